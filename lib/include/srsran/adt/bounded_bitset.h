@@ -24,6 +24,7 @@
 
 #include "srsran/srslog/bundled/fmt/format.h"
 #include "srsran/support/srsran_assert.h"
+#include <algorithm>
 #include <cstdint>
 #include <inttypes.h>
 #include <string>
@@ -98,7 +99,35 @@ struct zerobit_counter {
   }
 };
 
+template <typename Integer>
+unsigned popcount(Integer value)
+{
+  // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
+  int c = 0;
+  for (; value != 0; c++) {
+    value &= value - 1;
+  }
+  return c;
+}
+
 #ifdef __GNUC__ // clang and gcc
+/// Specializations for unsigned char and unsigned short, which are promoted to unsigned
+template <typename Integer>
+struct zerobit_counter<Integer, 1> {
+  static Integer msb_count(Integer value)
+  {
+    return (value) ? __builtin_clz(value) - (std::numeric_limits<unsigned>::digits - std::numeric_limits<Integer>::digits)
+                   : std::numeric_limits<Integer>::digits;
+  }
+  static Integer lsb_count(Integer value)
+  {
+    return (value) ? __builtin_ctz(value) : std::numeric_limits<Integer>::digits;
+  }
+};
+
+template <typename Integer>
+struct zerobit_counter<Integer, 2> : public zerobit_counter<Integer, 1> {};
+
 /// Specializations for unsigned
 template <typename Integer>
 struct zerobit_counter<Integer, 4> {
@@ -124,6 +153,18 @@ struct zerobit_counter<Integer, 8> {
     return (value) ? __builtin_ctzll(value) : std::numeric_limits<Integer>::digits;
   }
 };
+
+template <>
+inline unsigned popcount<uint32_t>(uint32_t value)
+{
+  return __builtin_popcount(value);
+}
+
+template <>
+inline unsigned popcount<uint64_t>(uint64_t value)
+{
+  return __builtin_popcountll(value);
+}
 #endif
 
 } // namespace detail
@@ -218,15 +259,13 @@ public:
   bounded_bitset<N, reversed>& fill(size_t startpos, size_t endpos, bool value = true)
   {
     assert_range_bounds_(startpos, endpos);
-    // NOTE: can be optimized
+    if (startpos == endpos) {
+      return *this;
+    }
     if (value) {
-      for (size_t i = startpos; i < endpos; ++i) {
-        set_(i);
-      }
+      for_each_word_in_range_(startpos, endpos, [this](size_t i, word_t mask) { buffer[i] |= mask; });
     } else {
-      for (size_t i = startpos; i < endpos; ++i) {
-        reset_(i);
-      }
+      for_each_word_in_range_(startpos, endpos, [this](size_t i, word_t mask) { buffer[i] &= ~mask; });
     }
     return *this;
   }
@@ -244,6 +283,46 @@ public:
     return find_first_reversed_(startpos, endpos, value);
   }
 
+  int find_highest(size_t startpos, size_t endpos, bool value = true) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (startpos == endpos) {
+      return -1;
+    }
+
+    if (not reversed) {
+      return find_last_(startpos, endpos, value);
+    }
+    // The highest position of a reversed bitset is the lowest bit of its buffer
+    int pos = find_first_(size() - endpos, size() - startpos, value);
+    return pos < 0 ? -1 : static_cast<int>(size() - 1 - pos);
+  }
+
+  /// Finds the lowest position "pos" in [startpos, endpos), such that the "length" bits in [pos, pos + length) are all
+  /// equal to "value". Returns -1 if there is no such run of bits.
+  int find_lowest_run(size_t startpos, size_t endpos, size_t length, bool value = true) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (length == 0) {
+      return startpos < endpos ? static_cast<int>(startpos) : -1;
+    }
+    if (startpos + length > endpos) {
+      return -1;
+    }
+    // Word-parallel search: after the loop, bit i of "runs" is one iff the bits [i, i + length) are all equal to
+    // "value". Each iteration doubles the run length covered, so only log2(length) passes over the words are needed
+    bounded_bitset<N, reversed> runs(*this);
+    if (not value) {
+      runs.flip();
+    }
+    for (size_t len = 1; len < length;) {
+      size_t shift = std::min(len, length - len);
+      runs.and_with_shifted_(shift);
+      len += shift;
+    }
+    return runs.find_lowest(startpos, endpos - length + 1, true);
+  }
+
   bool all() const noexcept
   {
     const size_t nw = nof_words_();
@@ -273,13 +352,11 @@ public:
   {
     assert_within_bounds_(start, false);
     assert_within_bounds_(stop, false);
-    // NOTE: can be optimized
-    for (size_t i = start; i < stop; ++i) {
-      if (test_(i)) {
-        return true;
-      }
+    bool ret = false;
+    if (start < stop) {
+      for_each_word_in_range_(start, stop, [this, &ret](size_t i, word_t mask) { ret |= (buffer[i] & mask) != 0; });
     }
-    return false;
+    return ret;
   }
 
   bool none() const noexcept { return !any(); }
@@ -288,13 +365,19 @@ public:
   {
     size_t result = 0;
     for (size_t i = 0; i < nof_words_(); i++) {
-      //      result += __builtin_popcountl(buffer[i]);
-      // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
-      int c = 0;
-      for (word_t w = buffer[i]; w > 0; c++) {
-        w &= w - 1;
-      }
-      result += c;
+      result += detail::popcount(buffer[i]);
+    }
+    return result;
+  }
+
+  /// Number of bits set to one in [startpos, endpos)
+  size_t count(size_t startpos, size_t endpos) const
+  {
+    assert_range_bounds_(startpos, endpos);
+    size_t result = 0;
+    if (startpos < endpos) {
+      for_each_word_in_range_(
+          startpos, endpos, [this, &result](size_t i, word_t mask) { result += detail::popcount(buffer[i] & mask); });
     }
     return result;
   }
@@ -457,6 +540,61 @@ private:
 
   static word_t maskbit(size_t pos) noexcept { return (static_cast<word_t>(1)) << (pos % bits_per_word); }
 
+  /// Calls "f(word_idx, mask)" for each word overlapping the non-empty range [startpos, endpos), where "mask" selects
+  /// the bits of the word that fall within the range
+  template <typename F>
+  void for_each_word_in_range_(size_t startpos, size_t endpos, F&& f) const
+  {
+    size_t startbit  = reversed ? get_bitidx_(endpos - 1) : startpos;
+    size_t lastbit   = reversed ? get_bitidx_(startpos) : endpos - 1;
+    size_t startword = startbit / bits_per_word;
+    size_t lastword  = std::min(lastbit / bits_per_word, max_nof_words_() - 1);
+    word_t startmask = mask_lsb_zeros<word_t>(startbit % bits_per_word);
+    word_t lastmask  = mask_lsb_ones<word_t>(lastbit % bits_per_word + 1);
+
+    for (size_t i = startword; i <= lastword; ++i) {
+      word_t mask = ~static_cast<word_t>(0);
+      if (i == startword) {
+        mask &= startmask;
+      }
+      if (i == lastword) {
+        mask &= lastmask;
+      }
+      f(i, mask);
+    }
+  }
+
+  /// Sets each bit at position "pos" to the AND of itself and the bit at position "pos + shift", where positions
+  /// beyond the bitset size read as zero
+  void and_with_shifted_(size_t shift) noexcept
+  {
+    const size_t nw          = std::min(nof_words_(), max_nof_words_());
+    const size_t word_offset = shift / bits_per_word;
+    const size_t bit_offset  = shift % bits_per_word;
+    auto         get_word    = [this, nw](size_t i) { return i < nw ? buffer[i] : static_cast<word_t>(0); };
+
+    if (not reversed) {
+      // Higher positions are found at higher bit indexes
+      for (size_t i = 0; i < nw; ++i) {
+        word_t w = get_word(i + word_offset) >> bit_offset;
+        if (bit_offset != 0) {
+          w |= get_word(i + word_offset + 1) << (bits_per_word - bit_offset);
+        }
+        buffer[i] &= w;
+      }
+    } else {
+      // Higher positions are found at lower bit indexes
+      for (size_t i = nw; i > 0; --i) {
+        size_t idx = i - 1;
+        word_t w   = idx >= word_offset ? get_word(idx - word_offset) << bit_offset : 0;
+        if (bit_offset != 0 and idx >= word_offset + 1) {
+          w |= get_word(idx - word_offset - 1) >> (bits_per_word - bit_offset);
+        }
+        buffer[idx] &= w;
+      }
+    }
+  }
+
   static size_t max_nof_words_() noexcept { return (N - 1) / bits_per_word + 1; }
 
   int find_last_(size_t startpos, size_t endpos, bool value) const noexcept
@@ -464,7 +602,7 @@ private:
     size_t startword = startpos / bits_per_word;
     size_t lastword  = (endpos - 1) / bits_per_word;
 
-    for (size_t i = lastword; i != startpos - 1; --i) {
+    for (size_t i = lastword; i != startword - 1; --i) {
       word_t w = buffer[i];
       if (not value) {
         w = ~w;
@@ -472,11 +610,11 @@ private:
 
       if (i == startword) {
         size_t offset = startpos % bits_per_word;
-        w &= (reversed) ? mask_msb_zeros<word_t>(offset) : mask_lsb_zeros<word_t>(offset);
+        w &= mask_lsb_zeros<word_t>(offset);
       }
       if (i == lastword) {
         size_t offset = (endpos - 1) % bits_per_word;
-        w &= (reversed) ? mask_msb_ones<word_t>(offset + 1) : mask_lsb_ones<word_t>(offset + 1);
+        w &= mask_lsb_ones<word_t>(offset + 1);
       }
       if (w != 0) {
         return static_cast<int>(i * bits_per_word + find_first_msb_one(w));
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SPSC_RING_H
+#define SRSRAN_SPSC_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace srsran {
+
+/**
+ * Bounded single-producer single-consumer ring buffer with the following features:
+ * - lock-free and wait-free. Each side owns one index and only reads the index of the other side
+ * - no allocations. The storage is an embedded array of N elements
+ * - the consumer can pop all the pending elements in bulk, with a single update of its index
+ * - each side caches the last seen index of the other side, to avoid touching the shared cache line on every call
+ * Only one thread may push and only one thread may pop at any given time.
+ * @tparam T trivially copyable element type
+ * @tparam N capacity of the ring. Must be a power of 2
+ */
+template <typename T, size_t N>
+class spsc_ring
+{
+  static_assert(N > 0 and (N & (N - 1)) == 0, "spsc_ring capacity must be a power of 2");
+  static_assert(std::is_trivially_copyable<T>::value, "spsc_ring elements must be trivially copyable");
+
+public:
+  spsc_ring()                 = default;
+  spsc_ring(const spsc_ring&) = delete;
+  spsc_ring& operator=(const spsc_ring&) = delete;
+
+  /// Called by the producer. Returns false if the ring is full
+  bool try_push(const T& t)
+  {
+    size_t tail = prod.tail.load(std::memory_order_relaxed);
+    if (tail - prod.head_cache == N) {
+      prod.head_cache = cons.head.load(std::memory_order_acquire);
+      if (tail - prod.head_cache == N) {
+        return false;
+      }
+    }
+    buffer[tail & (N - 1)] = t;
+    prod.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Called by the consumer. Returns false if the ring is empty
+  bool try_pop(T& t)
+  {
+    size_t head = cons.head.load(std::memory_order_relaxed);
+    if (head == cons.tail_cache) {
+      cons.tail_cache = prod.tail.load(std::memory_order_acquire);
+      if (head == cons.tail_cache) {
+        return false;
+      }
+    }
+    t = buffer[head & (N - 1)];
+    cons.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Called by the consumer. Passes all the elements pushed so far to "f" and frees their slots at once
+  /// @return number of popped elements
+  template <typename F>
+  size_t pop_all(F&& f)
+  {
+    size_t head = cons.head.load(std::memory_order_relaxed);
+    size_t tail = prod.tail.load(std::memory_order_acquire);
+    for (size_t i = head; i != tail; ++i) {
+      f(static_cast<const T&>(buffer[i & (N - 1)]));
+    }
+    cons.tail_cache = tail;
+    cons.head.store(tail, std::memory_order_release);
+    return tail - head;
+  }
+
+  /// Number of elements in the ring. Only exact when called with both sides idle
+  size_t size() const { return prod.tail.load(std::memory_order_acquire) - cons.head.load(std::memory_order_acquire); }
+  bool   empty() const { return size() == 0; }
+  static constexpr size_t capacity() { return N; }
+
+private:
+  struct alignas(64) producer_side {
+    std::atomic<size_t> tail{0};
+    size_t              head_cache = 0;
+  };
+  struct alignas(64) consumer_side {
+    std::atomic<size_t> head{0};
+    size_t              tail_cache = 0;
+  };
+
+  producer_side    prod;
+  consumer_side    cons;
+  std::array<T, N> buffer;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_SPSC_RING_H
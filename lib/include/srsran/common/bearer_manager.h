@@ -163,7 +163,8 @@ public:
   bool           set_five_qi(uint16_t rnti, uint32_t eps_bearer_id, uint16_t five_qi);
 
 private:
-  srslog::basic_logger& logger;
+  mutable pthread_rwlock_t rwlock = {}; /// RW lock to protect access from the stack thread and the MAC UL PDU workers
+  srslog::basic_logger&    logger;
 
   std::unordered_map<uint16_t, srsran::detail::ue_bearer_manager_impl> users_map;
 };
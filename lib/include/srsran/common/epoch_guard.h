@@ -0,0 +1,159 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_EPOCH_GUARD_H
+#define SRSRAN_EPOCH_GUARD_H
+
+#include "srsran/support/srsran_assert.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace srsran {
+
+/**
+ * Process-wide epoch domain used for epoch-based memory reclamation (EBR).
+ * Readers announce the global epoch in a thread-local, cache-line aligned slot while they access shared objects.
+ * Writers unlink objects, advance the global epoch, and only free the unlinked objects once every active reader has
+ * announced a newer epoch. Readers thus never write to a shared cache line, in contrast to a rwlock.
+ * Note: Taking into account the usage of thread_local, this class is made a singleton
+ */
+class epoch_domain
+{
+  static const size_t MAX_READERS = 128;
+
+public:
+  static constexpr uint64_t quiescent_epoch = std::numeric_limits<uint64_t>::max();
+
+  epoch_domain(const epoch_domain&) = delete;
+  epoch_domain(epoch_domain&&)      = delete;
+  epoch_domain& operator=(const epoch_domain&) = delete;
+  epoch_domain& operator=(epoch_domain&&) = delete;
+
+  static epoch_domain& get_instance()
+  {
+    static epoch_domain domain;
+    return domain;
+  }
+
+  /// Marks the calling thread as reader in the current epoch. Calls can be nested.
+  void enter()
+  {
+    reader_ctxt* ctxt = get_reader_ctxt();
+    if (ctxt->depth++ > 0) {
+      return;
+    }
+    reader_slot& slot  = slots[ctxt->slot_idx];
+    uint64_t     epoch = global_epoch.load(std::memory_order_seq_cst);
+    // Re-check the global epoch to avoid announcing an epoch that a writer has already scanned past
+    while (true) {
+      slot.epoch.store(epoch, std::memory_order_seq_cst);
+      uint64_t new_epoch = global_epoch.load(std::memory_order_seq_cst);
+      if (new_epoch == epoch) {
+        break;
+      }
+      epoch = new_epoch;
+    }
+  }
+
+  /// Marks the calling thread as quiescent, once the outermost guard exits.
+  void exit()
+  {
+    reader_ctxt* ctxt = get_reader_ctxt();
+    srsran_assert(ctxt->depth > 0, "Unbalanced epoch exit");
+    if (--ctxt->depth == 0) {
+      slots[ctxt->slot_idx].epoch.store(quiescent_epoch, std::memory_order_release);
+    }
+  }
+
+  /// Called by writers after unlinking an object. Returns the epoch with which the unlinked object is tagged.
+  uint64_t advance() { return global_epoch.fetch_add(1, std::memory_order_seq_cst); }
+
+  /// Checks whether all readers that could have observed objects retired at "retire_epoch" have exited.
+  bool is_safe_to_reclaim(uint64_t retire_epoch) const { return min_active_epoch() > retire_epoch; }
+
+  uint64_t min_active_epoch() const
+  {
+    uint64_t min_epoch = quiescent_epoch;
+    for (const reader_slot& slot : slots) {
+      uint64_t e = slot.epoch.load(std::memory_order_seq_cst);
+      min_epoch  = e < min_epoch ? e : min_epoch;
+    }
+    return min_epoch;
+  }
+
+private:
+  epoch_domain() = default;
+
+  struct alignas(64) reader_slot {
+    std::atomic<uint64_t> epoch{quiescent_epoch};
+    std::atomic<bool>     in_use{false};
+  };
+
+  struct reader_ctxt {
+    size_t   slot_idx = 0;
+    uint32_t depth    = 0;
+
+    reader_ctxt()
+    {
+      epoch_domain& domain = get_instance();
+      for (slot_idx = 0; slot_idx < domain.slots.size(); ++slot_idx) {
+        bool expected = false;
+        if (domain.slots[slot_idx].in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+          return;
+        }
+      }
+      srsran_terminate("Maximum number of epoch reader threads (%zd) exceeded", MAX_READERS);
+    }
+    ~reader_ctxt()
+    {
+      epoch_domain& domain = get_instance();
+      domain.slots[slot_idx].epoch.store(quiescent_epoch, std::memory_order_release);
+      domain.slots[slot_idx].in_use.store(false, std::memory_order_release);
+    }
+  };
+
+  static reader_ctxt* get_reader_ctxt()
+  {
+    thread_local reader_ctxt ctxt;
+    return &ctxt;
+  }
+
+  alignas(64) std::atomic<uint64_t> global_epoch{1};
+  std::array<reader_slot, MAX_READERS> slots;
+};
+
+/// Scoped guard that marks the calling thread as an epoch reader. It replaces shared read locks on hot paths.
+class epoch_read_guard
+{
+public:
+  epoch_read_guard() { epoch_domain::get_instance().enter(); }
+  epoch_read_guard(const epoch_read_guard&) = delete;
+  epoch_read_guard(epoch_read_guard&&)      = delete;
+  epoch_read_guard& operator=(const epoch_read_guard&) = delete;
+  epoch_read_guard& operator=(epoch_read_guard&&) = delete;
+  ~epoch_read_guard() { epoch_domain::get_instance().exit(); }
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_EPOCH_GUARD_H
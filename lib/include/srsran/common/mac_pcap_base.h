@@ -49,6 +49,9 @@ public:
 
   void set_ue_id(uint16_t ue_id);
 
+  /// Number of PDUs dropped because the write queue was full or no buffer was available
+  uint32_t get_nof_dropped_pdus() const { return nof_dropped_pdus.load(std::memory_order_relaxed); }
+
   // EUTRA
   void
   write_ul_crnti(uint8_t* pdu, uint32_t pdu_len_bytes, uint16_t crnti, uint32_t reTX, uint32_t tti, uint8_t cc_idx);
@@ -106,6 +109,9 @@ protected:
   } pcap_pdu_t;
 
   virtual void write_pdu(pcap_pdu_t& pdu) = 0;
+  /// Called once the PDUs pending in the write queue have been passed to write_pdu(), so that writers that aggregate
+  /// PDUs can output them
+  virtual void flush_pdus() {}
   void         run_thread() final;
 
   std::mutex                              mutex;
@@ -114,6 +120,7 @@ protected:
   static_blocking_queue<pcap_pdu_t, 1024> queue;
   uint16_t                                ue_id                = 0;
   int                                     emergency_handler_id = -1;
+  std::atomic<uint32_t>                   nof_dropped_pdus     = {0};
 
 private:
   void pack_and_queue(uint8_t* payload,
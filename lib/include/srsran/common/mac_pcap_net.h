@@ -24,29 +24,78 @@
 
 #include "srsran/common/common.h"
 #include "srsran/common/mac_pcap_base.h"
+#include "srsran/common/mac_pcap_net_batch.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/srsran.h"
+#include <sys/socket.h>
 
 namespace srsran {
+
+/// Aggregation of MAC PDUs in the datagrams of the network tap. The framing is described in mac_pcap_net_batch.h
+struct mac_pcap_net_batch_cfg_t {
+  /// If disabled, each PDU is sent in its own datagram, with the Wireshark "mac-lte-framed" format
+  bool enable = false;
+  /// Maximum size of the datagrams carrying the aggregated PDUs. It is raised if needed to fit the largest MAC PDU
+  uint32_t max_datagram_size = 32768;
+  /// Maximum number of datagrams sent with a single sendmmsg() call
+  uint32_t max_datagrams_per_send = 16;
+};
+
+struct mac_pcap_net_metrics_t {
+  uint64_t nof_pdus         = 0; ///< PDUs sent
+  uint64_t nof_bytes        = 0; ///< Bytes sent, including the framing
+  uint64_t nof_datagrams    = 0;
+  uint64_t nof_syscalls     = 0; ///< Calls to sendto() or sendmmsg()
+  uint64_t nof_dropped_pdus = 0; ///< PDUs dropped in the write queue or by the socket
+};
+
 class mac_pcap_net : public mac_pcap_base
 {
 public:
   mac_pcap_net();
   ~mac_pcap_net();
-  uint32_t open(std::string client_ip_addr_,
-                std::string bind_addr_str    = "0.0.0.0",
-                uint16_t    client_udp_port_ = 5847,
-                uint16_t    bind_udp_port_   = 5687,
-                uint32_t    ue_id_           = 0);
+  uint32_t open(std::string                     client_ip_addr_,
+                std::string                     bind_addr_str    = "0.0.0.0",
+                uint16_t                        client_udp_port_ = 5847,
+                uint16_t                        bind_udp_port_   = 5687,
+                uint32_t                        ue_id_           = 0,
+                const mac_pcap_net_batch_cfg_t& batch_cfg_       = {});
   uint32_t close();
 
+  mac_pcap_net_metrics_t get_metrics() const;
+
 private:
   void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  void flush_pdus() override;
   void write_mac_lte_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
   void write_mac_nr_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
 
+  // Batched mode
+  void     write_pdu_to_batch(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  uint8_t* get_datagram(uint32_t idx) { return &tx_buffer[idx * batch_cfg.max_datagram_size]; }
+  void     close_datagram();
+  void     send_datagrams();
+
   srsran::unique_socket socket;
   struct sockaddr_in    client_addr;
+
+  mac_pcap_net_batch_cfg_t batch_cfg;
+  std::vector<uint8_t>     tx_buffer;        ///< Space for "max_datagrams_per_send" datagrams
+  std::vector<uint32_t>    datagram_lengths; ///< Length of each closed datagram
+  std::vector<uint16_t>    datagram_nof_records;
+  std::vector<mmsghdr>     msgs;
+  std::vector<iovec>       iovs;
+  uint32_t                 nof_closed_datagrams = 0;
+  uint32_t                 cur_offset           = 0; ///< Write position in the open datagram
+  uint16_t                 cur_nof_records      = 0;
+  timeval                  cur_ts               = {};
+  uint32_t                 seq_nr               = 0;
+
+  std::atomic<uint64_t> nof_pdus_sent           = {0};
+  std::atomic<uint64_t> nof_bytes_sent          = {0};
+  std::atomic<uint64_t> nof_datagrams_sent      = {0};
+  std::atomic<uint64_t> nof_syscalls            = {0};
+  std::atomic<uint64_t> nof_socket_dropped_pdus = {0};
 };
 } // namespace srsran
 
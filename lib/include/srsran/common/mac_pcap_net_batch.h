@@ -0,0 +1,160 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MAC_PCAP_NET_BATCH_H
+#define SRSRAN_MAC_PCAP_NET_BATCH_H
+
+#include "srsran/common/network_utils.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <sys/time.h>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Framing of the batched MAC PCAP network tap. Each UDP datagram carries several MAC PDUs:
+ *
+ *   datagram header (24 B): magic (4 B), version (1 B), reserved (1 B), number of records (2 B), datagram sequence
+ *                           number (4 B), PDUs dropped by the sender so far (4 B), timestamp sec (4 B) and usec (4 B)
+ *   record header (8 B):    payload length (2 B), reserved (2 B), timestamp offset to the datagram timestamp, in
+ *                           usec (4 B)
+ *   record payload:         "mac-lte" or "mac-nr" start string, MAC context and MAC PDU, as in the UDP PCAP files
+ *
+ * All fields are in network byte order.
+ */
+namespace mac_pcap_net_batch {
+
+const uint32_t magic          = 0x53525042; // "SRPB"
+const uint8_t  version        = 1;
+const uint32_t hdr_len        = 24;
+const uint32_t record_hdr_len = 8;
+
+struct header_t {
+  uint16_t nof_records      = 0;
+  uint32_t seq_nr           = 0;
+  uint32_t nof_dropped_pdus = 0;
+  timeval  ts               = {};
+};
+
+void pack_header(const header_t& hdr, uint8_t* buffer);
+bool unpack_header(const uint8_t* buffer, uint32_t len, header_t& hdr);
+void pack_record_header(uint16_t payload_len, uint32_t ts_offset_usec, uint8_t* buffer);
+
+} // namespace mac_pcap_net_batch
+
+/// Parser of the datagrams of the batched MAC PCAP network tap, which tracks lost and malformed datagrams
+class mac_pcap_net_batch_decoder
+{
+public:
+  struct record_t {
+    timeval        ts;
+    const uint8_t* payload;
+    uint32_t       len;
+  };
+
+  struct metrics_t {
+    uint64_t nof_datagrams           = 0;
+    uint64_t nof_records             = 0;
+    uint64_t nof_record_bytes        = 0;
+    uint64_t nof_lost_datagrams      = 0; ///< Derived from gaps in the datagram sequence numbers
+    uint64_t nof_malformed_datagrams = 0;
+    uint32_t nof_sender_dropped_pdus = 0; ///< Last value reported by the sender
+  };
+
+  /// Decodes a datagram and calls "record_handler(const record_t&)" for each of its records. Returns false if the
+  /// datagram is malformed, in which case none of its records are passed on.
+  template <typename RecordHandler>
+  bool decode(const uint8_t* datagram, uint32_t len, RecordHandler&& record_handler)
+  {
+    mac_pcap_net_batch::header_t hdr;
+    if (not unpack_and_check(datagram, len, hdr)) {
+      return false;
+    }
+    const uint8_t* ptr = datagram + mac_pcap_net_batch::hdr_len;
+    for (uint32_t i = 0; i < hdr.nof_records; ++i) {
+      record_t record;
+      uint32_t ts_offset_usec;
+      record.len     = unpack_record(ptr, &ts_offset_usec);
+      record.payload = ptr + mac_pcap_net_batch::record_hdr_len;
+      record.ts      = hdr.ts;
+      record.ts.tv_sec += (record.ts.tv_usec + ts_offset_usec) / 1000000;
+      record.ts.tv_usec = (record.ts.tv_usec + ts_offset_usec) % 1000000;
+      record_handler(record);
+      ptr += mac_pcap_net_batch::record_hdr_len + record.len;
+    }
+    metrics.nof_records += hdr.nof_records;
+    return true;
+  }
+
+  const metrics_t& get_metrics() const { return metrics; }
+
+private:
+  /// Parses the datagram header and checks that all the records are within the datagram
+  bool     unpack_and_check(const uint8_t* datagram, uint32_t len, mac_pcap_net_batch::header_t& hdr);
+  uint32_t unpack_record(const uint8_t* ptr, uint32_t* ts_offset_usec) const;
+
+  bool      first_datagram = true;
+  uint32_t  next_seq_nr    = 0;
+  metrics_t metrics;
+};
+
+/**
+ * Receiver of the batched MAC PCAP network tap, which writes the received MAC PDUs to a standard PCAP file, in the
+ * same format as srsran::mac_pcap (UDP DLT with the "mac-lte"/"mac-nr" framing), so that it can be opened with
+ * Wireshark.
+ */
+class mac_pcap_net_bridge
+{
+public:
+  mac_pcap_net_bridge() = default;
+  ~mac_pcap_net_bridge();
+  mac_pcap_net_bridge(const mac_pcap_net_bridge&) = delete;
+  mac_pcap_net_bridge& operator=(const mac_pcap_net_bridge&) = delete;
+
+  bool open(const std::string& bind_addr, uint16_t bind_port, const std::string& filename);
+  void close();
+
+  /// Port the socket is bound to, e.g. the one picked by the OS when opened with bind_port 0. Returns 0 if closed.
+  uint16_t get_port() const;
+
+  /// Reads the datagrams available at the socket, waiting up to "timeout_ms" for the first one, and writes their
+  /// records to the PCAP file. Returns the number of records written, or -1 on error.
+  int receive(uint32_t timeout_ms);
+
+  const mac_pcap_net_batch_decoder::metrics_t& get_metrics() const { return decoder.get_metrics(); }
+
+private:
+  static const uint32_t max_datagram_size      = 65536;
+  static const uint32_t nof_datagrams_per_read = 32;
+
+  void write_record(const mac_pcap_net_batch_decoder::record_t& record);
+
+  srsran::unique_socket      socket;
+  FILE*                      pcap_file = nullptr;
+  mac_pcap_net_batch_decoder decoder;
+  std::vector<uint8_t>       rx_buffer;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_MAC_PCAP_NET_BATCH_H
@@ -200,6 +200,13 @@ public:
         impl = nullptr;
       }
     }
+    /// Unblocks the pushing threads and discards the current and future pushes, without releasing the queue
+    void deactivate()
+    {
+      if (impl != nullptr) {
+        impl->deactivate_blocking();
+      }
+    }
 
     size_t size() { return impl->size(); }
     size_t capacity() { return impl->capacity(); }
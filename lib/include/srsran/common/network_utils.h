@@ -60,6 +60,16 @@ bool bind_addr(int fd, const sockaddr_in& addr_in);
 bool bind_addr(int fd, const char* bind_addr_str, int port, sockaddr_in* addr_result = nullptr);
 bool connect_to(int fd, const char* dest_addr_str, int dest_port, sockaddr_in* dest_sockaddr = nullptr);
 
+// Batched datagram I/O functions
+/// Maximum number of datagrams sent or received by a single sendmmsg/recvmmsg call
+constexpr uint32_t max_io_batch_size = 64;
+/// Sends the PDUs to the same destination, with one sendmmsg call per max_io_batch_size PDUs.
+/// Returns the number of PDUs sent, which is lower than nof_pdus if the socket reported an error.
+int send_pdus(int fd, const sockaddr_in& dest, const srsran::unique_byte_buffer_t* pdus, uint32_t nof_pdus);
+/// Receives, without blocking and with a single recvmmsg call, up to max_pdus datagrams into the given (empty) PDUs.
+/// Returns the number of PDUs received, 0 if no datagram was pending, or -1 on error.
+int recv_pdus(int fd, srsran::unique_byte_buffer_t* pdus, sockaddr_in* from, uint32_t max_pdus);
+
 } // namespace net_utils
 
 /**
@@ -196,6 +206,16 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 socket_manager_itf::recv_callback_t
 make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
 
+/**
+ * Similar to make_sdu_handler, but each time the socket has data it receives up to batch_size datagrams with a single
+ * recvmmsg call, and dispatches all of them into the "queue" as a single task. The rx_callback is still called once
+ * per SDU. Suited for sockets with a high datagram rate, e.g. the M1-U multicast socket
+ */
+socket_manager_itf::recv_callback_t make_batch_sdu_handler(srslog::basic_logger&      logger,
+                                                           srsran::task_queue_handle& queue,
+                                                           recvfrom_callback_t        rx_callback,
+                                                           uint32_t batch_size = net_utils::max_io_batch_size);
+
 inline socket_manager& get_rx_io_manager()
 {
   static socket_manager io;
@@ -46,6 +46,15 @@
 
 namespace srsran {
 
+/**
+ * Pool of workers that are handed one job (e.g. a TTI) at a time. The handoff between the thread that grabs and starts
+ * the workers and the workers is lock-free:
+ * - every worker has a single-slot mailbox holding its status, which is written to start or stop the worker
+ * - a bitmap of the idle workers, from which a worker is grabbed with a single atomic operation
+ * - both the workers and the threads waiting for an idle worker spin for a while before sleeping on a futex. The spin
+ *   time of every worker adapts to how long it has been waiting for its jobs. The futex is only woken if the other
+ *   side is sleeping, so a handoff between spinning threads takes no system call
+ */
 class thread_pool
 {
 public:
@@ -87,28 +96,62 @@ public:
 
 private:
   bool find_finished_worker(uint32_t tti, uint32_t* id);
+  bool claim_worker(uint32_t id);
+  bool set_idle(uint32_t id, uint32_t from_status);
+  void wait_idle_event(uint32_t event_count);
 
   typedef enum { STOP, IDLE, START_WORK, WORKER_READY, WORKING } worker_status;
 
-  std::string                          id; // id is prepended to every worker
-  std::vector<worker*>                 workers     = {};
-  uint32_t                             nof_workers = 0;
-  uint32_t                             max_workers = 0;
-  bool                                 running     = false;
-  std::condition_variable              cvar_queue  = {};
-  std::mutex                           mutex_queue = {};
-  std::vector<worker_status>           status      = {};
-  std::vector<std::condition_variable> cvar_worker = {};
+  /// Mailbox of a worker, padded so that the mailboxes of different workers do not share a cache line
+  struct mailbox_t {
+    std::atomic<uint32_t> status{IDLE};    ///< worker_status, written to start and stop the worker
+    std::atomic<bool>     sleeping{false}; ///< the worker waits on the status futex
+    uint32_t              spin_budget = 0; ///< number of spins before sleeping, only accessed by the worker
+    char                  pad[64];
+  };
+
+  std::string                         id; // id is prepended to every worker
+  std::vector<worker*>                workers     = {};
+  uint32_t                            nof_workers = 0;
+  uint32_t                            max_workers = 0;
+  std::atomic<bool>                   running{false};
+  std::mutex                          mutex_queue = {};
+  std::vector<mailbox_t>              mailboxes;
+  std::vector<std::atomic<uint64_t> > idle_mask;      ///< bit i of word i / 64 is set if the worker i is idle
+  std::atomic<uint32_t>               idle_events{0}; ///< incremented every time a worker becomes idle
+  std::atomic<uint32_t>               nof_waiters{0}; ///< threads waiting on the idle_events futex
 };
 
+/**
+ * Pool of workers that execute the pushed tasks, with the following features:
+ * - every worker owns a bounded work-stealing deque (Chase-Lev), where the tasks pushed from within that worker are
+ *   placed. The owner pops from one end (LIFO), while idle workers steal from the other end (FIFO)
+ * - the tasks pushed from threads outside the pool go to lock-free global injection queues, one per priority level
+ * - high priority tasks are always injected globally and are served before any normal priority task
+ * - idle workers spin briefly before sleeping, and the pushing thread only takes a lock when some worker is asleep
+ * - optionally, every worker is pinned to one of the cores of the CPU mask
+ * Tasks still pending when the pool is stopped are not executed until the pool is started again.
+ * Note that the normal priority tasks pushed from within a worker run in LIFO order, unless they are stolen. In a pool
+ * with a single worker, such as the default background pool, they are therefore executed in the reverse order of
+ * their push, while the tasks pushed from outside the pool keep the FIFO order.
+ */
 class task_thread_pool
 {
-  using task_t                             = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
-  static constexpr uint32_t max_task_shift = 14;
-  static constexpr uint32_t max_task_num   = 1u << max_task_shift;
+  using task_t                               = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
+  static constexpr uint32_t max_task_shift   = 14;
+  static constexpr uint32_t max_task_num     = 1u << max_task_shift;
+  static constexpr uint32_t local_task_shift = 8;
+  static constexpr uint32_t local_task_num   = 1u << local_task_shift;
+  static constexpr uint32_t max_nof_workers  = 256;
 
 public:
-  task_thread_pool(uint32_t nof_workers = 1, bool start_deferred = false, int32_t prio_ = -1, uint32_t mask_ = 255);
+  enum class task_priority { high, normal, nof_priorities };
+
+  task_thread_pool(uint32_t nof_workers    = 1,
+                   bool     start_deferred = false,
+                   int32_t  prio_          = -1,
+                   uint32_t mask_          = 255,
+                   bool     pin_workers_   = false);
   task_thread_pool(const task_thread_pool&) = delete;
   task_thread_pool(task_thread_pool&&)      = delete;
   task_thread_pool& operator=(const task_thread_pool&) = delete;
@@ -116,14 +159,64 @@ public:
   ~task_thread_pool();
 
   void stop();
-  void start(int32_t prio_ = -1, uint32_t mask_ = 255);
+  void start(int32_t prio_ = -1, uint32_t mask_ = 255, bool pin_workers_ = false);
   void set_nof_workers(uint32_t nof_workers);
 
-  void     push_task(task_t&& task);
+  void     push_task(task_t&& task, task_priority task_prio = task_priority::normal);
   uint32_t nof_pending_tasks() const;
-  size_t   nof_workers() const { return workers.size(); }
+  size_t   nof_workers() const { return nof_workers_cfg; }
 
 private:
+  /// Bounded multi-producer multi-consumer queue, in which every slot carries a sequence number that tells whether it
+  /// is ready to be written or read for a given position (D. Vyukov)
+  class task_queue
+  {
+  public:
+    explicit task_queue(uint32_t capacity);
+    bool try_push(task_t& task);
+    bool try_pop(task_t& task);
+
+  private:
+    struct slot_t {
+      std::atomic<uint64_t> seq{0};
+      task_t                task;
+    };
+
+    // The indexes are kept apart to avoid false sharing between producers and consumers. Padding is used instead of
+    // alignas, since over-aligned types cannot be allocated with new before C++17
+    std::unique_ptr<slot_t[]> slots;
+    uint64_t                  mask = 0;
+    char                      pad0[64];
+    std::atomic<uint64_t>     head{0}; ///< next position to read
+    char                      pad1[64];
+    std::atomic<uint64_t>     tail{0}; ///< next position to write
+  };
+
+  /// Bounded Chase-Lev deque. Only the owner worker may push and pop, any other worker may steal. A slot is moved out
+  /// after its position has been claimed, and the owner does not reuse a slot until it has been moved out
+  class task_deque
+  {
+  public:
+    task_deque();
+    bool try_push(task_t& task);
+    bool try_pop(task_t& task);
+    bool try_steal(task_t& task);
+
+  private:
+    struct slot_t {
+      std::atomic<bool> busy{false};
+      task_t            task;
+    };
+
+    void take(slot_t& slot, task_t& task);
+
+    std::unique_ptr<slot_t[]> slots;
+    char                      pad0[64]; // see task_queue
+    std::atomic<int64_t>      top{0};    ///< end where the thieves steal
+    char                      pad1[64];
+    std::atomic<int64_t>      bottom{0}; ///< end where the owner pushes and pops
+  };
+
   class worker_t : public thread
   {
   public:
@@ -134,23 +227,38 @@ private:
 
     void run_thread() override;
 
+    task_thread_pool* parent = nullptr;
+    task_deque        local_tasks;
+
   private:
-    bool wait_task(task_t* task);
+    bool find_task(task_t& task);
+    bool wait_task(task_t& task);
 
-    task_thread_pool* parent  = nullptr;
-    uint32_t          id_     = 0;
-    bool              running = false;
+    uint32_t          id_         = 0;
+    uint32_t          local_count = 0;
+    uint32_t          steal_index = 0;
+    std::atomic<bool> running{false};
   };
 
-  int32_t               prio = -1;
-  uint32_t              mask = 255;
+  void start_worker(uint32_t id);
+  void notify_workers();
+
+  static thread_local worker_t* current_worker; ///< worker running in the calling thread, if any
+
+  int32_t               prio        = -1;
+  uint32_t              mask        = 255;
+  bool                  pin_workers = false;
   srslog::basic_logger& logger;
 
-  srsran::dyn_circular_buffer<task_t>     pending_tasks;
+  std::unique_ptr<task_queue>             global_tasks[(size_t)task_priority::nof_priorities];
   std::vector<std::unique_ptr<worker_t> > workers;
+  uint32_t                                nof_workers_cfg = 0;
+  std::atomic<uint32_t>                   nof_started{0};  ///< workers that can be stolen from
+  std::atomic<uint32_t>                   nof_pending{0};  ///< tasks waiting in the global queues and the deques
+  std::atomic<uint32_t>                   nof_sleeping{0}; ///< workers waiting on cv_empty
+  std::atomic<bool>                       running{false};
   mutable std::mutex                      queue_mutex;
   std::condition_variable                 cv_empty;
-  bool                                    running = false;
 };
 
 /// Class used to create a single worker with an input task queue with a single reader
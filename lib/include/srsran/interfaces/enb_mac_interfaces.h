@@ -34,6 +34,7 @@ struct mac_args_t {
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
+  uint32_t                      nof_ul_pdu_workers; ///< Number of UE-plane workers for UL PDUs (0: use stack thread)
 };
 
 /* Interface PHY -> MAC */
@@ -158,6 +159,25 @@ public:
    */
   virtual int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) = 0;
 
+  /**
+   * PHY callback for giving MAC the SINR in dB of consecutive UL subbands for a given RNTI at a given carrier, as
+   * measured on the SRS
+   *
+   * @param tti The measurement was made
+   * @param rnti The UE identifier in the eNb
+   * @param cc_idx The eNb Cell/Carrier where the SRS was received
+   * @param prb_start First PRB of the first subband
+   * @param sb_nof_prb Number of PRBs of each subband
+   * @param sb_snr_db SINR of each subband
+   * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR* if an error occurs
+   */
+  virtual int ul_sb_snr_info(uint32_t                  tti,
+                             uint16_t                  rnti,
+                             uint32_t                  cc_idx,
+                             uint32_t                  prb_start,
+                             uint32_t                  sb_nof_prb,
+                             srsran::span<const float> sb_snr_db) = 0;
+
   /**
    * PHY callback for giving MAC the Time Aligment information in microseconds of a given RNTI during a TTI processing
    *
@@ -65,6 +65,12 @@ public:
   virtual void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu)               = 0;
   virtual void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) = 0;
   virtual void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)  = 0;
+  /* RLC calls PDCP to push a user plane PDCP PDU from outside of the stack thread (e.g. from the MAC UL PDU workers).
+   * Returns false, leaving the PDU untouched, if the PDU must be pushed from the stack thread with write_pdu(). */
+  virtual bool try_write_pdu_user_plane(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t& pdu)
+  {
+    return false;
+  }
 };
 
 } // namespace srsenb
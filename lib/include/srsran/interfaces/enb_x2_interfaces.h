@@ -22,6 +22,7 @@
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_types.h"
+#include "srsran/upper/pdcp_split_bearer.h"
 
 #ifndef SRSRAN_ENB_X2_INTERFACES_H
 #define SRSRAN_ENB_X2_INTERFACES_H
@@ -117,9 +118,35 @@ public:
   virtual void set_activity_user(uint16_t eutra_rnti) = 0;
 };
 
+/// X2-U inspired interface to allow EUTRA RRC to set up an EN-DC split bearer, whose PDCP is the NR PDCP
+class pdcp_nr_interface_rrc
+{
+public:
+  /**
+   * @brief Use an EUTRA RLC bearer as secondary leg of a DRB of the NR PDCP
+   *
+   * The UL PDUs and the delivery notifications of the EUTRA RLC bearer are forwarded to the NR PDCP
+   *
+   * @param nr_rnti The RNTI of the UE on the NR side
+   * @param nr_lcid The LCID of the DRB on the NR side
+   * @param eutra_rnti The RNTI of the UE on the EUTRA side
+   * @param eutra_lcid The LCID of the EUTRA RLC bearer
+   * @param split_cfg Flow control configuration of the split bearer
+   */
+  virtual void add_split_bearer_leg(uint16_t                               nr_rnti,
+                                    uint32_t                               nr_lcid,
+                                    uint16_t                               eutra_rnti,
+                                    uint32_t                               eutra_lcid,
+                                    const srsran::pdcp_split_bearer_cfg_t& split_cfg) = 0;
+
+  /// Stop using the EUTRA RLC bearer as secondary leg of the DRB of the NR PDCP
+  virtual void del_split_bearer_leg(uint16_t nr_rnti, uint32_t nr_lcid, uint16_t eutra_rnti, uint32_t eutra_lcid) = 0;
+};
+
 // combined interface used by X2 adapter
 class x2_interface : public rrc_nr_interface_rrc,
                      public rrc_eutra_interface_rrc_nr,
+                     public pdcp_nr_interface_rrc,
                      public pdcp_interface_gtpu, // allow GTPU to access PDCP in DL direction
                      public gtpu_interface_pdcp  // allow PDCP to access GTPU in UL direction
 {
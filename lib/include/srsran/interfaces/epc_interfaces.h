@@ -116,8 +116,7 @@ public:
   virtual bool modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw_user_fteid, uint32_t up_ctrl_teid) = 0;
   virtual bool delete_gtpu_tunnel(in_addr_t ue_ipv4)                                                              = 0;
   virtual bool delete_gtpc_tunnel(in_addr_t ue_ipv4)                                                              = 0;
-  virtual void send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
-                                       std::queue<srsran::unique_byte_buffer_t>& pkt_queue)                       = 0;
+  virtual void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)                            = 0;
 };
 
 class gtpc_interface_gtpu // GTP-U -> GTP-C
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_UE_GW_INTERFACES_H
 #define SRSRAN_UE_GW_INTERFACES_H
 
+#include "srsran/adt/span.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/byte_buffer.h"
 
@@ -77,6 +78,14 @@ class gw_interface_pdcp
 public:
   virtual void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)     = 0;
   virtual void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu) = 0;
+
+  /// Passes a run of PDUs in ascending order of COUNT. By default they are written one by one
+  virtual void write_pdu_batch(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+  {
+    for (srsran::unique_byte_buffer_t& pdu : pdus) {
+      write_pdu(lcid, std::move(pdu));
+    }
+  }
 };
 
 class gw_interface_stack : public gw_interface_nas, public gw_interface_rrc, public gw_interface_pdcp
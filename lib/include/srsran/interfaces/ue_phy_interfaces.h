@@ -78,6 +78,10 @@ struct phy_args_t {
   float       snr_ema_coeff                = 0.1f;
   std::string snr_estim_alg                = "refs";
   bool        agc_enable                   = true;
+  bool        agc_fast_attack              = false;
+  float       agc_attack_tc                = 1.0f;
+  float       agc_decay_tc                 = 20.0f;
+  uint32_t    agc_hold_frames              = 3;
   bool        correct_sync_error           = false;
   bool        cfo_is_doppler               = false;
   bool        cfo_integer_enabled          = false;
@@ -61,6 +61,9 @@ public:
   ///< Allow PDCP to query SDU queue status
   virtual bool sdu_queue_is_full(uint32_t lcid) = 0;
 
+  ///< Allow PDCP to query the RLC buffer occupancy, e.g. for the flow control of split bearers
+  virtual uint32_t get_buffer_state(const uint32_t lcid) = 0;
+
   virtual bool is_suspended(const uint32_t lcid) = 0;
 };
 
@@ -43,6 +43,7 @@
 #define SRSRAN_AGC_HOLD_COUNT (20)        /* Number of frames to wait after setting the gain before start measuring */
 #define SRSRAN_AGC_MIN_MEASUREMENTS (10)  /* Minimum number of measurements  */
 #define SRSRAN_AGC_MIN_GAIN_OFFSET (2.0f) /* Mimum of gain offset to set the radio gain */
+#define SRSRAN_AGC_CLIP_LEVEL (1.0f)      /* Peak amplitude above which the Rx signal is considered clipped */
 
 typedef enum SRSRAN_API { SRSRAN_AGC_MODE_ENERGY = 0, SRSRAN_AGC_MODE_PEAK_AMPLITUDE } srsran_agc_mode_t;
 
@@ -61,6 +62,13 @@ typedef enum SRSRAN_API { SRSRAN_AGC_MODE_ENERGY = 0, SRSRAN_AGC_MODE_PEAK_AMPLI
  * +------+                  +---------+                +------+
  *                                ^      Enter measure      |
  *                                +-------------------------+
+ *
+ * In fast-attack mode, the average and peak power of every measured frame are estimated in a single pass, and the
+ * measurement is tracked with an envelope follower whose time constant is short when the level rises (attack) and long
+ * when it falls (decay). A gain reduction is set as soon as the offset exceeds SRSRAN_AGC_MIN_GAIN_OFFSET or the signal
+ * clips, whereas gain increases wait for SRSRAN_AGC_MIN_MEASUREMENTS frames. The hold period is configurable, and the
+ * envelope is corrected by the applied gain step instead of restarting the measurement. A frame whose peak reaches
+ * SRSRAN_AGC_CLIP_LEVEL bypasses the envelope follower.
  */
 
 typedef enum { SRSRAN_AGC_STATE_INIT = 0, SRSRAN_AGC_STATE_MEASURE, SRSRAN_AGC_STATE_HOLD } srsran_agc_state_t;
@@ -83,6 +91,12 @@ typedef struct SRSRAN_API {
   uint32_t           hold_cnt;
   float*             y_tmp;
   srsran_agc_state_t state;
+  bool               fast_attack;
+  float              attack_coeff;
+  float              decay_coeff;
+  uint32_t           hold_frames;
+  float              avg_power;
+  float              peak_power;
 } srsran_agc_t;
 
 SRSRAN_API int srsran_agc_init_acc(srsran_agc_t* q, srsran_agc_mode_t mode, uint32_t nof_frames);
@@ -103,6 +117,22 @@ SRSRAN_API float srsran_agc_get_gain(srsran_agc_t* q);
 
 SRSRAN_API void srsran_agc_set_gain(srsran_agc_t* q, float init_gain_value_db);
 
+/**
+ * Enables the fast-attack/slow-decay mode. The time constants are given in number of calls to srsran_agc_process(), so
+ * they scale with the AGC period set by the caller.
+ * @param q AGC object
+ * @param attack_tc Time constant of the envelope follower when the signal level rises
+ * @param decay_tc Time constant of the envelope follower when the signal level falls
+ * @param hold_frames Number of frames ignored after setting a new gain, while the radio settles
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_agc_set_fast_attack(srsran_agc_t* q, float attack_tc, float decay_tc, uint32_t hold_frames);
+
 SRSRAN_API void srsran_agc_process(srsran_agc_t* q, cf_t* signal, uint32_t len);
 
+/* Average and peak power of the last measured frame, in linear units */
+SRSRAN_API float srsran_agc_get_avg_power(srsran_agc_t* q);
+
+SRSRAN_API float srsran_agc_get_peak_power(srsran_agc_t* q);
+
 #endif // SRSRAN_AGC_H
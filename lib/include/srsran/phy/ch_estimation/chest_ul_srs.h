@@ -0,0 +1,120 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**********************************************************************************************
+ *  File:         chest_ul_srs.h
+ *
+ *  Description:  3GPP LTE multi-UE Sounding Reference Signal (SRS) receiver.
+ *                The UEs that sound the same subcarriers in a subframe share the SRS base
+ *                sequence and differ only in their cyclic shift. Their SRS are separated with
+ *                a single IFFT of the least squares estimate of the shared subcarriers, after
+ *                which every UE occupies its own window of channel taps. The per-UE frequency
+ *                response is recovered from its window and reduced to a per-subband SINR.
+ *
+ *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 5.5.3
+ *********************************************************************************************/
+
+#ifndef SRSRAN_CHEST_UL_SRS_H
+#define SRSRAN_CHEST_UL_SRS_H
+
+#include "srsran/config.h"
+
+#include "srsran/phy/ch_estimation/refsignal_ul.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/dft/dft.h"
+
+/**
+ * Number of PRB of the subbands in which the SINR of the sounded bandwidth is reported. The SRS bandwidths are
+ * multiple of 4 PRB (TS 36.211 Tables 5.5.3.2-1 to 5.5.3.2-4), so the sounded bandwidth holds an integer number of
+ * subbands.
+ */
+#define SRSRAN_CHEST_UL_SRS_SB_NOF_PRB 4
+
+/**
+ * Maximum number of subbands in a SRS measurement
+ */
+#define SRSRAN_CHEST_UL_SRS_MAX_NOF_SB (SRSRAN_MAX_PRB / SRSRAN_CHEST_UL_SRS_SB_NOF_PRB)
+
+/**
+ * Maximum number of different SRS bandwidths in a cell, all bandwidth configurations and B values combined
+ */
+#define SRSRAN_CHEST_UL_SRS_MAX_NOF_DFT 32
+
+typedef struct SRSRAN_API {
+  uint32_t prb_start;                                 ///< First PRB of the sounded bandwidth
+  uint32_t nof_sb;                                    ///< Number of subbands in the sounded bandwidth
+  float    sb_snr_db[SRSRAN_CHEST_UL_SRS_MAX_NOF_SB]; ///< SINR of each subband, in dB
+  float    snr_db;                                    ///< SINR of the whole sounded bandwidth, in dB
+  float    noise_estimate_dbFs;                       ///< Noise and interference power per subcarrier
+  float    ta_us;                                     ///< Time alignment estimate
+} srsran_chest_ul_srs_res_t;
+
+typedef struct SRSRAN_API {
+  srsran_cell_t         cell;
+  srsran_refsignal_ul_t refsignal;
+
+  // One DFT pair per SRS bandwidth of the cell
+  uint32_t          nof_dft;
+  uint32_t          dft_size[SRSRAN_CHEST_UL_SRS_MAX_NOF_DFT];
+  srsran_dft_plan_t ifft[SRSRAN_CHEST_UL_SRS_MAX_NOF_DFT];
+  srsran_dft_plan_t fft[SRSRAN_CHEST_UL_SRS_MAX_NOF_DFT];
+
+  cf_t*     pilot_recv_signal;
+  cf_t*     pilot_known_signal;
+  cf_t*     cir;
+  cf_t*     ue_cir;
+  cf_t*     ue_ce;
+  float*    power;
+  uint16_t* tap_dist;
+  uint32_t* tap_hist;
+  uint32_t  max_prb;
+} srsran_chest_ul_srs_t;
+
+SRSRAN_API int srsran_chest_ul_srs_init(srsran_chest_ul_srs_t* q, uint32_t max_prb);
+
+SRSRAN_API void srsran_chest_ul_srs_free(srsran_chest_ul_srs_t* q);
+
+SRSRAN_API int srsran_chest_ul_srs_set_cell(srsran_chest_ul_srs_t* q, srsran_cell_t cell);
+
+/**
+ * @brief Measures the SRS of several UEs in one subframe.
+ *
+ * UEs that sound the same subcarriers are processed together, with one IFFT per group. UEs whose SRS bandwidths
+ * overlap without being equal are measured in different groups, and appear as interference in the SINR of each other.
+ *
+ * @param q SRS receiver object
+ * @param sf Uplink subframe configuration, it provides the TTI
+ * @param pusch_cfg Cell PUSCH DMRS configuration, which determines the SRS base sequence
+ * @param cfg Array with the SRS configuration of each UE. All of them must transmit SRS in this TTI
+ * @param nof_ue Number of UEs
+ * @param input Received resource grid
+ * @param res Array with one measurement per UE
+ * @return SRSRAN_SUCCESS if the measurements are successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_chest_ul_srs_estimate(srsran_chest_ul_srs_t*             q,
+                                            const srsran_ul_sf_cfg_t*          sf,
+                                            srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                                            srsran_refsignal_srs_cfg_t*        cfg,
+                                            uint32_t                           nof_ue,
+                                            const cf_t*                        input,
+                                            srsran_chest_ul_srs_res_t*         res);
+
+#endif // SRSRAN_CHEST_UL_SRS_H
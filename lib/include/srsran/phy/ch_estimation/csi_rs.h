@@ -48,6 +48,38 @@
  */
 #define SRSRAN_CSI_RS_NOF_FREQ_DOMAIN_ALLOC_OTHER 6
 
+/**
+ * @brief Maximum number of symbols occupied by a CSI-RS resource as defined in TS 38.211 Table 7.4.1.5.3-1
+ */
+#define SRSRAN_CSI_RS_MAX_SYMBOLS_SLOT 4
+
+/**
+ * @brief Precomputed parameters of a NZP-CSI-RS resource for measurements
+ */
+typedef struct SRSRAN_API {
+  uint32_t  nof_l;                                  ///< Number of OFDM symbols carrying the resource
+  uint32_t  l_list[SRSRAN_CSI_RS_MAX_SYMBOLS_SLOT]; ///< OFDM symbol indexes
+  uint32_t  nof_re;                                 ///< Number of RE in each OFDM symbol
+  uint32_t* re_idx;                                 ///< Subcarrier index of each RE in the OFDM symbol
+  uint32_t  slot_stride;                            ///< Slots carrying the resource are congruent modulo this
+  uint32_t  nof_slots;                              ///< Number of slots of a frame that can carry the resource
+  bool*     sequence_ready;                         ///< Whether the sequences of each slot are generated
+  cf_t*     sequence;                               ///< Sequences for each slot and symbol, generated on demand
+} srsran_csi_rs_nzp_table_resource_t;
+
+/**
+ * @brief NZP-CSI-RS set measurement tables. They keep the RE indexes and the sequences of every resource of a set, so
+ * that all the resources transmitted in a slot are measured in a single pass over the resource grid without deriving
+ * their patterns and sequences again.
+ */
+typedef struct SRSRAN_API {
+  srsran_carrier_nr_t                carrier;    ///< Carrier the tables have been computed for
+  srsran_csi_rs_nzp_set_t            set;        ///< Set the tables have been computed for
+  bool                               configured; ///< Set to true once the tables are computed
+  srsran_csi_rs_nzp_table_resource_t resources[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  cf_t*                              lse; ///< Temporal least square estimates
+} srsran_csi_rs_nzp_table_t;
+
 /**
  * @brief Calculates if the given periodicity implies a CSI-RS transmission in the given slot
  * @remark Described in TS 36.211 section 7.4.1.5.3 Mapping to physical resources
@@ -191,4 +223,63 @@ SRSRAN_API int srsran_csi_rs_zp_measure_channel(const srsran_carrier_nr_t*
                                                 const cf_t*                        grid,
                                                 srsran_csi_channel_measurements_t* measure);
 
+/**
+ * @brief Initialises NZP-CSI-RS set measurement tables
+ * @param q Object
+ * @return SRSRAN_SUCCESS if the arguments are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_csi_rs_nzp_table_init(srsran_csi_rs_nzp_table_t* q);
+
+SRSRAN_API void srsran_csi_rs_nzp_table_free(srsran_csi_rs_nzp_table_t* q);
+
+/**
+ * @brief Checks whether the tables have been computed for the given carrier and NZP-CSI-RS resource set
+ * @param q Object
+ * @param carrier Provides carrier configuration
+ * @param set Provides NZP-CSI-RS resource set
+ * @return True if the tables match the given configuration, false otherwise
+ */
+SRSRAN_API bool srsran_csi_rs_nzp_table_match(const srsran_csi_rs_nzp_table_t* q,
+                                              const srsran_carrier_nr_t*       carrier,
+                                              const srsran_csi_rs_nzp_set_t*   set);
+
+/**
+ * @brief Computes the tables for the given carrier and NZP-CSI-RS resource set. It does nothing if they already match.
+ * @param q Object
+ * @param carrier Provides carrier configuration
+ * @param set Provides NZP-CSI-RS resource set
+ * @return SRSRAN_SUCCESS if the configuration is valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_csi_rs_nzp_table_set(srsran_csi_rs_nzp_table_t*     q,
+                                           const srsran_carrier_nr_t*     carrier,
+                                           const srsran_csi_rs_nzp_set_t* set);
+
+/**
+ * @brief Same as srsran_csi_rs_nzp_measure_trs(), using the precomputed tables of the set
+ * @param q Object
+ * @param slot_cfg Provides current slot
+ * @param grid Resource grid
+ * @param measure Provides measurement
+ * @return The number of NZP-CSI-RS resources scheduled for this TTI if the configuration is right, SRSRAN_ERROR code if
+ * the configuration is invalid
+ */
+SRSRAN_API int srsran_csi_rs_nzp_table_measure_trs(srsran_csi_rs_nzp_table_t*     q,
+                                                   const srsran_slot_cfg_t*       slot_cfg,
+                                                   const cf_t*                    grid,
+                                                   srsran_csi_trs_measurements_t* measure);
+
+/**
+ * @brief Same as srsran_csi_rs_nzp_measure_channel(), using the precomputed tables of the set
+ * @param q Object
+ * @param slot_cfg Provides current slot
+ * @param grid Resource grid
+ * @param measure Provides CSI measurement
+ * @return The number of NZP-CSI-RS resources scheduled for this slot if the configuration is right, SRSRAN_ERROR code
+ * if the configuration is invalid
+ */
+SRSRAN_API int srsran_csi_rs_nzp_table_measure_channel(srsran_csi_rs_nzp_table_t*         q,
+                                                       const srsran_slot_cfg_t*           slot_cfg,
+                                                       const cf_t*                        grid,
+                                                       srsran_csi_channel_measurements_t* measure);
+
 #endif // SRSRAN_CSI_RS_H_
@@ -140,6 +140,50 @@ SRSRAN_API void srsran_ofdm_tx_free(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_tx_sf(srsran_ofdm_t* q);
 
+/**
+ * @brief Transforms a subframe in which some of the OFDM symbols may be empty
+ *
+ * The empty symbols are not transformed, their output samples are set to zero instead. Subframes without empty
+ * symbols, MBSFN subframes and transmitters with CFR enabled are transformed as in srsran_ofdm_tx_sf().
+ *
+ * @param q OFDM object
+ * @param active_mask Bitmap of the symbols of the subframe with any non-zero resource element, bit n corresponds to
+ * the n-th symbol of the subframe
+ */
+SRSRAN_API void srsran_ofdm_tx_sf_sparse(srsran_ofdm_t* q, uint32_t active_mask);
+
+/**
+ * @brief Tells whether the output samples of every symbol of a subframe only depend on the resource elements of the
+ * symbol, in which case the output of a symbol can be reused in any other subframe with the same content
+ *
+ * It is false for MBSFN subframes, and when frequency shift or CFR are enabled.
+ *
+ * @param q OFDM object
+ * @return true if the transform of the symbols can be reused, false otherwise
+ */
+SRSRAN_API bool srsran_ofdm_tx_sf_can_reuse(const srsran_ofdm_t* q);
+
+/**
+ * @brief Same as srsran_ofdm_tx_sf_sparse() but the output samples of the symbols in the reuse bitmap, including their
+ * CP, are copied from a previous output of the same subframe index instead of being transformed
+ *
+ * If srsran_ofdm_tx_sf_can_reuse() is false, the symbols to reuse are output as empty symbols.
+ *
+ * @param q OFDM object
+ * @param active_mask Bitmap of the symbols to transform
+ * @param reuse_mask Bitmap of the symbols to copy from the reused output, disjoint with the active ones
+ * @param reuse Previous output of the subframe, it holds the same number of samples as the output buffer
+ */
+SRSRAN_API void srsran_ofdm_tx_sf_reuse(srsran_ofdm_t* q, uint32_t active_mask, uint32_t reuse_mask, const cf_t* reuse);
+
+/**
+ * @brief Gets the symbols of the input subframe which have any non-zero resource element
+ *
+ * @param q OFDM object
+ * @return Bitmap of the non-empty symbols, bit n corresponds to the n-th symbol of the subframe
+ */
+SRSRAN_API uint32_t srsran_ofdm_tx_sf_active_symbols(const srsran_ofdm_t* q);
+
 SRSRAN_API int srsran_ofdm_set_freq_shift(srsran_ofdm_t* q, float freq_shift);
 
 SRSRAN_API void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable);
@@ -89,6 +89,16 @@ typedef struct SRSRAN_API {
   uint32_t              nof_common_locations[3];
   srsran_dci_location_t common_locations[3][SRSRAN_MAX_CANDIDATES_COM];
 
+  // Base grid of each subframe index, with the signals that do not change between frames (CRS, PSS and SSS)
+  cf_t*               base_grid[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_PORTS];
+  uint32_t            base_symbols[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_PORTS]; ///< Symbols used by the base grid
+  bool                base_grid_valid[SRSRAN_NOF_SF_X_FRAME];
+  srsran_tdd_config_t base_grid_tdd[SRSRAN_NOF_SF_X_FRAME]; ///< TDD configuration the base grid was generated for
+
+  // Transform of each base grid, reused by the symbols which do not carry anything else
+  cf_t* base_signal[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_PORTS];
+  bool  base_signal_valid[SRSRAN_NOF_SF_X_FRAME];
+
 } srsran_enb_dl_t;
 
 typedef struct {
@@ -36,6 +36,7 @@
 #include <stdbool.h>
 
 #include "srsran/phy/ch_estimation/chest_ul.h"
+#include "srsran/phy/ch_estimation/chest_ul_srs.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/dft/ofdm.h"
 #include "srsran/phy/phch/prach.h"
@@ -56,10 +57,11 @@ typedef struct SRSRAN_API {
   cf_t*                 in_buffer;
   srsran_chest_ul_res_t chest_res;
 
-  srsran_ofdm_t     fft;
-  srsran_chest_ul_t chest;
-  srsran_pusch_t    pusch;
-  srsran_pucch_t    pucch;
+  srsran_ofdm_t         fft;
+  srsran_chest_ul_t     chest;
+  srsran_chest_ul_srs_t chest_srs;
+  srsran_pusch_t        pusch;
+  srsran_pucch_t        pucch;
 
 } srsran_enb_ul_t;
 
@@ -85,4 +87,12 @@ SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_pusch_cfg_t* cfg,
                                        srsran_pusch_res_t* res);
 
+/* Measures the SRS that several UEs transmit in the subframe. All of them must transmit SRS in this TTI */
+SRSRAN_API int srsran_enb_ul_get_srs(srsran_enb_ul_t*                   q,
+                                     srsran_ul_sf_cfg_t*                ul_sf,
+                                     srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                                     srsran_refsignal_srs_cfg_t*        cfg,
+                                     uint32_t                           nof_ue,
+                                     srsran_chest_ul_srs_res_t*         res);
+
 #endif // SRSRAN_ENB_UL_H
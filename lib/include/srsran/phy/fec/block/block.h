@@ -36,6 +36,22 @@
  */
 #define SRSRAN_FEC_BLOCK_SIZE 32U
 
+/**
+ * @brief Number of codewords decoded together by srsran_block_decode_i8_batch(), larger batches are split
+ */
+#define SRSRAN_FEC_BLOCK_MAX_BATCH 32U
+
+/**
+ * @brief Maximum number of information bits of the fast Hadamard transform decoder
+ */
+#define SRSRAN_FEC_BLOCK_FHT_MAX_NOF_BITS 13U
+
+/**
+ * @brief Maximum number of information bits for which srsran_block_decode_fht_batch() transforms several codewords in
+ * parallel
+ */
+#define SRSRAN_FEC_BLOCK_FHT_MAX_LANES_NOF_BITS 8U
+
 /**
  * @brief Encodes unpacked data using Reed–Muller code block channel coding.
  *
@@ -71,4 +87,65 @@ SRSRAN_API int32_t srsran_block_decode_i16(const int16_t* llr, uint32_t nof_llr,
  */
 SRSRAN_API int32_t srsran_block_decode_i8(const int8_t* llr, uint32_t nof_llr, uint8_t* data, uint32_t data_len);
 
+/**
+ * @brief Maximum likelihood decoding of a binary linear block code by means of a fast Walsh–Hadamard transform.
+ *
+ * The encoded bit i is the parity of the information word masked by basis[i], where the bit n of the mask selects the
+ * information bit n. The correlation of the LLRs with all the 2^nof_bits candidate words is obtained at once, which is
+ * suitable for the Reed–Muller (32, O) and (20, A) codes.
+ *
+ * @param[in] llr Provides received LLRs, positive for encoded bits equal to 1
+ * @param[in] basis Provides the basis mask of every encoded bit
+ * @param[in] nof_llr Number of LLRs
+ * @param[in] nof_bits Number of information bits, up to SRSRAN_FEC_BLOCK_FHT_MAX_NOF_BITS
+ * @param[out] word Decoded word, the first one with the highest correlation
+ * @return The correlation of the decoded word if provided arguments are valid, otherwise SRSRAN_ERROR code
+ */
+SRSRAN_API int32_t srsran_block_decode_fht(const int16_t*  llr,
+                                           const uint16_t* basis,
+                                           uint32_t        nof_llr,
+                                           uint32_t        nof_bits,
+                                           uint32_t*       word);
+
+/**
+ * @brief Same as srsran_block_decode_fht() for several codewords of the same code.
+ *
+ * @param[in] llr Provides the received LLRs of each codeword
+ * @param[in] basis Provides the basis mask of every encoded bit
+ * @param[in] nof_llr Number of LLRs of every codeword
+ * @param[in] nof_bits Number of information bits, up to SRSRAN_FEC_BLOCK_FHT_MAX_NOF_BITS
+ * @param[out] corr Correlation of the decoded word of each codeword
+ * @param[out] word Decoded word of each codeword
+ * @param[in] nof_codewords Number of codewords
+ * @return SRSRAN_SUCCESS if provided arguments are valid, otherwise SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_block_decode_fht_batch(const int16_t* const* llr,
+                                             const uint16_t*       basis,
+                                             uint32_t              nof_llr,
+                                             uint32_t              nof_bits,
+                                             int32_t*              corr,
+                                             uint32_t*             word,
+                                             uint32_t              nof_codewords);
+
+/**
+ * @brief Decodes several 8-bit signed codewords of the same data length using Reed–Muller code block channel coding.
+ *
+ * The result of each codeword is identical to srsran_block_decode_i8(). Short codewords are transformed in parallel,
+ * which is faster than decoding them one by one when several UCI of the same size are received in a slot.
+ *
+ * @param[in] llr Provides the received LLRs of each codeword
+ * @param[in] nof_llr Provides the number of available LLRs of each codeword
+ * @param[out] data Data destination to store the unpacked received bits of each codeword
+ * @param[in] data_len number of bits to decode, the maximum number of bits is SRSRAN_FEC_BLOCK_MAX_NOF_BITS
+ * @param[out] corr Decoded bits correlation of each codeword
+ * @param[in] nof_codewords Number of codewords
+ * @return SRSRAN_SUCCESS if provided arguments are valid, otherwise SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_block_decode_i8_batch(const int8_t* const* llr,
+                                            const uint32_t*      nof_llr,
+                                            uint8_t* const*      data,
+                                            uint32_t             data_len,
+                                            int32_t*             corr,
+                                            uint32_t             nof_codewords);
+
 #endif // SRSRAN_BLOCK_H
@@ -103,6 +103,11 @@ SRSRAN_API int srsran_pdsch_encode(srsran_pdsch_t*     q,
                                    uint8_t*            data[SRSRAN_MAX_CODEWORDS],
                                    cf_t*               sf_symbols[SRSRAN_MAX_PORTS]);
 
+/* Scales the OFDM symbols carrying CRS by 1/rho_b. srsran_pdsch_encode() does it for each PDSCH, unless
+ * cfg->rho_b_applied is set because the caller applies it once per subframe */
+SRSRAN_API void
+srsran_pdsch_apply_rho_b(srsran_pdsch_t* q, const srsran_pdsch_cfg_t* cfg, cf_t* sf_symbols[SRSRAN_MAX_PORTS]);
+
 SRSRAN_API int srsran_pdsch_decode(srsran_pdsch_t*        q,
                                    srsran_dl_sf_cfg_t*    sf,
                                    srsran_pdsch_cfg_t*    cfg,
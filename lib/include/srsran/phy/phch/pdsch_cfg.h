@@ -57,6 +57,7 @@ typedef struct SRSRAN_API {
   uint32_t              p_b;
   float                 rs_power;
   bool                  power_scale;
+  bool                  rho_b_applied;
   bool                  csi_enable;
   bool                  use_tbs_index_alt;
 
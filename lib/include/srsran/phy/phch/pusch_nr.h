@@ -44,6 +44,23 @@ typedef struct SRSRAN_API {
   uint32_t             max_prb;
 } srsran_pusch_nr_args_t;
 
+/**
+ * @brief Parameters that determine the UCI multiplexing positions in PUSCH, the positions are only regenerated when
+ * any of them changes
+ */
+typedef struct SRSRAN_API {
+  uint32_t l0;                                   ///< First OFDM symbol after the first DMRS symbol(s)
+  uint32_t l1;                                   ///< First OFDM symbol that does not carry DMRS
+  uint32_t M_pusch_sc[SRSRAN_NSYMB_PER_SLOT_NR]; ///< Number of PUSCH subcarriers in each OFDM symbol
+  uint32_t M_uci_sc[SRSRAN_NSYMB_PER_SLOT_NR];   ///< Number of subcarriers available for UCI in each OFDM symbol
+  uint32_t Qm;                                   ///< Modulation order
+  uint32_t Nl;                                   ///< Number of layers
+  uint32_t G_ack_rvd;                            ///< Number of reserved bits for HARQ-ACK (0 if not reserved)
+  uint32_t G_ack;                                ///< Number of encoded HARQ-ACK bits
+  uint32_t G_csi1;                               ///< Number of encoded CSI part 1 bits
+  uint32_t G_csi2;                               ///< Number of encoded CSI part 2 bits
+} srsran_pusch_nr_uci_mux_key_t;
+
 /**
  * @brief PDSCH NR object
  */
@@ -75,6 +92,11 @@ typedef struct SRSRAN_API {
   uint32_t             G_csi1;    ///< Number of encoded CSI part 1 bits
   uint32_t             G_csi2;    ///< Number of encoded CSI part 2 bits
   uint32_t             G_ulsch;   ///< Number of encoded shared channel
+
+  srsran_pusch_nr_uci_mux_key_t uci_mux_key;     ///< Parameters of the current UCI multiplexing positions
+  bool                          uci_mux_valid;   ///< Set to true if the UCI multiplexing positions are valid
+  uint32_t                      uci_mux_G_ulsch; ///< Number of UL-SCH bits of the current positions
+  uint32_t                      uci_mux_G_csi1;  ///< Number of CSI part 1 bits of the current positions
 } srsran_pusch_nr_t;
 
 /**
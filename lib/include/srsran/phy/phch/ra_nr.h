@@ -91,6 +91,78 @@ SRSRAN_API int srsran_ra_nr_fill_tb(const srsran_sch_cfg_nr_t*   pdsch_cfg,
                                     const srsran_sch_grant_nr_t* grant,
                                     uint32_t                     mcs_idx,
                                     srsran_sch_tb_t*             tb);
+
+/**
+ * @brief Maximum number of MCS indexes with a target rate in any of the MCS tables
+ */
+#define SRSRAN_RA_NR_MAX_NOF_MCS 29
+
+/**
+ * @brief Shared channel TBS table for a given MCS table, number of RE per PRB and number of layers.
+ *
+ * It provides the TBS of every MCS and number of PRB without evaluating the TBS determination procedure, and the
+ * minimum number of PRB that carry a given TBS. TB scaling (S) is not supported.
+ */
+typedef struct SRSRAN_API {
+  uint32_t                   max_prb;
+  bool                       configured;
+  srsran_mcs_table_t         mcs_table;
+  srsran_dci_format_nr_t     dci_format;
+  srsran_search_space_type_t search_space_type;
+  srsran_rnti_type_t         rnti_type;
+  uint32_t                   nof_re_prb; ///< Number of RE per PRB (N'_RE bounded to 156)
+  uint32_t                   nof_layers; ///< Number of layers of the codeword
+  uint32_t                   nof_mcs;    ///< Number of MCS indexes in the table
+  double                     R[SRSRAN_RA_NR_MAX_NOF_MCS];
+  uint32_t                   Qm[SRSRAN_RA_NR_MAX_NOF_MCS];
+  uint32_t*                  tbs;     ///< TBS, indexed as [mcs * max_prb + nof_prb - 1]
+  uint32_t*                  tbs_crc; ///< TBS plus the TB and code block CRC bits, same indexing as tbs
+} srsran_ra_nr_tbs_table_t;
+
+SRSRAN_API int srsran_ra_nr_tbs_table_init(srsran_ra_nr_tbs_table_t* q, uint32_t max_prb);
+
+SRSRAN_API void srsran_ra_nr_tbs_table_free(srsran_ra_nr_tbs_table_t* q);
+
+/**
+ * @brief Checks whether the table was computed for the MCS table, RE per PRB and layers of a given grant
+ */
+SRSRAN_API bool srsran_ra_nr_tbs_table_match(const srsran_ra_nr_tbs_table_t* q,
+                                             const srsran_sch_cfg_nr_t*      cfg,
+                                             const srsran_sch_grant_nr_t*    grant);
+
+/**
+ * @brief Computes the table for the MCS table, RE per PRB and layers of a given grant. It does nothing if the table
+ * matches already
+ * @return SRSRAN_SUCCESS if the table is ready, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ra_nr_tbs_table_set(srsran_ra_nr_tbs_table_t*    q,
+                                          const srsran_sch_cfg_nr_t*   cfg,
+                                          const srsran_sch_grant_nr_t* grant);
+
+/**
+ * @brief Gets the TBS of a grant of nof_prb PRB, same as srsran_ra_nr_fill_tb
+ * @return The TBS in bits, 0 if the inputs are out of range
+ */
+SRSRAN_API uint32_t srsran_ra_nr_tbs_table_get_tbs(const srsran_ra_nr_tbs_table_t* q,
+                                                   uint32_t                        mcs_idx,
+                                                   uint32_t                        nof_prb);
+
+/**
+ * @brief Gets the effective code rate of a grant of nof_prb PRB, same as srsran_ra_nr_fill_tb
+ * @param nof_re Number of RE of the grant excluding the reserved ones, times the number of layers
+ * @return The effective code rate, NAN if the inputs are out of range
+ */
+SRSRAN_API double srsran_ra_nr_tbs_table_get_R_prime(const srsran_ra_nr_tbs_table_t* q,
+                                                     uint32_t                        mcs_idx,
+                                                     uint32_t                        nof_prb,
+                                                     uint32_t                        nof_re);
+
+/**
+ * @brief Finds the minimum number of PRB whose TBS is at least tbs bits
+ * @return The number of PRB, SRSRAN_ERROR if not even the maximum number of PRB carries tbs bits
+ */
+SRSRAN_API int srsran_ra_nr_tbs_table_min_prb(const srsran_ra_nr_tbs_table_t* q, uint32_t mcs_idx, uint32_t tbs);
+
 /**
  * @brief Converts an unpacked DL DCI message to a PDSCH grant structure.
  * Implements the procedures defined in Section 5 of 38.214 to compute the resource allocation (5.1.2)
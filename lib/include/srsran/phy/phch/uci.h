@@ -40,6 +40,7 @@
 #define SRSRAN_UCI_MAX_CQI_LEN_PUSCH 512
 #define SRSRAN_UCI_MAX_CQI_LEN_PUCCH 13
 #define SRSRAN_UCI_CQI_CODED_PUCCH_B 20
+#define SRSRAN_UCI_MAX_CQI_BATCH 32
 #define SRSRAN_UCI_STR_MAX_CHAR 32
 
 typedef struct SRSRAN_API {
@@ -52,7 +53,6 @@ typedef struct SRSRAN_API {
 
 typedef struct SRSRAN_API {
   uint8_t** cqi_table;
-  int16_t** cqi_table_s;
 } srsran_uci_cqi_pucch_t;
 
 SRSRAN_API void srsran_uci_cqi_pucch_init(srsran_uci_cqi_pucch_t* q);
@@ -72,6 +72,17 @@ SRSRAN_API int16_t srsran_uci_decode_cqi_pucch(srsran_uci_cqi_pucch_t* q,
                                                uint8_t*                cqi_data,
                                                uint32_t                cqi_len);
 
+/* Decodes the CQI/PMI reports of several PUCCH format 2 transmissions, e.g. all the reports of a subframe. The
+ * result of every report is identical to srsran_uci_decode_cqi_pucch(), the reports with the same length are decoded
+ * together. Returns SRSRAN_SUCCESS or SRSRAN_ERROR_INVALID_INPUTS.
+ */
+SRSRAN_API int srsran_uci_decode_cqi_pucch_batch(srsran_uci_cqi_pucch_t* q,
+                                                 int16_t* const*         b_bits,
+                                                 uint8_t* const*         cqi_data,
+                                                 const uint32_t*         cqi_len,
+                                                 int16_t*                corr,
+                                                 uint32_t                nof_reports);
+
 SRSRAN_API int srsran_uci_cqi_init(srsran_uci_cqi_pusch_t* q);
 
 SRSRAN_API void srsran_uci_cqi_free(srsran_uci_cqi_pusch_t* q);
@@ -126,6 +126,29 @@ SRSRAN_API int srsran_uci_nr_decode_pucch(srsran_uci_nr_t*                  q,
                                           int8_t*                           llr,
                                           srsran_uci_value_nr_t*            value);
 
+/**
+ * @brief Decodes the UCI bits of several PUCCH transmissions, for example, the PUCCH of all the UEs in a slot
+ *
+ * The UCI with 3 to 11 bits are decoded together with srsran_block_decode_i8_batch(), grouped by number of bits. The
+ * rest are decoded one by one. The result is identical to calling srsran_uci_nr_decode_pucch() for every UCI.
+ *
+ * @attention Compatible only with PUCCH formats 2, 3 and 4
+ *
+ * @param[in,out] q NR-UCI object
+ * @param[in] pucch_resource_cfg PUCCH resource of each UCI
+ * @param[in] uci_cfg Configuration of each UCI
+ * @param[in] llr Received LLRs of each UCI
+ * @param[out] value Decoded value of each UCI
+ * @param[in] nof_uci Number of UCI
+ * @return SRSRAN_SUCCESSFUL if it is successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_uci_nr_decode_pucch_batch(srsran_uci_nr_t*                         q,
+                                                const srsran_pucch_nr_resource_t* const* pucch_resource_cfg,
+                                                const srsran_uci_cfg_nr_t* const*        uci_cfg,
+                                                int8_t* const*                           llr,
+                                                srsran_uci_value_nr_t* const*            value,
+                                                uint32_t                                 nof_uci);
+
 /**
  * @brief Calculates total number of encoded bits for HARQ-ACK multiplexing in PUSCH
  * @param[in] cfg PUSCH transmission configuration
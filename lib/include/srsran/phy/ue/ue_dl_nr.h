@@ -38,6 +38,11 @@
  */
 #define SRSRAN_MAX_DCI_MSG_NR 4
 
+/**
+ * Maximum number of NZP-CSI-RS sets whose measurement tables are kept
+ */
+#define SRSRAN_UE_DL_NR_MAX_NOF_CSI_RS_TABLES 4
+
 typedef struct SRSRAN_API {
   srsran_pdsch_nr_args_t pdsch;
   srsran_pdcch_nr_args_t pdcch;
@@ -87,6 +92,10 @@ typedef struct SRSRAN_API {
 
   srsran_dci_msg_nr_t ul_dci_msg[SRSRAN_MAX_DCI_MSG_NR];
   uint32_t            ul_dci_count;
+
+  /// Cached NZP-CSI-RS measurement tables of the most recently measured sets, replaced in round-robin
+  srsran_csi_rs_nzp_table_t csi_rs_nzp_tables[SRSRAN_UE_DL_NR_MAX_NOF_CSI_RS_TABLES];
+  uint32_t                  csi_rs_nzp_table_next;
 } srsran_ue_dl_nr_t;
 
 SRSRAN_API int
@@ -128,13 +137,13 @@ SRSRAN_API uint32_t srsran_ue_dl_nr_pdsch_info(const srsran_ue_dl_nr_t*    q,
                                                uint32_t                    str_len);
 
 SRSRAN_API
-int srsran_ue_dl_nr_csi_measure_trs(const srsran_ue_dl_nr_t*       q,
+int srsran_ue_dl_nr_csi_measure_trs(srsran_ue_dl_nr_t*             q,
                                     const srsran_slot_cfg_t*       slot_cfg,
                                     const srsran_csi_rs_nzp_set_t* csi_rs_nzp_set,
                                     srsran_csi_trs_measurements_t* measurement);
 
 SRSRAN_API
-int srsran_ue_dl_nr_csi_measure_channel(const srsran_ue_dl_nr_t*           q,
+int srsran_ue_dl_nr_csi_measure_channel(srsran_ue_dl_nr_t*                 q,
                                         const srsran_slot_cfg_t*           slot_cfg,
                                         const srsran_csi_rs_nzp_set_t*     csi_rs_nzp_set,
                                         srsran_csi_channel_measurements_t* measurement);
@@ -244,6 +244,9 @@ SRSRAN_API float srsran_vec_avg_power_sf(const int16_t* x, const uint32_t len);
 SRSRAN_API float srsran_vec_avg_power_bf(const int8_t* x, const uint32_t len);
 SRSRAN_API float srsran_vec_avg_power_ff(const float* x, const uint32_t len);
 
+/* average and peak vector power, i.e. mean and maximum of |x|^2, computed in a single pass */
+SRSRAN_API void srsran_vec_power_peak_cf(const cf_t* x, const uint32_t len, float* avg_power, float* peak_power);
+
 /* Correlation between complex vectors x and y */
 SRSRAN_API float srsran_vec_corr_ccc(const cf_t* x, cf_t* y, const uint32_t len);
 
@@ -145,6 +145,9 @@ SRSRAN_API uint32_t srsran_vec_max_abs_fi_simd(const float* x, const int len);
 
 SRSRAN_API uint32_t srsran_vec_max_ci_simd(const cf_t* x, const int len);
 
+/* SIMD power measurement, returns the sum and the maximum of |x|^2 in a single pass */
+SRSRAN_API void srsran_vec_power_peak_cf_simd(const cf_t* x, const int len, float* sum_power, float* max_power);
+
 #ifdef __cplusplus
 }
 #endif
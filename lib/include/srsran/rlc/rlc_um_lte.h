@@ -94,6 +94,7 @@ private:
 
   private:
     void reset();
+    void handle_reordering_timeout();
 
     // Rx window
     std::map<uint32_t, rlc_umd_pdu_t> rx_window;
@@ -113,6 +114,9 @@ private:
      ***************************************************************************/
     srsran::timer_handler::unique_timer reordering_timer;
 
+    // The PDUs may be received outside of the stack thread, which runs the reordering timer
+    std::mutex mutex;
+
     // helper functions
     void debug_state();
   };
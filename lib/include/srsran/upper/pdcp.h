@@ -73,6 +73,13 @@ public:
 
   // eNB-only methods
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint32_t lcid);
+  bool                                             add_split_bearer_leg(uint32_t                       lcid,
+                                                                        srsue::rlc_interface_pdcp*     leg_rlc,
+                                                                        uint32_t                       leg_lcid,
+                                                                        const pdcp_split_bearer_cfg_t& split_cfg);
+  void                                             del_split_bearer_leg(uint32_t lcid);
+  /// Returns true if "lcid" is an LTE DRB. The reception of its data PDUs only uses the RX state of the bearer
+  bool                                             is_lte_drb(uint32_t lcid);
 
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
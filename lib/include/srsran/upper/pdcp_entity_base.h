@@ -33,6 +33,13 @@
 #include "srsran/interfaces/pdcp_interface_types.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include "srsran/upper/pdcp_metrics.h"
+#include "srsran/upper/pdcp_split_bearer.h"
+
+namespace srsue {
+
+class rlc_interface_pdcp;
+
+} // namespace srsue
 
 namespace srsran {
 
@@ -73,6 +80,7 @@ public:
   bool is_active() { return active; }
   bool is_srb() { return cfg.rb_type == PDCP_RB_IS_SRB; }
   bool is_drb() { return cfg.rb_type == PDCP_RB_IS_DRB; }
+  bool is_lte() { return cfg.rat == srsran_rat_t::lte; }
 
   // RRC interface
   void enable_integrity(srsran_direction_t direction = DIRECTION_TXRX)
@@ -133,6 +141,15 @@ public:
 
   virtual void send_status_report() = 0;
 
+  // Split bearer interface. The secondary RLC leg is only supported by the NR PDCP
+  virtual bool add_split_bearer_leg(srsue::rlc_interface_pdcp*     leg_rlc,
+                                    uint32_t                       leg_lcid,
+                                    const pdcp_split_bearer_cfg_t& split_cfg)
+  {
+    return false;
+  }
+  virtual void del_split_bearer_leg() {}
+
   // COUNT, HFN and SN helpers
   uint32_t HFN(uint32_t count);
   uint32_t SN(uint32_t count);
@@ -23,6 +23,7 @@
 #define SRSRAN_PDCP_ENTITY_NR_H
 
 #include "pdcp_entity_base.h"
+#include "pdcp_nr_rx_buffer.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/interfaces_common.h"
@@ -70,6 +71,17 @@ public:
 
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
 
+  // Split bearer: DL PDUs are distributed over the RLC of this entity (primary leg) and a secondary RLC leg
+  bool add_split_bearer_leg(srsue::rlc_interface_pdcp*     leg_rlc,
+                            uint32_t                       leg_lcid,
+                            const pdcp_split_bearer_cfg_t& split_cfg) final;
+  void del_split_bearer_leg() final;
+  bool is_split_bearer() const { return split_flow_ctrl != nullptr; }
+  pdcp_split_bearer_flow_ctrl::leg_metrics_t get_split_leg_metrics(pdcp_split_bearer_flow_ctrl::leg_t leg) const
+  {
+    return is_split_bearer() ? split_flow_ctrl->get_metrics(leg) : pdcp_split_bearer_flow_ctrl::leg_metrics_t{};
+  }
+
   // State variable getters (useful for testing)
   uint32_t nof_discard_timers() { return discard_timers_map.size(); }
   bool     is_reordering_timer_running() { return reordering_timer.is_running(); }
@@ -99,12 +111,13 @@ private:
   uint32_t window_size = 0;
 
   // Reordering Queue / Timers
-  std::map<uint32_t, unique_byte_buffer_t> reorder_queue;
-  timer_handler::unique_timer              reordering_timer;
+  pdcp_nr_rx_buffer                 reorder_queue;
+  timer_handler::unique_timer       reordering_timer;
+  std::vector<unique_byte_buffer_t> rx_batch; ///< In-sequence SDUs waiting to be passed to the upper layers
 
   // Pass to Upper Layers Helper function
   void deliver_all_consecutive_counts();
-  void pass_to_upper_layers(unique_byte_buffer_t pdu);
+  void pass_to_upper_layers();
 
   // Reodering callback (t-Reordering)
   class reordering_callback;
@@ -118,6 +131,18 @@ private:
   bool tx_overflow = false;
   bool rx_overflow = false;
 
+  // Split bearer. The leg of the COUNTs with a running discard timer is kept, so that discards reach the right RLC
+  srsue::rlc_interface_pdcp*                             split_rlc  = nullptr;
+  uint32_t                                               split_lcid = 0;
+  std::unique_ptr<pdcp_split_bearer_flow_ctrl>           split_flow_ctrl;
+  timer_handler::unique_timer                            split_feedback_timer;
+  std::map<uint32_t, pdcp_split_bearer_flow_ctrl::leg_t> split_leg_map;
+
+  bool lower_layers_full();
+  void write_to_lower_layers(unique_byte_buffer_t pdu);
+  void discard_in_lower_layers(uint32_t discard_count);
+  void handle_split_feedback();
+
   enum class rlc_mode_t {
     UM,
     AM,
@@ -157,13 +182,19 @@ private:
 /*
  * Helpers
  */
-inline void pdcp_entity_nr::pass_to_upper_layers(unique_byte_buffer_t sdu)
+inline void pdcp_entity_nr::pass_to_upper_layers()
 {
+  if (rx_batch.empty()) {
+    return;
+  }
   if (is_srb()) {
-    rrc->write_pdu(lcid, std::move(sdu));
+    for (unique_byte_buffer_t& sdu : rx_batch) {
+      rrc->write_pdu(lcid, std::move(sdu));
+    }
   } else {
-    gw->write_pdu(lcid, std::move(sdu));
+    gw->write_pdu_batch(lcid, rx_batch);
   }
+  rx_batch.clear();
 }
 
 } // namespace srsran
@@ -39,6 +39,11 @@ typedef struct {
   uint64_t tx_notification_latency_ms; //< Average time in ms from PDU delivery to RLC to ACK notification from RLC
   uint32_t num_tx_buffered_pdus;       //< Number of PDUs waiting for ACK
   uint32_t num_tx_buffered_pdus_bytes; //< Number of bytes of PDUs waiting for ACK
+
+  // Reordering specific metrics (NR PDCP)
+  uint32_t num_rx_reordered_pdus;      //< Number of PDUs that arrived out of order and waited in the reordering buffer
+  uint32_t num_rx_reordering_timeouts; //< Number of t-Reordering expiries
+  uint32_t num_rx_lost_pdus;           //< Number of COUNTs given up at t-Reordering expiry
 } pdcp_bearer_metrics_t;
 
 typedef struct {
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PDCP_NR_RX_BUFFER_H
+#define SRSRAN_PDCP_NR_RX_BUFFER_H
+
+#include "srsran/common/byte_buffer.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Reception buffer of the NR PDCP entity (TS 38.323, section 5.2.2), where PDUs are stored in a ring indexed by
+ * COUNT modulo the ring capacity. A bitmap of received COUNTs allows finding runs of in-sequence PDUs with word
+ * operations, rather than walking a tree per PDU.
+ * All stored COUNTs must lie in [base, base + capacity), where base is the RX_DELIV of the entity. The capacity
+ * starts small and is doubled on demand up to the PDCP window size, so that idle bearers do not hold large rings.
+ */
+class pdcp_nr_rx_buffer
+{
+  static const uint32_t initial_capacity = 256;
+  static const uint32_t bits_per_word    = 64;
+
+public:
+  pdcp_nr_rx_buffer() { resize(initial_capacity); }
+
+  /// Sets the maximum distance between the base and a stored COUNT, i.e. the PDCP window size (a power of 2)
+  void set_max_capacity(uint32_t window_size)
+  {
+    srsran_assert((window_size & (window_size - 1)) == 0, "The window size must be a power of 2");
+    max_capacity = window_size > initial_capacity ? window_size : initial_capacity;
+  }
+
+  uint32_t capacity() const { return slots.size(); }
+  size_t   size() const { return nof_pdus; }
+  bool     empty() const { return nof_pdus == 0; }
+
+  bool has_count(uint32_t base, uint32_t count) const
+  {
+    if (count - base >= capacity()) {
+      return false;
+    }
+    uint32_t idx = count & mask;
+    return (rcvd[idx / bits_per_word] >> (idx % bits_per_word)) & 1U;
+  }
+
+  /// Stores a PDU, whose COUNT must not be present yet. Returns false if the COUNT lies outside of the window
+  bool add(uint32_t base, uint32_t count, unique_byte_buffer_t pdu)
+  {
+    uint32_t offset = count - base;
+    if (offset >= capacity() and not grow(base, offset)) {
+      return false;
+    }
+    srsran_assert(not has_count(base, count), "COUNT=%u is already present", count);
+    uint32_t idx = count & mask;
+    slots[idx]   = std::move(pdu);
+    rcvd[idx / bits_per_word] |= (uint64_t)1U << (idx % bits_per_word);
+    nof_pdus++;
+    return true;
+  }
+
+  /// Removes the PDU with the given COUNT, which must be present
+  unique_byte_buffer_t pop(uint32_t count)
+  {
+    uint32_t idx = count & mask;
+    srsran_assert((rcvd[idx / bits_per_word] >> (idx % bits_per_word)) & 1U, "COUNT=%u is not present", count);
+    rcvd[idx / bits_per_word] &= ~((uint64_t)1U << (idx % bits_per_word));
+    nof_pdus--;
+    return std::move(slots[idx]);
+  }
+
+  /// Returns the first COUNT in [from, end) that was not received, or end if all were received
+  uint32_t find_first_missing(uint32_t from, uint32_t end) const
+  {
+    end            = clamp_end(from, end);
+    uint32_t count = from;
+    while (count != end) {
+      uint32_t idx       = count & mask;
+      uint32_t bit       = idx % bits_per_word;
+      uint32_t word_bits = std::min(bits_per_word - bit, end - count);
+      uint64_t missing   = ~rcvd[idx / bits_per_word] >> bit;
+      if (missing != 0) {
+        uint32_t n = __builtin_ctzll(missing);
+        if (n < word_bits) {
+          return count + n;
+        }
+      }
+      count += word_bits;
+    }
+    return end;
+  }
+
+  /// Pops all the PDUs with COUNT in [from, end) in ascending order of COUNT, passing them to "f(count, pdu)"
+  template <typename Func>
+  void pop_range(uint32_t from, uint32_t end, Func&& f)
+  {
+    end            = clamp_end(from, end);
+    uint32_t count = from;
+    while (count != end and nof_pdus > 0) {
+      uint32_t idx       = count & mask;
+      uint32_t bit       = idx % bits_per_word;
+      uint32_t word_bits = std::min(bits_per_word - bit, end - count);
+      uint64_t present   = rcvd[idx / bits_per_word] >> bit;
+      if (word_bits < bits_per_word) {
+        present &= ((uint64_t)1U << word_bits) - 1;
+      }
+      while (present != 0) {
+        uint32_t c = count + __builtin_ctzll(present);
+        present &= present - 1;
+        f(c, pop(c));
+      }
+      count += word_bits;
+    }
+  }
+
+  void clear()
+  {
+    resize(initial_capacity);
+    nof_pdus = 0;
+  }
+
+private:
+  /// Ranges are limited to one ring turn, as all stored COUNTs are within [base, base + capacity)
+  uint32_t clamp_end(uint32_t from, uint32_t end) const { return (end - from > capacity()) ? from + capacity() : end; }
+
+  void resize(uint32_t new_capacity)
+  {
+    slots.clear();
+    slots.resize(new_capacity);
+    rcvd.assign(new_capacity / bits_per_word, 0);
+    mask = new_capacity - 1;
+  }
+
+  /// Doubles the capacity until "base + offset" fits, re-indexing the stored PDUs
+  bool grow(uint32_t base, uint32_t offset)
+  {
+    if (offset >= max_capacity) {
+      return false;
+    }
+    uint32_t new_capacity = capacity();
+    while (new_capacity <= offset) {
+      new_capacity *= 2;
+    }
+    std::vector<unique_byte_buffer_t> old_slots;
+    std::vector<uint64_t>             old_rcvd;
+    old_slots.swap(slots);
+    old_rcvd.swap(rcvd);
+    uint32_t old_mask = mask;
+    resize(new_capacity);
+    for (uint32_t idx = 0; idx < old_slots.size(); ++idx) {
+      if ((old_rcvd[idx / bits_per_word] >> (idx % bits_per_word)) & 1U) {
+        uint32_t count   = base + ((idx - base) & old_mask);
+        uint32_t new_idx = count & mask;
+        slots[new_idx]   = std::move(old_slots[idx]);
+        rcvd[new_idx / bits_per_word] |= (uint64_t)1U << (new_idx % bits_per_word);
+      }
+    }
+    return true;
+  }
+
+  std::vector<unique_byte_buffer_t> slots;
+  std::vector<uint64_t>             rcvd; ///< Bitmap of occupied slots
+  uint32_t                          mask         = 0;
+  uint32_t                          max_capacity = initial_capacity;
+  size_t                            nof_pdus     = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PDCP_NR_RX_BUFFER_H
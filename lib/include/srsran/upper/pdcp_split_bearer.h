@@ -0,0 +1,99 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PDCP_SPLIT_BEARER_H
+#define SRSRAN_PDCP_SPLIT_BEARER_H
+
+#include <array>
+#include <stdint.h>
+
+namespace srsran {
+
+/// Configuration of the flow control between the two RLC legs of a split bearer (e.g. NR and LTE legs in EN-DC)
+struct pdcp_split_bearer_cfg_t {
+  /// While the primary leg holds fewer bytes than this, PDUs are only sent over the primary leg
+  uint32_t split_threshold_bytes = 0;
+  /// Maximum expected queuing delay (in ms) of a leg. New SDUs are dropped while neither leg can meet it
+  uint32_t max_leg_delay_ms = 50;
+  /// Minimum time (in ms) between two samples of the RLC buffer occupancy of the legs
+  uint32_t feedback_period_ms = 1;
+  /// Throughput assumed for a leg until it has been measured
+  uint32_t initial_rate_bytes_per_ms = 5000;
+  /// Weight of the last throughput measurement in the throughput moving average of a leg
+  float rate_avg_coeff = 0.1f;
+};
+
+/**
+ * Distribution of DL PDCP PDUs of a split bearer over its RLC legs.
+ * The buffer occupancy of the RLC of each leg is sampled periodically. The throughput of a leg is derived from the
+ * amount of bytes drained from its buffer between samples, and each PDU is sent over the leg where its expected
+ * queuing delay, i.e. the leg occupancy divided by the leg throughput, is smallest. Balancing the delays of both legs
+ * keeps the skew, and hence the reordering effort at the receiver, small.
+ */
+class pdcp_split_bearer_flow_ctrl
+{
+public:
+  enum leg_t { primary_leg = 0, secondary_leg, nof_legs };
+
+  struct leg_metrics_t {
+    uint64_t num_tx_pdus       = 0;
+    uint64_t num_tx_pdu_bytes  = 0;
+    uint32_t buffered_bytes    = 0; ///< Last sampled occupancy of the RLC of the leg
+    double   rate_bytes_per_ms = 0; ///< Estimated throughput of the leg
+  };
+
+  explicit pdcp_split_bearer_flow_ctrl(const pdcp_split_bearer_cfg_t& cfg_);
+
+  const pdcp_split_bearer_cfg_t& get_cfg() const { return cfg; }
+
+  /// Handles a sample of the RLC buffer occupancy of a leg, taken "elapsed_ms" after the previous one
+  void handle_buffer_state(leg_t leg, uint32_t buffered_bytes, uint32_t elapsed_ms);
+
+  /// Selects the leg over which a PDU of "pdu_len" bytes is sent, and accounts for it in the leg occupancy. A leg whose
+  /// RLC SDU queue is full is only selected if the other one is full too.
+  leg_t select_leg(uint32_t pdu_len, bool primary_queue_full = false, bool secondary_queue_full = false);
+
+  /// Whether a PDU of "pdu_len" bytes would exceed the maximum queuing delay on both legs
+  bool is_congested(uint32_t pdu_len) const;
+
+  /// Estimated number of bytes in the RLC buffer of a leg, including the PDUs written since the last sample
+  uint32_t get_occupancy(leg_t leg) const { return legs[leg].buffered_bytes + legs[leg].written_bytes; }
+
+  leg_metrics_t get_metrics(leg_t leg) const;
+
+private:
+  struct leg_ctxt_t {
+    uint32_t buffered_bytes    = 0; ///< Occupancy at the last sample
+    uint32_t written_bytes     = 0; ///< Bytes written to the leg since the last sample
+    double   rate_bytes_per_ms = 0;
+    uint64_t num_tx_pdus       = 0;
+    uint64_t num_tx_pdu_bytes  = 0;
+  };
+
+  double expected_delay_ms(leg_t leg, uint32_t pdu_len) const;
+
+  pdcp_split_bearer_cfg_t          cfg;
+  std::array<leg_ctxt_t, nof_legs> legs;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PDCP_SPLIT_BEARER_H
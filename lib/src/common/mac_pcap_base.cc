@@ -65,6 +65,11 @@ void mac_pcap_base::run_thread()
     {
       std::lock_guard<std::mutex> lock(mutex);
       write_pdu(pdu);
+      // Write the PDUs that are already queued before flushing, bounded by the queue size to limit the delay
+      for (size_t n = 1; n < queue.max_size() and queue.try_pop(pdu); ++n) {
+        write_pdu(pdu);
+      }
+      flush_pdus();
     }
   }
 
@@ -74,6 +79,8 @@ void mac_pcap_base::run_thread()
     std::lock_guard<std::mutex> lock(mutex);
     write_pdu(pdu);
   }
+  std::lock_guard<std::mutex> lock(mutex);
+  flush_pdus();
 }
 
 // Function called from PHY worker context, locking not needed as PDU queue is thread-safe
@@ -109,9 +116,11 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
       memcpy(pdu.pdu->msg, payload, payload_len);
       pdu.pdu->N_bytes = payload_len;
       if (not queue.try_push(std::move(pdu))) {
+        nof_dropped_pdus.fetch_add(1, std::memory_order_relaxed);
         logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
       }
     } else {
+      nof_dropped_pdus.fetch_add(1, std::memory_order_relaxed);
       logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
     }
   }
@@ -146,9 +155,11 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
       memcpy(pdu.pdu->msg, payload, payload_len);
       pdu.pdu->N_bytes = payload_len;
       if (not queue.try_push(std::move(pdu))) {
+        nof_dropped_pdus.fetch_add(1, std::memory_order_relaxed);
         logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
       }
     } else {
+      nof_dropped_pdus.fetch_add(1, std::memory_order_relaxed);
       logger.warning("Dropping PDU in NR PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
     }
   }
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/mac_pcap_net.h"
+#include <sys/time.h>
 
 namespace srsran {
 
@@ -29,11 +30,13 @@ mac_pcap_net::~mac_pcap_net()
 {
   close();
 }
-uint32_t mac_pcap_net::open(std::string client_ip_addr_,
-                            std::string bind_addr_str,
-                            uint16_t    client_udp_port_,
-                            uint16_t    bind_udp_port_,
-                            uint32_t    ue_id_)
+
+uint32_t mac_pcap_net::open(std::string                     client_ip_addr_,
+                            std::string                     bind_addr_str,
+                            uint16_t                        client_udp_port_,
+                            uint16_t                        bind_udp_port_,
+                            uint32_t                        ue_id_,
+                            const mac_pcap_net_batch_cfg_t& batch_cfg_)
 {
   std::lock_guard<std::mutex> lock(mutex);
 
@@ -63,8 +66,34 @@ uint32_t mac_pcap_net::open(std::string client_ip_addr_,
     logger.error("Invalid client_ip_addr: %s", client_ip_addr_.c_str());
     return SRSRAN_ERROR;
   }
-  running                     = true;
-  ue_id                       = ue_id_;
+
+  batch_cfg = batch_cfg_;
+  if (batch_cfg.enable) {
+    // The largest MAC PDU must fit in a datagram, together with its framing and context
+    uint32_t min_datagram_size = mac_pcap_net_batch::hdr_len + mac_pcap_net_batch::record_hdr_len +
+                                 PCAP_CONTEXT_HEADER_MAX + SRSRAN_MAX_BUFFER_SIZE_BYTES;
+    batch_cfg.max_datagram_size      = std::min(std::max(batch_cfg.max_datagram_size, min_datagram_size), 65507U);
+    batch_cfg.max_datagrams_per_send = std::max(batch_cfg.max_datagrams_per_send, 1U);
+
+    tx_buffer.resize(batch_cfg.max_datagram_size * batch_cfg.max_datagrams_per_send);
+    datagram_lengths.assign(batch_cfg.max_datagrams_per_send, 0);
+    datagram_nof_records.assign(batch_cfg.max_datagrams_per_send, 0);
+    msgs.assign(batch_cfg.max_datagrams_per_send, {});
+    iovs.assign(batch_cfg.max_datagrams_per_send, {});
+    for (uint32_t i = 0; i < batch_cfg.max_datagrams_per_send; ++i) {
+      iovs[i].iov_base            = get_datagram(i);
+      msgs[i].msg_hdr.msg_name    = &client_addr;
+      msgs[i].msg_hdr.msg_namelen = sizeof(client_addr);
+      msgs[i].msg_hdr.msg_iov     = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen  = 1;
+    }
+    nof_closed_datagrams = 0;
+    cur_offset           = 0;
+    logger.info("Aggregating MAC PCAP frames in datagrams of up to %d bytes", batch_cfg.max_datagram_size);
+  }
+
+  running = true;
+  ue_id   = ue_id_;
   // start writer thread
   start();
 
@@ -95,8 +124,23 @@ uint32_t mac_pcap_net::close()
   return SRSRAN_SUCCESS;
 }
 
+mac_pcap_net_metrics_t mac_pcap_net::get_metrics() const
+{
+  mac_pcap_net_metrics_t metrics;
+  metrics.nof_pdus         = nof_pdus_sent.load(std::memory_order_relaxed);
+  metrics.nof_bytes        = nof_bytes_sent.load(std::memory_order_relaxed);
+  metrics.nof_datagrams    = nof_datagrams_sent.load(std::memory_order_relaxed);
+  metrics.nof_syscalls     = nof_syscalls.load(std::memory_order_relaxed);
+  metrics.nof_dropped_pdus = get_nof_dropped_pdus() + nof_socket_dropped_pdus.load(std::memory_order_relaxed);
+  return metrics;
+}
+
 void mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
 {
+  if (pdu.pdu != nullptr && socket.is_open() && batch_cfg.enable) {
+    write_pdu_to_batch(pdu);
+    return;
+  }
   if (pdu.pdu != nullptr && socket.is_open()) {
     switch (pdu.rat) {
       case srsran_rat_t::lte:
@@ -139,10 +183,16 @@ void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
                       (const struct sockaddr*)&client_addr,
                       sizeof(client_addr));
 
+  nof_syscalls.fetch_add(1, std::memory_order_relaxed);
   if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
+    nof_socket_dropped_pdus.fetch_add(1, std::memory_order_relaxed);
     logger.error(
         "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+    return;
   }
+  nof_pdus_sent.fetch_add(1, std::memory_order_relaxed);
+  nof_datagrams_sent.fetch_add(1, std::memory_order_relaxed);
+  nof_bytes_sent.fetch_add(bytes_sent, std::memory_order_relaxed);
 }
 
 void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
@@ -173,9 +223,115 @@ void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
                       (const struct sockaddr*)&client_addr,
                       sizeof(client_addr));
 
+  nof_syscalls.fetch_add(1, std::memory_order_relaxed);
   if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
+    nof_socket_dropped_pdus.fetch_add(1, std::memory_order_relaxed);
     logger.error(
         "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+    return;
   }
+  nof_pdus_sent.fetch_add(1, std::memory_order_relaxed);
+  nof_datagrams_sent.fetch_add(1, std::memory_order_relaxed);
+  nof_bytes_sent.fetch_add(bytes_sent, std::memory_order_relaxed);
 }
+
+void mac_pcap_net::write_pdu_to_batch(pcap_pdu_t& pdu)
+{
+  // Record payload prefix, i.e. the start string and MAC context, as in the UDP PCAP files
+  uint8_t     context[PCAP_CONTEXT_HEADER_MAX + 8];
+  const char* start_str   = (pdu.rat == srsran_rat_t::nr) ? MAC_NR_START_STRING : MAC_LTE_START_STRING;
+  uint32_t    context_len = strlen(start_str);
+  memcpy(context, start_str, context_len);
+  switch (pdu.rat) {
+    case srsran_rat_t::lte:
+      context_len += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context, context + context_len, PCAP_CONTEXT_HEADER_MAX);
+      break;
+    case srsran_rat_t::nr:
+      context_len += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context_nr, context + context_len, PCAP_CONTEXT_HEADER_MAX);
+      break;
+    default:
+      logger.error("Error writing PDU to PCAP socket. Unsupported RAT selected.");
+      return;
+  }
+  uint32_t payload_len = context_len + pdu.pdu->N_bytes;
+  uint32_t record_len  = mac_pcap_net_batch::record_hdr_len + payload_len;
+
+  // Start a new datagram if the record does not fit in the open one
+  if (cur_offset + record_len > batch_cfg.max_datagram_size) {
+    close_datagram();
+  }
+  if (nof_closed_datagrams == batch_cfg.max_datagrams_per_send) {
+    send_datagrams();
+  }
+  timeval now;
+  gettimeofday(&now, nullptr);
+  if (cur_offset == 0) {
+    cur_offset      = mac_pcap_net_batch::hdr_len;
+    cur_nof_records = 0;
+    cur_ts          = now;
+  }
+
+  uint32_t ts_offset_usec = (now.tv_sec - cur_ts.tv_sec) * 1000000 + (now.tv_usec - cur_ts.tv_usec);
+  uint8_t* ptr            = get_datagram(nof_closed_datagrams) + cur_offset;
+  mac_pcap_net_batch::pack_record_header(payload_len, ts_offset_usec, ptr);
+  ptr += mac_pcap_net_batch::record_hdr_len;
+  memcpy(ptr, context, context_len);
+  memcpy(ptr + context_len, pdu.pdu->msg, pdu.pdu->N_bytes);
+  cur_offset += record_len;
+  cur_nof_records++;
+}
+
+void mac_pcap_net::close_datagram()
+{
+  if (cur_offset == 0) {
+    return;
+  }
+  mac_pcap_net_batch::header_t hdr;
+  hdr.nof_records      = cur_nof_records;
+  hdr.seq_nr           = seq_nr++;
+  hdr.nof_dropped_pdus = get_nof_dropped_pdus() + nof_socket_dropped_pdus.load(std::memory_order_relaxed);
+  hdr.ts               = cur_ts;
+  mac_pcap_net_batch::pack_header(hdr, get_datagram(nof_closed_datagrams));
+
+  datagram_lengths[nof_closed_datagrams]     = cur_offset;
+  datagram_nof_records[nof_closed_datagrams] = cur_nof_records;
+  iovs[nof_closed_datagrams].iov_len         = cur_offset;
+  nof_closed_datagrams++;
+  cur_offset = 0;
+}
+
+void mac_pcap_net::send_datagrams()
+{
+  uint32_t nof_sent = 0;
+  while (nof_sent < nof_closed_datagrams) {
+    int ret = sendmmsg(socket.get_socket(), &msgs[nof_sent], nof_closed_datagrams - nof_sent, 0);
+    nof_syscalls.fetch_add(1, std::memory_order_relaxed);
+    if (ret <= 0) {
+      // Discard the remaining datagrams
+      uint32_t nof_dropped = 0;
+      for (uint32_t i = nof_sent; i < nof_closed_datagrams; ++i) {
+        nof_dropped += datagram_nof_records[i];
+      }
+      nof_socket_dropped_pdus.fetch_add(nof_dropped, std::memory_order_relaxed);
+      logger.error("Sending %d UDP packets failed (err %s)", nof_closed_datagrams - nof_sent, strerror(errno));
+      break;
+    }
+    for (uint32_t i = nof_sent; i < nof_sent + ret; ++i) {
+      nof_pdus_sent.fetch_add(datagram_nof_records[i], std::memory_order_relaxed);
+      nof_bytes_sent.fetch_add(datagram_lengths[i], std::memory_order_relaxed);
+    }
+    nof_datagrams_sent.fetch_add(ret, std::memory_order_relaxed);
+    nof_sent += ret;
+  }
+  nof_closed_datagrams = 0;
+}
+
+void mac_pcap_net::flush_pdus()
+{
+  if (batch_cfg.enable and socket.is_open()) {
+    close_datagram();
+    send_datagrams();
+  }
+}
+
 } // namespace srsran
\ No newline at end of file
@@ -0,0 +1,258 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/mac_pcap_net_batch.h"
+#include "srsran/common/pcap.h"
+#include "srsran/srslog/srslog.h"
+#include <arpa/inet.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+
+namespace srsran {
+
+namespace mac_pcap_net_batch {
+
+static void pack_u16(uint16_t v, uint8_t* buffer)
+{
+  v = htons(v);
+  memcpy(buffer, &v, sizeof(v));
+}
+
+static void pack_u32(uint32_t v, uint8_t* buffer)
+{
+  v = htonl(v);
+  memcpy(buffer, &v, sizeof(v));
+}
+
+static uint16_t unpack_u16(const uint8_t* buffer)
+{
+  uint16_t v;
+  memcpy(&v, buffer, sizeof(v));
+  return ntohs(v);
+}
+
+static uint32_t unpack_u32(const uint8_t* buffer)
+{
+  uint32_t v;
+  memcpy(&v, buffer, sizeof(v));
+  return ntohl(v);
+}
+
+void pack_header(const header_t& hdr, uint8_t* buffer)
+{
+  pack_u32(magic, buffer);
+  buffer[4] = version;
+  buffer[5] = 0;
+  pack_u16(hdr.nof_records, buffer + 6);
+  pack_u32(hdr.seq_nr, buffer + 8);
+  pack_u32(hdr.nof_dropped_pdus, buffer + 12);
+  pack_u32(hdr.ts.tv_sec, buffer + 16);
+  pack_u32(hdr.ts.tv_usec, buffer + 20);
+}
+
+bool unpack_header(const uint8_t* buffer, uint32_t len, header_t& hdr)
+{
+  if (len < hdr_len or unpack_u32(buffer) != magic or buffer[4] != version) {
+    return false;
+  }
+  hdr.nof_records      = unpack_u16(buffer + 6);
+  hdr.seq_nr           = unpack_u32(buffer + 8);
+  hdr.nof_dropped_pdus = unpack_u32(buffer + 12);
+  hdr.ts.tv_sec        = unpack_u32(buffer + 16);
+  hdr.ts.tv_usec       = unpack_u32(buffer + 20);
+  return true;
+}
+
+void pack_record_header(uint16_t payload_len, uint32_t ts_offset_usec, uint8_t* buffer)
+{
+  pack_u16(payload_len, buffer);
+  pack_u16(0, buffer + 2);
+  pack_u32(ts_offset_usec, buffer + 4);
+}
+
+} // namespace mac_pcap_net_batch
+
+/*******************************
+ *      Batch decoder
+ ******************************/
+
+bool mac_pcap_net_batch_decoder::unpack_and_check(const uint8_t*                datagram,
+                                                  uint32_t                      len,
+                                                  mac_pcap_net_batch::header_t& hdr)
+{
+  if (not mac_pcap_net_batch::unpack_header(datagram, len, hdr)) {
+    metrics.nof_malformed_datagrams++;
+    return false;
+  }
+
+  // Check that the records fill the datagram exactly
+  const uint32_t nof_records = hdr.nof_records;
+  uint32_t       offset      = mac_pcap_net_batch::hdr_len;
+  for (uint32_t i = 0; i < nof_records; ++i) {
+    if (offset + mac_pcap_net_batch::record_hdr_len > len) {
+      metrics.nof_malformed_datagrams++;
+      return false;
+    }
+    offset += mac_pcap_net_batch::record_hdr_len + mac_pcap_net_batch::unpack_u16(datagram + offset);
+  }
+  if (offset != len) {
+    metrics.nof_malformed_datagrams++;
+    return false;
+  }
+
+  // Sequence numbers skipped by the datagram are counted as lost. Late or duplicated datagrams, i.e. behind the
+  // expected sequence number, are accepted but do not move it backwards
+  int32_t seq_nr_gap = static_cast<int32_t>(hdr.seq_nr - next_seq_nr);
+  if (first_datagram or seq_nr_gap >= 0) {
+    if (not first_datagram) {
+      metrics.nof_lost_datagrams += seq_nr_gap;
+    }
+    next_seq_nr = hdr.seq_nr + 1;
+  }
+  first_datagram                  = false;
+  metrics.nof_sender_dropped_pdus = hdr.nof_dropped_pdus;
+  metrics.nof_datagrams++;
+  metrics.nof_record_bytes += len - mac_pcap_net_batch::hdr_len - nof_records * mac_pcap_net_batch::record_hdr_len;
+  return true;
+}
+
+uint32_t mac_pcap_net_batch_decoder::unpack_record(const uint8_t* ptr, uint32_t* ts_offset_usec) const
+{
+  *ts_offset_usec = mac_pcap_net_batch::unpack_u32(ptr + 4);
+  return mac_pcap_net_batch::unpack_u16(ptr);
+}
+
+/*******************************
+ *      PCAP bridge
+ ******************************/
+
+mac_pcap_net_bridge::~mac_pcap_net_bridge()
+{
+  close();
+}
+
+bool mac_pcap_net_bridge::open(const std::string& bind_addr, uint16_t bind_port, const std::string& filename)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("MAC");
+
+  if (not socket.open_socket(
+          net_utils::addr_family::ipv4, net_utils::socket_type::datagram, net_utils::protocol_type::UDP)) {
+    logger.error("Couldn't open socket %s to receive MAC PCAP datagrams", bind_addr.c_str());
+    return false;
+  }
+  if (not socket.bind_addr(bind_addr.c_str(), bind_port)) {
+    socket.close();
+    logger.error("Couldn't bind socket %s:%d to receive MAC PCAP datagrams", bind_addr.c_str(), bind_port);
+    return false;
+  }
+  // Absorb bursts of datagrams while the PCAP file is being written
+  int rcvbuf_size = 8 * 1024 * 1024;
+  if (setsockopt(socket.fd(), SOL_SOCKET, SO_RCVBUF, &rcvbuf_size, sizeof(rcvbuf_size)) != 0) {
+    logger.warning("Couldn't set the receive buffer size of the MAC PCAP socket (%s)", strerror(errno));
+  }
+
+  pcap_file = DLT_PCAP_Open(UDP_DLT, filename.c_str());
+  if (pcap_file == nullptr) {
+    socket.close();
+    return false;
+  }
+  rx_buffer.resize(max_datagram_size * nof_datagrams_per_read);
+  return true;
+}
+
+void mac_pcap_net_bridge::close()
+{
+  socket.close();
+  if (pcap_file != nullptr) {
+    DLT_PCAP_Close(pcap_file);
+    pcap_file = nullptr;
+  }
+}
+
+uint16_t mac_pcap_net_bridge::get_port() const
+{
+  sockaddr_in addr    = {};
+  socklen_t   addrlen = sizeof(addr);
+  if (not socket.is_open() or getsockname(socket.fd(), (sockaddr*)&addr, &addrlen) != 0) {
+    return 0;
+  }
+  return ntohs(addr.sin_port);
+}
+
+int mac_pcap_net_bridge::receive(uint32_t timeout_ms)
+{
+  if (not socket.is_open() or pcap_file == nullptr) {
+    return -1;
+  }
+
+  pollfd pfd = {socket.fd(), POLLIN, 0};
+  int    ret = poll(&pfd, 1, timeout_ms);
+  if (ret <= 0) {
+    return ret;
+  }
+
+  mmsghdr msgs[nof_datagrams_per_read] = {};
+  iovec   iovs[nof_datagrams_per_read];
+  for (uint32_t i = 0; i < nof_datagrams_per_read; ++i) {
+    iovs[i].iov_base           = &rx_buffer[i * max_datagram_size];
+    iovs[i].iov_len            = max_datagram_size;
+    msgs[i].msg_hdr.msg_iov    = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  int nof_datagrams = recvmmsg(socket.fd(), msgs, nof_datagrams_per_read, MSG_DONTWAIT, nullptr);
+  if (nof_datagrams < 0) {
+    return (errno == EAGAIN or errno == EWOULDBLOCK) ? 0 : -1;
+  }
+
+  int nof_records = 0;
+  for (int i = 0; i < nof_datagrams; ++i) {
+    decoder.decode(&rx_buffer[i * max_datagram_size],
+                   msgs[i].msg_len,
+                   [this, &nof_records](const mac_pcap_net_batch_decoder::record_t& record) {
+                     write_record(record);
+                     nof_records++;
+                   });
+  }
+  return nof_records;
+}
+
+void mac_pcap_net_bridge::write_record(const mac_pcap_net_batch_decoder::record_t& record)
+{
+  // Same layout as the records written by LTE_PCAP_MAC_UDP_WritePDU, i.e. a dummy UDP header before the payload
+  udphdr udp_header = {};
+  udp_header.dest   = htons(0xdead);
+  udp_header.source = htons(0xbeef);
+  udp_header.len    = htons(sizeof(udp_header) + record.len);
+
+  pcaprec_hdr_t packet_header;
+  packet_header.ts_sec   = record.ts.tv_sec;
+  packet_header.ts_usec  = record.ts.tv_usec;
+  packet_header.incl_len = sizeof(udp_header) + record.len;
+  packet_header.orig_len = sizeof(udp_header) + record.len;
+
+  fwrite(&packet_header, sizeof(pcaprec_hdr_t), 1, pcap_file);
+  fwrite(&udp_header, sizeof(udp_header), 1, pcap_file);
+  fwrite(record.payload, 1, record.len, pcap_file);
+}
+
+} // namespace srsran
@@ -22,8 +22,10 @@
 #include "srsran/common/network_utils.h"
 
 #include <netinet/sctp.h>
+#include <array>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h> // for the pipe
 
 #define rxSockError(fmt, ...) logger.error("RxSockets: " fmt, ##__VA_ARGS__)
@@ -267,6 +269,62 @@ bool start_listen(int fd)
   return true;
 }
 
+int send_pdus(int fd, const sockaddr_in& dest, const srsran::unique_byte_buffer_t* pdus, uint32_t nof_pdus)
+{
+  std::array<mmsghdr, max_io_batch_size> msgs;
+  std::array<iovec, max_io_batch_size>   iovs;
+
+  uint32_t nof_sent = 0;
+  while (nof_sent < nof_pdus) {
+    uint32_t nof_msgs = std::min(nof_pdus - nof_sent, max_io_batch_size);
+    for (uint32_t i = 0; i < nof_msgs; ++i) {
+      iovs[i].iov_base            = pdus[nof_sent + i]->msg;
+      iovs[i].iov_len             = pdus[nof_sent + i]->N_bytes;
+      msgs[i]                     = {};
+      msgs[i].msg_hdr.msg_name    = const_cast<sockaddr_in*>(&dest);
+      msgs[i].msg_hdr.msg_namelen = sizeof(dest);
+      msgs[i].msg_hdr.msg_iov     = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen  = 1;
+    }
+    // sendmmsg may send only part of the batch, in which case the remaining PDUs are retried
+    int ret = sendmmsg(fd, msgs.data(), nof_msgs, 0);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      srslog::fetch_basic_logger(LOGSERVICE).error("Error sending batch of %d PDUs: %s", nof_msgs, strerror(errno));
+      break;
+    }
+    nof_sent += ret;
+  }
+  return nof_sent;
+}
+
+int recv_pdus(int fd, srsran::unique_byte_buffer_t* pdus, sockaddr_in* from, uint32_t max_pdus)
+{
+  std::array<mmsghdr, max_io_batch_size> msgs;
+  std::array<iovec, max_io_batch_size>   iovs;
+
+  uint32_t nof_msgs = std::min(max_pdus, max_io_batch_size);
+  for (uint32_t i = 0; i < nof_msgs; ++i) {
+    iovs[i].iov_base            = pdus[i]->msg;
+    iovs[i].iov_len             = pdus[i]->get_tailroom();
+    msgs[i]                     = {};
+    msgs[i].msg_hdr.msg_name    = &from[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(from[i]);
+    msgs[i].msg_hdr.msg_iov     = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen  = 1;
+  }
+  int ret = recvmmsg(fd, msgs.data(), nof_msgs, MSG_DONTWAIT, nullptr);
+  if (ret < 0) {
+    return (errno == EAGAIN or errno == EWOULDBLOCK) ? 0 : -1;
+  }
+  for (int i = 0; i < ret; ++i) {
+    pdus[i]->N_bytes = msgs[i].msg_len;
+  }
+  return ret;
+}
+
 } // namespace net_utils
 
 /********************************************
@@ -657,4 +715,82 @@ make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue,
   return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
 }
 
+/**
+ * Description: Functor for the case the received data is in the form of unique_byte_buffer, and a recvmmsg(...) call
+ * is used to receive several datagrams at once
+ */
+class recvmmsg_pdu_task
+{
+public:
+  using callback_t = recvfrom_callback_t;
+  using batch_t    = std::vector<std::pair<srsran::unique_byte_buffer_t, sockaddr_in> >;
+
+  explicit recvmmsg_pdu_task(srslog::basic_logger&      logger,
+                             srsran::task_queue_handle& queue_,
+                             callback_t                 func_,
+                             uint32_t                   batch_size) :
+    logger(logger),
+    queue(queue_),
+    func(std::move(func_)),
+    pdus(std::max(std::min(batch_size, net_utils::max_io_batch_size), 1U)),
+    from(pdus.size())
+  {}
+
+  bool operator()(int fd)
+  {
+    // Replace the buffers handed over to the queue by the previous call
+    for (srsran::unique_byte_buffer_t& pdu : pdus) {
+      if (pdu == nullptr) {
+        pdu = srsran::make_byte_buffer();
+        if (pdu == nullptr) {
+          logger.error("Unable to allocate byte buffer");
+          return true;
+        }
+      }
+    }
+
+    int n_recv = net_utils::recv_pdus(fd, pdus.data(), from.data(), pdus.size());
+    if (n_recv == -1) {
+      logger.error("Error reading from socket: %s", strerror(errno));
+      return true;
+    }
+    if (n_recv == 0) {
+      logger.debug("Socket timeout reached");
+      return true;
+    }
+
+    batch_t batch;
+    batch.reserve(n_recv);
+    for (int i = 0; i < n_recv; ++i) {
+      batch.emplace_back(std::move(pdus[i]), from[i]);
+    }
+
+    // Defer handling of all the received packets to provided queue, in a single task
+    queue.push(std::bind(
+        [this](batch_t& sdus) {
+          for (auto& sdu : sdus) {
+            func(std::move(sdu.first), sdu.second);
+          }
+        },
+        std::move(batch)));
+
+    return true;
+  }
+
+private:
+  srslog::basic_logger&                     logger;
+  srsran::task_queue_handle&                queue;
+  callback_t                                func;
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  std::vector<sockaddr_in>                  from;
+};
+
+socket_manager_itf::recv_callback_t make_batch_sdu_handler(srslog::basic_logger&      logger,
+                                                           srsran::task_queue_handle& queue,
+                                                           recvfrom_callback_t        rx_callback,
+                                                           uint32_t                   batch_size)
+{
+  return socket_manager_itf::recv_callback_t(recvmmsg_pdu_task(logger, queue, std::move(rx_callback), batch_size));
+}
+
 } // namespace srsran
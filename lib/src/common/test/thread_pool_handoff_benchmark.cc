@@ -0,0 +1,229 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/**
+ * Thread pool handoff benchmark. A txrx-like thread grabs an idle worker and starts it every TTI, and the worker
+ * records when its job begins. The benchmark reports the distribution of:
+ * - the time spent by the txrx thread grabbing and starting the worker (wait_worker() + start_worker())
+ * - the latency between start_worker() and the beginning of the job in the worker
+ * both for back-to-back TTIs, where the workers are likely spinning, and for TTIs paced every 1 ms, where the workers
+ * spin or sleep depending on their adapted spin time.
+ *
+ * Usage: thread_pool_handoff_benchmark [test|benchmark]
+ */
+
+namespace srsran {
+
+using bench_clock = std::chrono::steady_clock;
+
+class handoff_worker : public thread_pool::worker
+{
+public:
+  void set_job(bench_clock::time_point start_time_, double* latency_ns_, uint32_t work_us_)
+  {
+    start_time = start_time_;
+    latency_ns = latency_ns_;
+    work_us    = work_us_;
+  }
+
+protected:
+  void work_imp() override
+  {
+    std::chrono::duration<double, std::nano> latency = bench_clock::now() - start_time;
+    *latency_ns                                       = latency.count();
+    if (work_us > 0) {
+      // Busy work, as a PHY worker would do
+      bench_clock::time_point end = bench_clock::now() + std::chrono::microseconds(work_us);
+      while (bench_clock::now() < end) {
+      }
+    }
+  }
+
+private:
+  bench_clock::time_point start_time;
+  double*                 latency_ns = nullptr;
+  uint32_t                work_us    = 0;
+};
+
+struct run_params {
+  uint32_t nof_workers;
+  uint32_t nof_tti;
+  uint32_t tti_period_us; ///< 0 for back-to-back TTIs
+  uint32_t work_us;
+};
+
+struct percentiles_t {
+  double p50;
+  double p90;
+  double p99;
+  double max;
+};
+
+struct run_data {
+  run_params    params;
+  percentiles_t grab_start_ns;
+  percentiles_t handoff_ns;
+};
+
+percentiles_t get_percentiles(std::vector<double>& values)
+{
+  std::sort(values.begin(), values.end());
+  return {values[values.size() / 2],
+          values[(values.size() * 9) / 10],
+          values[(values.size() * 99) / 100],
+          values.back()};
+}
+
+int run_benchmark_scenario(const run_params& params, std::vector<run_data>& run_results)
+{
+  thread_pool                                  pool(params.nof_workers, "BENCH");
+  std::vector<std::unique_ptr<handoff_worker> > workers;
+  for (uint32_t i = 0; i < params.nof_workers; ++i) {
+    workers.emplace_back(new handoff_worker);
+    pool.init_worker(i, workers.back().get());
+  }
+
+  std::vector<double>     grab_start_ns(params.nof_tti);
+  std::vector<double>     handoff_ns(params.nof_tti);
+  bench_clock::time_point next_tti = bench_clock::now();
+  for (uint32_t tti = 0; tti < params.nof_tti; ++tti) {
+    if (params.tti_period_us > 0) {
+      next_tti += std::chrono::microseconds(params.tti_period_us);
+      std::this_thread::sleep_until(next_tti);
+    }
+
+    bench_clock::time_point tic = bench_clock::now();
+    auto*                   w   = static_cast<handoff_worker*>(pool.wait_worker(tti));
+    TESTASSERT(w != nullptr);
+    bench_clock::time_point start_time = bench_clock::now();
+    w->set_job(start_time, &handoff_ns[tti], params.work_us);
+    pool.start_worker(w);
+    std::chrono::duration<double, std::nano> grab_start = bench_clock::now() - tic;
+    grab_start_ns[tti]                                  = grab_start.count();
+  }
+
+  // Wait for the last jobs to finish before reading their latencies
+  for (uint32_t i = 0; i < params.nof_workers; ++i) {
+    TESTASSERT(pool.wait_worker_id(i) != nullptr);
+  }
+  pool.stop();
+
+  run_data r      = {};
+  r.params        = params;
+  r.grab_start_ns = get_percentiles(grab_start_ns);
+  r.handoff_ns    = get_percentiles(handoff_ns);
+  run_results.push_back(r);
+  return SRSRAN_SUCCESS;
+}
+
+/// Stops the pool while another thread keeps grabbing and releasing the idle workers. The pool must not hang
+int run_stop_while_grabbing(uint32_t nof_runs)
+{
+  for (uint32_t run = 0; run < nof_runs; ++run) {
+    thread_pool                                  pool(2, "STOP");
+    std::vector<std::unique_ptr<handoff_worker> > workers;
+    for (uint32_t i = 0; i < 2; ++i) {
+      workers.emplace_back(new handoff_worker);
+      pool.init_worker(i, workers.back().get());
+    }
+
+    std::atomic<bool> done{false};
+
+    // Grab and release the workers while the pool is being stopped
+    std::thread grabber([&pool, &done]() {
+      while (not done.load(std::memory_order_relaxed)) {
+        thread_pool::worker* w = pool.wait_worker_nb(0);
+        if (w != nullptr) {
+          w->release();
+        }
+      }
+    });
+    std::this_thread::sleep_for(std::chrono::microseconds(run % 100));
+    pool.stop();
+    done = true;
+    grabber.join();
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  fmt::print("Note: spinning is disabled on single core machines, every handoff goes through the futex\n");
+  fmt::print("run | workers | period [us] | work [us] | grab+start p50/p90/p99/max [ns]  | handoff p50/p90/p99/max "
+             "[ns]\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data&      r = run_results[i];
+    const percentiles_t& g = r.grab_start_ns;
+    const percentiles_t& h = r.handoff_ns;
+    fmt::print("{:>3d} | {:>7d} | {:>11d} | {:>9d} | {:>6.0f} {:>6.0f} {:>7.0f} {:>9.0f} | {:>6.0f} {:>6.0f} {:>7.0f} "
+               "{:>9.0f}\n",
+               i,
+               r.params.nof_workers,
+               r.params.tti_period_us,
+               r.params.work_us,
+               g.p50,
+               g.p90,
+               g.p99,
+               g.max,
+               h.p50,
+               h.p90,
+               h.p99,
+               h.max);
+  }
+}
+
+int run_all(uint32_t nof_tti)
+{
+  std::vector<run_data> run_results;
+  for (uint32_t nof_workers : {1, 4}) {
+    for (uint32_t tti_period_us : {0, 1000}) {
+      // Paced runs are limited to a few seconds
+      uint32_t   n      = tti_period_us > 0 ? std::min(nof_tti, 2000u) : nof_tti;
+      run_params params = {nof_workers, n, tti_period_us, tti_period_us > 0 ? 300u : 0u};
+      TESTASSERT(run_benchmark_scenario(params, run_results) == SRSRAN_SUCCESS);
+    }
+  }
+  print_benchmark_results(run_results);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main(int argc, char* argv[])
+{
+  srslog::init();
+
+  if (argc == 1 or strcmp(argv[1], "test") == 0) {
+    TESTASSERT(srsran::run_all(200) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran::run_stop_while_grabbing(500) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark") == 0) {
+    TESTASSERT(srsran::run_all(100000) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
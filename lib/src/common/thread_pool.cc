@@ -21,9 +21,15 @@
 
 #include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
+#include "srsran/support/srsran_assert.h"
 #include <assert.h>
 #include <chrono>
+#include <climits>
+#include <linux/futex.h>
 #include <stdio.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
 
 #define DEBUG 0
 #define debug_thread(fmt, ...)                                                                                         \
@@ -34,6 +40,47 @@
 
 namespace srsran {
 
+/// Upper bound of the number of spins of a worker waiting for a job
+static const uint32_t max_worker_spins = 1u << 14;
+/// Lower bound of the number of spins of a worker waiting for a job
+static const uint32_t min_worker_spins = 1u << 4;
+/// Number of spins of a thread waiting for an idle worker before sleeping
+static const uint32_t max_waiter_spins = 1u << 10;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "The futex word must be a plain 32-bit integer");
+
+static void futex_wait(std::atomic<uint32_t>* word, uint32_t expected)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+static void futex_wake(std::atomic<uint32_t>* word, int nof_threads)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE_PRIVATE, nof_threads, nullptr, nullptr, 0);
+}
+
+/// Hints the CPU that the calling thread is spinning. Every few spins, the thread yields, so that spinning does not
+/// starve the thread it waits for when both share a core
+static inline void spin_pause(uint32_t count)
+{
+  if ((count & 63u) == 63u) {
+    std::this_thread::yield();
+    return;
+  }
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/// Spinning only makes sense when the threads on both sides of the handoff can run at the same time
+static bool spinning_enabled()
+{
+  static const bool enabled = std::thread::hardware_concurrency() > 1;
+  return enabled;
+}
+
 thread_pool::worker::worker() : thread("THREAD_POOL_WORKER") {}
 
 void thread_pool::worker::setup(uint32_t id, thread_pool* parent, uint32_t prio, uint32_t mask)
@@ -71,11 +118,14 @@ uint32_t thread_pool::worker::get_id()
 }
 
 thread_pool::thread_pool(uint32_t max_workers_, std::string id_) :
-  workers(max_workers_), max_workers(max_workers_), status(max_workers_), cvar_worker(max_workers_), id(id_)
+  id(id_),
+  workers(max_workers_),
+  max_workers(max_workers_),
+  mailboxes(max_workers_),
+  idle_mask((max_workers_ + 63) / 64)
 {
   for (uint32_t i = 0; i < max_workers; i++) {
     workers[i] = NULL;
-    status[i]  = IDLE;
   }
   running     = true;
   nof_workers = 0;
@@ -88,9 +138,13 @@ void thread_pool::init_worker(uint32_t id, worker* obj, uint32_t prio, uint32_t
     if (id >= nof_workers) {
       nof_workers = id + 1;
     }
-    workers[id] = obj;
+    workers[id]               = obj;
+    mailboxes[id].spin_budget = spinning_enabled() ? min_worker_spins : 0;
+    mailboxes[id].status.store(WORKER_READY, std::memory_order_relaxed);
     obj->setup(id, this, prio, mask);
-    cvar_queue.notify_all();
+
+    // Make the worker available to the waiting threads
+    set_idle(id, WORKER_READY);
   }
 }
 
@@ -101,15 +155,16 @@ void thread_pool::stop()
 
     /* Stop any thread waiting for available worker */
     running = false;
+    idle_events.fetch_add(1, std::memory_order_seq_cst);
+    futex_wake(&idle_events, INT_MAX);
 
     /* Now stop all workers */
     for (uint32_t i = 0; i < nof_workers; i++) {
       if (workers[i]) {
         debug_thread("stop(): stopping %d\n", i);
         workers[i]->stop();
-        status[i] = STOP;
-        cvar_worker[i].notify_all();
-        cvar_queue.notify_all();
+        mailboxes[i].status.store(STOP, std::memory_order_seq_cst);
+        futex_wake(&mailboxes[i].status, INT_MAX);
       }
     }
   }
@@ -123,66 +178,136 @@ void thread_pool::stop()
 
 void thread_pool::worker::release()
 {
-  finished();
+  // Released either by the thread that grabbed the worker without starting it, or by the worker before its job ends
+  if (not my_parent->set_idle(my_id, WORKER_READY)) {
+    my_parent->set_idle(my_id, WORKING);
+  }
 }
 
 void thread_pool::worker::wait_to_start()
 {
-  std::unique_lock<std::mutex> lock(my_parent->mutex_queue);
+  mailbox_t& mailbox = my_parent->mailboxes[my_id];
 
-  debug_thread("wait_to_start() id=%d, status=%d, enter\n", my_id, my_parent->status[my_id]);
+  debug_thread("wait_to_start() id=%d, status=%d, enter\n", my_id, mailbox.status.load());
 
-  while (my_parent->status[my_id] != START_WORK && my_parent->status[my_id] != STOP) {
-    my_parent->cvar_worker[my_id].wait(lock);
+  // Spin first, adapting the spin time to whether the jobs arrive while spinning
+  uint32_t status = mailbox.status.load(std::memory_order_acquire);
+  for (uint32_t i = 0; i < mailbox.spin_budget and status != START_WORK and status != STOP; ++i) {
+    spin_pause(i);
+    status = mailbox.status.load(std::memory_order_acquire);
   }
-  if (my_parent->status[my_id] != STOP) {
-    my_parent->status[my_id] = WORKING;
+  if (status == START_WORK or status == STOP) {
+    mailbox.spin_budget = std::min(2 * mailbox.spin_budget, max_worker_spins);
+  } else {
+    mailbox.spin_budget = spinning_enabled() ? std::max(mailbox.spin_budget / 2, min_worker_spins) : 0;
+
+    // Pairs with the read of the sleeping flag by start_worker() after writing the status. If the status changes after
+    // it is read here, the futex does not sleep
+    while (status != START_WORK and status != STOP) {
+      mailbox.sleeping.store(true, std::memory_order_seq_cst);
+      status = mailbox.status.load(std::memory_order_seq_cst);
+      if (status != START_WORK and status != STOP) {
+        futex_wait(&mailbox.status, status);
+        status = mailbox.status.load(std::memory_order_acquire);
+      }
+      mailbox.sleeping.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  if (status != STOP) {
+    uint32_t expected = START_WORK;
+    mailbox.status.compare_exchange_strong(expected, WORKING, std::memory_order_acq_rel);
   }
 
-  debug_thread("wait_to_start() id=%d, status=%d, exit\n", my_id, my_parent->status[my_id]);
+  debug_thread("wait_to_start() id=%d, status=%d, exit\n", my_id, mailbox.status.load());
 }
 
 void thread_pool::worker::finished()
 {
-  std::lock_guard<std::mutex> lock(my_parent->mutex_queue);
-  if (my_parent->status[my_id] != STOP) {
-    my_parent->status[my_id] = IDLE;
-    my_parent->cvar_worker[my_id].notify_all();
-    my_parent->cvar_queue.notify_all();
-  }
+  my_parent->set_idle(my_id, WORKING);
 }
 
 bool thread_pool::worker::is_stopped() const
 {
-  std::lock_guard<std::mutex> lock(my_parent->mutex_queue);
-  return my_parent->status[my_id] == STOP;
+  return my_parent->mailboxes[my_id].status.load(std::memory_order_relaxed) == STOP;
+}
+
+bool thread_pool::set_idle(uint32_t id, uint32_t from_status)
+{
+  if (not mailboxes[id].status.compare_exchange_strong(from_status, IDLE, std::memory_order_acq_rel)) {
+    return false;
+  }
+  idle_mask[id / 64].fetch_or(1ULL << (id % 64), std::memory_order_release);
+
+  // Pairs with the increment of nof_waiters by wait_idle_event() before it sleeps
+  idle_events.fetch_add(1, std::memory_order_seq_cst);
+  if (nof_waiters.load(std::memory_order_seq_cst) > 0) {
+    futex_wake(&idle_events, INT_MAX);
+  }
+  return true;
+}
+
+bool thread_pool::claim_worker(uint32_t id)
+{
+  uint64_t bit = 1ULL << (id % 64);
+  if ((idle_mask[id / 64].fetch_and(~bit, std::memory_order_acq_rel) & bit) == 0) {
+    return false;
+  }
+  // The worker may have been stopped after it became idle, in which case the STOP status must not be overwritten
+  uint32_t expected = IDLE;
+  if (not mailboxes[id].status.compare_exchange_strong(expected, WORKER_READY, std::memory_order_acq_rel)) {
+    idle_mask[id / 64].fetch_or(bit, std::memory_order_release);
+    return false;
+  }
+  return true;
 }
 
 bool thread_pool::find_finished_worker(uint32_t tti, uint32_t* id)
 {
-  for (uint32_t i = 0; i < nof_workers; i++) {
-    if (status[i] == IDLE) {
-      *id = i;
-      return true;
+  // Grab the idle worker with the lowest index
+  for (uint32_t w = 0; w < idle_mask.size(); w++) {
+    uint64_t mask = idle_mask[w].load(std::memory_order_relaxed);
+    while (mask != 0) {
+      uint32_t i = w * 64 + __builtin_ctzll(mask);
+      if (i < nof_workers and claim_worker(i)) {
+        *id = i;
+        return true;
+      }
+      mask &= mask - 1;
     }
   }
   return false;
 }
 
-thread_pool::worker* thread_pool::wait_worker_id(uint32_t id)
+void thread_pool::wait_idle_event(uint32_t event_count)
 {
-  std::unique_lock<std::mutex> lock(mutex_queue);
+  uint32_t nof_spins = spinning_enabled() ? max_waiter_spins : 0;
+  for (uint32_t i = 0; i < nof_spins; ++i) {
+    if (idle_events.load(std::memory_order_acquire) != event_count) {
+      return;
+    }
+    spin_pause(i);
+  }
 
-  debug_thread("wait_worker_id() - enter - id=%d, state0=%d, state1=%d\n", id, status[0], status[1]);
+  nof_waiters.fetch_add(1, std::memory_order_seq_cst);
+  if (idle_events.load(std::memory_order_seq_cst) == event_count) {
+    futex_wait(&idle_events, event_count);
+  }
+  nof_waiters.fetch_sub(1, std::memory_order_relaxed);
+}
 
-  thread_pool::worker* ret = nullptr;
+thread_pool::worker* thread_pool::wait_worker_id(uint32_t id)
+{
+  debug_thread("wait_worker_id() - enter - id=%d\n", id);
 
-  while (status[id] != IDLE && running) {
-    cvar_queue.wait(lock);
-  }
-  if (running) {
-    ret        = workers[id];
-    status[id] = WORKER_READY;
+  thread_pool::worker* ret = nullptr;
+  while (running) {
+    uint32_t event_count = idle_events.load(std::memory_order_acquire);
+    if (claim_worker(id)) {
+      ret = workers[id];
+      break;
+    }
+    wait_idle_event(event_count);
   }
   debug_thread("wait_worker_id() - exit - id=%d\n", id);
   return ret;
@@ -190,19 +315,17 @@ thread_pool::worker* thread_pool::wait_worker_id(uint32_t id)
 
 thread_pool::worker* thread_pool::wait_worker(uint32_t tti)
 {
-  std::unique_lock<std::mutex> lock(mutex_queue);
-
-  debug_thread("wait_worker() - enter - tti=%d, state0=%d, state1=%d\n", tti, status[0], status[1]);
+  debug_thread("wait_worker() - enter - tti=%d\n", tti);
 
   thread_pool::worker* ret = nullptr;
   uint32_t             id  = 0;
-
-  while (!find_finished_worker(tti, &id) && running) {
-    cvar_queue.wait(lock);
-  }
-  if (running) {
-    ret        = workers[id];
-    status[id] = WORKER_READY;
+  while (running) {
+    uint32_t event_count = idle_events.load(std::memory_order_acquire);
+    if (find_finished_worker(tti, &id)) {
+      ret = workers[id];
+      break;
+    }
+    wait_idle_event(event_count);
   }
   debug_thread("wait_worker() - exit - id=%d\n", id);
   return ret;
@@ -210,16 +333,13 @@ thread_pool::worker* thread_pool::wait_worker(uint32_t tti)
 
 thread_pool::worker* thread_pool::wait_worker_nb(uint32_t tti)
 {
-  std::unique_lock<std::mutex> lock(mutex_queue);
-
-  debug_thread("wait_worker_nb() - enter - tti=%d, state0=%d, state1=%d\n", tti, status[0], status[1]);
+  debug_thread("wait_worker_nb() - enter - tti=%d\n", tti);
 
   thread_pool::worker* ret = nullptr;
   uint32_t             id  = 0;
 
-  if (find_finished_worker(tti, &id) && running) {
-    ret        = workers[id];
-    status[id] = WORKER_READY;
+  if (running and find_finished_worker(tti, &id)) {
+    ret = workers[id];
   }
 
   debug_thread("wait_worker_nb() - exit - id=%d\n", id);
@@ -228,24 +348,28 @@ thread_pool::worker* thread_pool::wait_worker_nb(uint32_t tti)
 
 void thread_pool::start_worker(uint32_t id)
 {
-  std::unique_lock<std::mutex> lock(mutex_queue);
   if (id < nof_workers) {
-    debug_thread("start_worker() id=%d, status=%d\n", id, status[id]);
-    if (status[id] != STOP) {
-      status[id] = START_WORK;
-      cvar_worker[id].notify_all();
-      cvar_queue.notify_all();
+    mailbox_t& mailbox = mailboxes[id];
+    uint32_t   prev    = mailbox.status.load(std::memory_order_relaxed);
+    debug_thread("start_worker() id=%d, status=%d\n", id, prev);
+    do {
+      if (prev == STOP) {
+        return;
+      }
+    } while (not mailbox.status.compare_exchange_weak(prev, START_WORK, std::memory_order_seq_cst));
+
+    // Only enter the kernel if the worker is not spinning
+    if (mailbox.sleeping.load(std::memory_order_seq_cst)) {
+      futex_wake(&mailbox.status, 1);
     }
   }
 }
 
 void thread_pool::start_worker(worker* x)
 {
-  for (uint32_t i = 0; i < nof_workers; i++) {
-    if (x == workers[i]) {
-      start_worker(i);
-      return;
-    }
+  uint32_t i = x->get_id();
+  if (i < nof_workers and workers[i] == x) {
+    start_worker(i);
   }
 }
 
@@ -268,15 +392,148 @@ std::string thread_pool::get_id()
 }
 
 /**************************************************************************
- *  task_thread_pool - uses a queue to enqueue callables, that start
- *  once a worker is available
+ *  task_thread_pool - enqueues callables in per-worker work-stealing deques
+ *  or in global per-priority queues, that start once a worker is available
  *************************************************************************/
 
-task_thread_pool::task_thread_pool(uint32_t nof_workers, bool start_deferred, int32_t prio_, uint32_t mask_) :
-  logger(srslog::fetch_basic_logger("POOL")), pending_tasks(max_task_num), workers(std::max(1u, nof_workers))
+/// Number of times an idle worker looks for tasks, yielding in between, before going to sleep
+static const uint32_t max_idle_spins = 64;
+/// Period, in tasks popped from the local deque, with which a worker looks first at the global normal priority queue
+static const uint32_t local_fairness_period = 32;
+
+thread_local task_thread_pool::worker_t* task_thread_pool::current_worker = nullptr;
+
+task_thread_pool::task_queue::task_queue(uint32_t capacity) : slots(new slot_t[capacity]), mask(capacity - 1)
+{
+  srsran_assert((capacity & (capacity - 1)) == 0, "The task queue capacity must be a power of 2");
+  for (uint32_t i = 0; i < capacity; ++i) {
+    slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool task_thread_pool::task_queue::try_push(task_t& task)
+{
+  uint64_t pos = tail.load(std::memory_order_relaxed);
+  while (true) {
+    slot_t&  slot = slots[pos & mask];
+    uint64_t seq  = slot.seq.load(std::memory_order_acquire);
+    int64_t  diff = (int64_t)seq - (int64_t)pos;
+    if (diff == 0) {
+      if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        slot.task = std::move(task);
+        slot.seq.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // the slot still holds the task pushed one lap before
+      return false;
+    } else {
+      pos = tail.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool task_thread_pool::task_queue::try_pop(task_t& task)
+{
+  uint64_t pos = head.load(std::memory_order_relaxed);
+  while (true) {
+    slot_t&  slot = slots[pos & mask];
+    uint64_t seq  = slot.seq.load(std::memory_order_acquire);
+    int64_t  diff = (int64_t)seq - (int64_t)(pos + 1);
+    if (diff == 0) {
+      if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        task = std::move(slot.task);
+        slot.seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // the slot was not written yet
+      return false;
+    } else {
+      pos = head.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+task_thread_pool::task_deque::task_deque() : slots(new slot_t[local_task_num]) {}
+
+void task_thread_pool::task_deque::take(slot_t& slot, task_t& task)
+{
+  task = std::move(slot.task);
+  slot.busy.store(false, std::memory_order_release);
+}
+
+bool task_thread_pool::task_deque::try_push(task_t& task)
+{
+  int64_t b = bottom.load(std::memory_order_relaxed);
+  int64_t t = top.load(std::memory_order_acquire);
+  if (b - t >= (int64_t)local_task_num) {
+    return false;
+  }
+  slot_t& slot = slots[b & (local_task_num - 1)];
+  if (slot.busy.load(std::memory_order_acquire)) {
+    // a thief claimed the task of the previous lap but did not move it out yet
+    return false;
+  }
+  slot.task = std::move(task);
+  slot.busy.store(true, std::memory_order_relaxed);
+  bottom.store(b + 1, std::memory_order_release);
+  return true;
+}
+
+bool task_thread_pool::task_deque::try_pop(task_t& task)
 {
+  int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+  bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top.load(std::memory_order_relaxed);
+  if (t > b) {
+    // empty
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return false;
+  }
+  if (t == b) {
+    // last task, race against the thieves for it
+    bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    if (not won) {
+      return false;
+    }
+  }
+  take(slots[b & (local_task_num - 1)], task);
+  return true;
+}
+
+bool task_thread_pool::task_deque::try_steal(task_t& task)
+{
+  int64_t t = top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = bottom.load(std::memory_order_acquire);
+  if (t >= b) {
+    return false;
+  }
+  if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return false;
+  }
+  take(slots[t & (local_task_num - 1)], task);
+  return true;
+}
+
+task_thread_pool::task_thread_pool(uint32_t nof_workers,
+                                   bool     start_deferred,
+                                   int32_t  prio_,
+                                   uint32_t mask_,
+                                   bool     pin_workers_) :
+  logger(srslog::fetch_basic_logger("POOL")),
+  nof_workers_cfg(std::min(std::max(1u, nof_workers), uint32_t(max_nof_workers)))
+{
+  for (std::unique_ptr<task_queue>& q : global_tasks) {
+    q.reset(new task_queue(max_task_num));
+  }
+  // Workers are never reallocated, so that the thieves can access them while new workers are added
+  workers.reserve(max_nof_workers);
   if (not start_deferred) {
-    start(prio_, mask_);
+    start(prio_, mask_, pin_workers_);
   }
 }
 
@@ -288,117 +545,196 @@ task_thread_pool::~task_thread_pool()
 void task_thread_pool::set_nof_workers(uint32_t nof_workers)
 {
   std::lock_guard<std::mutex> lock(queue_mutex);
-  if (workers.size() > nof_workers) {
+  if (nof_workers_cfg > nof_workers) {
     logger.error("Reducing the number of workers dynamically not supported");
     return;
   }
-  uint32_t old_size = workers.size();
-  workers.resize(nof_workers);
+  if (nof_workers > max_nof_workers) {
+    logger.error("The number of workers %d exceeds the maximum %d", nof_workers, uint32_t(max_nof_workers));
+    nof_workers = max_nof_workers;
+  }
+  uint32_t old_size = nof_workers_cfg;
+  nof_workers_cfg   = nof_workers;
   if (running) {
     for (uint32_t i = old_size; i < nof_workers; ++i) {
-      workers[i].reset(new worker_t(this, i));
+      start_worker(i);
     }
   }
 }
 
-void task_thread_pool::start(int32_t prio_, uint32_t mask_)
+void task_thread_pool::start(int32_t prio_, uint32_t mask_, bool pin_workers_)
 {
   std::lock_guard<std::mutex> lock(queue_mutex);
   if (running) {
     logger.error("Starting thread pool that has already started");
     return;
   }
-  prio    = prio_;
-  mask    = mask_;
-  running = true;
-  for (uint32_t i = 0; i < workers.size(); ++i) {
-    workers[i].reset(new worker_t(this, i));
+  prio        = prio_;
+  mask        = mask_;
+  pin_workers = pin_workers_ and mask != 0;
+  running     = true;
+
+  // Move the tasks left in the deques of a previous run to the global queue
+  nof_started.store(0, std::memory_order_relaxed);
+  task_t task;
+  for (std::unique_ptr<worker_t>& w : workers) {
+    while (w->local_tasks.try_pop(task)) {
+      if (not global_tasks[(size_t)task_priority::normal]->try_push(task)) {
+        nof_pending.fetch_sub(1, std::memory_order_relaxed);
+        logger.error("Dropping task left by a previous run, maximum queue size is %u", uint32_t(max_task_num));
+      }
+    }
+  }
+  workers.clear();
+
+  for (uint32_t i = 0; i < nof_workers_cfg; ++i) {
+    start_worker(i);
   }
 }
 
-void task_thread_pool::stop()
+void task_thread_pool::start_worker(uint32_t id)
 {
-  std::unique_lock<std::mutex> lock(queue_mutex);
-  if (running) {
-    running              = false;
-    bool workers_running = false;
-    for (std::unique_ptr<worker_t>& w : workers) {
-      if (w->is_running()) {
-        workers_running = true;
+  workers.emplace_back(new worker_t(this, id));
+  nof_started.store(workers.size(), std::memory_order_release);
+
+  worker_t* w = workers.back().get();
+  if (pin_workers) {
+    // Pin the worker to the n-th core of the mask, wrapping around the cores of the mask
+    uint32_t n   = id % __builtin_popcount(mask);
+    uint32_t cpu = 0;
+    for (uint32_t m = mask; m != 0; m &= m - 1) {
+      if (n-- == 0) {
+        cpu = __builtin_ctz(m);
         break;
       }
     }
+    w->start_cpu_mask(prio, 1u << cpu);
+  } else if (mask == 255) {
+    w->start(prio);
+  } else {
+    w->start_cpu_mask(prio, mask);
+  }
+}
+
+void task_thread_pool::stop()
+{
+  std::unique_lock<std::mutex> lock(queue_mutex);
+  if (running) {
+    running = false;
+    cv_empty.notify_all();
     lock.unlock();
-    if (workers_running) {
-      cv_empty.notify_all();
-    }
     for (std::unique_ptr<worker_t>& w : workers) {
       w->stop();
     }
   }
 }
 
-void task_thread_pool::push_task(task_t&& task)
+void task_thread_pool::push_task(task_t&& task, task_priority task_prio)
+{
+  // Counted before the task becomes visible, so that the worker that pops it cannot decrement the count first.
+  // Pairs with the increment of nof_sleeping by a worker before it checks nof_pending and goes to sleep
+  nof_pending.fetch_add(1, std::memory_order_seq_cst);
+
+  bool pushed = false;
+  if (task_prio == task_priority::normal and current_worker != nullptr and current_worker->parent == this) {
+    pushed = current_worker->local_tasks.try_push(task);
+  }
+  if (not pushed and not global_tasks[(size_t)task_prio]->try_push(task)) {
+    nof_pending.fetch_sub(1, std::memory_order_relaxed);
+    logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
+    return;
+  }
+
+  if (nof_sleeping.load(std::memory_order_seq_cst) > 0) {
+    notify_workers();
+  }
+}
+
+void task_thread_pool::notify_workers()
 {
   {
+    // The lock guarantees that a worker which found no pending tasks is already waiting on the condition variable
     std::lock_guard<std::mutex> lock(queue_mutex);
-    if (pending_tasks.full()) {
-      logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
-      return;
-    }
-    pending_tasks.push(std::move(task));
   }
   cv_empty.notify_one();
 }
 
 uint32_t task_thread_pool::nof_pending_tasks() const
 {
-  std::lock_guard<std::mutex> lock(queue_mutex);
-  return pending_tasks.size();
+  return nof_pending.load(std::memory_order_relaxed);
 }
 
 task_thread_pool::worker_t::worker_t(srsran::task_thread_pool* parent_, uint32_t my_id) :
-  parent(parent_), thread(std::string("TASKWORKER") + std::to_string(my_id)), id_(my_id), running(true)
-{
-  if (parent->mask == 255) {
-    start(parent->prio);
-  } else {
-    start_cpu_mask(parent->prio, parent->mask);
-  }
-}
+  thread(std::string("TASKWORKER") + std::to_string(my_id)), parent(parent_), id_(my_id), running(true)
+{}
 
 void task_thread_pool::worker_t::stop()
 {
   wait_thread_finish();
 }
 
-bool task_thread_pool::worker_t::wait_task(task_t* task)
+bool task_thread_pool::worker_t::find_task(task_t& task)
 {
-  std::unique_lock<std::mutex> lock(parent->queue_mutex);
-  while (parent->running and parent->pending_tasks.empty()) {
-    parent->cv_empty.wait(lock);
+  if (parent->global_tasks[(size_t)task_priority::high]->try_pop(task)) {
+    return true;
   }
-  if (not parent->running) {
-    return false;
+  // Look first at the local deque, except periodically so that it cannot starve the tasks pushed from outside
+  if (++local_count % local_fairness_period != 0 and local_tasks.try_pop(task)) {
+    return true;
   }
-  if (task) {
-    *task = std::move(parent->pending_tasks.top());
+  if (parent->global_tasks[(size_t)task_priority::normal]->try_pop(task) or local_tasks.try_pop(task)) {
+    return true;
   }
-  parent->pending_tasks.pop();
-  return true;
+
+  // Steal, starting from the last worker stolen from
+  uint32_t nof_workers = parent->nof_started.load(std::memory_order_acquire);
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    uint32_t victim = (steal_index + i) % nof_workers;
+    if (victim != id_ and parent->workers[victim]->local_tasks.try_steal(task)) {
+      steal_index = victim;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool task_thread_pool::worker_t::wait_task(task_t& task)
+{
+  uint32_t nof_spins = 0;
+  while (parent->running.load(std::memory_order_relaxed)) {
+    if (find_task(task)) {
+      parent->nof_pending.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    if (nof_spins++ < max_idle_spins) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(parent->queue_mutex);
+    parent->nof_sleeping.fetch_add(1, std::memory_order_seq_cst);
+    while (parent->running and parent->nof_pending.load(std::memory_order_seq_cst) == 0) {
+      parent->cv_empty.wait(lock);
+    }
+    parent->nof_sleeping.fetch_sub(1, std::memory_order_relaxed);
+    nof_spins = 0;
+  }
+  return false;
 }
 
 void task_thread_pool::worker_t::run_thread()
 {
+  current_worker = this;
+
   // main loop
   task_t task;
-  while (wait_task(&task)) {
+  while (wait_task(task)) {
     task();
   }
 
   // on exit, notify pool class
-  std::unique_lock<std::mutex> lock(parent->queue_mutex);
-  running = false;
+  current_worker = nullptr;
+  running        = false;
 }
 
 task_worker::task_worker(std::string thread_name_,
@@ -282,6 +282,25 @@ std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint32_
   return pdcp_array[lcid]->get_buffered_pdus();
 }
 
+bool pdcp::add_split_bearer_leg(uint32_t                       lcid,
+                                srsue::rlc_interface_pdcp*     leg_rlc,
+                                uint32_t                       leg_lcid,
+                                const pdcp_split_bearer_cfg_t& split_cfg)
+{
+  if (not valid_lcid(lcid)) {
+    logger.error("Can't add split bearer leg to inexistent LCID=%d", lcid);
+    return false;
+  }
+  return pdcp_array[lcid]->add_split_bearer_leg(leg_rlc, leg_lcid, split_cfg);
+}
+
+void pdcp::del_split_bearer_leg(uint32_t lcid)
+{
+  if (valid_lcid(lcid)) {
+    pdcp_array[lcid]->del_split_bearer_leg();
+  }
+}
+
 /*******************************************************************************
   RLC interface
 *******************************************************************************/
@@ -336,6 +355,12 @@ void pdcp::notify_failure(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn
   }
 }
 
+bool pdcp::is_lte_drb(uint32_t lcid)
+{
+  auto it = pdcp_array.find(lcid);
+  return it != pdcp_array.end() and it->second->is_drb() and it->second->is_lte();
+}
+
 bool pdcp::valid_lcid(uint32_t lcid)
 {
   if (lcid >= SRSRAN_N_RADIO_BEARERS) {
@@ -55,6 +55,7 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   cfg         = cnfg_;
   rb_name     = cfg.get_rb_name();
   window_size = 1 << (cfg.sn_len - 1);
+  reorder_queue.set_max_capacity(window_size);
 
   rlc_mode = rlc->rb_is_um(lcid) ? rlc_mode_t::UM : rlc_mode_t::AM;
 
@@ -111,7 +112,7 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
               srsran_direction_text[integrity_direction],
               srsran_direction_text[encryption_direction]);
 
-  if (rlc->sdu_queue_is_full(lcid)) {
+  if (lower_layers_full()) {
     logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
     return;
   }
@@ -174,9 +175,12 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
               srsran_direction_text[integrity_direction],
               srsran_direction_text[encryption_direction]);
 
-  // Check if PDCP is associated with more than on RLC entity TODO
+  // Update metrics
+  metrics.num_tx_pdus++;
+  metrics.num_tx_pdu_bytes += sdu->N_bytes;
+
   // Write to lower layers
-  rlc->write_sdu(lcid, std::move(sdu));
+  write_to_lower_layers(std::move(sdu));
 
   // Increment TX_NEXT
   tx_next++;
@@ -203,6 +207,10 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
   if (pdu->N_bytes <= cfg.hdr_len_bytes) {
     return;
   }
+
+  // Update metrics
+  metrics.num_rx_pdus++;
+  metrics.num_rx_pdu_bytes += pdu->N_bytes;
   logger.debug("Rx PDCP state - RX_NEXT=%u, RX_DELIV=%u, RX_REORD=%u", rx_next, rx_deliv, rx_reord);
 
   // Extract RCVD_SN from header
@@ -286,13 +294,16 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
   }
 
   // Check if PDU has been received
-  if (reorder_queue.find(rcvd_count) != reorder_queue.end()) {
+  if (reorder_queue.has_count(rx_deliv, rcvd_count)) {
     logger.debug("Duplicate PDU, dropping");
     return; // PDU already present, drop.
   }
 
   // Store PDU in reception buffer
-  reorder_queue[rcvd_count] = std::move(pdu);
+  if (not reorder_queue.add(rx_deliv, rcvd_count, std::move(pdu))) {
+    logger.warning("RCVD_COUNT %u outside of the reception window (RX_DELIV %u), dropping", rcvd_count, rx_deliv);
+    return;
+  }
 
   // Update RX_NEXT
   if (rcvd_count >= rx_next) {
@@ -304,6 +315,8 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
   if (rcvd_count == rx_deliv) {
     // Deliver to upper layers in ascending order of associated COUNT
     deliver_all_consecutive_counts();
+  } else {
+    metrics.num_rx_reordered_pdus++;
   }
 
   // Handle reordering timers
@@ -331,6 +344,7 @@ void pdcp_entity_nr::notify_delivery(const pdcp_sn_vector_t& pdcp_sns)
     // Remove timer from map
     logger.debug("Stopping discard timer for SN=%ld", sn);
     discard_timers_map.erase(sn);
+    split_leg_map.erase(sn);
   }
 }
 
@@ -343,30 +357,33 @@ void pdcp_entity_nr::notify_failure(const pdcp_sn_vector_t& pdcp_sns)
  * Packing / Unpacking Helpers
  */
 
-// Deliver all consecutively associated COUNTs.
-// Update RX_NEXT after submitting to higher layers
+// Deliver all consecutively associated COUNTs, together with the SDUs already in the batch.
+// Update RX_DELIV after submitting to higher layers
 void pdcp_entity_nr::deliver_all_consecutive_counts()
 {
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = reorder_queue.begin();
-       it != reorder_queue.end() && it->first == rx_deliv;
-       reorder_queue.erase(it++)) {
-    logger.debug("Delivering SDU with RCVD_COUNT %u", it->first);
-
-    // Check RX_DELIV overflow
+  // The whole in-sequence run is located in the received bitmap first, and then delivered in one batch
+  uint32_t last_count = reorder_queue.find_first_missing(rx_deliv, rx_next);
+  if (last_count != rx_deliv) {
     if (rx_overflow) {
       logger.warning("RX_DELIV has overflowed. Droping packet");
-      return;
-    }
-    if (rx_deliv + 1 == 0) {
-      rx_overflow = true;
+    } else {
+      // Check RX_DELIV overflow. The run stops after the maximum COUNT
+      if (last_count < rx_deliv) {
+        rx_overflow = true;
+        last_count  = 0;
+      }
+      logger.debug("Delivering SDUs with RCVD_COUNT %u to %u", rx_deliv, last_count - 1);
+      reorder_queue.pop_range(rx_deliv, last_count, [this](uint32_t count, unique_byte_buffer_t sdu) {
+        rx_batch.push_back(std::move(sdu));
+      });
+
+      // Update RX_DELIV
+      rx_deliv = last_count;
     }
-
-    // Pass PDCP SDU to the next layers
-    pass_to_upper_layers(std::move(it->second));
-
-    // Update RX_DELIV
-    rx_deliv = rx_deliv + 1;
   }
+
+  // Pass PDCP SDUs to the next layers
+  pass_to_upper_layers();
 }
 
 /*
@@ -378,13 +395,15 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
   parent->logger.info(
       "Reordering timer expired. RX_REORD=%u, re-order queue size=%ld", parent->rx_reord, parent->reorder_queue.size());
 
-  // Deliver all PDCP SDU(s) with associated COUNT value(s) < RX_REORD
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = parent->reorder_queue.begin();
-       it != parent->reorder_queue.end() && it->first < parent->rx_reord;
-       parent->reorder_queue.erase(it++)) {
-    // Deliver to upper layers
-    parent->pass_to_upper_layers(std::move(it->second));
-  }
+  // Deliver all PDCP SDU(s) with associated COUNT value(s) < RX_REORD. They are passed to the upper layers in the same
+  // batch as the SDUs consecutive to RX_REORD
+  size_t nof_batched = parent->rx_batch.size();
+  parent->reorder_queue.pop_range(parent->rx_deliv, parent->rx_reord, [this](uint32_t count, unique_byte_buffer_t sdu) {
+    parent->rx_batch.push_back(std::move(sdu));
+  });
+  uint32_t nof_delivered = parent->rx_batch.size() - nof_batched;
+  parent->metrics.num_rx_reordering_timeouts++;
+  parent->metrics.num_rx_lost_pdus += (parent->rx_reord - parent->rx_deliv) - nof_delivered;
 
   // Update RX_DELIV to the first PDCP SDU not delivered to the upper layers
   parent->rx_deliv = parent->rx_reord;
@@ -408,13 +427,116 @@ void pdcp_entity_nr::discard_callback::operator()(uint32_t timer_id)
   parent->logger.debug("Discard timer expired for PDU with SN=%d", discard_sn);
 
   // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
-  parent->rlc->discard_sdu(parent->lcid, discard_sn);
+  parent->discard_in_lower_layers(discard_sn);
 
   // Remove timer from map
   // NOTE: this will delete the callback. It *must* be the last instruction.
+  parent->split_leg_map.erase(discard_sn);
   parent->discard_timers_map.erase(discard_sn);
 }
 
+/*
+ * Split bearer
+ */
+bool pdcp_entity_nr::add_split_bearer_leg(srsue::rlc_interface_pdcp*     leg_rlc,
+                                          uint32_t                       leg_lcid,
+                                          const pdcp_split_bearer_cfg_t& split_cfg)
+{
+  if (not is_drb()) {
+    logger.error("%s: Split bearers are only supported for DRBs", rb_name.c_str());
+    return false;
+  }
+  if (split_cfg.feedback_period_ms == 0) {
+    logger.error("%s: Invalid split bearer feedback period of 0ms", rb_name.c_str());
+    return false;
+  }
+  split_rlc  = leg_rlc;
+  split_lcid = leg_lcid;
+  split_flow_ctrl.reset(new pdcp_split_bearer_flow_ctrl(split_cfg));
+  split_leg_map.clear();
+
+  // The buffer occupancy of the RLC of both legs is sampled once per feedback period. The timer is restarted from its
+  // own callback, i.e. before the current tic is accounted, so it is set one tic longer than the period
+  split_feedback_timer = task_sched.get_unique_timer();
+  split_feedback_timer.set(split_cfg.feedback_period_ms + 1, [this](uint32_t tid) {
+    handle_split_feedback();
+    split_feedback_timer.run();
+  });
+  split_feedback_timer.run();
+
+  logger.info("%s: Added split bearer leg with LCID=%d. Split threshold %dB, max leg delay %dms",
+              rb_name.c_str(),
+              leg_lcid,
+              split_cfg.split_threshold_bytes,
+              split_cfg.max_leg_delay_ms);
+  return true;
+}
+
+void pdcp_entity_nr::del_split_bearer_leg()
+{
+  if (not is_split_bearer()) {
+    return;
+  }
+  split_feedback_timer.release();
+  split_flow_ctrl.reset();
+  split_leg_map.clear();
+  split_rlc  = nullptr;
+  split_lcid = 0;
+  logger.info("%s: Removed split bearer leg", rb_name.c_str());
+}
+
+void pdcp_entity_nr::handle_split_feedback()
+{
+  uint32_t elapsed_ms = split_flow_ctrl->get_cfg().feedback_period_ms;
+  split_flow_ctrl->handle_buffer_state(
+      pdcp_split_bearer_flow_ctrl::primary_leg, rlc->get_buffer_state(lcid), elapsed_ms);
+  split_flow_ctrl->handle_buffer_state(
+      pdcp_split_bearer_flow_ctrl::secondary_leg, split_rlc->get_buffer_state(split_lcid), elapsed_ms);
+}
+
+bool pdcp_entity_nr::lower_layers_full()
+{
+  if (not is_split_bearer()) {
+    return rlc->sdu_queue_is_full(lcid);
+  }
+  // Congestion is assessed with the latest occupancy of both legs
+  return split_flow_ctrl->is_congested(0) or
+         (rlc->sdu_queue_is_full(lcid) and split_rlc->sdu_queue_is_full(split_lcid));
+}
+
+void pdcp_entity_nr::write_to_lower_layers(unique_byte_buffer_t pdu)
+{
+  if (not is_split_bearer()) {
+    rlc->write_sdu(lcid, std::move(pdu));
+    return;
+  }
+
+  pdcp_split_bearer_flow_ctrl::leg_t leg = split_flow_ctrl->select_leg(
+      pdu->N_bytes, rlc->sdu_queue_is_full(lcid), split_rlc->sdu_queue_is_full(split_lcid));
+  bool on_secondary = leg == pdcp_split_bearer_flow_ctrl::secondary_leg;
+
+  if (discard_timers_map.count(pdu->md.pdcp_sn) > 0) {
+    split_leg_map[pdu->md.pdcp_sn] = leg;
+  }
+  if (on_secondary) {
+    logger.debug("%s: TX PDU with COUNT=%d over the secondary leg", rb_name.c_str(), pdu->md.pdcp_sn);
+    split_rlc->write_sdu(split_lcid, std::move(pdu));
+  } else {
+    rlc->write_sdu(lcid, std::move(pdu));
+  }
+}
+
+void pdcp_entity_nr::discard_in_lower_layers(uint32_t discard_count)
+{
+  auto leg_it       = split_leg_map.find(discard_count);
+  bool on_secondary = leg_it != split_leg_map.end() and leg_it->second == pdcp_split_bearer_flow_ctrl::secondary_leg;
+  if (is_split_bearer() and on_secondary) {
+    split_rlc->discard_sdu(split_lcid, discard_count);
+  } else {
+    rlc->discard_sdu(lcid, discard_count);
+  }
+}
+
 void pdcp_entity_nr::get_bearer_state(pdcp_lte_state_t* state)
 {
   // TODO
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/upper/pdcp_split_bearer.h"
+#include <algorithm>
+
+namespace srsran {
+
+pdcp_split_bearer_flow_ctrl::pdcp_split_bearer_flow_ctrl(const pdcp_split_bearer_cfg_t& cfg_) : cfg(cfg_)
+{
+  cfg.feedback_period_ms = std::max(cfg.feedback_period_ms, 1U);
+  for (leg_ctxt_t& leg : legs) {
+    leg.rate_bytes_per_ms = std::max(cfg.initial_rate_bytes_per_ms, 1U);
+  }
+}
+
+void pdcp_split_bearer_flow_ctrl::handle_buffer_state(leg_t leg_idx, uint32_t buffered_bytes, uint32_t elapsed_ms)
+{
+  leg_ctxt_t& leg = legs[leg_idx];
+
+  // Bytes pulled by the lower layers of the leg since the last sample
+  uint32_t expected_bytes = leg.buffered_bytes + leg.written_bytes;
+  uint32_t drained_bytes  = expected_bytes > buffered_bytes ? expected_bytes - buffered_bytes : 0;
+  double   rate           = drained_bytes / (double)std::max(elapsed_ms, 1U);
+
+  // If the leg ran empty, the measurement is only a lower bound of its throughput
+  if (buffered_bytes > 0 or rate > leg.rate_bytes_per_ms) {
+    leg.rate_bytes_per_ms = cfg.rate_avg_coeff * rate + (1 - cfg.rate_avg_coeff) * leg.rate_bytes_per_ms;
+  }
+  // Keep the estimate positive, so that a stalled leg can be probed again
+  leg.rate_bytes_per_ms = std::max(leg.rate_bytes_per_ms, 1.0);
+
+  leg.buffered_bytes = buffered_bytes;
+  leg.written_bytes  = 0;
+}
+
+double pdcp_split_bearer_flow_ctrl::expected_delay_ms(leg_t leg, uint32_t pdu_len) const
+{
+  return (get_occupancy(leg) + pdu_len) / legs[leg].rate_bytes_per_ms;
+}
+
+pdcp_split_bearer_flow_ctrl::leg_t
+pdcp_split_bearer_flow_ctrl::select_leg(uint32_t pdu_len, bool primary_queue_full, bool secondary_queue_full)
+{
+  leg_t selected = primary_leg;
+  if (primary_queue_full != secondary_queue_full) {
+    selected = primary_queue_full ? secondary_leg : primary_leg;
+  } else if (get_occupancy(primary_leg) + pdu_len > cfg.split_threshold_bytes and
+             expected_delay_ms(secondary_leg, pdu_len) < expected_delay_ms(primary_leg, pdu_len)) {
+    selected = secondary_leg;
+  }
+
+  leg_ctxt_t& leg = legs[selected];
+  leg.written_bytes += pdu_len;
+  leg.num_tx_pdus++;
+  leg.num_tx_pdu_bytes += pdu_len;
+  return selected;
+}
+
+bool pdcp_split_bearer_flow_ctrl::is_congested(uint32_t pdu_len) const
+{
+  return expected_delay_ms(primary_leg, pdu_len) > cfg.max_leg_delay_ms and
+         expected_delay_ms(secondary_leg, pdu_len) > cfg.max_leg_delay_ms;
+}
+
+pdcp_split_bearer_flow_ctrl::leg_metrics_t pdcp_split_bearer_flow_ctrl::get_metrics(leg_t leg_idx) const
+{
+  const leg_ctxt_t& leg = legs[leg_idx];
+  leg_metrics_t     m;
+  m.num_tx_pdus       = leg.num_tx_pdus;
+  m.num_tx_pdu_bytes  = leg.num_tx_pdu_bytes;
+  m.buffered_bytes    = leg.buffered_bytes;
+  m.rate_bytes_per_ms = leg.rate_bytes_per_ms;
+  return m;
+}
+
+} // namespace srsran
@@ -20,6 +20,7 @@
  */
 
 #include <complex.h>
+#include <math.h>
 
 #include "srsran/phy/agc/agc.h"
 #include "srsran/phy/utils/debug.h"
@@ -73,6 +74,7 @@ void srsran_agc_reset(srsran_agc_t* q)
   q->state     = SRSRAN_AGC_STATE_INIT;
   q->bandwidth = SRSRAN_AGC_DEFAULT_BW;
   q->gain_db   = q->default_gain_db;
+  q->isfirst   = true;
   if (q->set_gain_callback && q->uhd_handler) {
     q->set_gain_callback(q->uhd_handler, q->default_gain_db);
   }
@@ -97,13 +99,35 @@ void srsran_agc_set_gain(srsran_agc_t* q, float init_gain_value_db)
   q->gain_db = init_gain_value_db;
 }
 
+int srsran_agc_set_fast_attack(srsran_agc_t* q, float attack_tc, float decay_tc, uint32_t hold_frames)
+{
+  if (q == NULL || !(attack_tc > 0.0f && decay_tc > 0.0f)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Convert the time constants into the coefficients of the exponential moving average
+  q->attack_coeff = 1.0f - expf(-1.0f / attack_tc);
+  q->decay_coeff  = 1.0f - expf(-1.0f / decay_tc);
+  q->hold_frames  = hold_frames;
+  q->fast_attack  = true;
+  return SRSRAN_SUCCESS;
+}
+
+float srsran_agc_get_avg_power(srsran_agc_t* q)
+{
+  return q->avg_power;
+}
+
+float srsran_agc_get_peak_power(srsran_agc_t* q)
+{
+  return q->peak_power;
+}
+
 /*
  * Transition functions
  */
-static inline void agc_enter_state_hold(srsran_agc_t* q)
+static inline float agc_bound_gain(srsran_agc_t* q, float gain_db)
 {
-  // Bound gain in dB
-  float gain_db = q->gain_db + q->gain_offset_db;
   if (gain_db < q->min_gain_db) {
     gain_db = q->min_gain_db;
     INFO("Warning: Rx signal strength is too high. Forcing minimum Rx gain %.2fdB", gain_db);
@@ -114,21 +138,42 @@ static inline void agc_enter_state_hold(srsran_agc_t* q)
     gain_db = q->default_gain_db;
     INFO("Warning: AGC went to an unknown state. Setting Rx gain to %.2fdB", gain_db);
   }
+  return gain_db;
+}
+
+static inline void agc_enter_state_measure(srsran_agc_t* q)
+{
+  q->hold_cnt = 0;
+  q->state    = SRSRAN_AGC_STATE_MEASURE;
+
+  // In fast-attack mode the envelope survives gain changes
+  if (!q->fast_attack) {
+    q->isfirst = true;
+  }
+}
+
+static inline void agc_enter_state_hold(srsran_agc_t* q)
+{
+  // Bound gain in dB
+  float gain_db = agc_bound_gain(q, q->gain_db + q->gain_offset_db);
 
   // Set gain
-  q->set_gain_callback(q->uhd_handler, gain_db);
+  if (q->set_gain_callback) {
+    q->set_gain_callback(q->uhd_handler, gain_db);
+  }
+
+  // Refer the envelope to the new gain, so that it remains valid during the next measurements
+  if (q->fast_attack) {
+    q->y_out *= srsran_convert_dB_to_amplitude(gain_db - q->gain_db);
+  }
   q->gain_db = gain_db;
 
   // Set holding period
   q->hold_cnt = 0;
   q->state    = SRSRAN_AGC_STATE_HOLD;
-}
-
-static inline void agc_enter_state_measure(srsran_agc_t* q)
-{
-  q->hold_cnt = 0;
-  q->isfirst  = true;
-  q->state    = SRSRAN_AGC_STATE_MEASURE;
+  if (q->fast_attack && q->hold_frames == 0) {
+    agc_enter_state_measure(q);
+  }
 }
 
 /*
@@ -146,7 +191,8 @@ static inline void agc_run_state_measure(srsran_agc_t* q, cf_t* signal, uint32_t
   float* t;
   switch (q->mode) {
     case SRSRAN_AGC_MODE_ENERGY:
-      y = sqrtf(crealf(srsran_vec_dot_prod_conj_ccc(signal, signal, len)) / len);
+      srsran_vec_power_peak_cf(signal, len, &q->avg_power, &q->peak_power);
+      y = sqrtf(q->avg_power);
       break;
     case SRSRAN_AGC_MODE_PEAK_AMPLITUDE:
       t = (float*)signal;
@@ -199,13 +245,49 @@ static inline void agc_run_state_measure(srsran_agc_t* q, cf_t* signal, uint32_t
   }
 }
 
+static inline void agc_run_state_measure_fast(srsran_agc_t* q, cf_t* signal, uint32_t len)
+{
+  // Single pass measurement of the average and peak power of the frame
+  srsran_vec_power_peak_cf(signal, len, &q->avg_power, &q->peak_power);
+  float peak    = sqrtf(q->peak_power);
+  float y       = (q->mode == SRSRAN_AGC_MODE_ENERGY) ? sqrtf(q->avg_power) : peak;
+  bool  clipped = peak >= SRSRAN_AGC_CLIP_LEVEL;
+
+  // Envelope follower, which tracks rising levels faster than falling ones. Clipped frames are taken as they are
+  if (q->isfirst || clipped) {
+    q->y_out   = y;
+    q->isfirst = false;
+  } else {
+    float alpha = (y > q->y_out) ? q->attack_coeff : q->decay_coeff;
+    q->y_out    = SRSRAN_VEC_EMA(y, q->y_out, alpha);
+  }
+  q->gain_offset_db = srsran_convert_amplitude_to_dB(q->target) - srsran_convert_amplitude_to_dB(q->y_out);
+
+  if (q->hold_cnt < SRSRAN_AGC_MIN_MEASUREMENTS) {
+    q->hold_cnt++;
+  }
+
+  // Reduce the gain right away, but only increase it after a minimum of measurements
+  bool attack = q->gain_offset_db < -SRSRAN_AGC_MIN_GAIN_OFFSET || (clipped && q->gain_offset_db < 0.0f);
+  bool decay  = q->hold_cnt >= SRSRAN_AGC_MIN_MEASUREMENTS && q->gain_offset_db > SRSRAN_AGC_MIN_GAIN_OFFSET;
+  if ((attack || decay) && agc_bound_gain(q, q->gain_db + q->gain_offset_db) != q->gain_db) {
+    INFO("AGC gain offset: %.2f y_out=%.3f, y=%.3f peak=%.3f target=%.1f",
+         q->gain_offset_db,
+         q->y_out,
+         y,
+         peak,
+         q->target);
+    agc_enter_state_hold(q);
+  }
+}
+
 static inline void agc_run_state_hold(srsran_agc_t* q)
 {
   // Increment holding counter
   q->hold_cnt++;
 
   // Check holding counter
-  if (q->hold_cnt >= SRSRAN_AGC_HOLD_COUNT) {
+  if (q->hold_cnt >= (q->fast_attack ? q->hold_frames : SRSRAN_AGC_HOLD_COUNT)) {
     // Enter state measure
     agc_enter_state_measure(q);
   }
@@ -227,7 +309,11 @@ void srsran_agc_process(srsran_agc_t* q, cf_t* signal, uint32_t len)
       agc_run_state_hold(q);
       break;
     case SRSRAN_AGC_STATE_MEASURE:
-      agc_run_state_measure(q, signal, len);
+      if (q->fast_attack) {
+        agc_run_state_measure_fast(q, signal, len);
+      } else {
+        agc_run_state_measure(q, signal, len);
+      }
       break;
     case SRSRAN_AGC_STATE_INIT:
     default:
@@ -0,0 +1,322 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+#define NOF_SIGNAL_FRAMES 16
+#define CONVERGED_MARGIN_DB 3.0f
+#define CONVERGED_NOF_FRAMES 5
+
+static uint32_t          sf_len          = 1920;
+static uint32_t          nof_frames      = 600;
+static uint32_t          step_period     = 200;
+static float             step_db         = 30.0f;
+static uint32_t          gain_latency    = 2;
+static float             attack_tc       = 1.0f;
+static float             decay_tc        = 20.0f;
+static uint32_t          hold_frames     = 3;
+static int               nof_repetitions = 10000;
+static srsran_agc_mode_t agc_mode        = SRSRAN_AGC_MODE_ENERGY;
+
+/* Simulated radio, the gain requested by the AGC is applied after some frames, as done by the RF gain thread */
+typedef struct {
+  float    gain_db;
+  float    requested_gain_db;
+  uint32_t pending_frames;
+} radio_sim_t;
+
+static void radio_sim_set_gain(void* h, float gain_db)
+{
+  radio_sim_t* radio       = (radio_sim_t*)h;
+  radio->requested_gain_db = gain_db;
+  radio->pending_frames    = gain_latency + 1;
+}
+
+static void radio_sim_tick(radio_sim_t* radio)
+{
+  if (radio->pending_frames > 0 && --radio->pending_frames == 0) {
+    radio->gain_db = radio->requested_gain_db;
+  }
+}
+
+static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
+{
+  if (ts_end->tv_usec > ts_start->tv_usec) {
+    return ((double)ts_end->tv_sec - (double)ts_start->tv_sec) * 1000000 + (double)ts_end->tv_usec -
+           (double)ts_start->tv_usec;
+  } else {
+    return ((double)ts_end->tv_sec - (double)ts_start->tv_sec - 1) * 1000000 + ((double)ts_end->tv_usec + 1000000) -
+           (double)ts_start->tv_usec;
+  }
+}
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-m AGC mode: energy, peak [Default energy]\n");
+  printf("\t-f Number of frames [Default %d]\n", nof_frames);
+  printf("\t-s Frames between level steps [Default %d]\n", step_period);
+  printf("\t-l Radio gain latency in frames [Default %d]\n", gain_latency);
+  printf("\t-a Fast-attack time constant in frames [Default %.1f]\n", attack_tc);
+  printf("\t-d Slow-decay time constant in frames [Default %.1f]\n", decay_tc);
+  printf("\t-H Fast-attack hold frames [Default %d]\n", hold_frames);
+  printf("\t-r Number of repetitions of the power measurement benchmark [Default %d]\n", nof_repetitions);
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "mfsladHr")) != -1) {
+    switch (opt) {
+      case 'm':
+        if (strcmp(argv[optind], "peak") == 0) {
+          agc_mode = SRSRAN_AGC_MODE_PEAK_AMPLITUDE;
+        } else if (strcmp(argv[optind], "energy") == 0) {
+          agc_mode = SRSRAN_AGC_MODE_ENERGY;
+        } else {
+          usage(argv[0]);
+          return SRSRAN_ERROR;
+        }
+        break;
+      case 'f':
+        nof_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        step_period = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'l':
+        gain_latency = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'a':
+        attack_tc = strtof(argv[optind], NULL);
+        break;
+      case 'd':
+        decay_tc = strtof(argv[optind], NULL);
+        break;
+      case 'H':
+        hold_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (int)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Runs the AGC over a signal whose level alternates between two values every step_period frames, i.e. the first step
+ * makes the signal stronger and clip, and the next one weaker. Returns the worst number of frames, after a step, that
+ * the AGC takes to bring the Rx level within CONVERGED_MARGIN_DB of the target, or -1 if it does not converge.
+ */
+static int run_simulation(cf_t** tx_frames, cf_t* rx_frame, bool fast_attack, int* attack_frames, int* decay_frames)
+{
+  radio_sim_t  radio = {};
+  srsran_agc_t agc;
+  if (srsran_agc_init_uhd(&agc, agc_mode, 0, radio_sim_set_gain, &radio) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising AGC");
+    return SRSRAN_ERROR;
+  }
+  srsran_agc_set_gain_range(&agc, 0.0f, 90.0f);
+  if (fast_attack && srsran_agc_set_fast_attack(&agc, attack_tc, decay_tc, hold_frames) < SRSRAN_SUCCESS) {
+    ERROR("Error setting AGC fast-attack mode");
+    srsran_agc_free(&agc);
+    return SRSRAN_ERROR;
+  }
+  srsran_agc_reset(&agc);
+  radio.gain_db = srsran_agc_get_gain(&agc);
+
+  const float target_db = srsran_convert_amplitude_to_dB(agc.target);
+  // The peak amplitude of a frame of Gaussian samples is about 9 dB above its RMS value
+  const float peak_to_rms_db = (agc_mode == SRSRAN_AGC_MODE_PEAK_AMPLITUDE) ? 9.0f : 0.0f;
+
+  *attack_frames = 0;
+  *decay_frames  = 0;
+  int      worst_attack = 0, worst_decay = 0;
+  uint32_t step_frame = 0, converged_cnt = 0;
+  bool     converged = false;
+  for (uint32_t i = 0; i < nof_frames; i++) {
+    // Level of the signal at the antenna, the first period leaves the AGC converging from the default gain
+    bool  strong   = (i / step_period) % 2 == 1;
+    float level_db = (strong ? step_db : 0.0f) - 60.0f;
+    if (i > 0 && i % step_period == 0) {
+      if (!converged) {
+        break;
+      }
+      step_frame    = i;
+      converged     = false;
+      converged_cnt = 0;
+    }
+
+    // Receive frame, clipping the samples at the ADC full scale
+    float amplitude = srsran_convert_dB_to_amplitude(level_db + radio.gain_db);
+    srsran_vec_sc_prod_cfc(tx_frames[i % NOF_SIGNAL_FRAMES], amplitude, rx_frame, sf_len);
+    float* rx = (float*)rx_frame;
+    for (uint32_t j = 0; j < 2 * sf_len; j++) {
+      rx[j] = SRSRAN_MAX(-1.0f, SRSRAN_MIN(1.0f, rx[j]));
+    }
+    float rx_level_db = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(rx_frame, sf_len));
+
+    srsran_agc_process(&agc, rx_frame, sf_len);
+    radio_sim_tick(&radio);
+
+    // Check convergence
+    if (fabsf(rx_level_db + peak_to_rms_db - target_db) < CONVERGED_MARGIN_DB) {
+      converged_cnt++;
+    } else {
+      converged_cnt = 0;
+      converged     = false;
+    }
+    if (!converged && converged_cnt == CONVERGED_NOF_FRAMES) {
+      converged  = true;
+      int frames = (int)(i - step_frame) - CONVERGED_NOF_FRAMES + 1;
+      if (step_frame == 0) {
+        // Initial acquisition, not accounted
+      } else if (strong) {
+        worst_attack = SRSRAN_MAX(worst_attack, frames);
+      } else {
+        worst_decay = SRSRAN_MAX(worst_decay, frames);
+      }
+    }
+  }
+  srsran_agc_free(&agc);
+
+  if (!converged) {
+    return SRSRAN_ERROR;
+  }
+  *attack_frames = worst_attack;
+  *decay_frames  = worst_decay;
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Compares the single pass power and peak measurement with separate average power and maximum searches
+ */
+static void run_benchmark(const cf_t* frame)
+{
+  struct timeval t[3];
+  float          avg_power = 0, peak_power = 0;
+  double         acc = 0;
+
+  gettimeofday(&t[1], NULL);
+  for (int i = 0; i < nof_repetitions; i++) {
+    avg_power  = srsran_vec_avg_power_cf(frame, sf_len);
+    peak_power = SRSRAN_CSQABS(frame[srsran_vec_max_abs_ci(frame, sf_len)]);
+    acc += avg_power + peak_power;
+  }
+  gettimeofday(&t[2], NULL);
+  double separate_us = elapsed_us(&t[1], &t[2]);
+
+  gettimeofday(&t[1], NULL);
+  for (int i = 0; i < nof_repetitions; i++) {
+    srsran_vec_power_peak_cf(frame, sf_len, &avg_power, &peak_power);
+    acc -= avg_power + peak_power;
+  }
+  gettimeofday(&t[2], NULL);
+  double fused_us = elapsed_us(&t[1], &t[2]);
+
+  printf("Power measurement of %d samples: separate %.1f MSamp/s, single pass %.1f MSamp/s (check %.1e)\n",
+         sf_len,
+         (double)sf_len * nof_repetitions / separate_us,
+         (double)sf_len * nof_repetitions / fused_us,
+         acc);
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_random_t random_gen                   = srsran_random_init(0x1234);
+  cf_t*           tx_frames[NOF_SIGNAL_FRAMES] = {};
+  cf_t*           rx_frame                     = srsran_vec_cf_malloc(sf_len);
+  if (random_gen == NULL || rx_frame == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  // Unit power Gaussian signal, as an OFDM signal
+  for (uint32_t i = 0; i < NOF_SIGNAL_FRAMES; i++) {
+    tx_frames[i] = srsran_vec_cf_malloc(sf_len);
+    if (tx_frames[i] == NULL) {
+      ERROR("Error allocating memory");
+      goto clean_exit;
+    }
+    for (uint32_t j = 0; j < sf_len; j++) {
+      __real__ tx_frames[i][j] = srsran_random_gauss_dist(random_gen, M_SQRT1_2);
+      __imag__ tx_frames[i][j] = srsran_random_gauss_dist(random_gen, M_SQRT1_2);
+    }
+  }
+
+  int slow_attack = 0, slow_decay = 0, fast_attack = 0, fast_decay = 0;
+  if (run_simulation(tx_frames, rx_frame, false, &slow_attack, &slow_decay) < SRSRAN_SUCCESS) {
+    ERROR("Default AGC did not converge");
+    goto clean_exit;
+  }
+  if (run_simulation(tx_frames, rx_frame, true, &fast_attack, &fast_decay) < SRSRAN_SUCCESS) {
+    ERROR("Fast-attack AGC did not converge");
+    goto clean_exit;
+  }
+  printf("Convergence after a %+.0f/%+.0f dB step (frames): default AGC %d/%d, fast-attack AGC %d/%d\n",
+         step_db,
+         -step_db,
+         slow_attack,
+         slow_decay,
+         fast_attack,
+         fast_decay);
+
+  // The fast-attack mode must recover from a strong signal faster than the default AGC
+  if (fast_attack >= slow_attack) {
+    ERROR("Fast-attack AGC is not faster than the default AGC (%d >= %d frames)", fast_attack, slow_attack);
+    goto clean_exit;
+  }
+
+  run_benchmark(tx_frames[0]);
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t i = 0; i < NOF_SIGNAL_FRAMES; i++) {
+    if (tx_frames[i]) {
+      free(tx_frames[i]);
+    }
+  }
+  if (rx_frame) {
+    free(rx_frame);
+  }
+  if (random_gen) {
+    srsran_random_free(random_gen);
+  }
+  printf("%s!\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
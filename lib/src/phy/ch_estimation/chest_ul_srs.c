@@ -0,0 +1,362 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/ch_estimation/chest_ul_srs.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <float.h>
+#include <string.h>
+
+// The SRS is transmitted every other subcarrier
+#define SRS_COMB_SPACING_HZ (2 * 15000.0f)
+#define SRS_MAX_NOF_RE(max_prb) ((max_prb)*SRSRAN_NRE / 2)
+#define SRS_SB_NOF_RE (SRSRAN_CHEST_UL_SRS_SB_NOF_PRB * SRSRAN_NRE / 2)
+
+// Lowest reported SINR, in linear units
+#define SRS_MIN_SNR 1e-3f
+
+// Minimum number of taps the noise is estimated from, if the UE windows leave them
+#define SRS_MIN_NOISE_TAPS 16
+
+int srsran_chest_ul_srs_init(srsran_chest_ul_srs_t* q, uint32_t max_prb)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_chest_ul_srs_t, 1);
+
+  uint32_t max_re       = SRS_MAX_NOF_RE(max_prb);
+  q->pilot_recv_signal  = srsran_vec_cf_malloc(max_re);
+  q->pilot_known_signal = srsran_vec_cf_malloc(2 * max_re);
+  q->cir                = srsran_vec_cf_malloc(max_re);
+  q->ue_cir             = srsran_vec_cf_malloc(max_re);
+  q->ue_ce              = srsran_vec_cf_malloc(max_re);
+  q->power              = srsran_vec_f_malloc(max_re);
+  q->tap_dist           = srsran_vec_u16_malloc(max_re);
+  q->tap_hist           = srsran_vec_u32_malloc(max_re);
+  if (q->pilot_recv_signal == NULL || q->pilot_known_signal == NULL || q->cir == NULL || q->ue_cir == NULL ||
+      q->ue_ce == NULL || q->power == NULL || q->tap_dist == NULL || q->tap_hist == NULL) {
+    ERROR("Error allocating memory");
+    srsran_chest_ul_srs_free(q);
+    return SRSRAN_ERROR;
+  }
+  q->max_prb = max_prb;
+
+  return SRSRAN_SUCCESS;
+}
+
+static void chest_ul_srs_free_dft(srsran_chest_ul_srs_t* q)
+{
+  for (uint32_t i = 0; i < q->nof_dft; i++) {
+    srsran_dft_plan_free(&q->ifft[i]);
+    srsran_dft_plan_free(&q->fft[i]);
+  }
+  q->nof_dft = 0;
+}
+
+void srsran_chest_ul_srs_free(srsran_chest_ul_srs_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  chest_ul_srs_free_dft(q);
+
+  if (q->pilot_recv_signal) {
+    free(q->pilot_recv_signal);
+  }
+  if (q->pilot_known_signal) {
+    free(q->pilot_known_signal);
+  }
+  if (q->cir) {
+    free(q->cir);
+  }
+  if (q->ue_cir) {
+    free(q->ue_cir);
+  }
+  if (q->ue_ce) {
+    free(q->ue_ce);
+  }
+  if (q->power) {
+    free(q->power);
+  }
+  if (q->tap_dist) {
+    free(q->tap_dist);
+  }
+  if (q->tap_hist) {
+    free(q->tap_hist);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_chest_ul_srs_t, 1);
+}
+
+static int chest_ul_srs_find_dft(const srsran_chest_ul_srs_t* q, uint32_t M_sc)
+{
+  for (uint32_t i = 0; i < q->nof_dft; i++) {
+    if (q->dft_size[i] == M_sc) {
+      return (int)i;
+    }
+  }
+  return SRSRAN_ERROR;
+}
+
+int srsran_chest_ul_srs_set_cell(srsran_chest_ul_srs_t* q, srsran_cell_t cell)
+{
+  if (q == NULL || !srsran_cell_isvalid(&cell) || cell.nof_prb > q->max_prb) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->nof_dft > 0 && q->cell.id == cell.id && q->cell.nof_prb == cell.nof_prb && q->cell.cp == cell.cp) {
+    return SRSRAN_SUCCESS;
+  }
+  q->cell = cell;
+
+  if (srsran_refsignal_ul_set_cell(&q->refsignal, cell) < SRSRAN_SUCCESS) {
+    ERROR("Error setting SRS cell");
+    return SRSRAN_ERROR;
+  }
+
+  // Plan the DFT pairs for all the SRS bandwidths the cell can configure, so that no DFT is planned in real time
+  chest_ul_srs_free_dft(q);
+  srsran_refsignal_srs_cfg_t cfg = {};
+  for (cfg.bw_cfg = 0; cfg.bw_cfg < 8; cfg.bw_cfg++) {
+    for (cfg.B = 0; cfg.B < 4; cfg.B++) {
+      uint32_t M_sc = srsran_refsignal_srs_M_sc(&q->refsignal, &cfg);
+      if (M_sc == 0 || chest_ul_srs_find_dft(q, M_sc) >= SRSRAN_SUCCESS) {
+        continue;
+      }
+      if (q->nof_dft == SRSRAN_CHEST_UL_SRS_MAX_NOF_DFT) {
+        ERROR("Too many SRS bandwidths");
+        return SRSRAN_ERROR;
+      }
+      if (srsran_dft_plan_c(&q->ifft[q->nof_dft], M_sc, SRSRAN_DFT_BACKWARD) < SRSRAN_SUCCESS ||
+          srsran_dft_plan_c(&q->fft[q->nof_dft], M_sc, SRSRAN_DFT_FORWARD) < SRSRAN_SUCCESS) {
+        ERROR("Error creating SRS DFT of size %d", M_sc);
+        return SRSRAN_ERROR;
+      }
+      srsran_dft_plan_set_norm(&q->ifft[q->nof_dft], true);
+      srsran_dft_plan_set_norm(&q->fft[q->nof_dft], true);
+      q->dft_size[q->nof_dft] = M_sc;
+      q->nof_dft++;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static bool chest_ul_srs_cfg_isvalid(const srsran_refsignal_srs_cfg_t* cfg)
+{
+  return cfg->bw_cfg < 8 && cfg->B < 4 && cfg->k_tc < 2 && cfg->n_srs < SRSRAN_NOF_CSHIFT;
+}
+
+// Position of the first channel tap of a UE after the IFFT. A cyclic shift n_srs delays the channel taps by
+// -n_srs * M_sc / 8 samples
+static uint32_t chest_ul_srs_tap_pos(uint32_t n_srs, uint32_t M_sc)
+{
+  return (M_sc - n_srs * (M_sc / SRSRAN_NOF_CSHIFT)) % M_sc;
+}
+
+static float chest_ul_srs_snr_db(float power, float bias, float noise)
+{
+  return srsran_convert_power_to_dB(SRSRAN_MAX(power - bias, noise * SRS_MIN_SNR) / noise);
+}
+
+static bool chest_ul_srs_in_group(srsran_chest_ul_srs_t*      q,
+                                  srsran_refsignal_srs_cfg_t* cfg,
+                                  uint32_t                    tti,
+                                  uint32_t                    k0,
+                                  uint32_t                    M_sc)
+{
+  return srsran_refsignal_srs_k0_ue(&q->refsignal, cfg, tti) == k0 &&
+         srsran_refsignal_srs_M_sc(&q->refsignal, cfg) == M_sc;
+}
+
+// Measures the UEs, from "first" on, that sound the M_sc subcarriers starting at k0. The least squares estimate of
+// these subcarriers must be in pilot_recv_signal
+static void chest_ul_srs_estimate_group(srsran_chest_ul_srs_t*      q,
+                                        uint32_t                    tti,
+                                        srsran_refsignal_srs_cfg_t* cfg,
+                                        uint32_t                    first,
+                                        uint32_t                    nof_ue,
+                                        uint32_t                    k0,
+                                        uint32_t                    M_sc,
+                                        uint32_t                    dft_idx,
+                                        srsran_chest_ul_srs_res_t*  res)
+{
+  // Each cyclic shift owns M_sc / 8 taps. The first quarter is kept for channel taps that arrive early, the next half
+  // for the delay spread and the rest is only noise and interference
+  uint32_t W    = M_sc / SRSRAN_NOF_CSHIFT;
+  int      pre  = (int)(W / 4);
+  int      post = (int)SRSRAN_MAX(W / 2, 1);
+
+  // Separate the UEs in the time domain
+  srsran_dft_run_c(&q->ifft[dft_idx], q->pilot_recv_signal, q->cir);
+  srsran_vec_abs_square_cf(q->cir, q->power, M_sc);
+
+  // Distance of every tap to the closest UE window, taps in a window are at distance 0
+  for (uint32_t n = 0; n < M_sc; n++) {
+    q->tap_dist[n] = (uint16_t)M_sc;
+  }
+  for (uint32_t i = first; i < nof_ue; i++) {
+    if (chest_ul_srs_in_group(q, &cfg[i], tti, k0, M_sc)) {
+      uint32_t pos = chest_ul_srs_tap_pos(cfg[i].n_srs, M_sc);
+      for (int j = -pre; j < post; j++) {
+        q->tap_dist[(pos + M_sc + j) % M_sc] = 0;
+      }
+    }
+  }
+  uint32_t d = M_sc;
+  for (uint32_t n = 0; n < 2 * M_sc; n++) {
+    d                     = SRSRAN_MIN(d + 1, q->tap_dist[n % M_sc]);
+    q->tap_dist[n % M_sc] = (uint16_t)d;
+  }
+  d = M_sc;
+  for (uint32_t n = 2 * M_sc; n > 0; n--) {
+    d                           = SRSRAN_MIN(d + 1, q->tap_dist[(n - 1) % M_sc]);
+    q->tap_dist[(n - 1) % M_sc] = (uint16_t)d;
+  }
+
+  // Estimate noise and interference from the taps furthest from the UE windows, where the sidelobes of the UEs with
+  // fractional delays are weakest. The guard distance is the largest that leaves enough taps for a stable estimate
+  uint32_t min_noise_taps = SRSRAN_MAX(M_sc / 4, SRS_MIN_NOISE_TAPS);
+  memset(q->tap_hist, 0, sizeof(uint32_t) * M_sc);
+  for (uint32_t n = 0; n < M_sc; n++) {
+    q->tap_hist[SRSRAN_MIN(q->tap_dist[n], M_sc - 1)]++;
+  }
+  uint32_t guard        = M_sc - 1;
+  uint32_t nof_noise_re = q->tap_hist[guard];
+  while (guard > 1 && nof_noise_re < min_noise_taps) {
+    guard--;
+    nof_noise_re += q->tap_hist[guard];
+  }
+  float noise = 0.0f;
+  for (uint32_t n = 0; n < M_sc; n++) {
+    if (q->tap_dist[n] >= guard) {
+      noise += q->power[n];
+    }
+  }
+  noise = nof_noise_re > 0 ? noise / nof_noise_re : 0.0f;
+  if (fpclassify(noise) == FP_ZERO) {
+    noise = FLT_MIN;
+  }
+
+  // Noise kept in the window of a UE, per subcarrier
+  float    bias     = noise * (pre + post) / M_sc;
+  uint32_t nof_sb   = M_sc / SRS_SB_NOF_RE;
+  float    noise_db = srsran_convert_power_to_dB(noise);
+
+  for (uint32_t i = first; i < nof_ue; i++) {
+    if (!chest_ul_srs_in_group(q, &cfg[i], tti, k0, M_sc)) {
+      continue;
+    }
+    uint32_t pos = chest_ul_srs_tap_pos(cfg[i].n_srs, M_sc);
+
+    // Take the taps of the UE window, removing its cyclic shift
+    srsran_vec_cf_zero(q->ue_cir, M_sc);
+    int   peak_idx   = 0;
+    float peak_power = -1.0f;
+    for (int j = -pre; j < post; j++) {
+      cf_t  tap                    = q->cir[(pos + M_sc + j) % M_sc];
+      float tap_power              = __real__ tap * __real__ tap + __imag__ tap * __imag__ tap;
+      q->ue_cir[(M_sc + j) % M_sc] = tap;
+      if (tap_power > peak_power) {
+        peak_power = tap_power;
+        peak_idx   = j;
+      }
+    }
+
+    // Frequency response of the UE
+    srsran_dft_run_c(&q->fft[dft_idx], q->ue_cir, q->ue_ce);
+    srsran_vec_abs_square_cf(q->ue_ce, q->power, M_sc);
+
+    float wb_power = 0.0f;
+    for (uint32_t sb = 0; sb < nof_sb; sb++) {
+      float sb_power       = srsran_vec_acc_ff(&q->power[sb * SRS_SB_NOF_RE], SRS_SB_NOF_RE) / SRS_SB_NOF_RE;
+      res[i].sb_snr_db[sb] = chest_ul_srs_snr_db(sb_power, bias, noise);
+      wb_power += sb_power;
+    }
+    res[i].prb_start           = k0 / SRSRAN_NRE;
+    res[i].nof_sb              = nof_sb;
+    res[i].snr_db              = chest_ul_srs_snr_db(wb_power / nof_sb, bias, noise);
+    res[i].noise_estimate_dbFs = noise_db;
+    res[i].ta_us               = (float)peak_idx * 1e6f / (SRS_COMB_SPACING_HZ * M_sc);
+  }
+}
+
+int srsran_chest_ul_srs_estimate(srsran_chest_ul_srs_t*             q,
+                                 const srsran_ul_sf_cfg_t*          sf,
+                                 srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                                 srsran_refsignal_srs_cfg_t*        cfg,
+                                 uint32_t                           nof_ue,
+                                 const cf_t*                        input,
+                                 srsran_chest_ul_srs_res_t*         res)
+{
+  if (q == NULL || sf == NULL || pusch_cfg == NULL || (nof_ue > 0 && (cfg == NULL || input == NULL || res == NULL))) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    if (!chest_ul_srs_cfg_isvalid(&cfg[i])) {
+      ERROR("Invalid SRS configuration");
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  uint32_t    sf_idx = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  const cf_t* symbol = &input[SRSRAN_RE_IDX(q->cell.nof_prb, 2 * SRSRAN_CP_NSYMB(q->cell.cp) - 1, 0)];
+
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    uint32_t k0   = srsran_refsignal_srs_k0_ue(&q->refsignal, &cfg[i], sf->tti);
+    uint32_t M_sc = srsran_refsignal_srs_M_sc(&q->refsignal, &cfg[i]);
+
+    // Skip the UEs already measured in the group of a previous UE
+    bool processed = false;
+    for (uint32_t j = 0; j < i && !processed; j++) {
+      processed = chest_ul_srs_in_group(q, &cfg[j], sf->tti, k0, M_sc);
+    }
+    if (processed) {
+      continue;
+    }
+
+    int dft_idx = chest_ul_srs_find_dft(q, M_sc);
+    if (dft_idx < SRSRAN_SUCCESS || k0 + 2 * (M_sc - 1) >= q->cell.nof_prb * SRSRAN_NRE) {
+      ERROR("Invalid SRS allocation k0=%d, M_sc=%d", k0, M_sc);
+      return SRSRAN_ERROR;
+    }
+
+    // Least squares estimate of the group, with the common base sequence
+    for (uint32_t k = 0; k < M_sc; k++) {
+      q->pilot_recv_signal[k] = symbol[k0 + 2 * k];
+    }
+    srsran_refsignal_srs_cfg_t base_cfg = cfg[i];
+    base_cfg.n_srs                      = 0;
+    if (srsran_refsignal_srs_gen(&q->refsignal, &base_cfg, pusch_cfg, sf_idx, q->pilot_known_signal) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error generating SRS");
+      return SRSRAN_ERROR;
+    }
+    srsran_vec_prod_conj_ccc(q->pilot_recv_signal, q->pilot_known_signal, q->pilot_recv_signal, M_sc);
+
+    chest_ul_srs_estimate_group(q, sf->tti, cfg, i, nof_ue, k0, M_sc, (uint32_t)dft_idx, res);
+  }
+
+  return SRSRAN_SUCCESS;
+}
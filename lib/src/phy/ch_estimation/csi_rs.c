@@ -22,10 +22,12 @@
 #include "srsran/phy/ch_estimation/csi_rs.h"
 #include "srsran/phy/common/sequence.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <complex.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 /**
  * @brief Maximum number of subcarriers occupied by a CSI-RS resource as defined in TS 38.211 Table 7.4.1.5.3-1
@@ -35,7 +37,7 @@
 /**
  * @brief Maximum number of symbols occupied by a CSI-RS resource as defined in TS 38.211 Table 7.4.1.5.3-1
  */
-#define CSI_RS_MAX_SYMBOLS_SLOT 4
+#define CSI_RS_MAX_SYMBOLS_SLOT SRSRAN_CSI_RS_MAX_SYMBOLS_SLOT
 
 #define RESOURCE_ERROR(R)                                                                                              \
   do {                                                                                                                 \
@@ -749,34 +751,11 @@ int srsran_csi_rs_nzp_measure(const srsran_carrier_nr_t*          carrier,
   return SRSRAN_SUCCESS;
 }
 
-int srsran_csi_rs_nzp_measure_trs(const srsran_carrier_nr_t*     carrier,
-                                  const srsran_slot_cfg_t*       slot_cfg,
-                                  const srsran_csi_rs_nzp_set_t* set,
-                                  const cf_t*                    grid,
-                                  srsran_csi_trs_measurements_t* measure)
+static int csi_rs_nzp_trs_average(const srsran_carrier_nr_t*          carrier,
+                                  const csi_rs_nzp_resource_measure_t* measurements,
+                                  uint32_t                             count,
+                                  srsran_csi_trs_measurements_t*       measure)
 {
-  // Verify inputs
-  if (carrier == NULL || slot_cfg == NULL || set == NULL || grid == NULL || measure == NULL) {
-    return SRSRAN_ERROR;
-  }
-
-  // Verify it is a TRS set
-  if (!set->trs_info) {
-    ERROR("The set is not configured as TRS");
-    return SRSRAN_ERROR;
-  }
-
-  // Perform Measurements
-  csi_rs_nzp_resource_measure_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
-  int                           ret = csi_rs_nzp_measure_set(carrier, slot_cfg, set, grid, measurements);
-
-  // Return to prevent assigning negative values to count
-  if (ret < SRSRAN_SUCCESS) {
-    ERROR("Error performing measurements");
-    return SRSRAN_ERROR;
-  }
-  uint32_t count = (uint32_t)ret;
-
   // No NZP-CSI-RS has been scheduled for this slot
   if (count == 0) {
     return 0;
@@ -853,17 +832,23 @@ int srsran_csi_rs_nzp_measure_trs(const srsran_carrier_nr_t*     carrier,
   return count;
 }
 
-int srsran_csi_rs_nzp_measure_channel(const srsran_carrier_nr_t*         carrier,
-                                      const srsran_slot_cfg_t*           slot_cfg,
-                                      const srsran_csi_rs_nzp_set_t*     set,
-                                      const cf_t*                        grid,
-                                      srsran_csi_channel_measurements_t* measure)
+int srsran_csi_rs_nzp_measure_trs(const srsran_carrier_nr_t*     carrier,
+                                  const srsran_slot_cfg_t*       slot_cfg,
+                                  const srsran_csi_rs_nzp_set_t* set,
+                                  const cf_t*                    grid,
+                                  srsran_csi_trs_measurements_t* measure)
 {
   // Verify inputs
   if (carrier == NULL || slot_cfg == NULL || set == NULL || grid == NULL || measure == NULL) {
     return SRSRAN_ERROR;
   }
 
+  // Verify it is a TRS set
+  if (!set->trs_info) {
+    ERROR("The set is not configured as TRS");
+    return SRSRAN_ERROR;
+  }
+
   // Perform Measurements
   csi_rs_nzp_resource_measure_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
   int                           ret = csi_rs_nzp_measure_set(carrier, slot_cfg, set, grid, measurements);
@@ -873,8 +858,14 @@ int srsran_csi_rs_nzp_measure_channel(const srsran_carrier_nr_t*         carrier
     ERROR("Error performing measurements");
     return SRSRAN_ERROR;
   }
-  uint32_t count = (uint32_t)ret;
 
+  return csi_rs_nzp_trs_average(carrier, measurements, (uint32_t)ret, measure);
+}
+
+static int csi_rs_nzp_channel_average(const csi_rs_nzp_resource_measure_t* measurements,
+                                      uint32_t                             count,
+                                      srsran_csi_channel_measurements_t*   measure)
+{
   // No NZP-CSI-RS has been scheduled for this slot
   if (count == 0) {
     return 0;
@@ -909,6 +900,477 @@ int srsran_csi_rs_nzp_measure_channel(const srsran_carrier_nr_t*         carrier
   return count;
 }
 
+int srsran_csi_rs_nzp_measure_channel(const srsran_carrier_nr_t*         carrier,
+                                      const srsran_slot_cfg_t*           slot_cfg,
+                                      const srsran_csi_rs_nzp_set_t*     set,
+                                      const cf_t*                        grid,
+                                      srsran_csi_channel_measurements_t* measure)
+{
+  // Verify inputs
+  if (carrier == NULL || slot_cfg == NULL || set == NULL || grid == NULL || measure == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // Perform Measurements
+  csi_rs_nzp_resource_measure_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  int                           ret = csi_rs_nzp_measure_set(carrier, slot_cfg, set, grid, measurements);
+
+  // Return to prevent assigning negative values to count
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error performing measurements");
+    return SRSRAN_ERROR;
+  }
+
+  return csi_rs_nzp_channel_average(measurements, (uint32_t)ret, measure);
+}
+
+/*
+ * NZP-CSI-RS set measurement tables
+ */
+static void csi_rs_nzp_table_resource_free(srsran_csi_rs_nzp_table_resource_t* r)
+{
+  if (r->re_idx) {
+    free(r->re_idx);
+  }
+  if (r->sequence_ready) {
+    free(r->sequence_ready);
+  }
+  if (r->sequence) {
+    free(r->sequence);
+  }
+  SRSRAN_MEM_ZERO(r, srsran_csi_rs_nzp_table_resource_t, 1);
+}
+
+static uint32_t csi_rs_gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  return a;
+}
+
+static int csi_rs_nzp_table_resource_set(srsran_csi_rs_nzp_table_resource_t* r,
+                                         const srsran_carrier_nr_t*          carrier,
+                                         const srsran_csi_rs_nzp_resource_t* resource)
+{
+  csi_rs_nzp_table_resource_free(r);
+
+  // Force CDM group to 0
+  uint32_t j = 0;
+
+  // Get subcarrier indexes
+  uint32_t k_list[CSI_RS_MAX_SUBC_PRB];
+  int      nof_k = csi_rs_location_get_k_list(&resource->resource_mapping, j, k_list);
+  if (nof_k <= 0) {
+    return SRSRAN_ERROR;
+  }
+
+  // Get symbol indexes
+  int nof_l = csi_rs_location_get_l_list(&resource->resource_mapping, j, r->l_list);
+  if (nof_l <= 0) {
+    return SRSRAN_ERROR;
+  }
+  r->nof_l = (uint32_t)nof_l;
+
+  // Calculate Resource Block boundaries
+  uint32_t rb_begin  = csi_rs_rb_begin(carrier, &resource->resource_mapping);
+  uint32_t rb_end    = csi_rs_rb_end(carrier, &resource->resource_mapping);
+  uint32_t rb_stride = csi_rs_rb_stride(&resource->resource_mapping);
+
+  // Calculate ideal number of RE per symbol
+  r->nof_re = (rb_end > rb_begin) ? csi_rs_count(resource->resource_mapping.density, rb_end - rb_begin) : 0;
+  if (r->nof_re == 0) {
+    ERROR("Invalid number of RE for NZP-CSI-RS resource %d", resource->id);
+    return SRSRAN_ERROR;
+  }
+
+  // Subcarrier index of every RE
+  r->re_idx = srsran_vec_u32_malloc(r->nof_re);
+  if (r->re_idx == NULL) {
+    return SRSRAN_ERROR;
+  }
+  uint32_t count_re = 0;
+  for (uint32_t n = rb_begin; n < rb_end && count_re < r->nof_re; n += rb_stride) {
+    for (uint32_t k_idx = 0; k_idx < nof_k && count_re < r->nof_re; k_idx++) {
+      r->re_idx[count_re++] = SRSRAN_NRE * n + k_list[k_idx];
+    }
+  }
+
+  // Verify RE count matches the expected number of RE
+  if (count_re != r->nof_re) {
+    ERROR("Unmatched number of RE (%d != %d)", count_re, r->nof_re);
+    return SRSRAN_ERROR;
+  }
+
+  // A resource that is never transmitted does not need sequences
+  if (resource->periodicity.period == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // The slots of a frame carrying the resource are congruent with its offset modulo the GCD of the period and the
+  // number of slots in a frame, hence there are only as many different sequences as slots of a frame in this stride
+  uint32_t nof_slots_per_frame = SRSRAN_NSLOTS_PER_FRAME_NR(carrier->scs);
+  r->slot_stride               = csi_rs_gcd(resource->periodicity.period, nof_slots_per_frame);
+  r->nof_slots                 = nof_slots_per_frame / r->slot_stride;
+  r->sequence_ready            = SRSRAN_MEM_ALLOC(bool, r->nof_slots);
+  r->sequence                  = srsran_vec_cf_malloc(r->nof_slots * r->nof_l * r->nof_re);
+  if (r->sequence_ready == NULL || r->sequence == NULL) {
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(r->sequence_ready, bool, r->nof_slots);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_csi_rs_nzp_table_init(srsran_csi_rs_nzp_table_t* q)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_csi_rs_nzp_table_t, 1);
+
+  q->lse = srsran_vec_cf_malloc(CSI_RS_MAX_SUBC_PRB * SRSRAN_MAX_PRB_NR);
+  if (q->lse == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_csi_rs_nzp_table_free(srsran_csi_rs_nzp_table_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET; i++) {
+    csi_rs_nzp_table_resource_free(&q->resources[i]);
+  }
+
+  if (q->lse) {
+    free(q->lse);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_csi_rs_nzp_table_t, 1);
+}
+
+static bool csi_rs_resource_mapping_equal(const srsran_csi_rs_resource_mapping_t* a,
+                                          const srsran_csi_rs_resource_mapping_t* b)
+{
+  if (a->row != b->row || a->nof_ports != b->nof_ports || a->first_symbol_idx != b->first_symbol_idx ||
+      a->first_symbol_idx2 != b->first_symbol_idx2 || a->cdm != b->cdm || a->density != b->density ||
+      a->freq_band.start_rb != b->freq_band.start_rb || a->freq_band.nof_rb != b->freq_band.nof_rb) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_CSI_RS_NOF_FREQ_DOMAIN_ALLOC_MAX; i++) {
+    if (a->frequency_domain_alloc[i] != b->frequency_domain_alloc[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Compares field by field, as the padding bytes of the structures are not guaranteed to be initialised
+static bool csi_rs_nzp_resource_equal(const srsran_csi_rs_nzp_resource_t* a, const srsran_csi_rs_nzp_resource_t* b)
+{
+  return a->id == b->id && csi_rs_resource_mapping_equal(&a->resource_mapping, &b->resource_mapping) &&
+         a->power_control_offset == b->power_control_offset &&
+         a->power_control_offset_ss == b->power_control_offset_ss && a->scrambling_id == b->scrambling_id &&
+         a->periodicity.period == b->periodicity.period && a->periodicity.offset == b->periodicity.offset;
+}
+
+bool srsran_csi_rs_nzp_table_match(const srsran_csi_rs_nzp_table_t* q,
+                                   const srsran_carrier_nr_t*       carrier,
+                                   const srsran_csi_rs_nzp_set_t*   set)
+{
+  if (q == NULL || carrier == NULL || set == NULL || !q->configured) {
+    return false;
+  }
+
+  // Only the carrier parameters that affect the resource mapping are relevant
+  if (q->carrier.nof_prb != carrier->nof_prb || q->carrier.start != carrier->start || q->carrier.scs != carrier->scs) {
+    return false;
+  }
+
+  if (q->set.count != set->count || q->set.trs_info != set->trs_info) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < set->count; i++) {
+    if (!csi_rs_nzp_resource_equal(&q->set.data[i], &set->data[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int srsran_csi_rs_nzp_table_set(srsran_csi_rs_nzp_table_t*     q,
+                                const srsran_carrier_nr_t*     carrier,
+                                const srsran_csi_rs_nzp_set_t* set)
+{
+  if (q == NULL || carrier == NULL || set == NULL || set->count > SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Skip if the tables are up to date
+  if (srsran_csi_rs_nzp_table_match(q, carrier, set)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  q->configured = false;
+  q->carrier    = *carrier;
+  memcpy(&q->set, set, sizeof(srsran_csi_rs_nzp_set_t));
+
+  for (uint32_t i = 0; i < set->count; i++) {
+    if (csi_rs_nzp_table_resource_set(&q->resources[i], carrier, &set->data[i]) < SRSRAN_SUCCESS) {
+      char res_info_str[256];
+      srsran_csi_rs_resource_mapping_info(&set->data[i].resource_mapping, res_info_str, sizeof(res_info_str));
+      ERROR("Error computing NZP-CSI-RS tables for resource %s", res_info_str);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  q->configured = true;
+
+  return SRSRAN_SUCCESS;
+}
+
+static const cf_t*
+csi_rs_nzp_table_get_sequence(srsran_csi_rs_nzp_table_t* q, uint32_t i, const srsran_slot_cfg_t* slot_cfg)
+{
+  srsran_csi_rs_nzp_table_resource_t* r        = &q->resources[i];
+  const srsran_csi_rs_nzp_resource_t* resource = &q->set.data[i];
+
+  uint32_t slot_idx = SRSRAN_SLOT_NR_MOD(q->carrier.scs, slot_cfg->idx) / SRSRAN_MAX(r->slot_stride, 1);
+  if (slot_idx >= r->nof_slots) {
+    return NULL;
+  }
+
+  cf_t* sequence = &r->sequence[slot_idx * r->nof_l * r->nof_re];
+
+  // Generate the sequences the first time the resource is transmitted in this slot of the frame
+  if (!r->sequence_ready[slot_idx]) {
+    uint32_t rb_begin = csi_rs_rb_begin(&q->carrier, &resource->resource_mapping);
+    for (uint32_t l_idx = 0; l_idx < r->nof_l; l_idx++) {
+      uint32_t                cinit          = csi_rs_cinit(&q->carrier, slot_cfg, resource, r->l_list[l_idx]);
+      srsran_sequence_state_t sequence_state = {};
+      srsran_sequence_state_init(&sequence_state, cinit);
+
+      // Skip unallocated RB
+      srsran_sequence_state_advance(&sequence_state, 2 * csi_rs_count(resource->resource_mapping.density, rb_begin));
+
+      srsran_sequence_state_gen_f(&sequence_state, M_SQRT1_2, (float*)&sequence[l_idx * r->nof_re], 2 * r->nof_re);
+    }
+    r->sequence_ready[slot_idx] = true;
+  }
+
+  return sequence;
+}
+
+/**
+ * @brief Computes the least square estimates lse = y * conj(r) and, in the same pass, their total power and the
+ * correlation between consecutive estimates, from which the average delay is derived
+ */
+static float csi_rs_nzp_lse(const cf_t* y, const cf_t* r, cf_t* lse, uint32_t nof_re, cf_t* lag_corr)
+{
+  float    power = 0.0f;
+  cf_t     corr  = 0.0f;
+  uint32_t i     = 0;
+
+  if (nof_re == 0) {
+    *lag_corr = 0.0f;
+    return 0.0f;
+  }
+
+  lse[0] = y[0] * conjf(r[0]);
+  power  = SRSRAN_CSQABS(lse[0]);
+  i      = 1;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t simd_corr  = srsran_simd_cf_zero();
+  simd_f_t  simd_power = srsran_simd_f_zero();
+  for (; i + SRSRAN_SIMD_CF_SIZE <= nof_re; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t z = srsran_simd_cf_conjprod(srsran_simd_cfi_loadu(&y[i]), srsran_simd_cfi_loadu(&r[i]));
+    srsran_simd_cfi_storeu(&lse[i], z);
+
+    // The previous estimates have been stored already
+    simd_cf_t z_prev = srsran_simd_cfi_loadu(&lse[i - 1]);
+    simd_corr        = srsran_simd_cf_add(simd_corr, srsran_simd_cf_conjprod(z, z_prev));
+
+    simd_f_t re = srsran_simd_cf_re(z);
+    simd_f_t im = srsran_simd_cf_im(z);
+    simd_f_t p  = srsran_simd_f_add(srsran_simd_f_mul(re, re), srsran_simd_f_mul(im, im));
+    simd_power  = srsran_simd_f_add(simd_power, p);
+  }
+
+  srsran_simd_aligned float corr_re[SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned float corr_im[SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned float power_v[SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_f_store(corr_re, srsran_simd_cf_re(simd_corr));
+  srsran_simd_f_store(corr_im, srsran_simd_cf_im(simd_corr));
+  srsran_simd_f_store(power_v, simd_power);
+  for (uint32_t k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+    __real__ corr += corr_re[k];
+    __imag__ corr += corr_im[k];
+    power += power_v[k];
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < nof_re; i++) {
+    lse[i] = y[i] * conjf(r[i]);
+    corr += lse[i] * conjf(lse[i - 1]);
+    power += SRSRAN_CSQABS(lse[i]);
+  }
+
+  *lag_corr = corr;
+  return power;
+}
+
+static int csi_rs_nzp_table_measure_set(srsran_csi_rs_nzp_table_t*    q,
+                                        const srsran_slot_cfg_t*      slot_cfg,
+                                        const cf_t*                   grid,
+                                        csi_rs_nzp_resource_measure_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET])
+{
+  uint32_t    active[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  const cf_t* sequences[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  float       delay_acc[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  uint32_t    count = 0;
+
+  // Select the resources transmitted in this slot
+  for (uint32_t i = 0; i < q->set.count; i++) {
+    if (!srsran_csi_rs_send(&q->set.data[i].periodicity, slot_cfg)) {
+      continue;
+    }
+
+    sequences[count] = csi_rs_nzp_table_get_sequence(q, i, slot_cfg);
+    if (sequences[count] == NULL) {
+      ERROR("Error getting NZP-CSI-RS sequence");
+      return SRSRAN_ERROR;
+    }
+    active[count]    = i;
+    delay_acc[count] = 0.0f;
+    SRSRAN_MEM_ZERO(&measurements[count], csi_rs_nzp_resource_measure_t, 1);
+    count++;
+  }
+
+  if (count == 0) {
+    return 0;
+  }
+
+  // Walk the grid once, measuring all the resources of a symbol while the symbol is in cache
+  for (uint32_t l = 0; l < SRSRAN_NSYMB_PER_SLOT_NR; l++) {
+    const cf_t* symbol = &grid[l * SRSRAN_NRE * q->carrier.nof_prb];
+
+    for (uint32_t c = 0; c < count; c++) {
+      const srsran_csi_rs_nzp_table_resource_t* r = &q->resources[active[c]];
+      for (uint32_t l_idx = 0; l_idx < r->nof_l; l_idx++) {
+        if (r->l_list[l_idx] != l) {
+          continue;
+        }
+
+        // Extract RE
+        for (uint32_t i = 0; i < r->nof_re; i++) {
+          q->lse[i] = symbol[r->re_idx[i]];
+        }
+
+        // Compute LSE, EPRE and average delay
+        cf_t  lag_corr = 0.0f;
+        float power    = csi_rs_nzp_lse(q->lse, &sequences[c][l_idx * r->nof_re], q->lse, r->nof_re, &lag_corr);
+        float delay    = -cargf(lag_corr) * M_1_PI * 0.5f;
+        delay_acc[c] += delay;
+        measurements[c].epre += power / (float)r->nof_re;
+
+        // Pre-compensate delay to avoid RSRP measurements get affected by average delay
+        srsran_vec_apply_cfo(q->lse, delay, q->lse, (int)r->nof_re);
+
+        // Compute correlation
+        measurements[c].corr += srsran_vec_acc_cc(q->lse, r->nof_re) / (float)r->nof_re;
+      }
+    }
+  }
+
+  // Set measure fields
+  for (uint32_t c = 0; c < count; c++) {
+    const srsran_csi_rs_nzp_table_resource_t* r = &q->resources[active[c]];
+    measurements[c].cri                         = q->set.data[active[c]].id;
+    measurements[c].l0                          = r->l_list[0];
+    measurements[c].epre /= (float)r->nof_l;
+    measurements[c].corr /= (float)r->nof_l;
+    measurements[c].delay_us = 1e6f * delay_acc[c] / ((float)r->nof_l * SRSRAN_SUBC_SPACING_NR(q->carrier.scs));
+    measurements[c].nof_re   = r->nof_l * r->nof_re;
+  }
+
+  return (int)count;
+}
+
+int srsran_csi_rs_nzp_table_measure_trs(srsran_csi_rs_nzp_table_t*     q,
+                                        const srsran_slot_cfg_t*       slot_cfg,
+                                        const cf_t*                    grid,
+                                        srsran_csi_trs_measurements_t* measure)
+{
+  // Verify inputs
+  if (q == NULL || slot_cfg == NULL || grid == NULL || measure == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (!q->configured) {
+    ERROR("NZP-CSI-RS tables are not configured");
+    return SRSRAN_ERROR;
+  }
+
+  // Verify it is a TRS set
+  if (!q->set.trs_info) {
+    ERROR("The set is not configured as TRS");
+    return SRSRAN_ERROR;
+  }
+
+  // Perform Measurements
+  csi_rs_nzp_resource_measure_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  int                           ret = csi_rs_nzp_table_measure_set(q, slot_cfg, grid, measurements);
+
+  // Return to prevent assigning negative values to count
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error performing measurements");
+    return SRSRAN_ERROR;
+  }
+
+  return csi_rs_nzp_trs_average(&q->carrier, measurements, (uint32_t)ret, measure);
+}
+
+int srsran_csi_rs_nzp_table_measure_channel(srsran_csi_rs_nzp_table_t*         q,
+                                            const srsran_slot_cfg_t*           slot_cfg,
+                                            const cf_t*                        grid,
+                                            srsran_csi_channel_measurements_t* measure)
+{
+  // Verify inputs
+  if (q == NULL || slot_cfg == NULL || grid == NULL || measure == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  if (!q->configured) {
+    ERROR("NZP-CSI-RS tables are not configured");
+    return SRSRAN_ERROR;
+  }
+
+  // Perform Measurements
+  csi_rs_nzp_resource_measure_t measurements[SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET];
+  int                           ret = csi_rs_nzp_table_measure_set(q, slot_cfg, grid, measurements);
+
+  // Return to prevent assigning negative values to count
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Error performing measurements");
+    return SRSRAN_ERROR;
+  }
+
+  return csi_rs_nzp_channel_average(measurements, (uint32_t)ret, measure);
+}
+
 /**
  * @brief Internal ZP-CSI-RS measurement structure
  */
@@ -0,0 +1,281 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/ch_estimation/chest_ul_srs.h"
+#include "srsran/srsran.h"
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static srsran_cell_t cell = {50,             // nof_prb
+                             1,              // nof_ports
+                             2,              // cell_id
+                             SRSRAN_CP_NORM, // cyclic prefix
+                             SRSRAN_PHICH_NORM,
+                             SRSRAN_PHICH_R_1, // PHICH length
+                             SRSRAN_FDD};
+
+static srsran_refsignal_dmrs_pusch_cfg_t dmrs_pusch_cfg = {};
+
+#define MAX_NOF_UE 32
+#define NOF_POSITIONS 4
+#define NOF_REPETITIONS 100
+#define TA_US_TOLERANCE 0.5f
+
+// The narrow SRS bandwidths leave few taps for the noise estimate and few degrees of freedom per subband
+#define SB_SNR_DB_TOLERANCE(M_sc) ((M_sc) < 144 ? 6.0f : 4.0f)
+#define WB_SNR_DB_TOLERANCE(M_sc) ((M_sc) < 144 ? 6.0f : 3.0f)
+
+static const uint32_t n_srs_values[] = {0, 2, 5, 7};
+#define NOF_N_SRS (sizeof(n_srs_values) / sizeof(uint32_t))
+
+static uint32_t tti    = 0;
+static uint32_t bw_cfg = 0;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [rcv]\n", prog);
+  printf("\t-r nof_prb [Default %d]\n", cell.nof_prb);
+  printf("\t-c cell_id [Default %d]\n", cell.id);
+  printf("\t-v increase verbosity\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "r:c:v")) != -1) {
+    switch (opt) {
+      case 'r':
+        cell.nof_prb = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'c':
+        cell.id = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+typedef struct {
+  float gain;
+  float a1;
+  float delay_s;
+} test_channel_t;
+
+static cf_t test_channel_freq_response(const test_channel_t* ch, uint32_t k)
+{
+  return ch->gain * (1.0f + ch->a1 * cexpf(-I * 2.0f * (float)M_PI * 15e3f * k * ch->delay_s));
+}
+
+// Selects the SRS of up to MAX_NOF_UE UEs with bandwidth index B: both combs, several frequency positions and
+// several cyclic shifts per position
+static uint32_t test_select_ue(srsran_refsignal_ul_t* refsignal, uint32_t B, srsran_refsignal_srs_cfg_t* cfg)
+{
+  uint32_t nof_ue = 0;
+  for (uint32_t k_tc = 0; k_tc < 2; k_tc++) {
+    uint32_t k0_list[NOF_POSITIONS];
+    uint32_t nof_positions = 0;
+    for (uint32_t n_rrc = 0; n_rrc < 24 && nof_positions < NOF_POSITIONS; n_rrc++) {
+      srsran_refsignal_srs_cfg_t c = {};
+      c.configured                 = true;
+      c.subframe_config            = 0;
+      c.bw_cfg                     = bw_cfg;
+      c.B                          = B;
+      c.b_hop                      = 3;
+      c.k_tc                       = k_tc;
+      c.n_rrc                      = n_rrc;
+      c.I_srs                      = 0;
+
+      uint32_t k0  = srsran_refsignal_srs_k0_ue(refsignal, &c, tti);
+      bool     new = true;
+      for (uint32_t i = 0; i < nof_positions; i++) {
+        new = new && k0_list[i] != k0;
+      }
+      if (!new) {
+        continue;
+      }
+      k0_list[nof_positions++] = k0;
+      for (uint32_t i = 0; i < NOF_N_SRS && nof_ue < MAX_NOF_UE; i++) {
+        c.n_srs       = n_srs_values[i];
+        cfg[nof_ue++] = c;
+      }
+    }
+  }
+  return nof_ue;
+}
+
+static int test_srs_B(srsran_chest_ul_srs_t* q, srsran_channel_awgn_t* awgn, cf_t* sf_symbols, uint32_t B)
+{
+  srsran_refsignal_ul_t      refsignal = {};
+  srsran_refsignal_srs_cfg_t cfg[MAX_NOF_UE];
+  test_channel_t             channel[MAX_NOF_UE];
+  srsran_chest_ul_srs_res_t  res[MAX_NOF_UE];
+  srsran_ul_sf_cfg_t         ul_sf = {};
+  ul_sf.tti                        = tti;
+
+  TESTASSERT(srsran_refsignal_ul_set_cell(&refsignal, cell) == SRSRAN_SUCCESS);
+  uint32_t nof_ue = test_select_ue(&refsignal, B, cfg);
+  TESTASSERT(nof_ue > 0);
+
+  // Noise power of 1 per subcarrier, SNR between 5 and 15 dB
+  uint32_t sf_len = SRSRAN_SF_LEN_RE(cell.nof_prb, cell.cp);
+  srsran_vec_cf_zero(sf_symbols, sf_len);
+  srsran_channel_awgn_set_n0(awgn, 0.0f);
+  srsran_channel_awgn_run_c(awgn, sf_symbols, sf_symbols, sf_len);
+
+  cf_t     r_srs[2 * SRSRAN_MAX_PRB * SRSRAN_NRE / 2];
+  cf_t*    symbol = &sf_symbols[SRSRAN_RE_IDX(cell.nof_prb, 2 * SRSRAN_CP_NSYMB(cell.cp) - 1, 0)];
+  uint32_t M_sc   = srsran_refsignal_srs_M_sc(&refsignal, &cfg[0]);
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    channel[i].gain    = srsran_convert_dB_to_amplitude(5.0f + 10.0f * (float)rand() / RAND_MAX);
+    channel[i].a1      = 0.5f * (float)rand() / RAND_MAX;
+    channel[i].delay_s = 0.3e-6f * (float)rand() / RAND_MAX;
+
+    TESTASSERT(srsran_refsignal_srs_gen(&refsignal, &cfg[i], &dmrs_pusch_cfg, tti % SRSRAN_NOF_SF_X_FRAME, r_srs) ==
+               SRSRAN_SUCCESS);
+    uint32_t k0 = srsran_refsignal_srs_k0_ue(&refsignal, &cfg[i], tti);
+    for (uint32_t k = 0; k < M_sc; k++) {
+      symbol[k0 + 2 * k] += test_channel_freq_response(&channel[i], k0 + 2 * k) * r_srs[k];
+    }
+  }
+
+  TESTASSERT(srsran_chest_ul_srs_estimate(q, &ul_sf, &dmrs_pusch_cfg, cfg, nof_ue, sf_symbols, res) ==
+             SRSRAN_SUCCESS);
+
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    uint32_t k0 = srsran_refsignal_srs_k0_ue(&refsignal, &cfg[i], tti);
+    TESTASSERT(res[i].prb_start == k0 / SRSRAN_NRE);
+    TESTASSERT(res[i].nof_sb * SRSRAN_CHEST_UL_SRS_SB_NOF_PRB * SRSRAN_NRE / 2 == M_sc);
+    TESTASSERT(fabsf(res[i].ta_us) < TA_US_TOLERANCE);
+    INFO("B=%d; ue=%d; noise_estimate_dbFs=%+.1f; ta_us=%.2f", B, i, res[i].noise_estimate_dbFs, res[i].ta_us);
+    TESTASSERT(fabsf(res[i].noise_estimate_dbFs) < WB_SNR_DB_TOLERANCE(M_sc));
+
+    // Expected SINR per subband, averaged over the SRS subcarriers
+    float wb_power = 0.0f;
+    for (uint32_t sb = 0; sb < res[i].nof_sb; sb++) {
+      float sb_power = 0.0f;
+      for (uint32_t k = 0; k < SRSRAN_CHEST_UL_SRS_SB_NOF_PRB * SRSRAN_NRE / 2; k++) {
+        uint32_t sc = k0 + 2 * (sb * SRSRAN_CHEST_UL_SRS_SB_NOF_PRB * SRSRAN_NRE / 2 + k);
+        cf_t     h  = test_channel_freq_response(&channel[i], sc);
+        sb_power += __real__ h * __real__ h + __imag__ h * __imag__ h;
+      }
+      sb_power /= SRSRAN_CHEST_UL_SRS_SB_NOF_PRB * SRSRAN_NRE / 2;
+      wb_power += sb_power;
+
+      INFO("B=%d; ue=%d; k0=%d; n_srs=%d; sb=%d; snr_db=%+.1f; expected=%+.1f;",
+           B,
+           i,
+           k0,
+           cfg[i].n_srs,
+           sb,
+           res[i].sb_snr_db[sb],
+           srsran_convert_power_to_dB(sb_power));
+      TESTASSERT(fabsf(res[i].sb_snr_db[sb] - srsran_convert_power_to_dB(sb_power)) < SB_SNR_DB_TOLERANCE(M_sc));
+    }
+    TESTASSERT(fabsf(res[i].snr_db - srsran_convert_power_to_dB(wb_power / res[i].nof_sb)) < WB_SNR_DB_TOLERANCE(M_sc));
+  }
+
+  // Compare the cost per UE against measuring every UE separately
+  srsran_chest_ul_t     chest     = {};
+  srsran_chest_ul_res_t chest_res = {};
+  TESTASSERT(srsran_chest_ul_init(&chest, cell.nof_prb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_ul_set_cell(&chest, cell) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_chest_ul_res_init(&chest_res, cell.nof_prb) == SRSRAN_SUCCESS);
+
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < NOF_REPETITIONS; r++) {
+    for (uint32_t i = 0; i < nof_ue; i++) {
+      srsran_chest_ul_estimate_srs(&chest, &ul_sf, &cfg[i], &dmrs_pusch_cfg, sf_symbols, &chest_res);
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double single_us = (t[0].tv_sec * 1e6 + t[0].tv_usec) / (NOF_REPETITIONS * nof_ue);
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < NOF_REPETITIONS; r++) {
+    srsran_chest_ul_srs_estimate(q, &ul_sf, &dmrs_pusch_cfg, cfg, nof_ue, sf_symbols, res);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double batch_us = (t[0].tv_sec * 1e6 + t[0].tv_usec) / (NOF_REPETITIONS * nof_ue);
+
+  printf("B=%d; M_sc=%d; %d UEs; per UE: single %.2f us; batch %.2f us\n", B, M_sc, nof_ue, single_us, batch_us);
+
+  srsran_chest_ul_free(&chest);
+  srsran_chest_ul_res_free(&chest_res);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_chest_ul_srs_t q          = {};
+  srsran_channel_awgn_t awgn       = {};
+  cf_t*                 sf_symbols = NULL;
+  int                   ret        = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  sf_symbols = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(cell.nof_prb, cell.cp));
+  if (sf_symbols == NULL) {
+    goto clean_exit;
+  }
+  if (srsran_channel_awgn_init(&awgn, 1234) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+  if (srsran_chest_ul_srs_init(&q, cell.nof_prb) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+  if (srsran_chest_ul_srs_set_cell(&q, cell) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  // Widest SRS bandwidth configuration that fits in the cell
+  while (srsran_refsignal_srs_rb_L_cs(bw_cfg, cell.nof_prb) > cell.nof_prb) {
+    bw_cfg++;
+  }
+
+  srand(1234);
+  ret = SRSRAN_SUCCESS;
+  for (uint32_t B = 0; B < 4 && ret == SRSRAN_SUCCESS; B++) {
+    ret = test_srs_B(&q, &awgn, sf_symbols, B);
+  }
+
+clean_exit:
+  srsran_chest_ul_srs_free(&q);
+  srsran_channel_awgn_free(&awgn);
+  if (sf_symbols) {
+    free(sf_symbols);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
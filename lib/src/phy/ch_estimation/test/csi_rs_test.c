@@ -25,6 +25,7 @@
 #include <getopt.h>
 #include <srsran/srsran.h>
 #include <stdlib.h>
+#include <sys/time.h>
 
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 
@@ -133,6 +134,10 @@ static int nzp_test_trs(srsran_channel_awgn_t* awgn, cf_t* grid)
   // Slot configuration
   srsran_slot_cfg_t slot_cfg = {};
 
+  // Measurement tables
+  srsran_csi_rs_nzp_table_t table = {};
+  TESTASSERT(srsran_csi_rs_nzp_table_init(&table) == SRSRAN_SUCCESS);
+
   //  Item 1
   //      NZP-CSI-RS-Resource
   //          nzp-CSI-RS-ResourceId: 1
@@ -300,6 +305,17 @@ static int nzp_test_trs(srsran_channel_awgn_t* awgn, cf_t* grid)
   set.data[set.count++]       = resource4;
   set.trs_info                = true;
 
+  TESTASSERT(srsran_csi_rs_nzp_table_set(&table, &carrier, &set) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_csi_rs_nzp_table_match(&table, &carrier, &set));
+
+  // Any change in the resources requires computing the tables again
+  srsran_csi_rs_nzp_set_t set_changed = set;
+  set_changed.data[3].scrambling_id++;
+  TESTASSERT(!srsran_csi_rs_nzp_table_match(&table, &carrier, &set_changed));
+  set_changed = set;
+  set_changed.data[0].resource_mapping.frequency_domain_alloc[0] ^= true;
+  TESTASSERT(!srsran_csi_rs_nzp_table_match(&table, &carrier, &set_changed));
+
   for (slot_cfg.idx = 0; slot_cfg.idx < resource1.periodicity.period; slot_cfg.idx++) {
     // Put NZP-CSI-RS TRS signals
     int ret = srsran_csi_rs_nzp_put_set(&carrier, &slot_cfg, &set, grid);
@@ -325,8 +341,92 @@ static int nzp_test_trs(srsran_channel_awgn_t* awgn, cf_t* grid)
     } else {
       TESTASSERT(ret == 0);
     }
+
+    // Measure using the tables, it shall match the measurement above
+    srsran_csi_trs_measurements_t measure_table = {};
+    TESTASSERT(srsran_csi_rs_nzp_table_measure_trs(&table, &slot_cfg, grid, &measure_table) == ret);
+    if (ret > 0) {
+      TESTASSERT(fabsf(measure_table.rsrp_dB - measure.rsrp_dB) < 0.01f);
+      TESTASSERT(fabsf(measure_table.epre_dB - measure.epre_dB) < 0.01f);
+      TESTASSERT(fabsf(measure_table.n0_dB - measure.n0_dB) < 0.01f);
+      TESTASSERT(fabsf(measure_table.cfo_hz - measure.cfo_hz) < 1.0f);
+      TESTASSERT(fabsf(measure_table.delay_us - measure.delay_us) < 0.001f);
+      TESTASSERT(measure_table.nof_re == measure.nof_re);
+    }
+  }
+
+  srsran_csi_rs_nzp_table_free(&table);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int nzp_test_table_benchmark(srsran_channel_awgn_t* awgn, cf_t* grid)
+{
+  srsran_slot_cfg_t         slot_cfg = {};
+  srsran_csi_rs_nzp_set_t   set      = {};
+  srsran_csi_rs_nzp_table_t table    = {};
+  TESTASSERT(srsran_csi_rs_nzp_table_init(&table) == SRSRAN_SUCCESS);
+
+  // Fill a set with as many single port resources as possible, all of them transmitted in every slot
+  for (uint32_t i = 0; i < SRSRAN_PHCH_CFG_MAX_NOF_CSI_RS_PER_SET; i++) {
+    srsran_csi_rs_nzp_resource_t* resource = &set.data[set.count++];
+
+    resource->id                                             = i;
+    resource->resource_mapping.row                           = srsran_csi_rs_resource_mapping_row_1;
+    resource->resource_mapping.nof_ports                     = 1;
+    resource->resource_mapping.cdm                           = srsran_csi_rs_cdm_nocdm;
+    resource->resource_mapping.density                       = srsran_csi_rs_resource_mapping_density_three;
+    resource->resource_mapping.first_symbol_idx              = i % SRSRAN_NSYMB_PER_SLOT_NR;
+    resource->resource_mapping.frequency_domain_alloc[i % 4] = true;
+    resource->resource_mapping.freq_band.start_rb            = 0;
+    resource->resource_mapping.freq_band.nof_rb              = carrier.nof_prb;
+    resource->scrambling_id                                  = i;
+    resource->periodicity.period                             = 10;
+    resource->periodicity.offset                             = 0;
   }
 
+  // Put all the resources in a noisy grid
+  TESTASSERT(srsran_csi_rs_nzp_put_set(&carrier, &slot_cfg, &set, grid) == (int)set.count);
+  TESTASSERT(srsran_channel_awgn_set_n0(awgn, -snr_dB) == SRSRAN_SUCCESS);
+  srsran_channel_awgn_run_c(awgn, grid, grid, SRSRAN_SLOT_LEN_RE_NR(carrier.nof_prb));
+
+  const uint32_t                    nof_repetitions = 1000;
+  srsran_csi_channel_measurements_t measure_legacy  = {};
+  srsran_csi_channel_measurements_t measure_table   = {};
+  struct timeval                    t[3];
+
+  // Measure resource by resource
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    TESTASSERT(srsran_csi_rs_nzp_measure_channel(&carrier, &slot_cfg, &set, grid, &measure_legacy) == (int)set.count);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t legacy_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+  // Measure all resources in a single pass using the tables
+  TESTASSERT(srsran_csi_rs_nzp_table_set(&table, &carrier, &set) == SRSRAN_SUCCESS);
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    TESTASSERT(srsran_csi_rs_nzp_table_measure_channel(&table, &slot_cfg, grid, &measure_table) == (int)set.count);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t table_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+  // Both measurements shall report the same resource
+  TESTASSERT(measure_table.cri == measure_legacy.cri);
+  TESTASSERT(fabsf(measure_table.wideband_rsrp_dBm - measure_legacy.wideband_rsrp_dBm) < 0.01f);
+  TESTASSERT(fabsf(measure_table.wideband_epre_dBm - measure_legacy.wideband_epre_dBm) < 0.01f);
+
+  printf("NZP-CSI-RS measurement of %d resources, %d PRB: per resource %.2f us/slot; tables %.2f us/slot\n",
+         set.count,
+         carrier.nof_prb,
+         (double)legacy_us / nof_repetitions,
+         (double)table_us / nof_repetitions);
+
+  srsran_csi_rs_nzp_table_free(&table);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -405,6 +505,10 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  if (nzp_test_table_benchmark(&awgn, grid) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
   ret = SRSRAN_SUCCESS;
 
 clean_exit:
@@ -579,6 +579,38 @@ void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+#ifndef AVOID_GURU
+/* Applies the phase compensation, normalization and CFR to a transformed symbol, and adds its CP */
+static void ofdm_tx_symbol_post(srsran_ofdm_t* q, int slot_in_sf, uint32_t symbol_idx, cf_t* output, int cp_len)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  float    norm      = 1.0f / sqrtf(symbol_sz);
+
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    // Get phase compensation
+    cf_t phase_compensation = q->phase_compensation[slot_in_sf * q->nof_symbols + symbol_idx];
+
+    // Apply normalization
+    if (q->fft_plan.norm) {
+      phase_compensation *= norm;
+    }
+
+    // Apply correction
+    srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
+  } else if (q->fft_plan.norm) {
+    srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
+  }
+
+  // CFR: Process the time-domain signal without the CP
+  if (q->cfg.cfr_tx_cfg.cfr_enable) {
+    srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
+  }
+
+  /* add CP */
+  srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+}
+#endif /* AVOID_GURU */
+
 /* Transforms input OFDM symbols into output samples.
  * Performs the FFT on each symbol and adds CP.
  */
@@ -603,7 +635,6 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
 #else
   uint32_t nof_symbols = q->nof_symbols;
   uint32_t nof_re = q->nof_re;
-  float norm = 1.0f / sqrtf(symbol_sz);
   cf_t* tmp = q->tmp;
 
   bzero(tmp, q->slot_sz);
@@ -621,33 +652,62 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
 
   for (int i = 0; i < nof_symbols; i++) {
     int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+    ofdm_tx_symbol_post(q, slot_in_sf, i, output, cp_len);
+    output += symbol_sz + cp_len;
+  }
+#endif
+}
 
-    if (isnormal(q->cfg.phase_compensation_hz)) {
-      // Get phase compensation
-      cf_t phase_compensation = q->phase_compensation[slot_in_sf * q->nof_symbols + i];
+#ifndef AVOID_GURU
+/* Transforms the symbols of a slot one by one. The output samples of the symbols to reuse are copied from the reuse
+ * buffer. The rest of symbols are assumed to be empty and their output samples, including the CP, are set to zero
+ * without performing their FFT.
+ */
+static void ofdm_tx_slot_sparse(srsran_ofdm_t* q,
+                                int            slot_in_sf,
+                                uint32_t       active_mask,
+                                uint32_t       reuse_mask,
+                                const cf_t*    reuse)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  uint32_t    nof_re    = q->nof_re;
+  uint32_t    dc        = (q->fft_plan.dc) ? 1 : 0;
 
-      // Apply normalization
-      if (q->fft_plan.norm) {
-        phase_compensation *= norm;
-      }
+  cf_t* input  = q->cfg.in_buffer + slot_in_sf * q->nof_re * q->nof_symbols;
+  cf_t* output = q->cfg.out_buffer + slot_in_sf * q->slot_sz;
+  if (reuse != NULL) {
+    reuse += slot_in_sf * q->slot_sz;
+  }
 
-      // Apply correction
-      srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
-    } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
-    }
+  // The slot transform only uses the first symbols of the temporal buffer, the rest is free for the DFT output
+  cf_t* dft_out = q->tmp + q->nof_symbols * symbol_sz;
 
-    // CFR: Process the time-domain signal without the CP
-    if (q->cfg.cfr_tx_cfg.cfr_enable) {
-      srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
+  for (uint32_t i = 0; i < q->nof_symbols; i++) {
+    int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+    if (active_mask & (1U << i)) {
+      // Same subcarrier mapping than the slot transform, the remaining subcarriers are kept to zero
+      cf_t* tmp = q->tmp + i * symbol_sz;
+      srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
+      srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+      srsran_dft_run_c_zerocopy(&q->fft_plan, tmp, dft_out);
+      srsran_vec_cf_copy(&output[cp_len], dft_out, symbol_sz);
+      ofdm_tx_symbol_post(q, slot_in_sf, i, output, cp_len);
+    } else if (reuse_mask & (1U << i)) {
+      srsran_vec_cf_copy(output, reuse, symbol_sz + cp_len);
+    } else {
+      srsran_vec_cf_zero(output, symbol_sz + cp_len);
     }
 
-    /* add CP */
-    srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+    input += nof_re;
     output += symbol_sz + cp_len;
+    if (reuse != NULL) {
+      reuse += symbol_sz + cp_len;
+    }
   }
-#endif
 }
+#endif /* AVOID_GURU */
 
 void ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
@@ -689,6 +749,72 @@ void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
   }
 }
 
+bool srsran_ofdm_tx_sf_can_reuse(const srsran_ofdm_t* q)
+{
+#ifdef AVOID_GURU
+  return false;
+#else
+  return !q->mbsfn_subframe && !q->cfg.cfr_tx_cfg.cfr_enable && !isnormal(q->cfg.freq_shift_f);
+#endif /* AVOID_GURU */
+}
+
+void srsran_ofdm_tx_sf_sparse(srsran_ofdm_t* q, uint32_t active_mask)
+{
+  srsran_ofdm_tx_sf_reuse(q, active_mask, 0, NULL);
+}
+
+void srsran_ofdm_tx_sf_reuse(srsran_ofdm_t* q, uint32_t active_mask, uint32_t reuse_mask, const cf_t* reuse)
+{
+#ifdef AVOID_GURU
+  srsran_ofdm_tx_sf(q);
+#else
+  uint32_t slot_mask = (1U << q->nof_symbols) - 1U;
+  uint32_t sf_mask   = (1U << (SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols)) - 1U;
+
+  // MBSFN subframes, subframes without empty symbols and CFR (which tracks the signal power) use the regular transform
+  if (q->mbsfn_subframe || q->cfg.cfr_tx_cfg.cfr_enable || (active_mask & sf_mask) == sf_mask) {
+    srsran_ofdm_tx_sf(q);
+    return;
+  }
+
+  if (reuse == NULL || !srsran_ofdm_tx_sf_can_reuse(q)) {
+    reuse_mask = 0;
+  }
+  reuse_mask &= ~active_mask;
+
+  for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+    uint32_t slot_active = (active_mask >> (n * q->nof_symbols)) & slot_mask;
+    uint32_t slot_reuse  = (reuse_mask >> (n * q->nof_symbols)) & slot_mask;
+    if (slot_active == slot_mask) {
+      ofdm_tx_slot(q, n);
+    } else {
+      ofdm_tx_slot_sparse(q, n, slot_active, slot_reuse, reuse);
+    }
+  }
+  if (isnormal(q->cfg.freq_shift_f)) {
+    srsran_vec_prod_ccc(q->cfg.out_buffer, q->shift_buffer, q->cfg.out_buffer, q->sf_sz);
+  }
+#endif /* AVOID_GURU */
+}
+
+uint32_t srsran_ofdm_tx_sf_active_symbols(const srsran_ofdm_t* q)
+{
+  uint32_t    active_mask = 0;
+  const cf_t* input       = q->cfg.in_buffer;
+
+  for (uint32_t l = 0; l < SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols; l++) {
+    for (uint32_t k = 0; k < q->nof_re; k++) {
+      if (crealf(input[k]) != 0.0f || cimagf(input[k]) != 0.0f) {
+        active_mask |= 1U << l;
+        break;
+      }
+    }
+    input += q->nof_re;
+  }
+
+  return active_mask;
+}
+
 int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr)
 {
   if (q == NULL || cfr == NULL) {
@@ -138,6 +138,16 @@ void srsran_enb_dl_free(srsran_enb_dl_t* q)
         free(q->sf_symbols[i]);
       }
     }
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+        if (q->base_grid[sf_idx][p]) {
+          free(q->base_grid[sf_idx][p]);
+        }
+        if (q->base_signal[sf_idx][p]) {
+          free(q->base_signal[sf_idx][p]);
+        }
+      }
+    }
     bzero(q, sizeof(srsran_enb_dl_t));
   }
 }
@@ -225,6 +235,30 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
       srsran_pss_generate(q->pss_signal, cell.id % 3);
       srsran_sss_generate(q->sss_signal0, q->sss_signal5, cell.id);
 
+      /* The base grids are generated on their first use for the new cell */
+      for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+        for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+          if (q->base_grid[sf_idx][p]) {
+            free(q->base_grid[sf_idx][p]);
+            q->base_grid[sf_idx][p] = NULL;
+          }
+          if (q->base_signal[sf_idx][p]) {
+            free(q->base_signal[sf_idx][p]);
+            q->base_signal[sf_idx][p] = NULL;
+          }
+          if (p < q->cell.nof_ports) {
+            q->base_grid[sf_idx][p]   = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(q->cell.nof_prb, q->cell.cp));
+            q->base_signal[sf_idx][p] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(q->cell.nof_prb));
+            if (!q->base_grid[sf_idx][p] || !q->base_signal[sf_idx][p]) {
+              ERROR("Error allocating base grid");
+              return SRSRAN_ERROR;
+            }
+          }
+        }
+        q->base_grid_valid[sf_idx]   = false;
+        q->base_signal_valid[sf_idx] = false;
+      }
+
       // Calculate common DCI locations
       for (int32_t cfi = 1; cfi <= 3; cfi++) {
         q->nof_common_locations[SRSRAN_CFI_IDX(cfi)] = srsran_pdcch_common_locations(
@@ -249,6 +283,11 @@ int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr)
   // Copy the cfr config into the eNB
   q->cfr_config = *cfr;
 
+  // The transform of the base grids does not include the CFR
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    q->base_signal_valid[sf_idx] = false;
+  }
+
   // Set the cfr for the ifft's
   if (srsran_ofdm_set_cfr(&q->ifft_mbsfn, &q->cfr_config) < SRSRAN_SUCCESS) {
     ERROR("Error setting the CFR for ifft_mbsfn");
@@ -330,31 +369,91 @@ static void clear_sf(srsran_enb_dl_t* q)
   }
 }
 
-static void put_sync(srsran_enb_dl_t* q)
+static void put_sync(srsran_enb_dl_t* q, cf_t* sf_symbols[SRSRAN_MAX_PORTS])
 {
   uint32_t sf_idx = q->dl_sf.tti % 10;
 
   if (sf_idx == 0 || sf_idx == 5) {
     for (int p = 0; p < q->cell.nof_ports; p++) {
-      srsran_pss_put_slot(q->pss_signal, q->sf_symbols[p], q->cell.nof_prb, q->cell.cp);
-      srsran_sss_put_slot(sf_idx ? q->sss_signal5 : q->sss_signal0, q->sf_symbols[p], q->cell.nof_prb, q->cell.cp);
+      srsran_pss_put_slot(q->pss_signal, sf_symbols[p], q->cell.nof_prb, q->cell.cp);
+      srsran_sss_put_slot(sf_idx ? q->sss_signal5 : q->sss_signal0, sf_symbols[p], q->cell.nof_prb, q->cell.cp);
     }
   }
 }
 
-static void put_refs(srsran_enb_dl_t* q)
+static void put_refs(srsran_enb_dl_t* q, cf_t* sf_symbols[SRSRAN_MAX_PORTS])
 {
   uint32_t sf_idx = q->dl_sf.tti % 10;
   if (q->dl_sf.sf_type == SRSRAN_SF_MBSFN) {
     srsran_refsignal_mbsfn_put_sf(
-        q->cell, 0, q->csr_signal.pilots[0][sf_idx], q->mbsfnr_signal.pilots[0][sf_idx], q->sf_symbols[0]);
+        q->cell, 0, q->csr_signal.pilots[0][sf_idx], q->mbsfnr_signal.pilots[0][sf_idx], sf_symbols[0]);
   } else {
     for (int p = 0; p < q->cell.nof_ports; p++) {
-      srsran_refsignal_cs_put_sf(&q->csr_signal, &q->dl_sf, (uint32_t)p, q->sf_symbols[p]);
+      srsran_refsignal_cs_put_sf(&q->csr_signal, &q->dl_sf, (uint32_t)p, sf_symbols[p]);
     }
   }
 }
 
+static bool symbol_is_empty(const cf_t* symbol, uint32_t nof_re)
+{
+  for (uint32_t k = 0; k < nof_re; k++) {
+    if (crealf(symbol[k]) != 0.0f || cimagf(symbol[k]) != 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool tdd_config_equal(const srsran_tdd_config_t* a, const srsran_tdd_config_t* b)
+{
+  return a->configured == b->configured && a->sf_config == b->sf_config && a->ss_config == b->ss_config;
+}
+
+/* Copies the base grid of the subframe index, it is generated first if it is not available for the TDD configuration
+ * of the subframe. The copy replaces clearing the grid and placing the CRS and synchronization signals.
+ */
+static void put_base_grid(srsran_enb_dl_t* q)
+{
+  uint32_t sf_idx      = q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+  uint32_t nof_re      = SRSRAN_NRE * q->cell.nof_prb;
+  uint32_t nof_symbols = SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp);
+
+  if (!q->base_grid_valid[sf_idx] || !tdd_config_equal(&q->base_grid_tdd[sf_idx], &q->dl_sf.tdd_config)) {
+    for (int p = 0; p < q->cell.nof_ports; p++) {
+      srsran_vec_cf_zero(q->base_grid[sf_idx][p], CURRENT_SFLEN_RE);
+    }
+    put_sync(q, q->base_grid[sf_idx]);
+    put_refs(q, q->base_grid[sf_idx]);
+    for (int p = 0; p < q->cell.nof_ports; p++) {
+      q->base_symbols[sf_idx][p] = 0;
+      for (uint32_t l = 0; l < nof_symbols; l++) {
+        if (!symbol_is_empty(&q->base_grid[sf_idx][p][l * nof_re], nof_re)) {
+          q->base_symbols[sf_idx][p] |= 1U << l;
+        }
+      }
+    }
+    q->base_grid_tdd[sf_idx]     = q->dl_sf.tdd_config;
+    q->base_grid_valid[sf_idx]   = true;
+    q->base_signal_valid[sf_idx] = false;
+  }
+
+  // Transform the base grid with the same normalization than srsran_enb_dl_gen_signal(). The grid is about to be
+  // overwritten, so it is used as the transform input
+  if (!q->base_signal_valid[sf_idx] && srsran_ofdm_tx_sf_can_reuse(&q->ifft[0])) {
+    float norm_factor = enb_dl_get_norm_factor(q->cell.nof_prb);
+    for (int p = 0; p < q->cell.nof_ports; p++) {
+      srsran_vec_sc_prod_cfc(q->base_grid[sf_idx][p], norm_factor, q->sf_symbols[p], CURRENT_SFLEN_RE);
+      srsran_ofdm_tx_sf_sparse(&q->ifft[p], q->base_symbols[sf_idx][p]);
+      srsran_vec_cf_copy(q->base_signal[sf_idx][p], q->ifft[p].cfg.out_buffer, SRSRAN_SF_LEN_PRB(q->cell.nof_prb));
+    }
+    q->base_signal_valid[sf_idx] = true;
+  }
+
+  for (int p = 0; p < q->cell.nof_ports; p++) {
+    srsran_vec_cf_copy(q->sf_symbols[p], q->base_grid[sf_idx][p], CURRENT_SFLEN_RE);
+  }
+}
+
 static void put_mib(srsran_enb_dl_t* q)
 {
   uint8_t bch_payload[SRSRAN_BCH_PAYLOAD_LEN];
@@ -377,9 +476,13 @@ void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf)
 {
   srsran_ofdm_set_non_mbsfn_region(&q->ifft_mbsfn, dl_sf->non_mbsfn_region);
   q->dl_sf = *dl_sf;
-  clear_sf(q);
-  put_sync(q);
-  put_refs(q);
+  if (q->dl_sf.sf_type == SRSRAN_SF_MBSFN) {
+    clear_sf(q);
+    put_sync(q, q->sf_symbols);
+    put_refs(q, q->sf_symbols);
+  } else {
+    put_base_grid(q);
+  }
   put_mib(q);
   put_pcfich(q);
 }
@@ -455,12 +558,33 @@ void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
                            SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
     srsran_ofdm_tx_sf(&q->ifft_mbsfn);
   } else {
+    uint32_t sf_idx      = q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+    uint32_t nof_re      = SRSRAN_NRE * q->cell.nof_prb;
+    uint32_t nof_symbols = SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp);
     for (int i = 0; i < q->cell.nof_ports; i++) {
-      srsran_vec_sc_prod_cfc(q->ifft[i].cfg.in_buffer,
-                             norm_factor,
-                             q->ifft[i].cfg.in_buffer,
-                             SRSRAN_NOF_SLOTS_PER_SF * q->cell.nof_prb * SRSRAN_NRE * SRSRAN_CP_NSYMB(q->cell.cp));
-      srsran_ofdm_tx_sf(&q->ifft[i]);
+      cf_t* base_grid = q->base_grid[sf_idx][i];
+
+      // Only the symbols with any resource element in use are normalized and transformed, unless they only carry the
+      // base grid, in which case they reuse its transform
+      uint32_t active_mask = q->base_symbols[sf_idx][i] | srsran_ofdm_tx_sf_active_symbols(&q->ifft[i]);
+      uint32_t reuse_mask  = 0;
+      if (q->base_signal_valid[sf_idx] && srsran_ofdm_tx_sf_can_reuse(&q->ifft[i])) {
+        for (uint32_t l = 0; l < nof_symbols; l++) {
+          if ((q->base_symbols[sf_idx][i] & (1U << l)) &&
+              memcmp(&q->ifft[i].cfg.in_buffer[l * nof_re], &base_grid[l * nof_re], nof_re * sizeof(cf_t)) == 0) {
+            reuse_mask |= 1U << l;
+          }
+        }
+      }
+      active_mask &= ~reuse_mask;
+
+      for (uint32_t l = 0; l < nof_symbols; l++) {
+        if (active_mask & (1U << l)) {
+          cf_t* symbol = &q->ifft[i].cfg.in_buffer[l * nof_re];
+          srsran_vec_sc_prod_cfc(symbol, norm_factor, symbol, nof_re);
+        }
+      }
+      srsran_ofdm_tx_sf_reuse(&q->ifft[i], active_mask, reuse_mask, q->base_signal[sf_idx][i]);
     }
   }
 }
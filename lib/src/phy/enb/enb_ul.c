@@ -63,6 +63,11 @@ int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb)
       goto clean_exit;
     }
 
+    if (srsran_chest_ul_srs_init(&q->chest_srs, max_prb)) {
+      ERROR("Error initiating SRS receiver");
+      goto clean_exit;
+    }
+
     ret = SRSRAN_SUCCESS;
 
   } else {
@@ -83,6 +88,7 @@ void srsran_enb_ul_free(srsran_enb_ul_t* q)
     srsran_pucch_free(&q->pucch);
     srsran_pusch_free(&q->pusch);
     srsran_chest_ul_free(&q->chest);
+    srsran_chest_ul_srs_free(&q->chest_srs);
 
     if (q->sf_symbols) {
       free(q->sf_symbols);
@@ -137,6 +143,11 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
         return SRSRAN_ERROR;
       }
 
+      if (srsran_chest_ul_srs_set_cell(&q->chest_srs, cell)) {
+        ERROR("Error initiating SRS receiver");
+        return SRSRAN_ERROR;
+      }
+
       // SRS is a dedicated configuration
       srsran_chest_ul_pregen(&q->chest, pusch_cfg, srs_cfg);
 
@@ -281,3 +292,13 @@ int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
 
   return srsran_pusch_decode(&q->pusch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
 }
+
+int srsran_enb_ul_get_srs(srsran_enb_ul_t*                   q,
+                          srsran_ul_sf_cfg_t*                ul_sf,
+                          srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg,
+                          srsran_refsignal_srs_cfg_t*        cfg,
+                          uint32_t                           nof_ue,
+                          srsran_chest_ul_srs_res_t*         res)
+{
+  return srsran_chest_ul_srs_estimate(&q->chest_srs, ul_sf, pusch_cfg, cfg, nof_ue, q->sf_symbols, res);
+}
@@ -23,7 +23,11 @@
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
-// The following MACRO enables/disables LUT for the decoder
+#ifdef LV_HAVE_SSE
+#include <immintrin.h>
+#endif // LV_HAVE_SSE
+
+// The following MACRO enables/disables LUT for the encoder
 #define USE_LUT 1
 
 // The following type is used for selecting the algorithm precision
@@ -56,20 +60,13 @@ static inline uint8_t encode_M_basis_seq_u16(uint16_t w, uint32_t bit_idx)
 // Encoded unpacked table
 static uint8_t block_unpacked_lut[1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS][SRSRAN_FEC_BLOCK_SIZE];
 
-// LLR signed table
-static block_llr_t block_llr_lut[1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS][SRSRAN_FEC_BLOCK_SIZE];
-
 // Initialization function, as the table is read-only after initialization, it can be initialised from constructor
 __attribute__((constructor)) static void srsran_block_init()
 {
   for (uint32_t word = 0; word < (1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS); word++) {
     for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
-      uint8_t e = encode_M_basis_seq_u16(word, i);
       // Encoded unpacked byte
-      block_unpacked_lut[word][i] = e;
-
-      // Encoded LLR
-      block_llr_lut[word][i] = (block_llr_t)e * 2 - 1;
+      block_unpacked_lut[word][i] = encode_M_basis_seq_u16(word, i);
     }
   }
 }
@@ -110,45 +107,279 @@ void srsran_block_encode(const uint8_t* input, uint32_t input_len, uint8_t* outp
 #endif // USE_LUT
 }
 
-static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data_len)
+/*
+ * Maximum likelihood decoding by fast Walsh-Hadamard transform (FHT)
+ *
+ * The encoded bit i is the parity of the information word w masked by basis[i], so its sign is (-1)^<w, basis[i]>.
+ * Accumulating every LLR in the position given by its basis, f[basis[i]] += llr[i], the correlation of all the
+ * candidate words is the Walsh-Hadamard transform of f with the opposite sign: corr(w) = -F(w). The transform takes
+ * N·log2(N) additions instead of the N·E multiply-accumulates of correlating every word.
+ */
+
+// In-place Walsh-Hadamard transform of 2^nof_bits values
+static void block_fht(int32_t* x, uint32_t nof_bits)
 {
-  int32_t  max_corr = 0; //< Stores maximum correlation
-  uint32_t max_data = 0; //< Stores the word for maximum correlation
+  uint32_t N = 1U << nof_bits;
+  uint32_t h = 1;
 
-  // Limit data to maximum
-  data_len = SRSRAN_MIN(data_len, SRSRAN_FEC_BLOCK_MAX_NOF_BITS);
+#ifdef LV_HAVE_AVX2
+  // The first three stages operate within the 8 lanes of a register
+  if (N >= 8) {
+    for (uint32_t i = 0; i < N; i += 8) {
+      __m256i v = _mm256_loadu_si256((__m256i*)&x[i]);
+      __m256i s = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+      v         = _mm256_blend_epi32(_mm256_add_epi32(v, s), _mm256_sub_epi32(s, v), 0xAA);
+      s         = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+      v         = _mm256_blend_epi32(_mm256_add_epi32(v, s), _mm256_sub_epi32(s, v), 0xCC);
+      s         = _mm256_permute2x128_si256(v, v, 0x01);
+      v         = _mm256_blend_epi32(_mm256_add_epi32(v, s), _mm256_sub_epi32(s, v), 0xF0);
+      _mm256_storeu_si256((__m256i*)&x[i], v);
+    }
+    h = 8;
+  }
+#endif // LV_HAVE_AVX2
 
-  // Brute force all possible sequences
-  uint16_t max_guess = (1U << data_len); //< Maximum guess bit combination (excluded)
-  for (uint16_t guess = 0; guess < max_guess; guess++) {
-    int32_t corr = 0;
-#if USE_LUT
-    // Load sequence from LUT
-    // Dot product
-    for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
-      corr += llr[i] * block_llr_lut[guess][i];
+  for (; h < N; h *= 2) {
+    for (uint32_t i = 0; i < N; i += 2 * h) {
+      uint32_t j = i;
+#ifdef LV_HAVE_AVX512
+      for (; j + 16 <= i + h; j += 16) {
+        __m512i a = _mm512_loadu_si512((__m512i*)&x[j]);
+        __m512i b = _mm512_loadu_si512((__m512i*)&x[j + h]);
+        _mm512_storeu_si512((__m512i*)&x[j], _mm512_add_epi32(a, b));
+        _mm512_storeu_si512((__m512i*)&x[j + h], _mm512_sub_epi32(a, b));
+      }
+#endif // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+      for (; j + 8 <= i + h; j += 8) {
+        __m256i a = _mm256_loadu_si256((__m256i*)&x[j]);
+        __m256i b = _mm256_loadu_si256((__m256i*)&x[j + h]);
+        _mm256_storeu_si256((__m256i*)&x[j], _mm256_add_epi32(a, b));
+        _mm256_storeu_si256((__m256i*)&x[j + h], _mm256_sub_epi32(a, b));
+      }
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_SSE
+      for (; j + 4 <= i + h; j += 4) {
+        __m128i a = _mm_loadu_si128((__m128i*)&x[j]);
+        __m128i b = _mm_loadu_si128((__m128i*)&x[j + h]);
+        _mm_storeu_si128((__m128i*)&x[j], _mm_add_epi32(a, b));
+        _mm_storeu_si128((__m128i*)&x[j + h], _mm_sub_epi32(a, b));
+      }
+#endif // LV_HAVE_SSE
+      for (; j < i + h; j++) {
+        int32_t a = x[j];
+        int32_t b = x[j + h];
+        x[j]      = a + b;
+        x[j + h]  = a - b;
+      }
     }
-#else
-    for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
-      // On-the-fly sequence generation and product
-      corr += llr[i] * (encode_M_basis_seq_u16(guess, i) * 2 - 1);
+  }
+}
+
+// Finds the first word with the minimum transform, i.e. the first word with the maximum correlation
+static uint32_t block_fht_argmin(const int32_t* x, uint32_t N)
+{
+  uint32_t w       = 0;
+  int32_t  min     = x[0];
+  uint32_t min_idx = 0;
+
+#ifdef LV_HAVE_AVX2
+  if (N >= 8) {
+    __m256i min_v  = _mm256_set1_epi32(min);
+    __m256i idx_v  = _mm256_setzero_si256();
+    __m256i word_v = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (; w + 8 <= N; w += 8) {
+      __m256i v = _mm256_loadu_si256((__m256i*)&x[w]);
+
+      // Strict comparison keeps the first word of every lane
+      __m256i lower = _mm256_cmpgt_epi32(min_v, v);
+      min_v         = _mm256_blendv_epi8(min_v, v, lower);
+      idx_v         = _mm256_blendv_epi8(idx_v, word_v, lower);
+      word_v        = _mm256_add_epi32(word_v, _mm256_set1_epi32(8));
     }
-#endif
 
-    // Take decision
-    if (corr > max_corr) {
-      max_corr = corr;
-      max_data = guess;
+    // Reduce lanes, ties are resolved in favour of the first word
+    int32_t  min_lane[8];
+    uint32_t idx_lane[8];
+    _mm256_storeu_si256((__m256i*)min_lane, min_v);
+    _mm256_storeu_si256((__m256i*)idx_lane, idx_v);
+    for (uint32_t j = 0; j < 8; j++) {
+      if (min_lane[j] < min || (min_lane[j] == min && idx_lane[j] < min_idx)) {
+        min     = min_lane[j];
+        min_idx = idx_lane[j];
+      }
+    }
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; w < N; w++) {
+    if (x[w] < min) {
+      min     = x[w];
+      min_idx = w;
+    }
+  }
+
+  return min_idx;
+}
+
+int32_t srsran_block_decode_fht(const int16_t*  llr,
+                                const uint16_t* basis,
+                                uint32_t        nof_llr,
+                                uint32_t        nof_bits,
+                                uint32_t*       word)
+{
+  int32_t x[1U << SRSRAN_FEC_BLOCK_FHT_MAX_NOF_BITS] __attribute__((aligned(64)));
+
+  if (!llr || !basis || !word || nof_bits > SRSRAN_FEC_BLOCK_FHT_MAX_NOF_BITS) {
+    ERROR("Invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t N    = 1U << nof_bits;
+  uint32_t mask = N - 1;
+  SRSRAN_MEM_ZERO(x, int32_t, N);
+  for (uint32_t i = 0; i < nof_llr; i++) {
+    x[basis[i] & mask] += llr[i];
+  }
+
+  block_fht(x, nof_bits);
+
+  *word = block_fht_argmin(x, N);
+  return -x[*word];
+}
+
+#ifdef LV_HAVE_AVX2
+// Codewords decoded in parallel, one in each lane of an AVX2 register
+#define BLOCK_FHT_NOF_LANES 8U
+
+// Decodes up to BLOCK_FHT_NOF_LANES codewords with the same basis, the transform of every codeword is computed in a
+// different lane so that all the stages are plain vector additions and subtractions
+static void block_decode_fht_lanes(const int16_t* const* llr,
+                                   const uint16_t*       basis,
+                                   uint32_t              nof_llr,
+                                   uint32_t              nof_bits,
+                                   int32_t*              corr,
+                                   uint32_t*             word,
+                                   uint32_t              nof_codewords)
+{
+  int32_t  x[1U << SRSRAN_FEC_BLOCK_FHT_MAX_LANES_NOF_BITS][BLOCK_FHT_NOF_LANES] __attribute__((aligned(32)));
+  uint32_t N    = 1U << nof_bits;
+  uint32_t mask = N - 1;
+
+  SRSRAN_MEM_ZERO(&x[0][0], int32_t, N * BLOCK_FHT_NOF_LANES);
+  for (uint32_t cw = 0; cw < nof_codewords; cw++) {
+    for (uint32_t i = 0; i < nof_llr; i++) {
+      x[basis[i] & mask][cw] += llr[cw][i];
     }
   }
 
+  for (uint32_t h = 1; h < N; h *= 2) {
+    for (uint32_t i = 0; i < N; i += 2 * h) {
+      for (uint32_t j = i; j < i + h; j++) {
+        __m256i a = _mm256_load_si256((__m256i*)x[j]);
+        __m256i b = _mm256_load_si256((__m256i*)x[j + h]);
+        _mm256_store_si256((__m256i*)x[j], _mm256_add_epi32(a, b));
+        _mm256_store_si256((__m256i*)x[j + h], _mm256_sub_epi32(a, b));
+      }
+    }
+  }
+
+  __m256i min_v = _mm256_load_si256((__m256i*)x[0]);
+  __m256i idx_v = _mm256_setzero_si256();
+  for (uint32_t w = 1; w < N; w++) {
+    __m256i v     = _mm256_load_si256((__m256i*)x[w]);
+    __m256i lower = _mm256_cmpgt_epi32(min_v, v);
+    min_v         = _mm256_blendv_epi8(min_v, v, lower);
+    idx_v         = _mm256_blendv_epi8(idx_v, _mm256_set1_epi32((int32_t)w), lower);
+  }
+
+  int32_t  min_lane[BLOCK_FHT_NOF_LANES];
+  uint32_t idx_lane[BLOCK_FHT_NOF_LANES];
+  _mm256_storeu_si256((__m256i*)min_lane, min_v);
+  _mm256_storeu_si256((__m256i*)idx_lane, idx_v);
+  for (uint32_t cw = 0; cw < nof_codewords; cw++) {
+    corr[cw] = -min_lane[cw];
+    word[cw] = idx_lane[cw];
+  }
+}
+#endif // LV_HAVE_AVX2
+
+int srsran_block_decode_fht_batch(const int16_t* const* llr,
+                                  const uint16_t*       basis,
+                                  uint32_t              nof_llr,
+                                  uint32_t              nof_bits,
+                                  int32_t*              corr,
+                                  uint32_t*             word,
+                                  uint32_t              nof_codewords)
+{
+  if (!llr || !basis || !corr || !word || nof_bits > SRSRAN_FEC_BLOCK_FHT_MAX_NOF_BITS) {
+    ERROR("Invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t cw = 0;
+#ifdef LV_HAVE_AVX2
+  // Short codes barely fill a register with a single codeword, transform several of them in parallel instead
+  if (nof_bits <= SRSRAN_FEC_BLOCK_FHT_MAX_LANES_NOF_BITS) {
+    for (; cw < nof_codewords; cw += BLOCK_FHT_NOF_LANES) {
+      uint32_t nof_lanes = SRSRAN_MIN(nof_codewords - cw, BLOCK_FHT_NOF_LANES);
+      block_decode_fht_lanes(&llr[cw], basis, nof_llr, nof_bits, &corr[cw], &word[cw], nof_lanes);
+    }
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; cw < nof_codewords; cw++) {
+    corr[cw] = srsran_block_decode_fht(llr[cw], basis, nof_llr, nof_bits, &word[cw]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Basis of the (32, O) code for data_len information bits
+static void block_basis(uint32_t data_len, uint16_t basis[SRSRAN_FEC_BLOCK_SIZE])
+{
+  for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
+    basis[i] = (uint16_t)(M_basis_seq_b[i] & ((1U << data_len) - 1U));
+  }
+}
+
+// Applies the decision rule of the block decoder, the first word with the highest correlation is only selected if the
+// correlation is positive, and unpacks the decoded word
+static int32_t block_decision(int32_t corr, uint32_t word, uint8_t* data, uint32_t data_len)
+{
+  if (corr <= 0) {
+    corr = 0;
+    word = 0;
+  }
+
   // Bit unpack (reversed)
   for (uint32_t i = 0; i < data_len; i++) {
-    data[i] = (uint8_t)((max_data >> i) & 1U);
+    data[i] = (uint8_t)((word >> i) & 1U);
   }
 
-  // Return correlation
-  return max_corr;
+  return corr;
+}
+
+static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data_len)
+{
+  // Limit data to maximum
+  data_len = SRSRAN_MIN(data_len, SRSRAN_FEC_BLOCK_MAX_NOF_BITS);
+
+  uint16_t basis[SRSRAN_FEC_BLOCK_SIZE];
+  block_basis(data_len, basis);
+
+  uint32_t word = 0;
+  int32_t  corr = srsran_block_decode_fht(llr, basis, SRSRAN_FEC_BLOCK_SIZE, data_len, &word);
+
+  return block_decision(corr, word, data, data_len);
+}
+
+static void block_accumulate_i8(const int8_t* llr, uint32_t nof_llr, block_llr_t* llr_)
+{
+  // Accumulate all copies of the 32-length sequence
+  for (uint32_t i = 0; i < nof_llr; i++) {
+    llr_[i % SRSRAN_FEC_BLOCK_SIZE] += (block_llr_t)llr[i];
+  }
 }
 
 int32_t srsran_block_decode_i8(const int8_t* llr, uint32_t nof_llr, uint8_t* data, uint32_t data_len)
@@ -161,10 +392,7 @@ int32_t srsran_block_decode_i8(const int8_t* llr, uint32_t nof_llr, uint8_t* dat
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  // Accumulate all copies of the 32-length sequence
-  for (uint32_t i = 0; i < nof_llr; i++) {
-    llr_[i % SRSRAN_FEC_BLOCK_SIZE] += (block_llr_t)llr[i];
-  }
+  block_accumulate_i8(llr, nof_llr, llr_);
 
   return block_decode(llr_, data, data_len);
 }
@@ -188,3 +416,51 @@ int32_t srsran_block_decode_i16(const int16_t* llr, uint32_t nof_llr, uint8_t* d
 
   return block_decode(llr_, data, data_len);
 }
+
+int srsran_block_decode_i8_batch(const int8_t* const* llr,
+                                 const uint32_t*      nof_llr,
+                                 uint8_t* const*      data,
+                                 uint32_t             data_len,
+                                 int32_t*             corr,
+                                 uint32_t             nof_codewords)
+{
+  // Return invalid inputs if data is not provided
+  if (!llr || !nof_llr || !data || !corr) {
+    ERROR("Invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Limit data to maximum
+  data_len = SRSRAN_MIN(data_len, SRSRAN_FEC_BLOCK_MAX_NOF_BITS);
+
+  uint16_t basis[SRSRAN_FEC_BLOCK_SIZE];
+  block_basis(data_len, basis);
+
+  for (uint32_t cw_offset = 0; cw_offset < nof_codewords; cw_offset += SRSRAN_FEC_BLOCK_MAX_BATCH) {
+    uint32_t       nof_cw = SRSRAN_MIN(nof_codewords - cw_offset, SRSRAN_FEC_BLOCK_MAX_BATCH);
+    block_llr_t    llr_[SRSRAN_FEC_BLOCK_MAX_BATCH][SRSRAN_FEC_BLOCK_SIZE];
+    const int16_t* llr_ptr[SRSRAN_FEC_BLOCK_MAX_BATCH];
+    uint32_t       word[SRSRAN_FEC_BLOCK_MAX_BATCH];
+
+    for (uint32_t cw = 0; cw < nof_cw; cw++) {
+      if (!llr[cw_offset + cw] || !data[cw_offset + cw]) {
+        ERROR("Invalid inputs");
+        return SRSRAN_ERROR_INVALID_INPUTS;
+      }
+      srsran_vec_i16_zero(llr_[cw], SRSRAN_FEC_BLOCK_SIZE);
+      block_accumulate_i8(llr[cw_offset + cw], nof_llr[cw_offset + cw], llr_[cw]);
+      llr_ptr[cw] = llr_[cw];
+    }
+
+    if (srsran_block_decode_fht_batch(
+            llr_ptr, basis, SRSRAN_FEC_BLOCK_SIZE, data_len, &corr[cw_offset], word, nof_cw) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t cw = 0; cw < nof_cw; cw++) {
+      corr[cw_offset + cw] = block_decision(corr[cw_offset + cw], word[cw], data[cw_offset + cw], data_len);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
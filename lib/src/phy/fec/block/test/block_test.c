@@ -130,16 +130,112 @@ int test(uint32_t block_size)
   return SRSRAN_SUCCESS;
 }
 
+// Brute force maximum likelihood decoding without LUT, used as reference of the optimised decoders
+static int32_t reference_decode(const int8_t* llr, uint32_t nof_llr, uint32_t block_size, uint32_t* word)
+{
+  int32_t max_corr = 0;
+  *word            = 0;
+  for (uint32_t guess = 0; guess < (1U << block_size); guess++) {
+    uint8_t bits[SRSRAN_FEC_BLOCK_MAX_NOF_BITS];
+    uint8_t seq[SRSRAN_FEC_BLOCK_SIZE];
+    for (uint32_t i = 0; i < block_size; i++) {
+      bits[i] = (uint8_t)((guess >> i) & 1U);
+    }
+    srsran_block_encode(bits, block_size, seq, SRSRAN_FEC_BLOCK_SIZE);
+
+    int32_t corr = 0;
+    for (uint32_t i = 0; i < nof_llr; i++) {
+      corr += llr[i] * (seq[i % SRSRAN_FEC_BLOCK_SIZE] * 2 - 1);
+    }
+    if (corr > max_corr) {
+      max_corr = corr;
+      *word    = guess;
+    }
+  }
+  return max_corr;
+}
+
+#define NOF_BATCH_CODEWORDS 24
+
+int test_batch(uint32_t block_size)
+{
+  struct timeval t[3]                                                      = {};
+  static int8_t  llr[NOF_BATCH_CODEWORDS][4 * SRSRAN_FEC_BLOCK_SIZE]       = {};
+  uint8_t        rx[NOF_BATCH_CODEWORDS][SRSRAN_FEC_BLOCK_MAX_NOF_BITS]    = {};
+  uint8_t        rx_ref[NOF_BATCH_CODEWORDS][SRSRAN_FEC_BLOCK_MAX_NOF_BITS] = {};
+  int32_t        corr[NOF_BATCH_CODEWORDS]                                 = {};
+  int32_t        corr_ref[NOF_BATCH_CODEWORDS]                             = {};
+  const int8_t*  llr_ptr[NOF_BATCH_CODEWORDS];
+  uint8_t*       rx_ptr[NOF_BATCH_CODEWORDS];
+  uint32_t       nof_llr[NOF_BATCH_CODEWORDS];
+
+  // Generate noise-like LLRs, so that the decision is not trivial and ties are likely
+  for (uint32_t cw = 0; cw < NOF_BATCH_CODEWORDS; cw++) {
+    for (uint32_t i = 0; i < E; i++) {
+      llr[cw][i] = (int8_t)srsran_random_uniform_int_dist(random_gen, -4, 4);
+    }
+    llr_ptr[cw] = llr[cw];
+    rx_ptr[cw]  = rx[cw];
+    nof_llr[cw] = E;
+  }
+
+  // Compare the optimised decoder with the reference
+  for (uint32_t cw = 0; cw < NOF_BATCH_CODEWORDS; cw++) {
+    uint32_t word = 0;
+    int32_t  max  = reference_decode(llr[cw], E, block_size, &word);
+    corr_ref[cw]  = srsran_block_decode_i8(llr[cw], E, rx_ref[cw], block_size);
+    TESTASSERT(corr_ref[cw] == max);
+    for (uint32_t i = 0; i < block_size; i++) {
+      TESTASSERT(rx_ref[cw][i] == ((word >> i) & 1U));
+    }
+  }
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    for (uint32_t cw = 0; cw < NOF_BATCH_CODEWORDS; cw++) {
+      srsran_block_decode_i8(llr[cw], E, rx_ref[cw], block_size);
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_single_us = t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    TESTASSERT(srsran_block_decode_i8_batch(llr_ptr, nof_llr, rx_ptr, block_size, corr, NOF_BATCH_CODEWORDS) ==
+               SRSRAN_SUCCESS);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_batch_us = t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+  // The batch decoder must give the same results as the single codeword decoder
+  TESTASSERT(memcmp(corr, corr_ref, sizeof(corr)) == 0);
+  TESTASSERT(memcmp(rx, rx_ref, sizeof(rx)) == 0);
+
+  INFO("Block size %d batch of %d PASSED! Single: %.1f us; Batch: %.1f us",
+       block_size,
+       NOF_BATCH_CODEWORDS,
+       t_single_us / (double)nof_repetitions,
+       t_batch_us / (double)nof_repetitions);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   parse_args(argc, argv);
   random_gen = srsran_random_init(seed);
 
+  int ret = SRSRAN_SUCCESS;
   for (uint32_t block_size = 3; block_size <= SRSRAN_FEC_BLOCK_MAX_NOF_BITS; block_size++) {
-    if (test(block_size) < SRSRAN_SUCCESS) {
+    if (test(block_size) < SRSRAN_SUCCESS || test_batch(block_size) < SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
       break;
     }
   }
 
   srsran_random_free(random_gen);
+
+  return ret;
 }
@@ -234,9 +234,14 @@ void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q)
   float norm_factor = gnb_dl_get_norm_factor(q->pdsch.carrier.nof_prb);
 
   for (uint32_t i = 0; i < q->nof_tx_antennas; i++) {
-    srsran_ofdm_tx_sf(&q->fft[i]);
+    // Empty symbols are not transformed, an empty slot results in a zero signal that does not need normalization
+    uint32_t active_mask = srsran_ofdm_tx_sf_active_symbols(&q->fft[i]);
+    srsran_ofdm_tx_sf_sparse(&q->fft[i], active_mask);
 
-    srsran_vec_sc_prod_cfc(q->fft[i].cfg.out_buffer, norm_factor, q->fft[i].cfg.out_buffer, (uint32_t)q->fft[i].sf_sz);
+    if (active_mask != 0) {
+      srsran_vec_sc_prod_cfc(
+          q->fft[i].cfg.out_buffer, norm_factor, q->fft[i].cfg.out_buffer, (uint32_t)q->fft[i].sf_sz);
+    }
   }
 }
 
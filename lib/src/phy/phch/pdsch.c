@@ -483,14 +483,11 @@ int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell)
   return ret;
 }
 
-static float apply_power_allocation(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg, cf_t* sf_symbols_m[SRSRAN_MAX_PORTS])
+void srsran_pdsch_apply_rho_b(srsran_pdsch_t* q, const srsran_pdsch_cfg_t* cfg, cf_t* sf_symbols_m[SRSRAN_MAX_PORTS])
 {
   uint32_t nof_symbols_slot = cfg->grant.nof_symb_slot[0];
   uint32_t nof_re_symbol    = SRSRAN_NRE * q->cell.nof_prb;
 
-  /* Set power allocation according to 3GPP 36.213 clause 5.2 Downlink power allocation */
-  float rho_a = srsran_convert_dB_to_amplitude(cfg->p_a) * ((q->cell.nof_ports == 1) ? 1.0f : M_SQRT2);
-
   uint32_t idx0                = (q->cell.nof_ports == 1) ? 0 : 1;
   float    cell_specific_ratio = pdsch_cfg_cell_specific_ratio_table[idx0][cfg->p_b];
   float    rho_b               = sqrtf(cell_specific_ratio);
@@ -517,6 +514,16 @@ static float apply_power_allocation(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg,
       }
     }
   }
+}
+
+static float apply_power_allocation(srsran_pdsch_t* q, srsran_pdsch_cfg_t* cfg, cf_t* sf_symbols_m[SRSRAN_MAX_PORTS])
+{
+  /* Set power allocation according to 3GPP 36.213 clause 5.2 Downlink power allocation */
+  float rho_a = srsran_convert_dB_to_amplitude(cfg->p_a) * ((q->cell.nof_ports == 1) ? 1.0f : M_SQRT2);
+
+  if (!cfg->rho_b_applied) {
+    srsran_pdsch_apply_rho_b(q, cfg, sf_symbols_m);
+  }
   return rho_a;
 }
 
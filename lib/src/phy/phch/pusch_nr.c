@@ -26,6 +26,7 @@
 #include "srsran/phy/phch/csi.h"
 #include "srsran/phy/phch/ra_nr.h"
 #include "srsran/phy/phch/uci_cfg.h"
+#include <string.h>
 
 static int pusch_nr_alloc(srsran_pusch_nr_t* q, uint32_t max_mimo_layers, uint32_t max_prb)
 {
@@ -361,6 +362,35 @@ static int pusch_nr_gen_mux_uci(srsran_pusch_nr_t* q, const srsran_uci_cfg_nr_t*
     return SRSRAN_SUCCESS;
   }
 
+  // if the number of HARQ-ACK information bits to be transmitted on PUSCH is 0, 1 or 2 bits
+  uint32_t G_ack_rvd = 0;
+  if (cfg->ack.count <= 2) {
+    // the number of reserved resource elements for potential HARQ-ACK transmission is calculated according to Clause
+    // 6.3.2.4.2.1, by setting O_ACK = 2 ;
+    G_ack_rvd = srsran_uci_nr_pusch_ack_nof_bits(&cfg->pusch, 2);
+  }
+
+  // The positions only depend on the grant allocation and the number of UCI bits, reuse them if these have not changed
+  srsran_pusch_nr_uci_mux_key_t key;
+  SRSRAN_MEM_ZERO(&key, srsran_pusch_nr_uci_mux_key_t, 1);
+  key.l0        = cfg->pusch.l0;
+  key.l1        = cfg->pusch.l1;
+  key.Qm        = srsran_mod_bits_x_symbol(cfg->pusch.modulation);
+  key.Nl        = cfg->pusch.nof_layers;
+  key.G_ack_rvd = G_ack_rvd;
+  key.G_ack     = q->G_ack;
+  key.G_csi1    = q->G_csi1;
+  key.G_csi2    = q->G_csi2;
+  for (uint32_t l = 0; l < SRSRAN_NSYMB_PER_SLOT_NR; l++) {
+    key.M_pusch_sc[l] = cfg->pusch.M_pusch_sc[l];
+    key.M_uci_sc[l]   = cfg->pusch.M_uci_sc[l];
+  }
+  if (q->uci_mux_valid && memcmp(&key, &q->uci_mux_key, sizeof(srsran_pusch_nr_uci_mux_key_t)) == 0) {
+    q->G_ulsch = q->uci_mux_G_ulsch;
+    q->G_csi1  = q->uci_mux_G_csi1;
+    return SRSRAN_SUCCESS;
+  }
+
   // Bit positions
   uint32_t* pos_ulsch = q->pos_ulsch; // coded bits for UL-SCH
   uint32_t* pos_ack   = q->pos_ack;   // coded bits for HARQ-ACK
@@ -378,16 +408,8 @@ static int pusch_nr_gen_mux_uci(srsran_pusch_nr_t* q, const srsran_uci_cfg_nr_t*
   uint32_t G_csi2 = q->G_csi2;
 
   // Other...
-  uint32_t Nl = cfg->pusch.nof_layers;
-  uint32_t Qm = srsran_mod_bits_x_symbol(cfg->pusch.modulation);
-
-  // if the number of HARQ-ACK information bits to be transmitted on PUSCH is 0, 1 or 2 bits
-  uint32_t G_ack_rvd = 0;
-  if (cfg->ack.count <= 2) {
-    // the number of reserved resource elements for potential HARQ-ACK transmission is calculated according to Clause
-    // 6.3.2.4.2.1, by setting O_ACK = 2 ;
-    G_ack_rvd = srsran_uci_nr_pusch_ack_nof_bits(&cfg->pusch, 2);
-  }
+  uint32_t Nl = key.Nl;
+  uint32_t Qm = key.Qm;
 
   // Counters
   uint32_t m_ack_count   = 0;
@@ -584,6 +606,12 @@ static int pusch_nr_gen_mux_uci(srsran_pusch_nr_t* q, const srsran_uci_cfg_nr_t*
     }
   }
 
+  // Keep the positions for the next transmissions with the same parameters
+  q->uci_mux_key     = key;
+  q->uci_mux_valid   = true;
+  q->uci_mux_G_ulsch = q->G_ulsch;
+  q->uci_mux_G_csi1  = q->G_csi1;
+
   return SRSRAN_SUCCESS;
 }
 
@@ -405,7 +405,7 @@ srsran_mod_t srsran_ra_nr_mod_from_mcs(srsran_mcs_table_t         mcs_table,
   return SRSRAN_MOD_NITEMS;
 }
 
-int srsran_ra_dl_nr_slot_nof_re(const srsran_sch_cfg_nr_t* pdsch_cfg, const srsran_sch_grant_nr_t* grant)
+static int ra_nr_nof_re_prb(const srsran_sch_cfg_nr_t* pdsch_cfg, const srsran_sch_grant_nr_t* grant)
 {
   // the number of symbols of the PDSCH allocation within the slot
   int n_sh_symb = grant->L;
@@ -437,13 +437,24 @@ int srsran_ra_dl_nr_slot_nof_re(const srsran_sch_cfg_nr_t* pdsch_cfg, const srsr
   // Compute total number of n_re used for PDSCH
   uint32_t n_re_prime = SRSRAN_NRE * n_sh_symb - n_prb_dmrs - n_prb_oh;
 
+  // Return the number of resource elements for PDSCH in each PRB
+  return (int)SRSRAN_MIN(SRSRAN_MAX_NRE_NR, n_re_prime);
+}
+
+int srsran_ra_dl_nr_slot_nof_re(const srsran_sch_cfg_nr_t* pdsch_cfg, const srsran_sch_grant_nr_t* grant)
+{
+  int n_re_prb = ra_nr_nof_re_prb(pdsch_cfg, grant);
+  if (n_re_prb < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   uint32_t n_prb = 0;
   for (uint32_t i = 0; i < SRSRAN_MAX_PRB_NR; i++) {
     n_prb += (uint32_t)grant->prb_idx[i];
   }
 
   // Return the number of resource elements for PDSCH
-  return SRSRAN_MIN(SRSRAN_MAX_NRE_NR, n_re_prime) * n_prb;
+  return n_re_prb * (int)n_prb;
 }
 
 #define POW2(N) (1U << (N))
@@ -652,6 +663,168 @@ int srsran_ra_nr_fill_tb(const srsran_sch_cfg_nr_t*   pdsch_cfg,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_ra_nr_tbs_table_init(srsran_ra_nr_tbs_table_t* q, uint32_t max_prb)
+{
+  if (q == NULL || max_prb == 0 || max_prb > SRSRAN_MAX_PRB_NR) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ra_nr_tbs_table_t, 1);
+  q->max_prb = max_prb;
+
+  q->tbs     = SRSRAN_MEM_ALLOC(uint32_t, SRSRAN_RA_NR_MAX_NOF_MCS * max_prb);
+  q->tbs_crc = SRSRAN_MEM_ALLOC(uint32_t, SRSRAN_RA_NR_MAX_NOF_MCS * max_prb);
+  if (q->tbs == NULL || q->tbs_crc == NULL) {
+    ERROR("Error allocating TBS table");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ra_nr_tbs_table_free(srsran_ra_nr_tbs_table_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->tbs != NULL) {
+    free(q->tbs);
+  }
+  if (q->tbs_crc != NULL) {
+    free(q->tbs_crc);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ra_nr_tbs_table_t, 1);
+}
+
+static uint32_t ra_nr_tbs_table_nof_layers(const srsran_sch_grant_nr_t* grant)
+{
+  // Same as srsran_ra_nr_fill_tb, assumes first codeword only
+  uint32_t nof_cw = grant->nof_layers < 5 ? 1 : 2;
+  return grant->nof_layers / nof_cw;
+}
+
+bool srsran_ra_nr_tbs_table_match(const srsran_ra_nr_tbs_table_t* q,
+                                  const srsran_sch_cfg_nr_t*      cfg,
+                                  const srsran_sch_grant_nr_t*    grant)
+{
+  if (q == NULL || cfg == NULL || grant == NULL || !q->configured) {
+    return false;
+  }
+
+  return q->mcs_table == cfg->sch_cfg.mcs_table && q->dci_format == grant->dci_format &&
+         q->search_space_type == grant->dci_search_space && q->rnti_type == grant->rnti_type &&
+         q->nof_layers == ra_nr_tbs_table_nof_layers(grant) && (int)q->nof_re_prb == ra_nr_nof_re_prb(cfg, grant);
+}
+
+int srsran_ra_nr_tbs_table_set(srsran_ra_nr_tbs_table_t*    q,
+                               const srsran_sch_cfg_nr_t*   cfg,
+                               const srsran_sch_grant_nr_t* grant)
+{
+  if (q == NULL || cfg == NULL || grant == NULL || q->tbs == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The table does not support TB scaling
+  if ((SRSRAN_RNTI_ISRAR(grant->rnti) || SRSRAN_RNTI_ISPA(grant->rnti)) &&
+      grant->dci_format == srsran_dci_format_nr_1_0) {
+    return SRSRAN_ERROR;
+  }
+
+  // Skip if the table is up to date
+  if (srsran_ra_nr_tbs_table_match(q, cfg, grant)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  int nof_re_prb = ra_nr_nof_re_prb(cfg, grant);
+  if (nof_re_prb <= 0) {
+    ERROR("Invalid number of RE per PRB (%d)", nof_re_prb);
+    return SRSRAN_ERROR;
+  }
+
+  q->configured        = false;
+  q->mcs_table         = cfg->sch_cfg.mcs_table;
+  q->dci_format        = grant->dci_format;
+  q->search_space_type = grant->dci_search_space;
+  q->rnti_type         = grant->rnti_type;
+  q->nof_re_prb        = (uint32_t)nof_re_prb;
+  q->nof_layers        = ra_nr_tbs_table_nof_layers(grant);
+  q->nof_mcs           = 0;
+
+  for (uint32_t mcs = 0; mcs < SRSRAN_RA_NR_MAX_NOF_MCS; mcs++) {
+    double       R = srsran_ra_nr_R_from_mcs(q->mcs_table, q->dci_format, q->search_space_type, q->rnti_type, mcs);
+    srsran_mod_t m = srsran_ra_nr_mod_from_mcs(q->mcs_table, q->dci_format, q->search_space_type, q->rnti_type, mcs);
+    if (!isnormal(R) || m >= SRSRAN_MOD_NITEMS) {
+      break;
+    }
+    q->R[mcs]  = R;
+    q->Qm[mcs] = srsran_mod_bits_x_symbol(m);
+
+    // Compute the TBS of every number of PRB
+    for (uint32_t nof_prb = 1; nof_prb <= q->max_prb; nof_prb++) {
+      uint32_t N_re   = q->nof_re_prb * nof_prb;
+      uint32_t tbs    = srsran_ra_nr_tbs(N_re, 1.0, R, q->Qm[mcs], q->nof_layers);
+      uint32_t idx    = mcs * q->max_prb + nof_prb - 1;
+      q->tbs[idx]     = tbs;
+      q->tbs_crc[idx] = tbs + ra_nr_nof_crc_bits(tbs, R);
+    }
+    q->nof_mcs++;
+  }
+
+  q->configured = true;
+
+  return SRSRAN_SUCCESS;
+}
+
+uint32_t srsran_ra_nr_tbs_table_get_tbs(const srsran_ra_nr_tbs_table_t* q, uint32_t mcs_idx, uint32_t nof_prb)
+{
+  if (q == NULL || mcs_idx >= q->nof_mcs || nof_prb == 0 || nof_prb > q->max_prb) {
+    return 0;
+  }
+
+  return q->tbs[mcs_idx * q->max_prb + nof_prb - 1];
+}
+
+double srsran_ra_nr_tbs_table_get_R_prime(const srsran_ra_nr_tbs_table_t* q,
+                                          uint32_t                        mcs_idx,
+                                          uint32_t                        nof_prb,
+                                          uint32_t                        nof_re)
+{
+  if (q == NULL || mcs_idx >= q->nof_mcs || nof_prb == 0 || nof_prb > q->max_prb || nof_re == 0) {
+    return NAN;
+  }
+
+  return (double)q->tbs_crc[mcs_idx * q->max_prb + nof_prb - 1] / (double)(nof_re * q->Qm[mcs_idx]);
+}
+
+int srsran_ra_nr_tbs_table_min_prb(const srsran_ra_nr_tbs_table_t* q, uint32_t mcs_idx, uint32_t tbs)
+{
+  if (q == NULL || mcs_idx >= q->nof_mcs) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The TBS is non-decreasing with the number of PRB, find the first one that carries tbs bits
+  const uint32_t* row   = &q->tbs[mcs_idx * q->max_prb];
+  uint32_t        first = 0;
+  uint32_t        count = q->max_prb;
+  while (count > 0) {
+    uint32_t step = count / 2;
+    if (row[first + step] < tbs) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  if (first == q->max_prb) {
+    return SRSRAN_ERROR;
+  }
+
+  return (int)first + 1;
+}
+
 static int ra_dl_dmrs(const srsran_sch_hl_cfg_nr_t* hl_cfg, const srsran_dci_dl_nr_t* dci, srsran_sch_cfg_nr_t* cfg)
 {
   const bool dedicated_dmrs_present =
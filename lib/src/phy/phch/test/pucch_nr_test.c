@@ -34,6 +34,7 @@
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 
 static uint32_t              starting_prb_stride    = 4;
+static uint32_t              nof_batch_uci          = 64;
 static uint32_t              starting_symbol_stride = 4;
 static srsran_random_t       random_gen             = NULL;
 static int                   format                 = -1;
@@ -256,6 +257,104 @@ static int test_pucch_format2(srsran_pucch_nr_t*                  pucch,
   return SRSRAN_SUCCESS;
 }
 
+// Decodes the UCI of many format 2 transmissions, as the gNb does for all the UEs of a slot, one by one and in a batch
+static int test_pucch_format2_batch(srsran_pucch_nr_t* pucch)
+{
+  srsran_pucch_nr_resource_t resource = {};
+  resource.format                     = SRSRAN_PUCCH_NR_FORMAT_2;
+  resource.nof_symbols                = 2;
+  resource.nof_prb                    = 4;
+
+  uint32_t E = (uint32_t)srsran_uci_nr_pucch_format_2_3_4_E(&resource);
+
+  srsran_uci_cfg_nr_t*               uci_cfg      = SRSRAN_MEM_ALLOC(srsran_uci_cfg_nr_t, nof_batch_uci);
+  srsran_uci_value_nr_t*             uci_tx       = SRSRAN_MEM_ALLOC(srsran_uci_value_nr_t, nof_batch_uci);
+  srsran_uci_value_nr_t*             uci_rx       = SRSRAN_MEM_ALLOC(srsran_uci_value_nr_t, nof_batch_uci);
+  srsran_uci_value_nr_t*             uci_rx_ref   = SRSRAN_MEM_ALLOC(srsran_uci_value_nr_t, nof_batch_uci);
+  int8_t*                            llr          = srsran_vec_i8_malloc(nof_batch_uci * E);
+  int8_t*                            llr_ref      = srsran_vec_i8_malloc(nof_batch_uci * E);
+  uint8_t*                           bits         = srsran_vec_u8_malloc(E);
+  const srsran_pucch_nr_resource_t** resource_ptr = SRSRAN_MEM_ALLOC(const srsran_pucch_nr_resource_t*, nof_batch_uci);
+  const srsran_uci_cfg_nr_t**        uci_cfg_ptr  = SRSRAN_MEM_ALLOC(const srsran_uci_cfg_nr_t*, nof_batch_uci);
+  int8_t**                           llr_ptr      = SRSRAN_MEM_ALLOC(int8_t*, nof_batch_uci);
+  srsran_uci_value_nr_t**            uci_rx_ptr   = SRSRAN_MEM_ALLOC(srsran_uci_value_nr_t*, nof_batch_uci);
+  TESTASSERT(uci_cfg != NULL && uci_tx != NULL && uci_rx != NULL && uci_rx_ref != NULL && llr != NULL &&
+             llr_ref != NULL && bits != NULL && resource_ptr != NULL && uci_cfg_ptr != NULL && llr_ptr != NULL && uci_rx_ptr != NULL);
+
+  // Encode UCI of different sizes, mostly in the block code range, and convert them to noisy LLRs
+  for (uint32_t i = 0; i < nof_batch_uci; i++) {
+    SRSRAN_MEM_ZERO(&uci_cfg[i], srsran_uci_cfg_nr_t, 1);
+    SRSRAN_MEM_ZERO(&uci_tx[i], srsran_uci_value_nr_t, 1);
+    uci_cfg[i].ack.count = 2 + i % 11;
+    for (uint32_t j = 0; j < uci_cfg[i].ack.count; j++) {
+      uci_tx[i].ack[j] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    TESTASSERT(srsran_uci_nr_encode_pucch(&pucch->uci, &resource, &uci_cfg[i], &uci_tx[i], bits) == (int)E);
+    for (uint32_t j = 0; j < E; j++) {
+      int32_t noise  = srsran_random_uniform_int_dist(random_gen, -40, 40);
+      llr[i * E + j] = (int8_t)((bits[j] ? 64 : -64) + noise);
+    }
+
+    resource_ptr[i] = &resource;
+    uci_cfg_ptr[i]  = &uci_cfg[i];
+    llr_ptr[i]      = &llr[i * E];
+    uci_rx_ptr[i]   = &uci_rx[i];
+  }
+
+  // The decoder may modify the LLR, keep a copy for the single UCI decoder
+  srsran_vec_i8_copy(llr_ref, llr, nof_batch_uci * E);
+
+  struct timeval t[3] = {};
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_batch_uci; i++) {
+    SRSRAN_MEM_ZERO(&uci_rx_ref[i], srsran_uci_value_nr_t, 1);
+    TESTASSERT(srsran_uci_nr_decode_pucch(&pucch->uci, &resource, &uci_cfg[i], &llr_ref[i * E], &uci_rx_ref[i]) ==
+               SRSRAN_SUCCESS);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_single_us = t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+  for (uint32_t i = 0; i < nof_batch_uci; i++) {
+    SRSRAN_MEM_ZERO(&uci_rx[i], srsran_uci_value_nr_t, 1);
+  }
+  gettimeofday(&t[1], NULL);
+  TESTASSERT(srsran_uci_nr_decode_pucch_batch(
+                 &pucch->uci, resource_ptr, uci_cfg_ptr, llr_ptr, uci_rx_ptr, nof_batch_uci) == SRSRAN_SUCCESS);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_batch_us = t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+  // The batch must decode exactly as the single UCI decoder
+  for (uint32_t i = 0; i < nof_batch_uci; i++) {
+    TESTASSERT(uci_rx[i].valid == uci_rx_ref[i].valid);
+    TESTASSERT(uci_rx[i].valid == true);
+    for (uint32_t j = 0; j < uci_cfg[i].ack.count; j++) {
+      TESTASSERT(uci_rx[i].ack[j] == uci_rx_ref[i].ack[j]);
+      TESTASSERT(uci_rx[i].ack[j] == uci_tx[i].ack[j]);
+    }
+  }
+
+  INFO("Format 2 batch of %d UCI PASSED! Single: %.1f us; Batch: %.1f us",
+       nof_batch_uci,
+       (double)t_single_us,
+       (double)t_batch_us);
+
+  free(uci_cfg);
+  free(uci_tx);
+  free(uci_rx);
+  free(uci_rx_ref);
+  free(llr);
+  free(llr_ref);
+  free(bits);
+  free(resource_ptr);
+  free(uci_cfg_ptr);
+  free(llr_ptr);
+  free(uci_rx_ptr);
+
+  return SRSRAN_SUCCESS;
+}
+
 static void usage(char* prog)
 {
   printf("Usage: %s [csNnv]\n", prog);
@@ -263,6 +362,7 @@ static void usage(char* prog)
   printf("\t-n nof_prb [Default %d]\n", carrier.nof_prb);
   printf("\t-f format [Default %d]\n", format);
   printf("\t-s SNR in dB [Default %.2f]\n", snr_db);
+  printf("\t-b number of UCI decoded in a batch [Default %d]\n", nof_batch_uci);
   printf("\t-v [set verbose to debug, default none]\n");
 }
 
@@ -272,7 +372,7 @@ static void parse_args(int argc, char** argv)
   carrier.nof_prb = 6;
 
   int opt;
-  while ((opt = getopt(argc, argv, "cnfsv")) != -1) {
+  while ((opt = getopt(argc, argv, "cnfsbv")) != -1) {
     switch (opt) {
       case 'c':
         carrier.pci = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -286,6 +386,9 @@ static void parse_args(int argc, char** argv)
       case 's':
         snr_db = strtof(argv[optind], NULL);
         break;
+      case 'b':
+        nof_batch_uci = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -371,6 +474,10 @@ int main(int argc, char** argv)
       ERROR("Failed PUCCH format 2");
       goto clean_exit;
     }
+    if (test_pucch_format2_batch(&pucch) < SRSRAN_SUCCESS) {
+      ERROR("Failed PUCCH format 2 batch");
+      goto clean_exit;
+    }
   }
 
   ret = SRSRAN_SUCCESS;
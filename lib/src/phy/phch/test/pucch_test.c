@@ -84,6 +84,107 @@ void parse_args(int argc, char** argv)
   }
 }
 
+// Brute force correlation with all the CQI words, used as reference of the decoder
+static int32_t cqi_pucch_reference(const int16_t* llr, uint32_t nof_bits, uint32_t* cqi)
+{
+  int32_t max_corr = INT32_MIN;
+  for (uint32_t w = 0; w < (1U << nof_bits); w++) {
+    uint8_t  bits[SRSRAN_UCI_MAX_CQI_LEN_PUCCH];
+    uint8_t  encoded[SRSRAN_UCI_CQI_CODED_PUCCH_B];
+    uint8_t* ptr = bits;
+    srsran_bit_unpack(w, &ptr, nof_bits);
+    srsran_uci_encode_cqi_pucch(bits, nof_bits, encoded);
+
+    int32_t corr = 0;
+    for (uint32_t i = 0; i < SRSRAN_UCI_CQI_CODED_PUCCH_B; i++) {
+      corr += llr[i] * (2 * encoded[i] - 1);
+    }
+    if (corr > max_corr) {
+      max_corr = corr;
+      *cqi     = w;
+    }
+  }
+  return max_corr;
+}
+
+#define NOF_CQI_REPORTS 200
+#define NOF_CQI_REPETITIONS 10
+
+// Decodes the CQI reports of many UEs, as in a busy subframe, one by one and in a batch
+static int test_uci_cqi_pucch_batch(srsran_uci_cqi_pucch_t* q)
+{
+  static int16_t llr[NOF_CQI_REPORTS][SRSRAN_CQI_MAX_BITS];
+  static uint8_t data[NOF_CQI_REPORTS][SRSRAN_UCI_MAX_CQI_LEN_PUCCH];
+  static uint8_t data_batch[NOF_CQI_REPORTS][SRSRAN_UCI_MAX_CQI_LEN_PUCCH];
+  int16_t        corr[NOF_CQI_REPORTS];
+  int16_t        corr_batch[NOF_CQI_REPORTS];
+  uint32_t       nof_bits[NOF_CQI_REPORTS];
+  int16_t*       llr_ptr[NOF_CQI_REPORTS];
+  uint8_t*       data_ptr[NOF_CQI_REPORTS];
+  struct timeval t[3];
+
+  // Noise-like LLRs with typical wideband and subband report lengths
+  srand(1234);
+  for (uint32_t i = 0; i < NOF_CQI_REPORTS; i++) {
+    nof_bits[i] = 4 + i % 8;
+    for (uint32_t j = 0; j < SRSRAN_UCI_CQI_CODED_PUCCH_B; j++) {
+      llr[i][j] = (int16_t)(rand() % 9 - 4);
+    }
+    llr_ptr[i]  = llr[i];
+    data_ptr[i] = data_batch[i];
+  }
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < NOF_CQI_REPETITIONS; r++) {
+    for (uint32_t i = 0; i < NOF_CQI_REPORTS; i++) {
+      corr[i] = srsran_uci_decode_cqi_pucch(q, llr[i], data[i], nof_bits[i]);
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_single_us = t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < NOF_CQI_REPETITIONS; r++) {
+    if (srsran_uci_decode_cqi_pucch_batch(q, llr_ptr, data_ptr, nof_bits, corr_batch, NOF_CQI_REPORTS) <
+        SRSRAN_SUCCESS) {
+      printf("Error decoding CQI batch\n");
+      return SRSRAN_ERROR;
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_batch_us = t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+  for (uint32_t i = 0; i < NOF_CQI_REPORTS; i++) {
+    uint32_t cqi     = 0;
+    int32_t  ref     = cqi_pucch_reference(llr[i], nof_bits[i], &cqi);
+    uint8_t* ptr     = data[i];
+    uint32_t decoded = srsran_bit_pack(&ptr, nof_bits[i]);
+    if (corr[i] != ref || decoded != cqi) {
+      printf("Error! CQI report %d (len: %d) decoded %X (corr=%d) instead of %X (corr=%d)\n",
+             i,
+             nof_bits[i],
+             decoded,
+             corr[i],
+             cqi,
+             ref);
+      return SRSRAN_ERROR;
+    }
+    if (corr_batch[i] != corr[i] || memcmp(data_batch[i], data[i], SRSRAN_UCI_MAX_CQI_LEN_PUCCH) != 0) {
+      printf("Error! CQI report %d (len: %d) batch decoding does not match\n", i, nof_bits[i]);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  printf("Decoded %d CQI reports. Single: %.1f us; Batch: %.1f us;\n",
+         NOF_CQI_REPORTS,
+         t_single_us / (double)NOF_CQI_REPETITIONS,
+         t_batch_us / (double)NOF_CQI_REPETITIONS);
+
+  return SRSRAN_SUCCESS;
+}
+
 int test_uci_cqi_pucch(void)
 {
   int                                   ret                                  = SRSRAN_SUCCESS;
@@ -127,6 +228,10 @@ int test_uci_cqi_pucch(void)
     }
   }
 
+  if (test_uci_cqi_pucch_batch(&uci_cqi_pucch) < SRSRAN_SUCCESS) {
+    ret = SRSRAN_ERROR;
+  }
+
   srsran_uci_cqi_pucch_free(&uci_cqi_pucch);
 
   if (ret) {
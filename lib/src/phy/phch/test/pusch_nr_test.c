@@ -28,13 +28,14 @@
 #include <complex.h>
 #include <getopt.h>
 
-static srsran_carrier_nr_t carrier      = SRSRAN_DEFAULT_CARRIER_NR;
-static uint32_t            n_prb        = 0;  // Set to 0 for steering
-static uint32_t            mcs          = 30; // Set to 30 for steering
-static srsran_sch_cfg_nr_t pusch_cfg    = {};
-static uint16_t            rnti         = 0x1234;
-static uint32_t            nof_ack_bits = 0;
-static uint32_t            nof_csi_bits = 0;
+static srsran_carrier_nr_t carrier         = SRSRAN_DEFAULT_CARRIER_NR;
+static uint32_t            n_prb           = 0;  // Set to 0 for steering
+static uint32_t            mcs             = 30; // Set to 30 for steering
+static srsran_sch_cfg_nr_t pusch_cfg       = {};
+static uint16_t            rnti            = 0x1234;
+static uint32_t            nof_ack_bits    = 0;
+static uint32_t            nof_csi_bits    = 0;
+static uint32_t            nof_repetitions = 10;
 
 void usage(char* prog)
 {
@@ -46,13 +47,14 @@ void usage(char* prog)
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
   printf("\t-A Provide a number of HARQ-ACK bits [Default %d]\n", nof_ack_bits);
   printf("\t-C Provide a number of CSI bits [Default %d]\n", nof_csi_bits);
+  printf("\t-R Number of decoding repetitions for measuring the UCI multiplexing [Default %d]\n", nof_repetitions);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pmTLACv")) != -1) {
+  while ((opt = getopt(argc, argv, "pmTLACRv")) != -1) {
     switch (opt) {
       case 'p':
         n_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -72,6 +74,9 @@ int parse_args(int argc, char** argv)
       case 'C':
         nof_csi_bits = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'R':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -369,6 +374,38 @@ int main(int argc, char** argv)
         }
       }
 
+      // Measure the decoding time regenerating the UCI multiplexing positions and reusing them
+      if (pusch_rx.uci_mux && nof_repetitions > 0) {
+        uint64_t t_decode_us[2] = {};
+        for (uint32_t reuse = 0; reuse < 2; reuse++) {
+          for (uint32_t r = 0; r < nof_repetitions; r++) {
+            srsran_softbuffer_rx_reset(&softbuffer_rx);
+            pusch_rx.uci_mux_valid = pusch_rx.uci_mux_valid && reuse;
+
+            struct timeval t[3] = {};
+            gettimeofday(&t[1], NULL);
+            if (srsran_pusch_nr_decode(&pusch_rx, &pusch_cfg, &pusch_cfg.grant, &chest, sf_symbols, &data_rx) <
+                SRSRAN_SUCCESS) {
+              ERROR("Error decoding");
+              goto clean_exit;
+            }
+            gettimeofday(&t[2], NULL);
+            get_time_interval(t);
+            t_decode_us[reuse] += t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+            if (!data_rx.tb[0].crc || !data_rx.uci.valid) {
+              ERROR("Failed to decode with %s UCI multiplexing positions", reuse ? "reused" : "regenerated");
+              goto clean_exit;
+            }
+          }
+        }
+        printf("n_prb=%d; mcs=%d; UCI multiplexing positions regenerated: %.1f us; reused: %.1f us;\n",
+               n_prb,
+               mcs,
+               t_decode_us[0] / (double)nof_repetitions,
+               t_decode_us[1] / (double)nof_repetitions);
+      }
+
       if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO) {
         char str[512];
         srsran_pusch_nr_rx_info(&pusch_rx, &pusch_cfg, &pusch_cfg.grant, &data_rx, str, (uint32_t)sizeof(str));
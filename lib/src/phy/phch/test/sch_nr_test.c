@@ -25,6 +25,7 @@
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 #include <getopt.h>
+#include <math.h>
 #include <srsran/phy/utils/random.h>
 
 static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
@@ -89,6 +90,8 @@ int main(int argc, char** argv)
   srsran_sch_nr_t sch_nr_rx = {};
   srsran_random_t rand_gen  = srsran_random_init(1234);
 
+  srsran_ra_nr_tbs_table_t tbs_table = {};
+
   uint8_t* data_tx = srsran_vec_u8_malloc(1024 * 1024);
   uint8_t* encoded = srsran_vec_u8_malloc(1024 * 1024 * 8);
   int8_t*  llr     = srsran_vec_i8_malloc(1024 * 1024 * 8);
@@ -145,6 +148,11 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  if (srsran_ra_nr_tbs_table_init(&tbs_table, carrier.nof_prb) < SRSRAN_SUCCESS) {
+    ERROR("Error init TBS table");
+    goto clean_exit;
+  }
+
   // Use grant default A time resources with m=0
   pdsch_cfg.grant.S          = 1;
   pdsch_cfg.grant.L          = 13;
@@ -188,6 +196,18 @@ int main(int argc, char** argv)
           goto clean_exit;
         }
 
+        // The TBS table must give the same TBS and rate as the TBS determination procedure
+        if (srsran_ra_nr_tbs_table_set(&tbs_table, &pdsch_cfg, &pdsch_cfg.grant) < SRSRAN_SUCCESS) {
+          ERROR("Error setting TBS table");
+          goto clean_exit;
+        }
+        if (srsran_ra_nr_tbs_table_get_tbs(&tbs_table, mcs, n_prb) != (uint32_t)tb.tbs ||
+            fabs(srsran_ra_nr_tbs_table_get_R_prime(&tbs_table, mcs, n_prb, tb.nof_re) - tb.R_prime) > 1e-9 ||
+            srsran_ra_nr_tbs_table_min_prb(&tbs_table, mcs, (uint32_t)tb.tbs) > (int)n_prb) {
+          ERROR("TBS table mismatch for n_prb=%d; mcs=%d;", n_prb, mcs);
+          goto clean_exit;
+        }
+
         for (uint32_t i = 0; i < tb.tbs; i++) {
           data_tx[i] = (uint8_t)srsran_random_uniform_int_dist(rand_gen, 0, UINT8_MAX);
         }
@@ -240,6 +260,7 @@ clean_exit:
   srsran_random_free(rand_gen);
   srsran_sch_nr_free(&sch_nr_tx);
   srsran_sch_nr_free(&sch_nr_rx);
+  srsran_ra_nr_tbs_table_free(&tbs_table);
   if (data_tx) {
     free(data_tx);
   }
@@ -58,17 +58,12 @@ void srsran_uci_cqi_pucch_init(srsran_uci_cqi_pucch_t* q)
 
   uint32_t nwords = 1 << SRSRAN_UCI_MAX_CQI_LEN_PUCCH;
   q->cqi_table    = srsran_vec_malloc(nwords * sizeof(int8_t*));
-  q->cqi_table_s  = srsran_vec_malloc(nwords * sizeof(int16_t*));
 
   for (uint32_t w = 0; w < nwords; w++) {
-    q->cqi_table[w]   = srsran_vec_malloc(SRSRAN_UCI_CQI_CODED_PUCCH_B * sizeof(int8_t));
-    q->cqi_table_s[w] = srsran_vec_malloc(SRSRAN_UCI_CQI_CODED_PUCCH_B * sizeof(int16_t));
-    uint8_t* ptr      = word;
+    q->cqi_table[w] = srsran_vec_malloc(SRSRAN_UCI_CQI_CODED_PUCCH_B * sizeof(int8_t));
+    uint8_t* ptr    = word;
     srsran_bit_unpack(w, &ptr, SRSRAN_UCI_MAX_CQI_LEN_PUCCH);
     srsran_uci_encode_cqi_pucch(word, SRSRAN_UCI_MAX_CQI_LEN_PUCCH, q->cqi_table[w]);
-    for (int j = 0; j < SRSRAN_UCI_CQI_CODED_PUCCH_B; j++) {
-      q->cqi_table_s[w][j] = (int16_t)(2 * q->cqi_table[w][j] - 1);
-    }
   }
 }
 
@@ -79,12 +74,8 @@ void srsran_uci_cqi_pucch_free(srsran_uci_cqi_pucch_t* q)
     if (q->cqi_table[w]) {
       free(q->cqi_table[w]);
     }
-    if (q->cqi_table_s[w]) {
-      free(q->cqi_table_s[w]);
-    }
   }
   free(q->cqi_table);
-  free(q->cqi_table_s);
 }
 
 /* Encode UCI CQI/PMI as described in 5.2.3.3 of 36.212
@@ -122,6 +113,26 @@ int srsran_uci_encode_cqi_pucch_from_table(srsran_uci_cqi_pucch_t* q,
   }
 }
 
+/* Basis of the (20, A) code for cqi_len bits, the first CQI bit is the most significant bit of the decoded word so
+ * that words are sorted as in the CQI table
+ */
+static void uci_cqi_pucch_basis(uint32_t cqi_len, uint16_t basis[SRSRAN_UCI_CQI_CODED_PUCCH_B])
+{
+  for (uint32_t i = 0; i < SRSRAN_UCI_CQI_CODED_PUCCH_B; i++) {
+    basis[i] = 0;
+    for (uint32_t n = 0; n < cqi_len; n++) {
+      basis[i] |= (uint16_t)(M_basis_seq_pucch[i][n] << (cqi_len - 1 - n));
+    }
+  }
+}
+
+static void uci_cqi_pucch_unpack(uint32_t word, uint32_t cqi_len, uint8_t* cqi_data)
+{
+  // Convert word to bits again, padding with zeros up to the maximum length as the CQI table words
+  uint8_t* ptr = cqi_data;
+  srsran_bit_unpack(word << (SRSRAN_UCI_MAX_CQI_LEN_PUCCH - cqi_len), &ptr, SRSRAN_UCI_MAX_CQI_LEN_PUCCH);
+}
+
 /* Decode UCI CQI/PMI over PUCCH
  */
 int16_t srsran_uci_decode_cqi_pucch(srsran_uci_cqi_pucch_t* q,
@@ -130,20 +141,13 @@ int16_t srsran_uci_decode_cqi_pucch(srsran_uci_cqi_pucch_t* q,
                                     uint32_t                cqi_len)
 {
   if (q != NULL && cqi_len < SRSRAN_UCI_MAX_CQI_LEN_PUCCH && b_bits != NULL && cqi_data != NULL) {
+    // Maximum likelihood decoding, the correlation with all the words is computed at once with a Hadamard transform
+    uint16_t basis[SRSRAN_UCI_CQI_CODED_PUCCH_B];
+    uci_cqi_pucch_basis(cqi_len, basis);
+
     uint32_t max_w    = 0;
-    int32_t  max_corr = INT32_MIN;
-    uint32_t nwords   = 1 << SRSRAN_UCI_MAX_CQI_LEN_PUCCH;
-    for (uint32_t w = 0; w < nwords; w += 1 << (SRSRAN_UCI_MAX_CQI_LEN_PUCCH - cqi_len)) {
-      // Calculate correlation with pregenerated word and select maximum
-      int32_t corr = srsran_vec_dot_prod_sss(q->cqi_table_s[w], b_bits, SRSRAN_UCI_CQI_CODED_PUCCH_B);
-      if (corr > max_corr) {
-        max_corr = corr;
-        max_w    = w;
-      }
-    }
-    // Convert word to bits again
-    uint8_t* ptr = cqi_data;
-    srsran_bit_unpack(max_w, &ptr, SRSRAN_UCI_MAX_CQI_LEN_PUCCH);
+    int32_t  max_corr = srsran_block_decode_fht(b_bits, basis, SRSRAN_UCI_CQI_CODED_PUCCH_B, cqi_len, &max_w);
+    uci_cqi_pucch_unpack(max_w, cqi_len, cqi_data);
 
     INFO("Decoded CQI: w=%d, corr=%d", max_w, max_corr);
     return max_corr;
@@ -152,6 +156,60 @@ int16_t srsran_uci_decode_cqi_pucch(srsran_uci_cqi_pucch_t* q,
   }
 }
 
+int srsran_uci_decode_cqi_pucch_batch(srsran_uci_cqi_pucch_t* q,
+                                      int16_t* const*         b_bits,
+                                      uint8_t* const*         cqi_data,
+                                      const uint32_t*         cqi_len,
+                                      int16_t*                corr,
+                                      uint32_t                nof_reports)
+{
+  if (q == NULL || b_bits == NULL || cqi_data == NULL || cqi_len == NULL || corr == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < nof_reports; i++) {
+    if (cqi_len[i] >= SRSRAN_UCI_MAX_CQI_LEN_PUCCH || b_bits[i] == NULL || cqi_data[i] == NULL) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  // Decode together the reports with the same number of bits, as they share the code basis
+  for (uint32_t len = 1; len < SRSRAN_UCI_MAX_CQI_LEN_PUCCH; len++) {
+    for (uint32_t offset = 0; offset < nof_reports; offset += SRSRAN_UCI_MAX_CQI_BATCH) {
+      const int16_t* batch_llr[SRSRAN_UCI_MAX_CQI_BATCH];
+      uint32_t       batch_idx[SRSRAN_UCI_MAX_CQI_BATCH];
+      uint32_t       count = 0;
+      for (uint32_t i = offset; i < SRSRAN_MIN(offset + SRSRAN_UCI_MAX_CQI_BATCH, nof_reports); i++) {
+        if (cqi_len[i] == len) {
+          batch_llr[count] = b_bits[i];
+          batch_idx[count] = i;
+          count++;
+        }
+      }
+      if (count == 0) {
+        continue;
+      }
+
+      uint16_t basis[SRSRAN_UCI_CQI_CODED_PUCCH_B];
+      uci_cqi_pucch_basis(len, basis);
+
+      int32_t  batch_corr[SRSRAN_UCI_MAX_CQI_BATCH];
+      uint32_t batch_word[SRSRAN_UCI_MAX_CQI_BATCH];
+      if (srsran_block_decode_fht_batch(
+              batch_llr, basis, SRSRAN_UCI_CQI_CODED_PUCCH_B, len, batch_corr, batch_word, count) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+
+      for (uint32_t j = 0; j < count; j++) {
+        uci_cqi_pucch_unpack(batch_word[j], len, cqi_data[batch_idx[j]]);
+        corr[batch_idx[j]] = (int16_t)batch_corr[j];
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_uci_cqi_init(srsran_uci_cqi_pusch_t* q)
 {
   if (srsran_crc_init(&q->crc, SRSRAN_LTE_CRC8, 8)) {
@@ -979,11 +979,11 @@ int srsran_uci_nr_encode_pucch(srsran_uci_nr_t*                  q,
   return uci_nr_encode(q, uci_cfg, A, o, E_uci);
 }
 
-int srsran_uci_nr_decode_pucch(srsran_uci_nr_t*                  q,
-                               const srsran_pucch_nr_resource_t* pucch_resource_cfg,
-                               const srsran_uci_cfg_nr_t*        uci_cfg,
-                               int8_t*                           llr,
-                               srsran_uci_value_nr_t*            value)
+// Computes the number of encoded bits (E) and the number of information bits (A) of a PUCCH UCI
+static int uci_nr_pucch_E_A(const srsran_pucch_nr_resource_t* pucch_resource_cfg,
+                            const srsran_uci_cfg_nr_t*        uci_cfg,
+                            uint32_t*                         E,
+                            uint32_t*                         A)
 {
   int E_tot = srsran_uci_nr_pucch_format_2_3_4_E(pucch_resource_cfg);
   if (E_tot < SRSRAN_SUCCESS) {
@@ -997,12 +997,29 @@ int srsran_uci_nr_decode_pucch(srsran_uci_nr_t*                  q,
   }
 
   // 6.3.1.1 UCI bit sequence generation
-  int A = uci_nr_A(uci_cfg);
-  if (A < SRSRAN_SUCCESS) {
+  int A_ = uci_nr_A(uci_cfg);
+  if (A_ < SRSRAN_SUCCESS) {
     ERROR("Error getting number of bits");
     return SRSRAN_ERROR;
   }
 
+  *E = (uint32_t)E_uci;
+  *A = (uint32_t)A_;
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_uci_nr_decode_pucch(srsran_uci_nr_t*                  q,
+                               const srsran_pucch_nr_resource_t* pucch_resource_cfg,
+                               const srsran_uci_cfg_nr_t*        uci_cfg,
+                               int8_t*                           llr,
+                               srsran_uci_value_nr_t*            value)
+{
+  uint32_t E_uci = 0;
+  uint32_t A     = 0;
+  if (uci_nr_pucch_E_A(pucch_resource_cfg, uci_cfg, &E_uci, &A) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   if (uci_nr_decode(q, uci_cfg, llr, A, E_uci, &value->valid) < SRSRAN_SUCCESS) {
     ERROR("Error decoding UCI bits");
     return SRSRAN_ERROR;
@@ -1017,6 +1034,86 @@ int srsran_uci_nr_decode_pucch(srsran_uci_nr_t*                  q,
   return SRSRAN_SUCCESS;
 }
 
+int srsran_uci_nr_decode_pucch_batch(srsran_uci_nr_t*                         q,
+                                     const srsran_pucch_nr_resource_t* const* pucch_resource_cfg,
+                                     const srsran_uci_cfg_nr_t* const*        uci_cfg,
+                                     int8_t* const*                           llr,
+                                     srsran_uci_value_nr_t* const*            value,
+                                     uint32_t                                 nof_uci)
+{
+  if (q == NULL || pucch_resource_cfg == NULL || uci_cfg == NULL || llr == NULL || value == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t offset = 0; offset < nof_uci; offset += SRSRAN_FEC_BLOCK_MAX_BATCH) {
+    uint32_t nof = SRSRAN_MIN(nof_uci - offset, SRSRAN_FEC_BLOCK_MAX_BATCH);
+    uint32_t E[SRSRAN_FEC_BLOCK_MAX_BATCH];
+    uint32_t A[SRSRAN_FEC_BLOCK_MAX_BATCH];
+    uint8_t  sequence[SRSRAN_FEC_BLOCK_MAX_BATCH][UCI_NR_MAX_L];
+
+    // Decode individually the UCI that are not block coded, or whose LLR cannot be decoded
+    for (uint32_t i = 0; i < nof; i++) {
+      const srsran_pucch_nr_resource_t* resource = pucch_resource_cfg[offset + i];
+      const srsran_uci_cfg_nr_t*        cfg      = uci_cfg[offset + i];
+      if (resource == NULL || cfg == NULL || llr[offset + i] == NULL || value[offset + i] == NULL) {
+        return SRSRAN_ERROR_INVALID_INPUTS;
+      }
+
+      if (uci_nr_pucch_E_A(resource, cfg, &E[i], &A[i]) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+
+      if (A[i] < 3 || A[i] > UCI_NR_MAX_L || E[i] < 1 || (A[i] == 11 && E[i] <= 16) ||
+          !isnormal(srsran_vec_avg_power_bf(llr[offset + i], E[i]))) {
+        if (srsran_uci_nr_decode_pucch(q, resource, cfg, llr[offset + i], value[offset + i]) < SRSRAN_SUCCESS) {
+          return SRSRAN_ERROR;
+        }
+        A[i] = 0;
+      }
+    }
+
+    // Decode together the block coded UCI with the same number of bits
+    for (uint32_t a = 3; a <= UCI_NR_MAX_L; a++) {
+      const int8_t* batch_llr[SRSRAN_FEC_BLOCK_MAX_BATCH];
+      uint32_t      batch_E[SRSRAN_FEC_BLOCK_MAX_BATCH];
+      uint8_t*      batch_data[SRSRAN_FEC_BLOCK_MAX_BATCH];
+      int32_t       batch_corr[SRSRAN_FEC_BLOCK_MAX_BATCH];
+      uint32_t      batch_idx[SRSRAN_FEC_BLOCK_MAX_BATCH];
+      uint32_t      batch_count = 0;
+      for (uint32_t i = 0; i < nof; i++) {
+        if (A[i] == a) {
+          batch_llr[batch_count]  = llr[offset + i];
+          batch_E[batch_count]    = E[i];
+          batch_data[batch_count] = sequence[i];
+          batch_idx[batch_count]  = i;
+          batch_count++;
+        }
+      }
+      if (batch_count == 0) {
+        continue;
+      }
+
+      if (srsran_block_decode_i8_batch(batch_llr, batch_E, batch_data, a, batch_corr, batch_count) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+
+      for (uint32_t j = 0; j < batch_count; j++) {
+        uint32_t i = batch_idx[j];
+
+        // Take decoded decision with threshold
+        value[offset + i]->valid = ((float)batch_corr[j] > q->block_code_threshold);
+
+        if (uci_nr_unpack_pucch(uci_cfg[offset + i], sequence[i], value[offset + i]) < SRSRAN_SUCCESS) {
+          ERROR("Error unpacking PUCCH UCI bits");
+          return SRSRAN_ERROR;
+        }
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 uint32_t srsran_uci_nr_total_bits(const srsran_uci_cfg_nr_t* uci_cfg)
 {
   if (uci_cfg == NULL) {
@@ -63,14 +63,25 @@ static void* thread_gain_fcn(void* h)
     while (rf->cur_rx_gain == rf->new_rx_gain && rf->thread_gain_run) {
       pthread_cond_wait(&rf->cond, &rf->mutex);
     }
-    if (rf->new_rx_gain != rf->cur_rx_gain) {
-      srsran_rf_set_rx_gain(h, rf->new_rx_gain);
-      rf->cur_rx_gain = srsran_rf_get_rx_gain(h);
-      rf->new_rx_gain = rf->cur_rx_gain;
+    double new_rx_gain = rf->new_rx_gain;
+    pthread_mutex_unlock(&rf->mutex);
+
+    // Talk to the device without holding the mutex, so that the AGC in the Rx path never waits for it
+    if (new_rx_gain == rf->cur_rx_gain) {
+      continue;
     }
+    srsran_rf_set_rx_gain(h, new_rx_gain);
+    double cur_rx_gain = srsran_rf_get_rx_gain(h);
     if (rf->tx_gain_same_rx) {
-      srsran_rf_set_tx_gain(h, rf->cur_rx_gain + rf->tx_rx_gain_offset);
+      srsran_rf_set_tx_gain(h, cur_rx_gain + rf->tx_rx_gain_offset);
+    }
+
+    pthread_mutex_lock(&rf->mutex);
+    // Keep a gain requested in the meantime, it is applied in the next iteration
+    if (rf->new_rx_gain == new_rx_gain) {
+      rf->new_rx_gain = cur_rx_gain;
     }
+    rf->cur_rx_gain = cur_rx_gain;
     pthread_mutex_unlock(&rf->mutex);
   }
   return NULL;
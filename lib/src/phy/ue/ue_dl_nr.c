@@ -117,6 +117,13 @@ int srsran_ue_dl_nr_init(srsran_ue_dl_nr_t* q, cf_t* input[SRSRAN_MAX_PORTS], co
     return SRSRAN_ERROR;
   }
 
+  for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_CSI_RS_TABLES; i++) {
+    if (srsran_csi_rs_nzp_table_init(&q->csi_rs_nzp_tables[i]) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising NZP-CSI-RS tables");
+      return SRSRAN_ERROR;
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -147,6 +154,10 @@ void srsran_ue_dl_nr_free(srsran_ue_dl_nr_t* q)
     free(q->pdcch_ce);
   }
 
+  for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_CSI_RS_TABLES; i++) {
+    srsran_csi_rs_nzp_table_free(&q->csi_rs_nzp_tables[i]);
+  }
+
   SRSRAN_MEM_ZERO(q, srsran_ue_dl_nr_t, 1);
 }
 
@@ -612,7 +623,28 @@ uint32_t srsran_ue_dl_nr_pdsch_info(const srsran_ue_dl_nr_t*    q,
   return len;
 }
 
-int srsran_ue_dl_nr_csi_measure_trs(const srsran_ue_dl_nr_t*       q,
+static srsran_csi_rs_nzp_table_t* ue_dl_nr_get_csi_rs_nzp_table(srsran_ue_dl_nr_t*             q,
+                                                                const srsran_csi_rs_nzp_set_t* csi_rs_nzp_set)
+{
+  // Look for a table that matches the set
+  for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_CSI_RS_TABLES; i++) {
+    if (srsran_csi_rs_nzp_table_match(&q->csi_rs_nzp_tables[i], &q->carrier, csi_rs_nzp_set)) {
+      return &q->csi_rs_nzp_tables[i];
+    }
+  }
+
+  // Otherwise, replace the oldest table
+  srsran_csi_rs_nzp_table_t* table = &q->csi_rs_nzp_tables[q->csi_rs_nzp_table_next];
+  q->csi_rs_nzp_table_next         = (q->csi_rs_nzp_table_next + 1) % SRSRAN_UE_DL_NR_MAX_NOF_CSI_RS_TABLES;
+  if (srsran_csi_rs_nzp_table_set(table, &q->carrier, csi_rs_nzp_set) < SRSRAN_SUCCESS) {
+    ERROR("Error setting NZP-CSI-RS tables");
+    return NULL;
+  }
+
+  return table;
+}
+
+int srsran_ue_dl_nr_csi_measure_trs(srsran_ue_dl_nr_t*             q,
                                     const srsran_slot_cfg_t*       slot_cfg,
                                     const srsran_csi_rs_nzp_set_t* csi_rs_nzp_set,
                                     srsran_csi_trs_measurements_t* measurement)
@@ -621,10 +653,15 @@ int srsran_ue_dl_nr_csi_measure_trs(const srsran_ue_dl_nr_t*       q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  return srsran_csi_rs_nzp_measure_trs(&q->carrier, slot_cfg, csi_rs_nzp_set, q->sf_symbols[0], measurement);
+  srsran_csi_rs_nzp_table_t* table = ue_dl_nr_get_csi_rs_nzp_table(q, csi_rs_nzp_set);
+  if (table == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  return srsran_csi_rs_nzp_table_measure_trs(table, slot_cfg, q->sf_symbols[0], measurement);
 }
 
-int srsran_ue_dl_nr_csi_measure_channel(const srsran_ue_dl_nr_t*           q,
+int srsran_ue_dl_nr_csi_measure_channel(srsran_ue_dl_nr_t*                 q,
                                         const srsran_slot_cfg_t*           slot_cfg,
                                         const srsran_csi_rs_nzp_set_t*     csi_rs_nzp_set,
                                         srsran_csi_channel_measurements_t* measurement)
@@ -633,5 +670,10 @@ int srsran_ue_dl_nr_csi_measure_channel(const srsran_ue_dl_nr_t*           q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  return srsran_csi_rs_nzp_measure_channel(&q->carrier, slot_cfg, csi_rs_nzp_set, q->sf_symbols[0], measurement);
+  srsran_csi_rs_nzp_table_t* table = ue_dl_nr_get_csi_rs_nzp_table(q, csi_rs_nzp_set);
+  if (table == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  return srsran_csi_rs_nzp_table_measure_channel(table, slot_cfg, q->sf_symbols[0], measurement);
 }
@@ -759,6 +759,27 @@ TEST(
 
     free(x);)
 
+TEST(
+    srsran_vec_power_peak_cf, MALLOC(cf_t, x);
+
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    float avg_power  = 0;
+    float peak_power = 0;
+    TEST_CALL(srsran_vec_power_peak_cf(x, block_size, &avg_power, &peak_power);)
+
+        float gold_avg  = 0;
+    float     gold_peak = 0;
+    for (int i = 0; i < block_size; i++) {
+      cf_t  a    = x[i];
+      float abs2 = __real__ a * __real__ a + __imag__ a * __imag__ a;
+      gold_avg += abs2;
+      gold_peak = SRSRAN_MAX(gold_peak, abs2);
+    } gold_avg /= block_size;
+    mse = fabsf(gold_avg - avg_power) / gold_avg + fabsf(gold_peak - peak_power) / gold_peak;
+
+    free(x);)
+
 TEST(
     srsran_vec_apply_cfo, MALLOC(cf_t, x); MALLOC(cf_t, z);
 
@@ -1035,6 +1056,10 @@ int main(int argc, char** argv)
         test_srsran_vec_max_abs_ci(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_power_peak_cf(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_apply_cfo(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
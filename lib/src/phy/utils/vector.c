@@ -596,6 +596,18 @@ float srsran_vec_avg_power_cf(const cf_t* x, const uint32_t len)
   }
 }
 
+void srsran_vec_power_peak_cf(const cf_t* x, const uint32_t len, float* avg_power, float* peak_power)
+{
+  if (!len) {
+    *avg_power  = 0;
+    *peak_power = 0;
+    return;
+  }
+  float sum_power = 0;
+  srsran_vec_power_peak_cf_simd(x, len, &sum_power, peak_power);
+  *avg_power = sum_power / len;
+}
+
 float srsran_vec_avg_power_sf(const int16_t* x, const uint32_t len)
 {
   // Accumulator
@@ -1585,6 +1585,72 @@ uint32_t srsran_vec_max_ci_simd(const cf_t* x, const int len)
   return max_index;
 }
 
+void srsran_vec_power_peak_cf_simd(const cf_t* x, const int len, float* sum_power, float* max_power)
+{
+  int i = 0;
+
+  float sum_value = 0.0f;
+  float max_value = 0.0f;
+
+#if SRSRAN_SIMD_F_SIZE
+  srsran_simd_aligned float sum_buffer[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_aligned float max_buffer[SRSRAN_SIMD_F_SIZE];
+
+  simd_f_t simd_sum_values = srsran_simd_f_zero();
+  simd_f_t simd_max_values = srsran_simd_f_zero();
+
+  if (SRSRAN_IS_ALIGNED(x)) {
+    for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+      simd_f_t x1 = srsran_simd_f_load((float*)&x[i]);
+      simd_f_t x2 = srsran_simd_f_load((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+
+      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
+      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
+
+      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
+
+      simd_sum_values = srsran_simd_f_add(simd_sum_values, z1);
+      simd_max_values = srsran_simd_f_select(simd_max_values, z1, srsran_simd_f_max(z1, simd_max_values));
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+      simd_f_t x1 = srsran_simd_f_loadu((float*)&x[i]);
+      simd_f_t x2 = srsran_simd_f_loadu((float*)&x[i + SRSRAN_SIMD_F_SIZE / 2]);
+
+      simd_f_t mul1 = srsran_simd_f_mul(x1, x1);
+      simd_f_t mul2 = srsran_simd_f_mul(x2, x2);
+
+      simd_f_t z1 = srsran_simd_f_hadd(mul1, mul2);
+
+      simd_sum_values = srsran_simd_f_add(simd_sum_values, z1);
+      simd_max_values = srsran_simd_f_select(simd_max_values, z1, srsran_simd_f_max(z1, simd_max_values));
+    }
+  }
+
+  srsran_simd_f_store(sum_buffer, simd_sum_values);
+  srsran_simd_f_store(max_buffer, simd_max_values);
+
+  for (int k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+    sum_value += sum_buffer[k];
+    if (max_buffer[k] > max_value) {
+      max_value = max_buffer[k];
+    }
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  for (; i < len; i++) {
+    cf_t  a    = x[i];
+    float abs2 = __real__ a * __real__ a + __imag__ a * __imag__ a;
+    sum_value += abs2;
+    if (abs2 > max_value) {
+      max_value = abs2;
+    }
+  }
+
+  *sum_power = sum_value;
+  *max_power = max_value;
+}
+
 void srsran_vec_interleave_simd(const cf_t* x, const cf_t* y, cf_t* z, const int len)
 {
   uint32_t i = 0, k = 0;
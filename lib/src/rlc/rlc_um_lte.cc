@@ -272,10 +272,11 @@ bool rlc_um_lte::rlc_um_lte_rx::configure(const rlc_config_t& cnfg_, std::string
 
 void rlc_um_lte::rlc_um_lte_rx::reestablish()
 {
+  std::lock_guard<std::mutex> lock(mutex);
   // try to reassemble any SDUs if possible
   if (reordering_timer.is_valid() && reordering_timer.is_running()) {
     reordering_timer.stop();
-    timer_expired(reordering_timer.id());
+    handle_reordering_timeout();
   }
 
   reset();
@@ -283,6 +284,7 @@ void rlc_um_lte::rlc_um_lte_rx::reestablish()
 
 void rlc_um_lte::rlc_um_lte_rx::stop()
 {
+  std::lock_guard<std::mutex> lock(mutex);
   reset();
 
   reordering_timer.stop();
@@ -303,6 +305,7 @@ void rlc_um_lte::rlc_um_lte_rx::reset()
 
 void rlc_um_lte::rlc_um_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
+  std::lock_guard<std::mutex> lock(mutex);
   rlc_umd_pdu_header_t header;
   rlc_um_read_data_pdu_header(payload, nof_bytes, cfg.um.rx_sn_field_length, &header);
   RlcHexInfo(payload, nof_bytes, "Rx data PDU SN=%d (%d B)", header.sn, nof_bytes);
@@ -669,31 +672,38 @@ bool rlc_um_lte::rlc_um_lte_rx::inside_reordering_window(uint16_t sn)
 
 void rlc_um_lte::rlc_um_lte_rx::timer_expired(uint32_t timeout_id)
 {
+  std::lock_guard<std::mutex> lock(mutex);
   if (reordering_timer.id() == timeout_id) {
-    // 36.322 v10 Section 5.1.2.2.4
-    RlcInfo("%s reordering timeout expiry - updating vr_ur and reassembling", rb_name.c_str());
+    handle_reordering_timeout();
+  }
+}
 
-    RlcWarning("Lost PDU SN=%d", vr_ur);
+// No locking required as only called from within reestablish and timer_expired which lock
+void rlc_um_lte::rlc_um_lte_rx::handle_reordering_timeout()
+{
+  // 36.322 v10 Section 5.1.2.2.4
+  RlcInfo("%s reordering timeout expiry - updating vr_ur and reassembling", rb_name.c_str());
 
-    pdu_lost = true;
-    if (rx_sdu != NULL) {
-      rx_sdu->clear();
-    }
+  RlcWarning("Lost PDU SN=%d", vr_ur);
 
-    while (RX_MOD_BASE(vr_ur) < RX_MOD_BASE(vr_ux)) {
-      vr_ur = (vr_ur + 1) % cfg.um.rx_mod;
-      RlcDebug("Entering Reassemble from timeout id=%d", timeout_id);
-      reassemble_rx_sdus();
-      RlcDebug("Finished reassemble from timeout id=%d", timeout_id);
-    }
+  pdu_lost = true;
+  if (rx_sdu != NULL) {
+    rx_sdu->clear();
+  }
 
-    if (RX_MOD_BASE(vr_uh) > RX_MOD_BASE(vr_ur)) {
-      reordering_timer.run();
-      vr_ux = vr_uh;
-    }
+  while (RX_MOD_BASE(vr_ur) < RX_MOD_BASE(vr_ux)) {
+    vr_ur = (vr_ur + 1) % cfg.um.rx_mod;
+    RlcDebug("Entering Reassemble from timeout");
+    reassemble_rx_sdus();
+    RlcDebug("Finished reassemble from timeout");
+  }
 
-    debug_state();
+  if (RX_MOD_BASE(vr_uh) > RX_MOD_BASE(vr_ur)) {
+    reordering_timer.run();
+    vr_ux = vr_uh;
   }
+
+  debug_state();
 }
 
 /****************************************************************************
@@ -21,6 +21,8 @@
 
 #include "srsran/adt/bounded_bitset.h"
 #include "srsran/common/test_common.h"
+#include <chrono>
+#include <random>
 
 void test_bit_operations()
 {
@@ -276,6 +278,169 @@ void test_bitset_find()
     TESTASSERT(bitset.find_lowest(0, bitset.size()) == 0);
     TESTASSERT(bitset.find_lowest(5, bitset.size()) == 5);
   }
+  {
+    srsran::bounded_bitset<100, reversed> bitset(95);
+
+    // 0b0...0
+    TESTASSERT(bitset.find_highest(0, bitset.size()) == -1);
+    TESTASSERT(bitset.find_highest(0, bitset.size(), false) == 94);
+
+    // 0b0...010...01000, with the range starting beyond the first word index
+    bitset.set(3);
+    bitset.set(10);
+    TESTASSERT(bitset.find_highest(2, bitset.size()) == 10);
+    TESTASSERT(bitset.find_highest(5, bitset.size()) == 10);
+    TESTASSERT(bitset.find_highest(11, bitset.size()) == -1);
+    TESTASSERT(bitset.find_highest(0, 10) == 3);
+    TESTASSERT(bitset.find_highest(4, 10) == -1);
+
+    // 0b1...010...01000
+    bitset.set(94);
+    TESTASSERT(bitset.find_highest(5, bitset.size()) == 94);
+    TESTASSERT(bitset.find_highest(5, 94) == 10);
+    TESTASSERT(bitset.find_highest(5, bitset.size(), false) == 93);
+  }
+}
+
+/// Bit-by-bit reference implementation of the range operations
+template <size_t N, bool reversed>
+struct naive_bitset_ops {
+  using bitset_t = srsran::bounded_bitset<N, reversed>;
+
+  static size_t count(const bitset_t& b, size_t start, size_t stop)
+  {
+    size_t ret = 0;
+    for (size_t i = start; i < stop; ++i) {
+      ret += b.test(i) ? 1 : 0;
+    }
+    return ret;
+  }
+
+  static int find_lowest_run(const bitset_t& b, size_t start, size_t stop, size_t length, bool value)
+  {
+    size_t run = 0;
+    for (size_t i = start; i < stop; ++i) {
+      run = (b.test(i) == value) ? run + 1 : 0;
+      if (run >= length) {
+        return static_cast<int>(i + 1 - length);
+      }
+    }
+    return -1;
+  }
+
+  static int find_highest(const bitset_t& b, size_t start, size_t stop, bool value)
+  {
+    for (size_t i = stop; i > start; --i) {
+      if (b.test(i - 1) == value) {
+        return static_cast<int>(i - 1);
+      }
+    }
+    return -1;
+  }
+};
+
+template <size_t N, bool reversed>
+void test_bitset_range_operations()
+{
+  using naive = naive_bitset_ops<N, reversed>;
+
+  std::mt19937 rgen(N + reversed);
+  for (size_t trial = 0; trial < 2000; ++trial) {
+    srsran::bounded_bitset<N, reversed> bitset(std::uniform_int_distribution<size_t>{1, N}(rgen));
+    // Mix dense and sparse bitsets, so that both long and short runs show up
+    std::bernoulli_distribution bit_dist(trial % 2 == 0 ? 0.2 : 0.8);
+    for (size_t i = 0; i < bitset.size(); ++i) {
+      bitset.set(i, bit_dist(rgen));
+    }
+    size_t start = std::uniform_int_distribution<size_t>{0, bitset.size()}(rgen);
+    size_t stop  = std::uniform_int_distribution<size_t>{start, bitset.size()}(rgen);
+
+    TESTASSERT(bitset.count(start, stop) == naive::count(bitset, start, stop));
+    TESTASSERT(bitset.count(0, bitset.size()) == bitset.count());
+    TESTASSERT(bitset.any(start, stop) == (naive::count(bitset, start, stop) > 0));
+    TESTASSERT(bitset.find_highest(start, stop, true) == naive::find_highest(bitset, start, stop, true));
+    TESTASSERT(bitset.find_highest(start, stop, false) == naive::find_highest(bitset, start, stop, false));
+    for (size_t length = 1; length <= 8; ++length) {
+      TESTASSERT(bitset.find_lowest_run(start, stop, length, true) ==
+                 naive::find_lowest_run(bitset, start, stop, length, true));
+      TESTASSERT(bitset.find_lowest_run(start, stop, length, false) ==
+                 naive::find_lowest_run(bitset, start, stop, length, false));
+    }
+
+    srsran::bounded_bitset<N, reversed> filled(bitset);
+    filled.fill(start, stop, trial % 3 != 0);
+    for (size_t i = 0; i < bitset.size(); ++i) {
+      TESTASSERT(filled.test(i) == ((i >= start and i < stop) ? trial % 3 != 0 : bitset.test(i)));
+    }
+  }
+
+  // Runs crossing word boundaries
+  srsran::bounded_bitset<N, reversed> bitset(N);
+  bitset.fill(0, N);
+  TESTASSERT(bitset.find_lowest_run(0, N, 1, false) == -1);
+  bitset.fill(N / 2 - 10, N / 2 + 10, false);
+  TESTASSERT(bitset.count(0, N) == N - 20);
+  TESTASSERT(bitset.find_lowest_run(0, N, 20, false) == (int)N / 2 - 10);
+  TESTASSERT(bitset.find_lowest_run(0, N, 21, false) == -1);
+  TESTASSERT(bitset.find_lowest_run(N / 2, N, 5, false) == (int)N / 2);
+  TESTASSERT(bitset.find_lowest_run(0, N, 0, false) == 0);
+  TESTASSERT(not bitset.any(N / 2 - 10, N / 2 + 10));
+  TESTASSERT(bitset.any(N / 2 - 10, N / 2 + 11));
+}
+
+template <size_t N, bool reversed>
+void bitset_benchmark()
+{
+  using std::chrono::high_resolution_clock;
+  using std::chrono::nanoseconds;
+  using naive                  = naive_bitset_ops<N, reversed>;
+  const size_t nof_bitsets     = 64;
+  const size_t nof_repetitions = 2000;
+
+  // Random PRB occupancy of a loaded cell, with ~80% of PRBs in use, in allocations of 1 to 8 PRBs
+  std::mt19937                                     rgen(0);
+  std::vector<srsran::bounded_bitset<N, reversed> > bitsets(nof_bitsets, srsran::bounded_bitset<N, reversed>(N));
+  for (auto& b : bitsets) {
+    while (b.count() < N * 8 / 10) {
+      size_t start = std::uniform_int_distribution<size_t>{0, N - 1}(rgen);
+      b.fill(start, std::min(N, start + std::uniform_int_distribution<size_t>{1, 8}(rgen)));
+    }
+  }
+
+  auto run = [&bitsets, nof_repetitions](const char* name, auto&& op) {
+    int64_t                           dummy = 0;
+    high_resolution_clock::time_point tp    = high_resolution_clock::now();
+    for (size_t rep = 0; rep < nof_repetitions; ++rep) {
+      for (auto& b : bitsets) {
+        dummy += op(b);
+      }
+    }
+    nanoseconds t = std::chrono::duration_cast<nanoseconds>(high_resolution_clock::now() - tp);
+    fmt::print("  {:<25}: {:6.1f} nsec/op (chk={})\n", name, t.count() / (double)(nof_repetitions * nof_bitsets), dummy);
+  };
+
+  fmt::print("bounded_bitset<{}, {}> benchmark:\n", N, reversed);
+  run("count", [](const srsran::bounded_bitset<N, reversed>& b) { return b.count(); });
+  run("count(range)", [](const srsran::bounded_bitset<N, reversed>& b) { return b.count(3, N - 5); });
+  run("count(range) naive", [](const srsran::bounded_bitset<N, reversed>& b) { return naive::count(b, 3, N - 5); });
+  run("any(range)", [](const srsran::bounded_bitset<N, reversed>& b) { return b.any(N / 4, N / 2) ? 1 : 0; });
+  run("find_lowest_run(4)", [](const srsran::bounded_bitset<N, reversed>& b) {
+    return b.find_lowest_run(0, N, 4, false);
+  });
+  run("find_lowest_run(4) naive", [](const srsran::bounded_bitset<N, reversed>& b) {
+    return naive::find_lowest_run(b, 0, N, 4, false);
+  });
+  run("find_lowest_run(16)", [](const srsran::bounded_bitset<N, reversed>& b) {
+    return b.find_lowest_run(0, N, 16, false);
+  });
+  run("find_lowest_run(16) naive", [](const srsran::bounded_bitset<N, reversed>& b) {
+    return naive::find_lowest_run(b, 0, N, 16, false);
+  });
+  run("fill", [](srsran::bounded_bitset<N, reversed>& b) {
+    srsran::bounded_bitset<N, reversed> c(b);
+    c.fill(5, N - 3);
+    return c.count();
+  });
 }
 
 int main()
@@ -289,6 +454,12 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  test_bitset_range_operations<25, false>();
+  test_bitset_range_operations<25, true>();
+  test_bitset_range_operations<275, false>();
+  test_bitset_range_operations<275, true>();
+  bitset_benchmark<25, true>();
+  bitset_benchmark<275, true>();
   printf("Success\n");
   return 0;
 }
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/spsc_ring.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+
+namespace srsran {
+
+void test_spsc_ring_single_thread()
+{
+  spsc_ring<int, 4> ring;
+  TESTASSERT(ring.capacity() == 4);
+  TESTASSERT(ring.empty());
+
+  // push until full
+  for (int i = 0; i < 4; ++i) {
+    bool success = ring.try_push(i);
+    TESTASSERT(success);
+    TESTASSERT(ring.size() == (size_t)i + 1);
+  }
+  bool success = ring.try_push(4);
+  TESTASSERT(not success);
+
+  // pop one by one
+  int val = -1;
+  for (int i = 0; i < 2; ++i) {
+    success = ring.try_pop(val);
+    TESTASSERT(success and val == i);
+  }
+  TESTASSERT(ring.size() == 2);
+
+  // wrap-around
+  success = ring.try_push(4) and ring.try_push(5);
+  TESTASSERT(success);
+  success = ring.try_push(6);
+  TESTASSERT(not success);
+
+  // bulk pop
+  int    expected = 2;
+  size_t n        = ring.pop_all([&expected](const int& v) {
+    TESTASSERT(v == expected);
+    expected++;
+  });
+  TESTASSERT(n == 4 and expected == 6);
+  TESTASSERT(ring.empty());
+  success = ring.try_pop(val);
+  TESTASSERT(not success);
+  n = ring.pop_all([](const int& v) {});
+  TESTASSERT(n == 0);
+}
+
+void test_spsc_ring_two_threads()
+{
+  const int          nof_elems = 100000;
+  spsc_ring<int, 64> ring;
+  std::thread        t([&ring, nof_elems]() {
+    for (int i = 0; i < nof_elems;) {
+      if (ring.try_push(i)) {
+        i++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  // Alternate single and bulk pops
+  int next = 0;
+  while (next < nof_elems) {
+    int val;
+    if (next % 2 == 0 and ring.try_pop(val)) {
+      TESTASSERT(val == next);
+      next++;
+      continue;
+    }
+    size_t n = ring.pop_all([&next](const int& v) {
+      TESTASSERT(v == next);
+      next++;
+    });
+    if (n == 0) {
+      std::this_thread::yield();
+    }
+  }
+  t.join();
+  TESTASSERT(ring.empty());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  srsran::test_spsc_ring_single_thread();
+  srsran::test_spsc_ring_two_threads();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
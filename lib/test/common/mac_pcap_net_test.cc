@@ -22,8 +22,12 @@
 #include "srsran/common/common.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <ctime>
 #include <iostream>
 #include <thread>
+#include <unistd.h>
 
 // Write #num_pdus UL MAC PDUs using PCAP handle
 void write_pcap_eutra_thread_function(srsran::mac_pcap_net*           pcap_handle,
@@ -112,6 +116,153 @@ int nr_mac_pcap_net_test()
   return SRSRAN_SUCCESS;
 }
 
+// Reads back the PCAP file written by the bridge and returns its number of records
+uint32_t count_pcap_records(const char* filename)
+{
+  FILE* fd = fopen(filename, "r");
+  TESTASSERT(fd != nullptr);
+  pcap_hdr_t file_header;
+  TESTASSERT(fread(&file_header, sizeof(file_header), 1, fd) == 1);
+  TESTASSERT(file_header.network == UDP_DLT);
+
+  uint32_t             nof_records = 0;
+  pcaprec_hdr_t        packet_header;
+  std::vector<uint8_t> packet;
+  while (fread(&packet_header, sizeof(packet_header), 1, fd) == 1) {
+    packet.resize(packet_header.incl_len);
+    TESTASSERT(fread(packet.data(), 1, packet.size(), fd) == packet.size());
+    // Dummy UDP header followed by the "mac-lte" framing
+    TESTASSERT(packet.size() > 8 + strlen(MAC_LTE_START_STRING));
+    TESTASSERT(memcmp(packet.data() + 8, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING)) == 0);
+    nof_records++;
+  }
+  fclose(fd);
+  return nof_records;
+}
+
+// Checks the lost datagrams derived by the decoder from the datagram sequence numbers
+int mac_pcap_net_batch_decoder_seq_nr_test()
+{
+  auto decode_seq_nrs = [](std::initializer_list<uint32_t> seq_nrs) {
+    srsran::mac_pcap_net_batch_decoder decoder;
+    uint8_t                            datagram[srsran::mac_pcap_net_batch::hdr_len];
+    auto                               ignore_record = [](const srsran::mac_pcap_net_batch_decoder::record_t&) {};
+    for (uint32_t seq_nr : seq_nrs) {
+      srsran::mac_pcap_net_batch::header_t hdr;
+      hdr.seq_nr = seq_nr;
+      srsran::mac_pcap_net_batch::pack_header(hdr, datagram);
+      TESTASSERT(decoder.decode(datagram, sizeof(datagram), ignore_record));
+    }
+    return decoder.get_metrics().nof_lost_datagrams;
+  };
+
+  TESTASSERT(decode_seq_nrs({10, 11, 12}) == 0);
+  TESTASSERT(decode_seq_nrs({10, 13}) == 2);
+  // Late and duplicated datagrams are not lost, and do not move the expected sequence number backwards
+  TESTASSERT(decode_seq_nrs({10, 12, 11, 13}) == 1);
+  TESTASSERT(decode_seq_nrs({10, 11, 11, 10, 12}) == 0);
+  TESTASSERT(decode_seq_nrs({10, 14, 11, 12, 15}) == 3);
+  // Wrap-around of the sequence number
+  TESTASSERT(decode_seq_nrs({0xfffffffe, 0xffffffff, 0, 1}) == 0);
+  TESTASSERT(decode_seq_nrs({0xfffffffe, 1, 0xffffffff, 2}) == 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+// Offers DL PDUs from several threads, as the PHY workers of a loaded cell would do every TTI, and reports the rate
+// sustained by the network tap. In batched mode, the datagrams are received by a bridge that writes them to a PCAP
+// file.
+int mac_pcap_net_throughput_test(bool batch)
+{
+  const uint32_t num_threads         = 4;
+  const uint32_t num_ttis            = 500;
+  const uint32_t num_pdus_per_tti    = 25; // per thread, i.e. 100k PDU/s in total
+  const uint32_t num_pdus_per_thread = num_ttis * num_pdus_per_tti;
+  const uint32_t pdu_len             = 1500;
+  // Unique file and ports per run, so that concurrent runs of the test do not interfere
+  const std::string pcap_filename = fmt::format("/tmp/mac_pcap_net_test_{}_{}.pcap", getpid(), batch ? "batch" : "pdu");
+
+  srsran::mac_pcap_net_bridge bridge;
+  TESTASSERT(bridge.open("127.0.0.1", 0, pcap_filename));
+  const uint16_t client_port = bridge.get_port();
+  TESTASSERT(client_port != 0);
+  std::atomic<bool> rx_running = {true};
+  std::thread       rx_thread([&bridge, &rx_running]() {
+    while (rx_running or bridge.receive(0) > 0) {
+      bridge.receive(10);
+    }
+  });
+
+  srsran::mac_pcap_net_batch_cfg_t batch_cfg;
+  batch_cfg.enable = batch;
+  srsran::mac_pcap_net pcap_handle;
+  TESTASSERT(pcap_handle.open("127.0.0.1", "0.0.0.0", client_port, 0, 0, batch_cfg) == SRSRAN_SUCCESS);
+
+  std::vector<uint8_t>     pdu(pdu_len, 0x02);
+  std::clock_t             cpu_start = std::clock();
+  auto                     tp        = std::chrono::steady_clock::now();
+  std::vector<std::thread> writer_threads;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    writer_threads.emplace_back([&pcap_handle, &pdu, i, tp, num_ttis, num_pdus_per_tti]() {
+      for (uint32_t tti = 0; tti < num_ttis; tti++) {
+        std::this_thread::sleep_until(tp + std::chrono::milliseconds(tti));
+        for (uint32_t n = 0; n < num_pdus_per_tti; n++) {
+          pcap_handle.write_dl_crnti(pdu.data(), pdu.size(), 0x46 + i, true, tti % 10240, 0);
+        }
+      }
+    });
+  }
+  for (std::thread& thread : writer_threads) {
+    thread.join();
+  }
+  TESTASSERT(pcap_handle.close() == SRSRAN_SUCCESS);
+  double elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - tp).count();
+  double cpu_sec     = (std::clock() - cpu_start) / (double)CLOCKS_PER_SEC;
+
+  rx_running = false;
+  rx_thread.join();
+  bridge.close();
+
+  srsran::mac_pcap_net_metrics_t               tx = pcap_handle.get_metrics();
+  const srsran::mac_pcap_net_batch_decoder::metrics_t& rx = bridge.get_metrics();
+  fmt::print("{} mode: offered={} PDUs, sent={} PDUs ({:.0f} PDU/s, {:.1f} Mbps), dropped={}, datagrams={}, "
+             "syscalls/PDU={:.3f}, CPU={:.0f} ms\n",
+             batch ? "Batched" : "Per-PDU",
+             num_threads * num_pdus_per_thread,
+             tx.nof_pdus,
+             tx.nof_pdus / elapsed_sec,
+             tx.nof_bytes * 8 / elapsed_sec / 1e6,
+             tx.nof_dropped_pdus,
+             tx.nof_datagrams,
+             tx.nof_pdus > 0 ? tx.nof_syscalls / (double)tx.nof_pdus : 0.0,
+             cpu_sec * 1000);
+
+  // Every offered PDU is either sent or accounted for as dropped
+  TESTASSERT(tx.nof_pdus + tx.nof_dropped_pdus == num_threads * num_pdus_per_thread);
+  TESTASSERT(tx.nof_pdus > 0);
+  if (batch) {
+    fmt::print("  Bridge: received={} PDUs in {} datagrams, lost datagrams={}, sender drops={}\n",
+               rx.nof_records,
+               rx.nof_datagrams,
+               rx.nof_lost_datagrams,
+               rx.nof_sender_dropped_pdus);
+    TESTASSERT(tx.nof_syscalls < tx.nof_pdus);
+    TESTASSERT(rx.nof_malformed_datagrams == 0);
+    TESTASSERT(rx.nof_datagrams + rx.nof_lost_datagrams <= tx.nof_datagrams);
+    TESTASSERT(rx.nof_records <= tx.nof_pdus);
+    if (rx.nof_lost_datagrams == 0 and rx.nof_datagrams == tx.nof_datagrams) {
+      TESTASSERT(rx.nof_records == tx.nof_pdus);
+    }
+    TESTASSERT(count_pcap_records(pcap_filename.c_str()) == rx.nof_records);
+  } else {
+    // The per-PDU datagrams are not understood by the bridge
+    TESTASSERT(rx.nof_records == 0);
+  }
+  remove(pcap_filename.c_str());
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   auto& mac_logger = srslog::fetch_basic_logger("MAC", false);
@@ -121,4 +272,10 @@ int main(int argc, char** argv)
 
   TESTASSERT(lte_mac_pcap_net_test() == SRSRAN_SUCCESS);
   TESTASSERT(nr_mac_pcap_net_test() == SRSRAN_SUCCESS);
+  TESTASSERT(mac_pcap_net_batch_decoder_seq_nr_test() == SRSRAN_SUCCESS);
+
+  // Silence the drop warnings of the throughput tests
+  mac_logger.set_level(srslog::basic_levels::error);
+  TESTASSERT(mac_pcap_net_throughput_test(false) == SRSRAN_SUCCESS);
+  TESTASSERT(mac_pcap_net_throughput_test(true) == SRSRAN_SUCCESS);
 }
\ No newline at end of file
@@ -410,6 +410,41 @@ int test_task_thread_pool3()
   return 0;
 }
 
+int test_task_thread_pool4()
+{
+  std::cout << "\n====== TEST task thread pool test 4: start ======\n";
+  // Description: push tasks from within the workers, more than fit in a worker local queue, with both priorities, and
+  //              check that all of them are executed
+
+  uint32_t              nof_workers = 4, nof_roots = 16, nof_children = 1000;
+  std::atomic<uint32_t> count{0}, high_count{0};
+
+  task_thread_pool thread_pool(nof_workers);
+
+  for (uint32_t i = 0; i < nof_roots; ++i) {
+    thread_pool.push_task([&]() {
+      for (uint32_t j = 0; j < nof_children; ++j) {
+        if (j % 10 == 0) {
+          thread_pool.push_task([&high_count]() { high_count++; }, task_thread_pool::task_priority::high);
+        } else {
+          thread_pool.push_task([&count]() { count++; });
+        }
+      }
+    });
+  }
+
+  while (count + high_count < nof_roots * nof_children) {
+    usleep(100);
+  }
+  TESTASSERT(thread_pool.nof_pending_tasks() == 0);
+  thread_pool.stop();
+  TESTASSERT(high_count == nof_roots * nof_children / 10);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
 struct C {
   std::unique_ptr<int> val{new int{5}};
 };
@@ -503,6 +538,7 @@ int main()
   TESTASSERT(test_task_thread_pool() == 0);
   TESTASSERT(test_task_thread_pool2() == 0);
   TESTASSERT(test_task_thread_pool3() == 0);
+  TESTASSERT(test_task_thread_pool4() == 0);
 
   TESTASSERT(test_inplace_task() == 0);
 }
@@ -0,0 +1,211 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <unistd.h>
+
+/**
+ * Batched datagram I/O benchmark. It forwards bursts of GTP-U-sized datagrams over a loopback UDP socket, as the
+ * MBMS-GW does towards the M1-U, and compares in packets per second:
+ * - per-packet I/O, with one sendto/recvfrom call per datagram
+ * - batched I/O, with net_utils::send_pdus/recv_pdus, i.e. one sendmmsg/recvmmsg call per burst
+ * The bursts are sent and received from the same thread, and are small enough to fit in the socket receive buffer,
+ * so that no datagram is dropped and both sides are measured separately.
+ *
+ * Usage: network_batch_io_benchmark [test|benchmark]
+ */
+
+namespace srsran {
+
+using bench_clock = std::chrono::steady_clock;
+
+struct run_params {
+  uint32_t nof_pdus;
+  uint32_t pdu_size;
+  uint32_t burst_size;
+};
+
+struct run_data {
+  run_params params;
+  bool       batched;
+  double     tx_pdus_per_sec;
+  double     rx_pdus_per_sec;
+};
+
+class loopback_link
+{
+public:
+  loopback_link()
+  {
+    using namespace net_utils;
+    TESTASSERT(rx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+    TESTASSERT(rx_socket.bind_addr("127.0.0.1", 0));
+    TESTASSERT(tx_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+    socklen_t len = sizeof(rx_addr);
+    TESTASSERT(getsockname(rx_socket.fd(), (sockaddr*)&rx_addr, &len) == 0);
+  }
+
+  unique_socket rx_socket, tx_socket;
+  sockaddr_in   rx_addr = {};
+};
+
+/// Receives the given number of datagrams, with one call per datagram or per burst
+uint32_t
+recv_burst(loopback_link& link, unique_byte_buffer_t* pdus, sockaddr_in* from, uint32_t burst_size, bool batched)
+{
+  uint32_t nof_recv = 0;
+  while (nof_recv < burst_size) {
+    if (batched) {
+      int n = net_utils::recv_pdus(link.rx_socket.fd(), pdus + nof_recv, from + nof_recv, burst_size - nof_recv);
+      if (n <= 0) {
+        break;
+      }
+      nof_recv += n;
+    } else {
+      socklen_t fromlen = sizeof(from[nof_recv]);
+      ssize_t   n       = recvfrom(link.rx_socket.fd(),
+                                   pdus[nof_recv]->msg,
+                                   pdus[nof_recv]->get_tailroom(),
+                                   MSG_DONTWAIT,
+                                   (sockaddr*)&from[nof_recv],
+                                   &fromlen);
+      if (n < 0) {
+        break;
+      }
+      pdus[nof_recv]->N_bytes = n;
+      nof_recv++;
+    }
+  }
+  return nof_recv;
+}
+
+/// Sends the given number of datagrams, with one call per datagram or per burst
+uint32_t send_burst(loopback_link& link, const unique_byte_buffer_t* pdus, uint32_t burst_size, bool batched)
+{
+  if (batched) {
+    return net_utils::send_pdus(link.tx_socket.fd(), link.rx_addr, pdus, burst_size);
+  }
+  uint32_t nof_sent = 0;
+  for (; nof_sent < burst_size; ++nof_sent) {
+    ssize_t n = sendto(link.tx_socket.fd(),
+                       pdus[nof_sent]->msg,
+                       pdus[nof_sent]->N_bytes,
+                       0,
+                       (const sockaddr*)&link.rx_addr,
+                       sizeof(link.rx_addr));
+    if (n < 0) {
+      break;
+    }
+  }
+  return nof_sent;
+}
+
+int run_benchmark_scenario(const run_params& params, bool batched, run_data& r)
+{
+  loopback_link                     link;
+  std::vector<unique_byte_buffer_t> tx_pdus(params.burst_size), rx_pdus(params.burst_size);
+  std::vector<sockaddr_in>          from(params.burst_size);
+  for (uint32_t i = 0; i < params.burst_size; ++i) {
+    tx_pdus[i] = make_byte_buffer();
+    rx_pdus[i] = make_byte_buffer();
+    TESTASSERT(tx_pdus[i] != nullptr and rx_pdus[i] != nullptr);
+    tx_pdus[i]->N_bytes = params.pdu_size;
+  }
+
+  std::chrono::duration<double> tx_time{0}, rx_time{0};
+  for (uint32_t count = 0; count < params.nof_pdus; count += params.burst_size) {
+    for (uint32_t i = 0; i < params.burst_size; ++i) {
+      tx_pdus[i]->msg[0] = (count + i) % 256;
+    }
+    bench_clock::time_point tic      = bench_clock::now();
+    uint32_t                nof_sent = send_burst(link, tx_pdus.data(), params.burst_size, batched);
+    bench_clock::time_point toc      = bench_clock::now();
+    uint32_t                nof_recv = recv_burst(link, rx_pdus.data(), from.data(), params.burst_size, batched);
+    rx_time += bench_clock::now() - toc;
+    tx_time += toc - tic;
+
+    TESTASSERT(nof_sent == params.burst_size);
+    TESTASSERT(nof_recv == params.burst_size);
+    for (uint32_t i = 0; i < params.burst_size; ++i) {
+      TESTASSERT(rx_pdus[i]->N_bytes == params.pdu_size);
+      TESTASSERT(rx_pdus[i]->msg[0] == (count + i) % 256);
+      rx_pdus[i]->clear();
+    }
+  }
+
+  uint32_t nof_pdus = ((params.nof_pdus + params.burst_size - 1) / params.burst_size) * params.burst_size;
+  r.params          = params;
+  r.batched         = batched;
+  r.tx_pdus_per_sec = nof_pdus / tx_time.count();
+  r.rx_pdus_per_sec = nof_pdus / rx_time.count();
+  return SRSRAN_SUCCESS;
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  fmt::print("run | I/O       | PDU size [B] | burst | tx [PDU/s] | rx [PDU/s] | tx [Mbps]\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data& r = run_results[i];
+    fmt::print("{:>3d} | {:<9} | {:>12d} | {:>5d} | {:>10.0f} | {:>10.0f} | {:>9.1f}\n",
+               i,
+               r.batched ? "batched" : "per-PDU",
+               r.params.pdu_size,
+               r.params.burst_size,
+               r.tx_pdus_per_sec,
+               r.rx_pdus_per_sec,
+               r.tx_pdus_per_sec * r.params.pdu_size * 8 / 1e6);
+  }
+}
+
+int run_all(uint32_t nof_pdus)
+{
+  std::vector<run_data> run_results;
+  for (uint32_t pdu_size : {64, 512, 1400}) {
+    for (uint32_t burst_size : {8, 32}) {
+      run_params params = {nof_pdus, pdu_size, burst_size};
+      for (bool batched : {false, true}) {
+        run_data r = {};
+        TESTASSERT(run_benchmark_scenario(params, batched, r) == SRSRAN_SUCCESS);
+        run_results.push_back(r);
+      }
+    }
+  }
+  print_benchmark_results(run_results);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main(int argc, char* argv[])
+{
+  srslog::fetch_basic_logger("COMN", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  if (argc == 1 or strcmp(argv[1], "test") == 0) {
+    TESTASSERT(srsran::run_all(2000) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark") == 0) {
+    TESTASSERT(srsran::run_all(1000000) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -124,6 +124,61 @@ int test_socket_handler()
   return 0;
 }
 
+int test_batch_sdu_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+
+  std::atomic<uint32_t> counter   = {0};
+  std::atomic<bool>     in_order  = {true};
+  const uint32_t        nof_pdus  = 100;
+  const int             port      = 36413;
+  const char*           addr_str  = "127.0.0.1";
+  using namespace srsran::net_utils;
+
+  srsran::unique_socket  server_socket, client_socket;
+  srsran::socket_manager sockhandler;
+  TESTASSERT(server_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket.bind_addr(addr_str, port));
+  TESTASSERT(client_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+
+  // register server Rx handler, which receives the datagrams in batches
+  auto pdu_handler = [&counter, &in_order](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    uint32_t count = counter;
+    if (pdu->N_bytes != count % 50 + 1 or pdu->msg[0] != count % 256) {
+      in_order = false;
+    }
+    counter++;
+  };
+  rx_thread_tester rx_tester;
+  sockhandler.add_socket_handler(server_socket.fd(),
+                                 srsran::make_batch_sdu_handler(logger, rx_tester.task_queue, pdu_handler, 16));
+
+  // send all the datagrams with a few sendmmsg calls
+  std::vector<srsran::unique_byte_buffer_t> pdus(nof_pdus);
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    pdus[i] = srsran::make_byte_buffer();
+    TESTASSERT(pdus[i] != nullptr);
+    pdus[i]->N_bytes = i % 50 + 1;
+    pdus[i]->msg[0]  = i % 256;
+  }
+  sockaddr_in server_addrin = {};
+  TESTASSERT(set_sockaddr(&server_addrin, addr_str, port));
+  TESTASSERT(send_pdus(client_socket.fd(), server_addrin, pdus.data(), nof_pdus) == (int)nof_pdus);
+
+  uint32_t time_elapsed = 0;
+  while (counter != nof_pdus) {
+    usleep(100);
+    time_elapsed += 100;
+    if (time_elapsed > 3000000) {
+      // too much time has passed
+      return -1;
+    }
+  }
+  TESTASSERT(in_order);
+
+  return 0;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -146,6 +201,7 @@ int main()
 
   TESTASSERT(test_socket_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
+  TESTASSERT(test_batch_sdu_handler() == 0);
 
   return 0;
 }
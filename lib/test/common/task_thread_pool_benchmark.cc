@@ -0,0 +1,294 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <thread>
+
+/**
+ * Task thread pool benchmark. It compares the work-stealing srsran::task_thread_pool with a reference pool served
+ * from a single queue guarded by a mutex, i.e. the previous implementation of the task_thread_pool, in terms of:
+ * - throughput of small tasks pushed from an external thread
+ * - throughput of small tasks pushed from within the workers (fork), which the work-stealing pool keeps local
+ * - latency between the push of a task and the start of its execution, while the pool is loaded with other tasks
+ *
+ * Usage: task_thread_pool_benchmark [test|benchmark]
+ */
+
+namespace srsran {
+
+using bench_clock = std::chrono::steady_clock;
+using task_t      = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
+
+/// Reference pool with one queue shared by all the workers
+class locked_task_pool
+{
+public:
+  explicit locked_task_pool(uint32_t nof_workers)
+  {
+    for (uint32_t i = 0; i < nof_workers; ++i) {
+      workers.emplace_back([this]() { run_worker(); });
+    }
+  }
+  ~locked_task_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running = false;
+    }
+    cvar.notify_all();
+    for (std::thread& t : workers) {
+      t.join();
+    }
+  }
+
+  void push_task(task_t&& task, task_thread_pool::task_priority prio = task_thread_pool::task_priority::normal)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending_tasks.push_back(std::move(task));
+    }
+    cvar.notify_one();
+  }
+
+private:
+  void run_worker()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      while (running and pending_tasks.empty()) {
+        cvar.wait(lock);
+      }
+      if (not running) {
+        return;
+      }
+      task_t task = std::move(pending_tasks.front());
+      pending_tasks.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+  std::mutex               mutex;
+  std::condition_variable  cvar;
+  std::deque<task_t>       pending_tasks;
+  std::vector<std::thread> workers;
+  bool                     running = true;
+};
+
+/// Emulates the processing of a small task
+void small_work(uint32_t nof_iterations)
+{
+  volatile uint32_t acc = 0;
+  for (uint32_t i = 0; i < nof_iterations; ++i) {
+    acc = acc + i;
+  }
+}
+
+/// Number of tasks that may be pending at any given time, below the capacity of the pool queues
+const uint32_t max_tasks_in_flight = 4096;
+
+void wait_count(const std::atomic<uint32_t>& count, uint32_t value)
+{
+  while (count.load(std::memory_order_acquire) < value) {
+    std::this_thread::yield();
+  }
+}
+
+struct run_params {
+  uint32_t nof_workers;
+  uint32_t nof_tasks;
+  uint32_t task_iterations;
+};
+
+struct run_data {
+  run_params params;
+  bool       work_stealing;
+  double     inject_tasks_per_sec;
+  double     fork_tasks_per_sec;
+  double     normal_latency_mean_us;
+  double     normal_latency_p99_us;
+  double     high_latency_mean_us;
+  double     high_latency_p99_us;
+};
+
+/// Pushes all the tasks from the calling thread and measures the time until all of them are executed
+template <typename Pool>
+double run_inject(Pool& pool, const run_params& params)
+{
+  std::atomic<uint32_t>   count{0};
+  bench_clock::time_point tic = bench_clock::now();
+  for (uint32_t i = 0; i < params.nof_tasks; ++i) {
+    if (i >= max_tasks_in_flight) {
+      wait_count(count, i - max_tasks_in_flight);
+    }
+    pool.push_task([&count, &params]() {
+      small_work(params.task_iterations);
+      count.fetch_add(1, std::memory_order_release);
+    });
+  }
+  wait_count(count, params.nof_tasks);
+  std::chrono::duration<double> elapsed = bench_clock::now() - tic;
+  return params.nof_tasks / elapsed.count();
+}
+
+/// Pushes root tasks, each pushing a few tasks from within the worker
+template <typename Pool>
+double run_fork(Pool& pool, const run_params& params)
+{
+  const uint32_t          nof_children = 32;
+  const uint32_t          nof_roots    = params.nof_tasks / nof_children;
+  std::atomic<uint32_t>   count{0};
+  bench_clock::time_point tic = bench_clock::now();
+  for (uint32_t r = 0; r < nof_roots; ++r) {
+    if (r * nof_children >= max_tasks_in_flight) {
+      wait_count(count, r * nof_children - max_tasks_in_flight);
+    }
+    pool.push_task([&pool, &count, &params, nof_children]() {
+      for (uint32_t i = 0; i < nof_children; ++i) {
+        pool.push_task([&count, &params]() {
+          small_work(params.task_iterations);
+          count.fetch_add(1, std::memory_order_release);
+        });
+      }
+    });
+  }
+  wait_count(count, nof_roots * nof_children);
+  std::chrono::duration<double> elapsed = bench_clock::now() - tic;
+  return nof_roots * nof_children / elapsed.count();
+}
+
+/// Loads the pool with tasks and measures the delay between the push of a probe task and the start of its execution
+template <typename Pool>
+void run_latency(Pool&                          pool,
+                 const run_params&              params,
+                 task_thread_pool::task_priority prio,
+                 double&                        mean_us,
+                 double&                        p99_us)
+{
+  const uint32_t      nof_probes = 64;
+  std::vector<double> latencies(nof_probes);
+
+  std::atomic<uint32_t> count{0};
+  uint32_t              nof_background = params.nof_tasks / 4;
+  for (uint32_t i = 0; i < nof_background; ++i) {
+    if (i >= max_tasks_in_flight) {
+      wait_count(count, i - max_tasks_in_flight);
+    }
+    pool.push_task([&count, &params]() {
+      small_work(params.task_iterations);
+      count.fetch_add(1, std::memory_order_release);
+    });
+  }
+  for (uint32_t i = 0; i < nof_probes; ++i) {
+    bench_clock::time_point push_time = bench_clock::now();
+    pool.push_task(
+        [&count, &latencies, push_time, i]() {
+          std::chrono::duration<double, std::micro> latency = bench_clock::now() - push_time;
+          latencies[i]                                      = latency.count();
+          count.fetch_add(1, std::memory_order_release);
+        },
+        prio);
+  }
+  wait_count(count, nof_background + nof_probes);
+
+  std::sort(latencies.begin(), latencies.end());
+  mean_us = 0;
+  for (double l : latencies) {
+    mean_us += l / nof_probes;
+  }
+  p99_us = latencies[(nof_probes * 99) / 100];
+}
+
+template <typename Pool>
+void run_benchmark_scenario(Pool& pool, const run_params& params, run_data& r)
+{
+  r.params               = params;
+  r.inject_tasks_per_sec = run_inject(pool, params);
+  r.fork_tasks_per_sec   = run_fork(pool, params);
+  run_latency(pool, params, task_thread_pool::task_priority::normal, r.normal_latency_mean_us, r.normal_latency_p99_us);
+  run_latency(pool, params, task_thread_pool::task_priority::high, r.high_latency_mean_us, r.high_latency_p99_us);
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  fmt::print("Note: the reference pool has no priorities, its high priority tasks are served as normal ones\n");
+  fmt::print("run | pool      | workers | inject [task/s] | fork [task/s] | normal lat mean/p99 [us] | high lat "
+             "mean/p99 [us]\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data& r = run_results[i];
+    fmt::print("{:>3d} | {:<9} | {:>7d} | {:>15.0f} | {:>13.0f} | {:>11.1f} / {:>10.1f} | {:>9.1f} / {:>9.1f}\n",
+               i,
+               r.work_stealing ? "stealing" : "reference",
+               r.params.nof_workers,
+               r.inject_tasks_per_sec,
+               r.fork_tasks_per_sec,
+               r.normal_latency_mean_us,
+               r.normal_latency_p99_us,
+               r.high_latency_mean_us,
+               r.high_latency_p99_us);
+  }
+}
+
+int run_all(uint32_t nof_tasks)
+{
+  std::vector<run_data> run_results;
+  for (uint32_t nof_workers : {1, 2, 4}) {
+    run_params params = {nof_workers, nof_tasks, 200};
+    run_data   r      = {};
+    {
+      locked_task_pool pool(nof_workers);
+      run_benchmark_scenario(pool, params, r);
+      r.work_stealing = false;
+      run_results.push_back(r);
+    }
+    {
+      task_thread_pool pool(nof_workers);
+      run_benchmark_scenario(pool, params, r);
+      r.work_stealing = true;
+      run_results.push_back(r);
+      TESTASSERT(pool.nof_pending_tasks() == 0);
+    }
+  }
+  print_benchmark_results(run_results);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main(int argc, char* argv[])
+{
+  srslog::fetch_basic_logger("POOL", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  if (argc == 1 or strcmp(argv[1], "test") == 0) {
+    TESTASSERT(srsran::run_all(4000) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark") == 0) {
+    TESTASSERT(srsran::run_all(400000) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
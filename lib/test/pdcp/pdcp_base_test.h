@@ -74,7 +74,8 @@ private:
   srsran::unique_byte_buffer_t last_pdcp_pdu;
 
   bool rb_is_um(uint32_t lcid) { return false; }
-  bool sdu_queue_is_full(uint32_t lcid) { return false; };
+  bool     sdu_queue_is_full(uint32_t lcid) { return false; };
+  uint32_t get_buffer_state(uint32_t lcid) { return 0; }
 };
 
 class rrc_dummy : public srsue::rrc_interface_pdcp
@@ -130,6 +131,14 @@ public:
     rx_count++;
     last_pdu.swap(pdu);
   }
+  void write_pdu_batch(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+  {
+    nof_batches++;
+    for (srsran::unique_byte_buffer_t& pdu : pdus) {
+      write_pdu(lcid, std::move(pdu));
+    }
+  }
+  uint32_t nof_batches = 0;
 
 private:
   srslog::basic_logger&        logger;
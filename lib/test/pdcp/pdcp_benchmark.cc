@@ -0,0 +1,356 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/test/ue_test_interfaces.h"
+#include "srsran/upper/pdcp_entity_lte.h"
+#include "srsran/upper/pdcp_entity_nr.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <sys/resource.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * PDCP end-to-end benchmark. SDUs are written into a TX PDCP entity, whose PDUs are looped back into a peer RX PDCP
+ * entity, optionally out-of-order. The benchmark reports the rate of SDUs, the cycles per byte spent in TX and RX
+ * processing (i.e. header handling, ciphering and integrity protection) and the memory use.
+ *
+ * Usage: pdcp_benchmark [test|benchmark]
+ */
+
+namespace srsran {
+
+/// Reads the CPU cycle counter, falling back to ns on architectures without an accessible one
+inline uint64_t read_cycle_counter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t val;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(val));
+  return val;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/// Collects the PDUs generated by the TX entity
+class rlc_loopback : public srsue::rlc_interface_pdcp
+{
+public:
+  void     write_sdu(uint32_t lcid, unique_byte_buffer_t sdu) final { pdus.push_back(std::move(sdu)); }
+  void     discard_sdu(uint32_t lcid, uint32_t discard_sn) final { nof_discards++; }
+  bool     rb_is_um(uint32_t lcid) final { return false; }
+  bool     sdu_queue_is_full(uint32_t lcid) final { return false; }
+  bool     is_suspended(uint32_t lcid) final { return false; }
+  uint32_t get_buffer_state(uint32_t lcid) final { return 0; }
+
+  std::vector<unique_byte_buffer_t> pdus;
+  uint64_t                          nof_discards = 0;
+};
+
+/// Counts the SDUs delivered by the RX entity
+class upper_sink : public srsue::gw_interface_pdcp, public srsue::rrc_interface_pdcp
+{
+public:
+  // GW interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t pdu) final
+  {
+    nof_sdus++;
+    nof_bytes += pdu->N_bytes;
+  }
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t pdu) final {}
+
+  // RRC interface
+  void        write_pdu_bcch_bch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_bcch_dlsch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_pcch(unique_byte_buffer_t pdu) final {}
+  void        notify_pdcp_integrity_error(uint32_t lcid) final { nof_integrity_errors++; }
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+
+  uint64_t nof_sdus             = 0;
+  uint64_t nof_bytes            = 0;
+  uint64_t nof_integrity_errors = 0;
+};
+
+struct run_params {
+  srsran_rat_t                rat;
+  pdcp_rb_type_t              rb_type;
+  uint8_t                     sn_len;
+  CIPHERING_ALGORITHM_ID_ENUM cipher_algo;
+  INTEGRITY_ALGORITHM_ID_ENUM integ_algo;
+  uint32_t                    reorder_window; ///< PDUs are shuffled in blocks of this size (NR only). 0 means in-order
+  pdcp_discard_timer_t        discard_timer;
+  uint32_t                    sdu_len;
+  uint32_t                    nof_sdus;
+};
+
+struct run_data {
+  run_params params;
+  double     sdus_per_sec;
+  double     tx_cycles_per_byte;
+  double     rx_cycles_per_byte;
+  double     pool_mem_mbytes;
+  double     max_rss_mbytes;
+};
+
+/// Number of SDUs written into the TX entity per TTI, i.e. before the PDUs are forwarded to the RX entity
+const uint32_t sdus_per_tti = 32;
+
+template <typename PdcpEntity>
+int run_benchmark_scenario(const run_params& params, std::vector<run_data>& run_results)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PDCP", false);
+
+  rlc_loopback            rlc;
+  upper_sink              sink;
+  srsue::stack_test_dummy stack;
+
+  as_security_config_t sec_cfg = {};
+  for (uint32_t i = 0; i < sec_cfg.k_rrc_int.size(); ++i) {
+    sec_cfg.k_rrc_int[i] = sec_cfg.k_up_int[i] = i;
+    sec_cfg.k_rrc_enc[i] = sec_cfg.k_up_enc[i] = 0xff - i;
+  }
+  sec_cfg.integ_algo  = params.integ_algo;
+  sec_cfg.cipher_algo = params.cipher_algo;
+
+  pdcp_config_t tx_cfg(1,
+                       params.rb_type,
+                       SECURITY_DIRECTION_DOWNLINK,
+                       SECURITY_DIRECTION_UPLINK,
+                       params.sn_len,
+                       pdcp_t_reordering_t::ms500,
+                       params.discard_timer,
+                       false,
+                       params.rat);
+  pdcp_config_t rx_cfg(1,
+                       params.rb_type,
+                       SECURITY_DIRECTION_UPLINK,
+                       SECURITY_DIRECTION_DOWNLINK,
+                       params.sn_len,
+                       pdcp_t_reordering_t::ms500,
+                       pdcp_discard_timer_t::infinity,
+                       false,
+                       params.rat);
+
+  PdcpEntity pdcp_tx(&rlc, &sink, &sink, &stack.task_sched, logger, 1);
+  PdcpEntity pdcp_rx(&rlc, &sink, &sink, &stack.task_sched, logger, 1);
+  TESTASSERT(pdcp_tx.configure(tx_cfg));
+  TESTASSERT(pdcp_rx.configure(rx_cfg));
+  for (PdcpEntity* pdcp : {&pdcp_tx, &pdcp_rx}) {
+    pdcp->config_security(sec_cfg);
+    pdcp->enable_integrity(DIRECTION_TXRX);
+    pdcp->enable_encryption(DIRECTION_TXRX);
+  }
+
+  std::mt19937     rand_gen(params.nof_sdus);
+  uint64_t         tx_cycles = 0, rx_cycles = 0;
+  pdcp_sn_vector_t delivered_sns;
+  auto             tp_start = std::chrono::steady_clock::now();
+  for (uint32_t count = 0; count < params.nof_sdus; count += sdus_per_tti) {
+    uint32_t nof_tti_sdus = std::min(sdus_per_tti, params.nof_sdus - count);
+
+    // TX
+    for (uint32_t i = 0; i < nof_tti_sdus; ++i) {
+      unique_byte_buffer_t sdu = make_byte_buffer();
+      TESTASSERT(sdu != nullptr);
+      memset(sdu->msg, (count + i) & 0xffU, params.sdu_len);
+      sdu->N_bytes = params.sdu_len;
+
+      uint64_t t0 = read_cycle_counter();
+      pdcp_tx.write_sdu(std::move(sdu));
+      tx_cycles += read_cycle_counter() - t0;
+    }
+
+    // Transport, possibly out-of-order
+    if (params.reorder_window > 1) {
+      for (size_t i = 0; i < rlc.pdus.size(); i += params.reorder_window) {
+        size_t len = std::min(static_cast<size_t>(params.reorder_window), rlc.pdus.size() - i);
+        std::shuffle(rlc.pdus.begin() + i, rlc.pdus.begin() + i + len, rand_gen);
+      }
+    }
+    delivered_sns.clear();
+    for (unique_byte_buffer_t& pdu : rlc.pdus) {
+      delivered_sns.push_back(pdu->md.pdcp_sn);
+
+      uint64_t t0 = read_cycle_counter();
+      pdcp_rx.write_pdu(std::move(pdu));
+      rx_cycles += read_cycle_counter() - t0;
+    }
+    rlc.pdus.clear();
+
+    // RLC ACKs stop the discard timers
+    pdcp_tx.notify_delivery(delivered_sns);
+    stack.run_tti();
+  }
+  double elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - tp_start).count();
+
+  TESTASSERT_EQ(params.nof_sdus, sink.nof_sdus);
+  TESTASSERT_EQ((uint64_t)params.nof_sdus * params.sdu_len, sink.nof_bytes);
+  TESTASSERT_EQ(0, sink.nof_integrity_errors);
+  TESTASSERT_EQ(0, rlc.nof_discards);
+
+  struct rusage usage = {};
+  getrusage(RUSAGE_SELF, &usage);
+
+  run_data run           = {};
+  run.params             = params;
+  run.sdus_per_sec       = params.nof_sdus / elapsed_sec;
+  run.tx_cycles_per_byte = static_cast<double>(tx_cycles) / sink.nof_bytes;
+  run.rx_cycles_per_byte = static_cast<double>(rx_cycles) / sink.nof_bytes;
+  run.pool_mem_mbytes    = byte_buffer_pool::get_instance()->size() * sizeof(byte_buffer_t) / 1e6;
+  run.max_rss_mbytes     = usage.ru_maxrss / 1e3;
+  run_results.push_back(run);
+  return SRSRAN_SUCCESS;
+}
+
+int run_benchmark_scenario(const run_params& params, std::vector<run_data>& run_results)
+{
+  if (params.rat == srsran_rat_t::nr) {
+    return run_benchmark_scenario<pdcp_entity_nr>(params, run_results);
+  }
+  return run_benchmark_scenario<pdcp_entity_lte>(params, run_results);
+}
+
+std::vector<run_params> get_run_param_list(uint32_t nof_sdus)
+{
+  const uint32_t          sdu_len = 1500;
+  std::vector<run_params> list;
+  for (uint32_t algo = 0; algo < 4; ++algo) {
+    auto cipher = static_cast<CIPHERING_ALGORITHM_ID_ENUM>(algo);
+    auto integ  = static_cast<INTEGRITY_ALGORITHM_ID_ENUM>(algo);
+
+    // LTE DRBs are not integrity protected, so the EIA is only exercised with SRBs
+    list.push_back({srsran_rat_t::lte,
+                    PDCP_RB_IS_DRB,
+                    PDCP_SN_LEN_12,
+                    cipher,
+                    integ,
+                    0,
+                    pdcp_discard_timer_t::infinity,
+                    sdu_len,
+                    nof_sdus});
+    if (algo > 0) {
+      list.push_back({srsran_rat_t::lte,
+                      PDCP_RB_IS_SRB,
+                      PDCP_SN_LEN_5,
+                      cipher,
+                      integ,
+                      0,
+                      pdcp_discard_timer_t::infinity,
+                      sdu_len,
+                      nof_sdus});
+    }
+    for (uint8_t sn_len : {PDCP_SN_LEN_12, PDCP_SN_LEN_18}) {
+      list.push_back({srsran_rat_t::nr,
+                      PDCP_RB_IS_DRB,
+                      sn_len,
+                      cipher,
+                      integ,
+                      0,
+                      pdcp_discard_timer_t::infinity,
+                      sdu_len,
+                      nof_sdus});
+    }
+  }
+
+  // Discard timers and out-of-order delivery, which exercises the NR reordering queue
+  list.push_back({srsran_rat_t::lte,
+                  PDCP_RB_IS_DRB,
+                  PDCP_SN_LEN_18,
+                  CIPHERING_ALGORITHM_ID_128_EEA2,
+                  INTEGRITY_ALGORITHM_ID_128_EIA2,
+                  0,
+                  pdcp_discard_timer_t::ms100,
+                  sdu_len,
+                  nof_sdus});
+  for (uint32_t reorder_window : {8, 32}) {
+    list.push_back({srsran_rat_t::nr,
+                    PDCP_RB_IS_DRB,
+                    PDCP_SN_LEN_18,
+                    CIPHERING_ALGORITHM_ID_128_EEA2,
+                    INTEGRITY_ALGORITHM_ID_128_EIA2,
+                    reorder_window,
+                    pdcp_discard_timer_t::ms100,
+                    sdu_len,
+                    nof_sdus});
+  }
+  return list;
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  fmt::print("Note: cycles are given by the CPU timestamp counter (ns if not available)\n");
+  fmt::print("run | RAT |  RB | SN | algos     | ooo win | discard | SDU/s      | TX cycles/B | RX cycles/B | pool "
+             "[MB] | RSS [MB]\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data&   r   = run_results[i];
+    const run_params& p   = r.params;
+    bool              lte = p.rat == srsran_rat_t::lte;
+    fmt::print("{:>3d} | {:>3} | {:>3} | {:>2d} | {}/{} | {:>7d} | {:>7} | {:>10.0f} | {:>11.2f} | {:>11.2f} | "
+               "{:>9.1f} | {:>8.1f}\n",
+               i,
+               lte ? "LTE" : "NR",
+               p.rb_type == PDCP_RB_IS_SRB ? "SRB" : "DRB",
+               p.sn_len,
+               lte ? ciphering_algorithm_id_text[p.cipher_algo] : ciphering_algorithm_id_nr_text[p.cipher_algo],
+               lte ? integrity_algorithm_id_text[p.integ_algo] : integrity_algorithm_id_nr_text[p.integ_algo],
+               p.reorder_window,
+               p.discard_timer == pdcp_discard_timer_t::infinity ? "inf" : std::to_string((int)p.discard_timer),
+               r.sdus_per_sec,
+               r.tx_cycles_per_byte,
+               r.rx_cycles_per_byte,
+               r.pool_mem_mbytes,
+               r.max_rss_mbytes);
+  }
+}
+
+int run_all(uint32_t nof_sdus)
+{
+  std::vector<run_data> run_results;
+  for (const run_params& params : get_run_param_list(nof_sdus)) {
+    TESTASSERT(run_benchmark_scenario(params, run_results) == SRSRAN_SUCCESS);
+  }
+  print_benchmark_results(run_results);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main(int argc, char* argv[])
+{
+  srslog::fetch_basic_logger("PDCP", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  if (argc == 1 or strcmp(argv[1], "test") == 0) {
+    TESTASSERT(srsran::run_all(2000) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark") == 0) {
+    TESTASSERT(srsran::run_all(200000) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
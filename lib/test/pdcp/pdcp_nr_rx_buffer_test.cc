@@ -0,0 +1,216 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/upper/pdcp_nr_rx_buffer.h"
+
+using srsran::pdcp_nr_rx_buffer;
+using srsran::unique_byte_buffer_t;
+
+// PDUs carry their COUNT, so that the test can check which PDU is returned
+unique_byte_buffer_t make_pdu(uint32_t count)
+{
+  unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  srsran_assert(pdu != nullptr, "Out of buffers");
+  memcpy(pdu->msg, &count, sizeof(count));
+  pdu->N_bytes = sizeof(count);
+  return pdu;
+}
+
+uint32_t pdu_count(const unique_byte_buffer_t& pdu)
+{
+  uint32_t count = 0;
+  memcpy(&count, pdu->msg, sizeof(count));
+  return count;
+}
+
+/// Checks that pop_range() returns every PDU of [from, end) in ascending order of COUNT, and that these are "nof_pdus"
+int test_pop_range(pdcp_nr_rx_buffer& buffer, uint32_t from, uint32_t end, uint32_t nof_pdus)
+{
+  uint32_t nof_popped = 0;
+  uint32_t last_count = from;
+  buffer.pop_range(from, end, [&](uint32_t count, unique_byte_buffer_t pdu) {
+    TESTASSERT(pdu != nullptr);
+    TESTASSERT_EQ(count, pdu_count(pdu));
+    TESTASSERT(count - from < end - from);
+    TESTASSERT(nof_popped == 0 or count - from > last_count - from);
+    last_count = count;
+    nof_popped++;
+  });
+  TESTASSERT_EQ(nof_pdus, nof_popped);
+  return SRSRAN_SUCCESS;
+}
+
+int test_in_sequence_run()
+{
+  pdcp_nr_rx_buffer buffer;
+  const uint32_t    base = 0;
+
+  // COUNTs [0, 100) except 70, spanning two bitmap words
+  for (uint32_t count = base; count < base + 100; ++count) {
+    if (count != 70) {
+      TESTASSERT(buffer.add(base, count, make_pdu(count)));
+    }
+  }
+  TESTASSERT_EQ(99, buffer.size());
+  TESTASSERT_EQ(70, buffer.find_first_missing(base, 100));
+  TESTASSERT_EQ(60, buffer.find_first_missing(base, 60));
+  TESTASSERT_EQ(100, buffer.find_first_missing(71, 100));
+
+  // The in-sequence run is popped in one pass
+  TESTASSERT(test_pop_range(buffer, base, 70, 70) == SRSRAN_SUCCESS);
+  TESTASSERT_EQ(29, buffer.size());
+  TESTASSERT(not buffer.has_count(70, 69));
+  TESTASSERT(buffer.has_count(70, 71));
+
+  // Missing COUNTs in the range are skipped
+  TESTASSERT(test_pop_range(buffer, 70, 100, 29) == SRSRAN_SUCCESS);
+  TESTASSERT(buffer.empty());
+  return SRSRAN_SUCCESS;
+}
+
+int test_duplicates()
+{
+  pdcp_nr_rx_buffer buffer;
+  const uint32_t    base = 10;
+
+  TESTASSERT(not buffer.has_count(base, 12));
+  TESTASSERT(buffer.add(base, 12, make_pdu(12)));
+  TESTASSERT(buffer.has_count(base, 12));
+  TESTASSERT(not buffer.has_count(base, 11));
+  TESTASSERT(not buffer.has_count(base, 13));
+
+  // A COUNT one ring turn away maps to the same slot, but lies outside of the window
+  TESTASSERT(not buffer.has_count(base, 12 + buffer.capacity()));
+
+  unique_byte_buffer_t pdu = buffer.pop(12);
+  TESTASSERT_EQ(12, pdu_count(pdu));
+  TESTASSERT(not buffer.has_count(base, 12));
+  TESTASSERT(buffer.empty());
+
+  // The slot can be used again
+  TESTASSERT(buffer.add(base, 12, make_pdu(12)));
+  TESTASSERT_EQ(1, buffer.size());
+  return SRSRAN_SUCCESS;
+}
+
+int test_count_wraparound()
+{
+  pdcp_nr_rx_buffer buffer;
+  const uint32_t    base = 0xffffff80;
+  const uint32_t    lost = 5; // COUNT received after the run
+
+  // COUNTs [base, base + 256) wrap around 2^32 at the middle of the ring
+  for (uint32_t i = 0; i < buffer.capacity(); ++i) {
+    uint32_t count = base + i;
+    if (count != lost) {
+      TESTASSERT(buffer.add(base, count, make_pdu(count)));
+    }
+  }
+  const uint32_t end = base + buffer.capacity();
+  TESTASSERT(buffer.has_count(base, 0xffffffff));
+  TESTASSERT(buffer.has_count(base, 0));
+  TESTASSERT_EQ(lost, buffer.find_first_missing(base, end));
+
+  // The run is popped in ascending order of COUNT, across the wraparound
+  TESTASSERT(test_pop_range(buffer, base, lost, lost - base) == SRSRAN_SUCCESS);
+  TESTASSERT(buffer.add(lost, lost, make_pdu(lost)));
+  TESTASSERT_EQ(end, buffer.find_first_missing(lost, end));
+  TESTASSERT(test_pop_range(buffer, lost, end, end - lost) == SRSRAN_SUCCESS);
+  TESTASSERT(buffer.empty());
+  return SRSRAN_SUCCESS;
+}
+
+int test_ring_growth()
+{
+  pdcp_nr_rx_buffer buffer;
+  buffer.set_max_capacity(4096);
+  const uint32_t initial_capacity = buffer.capacity();
+
+  // The stored PDUs are re-indexed when the ring grows, also when the window wraps around 2^32
+  const uint32_t              base   = 0xffffff80;
+  const std::vector<uint32_t> counts = {base, base + 3, base + 200, 7, base + initial_capacity - 1};
+  for (uint32_t count : counts) {
+    TESTASSERT(buffer.add(base, count, make_pdu(count)));
+  }
+  TESTASSERT_EQ(initial_capacity, buffer.capacity());
+
+  // A COUNT beyond the ring doubles it as many times as needed
+  const uint32_t far_count = base + 3 * initial_capacity;
+  TESTASSERT(buffer.add(base, far_count, make_pdu(far_count)));
+  TESTASSERT_EQ(4 * initial_capacity, buffer.capacity());
+  TESTASSERT_EQ(counts.size() + 1, buffer.size());
+  for (uint32_t count : counts) {
+    TESTASSERT(buffer.has_count(base, count));
+  }
+  TESTASSERT(buffer.has_count(base, far_count));
+  TESTASSERT(not buffer.has_count(base, base + 1));
+  TESTASSERT_EQ(base + 1, buffer.find_first_missing(base, far_count + 1));
+  TESTASSERT_EQ(far_count + 1, buffer.find_first_missing(far_count, far_count + 1));
+
+  TESTASSERT(test_pop_range(buffer, base, far_count + 1, counts.size() + 1) == SRSRAN_SUCCESS);
+  TESTASSERT(buffer.empty());
+
+  // The ring goes back to its initial size once cleared
+  buffer.clear();
+  TESTASSERT_EQ(initial_capacity, buffer.capacity());
+  return SRSRAN_SUCCESS;
+}
+
+int test_out_of_window()
+{
+  pdcp_nr_rx_buffer buffer;
+  buffer.set_max_capacity(1024);
+  const uint32_t base = 5000;
+
+  // COUNTs at or beyond the window size from the base are dropped, and so are those below the base
+  TESTASSERT(not buffer.add(base, base + 1024, make_pdu(base + 1024)));
+  TESTASSERT(not buffer.add(base, base - 1, make_pdu(base - 1)));
+  TESTASSERT(buffer.empty());
+  TESTASSERT(not buffer.has_count(base, base + 1024));
+  TESTASSERT(not buffer.has_count(base, base - 1));
+
+  // The last COUNT of the window is accepted
+  TESTASSERT(buffer.add(base, base + 1023, make_pdu(base + 1023)));
+  TESTASSERT_EQ(1024, buffer.capacity());
+  TESTASSERT(buffer.has_count(base, base + 1023));
+
+  // Ranges longer than the ring are limited to one ring turn
+  TESTASSERT_EQ(base, buffer.find_first_missing(base, base + 10000));
+  TESTASSERT_EQ(base + 1024, buffer.find_first_missing(base + 1023, base + 10000));
+  TESTASSERT(test_pop_range(buffer, base, base + 10000, 1) == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(test_in_sequence_run() == SRSRAN_SUCCESS);
+  TESTASSERT(test_duplicates() == SRSRAN_SUCCESS);
+  TESTASSERT(test_count_wraparound() == SRSRAN_SUCCESS);
+  TESTASSERT(test_ring_growth() == SRSRAN_SUCCESS);
+  TESTASSERT(test_out_of_window() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -19,7 +19,9 @@
  *
  */
 #include "pdcp_nr_test.h"
+#include <chrono>
 #include <numeric>
+#include <random>
 
 /*
  * Generic class to test reception of in-sequence packets
@@ -270,6 +272,24 @@ int test_rx_all(srslog::basic_logger& logger)
     test8_pdus.push_back(std::move(event_pdu2));
     TESTASSERT(rx_helper.test_rx(std::move(test8_pdus), test8_init_state, 1, tst_sdu1) == 0);
   }
+
+  /*
+   * RX Test 9: PDCP Entity with SN LEN = 18
+   * Test reception of a block of PDUs in reverse order, with COUNT [15,0].
+   * The whole block is passed to the GW in a single batch once COUNT 0 is received.
+   */
+  {
+    srsran::test_delimit_logger delimiter("RX reversed COUNTs [15,0], 18 bit SN");
+    test_rx_helper              rx_helper(srsran::PDCP_SN_LEN_18, logger);
+    std::vector<uint32_t>       test9_counts(16);
+    std::iota(test9_counts.rbegin(), test9_counts.rend(), 0);
+    std::vector<pdcp_test_event_t> test9_pdus =
+        gen_expected_pdus_vector(tst_sdu1, test9_counts, srsran::PDCP_SN_LEN_18, sec_cfg, logger);
+    pdcp_initial_state test9_init_state = {};
+    TESTASSERT(rx_helper.test_rx(std::move(test9_pdus), test9_init_state, 16, tst_sdu1) == 0);
+    TESTASSERT_EQ(1, rx_helper.gw_rx.nof_batches);
+    TESTASSERT(rx_helper.pdcp_rx.get_rx_deliv() == 16);
+  }
   return 0;
 }
 
@@ -285,7 +305,139 @@ int run_all_tests()
   return 0;
 }
 
-int main()
+/*
+ * RX benchmark: reordering-heavy delivery patterns, as seen with multiple paths, dual connectivity or HARQ reordering.
+ * PDUs are generated by a TX entity and each block of "block_size" PDUs is permuted before reaching the RX entity.
+ */
+struct reordering_scenario_t {
+  const char* name;
+  uint32_t    block_size;
+  float       loss_rate;
+  std::function<void(std::vector<srsran::unique_byte_buffer_t>&, std::mt19937&)> permute;
+};
+
+double run_reordering_benchmark(const reordering_scenario_t& scenario,
+                                uint8_t                      sn_len,
+                                uint32_t                     nof_pdus,
+                                srslog::basic_logger&        logger)
+{
+  const uint32_t sdu_len        = 1500;
+  const uint32_t pdus_per_tick  = 8;
+  const uint32_t t_reordering   = static_cast<uint32_t>(srsran::pdcp_t_reordering_t::ms50);
+  const uint32_t nof_tail_ticks = 2 * t_reordering;
+
+  pdcp_nr_test_helper tx_hlp({1,
+                              srsran::PDCP_RB_IS_DRB,
+                              srsran::SECURITY_DIRECTION_UPLINK,
+                              srsran::SECURITY_DIRECTION_DOWNLINK,
+                              sn_len,
+                              srsran::pdcp_t_reordering_t::ms50,
+                              srsran::pdcp_discard_timer_t::infinity,
+                              false,
+                              srsran::srsran_rat_t::nr},
+                             sec_cfg,
+                             logger);
+  pdcp_nr_test_helper rx_hlp({1,
+                              srsran::PDCP_RB_IS_DRB,
+                              srsran::SECURITY_DIRECTION_DOWNLINK,
+                              srsran::SECURITY_DIRECTION_UPLINK,
+                              sn_len,
+                              srsran::pdcp_t_reordering_t::ms50,
+                              srsran::pdcp_discard_timer_t::infinity,
+                              false,
+                              srsran::srsran_rat_t::nr},
+                             sec_cfg,
+                             logger);
+
+  std::mt19937                              rand_gen(sn_len);
+  std::uniform_real_distribution<float>     loss_dist(0.0, 1.0);
+  std::vector<srsran::unique_byte_buffer_t> block;
+  std::chrono::nanoseconds                  rx_time{0};
+  uint32_t                                  nof_lost = 0, nof_written = 0;
+  for (uint32_t count = 0; count < nof_pdus; count += scenario.block_size) {
+    // Generate the PDUs of the block
+    block.clear();
+    for (uint32_t i = 0; i < std::min(scenario.block_size, nof_pdus - count); ++i) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      TESTASSERT(sdu != nullptr);
+      memset(sdu->msg, i & 0xffU, sdu_len);
+      sdu->N_bytes = sdu_len;
+      tx_hlp.pdcp.write_sdu(std::move(sdu));
+      if (loss_dist(rand_gen) < scenario.loss_rate) {
+        nof_lost++;
+        continue;
+      }
+      srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+      TESTASSERT(pdu != nullptr);
+      tx_hlp.rlc.get_last_sdu(pdu);
+      block.push_back(std::move(pdu));
+    }
+    scenario.permute(block, rand_gen);
+
+    auto tp = std::chrono::steady_clock::now();
+    for (srsran::unique_byte_buffer_t& pdu : block) {
+      rx_hlp.pdcp.write_pdu(std::move(pdu));
+      if (++nof_written % pdus_per_tick == 0) {
+        rx_hlp.stack.run_tti();
+      }
+    }
+    rx_time += std::chrono::steady_clock::now() - tp;
+  }
+  // Let t-Reordering expire for the last losses
+  for (uint32_t i = 0; i < nof_tail_ticks; ++i) {
+    rx_hlp.stack.run_tti();
+  }
+
+  TESTASSERT_EQ(nof_pdus - nof_lost, rx_hlp.gw.rx_count);
+  TESTASSERT(not rx_hlp.pdcp.is_reordering_timer_running());
+  return (nof_pdus - nof_lost) / std::chrono::duration<double>(rx_time).count();
+}
+
+int run_reordering_benchmarks(uint32_t nof_pdus)
+{
+  auto& logger = srslog::fetch_basic_logger("PDCP NR RX BENCH", false);
+  logger.set_level(srslog::basic_levels::warning);
+
+  std::vector<reordering_scenario_t> scenarios = {
+      {"in-order", 64, 0, [](std::vector<srsran::unique_byte_buffer_t>& b, std::mt19937& g) {}},
+      {"reversed blocks of 64",
+       64,
+       0,
+       [](std::vector<srsran::unique_byte_buffer_t>& b, std::mt19937& g) { std::reverse(b.begin(), b.end()); }},
+      {"shuffled window of 256",
+       256,
+       0,
+       [](std::vector<srsran::unique_byte_buffer_t>& b, std::mt19937& g) { std::shuffle(b.begin(), b.end(), g); }},
+      {"two legs, 128 PDU skew",
+       256,
+       0,
+       [](std::vector<srsran::unique_byte_buffer_t>& b, std::mt19937& g) {
+         // Even positions are sent through the fast leg, odd positions arrive later through the slow one
+         std::vector<srsran::unique_byte_buffer_t> legs;
+         for (size_t i = 0; i < b.size(); i += 2) {
+           legs.push_back(std::move(b[i]));
+         }
+         for (size_t i = 1; i < b.size(); i += 2) {
+           legs.push_back(std::move(b[i]));
+         }
+         b.swap(legs);
+       }},
+      {"shuffled window of 64, 1% loss",
+       64,
+       0.01,
+       [](std::vector<srsran::unique_byte_buffer_t>& b, std::mt19937& g) { std::shuffle(b.begin(), b.end(), g); }}};
+
+  fmt::print("PDCP NR RX reordering benchmark ({} PDUs)\n", nof_pdus);
+  fmt::print("{:<32} | SN12 [kPDU/s] | SN18 [kPDU/s]\n", "Scenario");
+  for (const reordering_scenario_t& scenario : scenarios) {
+    double rate12 = run_reordering_benchmark(scenario, srsran::PDCP_SN_LEN_12, nof_pdus, logger);
+    double rate18 = run_reordering_benchmark(scenario, srsran::PDCP_SN_LEN_18, nof_pdus, logger);
+    fmt::print("{:<32} | {:>13.1f} | {:>13.1f}\n", scenario.name, rate12 / 1e3, rate18 / 1e3);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
 {
   srslog::init();
 
@@ -293,5 +445,12 @@ int main()
     fprintf(stderr, "pdcp_nr_tests_rx() failed\n");
     return SRSRAN_ERROR;
   }
+
+  // Use "benchmark" argument for longer runs
+  bool long_run = argc > 1 and strcmp(argv[1], "benchmark") == 0;
+  if (run_reordering_benchmarks(long_run ? 1000000 : 10000) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "pdcp_nr_tests_rx() benchmark failed\n");
+    return SRSRAN_ERROR;
+  }
   return SRSRAN_SUCCESS;
 }
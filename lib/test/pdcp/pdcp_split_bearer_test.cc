@@ -0,0 +1,298 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/test/ue_test_interfaces.h"
+#include "srsran/upper/pdcp_entity_nr.h"
+#include <algorithm>
+#include <deque>
+
+/**
+ * Split bearer test and throughput benchmark. The DL SDUs of a gNB NR PDCP entity are distributed over two emulated
+ * RLC legs (NR and LTE radio links of an EN-DC UE) with different throughput and latency, and reordered by the NR PDCP
+ * entity of the UE. The emulation runs in TTI steps, so that the results do not depend on the host load.
+ *
+ * Usage: pdcp_split_bearer_test [test|benchmark]
+ */
+
+namespace srsran {
+
+const uint32_t sdu_len  = 1500;
+const uint32_t drb_lcid = 4;
+
+/// RLC leg with a given throughput and latency. The UE side of the link is the peer NR PDCP entity
+class emulated_rlc_leg : public srsue::rlc_interface_pdcp
+{
+public:
+  emulated_rlc_leg(uint32_t rate_bytes_per_ms_, uint32_t latency_ms_) :
+    rate_bytes_per_ms(rate_bytes_per_ms_), latency_ms(latency_ms_)
+  {}
+
+  void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu) final
+  {
+    buffered_bytes += sdu->N_bytes;
+    tx_queue.push_back(std::move(sdu));
+  }
+
+  void     discard_sdu(uint32_t lcid, uint32_t discard_sn) final {}
+  bool     rb_is_um(uint32_t lcid) final { return false; }
+  bool     sdu_queue_is_full(uint32_t lcid) final { return tx_queue.size() >= max_queued_sdus; }
+  bool     is_suspended(uint32_t lcid) final { return false; }
+  uint32_t get_buffer_state(uint32_t lcid) final { return buffered_bytes; }
+
+  /// Transmits one TTI worth of data and delivers the PDUs whose latency has elapsed to the UE
+  void run_tti(uint32_t tti, pdcp_entity_nr& ue_pdcp)
+  {
+    credit_bytes += rate_bytes_per_ms;
+    while (not tx_queue.empty() and tx_queue.front()->N_bytes <= credit_bytes) {
+      credit_bytes -= tx_queue.front()->N_bytes;
+      buffered_bytes -= tx_queue.front()->N_bytes;
+      in_flight.emplace_back(tti + latency_ms, std::move(tx_queue.front()));
+      tx_queue.pop_front();
+      nof_tx_pdus++;
+    }
+    if (tx_queue.empty()) {
+      // Unused radio resources are lost
+      credit_bytes = 0;
+    }
+    while (not in_flight.empty() and in_flight.front().first <= tti) {
+      ue_pdcp.write_pdu(std::move(in_flight.front().second));
+      in_flight.pop_front();
+    }
+  }
+
+  uint32_t rate_bytes_per_ms;
+  uint32_t latency_ms;
+  uint32_t max_queued_sdus = 1024;
+  uint64_t nof_tx_pdus     = 0;
+
+private:
+  std::deque<unique_byte_buffer_t>                      tx_queue;
+  std::deque<std::pair<uint32_t, unique_byte_buffer_t> > in_flight;
+  uint32_t                                              buffered_bytes = 0;
+  uint32_t                                              credit_bytes   = 0;
+};
+
+/// UE IP sink, which checks that SDUs are delivered in order and records their latency
+class ue_gw_sink : public srsue::gw_interface_pdcp, public srsue::rrc_interface_pdcp
+{
+public:
+  // GW interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t pdu) final
+  {
+    uint32_t sn, tx_tti;
+    memcpy(&sn, pdu->msg, sizeof(sn));
+    memcpy(&tx_tti, pdu->msg + sizeof(sn), sizeof(tx_tti));
+    nof_order_errors += (nof_sdus > 0 and sn <= last_sn) ? 1 : 0;
+    last_sn = sn;
+    nof_sdus++;
+    nof_bytes += pdu->N_bytes;
+    latency_sum_ms += cur_tti - tx_tti;
+    max_latency_ms = std::max(max_latency_ms, cur_tti - tx_tti);
+  }
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t pdu) final {}
+
+  // RRC interface
+  void        write_pdu_bcch_bch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_bcch_dlsch(unique_byte_buffer_t pdu) final {}
+  void        write_pdu_pcch(unique_byte_buffer_t pdu) final {}
+  void        notify_pdcp_integrity_error(uint32_t lcid) final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+
+  uint32_t cur_tti          = 0;
+  uint32_t last_sn          = 0;
+  uint64_t nof_sdus         = 0;
+  uint64_t nof_bytes        = 0;
+  uint64_t nof_order_errors = 0;
+  uint64_t latency_sum_ms   = 0;
+  uint32_t max_latency_ms   = 0;
+};
+
+struct scenario_t {
+  const char* name;
+  bool        split;
+  uint32_t    offered_mbps;
+  uint32_t    split_threshold_bytes;
+  /// Factor applied to the NR leg throughput in the second half of the run (e.g. to emulate a blockage)
+  float nr_rate_factor_second_half;
+};
+
+struct scenario_result_t {
+  double   dl_mbps            = 0;
+  double   secondary_share    = 0;
+  double   avg_latency_ms     = 0;
+  uint32_t max_latency_ms     = 0;
+  uint64_t nof_dropped_sdus   = 0;
+  uint64_t nof_order_errors   = 0;
+  uint32_t nof_reordered_pdus = 0;
+  uint32_t nof_lost_pdus      = 0;
+};
+
+// NR leg of 200 Mbps, and LTE leg of 75 Mbps with the additional X2 latency
+const uint32_t nr_rate_bytes_per_ms  = 25000;
+const uint32_t nr_latency_ms         = 2;
+const uint32_t lte_rate_bytes_per_ms = 9375;
+const uint32_t lte_latency_ms        = 10;
+
+scenario_result_t run_scenario(const scenario_t& sc, uint32_t duration_ms)
+{
+  srslog::basic_logger&   logger = srslog::fetch_basic_logger("PDCP", false);
+  srsue::stack_test_dummy stack;
+  emulated_rlc_leg        nr_leg(nr_rate_bytes_per_ms, nr_latency_ms);
+  emulated_rlc_leg        lte_leg(lte_rate_bytes_per_ms, lte_latency_ms);
+  ue_gw_sink              ue_sink;
+
+  pdcp_config_t gnb_cfg(1,
+                        PDCP_RB_IS_DRB,
+                        SECURITY_DIRECTION_DOWNLINK,
+                        SECURITY_DIRECTION_UPLINK,
+                        PDCP_SN_LEN_18,
+                        pdcp_t_reordering_t::ms100,
+                        pdcp_discard_timer_t::infinity,
+                        false,
+                        srsran_rat_t::nr);
+  pdcp_config_t ue_cfg(1,
+                       PDCP_RB_IS_DRB,
+                       SECURITY_DIRECTION_UPLINK,
+                       SECURITY_DIRECTION_DOWNLINK,
+                       PDCP_SN_LEN_18,
+                       pdcp_t_reordering_t::ms100,
+                       pdcp_discard_timer_t::infinity,
+                       false,
+                       srsran_rat_t::nr);
+
+  // The UL is not exercised, so the UE entity can share the NR leg
+  pdcp_entity_nr gnb_pdcp(&nr_leg, &ue_sink, &ue_sink, &stack.task_sched, logger, drb_lcid);
+  pdcp_entity_nr ue_pdcp(&nr_leg, &ue_sink, &ue_sink, &stack.task_sched, logger, drb_lcid);
+  TESTASSERT(gnb_pdcp.configure(gnb_cfg));
+  TESTASSERT(ue_pdcp.configure(ue_cfg));
+  if (sc.split) {
+    pdcp_split_bearer_cfg_t split_cfg;
+    split_cfg.split_threshold_bytes = sc.split_threshold_bytes;
+    split_cfg.max_leg_delay_ms      = 20;
+    TESTASSERT(gnb_pdcp.add_split_bearer_leg(&lte_leg, drb_lcid, split_cfg));
+  }
+
+  double   sdus_per_ms      = sc.offered_mbps * 1e3 / 8 / sdu_len, sdu_acc = 0;
+  uint32_t sn               = 0;
+  uint64_t nof_dropped_sdus = 0;
+  for (uint32_t tti = 0; tti < duration_ms; ++tti) {
+    if (tti == duration_ms / 2) {
+      nr_leg.rate_bytes_per_ms = nr_rate_bytes_per_ms * sc.nr_rate_factor_second_half;
+    }
+    ue_sink.cur_tti = tti;
+
+    // DL traffic from the core network
+    for (sdu_acc += sdus_per_ms; sdu_acc >= 1; sdu_acc -= 1) {
+      unique_byte_buffer_t sdu = make_byte_buffer();
+      if (sdu == nullptr) {
+        nof_dropped_sdus++;
+        continue;
+      }
+      memcpy(sdu->msg, &sn, sizeof(sn));
+      memcpy(sdu->msg + sizeof(sn), &tti, sizeof(tti));
+      sdu->N_bytes = sdu_len;
+      sn++;
+      gnb_pdcp.write_sdu(std::move(sdu));
+    }
+
+    nr_leg.run_tti(tti, ue_pdcp);
+    lte_leg.run_tti(tti, ue_pdcp);
+    stack.task_sched.tic();
+  }
+
+  pdcp_bearer_metrics_t gnb_metrics = gnb_pdcp.get_metrics();
+  pdcp_bearer_metrics_t ue_metrics  = ue_pdcp.get_metrics();
+  uint64_t              nof_tx_pdus = nr_leg.nof_tx_pdus + lte_leg.nof_tx_pdus;
+  scenario_result_t     ret;
+  ret.dl_mbps            = ue_sink.nof_bytes * 8 / (duration_ms * 1e3);
+  ret.secondary_share    = (double)lte_leg.nof_tx_pdus / std::max(nof_tx_pdus, (uint64_t)1);
+  ret.avg_latency_ms     = (double)ue_sink.latency_sum_ms / std::max(ue_sink.nof_sdus, (uint64_t)1);
+  ret.max_latency_ms     = ue_sink.max_latency_ms;
+  ret.nof_dropped_sdus   = nof_dropped_sdus + (sn - gnb_metrics.num_tx_pdus);
+  ret.nof_order_errors   = ue_sink.nof_order_errors;
+  ret.nof_reordered_pdus = ue_metrics.num_rx_reordered_pdus;
+  ret.nof_lost_pdus      = ue_metrics.num_rx_lost_pdus;
+  return ret;
+}
+
+int run_all(uint32_t duration_ms)
+{
+  const scenario_t scenarios[] = {
+      {"NR leg only", false, 400, 0, 1.0},
+      {"split", true, 400, 0, 1.0},
+      {"split, NR blockage", true, 400, 0, 0.25},
+      {"split, low load", true, 100, 100000, 1.0},
+  };
+
+  fmt::print("NR leg: {} Mbps, {} ms. LTE leg: {} Mbps, {} ms. SDU size: {} B\n",
+             nr_rate_bytes_per_ms * 8 / 1000,
+             nr_latency_ms,
+             lte_rate_bytes_per_ms * 8 / 1000,
+             lte_latency_ms,
+             sdu_len);
+  fmt::print("{:>20} | offered [Mbps] | DL [Mbps] | LTE share | avg/max latency [ms] | dropped | reordered | lost\n",
+             "scenario");
+
+  std::vector<scenario_result_t> results;
+  for (const scenario_t& sc : scenarios) {
+    scenario_result_t res = run_scenario(sc, duration_ms);
+    fmt::print("{:>20} | {:>14} | {:>9.1f} | {:>8.1f}% | {:>12.1f} / {:>5} | {:>7} | {:>9} | {:>4}\n",
+               sc.name,
+               sc.offered_mbps,
+               res.dl_mbps,
+               res.secondary_share * 100,
+               res.avg_latency_ms,
+               res.max_latency_ms,
+               res.nof_dropped_sdus,
+               res.nof_reordered_pdus,
+               res.nof_lost_pdus);
+
+    // The PDCP of the UE delivers in order, and no PDU gets stuck in the slower leg beyond t-Reordering
+    TESTASSERT(res.nof_order_errors == 0);
+    TESTASSERT(res.nof_lost_pdus == 0);
+    results.push_back(res);
+  }
+
+  // Both legs are used under high load, while the NR leg alone carries the traffic under the split threshold
+  TESTASSERT(results[1].dl_mbps > results[0].dl_mbps * 1.25);
+  TESTASSERT(results[2].secondary_share > results[1].secondary_share);
+  TESTASSERT(results[3].secondary_share < 0.01);
+  TESTASSERT(results[3].nof_dropped_sdus == 0);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+int main(int argc, char* argv[])
+{
+  srslog::fetch_basic_logger("PDCP", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  if (argc == 1 or strcmp(argv[1], "test") == 0) {
+    TESTASSERT(srsran::run_all(2000) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark") == 0) {
+    TESTASSERT(srsran::run_all(60000) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -45,6 +45,8 @@ static uint32_t mcs                     = 20;
 static int      cross_carrier_indicator = -1;
 static bool     enable_256qam           = false;
 static float    snr_db                  = NAN; // SNR in dB
+static uint32_t nof_empty_sf            = 0;   // Empty subframes after each scheduled subframe
+static int      p_b                     = -1;  // Power allocation p_b, overrides the default of the transmission mode
 
 void usage(char* prog)
 {
@@ -58,6 +60,8 @@ void usage(char* prog)
   printf("\t-t Transmission mode: 1,2,3,4 [Default %d]\n", transmission_mode + 1);
   printf("\t-m mcs [Default %d]\n", mcs);
   printf("\t-S SNR in dB [Default %+.2f]\n", snr_db);
+  printf("\t-e number of empty subframes after each scheduled subframe [Default %d]\n", nof_empty_sf);
+  printf("\t-b p_b (0..3), also checks the eNb signal with p_b applied once per subframe [Default by TM]\n");
   printf("\tAdvanced parameters:\n");
   if (cross_carrier_indicator >= 0) {
     printf("\t\t-a carrier-indicator [Default %d]\n", cross_carrier_indicator);
@@ -96,7 +100,7 @@ void parse_args(int argc, char** argv)
     nof_rx_ant     = 2;
   }
 
-  while ((opt = getopt(argc, argv, "cfapndvqstmES")) != -1) {
+  while ((opt = getopt(argc, argv, "cfapndvqstmESeb")) != -1) {
     switch (opt) {
       case 't':
         transmission_mode = (uint32_t)strtol(argv[optind], NULL, 10) - 1;
@@ -126,6 +130,12 @@ void parse_args(int argc, char** argv)
       case 'S':
         snr_db = strtof(argv[optind], NULL);
         break;
+      case 'e':
+        nof_empty_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        p_b = (int)strtol(argv[optind], NULL, 10);
+        break;
       case 'E':
         cell.cp = ((uint32_t)strtol(argv[optind], NULL, 10)) ? SRSRAN_CP_EXT : SRSRAN_CP_NORM;
         break;
@@ -149,12 +159,23 @@ void parse_args(int argc, char** argv)
   }
 }
 
+static uint32_t get_p_b()
+{
+  if (p_b >= 0) {
+    return (uint32_t)p_b;
+  }
+  return (transmission_mode > SRSRAN_TM1) ? 1 : 0; // 0 dB
+}
+
+/* Runs the eNb for one subframe. If rho_b_once is set, the power allocation (p_b) is applied to the subframe before
+ * mapping the PDSCH, as the eNb PHY does for all the PDSCH of a subframe, instead of by srsran_pdsch_encode() */
 int work_enb(srsran_enb_dl_t*         enb_dl,
              srsran_dl_sf_cfg_t*      dl_sf,
              srsran_dci_cfg_t*        dci_cfg,
              srsran_dci_dl_t*         dci,
              srsran_softbuffer_tx_t** softbuffer_tx,
-             uint8_t**                data_tx)
+             uint8_t**                data_tx,
+             bool                     rho_b_once)
 {
   int ret = SRSRAN_ERROR;
 
@@ -165,7 +186,7 @@ int work_enb(srsran_enb_dl_t*         enb_dl,
   }
 
   // Create pdsch config
-  srsran_pdsch_cfg_t pdsch_cfg;
+  srsran_pdsch_cfg_t pdsch_cfg = {};
   if (srsran_ra_dl_dci_to_grant(&cell, dl_sf, transmission_mode, enable_256qam, dci, &pdsch_cfg.grant)) {
     ERROR("Computing DL grant sf_idx=%d", dl_sf->tti);
     goto quit;
@@ -181,10 +202,15 @@ int work_enb(srsran_enb_dl_t*         enb_dl,
   // Enable power allocation
   pdsch_cfg.power_scale  = true;
   pdsch_cfg.p_a          = 0.0f;                                     // 0 dB
-  pdsch_cfg.p_b          = (transmission_mode > SRSRAN_TM1) ? 1 : 0; // 0 dB
+  pdsch_cfg.p_b          = get_p_b();
   pdsch_cfg.rnti         = rnti;
   pdsch_cfg.meas_time_en = false;
 
+  if (rho_b_once) {
+    srsran_pdsch_apply_rho_b(&enb_dl->pdsch, &pdsch_cfg, enb_dl->sf_symbols);
+    pdsch_cfg.rho_b_applied = true;
+  }
+
   if (srsran_enb_dl_put_pdsch(enb_dl, &pdsch_cfg, data_tx) < 0) {
     ERROR("Error putting PDSCH sf_idx=%d", dl_sf->tti);
     goto quit;
@@ -330,6 +356,7 @@ int main(int argc, char** argv)
   uint32_t                count_failures = 0, count_tbs = 0;
   size_t                  pdsch_decode_us = 0;
   size_t                  pdsch_encode_us = 0;
+  size_t                  empty_sf_us     = 0;
   srsran_channel_awgn_t   awgn            = {};
   float                   snr_db_avg      = 0.0;
 
@@ -338,6 +365,7 @@ int main(int argc, char** argv)
   parse_args(argc, argv);
 
   cf_t* signal_buffer[SRSRAN_MAX_PORTS] = {NULL};
+  cf_t* rho_b_signal[SRSRAN_MAX_PORTS]  = {NULL};
 
   /*
    * Allocate Memory
@@ -348,6 +376,13 @@ int main(int argc, char** argv)
       ERROR("Error allocating buffer");
       goto quit;
     }
+    if (p_b >= 0) {
+      rho_b_signal[i] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(cell.nof_prb));
+      if (!rho_b_signal[i]) {
+        ERROR("Error allocating buffer");
+        goto quit;
+      }
+    }
   }
 
   if (srsran_channel_awgn_init(&awgn, 0x1234) < SRSRAN_SUCCESS) {
@@ -558,13 +593,29 @@ int main(int argc, char** argv)
     INFO("--- Process eNb ---");
 
     gettimeofday(&t[1], NULL);
-    if (work_enb(enb_dl, &sf_cfg_dl, &dci_cfg, &dci, softbuffer_tx, data_tx)) {
+    if (work_enb(enb_dl, &sf_cfg_dl, &dci_cfg, &dci, softbuffer_tx, data_tx, false)) {
       goto quit;
     }
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
     pdsch_encode_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
 
+    // The signal must not change if p_b is applied once per subframe instead of by the PDSCH encoder
+    if (p_b >= 0) {
+      for (int i = 0; i < cell.nof_ports; i++) {
+        srsran_vec_cf_copy(rho_b_signal[i], signal_buffer[i], SRSRAN_SF_LEN_PRB(cell.nof_prb));
+      }
+      if (work_enb(enb_dl, &sf_cfg_dl, &dci_cfg, &dci, softbuffer_tx, data_tx, true)) {
+        goto quit;
+      }
+      for (int i = 0; i < cell.nof_ports; i++) {
+        if (memcmp(rho_b_signal[i], signal_buffer[i], SRSRAN_SF_LEN_PRB(cell.nof_prb) * sizeof(cf_t)) != 0) {
+          ERROR("eNb signal with p_b applied once differs in sf_idx=%d, port=%d", sf_idx, i);
+          goto quit;
+        }
+      }
+    }
+
     // MIMO perfect crossed channel
     if (transmission_mode > 1) {
       for (int i = 0; i < SRSRAN_SF_LEN_PRB(cell.nof_prb); i++) {
@@ -653,6 +704,21 @@ int main(int argc, char** argv)
         tx_nof_bits += ue_dl_cfg.cfg.pdsch.grant.tb[i].tbs;
       }
     }
+
+    /*
+     * Run eNodeB in empty subframes, only the base signals are transmitted
+     */
+    for (uint32_t i = 0; i < nof_empty_sf; i++) {
+      srsran_dl_sf_cfg_t empty_sf_cfg = sf_cfg_dl;
+      empty_sf_cfg.tti                = (sf_idx + 1 + i) % 10;
+
+      gettimeofday(&t[1], NULL);
+      srsran_enb_dl_put_base(enb_dl, &empty_sf_cfg);
+      srsran_enb_dl_gen_signal(enb_dl);
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      empty_sf_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+    }
   }
 
   printf("Finished! The UE failed decoding %d of %d transport blocks.\n", count_failures, count_tbs);
@@ -671,6 +737,12 @@ int main(int argc, char** argv)
 
   printf("BLER: %5.1f%%\n", (float)count_failures / (float)count_tbs * 100.0f);
 
+  printf("eNb processing time per subframe: %.1f us scheduled", (float)pdsch_encode_us / (float)nof_subframes);
+  if (nof_empty_sf > 0) {
+    printf(", %.1f us empty", (float)empty_sf_us / (float)(nof_subframes * nof_empty_sf));
+  }
+  printf("\n");
+
   if (isnormal(snr_db)) {
     printf("SNR Real: %+.2f; estimated: %+.2f\n", snr_db, snr_db_avg / nof_subframes);
   }
@@ -684,6 +756,9 @@ quit:
     if (signal_buffer[i]) {
       free(signal_buffer[i]);
     }
+    if (rho_b_signal[i]) {
+      free(rho_b_signal[i]);
+    }
   }
 
   for (int i = 0; i < SRSRAN_MAX_TB; i++) {
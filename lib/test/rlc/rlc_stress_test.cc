@@ -39,6 +39,30 @@
 #include "srsran/mac/mac_sch_pdu_nr.h"
 
 static std::unique_ptr<srsran::mac_pcap> pcap_handle = nullptr;
+
+/// Number of heap allocations made by the process, used in benchmark mode to report the allocations per SDU
+static std::atomic<uint64_t> nof_heap_allocs{0};
+
+void* operator new(std::size_t sz)
+{
+  nof_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(sz == 0 ? 1 : sz);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t sz) noexcept
+{
+  std::free(ptr);
+}
+
 /***********************
  * MAC tester class
  ***********************/
@@ -127,8 +151,7 @@ void mac_dummy::run_rx_tti(srsue::rlc_interface_mac*                  tx_rlc,
     srsran::unique_byte_buffer_t& pdu = *it;
 
     // Drop
-    float rnd = real_dist(mt19937);
-    if (std::isnan(rnd) || (((rnd > args.pdu_drop_rate) || skip_action) && pdu->N_bytes > 0)) {
+    if ((not is_pdu_lost(is_dl) || skip_action) && pdu->N_bytes > 0) {
       uint32_t pdu_len = pdu->N_bytes;
 
       // Cut
@@ -164,6 +187,22 @@ void mac_dummy::run_rx_tti(srsue::rlc_interface_mac*                  tx_rlc,
   }
 }
 
+bool mac_dummy::is_pdu_lost(bool is_dl)
+{
+  if (args.loss_pattern == "burst") {
+    // Gilbert-Elliott channel: all PDUs are lost in the bad state. The transition probabilities are derived so that
+    // the average burst length is "loss_burst_len" and the average loss rate is "pdu_drop_rate"
+    bool&  in_burst = in_loss_burst[is_dl ? 0 : 1];
+    float  p_exit   = 1.0f / args.loss_burst_len;
+    float  p_enter  = args.pdu_drop_rate >= 1.0f ? 1.0f : p_exit * args.pdu_drop_rate / (1.0f - args.pdu_drop_rate);
+    float  rnd      = real_dist(mt19937);
+    in_burst        = in_burst ? (rnd >= p_exit) : (rnd < p_enter);
+    return in_burst;
+  }
+  float rnd = real_dist(mt19937);
+  return not std::isnan(rnd) and rnd <= args.pdu_drop_rate;
+}
+
 /***********************
  * RLC tester class
  ***********************/
@@ -171,13 +210,22 @@ void mac_dummy::run_rx_tti(srsue::rlc_interface_mac*                  tx_rlc,
 void rlc_tester::write_pdu(uint32_t rx_lcid, srsran::unique_byte_buffer_t sdu)
 {
   assert(rx_lcid == lcid);
+  uint32_t payload_offset = 0;
+  if (args.benchmark and sdu->N_bytes > bench_sdu_header_len) {
+    int64_t tx_time_ns;
+    memcpy(&tx_time_ns, sdu->msg, sizeof(tx_time_ns));
+    payload_offset = bench_sdu_header_len;
+    if (latencies_us.size() < max_latency_samples) {
+      latencies_us.push_back(static_cast<uint32_t>((bench_now_ns() - tx_time_ns) / 1000));
+    }
+  }
   if (args.mode != "AM") {
     // Only AM will guarantee to deliver SDUs, take first byte as reference for other modes
-    next_expected_sdu = sdu->msg[0];
+    next_expected_sdu = sdu->msg[payload_offset];
   }
 
   // check SDU content (consider faster alternative)
-  for (uint32_t i = 0; i < sdu->N_bytes; ++i) {
+  for (uint32_t i = payload_offset; i < sdu->N_bytes; ++i) {
     if (sdu->msg[i] != next_expected_sdu) {
       logger.error(sdu->msg,
                    sdu->N_bytes,
@@ -193,6 +241,40 @@ void rlc_tester::write_pdu(uint32_t rx_lcid, srsran::unique_byte_buffer_t sdu)
   }
   next_expected_sdu += 1;
   rx_pdus++;
+  rx_bytes += sdu->N_bytes;
+}
+
+double rlc_tester::get_latency_percentile_us(double percentile) const
+{
+  if (latencies_us.empty()) {
+    return 0;
+  }
+  std::vector<uint32_t> sorted = latencies_us;
+  size_t                idx    = std::min(sorted.size() - 1, static_cast<size_t>(percentile / 100 * sorted.size()));
+  std::nth_element(sorted.begin(), sorted.begin() + idx, sorted.end());
+  return sorted[idx];
+}
+
+uint32_t rlc_tester::next_sdu_size()
+{
+  uint32_t sdu_size;
+  if (args.sdu_size >= 1) {
+    sdu_size = args.sdu_size;
+  } else if (args.sdu_size_dist == "bimodal") {
+    // e.g. TCP ACKs and full-sized data segments
+    sdu_size = (int_dist(mt19937) % 2 == 0) ? args.min_sdu_size : args.max_sdu_size;
+  } else if (args.sdu_size_dist == "imix") {
+    // Simple IMIX, i.e. 7:4:1 ratio of 40 B, 576 B and 1500 B packets
+    uint32_t idx = int_dist(mt19937) % 12;
+    sdu_size     = (idx < 7) ? 40 : ((idx < 11) ? 576 : 1500);
+  } else {
+    sdu_size = int_dist(mt19937);
+  }
+  if (args.benchmark) {
+    // Leave room for the Tx timestamp and at least one payload byte
+    sdu_size = std::max(sdu_size, bench_sdu_header_len + 1);
+  }
+  return sdu_size;
 }
 
 void rlc_tester::run_thread()
@@ -216,17 +298,18 @@ void rlc_tester::run_thread()
     pdu->md.pdcp_sn = pdcp_sn;
 
     // random or fixed SDU size
-    if (args.sdu_size < 1) {
-      sdu_size = int_dist(mt19937);
-    } else {
-      sdu_size = args.sdu_size;
-    }
+    sdu_size = next_sdu_size();
 
     for (uint32_t i = 0; i < sdu_size; i++) {
       pdu->msg[i] = payload;
     }
+    if (args.benchmark) {
+      int64_t tx_time_ns = bench_now_ns();
+      memcpy(pdu->msg, &tx_time_ns, sizeof(tx_time_ns));
+    }
     pdu->N_bytes = sdu_size;
     payload++;
+    tx_sdus++;
 
     rlc_pdcp->write_sdu(lcid, std::move(pdu));
     pdcp_sn = (pdcp_sn + 1) % max_pdcp_sn;
@@ -236,6 +319,94 @@ void rlc_tester::run_thread()
   }
 }
 
+struct bench_direction_result_t {
+  double sdus_per_sec;
+  double mbps;
+  double latency_p50_us;
+  double latency_p99_us;
+};
+
+/// Results of a direction are given by the tester at the receiving end
+bench_direction_result_t get_bench_direction_result(const rlc_tester& rx_tester, double elapsed_sec)
+{
+  bench_direction_result_t ret;
+  ret.sdus_per_sec   = rx_tester.get_nof_rx_pdus() / elapsed_sec;
+  ret.mbps           = rx_tester.get_nof_rx_bytes() * 8 / elapsed_sec / 1e6;
+  ret.latency_p50_us = rx_tester.get_latency_percentile_us(50);
+  ret.latency_p99_us = rx_tester.get_latency_percentile_us(99);
+  return ret;
+}
+
+void print_benchmark_results(const stress_test_args_t& args,
+                             uint32_t                  seed,
+                             double                    elapsed_sec,
+                             uint64_t                  nof_allocs,
+                             const rlc_tester&         tester1,
+                             const rlc_tester&         tester2)
+{
+  // RLC1 -> RLC2 is the DL direction of the dummy MAC
+  bench_direction_result_t dl = get_bench_direction_result(tester2, elapsed_sec);
+  bench_direction_result_t ul = get_bench_direction_result(tester1, elapsed_sec);
+
+  uint64_t nof_tx_sdus    = tester1.get_nof_tx_sdus() + tester2.get_nof_tx_sdus();
+  double   allocs_per_sdu = nof_tx_sdus > 0 ? static_cast<double>(nof_allocs) / nof_tx_sdus : 0;
+
+  fmt::print("Benchmark results ({} {}, seed={}, {:.2f}s):\n", args.rat, args.mode, seed, elapsed_sec);
+  fmt::print("  Dir |      SDUs/s |     Mbps | p50 lat [us] | p99 lat [us]\n");
+  fmt::print("   DL | {:>11.1f} | {:>8.2f} | {:>12.0f} | {:>12.0f}\n",
+             dl.sdus_per_sec,
+             dl.mbps,
+             dl.latency_p50_us,
+             dl.latency_p99_us);
+  fmt::print("   UL | {:>11.1f} | {:>8.2f} | {:>12.0f} | {:>12.0f}\n",
+             ul.sdus_per_sec,
+             ul.mbps,
+             ul.latency_p50_us,
+             ul.latency_p99_us);
+  fmt::print("  Heap allocations per SDU: {:.2f}\n", allocs_per_sdu);
+
+  if (args.json_output.empty()) {
+    return;
+  }
+  // One JSON object per line, so that several runs can be appended to the same file
+  FILE* f = fopen(args.json_output.c_str(), "a");
+  if (f == nullptr) {
+    fprintf(stderr, "Error opening %s\n", args.json_output.c_str());
+    return;
+  }
+  auto dir_to_json = [](const bench_direction_result_t& r) {
+    return fmt::format("{{\"sdus_per_sec\": {:.1f}, \"mbps\": {:.3f}, \"latency_p50_us\": {:.0f}, "
+                       "\"latency_p99_us\": {:.0f}}}",
+                       r.sdus_per_sec,
+                       r.mbps,
+                       r.latency_p50_us,
+                       r.latency_p99_us);
+  };
+  fmt::print(f,
+             "{{\"rat\": \"{}\", \"mode\": \"{}\", \"seed\": {}, \"duration_sec\": {:.3f}, \"sdu_size\": {}, "
+             "\"sdu_size_dist\": \"{}\", \"min_sdu_size\": {}, \"max_sdu_size\": {}, \"avg_opp_size\": {}, "
+             "\"random_opp\": {}, \"nof_pdu_tti\": {}, \"loss_pattern\": \"{}\", \"pdu_drop_rate\": {}, "
+             "\"loss_burst_len\": {}, \"dl\": {}, \"ul\": {}, \"allocs_per_sdu\": {:.3f}}}\n",
+             args.rat,
+             args.mode,
+             seed,
+             elapsed_sec,
+             args.sdu_size,
+             args.sdu_size_dist,
+             args.min_sdu_size,
+             args.max_sdu_size,
+             args.avg_opp_size,
+             args.random_opp,
+             args.nof_pdu_tti,
+             args.loss_pattern,
+             args.pdu_drop_rate,
+             args.loss_burst_len,
+             dir_to_json(dl),
+             dir_to_json(ul),
+             allocs_per_sdu);
+  fclose(f);
+}
+
 void stress_test(stress_test_args_t args)
 {
   auto log_sink =
@@ -304,9 +475,11 @@ void stress_test(stress_test_args_t args)
     exit(-1);
   }
 
-  // generate random seed if needed
+  // generate random seed if needed. Benchmark runs use a fixed default seed, so that they are reproducible
   uint32_t seed = 0;
-  if (not args.zero_seed) {
+  if (args.benchmark) {
+    seed = 1;
+  } else if (not args.zero_seed) {
     std::random_device rd;
     seed = rd();
   }
@@ -335,6 +508,9 @@ void stress_test(stress_test_args_t args)
 
   printf("Starting test ... Seed: %u\n", seed);
 
+  uint64_t allocs_start = nof_heap_allocs.load(std::memory_order_relaxed);
+  auto     tp_start     = std::chrono::steady_clock::now();
+
   tester1.start(7);
   if (!args.single_tx) {
     tester2.start(7);
@@ -366,6 +542,9 @@ void stress_test(stress_test_args_t args)
     pcap.close();
   }
 
+  double   elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - tp_start).count();
+  uint64_t nof_allocs  = nof_heap_allocs.load(std::memory_order_relaxed) - allocs_start;
+
   srsran::rlc_metrics_t metrics = {};
   rlc1.get_metrics(metrics, 1);
 
@@ -385,6 +564,10 @@ void stress_test(stress_test_args_t args)
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
+
+  if (args.benchmark) {
+    print_benchmark_results(args, seed, elapsed_sec, nof_allocs, tester1, tester2);
+  }
 }
 
 int main(int argc, char** argv)
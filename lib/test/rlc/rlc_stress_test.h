@@ -29,6 +29,7 @@
 #include <boost/program_options.hpp>
 #include <boost/program_options/parsers.hpp>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <pthread.h>
@@ -85,6 +86,11 @@ typedef struct {
   std::string log_filename;
   uint32_t    min_sdu_size;
   uint32_t    max_sdu_size;
+  std::string sdu_size_dist;
+  std::string loss_pattern;
+  float       loss_burst_len;
+  bool        benchmark;
+  std::string json_output;
 } stress_test_args_t;
 
 void parse_args(stress_test_args_t* args, int argc, char* argv[])
@@ -121,7 +127,12 @@ void parse_args(stress_test_args_t* args, int argc, char* argv[])
       ("nof_pdu_tti",   bpo::value<uint32_t>(&args->nof_pdu_tti)->default_value(1), "Number of PDUs processed in a TTI")
       ("log_hex_limit",   bpo::value<int32_t>(&args->log_hex_limit)->default_value(-1), "Maximum bytes in hex log")
       ("min_sdu_size",   bpo::value<uint32_t>(&args->min_sdu_size)->default_value(5), "Minimum SDU size")
-      ("max_sdu_size",   bpo::value<uint32_t>(&args->max_sdu_size)->default_value(1500), "Maximum SDU size");
+      ("max_sdu_size",   bpo::value<uint32_t>(&args->max_sdu_size)->default_value(1500), "Maximum SDU size")
+      ("sdu_size_dist",  bpo::value<std::string>(&args->sdu_size_dist)->default_value("uniform"), "Distribution of random SDU sizes (uniform/bimodal/imix)")
+      ("loss_pattern",   bpo::value<std::string>(&args->loss_pattern)->default_value("random"), "PDU loss pattern (random/burst)")
+      ("loss_burst_len", bpo::value<float>(&args->loss_burst_len)->default_value(4.0), "Average number of consecutive PDUs lost with the burst loss pattern")
+      ("benchmark",      bpo::value<bool>(&args->benchmark)->default_value(false), "Benchmark mode, i.e. fixed default seed and throughput, latency and allocation report")
+      ("json_output",    bpo::value<std::string>(&args->json_output)->default_value(""), "File where the benchmark results are appended in JSON format");
   // clang-format on
 
   // these options are allowed on the command line
@@ -151,6 +162,27 @@ void parse_args(stress_test_args_t* args, int argc, char* argv[])
   for (auto& c : args->mode) {
     c = toupper(c);
   }
+
+  if (args->sdu_size_dist != "uniform" and args->sdu_size_dist != "bimodal" and args->sdu_size_dist != "imix") {
+    std::cout << "Unsupported SDU size distribution " << args->sdu_size_dist << ", exiting." << std::endl;
+    exit(-1);
+  }
+  if (args->loss_pattern != "random" and args->loss_pattern != "burst") {
+    std::cout << "Unsupported loss pattern " << args->loss_pattern << ", exiting." << std::endl;
+    exit(-1);
+  }
+  if (args->loss_burst_len < 1.0) {
+    args->loss_burst_len = 1.0;
+  }
+}
+
+/// In benchmark mode, each SDU starts with its Tx timestamp (in ns) to measure the SDU latency at the receiver
+const uint32_t bench_sdu_header_len = sizeof(int64_t);
+
+inline int64_t bench_now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
 }
 
 class mac_dummy : public srsran::thread
@@ -200,6 +232,7 @@ private:
                                        srsue::rlc_interface_mac*                  rx_rlc,
                                        bool                                       is_dl,
                                        std::vector<srsran::unique_byte_buffer_t>& pdu_list);
+  bool                      is_pdu_lost(bool is_dl);
   srsue::rlc_interface_mac* rlc1 = nullptr;
   srsue::rlc_interface_mac* rlc2 = nullptr;
 
@@ -212,6 +245,9 @@ private:
 
   srsran::block_queue<srsran::move_task_t> pending_tasks;
 
+  /// State of the Gilbert-Elliott channel of each direction for the burst loss pattern
+  bool in_loss_burst[2] = {false, false};
+
   std::mt19937                          mt19937;
   std::uniform_real_distribution<float> real_dist;
 };
@@ -235,6 +271,9 @@ public:
   {
     logger.set_level(static_cast<srslog::basic_levels>(args.log_level));
     logger.set_hex_dump_max_size(args_.log_hex_limit);
+    if (args.benchmark) {
+      latencies_us.reserve(max_latency_samples);
+    }
   }
 
   void stop()
@@ -272,16 +311,25 @@ public:
   const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
 
   uint64_t get_nof_rx_pdus() const { return rx_pdus; }
+  uint64_t get_nof_rx_bytes() const { return rx_bytes; }
+  uint64_t get_nof_tx_sdus() const { return tx_sdus; }
+
+  /// Returns the given percentile (0..100) of the SDU latency in usec, measured in benchmark mode
+  double get_latency_percentile_us(double percentile) const;
 
 private:
-  const static size_t max_pdcp_sn = 262143U; // 18bit SN
+  const static size_t max_pdcp_sn         = 262143U; // 18bit SN
+  const static size_t max_latency_samples = 1U << 22U;
   void                run_thread() final;
+  uint32_t            next_sdu_size();
 
   std::atomic<bool> run_enable = {true};
 
   /// Tx uses thread-local PDCP SN to set SDU content, the Rx uses this variable to check received SDUs
   uint8_t               next_expected_sdu = 0;
   uint64_t              rx_pdus           = 0;
+  uint64_t              rx_bytes          = 0;
+  uint64_t              tx_sdus           = 0;
   uint32_t              lcid              = 0;
   srslog::basic_logger& logger;
 
@@ -291,6 +339,8 @@ private:
 
   srsue::rlc_interface_pdcp* rlc_pdcp = nullptr; // used by run_thread to push PDCP SDUs to RLC
 
+  std::vector<uint32_t> latencies_us; ///< SDU latencies, only collected in benchmark mode
+
   std::mt19937                    mt19937;
   std::uniform_int_distribution<> int_dist;
 };
@@ -0,0 +1,192 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_RNTI_EPOCH_MAP_H
+#define SRSENB_RNTI_EPOCH_MAP_H
+
+#include "common_enb.h"
+#include "srsran/common/epoch_guard.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * RNTI-indexed table of atomic pointers, where lookups are lock-free and removed objects are reclaimed via epochs.
+ * - Readers (e.g. PHY workers) must hold a srsran::epoch_read_guard while they access the table or any of its objects.
+ * - Writers (UE addition/removal) are serialized via an internal mutex that readers never touch.
+ * - Erased objects are only destroyed in reclaim(), once no reader can still hold a reference to them.
+ * As in rnti_map_t, the slot of an RNTI is given by rnti % N, so colliding RNTIs are rejected on insertion.
+ * @tparam UEObject pointer-like object type stored in the table (e.g. unique_rnti_ptr<T>)
+ */
+template <typename UEObject, size_t N = SRSENB_MAX_UES>
+class rnti_epoch_map
+{
+  struct node_t {
+    node_t(uint16_t rnti_, UEObject&& obj_) : rnti(rnti_), obj(std::move(obj_)) {}
+    uint16_t rnti;
+    UEObject obj;
+    uint64_t retire_epoch = 0;
+  };
+
+public:
+  rnti_epoch_map() : epochs(srsran::epoch_domain::get_instance())
+  {
+    for (auto& s : slots) {
+      s.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  rnti_epoch_map(const rnti_epoch_map&) = delete;
+  rnti_epoch_map& operator=(const rnti_epoch_map&) = delete;
+  ~rnti_epoch_map()
+  {
+    clear();
+    synchronize();
+  }
+
+  /// Lookup of UE object. Caller must hold an epoch_read_guard. Returns nullptr if RNTI is not present.
+  UEObject* find(uint16_t rnti) const
+  {
+    node_t* n = slots[rnti % N].load(std::memory_order_acquire);
+    return (n != nullptr and n->rnti == rnti) ? &n->obj : nullptr;
+  }
+  bool      contains(uint16_t rnti) const { return find(rnti) != nullptr; }
+  UEObject& operator[](uint16_t rnti) const
+  {
+    UEObject* obj = find(rnti);
+    srsran_assert(obj != nullptr, "rnti=0x%x not found", rnti);
+    return *obj;
+  }
+
+  bool   has_space(uint16_t rnti) const { return slots[rnti % N].load(std::memory_order_acquire) == nullptr; }
+  size_t size() const { return count.load(std::memory_order_relaxed); }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() == N; }
+
+  /// Iterates over all present objects. Caller must hold an epoch_read_guard.
+  template <typename Func>
+  void for_each(Func&& f) const
+  {
+    for (const auto& s : slots) {
+      node_t* n = s.load(std::memory_order_acquire);
+      if (n != nullptr) {
+        f(n->rnti, n->obj);
+      }
+    }
+  }
+
+  /// Publishes a new object. Returns a pointer to the stored object, or nullptr if the RNTI slot is taken.
+  UEObject* insert(uint16_t rnti, UEObject obj)
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    std::atomic<node_t*>&       slot = slots[rnti % N];
+    if (slot.load(std::memory_order_relaxed) != nullptr) {
+      return nullptr;
+    }
+    node_t* n = new node_t(rnti, std::move(obj));
+    slot.store(n, std::memory_order_release);
+    count.fetch_add(1, std::memory_order_relaxed);
+    return &n->obj;
+  }
+
+  /// Unlinks object from the table. Its destruction is deferred until reclaim() finds it safe.
+  bool erase(uint16_t rnti)
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    std::atomic<node_t*>&       slot = slots[rnti % N];
+    node_t*                     n    = slot.load(std::memory_order_relaxed);
+    if (n == nullptr or n->rnti != rnti) {
+      return false;
+    }
+    retire_unprotected(slot, n);
+    return true;
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    for (auto& slot : slots) {
+      node_t* n = slot.load(std::memory_order_relaxed);
+      if (n != nullptr) {
+        retire_unprotected(slot, n);
+      }
+    }
+  }
+
+  /// Destroys the retired objects that no reader can reference anymore. Returns the number of objects still pending.
+  size_t reclaim()
+  {
+    std::vector<node_t*> safe_nodes;
+    {
+      std::lock_guard<std::mutex> lock(writer_mutex);
+      if (retired.empty()) {
+        return 0;
+      }
+      uint64_t min_epoch = epochs.min_active_epoch();
+      auto     it        = std::partition(
+          retired.begin(), retired.end(), [min_epoch](const node_t* n) { return n->retire_epoch >= min_epoch; });
+      safe_nodes.assign(it, retired.end());
+      retired.erase(it, retired.end());
+    }
+    // Objects are destroyed outside the writer lock, as their destructors may be slow
+    for (node_t* n : safe_nodes) {
+      delete n;
+    }
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    return retired.size();
+  }
+
+  /// Blocks until all retired objects have been reclaimed. Must not be called from within an epoch_read_guard.
+  void synchronize()
+  {
+    while (reclaim() > 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  size_t nof_pending_reclaims() const
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    return retired.size();
+  }
+
+private:
+  void retire_unprotected(std::atomic<node_t*>& slot, node_t* n)
+  {
+    slot.store(nullptr, std::memory_order_seq_cst);
+    count.fetch_sub(1, std::memory_order_relaxed);
+    n->retire_epoch = epochs.advance();
+    retired.push_back(n);
+  }
+
+  srsran::epoch_domain&               epochs;
+  std::array<std::atomic<node_t*>, N> slots;
+  std::atomic<size_t>                 count{0};
+
+  mutable std::mutex   writer_mutex;
+  std::vector<node_t*> retired;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_RNTI_EPOCH_MAP_H
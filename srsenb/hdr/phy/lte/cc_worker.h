@@ -22,6 +22,8 @@
 #ifndef SRSENB_CC_WORKER_H
 #define SRSENB_CC_WORKER_H
 
+#include <atomic>
+#include <chrono>
 #include <string.h>
 
 #include "../phy_common.h"
@@ -62,21 +64,32 @@ public:
                srsran_mbsfn_cfg_t*                  mbsfn_cfg);
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
+  void     get_load_metrics(phy_load_metrics_t& metrics);
 
 private:
   constexpr static float PUSCH_RL_SNR_DB_TH = 1.0f;
   constexpr static float PUCCH_RL_CORR_TH   = 0.15f;
 
   int  encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
+  struct pdsch_tx_t;
+  bool prepare_pdsch_grant(stack_interface_phy_lte::dl_sched_grant_t& grant, pdsch_tx_t& tx);
+  int  encode_pdsch_grant(stack_interface_phy_lte::dl_sched_grant_t& grant,
+                          uint32_t                                   grant_idx,
+                          pdsch_tx_t&                                tx,
+                          srsran_pdsch_t*                            pdsch);
   int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg);
-  bool decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                         srsran_ul_cfg_t&                           ul_cfg,
-                         srsran_pusch_res_t&                        pusch_res);
+  struct pusch_rx_t;
+  bool decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_rx_t& rx, uint32_t lane);
+  void report_pusch(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_rx_t& rx);
   void decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
   int  encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks);
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants);
+  void select_pucch();
   int  decode_pucch();
+  void select_srs();
+  void decode_srs();
+  void metrics_tti(bool empty);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -95,6 +108,48 @@ private:
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 
+  // PDSCH encoders of the helper threads, one per lane of the UE task pool. Lane 0 uses enb_dl.pdsch
+  std::vector<srsran_pdsch_t> lane_pdsch;
+
+  class ue;
+
+  // PDSCH transmission of each grant. Filled in grant order before the grants are encoded in parallel
+  struct pdsch_tx_t {
+    ue*             user   = nullptr;
+    srsran_dl_cfg_t dl_cfg = {};
+  };
+  std::vector<pdsch_tx_t> pdsch_tx;
+
+  // PUSCH receivers of the helper threads, one per lane of the UE task pool. Lane 0 uses the ones of enb_ul
+  struct pusch_lane_t {
+    srsran_chest_ul_t     chest     = {};
+    srsran_chest_ul_res_t chest_res = {};
+    srsran_pusch_t        pusch     = {};
+  };
+  std::vector<pusch_lane_t> lane_pusch;
+
+  // PUSCH reception of each grant. Filled by the decoding tasks and reported to the stack in grant order
+  struct pusch_rx_t {
+    bool                  valid        = false;
+    bool                  uci_required = false;
+    srsran_ul_cfg_t       ul_cfg       = {};
+    srsran_pusch_res_t    res          = {};
+    srsran_chest_ul_res_t chest_res    = {};
+  };
+  std::vector<pusch_rx_t> pusch_rx;
+
+  // UEs expected to transmit PUCCH in the current TTI, without PUSCH
+  struct pucch_rx_t {
+    uint16_t        rnti   = SRSRAN_INVALID_RNTI;
+    srsran_ul_cfg_t ul_cfg = {};
+  };
+  std::vector<pucch_rx_t> pucch_rx;
+
+  // UEs that transmit SRS in the current TTI, measured together
+  std::vector<uint16_t>                   srs_rnti;
+  std::vector<srsran_refsignal_srs_cfg_t> srs_cfg;
+  std::vector<srsran_chest_ul_srs_res_t>  srs_res;
+
   // Class to store user information
   class ue
   {
@@ -120,6 +175,23 @@ private:
   // Component carrier index
   uint32_t cc_idx = 0;
 
+  // Processing load of the TTI in progress, the UL part is accounted until the DL part finishes the TTI
+  std::chrono::nanoseconds tti_proc_time = {};
+  bool                     tti_ul_empty  = false;
+  std::atomic<uint32_t>    tti_dl_prb    = {0};
+  uint32_t                 tti_ul_prb    = 0;
+
+  // Processing load accumulated since the last metrics report
+  struct load_metrics_t {
+    uint32_t                 nof_tti         = 0;
+    uint32_t                 nof_empty_tti   = 0;
+    uint64_t                 dl_prb          = 0;
+    uint64_t                 ul_prb          = 0;
+    std::chrono::nanoseconds proc_time       = {};
+    std::chrono::nanoseconds proc_time_empty = {};
+  };
+  load_metrics_t load_metrics;
+
   // Each worker keeps a local copy of the user database. Uses more memory but more efficient to manage concurrency
   std::map<uint16_t, ue*> ue_db;
   std::mutex              mutex;
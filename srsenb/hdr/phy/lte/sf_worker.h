@@ -57,6 +57,7 @@ public:
   void     start_plot();
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
+  void     get_load_metrics(std::vector<phy_load_metrics_t>& metrics);
 
 private:
   void work_imp() final;
@@ -69,6 +69,15 @@ private:
       return 0;
     }
     int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) override { return 0; }
+    int ul_sb_snr_info(uint32_t                  tti,
+                       uint16_t                  rnti,
+                       uint32_t                  cc_idx,
+                       uint32_t                  prb_start,
+                       uint32_t                  sb_nof_prb,
+                       srsran::span<const float> sb_snr_db) override
+    {
+      return 0;
+    }
     int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return 0; }
     int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override { return 0; }
     int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) override { return 0; }
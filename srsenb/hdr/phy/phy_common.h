@@ -35,6 +35,7 @@
 #include "srsran/phy/channel/channel.h"
 #include "srsran/radio/radio.h"
 
+#include <condition_variable>
 #include <map>
 #include <srsran/common/tti_sempahore.h>
 #include <string.h>
@@ -288,6 +289,30 @@ public:
    */
   phy_ue_db ue_db;
 
+  /**
+   * Starts the helper threads shared by all PHY workers, which run the per-UE tasks of a TTI in parallel
+   */
+  void     start_ue_tasks(uint32_t nof_helpers, int32_t prio);
+  void     stop_ue_tasks();
+  uint32_t nof_ue_task_lanes() const { return nof_ue_helpers + 1; }
+
+  /**
+   * Runs task(task_idx, lane) for every task_idx in [0, nof_tasks), and returns once all of them have finished. The
+   * calling PHY worker runs the tasks in lane 0, and each helper joining the batch in its own lane in
+   * [1, nof_ue_task_lanes()), so that the tasks can use per-lane resources (e.g. one PDSCH encoder) without locking
+   * @param nof_tasks number of tasks of the batch
+   * @param task callable with signature void(uint32_t task_idx, uint32_t lane)
+   */
+  template <typename F>
+  void run_ue_tasks(uint32_t nof_tasks, F&& task)
+  {
+    using func_t = typename std::remove_reference<F>::type;
+    run_ue_batch(
+        nof_tasks,
+        [](void* ctx, uint32_t task_idx, uint32_t lane) { (*static_cast<func_t*>(ctx))(task_idx, lane); },
+        &task);
+  }
+
   void configure_mbsfn(srsran::phy_cfg_mbsfn_t* cfg);
   void build_mch_table();
   void build_mcch_table();
@@ -300,6 +325,25 @@ public:
   void clear_grants(uint16_t rnti);
 
 private:
+  using ue_task_func_t = void (*)(void* ctx, uint32_t task_idx, uint32_t lane);
+
+  // Batch of per-UE tasks. It is shared with the helper tasks, which may start after the batch has finished
+  struct ue_batch_t {
+    uint32_t                nof_tasks = 0;
+    ue_task_func_t          func      = nullptr;
+    void*                   ctx       = nullptr;
+    std::atomic<uint32_t>   next_task = {0};
+    std::mutex              mutex;
+    std::condition_variable cvar;
+    uint32_t                nof_done = 0; ///< Tasks finished, protected by the batch mutex
+  };
+
+  void        run_ue_batch(uint32_t nof_tasks, ue_task_func_t func, void* ctx);
+  static void run_ue_batch_tasks(ue_batch_t& batch, uint32_t lane);
+
+  std::unique_ptr<srsran::task_thread_pool> ue_helpers;
+  uint32_t                                  nof_ue_helpers = 0;
+
   // Common objects for scheduling grants
   srsran::circular_array<stack_interface_phy_lte::ul_sched_list_t, TTIMOD_SZ> ul_grants   = {};
   std::mutex                                                                  grant_mutex = {};
@@ -23,6 +23,7 @@
 #define SRSENB_PHY_METRICS_H
 
 #include <limits>
+#include <stdint.h>
 
 namespace srsenb {
 
@@ -53,6 +54,18 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY processing load per cell
+
+struct phy_load_metrics_t {
+  uint32_t nof_tti;            ///< Number of processed TTIs
+  uint32_t nof_empty_tti;      ///< Processed TTIs without PDSCH, PDCCH, PHICH, PUSCH, PUCCH nor SRS
+  float    dl_prb_usage;       ///< Average percentage of the DL PRBs allocated to PDSCH
+  float    ul_prb_usage;       ///< Average percentage of the UL PRBs allocated to PUSCH
+  float    proc_time_us;       ///< Average processing time of a TTI, in microseconds
+  float    proc_time_empty_us; ///< Average processing time of an empty TTI, in microseconds
+  float    cpu_load;           ///< Processing time over the duration of the processed TTIs, in percentage of a core
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
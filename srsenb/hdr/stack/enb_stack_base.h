@@ -41,6 +41,7 @@ typedef struct {
   std::string bind_ip;
   uint16_t    client_port;
   uint16_t    bind_port;
+  bool        batch_enable;
 } pcap_net_args_t;
 
 typedef struct {
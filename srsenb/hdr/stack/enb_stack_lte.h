@@ -86,6 +86,15 @@ public:
   {
     return mac.snr_info(tti_rx, rnti, cc_idx, snr_db, ch);
   }
+  int ul_sb_snr_info(uint32_t                  tti_rx,
+                     uint16_t                  rnti,
+                     uint32_t                  cc_idx,
+                     uint32_t                  prb_start,
+                     uint32_t                  sb_nof_prb,
+                     srsran::span<const float> sb_snr_db) final
+  {
+    return mac.ul_sb_snr_info(tti_rx, rnti, cc_idx, prb_start, sb_nof_prb, sb_snr_db);
+  }
   int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return mac.ta_info(tti, rnti, ta_us); }
   int ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack) final
   {
@@ -147,6 +156,24 @@ public:
   // gtpu_interface_pdcp
   void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu);
 
+  // X2 split bearer interface, for the EUTRA RLC legs of the split bearers of the NR PDCP
+  void add_split_bearer_owner(uint16_t            rnti,
+                              uint32_t            lcid,
+                              pdcp_interface_rlc* owner,
+                              uint16_t            owner_rnti,
+                              uint32_t            owner_lcid)
+  {
+    x2_task_queue.push([this, rnti, lcid, owner, owner_rnti, owner_lcid]() {
+      pdcp.add_split_bearer_owner(rnti, lcid, owner, owner_rnti, owner_lcid);
+    });
+  }
+  void del_split_bearer_owner(uint16_t rnti, uint32_t lcid)
+  {
+    x2_task_queue.push([this, rnti, lcid]() { pdcp.del_split_bearer_owner(rnti, lcid); });
+  }
+  /// The RLC is thread-safe, so the NR PDCP writes to the EUTRA legs directly
+  rlc_interface_pdcp* get_split_bearer_leg_rlc() { return &rlc; }
+
 private:
   static const int STACK_MAIN_THREAD_PRIO = 4;
   // thread loop
@@ -24,6 +24,7 @@
 
 #include "sched.h"
 #include "sched_interface.h"
+#include "srsenb/hdr/common/rnti_epoch_map.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/adt/circular_map.h"
@@ -31,14 +32,19 @@
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/tti_sync_cv.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
+#include "srsran/interfaces/enb_rrc_interface_mac.h"
 #include "srsran/interfaces/enb_rrc_interface_types.h"
 #include "srsran/srslog/srslog.h"
 #include "ta.h"
 #include "ue.h"
+#include <atomic>
+#include <mutex>
+#include <pthread.h>
 #include <vector>
 
 namespace srsenb {
@@ -55,6 +61,12 @@ public:
             rrc_interface_mac*       rrc);
   void stop();
 
+  /// Queue of the tasks that the UL PDU workers post to the stack thread, or nullptr if there are no workers
+  srsran::task_queue_handle* get_ul_worker_stack_queue()
+  {
+    return ul_pdu_workers.empty() ? nullptr : &ul_worker_stack_queue;
+  }
+
   void start_pcap(srsran::mac_pcap* pcap_);
   void start_pcap_net(srsran::mac_pcap_net* pcap_net_);
 
@@ -67,6 +79,12 @@ public:
   int cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value) override;
   int sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value) override;
   int snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, ul_channel_t ch) override;
+  int ul_sb_snr_info(uint32_t                  tti,
+                     uint16_t                  rnti,
+                     uint32_t                  enb_cc_idx,
+                     uint32_t                  prb_start,
+                     uint32_t                  sb_nof_prb,
+                     srsran::span<const float> sb_snr_db) override;
   int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override;
   int ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack) override;
   int crc_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc_res) override;
@@ -115,9 +133,12 @@ public:
                   const uint8_t              mcch_payload_length) override;
 
 private:
-  bool     check_ue_active(uint16_t rnti);
+  ue*      get_active_ue(uint16_t rnti);
   uint16_t allocate_ue(uint32_t enb_cc_idx);
   bool     is_valid_rnti_unprotected(uint16_t rnti);
+  void     reclaim_removed_ues();
+
+  rrc_interface_mac* get_ue_rrc_interface() { return ul_pdu_workers.empty() ? rrc_h : &ul_rrc_adapter; }
 
   /* helper function for PDCCH orders */
   /**
@@ -131,9 +152,10 @@ private:
 
   srslog::basic_logger& logger;
 
-  // We use a rwlock in MAC to allow multiple workers to access MAC simultaneously. No conflicts will happen since
-  // access for different TTIs
-  pthread_rwlock_t rwlock = {};
+  // PHY workers access the UE DB without locks, holding a srsran::epoch_read_guard instead. UE additions/removals are
+  // serialized by the ue_db itself, and the removed UE objects are only destroyed once no worker can reference them.
+  // The cell and MCCH configurations are protected by cfg_rwlock, as the MCCH may be written while the PHY is running.
+  pthread_rwlock_t cfg_rwlock;
 
   // Interaction with PHY
   phy_interface_stack_lte*      phy_h = nullptr;
@@ -147,7 +169,8 @@ private:
   // derived from args
   srsran::task_multiqueue::queue_handle stack_task_queue;
 
-  bool started = false;
+  std::atomic<bool> started{false};
+  std::mutex        ue_alloc_mutex; ///< Serializes the insertion of new UEs with stop()
 
   /* Scheduler unit */
   sched                                    scheduler;
@@ -156,9 +179,9 @@ private:
   sched_interface::dl_pdu_mch_t mch = {};
 
   /* Map of active UEs */
-  static const uint16_t            FIRST_RNTI = 0x46;
-  rnti_map_t<unique_rnti_ptr<ue> > ue_db;
-  std::atomic<uint16_t>            ue_counter{0};
+  static const uint16_t                FIRST_RNTI = 0x46;
+  rnti_epoch_map<unique_rnti_ptr<ue> > ue_db;
+  std::atomic<uint16_t>                ue_counter{0};
 
   uint8_t* assemble_rar(sched_interface::dl_sched_rar_grant_t* grants,
                         uint32_t                               enb_cc_idx,
@@ -205,6 +228,33 @@ private:
 
   // Softbuffer pool
   std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > softbuffer_pool;
+
+  /// RRC interface used by the UEs when their UL PDUs are processed in the UE-plane workers. RRC procedures triggered
+  /// by MAC CEs are forwarded to the stack thread, while the remaining (thread-safe) calls go directly to RRC.
+  class ul_worker_rrc_adapter final : public rrc_interface_mac
+  {
+  public:
+    explicit ul_worker_rrc_adapter(mac* parent_) : parent(parent_) {}
+    int      add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg) override;
+    void     upd_user(uint16_t new_rnti, uint16_t old_rnti) override;
+    void     set_activity_user(uint16_t rnti) override;
+    void     set_radiolink_dl_state(uint16_t rnti, bool crc_res) override;
+    void     set_radiolink_ul_state(uint16_t rnti, bool crc_res) override;
+    bool     is_paging_opportunity(uint32_t tti_tx_dl, uint32_t* payload_len) override;
+    void     read_pdu_pcch(uint32_t tti_tx_dl, uint8_t* payload, uint32_t payload_size) override;
+    uint8_t* read_pdu_bcch_dlsch(const uint8_t enb_cc_idx, const uint32_t sib_index) override;
+
+  private:
+    mac* parent;
+  };
+
+  // UE-plane workers for UL PDU processing (MAC demux, RLC, and PDCP and GTP-U for LTE DRBs). Each UE is always served
+  // by the same worker. The tasks they post to the stack thread share one queue, which keeps their order. A worker
+  // waits while this queue is full, so that no task is lost, until the queue is deactivated by stop()
+  const static uint32_t                              ul_pdu_worker_queue_size = 2048;
+  std::vector<std::unique_ptr<srsran::task_worker> > ul_pdu_workers;
+  srsran::task_queue_handle                          ul_worker_stack_queue;
+  ul_worker_rrc_adapter                              ul_rrc_adapter{this};
 };
 
 } // namespace srsenb
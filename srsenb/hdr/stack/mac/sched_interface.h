@@ -21,6 +21,7 @@
 
 #include "common/sched_config.h"
 #include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/common.h"
 #include "srsran/srsran.h"
 #include <vector>
@@ -318,6 +319,14 @@ public:
   virtual int ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)                                           = 0;
   virtual int ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code) = 0;
 
+  /// SINR of consecutive subbands of "sb_nof_prb" PRBs starting at "prb_start", measured on the SRS
+  virtual int ul_sb_snr_info(uint32_t                  tti,
+                             uint16_t                  rnti,
+                             uint32_t                  enb_cc_idx,
+                             uint32_t                  prb_start,
+                             uint32_t                  sb_nof_prb,
+                             srsran::span<const float> sb_snr_db) = 0;
+
   /* Run Scheduler for this tti */
   virtual int dl_sched(uint32_t tti, uint32_t enb_cc_idx, dl_sched_res_t& sched_result) = 0;
   virtual int ul_sched(uint32_t tti, uint32_t enb_cc_idx, ul_sched_res_t& sched_result) = 0;
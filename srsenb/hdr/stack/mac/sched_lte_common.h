@@ -67,6 +67,11 @@ public:
   uint32_t nof_prb() const { return cfg.cell.nof_prb; }
   uint32_t get_dl_lb_nof_re(tti_point tti_tx_dl, uint32_t nof_prbs_alloc) const;
   uint32_t get_dl_nof_res(srsran::tti_point tti_tx_dl, const srsran_dci_dl_t& dci, uint32_t cfi) const;
+  /// Obtains TB size *in bytes* for a given MCS and nof allocated prbs, same as srsenb::get_tbs_bytes, or
+  /// SRSRAN_ERROR if the MCS is not in the MCS table or the nof prbs is invalid
+  int get_tbs_bytes(uint32_t mcs, uint32_t nof_prbs_alloc, bool use_tbs_index_alt, bool is_ul) const;
+  /// Obtains the minimum nof prbs whose TB size for a given MCS is at least req_bytes, or -1 if there is none
+  int get_min_nof_prb(uint32_t mcs, uint32_t req_bytes, bool use_tbs_index_alt, bool is_ul) const;
 
   uint32_t                                     enb_cc_idx       = 0;
   sched_interface::cell_cfg_t                  cfg              = {};
@@ -88,6 +93,15 @@ public:
   dl_nof_re_table nof_re_table;
   /// Cached computation of Lower bound of nof REs
   dl_lb_nof_re_table nof_re_lb_table;
+
+  /// MCS tables: DL, DL with 256QAM (TS 36.213 - Table 7.1.7.1-1/1A) and UL (TS 36.213 - Table 8.6.1-1)
+  constexpr static uint32_t nof_mcs_tables = 3;
+  constexpr static uint32_t nof_mcs        = 29;
+  using tbs_bytes_table =
+      std::array<std::array<srsran::bounded_vector<uint32_t, SRSRAN_MAX_PRB>, nof_mcs>, nof_mcs_tables>;
+
+  /// Table of TB sizes in bytes, indexed by {mcs table, mcs, nof prbs - 1}
+  tbs_bytes_table tbs_table;
 };
 
 /// Type of Allocation stored in PDSCH/PUSCH
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_UL_SINR_H
+#define SRSRAN_SCHED_UL_SINR_H
+
+#include "srsenb/hdr/stack/mac/sched_phy_ch/sched_phy_resource.h"
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/span.h"
+#include "srsran/common/tti_point.h"
+
+namespace srsenb {
+
+/**
+ * Class that handles the UL SINR per PRB of a given {rnti,sector}, measured on the SRS
+ * - Each SRS measurement covers the PRBs sounded in one TTI, which change from TTI to TTI with frequency hopping
+ * - The SINR of a PRB is averaged over the measurements that covered it, and forgotten after "max_age_ms"
+ * - The PRBs without a recent measurement take the average SINR of the PRBs with one
+ */
+class sched_ul_sinr
+{
+public:
+  explicit sched_ul_sinr(uint32_t cell_nof_prb_, uint32_t max_age_ms_ = 400, float alpha_ = 0.5f) :
+    cell_nof_prb(cell_nof_prb_), max_age_ms(max_age_ms_), alpha(alpha_), prbs(cell_nof_prb_)
+  {
+    srsran_assert(cell_nof_prb <= MAX_NOF_PRBS, "Invalid number of PRBs=%d", cell_nof_prb);
+  }
+
+  /// Update the SINR of "sb_snr_db.size()" consecutive subbands of "sb_nof_prb" PRBs, starting at "prb_start"
+  void sb_snr_info(tti_point tti_rx, uint32_t prb_start, uint32_t sb_nof_prb, srsran::span<const float> sb_snr_db);
+
+  /// Forgets all the measurements
+  void reset();
+
+  /// Whether any PRB was measured in the last "max_age_ms", as seen at "tti"
+  bool is_sinr_info_valid(tti_point tti) const;
+
+  /// SINR of the PRB "prb" as seen at "tti", in dB
+  float get_prb_sinr(uint32_t prb, tti_point tti) const;
+
+  /// Average SINR of the PRBs in "interv" as seen at "tti", in dB
+  float get_avg_sinr(prb_interval interv, tti_point tti) const;
+
+  /**
+   * Finds the interval of L PRBs, free in "ul_mask", with the highest average SINR. Ties are broken towards the lowest
+   * PRB, so that a flat or unknown channel keeps the first-fit allocation
+   * @return found interval of PRBs. If no free interval of L PRBs exists, interval.empty() == true
+   */
+  prb_interval get_optim_prb_interval(const prbmask_t& ul_mask, uint32_t L, tti_point tti) const;
+
+private:
+  struct prb_sinr_context {
+    tti_point last_tti_rx{};
+    float     sinr_db = 0;
+  };
+
+  bool is_prb_valid(uint32_t prb, tti_point tti) const
+  {
+    return prbs[prb].last_tti_rx.is_valid() and tti - prbs[prb].last_tti_rx <= static_cast<int>(max_age_ms);
+  }
+
+  /// Average SINR of the measured PRBs, which replaces the SINR of the PRBs without recent measurements
+  float get_wb_sinr(tti_point tti) const;
+
+  uint32_t cell_nof_prb;
+  uint32_t max_age_ms;
+  float    alpha;
+
+  srsran::bounded_vector<prb_sinr_context, MAX_NOF_PRBS> prbs;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_UL_SINR_H
@@ -55,6 +55,9 @@ alloc_result
              try_dl_newtx_alloc_greedy(sf_sched& tti_sched, sched_ue& ue, const dl_harq_proc& h, rbgmask_t* result_mask = nullptr);
 alloc_result try_ul_retx_alloc(sf_sched& tti_sched, sched_ue& ue, const ul_harq_proc& h);
 
+/// Finds the PRBs of an UL newtx of "L" PRBs, placed where the UE SRS measured the highest SINR if available
+prb_interval find_ul_newtx_prbs(sf_sched& tti_sched, sched_ue& ue, uint32_t L);
+
 } // namespace srsenb
 
 #endif // SRSRAN_SCHED_BASE_H
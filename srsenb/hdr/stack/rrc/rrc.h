@@ -77,7 +77,8 @@ public:
                pdcp_interface_rrc*    pdcp,
                s1ap_interface_rrc*    s1ap,
                gtpu_interface_rrc*    gtpu,
-               rrc_nr_interface_rrc*  rrc_nr);
+               rrc_nr_interface_rrc*  rrc_nr,
+               pdcp_nr_interface_rrc* pdcp_nr = nullptr);
 
   void stop();
   void get_metrics(rrc_metrics_t& m);
@@ -179,7 +180,8 @@ private:
   pdcp_interface_rrc*       pdcp   = nullptr;
   gtpu_interface_rrc*       gtpu   = nullptr;
   s1ap_interface_rrc*       s1ap   = nullptr;
-  rrc_nr_interface_rrc*     rrc_nr = nullptr;
+  rrc_nr_interface_rrc*     rrc_nr  = nullptr;
+  pdcp_nr_interface_rrc*    pdcp_nr = nullptr;
   srslog::basic_logger&     logger;
 
   // derived params
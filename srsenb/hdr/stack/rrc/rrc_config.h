@@ -27,6 +27,7 @@
 #include "srsran/common/security.h"
 #include "srsran/interfaces/enb_rrc_interface_types.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/upper/pdcp_split_bearer.h"
 #include <array>
 
 namespace srsenb {
@@ -62,6 +63,10 @@ struct rrc_endc_cfg_t {
   ssb_nr_cfg::periodicity_and_offset_r15_c_ ssb_period_offset;
   ssb_nr_cfg::ssb_dur_r15_e_                ssb_duration;
   ssb_rs_cfg::subcarrier_spacing_ssb_r15_e_ ssb_ssc;
+  /// Keep the EUTRA RLC bearer of the DRB moved to NR as secondary leg of a split bearer of the NR PDCP. Experimental,
+  /// as only the eNB side is set up (see rrc_endc)
+  bool                            split_bearer;
+  srsran::pdcp_split_bearer_cfg_t split_bearer_cfg;
 };
 
 struct rrc_cfg_t {
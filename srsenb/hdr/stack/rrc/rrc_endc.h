@@ -105,8 +105,9 @@ private:
   uint32_t nr_meas_id       = 0;
 
   // vars
-  rrc_endc_cfg_t                       endc_cfg = {};
-  uint16_t                             nr_rnti  = SRSRAN_INVALID_RNTI; // C-RNTI assigned to UE on NR side
+  rrc_endc_cfg_t                       endc_cfg       = {};
+  uint16_t                             nr_rnti        = SRSRAN_INVALID_RNTI; // C-RNTI assigned to UE on NR side
+  uint32_t                             split_leg_lcid = 0; // EUTRA RLC bearer used as secondary leg of the NR DRB
   asn1::rrc::rrc_conn_recfg_complete_s pending_recfg_complete;
 
   // fixed ENDC variables
@@ -28,6 +28,7 @@
 #include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
@@ -102,6 +103,9 @@ public:
   using ue_bearer_tunnel_list = srsran::bounded_vector<bearer_teid_pair, MAX_TUNNELS_PER_UE>;
 
   explicit gtpu_tunnel_manager(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger);
+  gtpu_tunnel_manager(const gtpu_tunnel_manager&) = delete;
+  gtpu_tunnel_manager& operator=(const gtpu_tunnel_manager&) = delete;
+  ~gtpu_tunnel_manager();
   void init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_);
 
   bool                           has_teid(uint32_t teid) const { return tunnels.contains(teid); }
@@ -123,7 +127,23 @@ public:
   bool remove_tunnel(uint32_t teid);
   bool remove_rnti(uint16_t rnti);
 
+  /// Calls "f" with the tunnel that carries the UL PDUs of a bearer. Unlike the other methods, which are only called
+  /// from the stack thread, it may be called from the MAC UL PDU workers. Returns false if the bearer has no tunnel
+  template <typename F>
+  bool apply_to_ul_tunnel(uint16_t rnti, uint32_t eps_bearer_id, const F& f)
+  {
+    srsran::rwlock_read_guard      rw_lock(rwlock);
+    srsran::span<bearer_teid_pair> teids = find_rnti_bearer_tunnels(rnti, eps_bearer_id);
+    if (teids.empty()) {
+      return false;
+    }
+    f(tunnels[teids[0].teid]);
+    return true;
+  }
+
 private:
+  bool remove_tunnel_unlocked(uint32_t teid);
+
   using tunnel_list_t  = srsran::static_id_obj_pool<uint32_t, tunnel, SRSENB_MAX_UES * MAX_TUNNELS_PER_UE>;
   using tunnel_ctxt_it = typename tunnel_list_t::iterator;
 
@@ -132,8 +152,10 @@ private:
   pdcp_interface_gtpu*      pdcp      = nullptr;
   srslog::basic_logger&     logger;
 
+  // The tunnels are only added, removed or moved to another RNTI by the stack thread, under a write lock
+  pthread_rwlock_t                                    rwlock = {};
   std::unordered_map<uint16_t, ue_bearer_tunnel_list> ue_teidin_db;
-  tunnel_list_t                     tunnels;
+  tunnel_list_t                                       tunnels;
 };
 
 using gtpu_tunnel_state = gtpu_tunnel_manager::tunnel_state;
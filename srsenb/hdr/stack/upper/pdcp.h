@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/common/timers.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
@@ -42,7 +43,7 @@ class pdcp : public pdcp_interface_rlc, public pdcp_interface_gtpu, public pdcp_
 {
 public:
   pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger);
-  virtual ~pdcp() {}
+  virtual ~pdcp();
   void init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_);
   void stop();
 
@@ -50,6 +51,7 @@ public:
   void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override;
   void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn) override;
   void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn) override;
+  bool try_write_pdu_user_plane(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t& pdu) override;
   void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t sdu) {}
 
   // pdcp_interface_rrc
@@ -72,6 +74,24 @@ public:
   // pdcp_interface_gtpu
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
 
+  /// Turns the DRB "lcid" of "rnti" into a split bearer, whose DL PDUs are also sent over the RLC bearer "leg_lcid"
+  /// of user "leg_rnti" in "leg_rlc" (e.g. the LTE RLC leg of an EN-DC UE served by the NR PDCP)
+  bool add_split_bearer_leg(uint16_t                               rnti,
+                            uint32_t                               lcid,
+                            rlc_interface_pdcp*                    leg_rlc,
+                            uint16_t                               leg_rnti,
+                            uint32_t                               leg_lcid,
+                            const srsran::pdcp_split_bearer_cfg_t& split_cfg);
+  void del_split_bearer_leg(uint16_t rnti, uint32_t lcid);
+  /// Marks the RLC bearer "lcid" of "rnti" as secondary leg of the split bearer "owner_lcid" of user "owner_rnti" in
+  /// "owner". The UL PDUs and delivery notifications of that RLC bearer are then forwarded to the owner PDCP
+  void add_split_bearer_owner(uint16_t            rnti,
+                              uint32_t            lcid,
+                              pdcp_interface_rlc* owner,
+                              uint16_t            owner_rnti,
+                              uint32_t            owner_lcid);
+  void del_split_bearer_owner(uint16_t rnti, uint32_t lcid);
+
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
 
@@ -82,11 +102,12 @@ private:
     uint16_t                    rnti;
     srsenb::rlc_interface_pdcp* rlc;
     // rlc_interface_pdcp
-    void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu);
-    void discard_sdu(uint32_t lcid, uint32_t discard_sn);
-    bool rb_is_um(uint32_t lcid);
-    bool sdu_queue_is_full(uint32_t lcid);
-    bool is_suspended(uint32_t lcid);
+    void     write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu);
+    void     discard_sdu(uint32_t lcid, uint32_t discard_sn);
+    bool     rb_is_um(uint32_t lcid);
+    bool     sdu_queue_is_full(uint32_t lcid);
+    bool     is_suspended(uint32_t lcid);
+    uint32_t get_buffer_state(uint32_t lcid);
   };
 
   class user_interface_gtpu : public srsue::gw_interface_pdcp
@@ -114,6 +135,13 @@ private:
     const char* get_rb_name(uint32_t lcid);
   };
 
+  /// PDCP that owns the split bearer of an RLC bearer of this user
+  struct split_bearer_owner_t {
+    pdcp_interface_rlc* pdcp;
+    uint16_t            rnti;
+    uint32_t            lcid;
+  };
+
   class user_interface
   {
   public:
@@ -121,10 +149,23 @@ private:
     user_interface_gtpu           gtpu_itf;
     user_interface_rrc            rrc_itf;
     unique_rnti_ptr<srsran::pdcp> pdcp;
+
+    /// Secondary RLC legs of the split bearers of the user, indexed by LCID
+    std::map<uint32_t, user_interface_rlc> split_leg_itfs;
+    /// Owners of the split bearers whose secondary leg is an RLC bearer of the user, indexed by the RLC LCID
+    std::map<uint32_t, split_bearer_owner_t> split_leg_owners;
   };
 
   void clear_user(user_interface* ue);
 
+  /// Returns the owner of the split bearer of the RLC bearer "lcid" of "rnti", or nullptr if it is not a secondary leg
+  const split_bearer_owner_t* get_split_bearer_owner(uint16_t rnti, uint32_t lcid);
+
+  // The users and their bearer configuration are only modified by the stack thread, under a write lock. The data PDUs
+  // of LTE DRBs are received under a read lock, as they may be pushed from the MAC UL PDU workers. The write sections
+  // may take the RLC read lock, which the workers hold in turn. This cannot deadlock, as RLC is also only write locked
+  // by the stack thread
+  pthread_rwlock_t                   rwlock = {};
   std::map<uint32_t, user_interface> users;
 
   rlc_interface_pdcp*       rlc  = nullptr;
@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsran/common/task_scheduler.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
@@ -52,6 +53,11 @@ public:
   void stop();
   void get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
 
+  /// Called when the UL PDUs are written from UE-plane workers. The user plane PDUs of LTE DRBs are then processed by
+  /// PDCP in the workers, while the other RLC outputs towards PDCP/RRC are forwarded to the stack thread through
+  /// "upper_queue". A null "upper_queue" means that the UL PDUs are written from the stack thread.
+  void set_upper_layer_queue(srsran::task_queue_handle* upper_queue_) { upper_queue = upper_queue_; }
+
   // rlc_interface_rrc
   void clear_buffer(uint16_t rnti);
   void add_user(uint16_t rnti);
@@ -71,6 +77,7 @@ public:
   bool        rb_is_um(uint16_t rnti, uint32_t lcid);
   const char* get_rb_name(uint32_t lcid);
   bool        sdu_queue_is_full(uint16_t rnti, uint32_t lcid);
+  uint32_t    get_buffer_state(uint16_t rnti, uint32_t lcid);
 
   // rlc_interface_mac
   int  read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
@@ -105,11 +112,12 @@ private:
   std::map<uint32_t, user_interface> users;
   std::vector<mch_service_t>         mch_services;
 
-  mac_interface_rlc*     mac  = nullptr;
-  pdcp_interface_rlc*    pdcp = nullptr;
-  rrc_interface_rlc*     rrc  = nullptr;
-  srslog::basic_logger&  logger;
-  srsran::timer_handler* timers = nullptr;
+  mac_interface_rlc*         mac  = nullptr;
+  pdcp_interface_rlc*        pdcp = nullptr;
+  rrc_interface_rlc*         rrc  = nullptr;
+  srslog::basic_logger&      logger;
+  srsran::timer_handler*     timers      = nullptr;
+  srsran::task_queue_handle* upper_queue = nullptr;
 };
 
 } // namespace srsenb
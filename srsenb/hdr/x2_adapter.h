@@ -125,6 +125,31 @@ public:
     nr_stack->sgnb_release_request(nr_rnti);
   }
 
+  /// pdcp_nr_interface_rrc
+  void add_split_bearer_leg(uint16_t                               nr_rnti,
+                            uint32_t                               nr_lcid,
+                            uint16_t                               eutra_rnti,
+                            uint32_t                               eutra_lcid,
+                            const srsran::pdcp_split_bearer_cfg_t& split_cfg) override
+  {
+    if (nr_stack == nullptr or eutra_stack == nullptr) {
+      logger.error("Split bearer requested without EUTRA and NR stacks");
+      return;
+    }
+    // The EUTRA PDCP forwards the UL PDUs and delivery notifications of the EUTRA RLC bearer to the NR stack
+    eutra_stack->add_split_bearer_owner(eutra_rnti, eutra_lcid, nr_stack, nr_rnti, nr_lcid);
+    nr_stack->add_split_bearer_leg(
+        nr_rnti, nr_lcid, eutra_stack->get_split_bearer_leg_rlc(), eutra_rnti, eutra_lcid, split_cfg);
+  }
+  void del_split_bearer_leg(uint16_t nr_rnti, uint32_t nr_lcid, uint16_t eutra_rnti, uint32_t eutra_lcid) override
+  {
+    if (nr_stack == nullptr or eutra_stack == nullptr) {
+      return;
+    }
+    nr_stack->del_split_bearer_leg(nr_rnti, nr_lcid);
+    eutra_stack->del_split_bearer_owner(eutra_rnti, eutra_lcid);
+  }
+
   // pdcp_interface_gtpu
   void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) override
   {
@@ -1815,6 +1815,10 @@ int parse_cfg_files(all_args_t* args_, rrc_cfg_t* rrc_cfg_, rrc_nr_cfg_t* rrc_nr
       rrc_cfg_->endc_cfg.ssb_duration      = asn1::rrc::mtc_ssb_nr_r15_s::ssb_dur_r15_opts::sf1;
       rrc_cfg_->endc_cfg.ssb_ssc           = asn1::rrc::rs_cfg_ssb_nr_r15_s::subcarrier_spacing_ssb_r15_opts::khz15;
       rrc_cfg_->endc_cfg.act_from_b1_event = true; // ENDC will only be activated from B1 measurment
+      rrc_cfg_->endc_cfg.split_bearer      = args_->general.nr_split_bearer;
+      if (rrc_cfg_->endc_cfg.split_bearer) {
+        fprintf(stderr, "Warning: nr_split_bearer is experimental. The UE is not signalled the split bearer\n");
+      }
     }
   }
 
@@ -68,6 +68,9 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
         file << ";cpu_" << std::to_string(i);
       }
 
+      // The PHY load columns go last, so that the position of the previous ones is kept
+      file << ";dl_prb_usage;ul_prb_usage;empty_tti;phy_proc_time;phy_cpu_load";
+
       // Add the new line.
       file << "\n";
     }
@@ -109,9 +112,27 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
     file << std::to_string(m.thread_count) << ";";
 
     // Write the cpu metrics.
-    for (uint32_t i = 0, e = m.cpu_count, last_cpu_index = e - 1; i != e; ++i) {
-      file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
+    for (uint32_t i = 0, e = m.cpu_count; i != e; ++i) {
+      file << float_to_string(m.cpu_load[i], 2);
+    }
+
+    // PHY processing load against the cell load. The usages are averaged over the cells, the processing time of a TTI
+    // includes all of them
+    float dl_prb_usage = 0, ul_prb_usage = 0, empty_tti = 0, phy_proc_time = 0, phy_cpu_load = 0;
+    for (const phy_load_metrics_t& load : metrics.phy_load) {
+      if (load.nof_tti > 0) {
+        dl_prb_usage += load.dl_prb_usage / metrics.phy_load.size();
+        ul_prb_usage += load.ul_prb_usage / metrics.phy_load.size();
+        empty_tti += 100.0f * load.nof_empty_tti / load.nof_tti / metrics.phy_load.size();
+        phy_proc_time += load.proc_time_us;
+        phy_cpu_load += load.cpu_load;
+      }
     }
+    file << float_to_string(dl_prb_usage, 2);
+    file << float_to_string(ul_prb_usage, 2);
+    file << float_to_string(empty_tti, 2);
+    file << float_to_string(phy_proc_time, 2);
+    file << float_to_string(phy_cpu_load, 2, false);
 
     file << "\n";
 
@@ -92,8 +92,25 @@ DECLARE_METRIC_SET("ue_container",
 DECLARE_METRIC("carrier_id", metric_carrier_id, uint32_t, "");
 DECLARE_METRIC("pci", metric_pci, uint32_t, "");
 DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
+DECLARE_METRIC("dl_prb_usage", metric_dl_prb_usage, float, "");
+DECLARE_METRIC("ul_prb_usage", metric_ul_prb_usage, float, "");
+DECLARE_METRIC("empty_tti", metric_empty_tti, float, "");
+DECLARE_METRIC("phy_proc_time", metric_phy_proc_time, float, "");
+DECLARE_METRIC("phy_proc_time_empty", metric_phy_proc_time_empty, float, "");
+DECLARE_METRIC("phy_cpu_load", metric_phy_cpu_load, float, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
-DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
+DECLARE_METRIC_SET("cell_container",
+                   mset_cell_container,
+                   metric_carrier_id,
+                   metric_pci,
+                   metric_nof_rach,
+                   metric_dl_prb_usage,
+                   metric_ul_prb_usage,
+                   metric_empty_tti,
+                   metric_phy_proc_time,
+                   metric_phy_proc_time_empty,
+                   metric_phy_cpu_load,
+                   mlist_ues);
 
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
@@ -223,6 +240,17 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     cell.write<metric_nof_rach>(m.stack.mac.cc_info[cc_idx].cc_rach_counter);
     cell.write<metric_pci>(m.stack.mac.cc_info[cc_idx].pci);
 
+    // PHY processing load against the cell load.
+    if (cc_idx < m.phy_load.size() && m.phy_load[cc_idx].nof_tti > 0) {
+      const phy_load_metrics_t& load = m.phy_load[cc_idx];
+      cell.write<metric_dl_prb_usage>(load.dl_prb_usage);
+      cell.write<metric_ul_prb_usage>(load.ul_prb_usage);
+      cell.write<metric_empty_tti>(100.0f * load.nof_empty_tti / load.nof_tti);
+      cell.write<metric_phy_proc_time>(load.proc_time_us);
+      cell.write<metric_phy_proc_time_empty>(load.proc_time_empty_us);
+      cell.write<metric_phy_cpu_load>(load.cpu_load);
+    }
+
     // For each UE in this cell...
     for (unsigned i = 0; i != m.stack.rrc.ues.size(); ++i) {
       if (!has_valid_metric_ranges(m, i)) {
@@ -66,6 +66,14 @@ cc_worker::~cc_worker()
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
   srsran_enb_dl_free(&enb_dl);
   srsran_enb_ul_free(&enb_ul);
+  for (srsran_pdsch_t& pdsch : lane_pdsch) {
+    srsran_pdsch_free(&pdsch);
+  }
+  for (pusch_lane_t& lane : lane_pusch) {
+    srsran_chest_ul_free(&lane.chest);
+    srsran_chest_ul_res_free(&lane.chest_res);
+    srsran_pusch_free(&lane.pusch);
+  }
 
   for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
     if (signal_buffer_rx[p]) {
@@ -122,6 +130,14 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     ERROR("Error setting the CFR");
     return;
   }
+  lane_pdsch.resize(phy->nof_ue_task_lanes() - 1);
+  for (srsran_pdsch_t& pdsch : lane_pdsch) {
+    if (srsran_pdsch_init_enb(&pdsch, nof_prb) < SRSRAN_SUCCESS or
+        srsran_pdsch_set_cell(&pdsch, cell) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating PDSCH encoder (cc=%d)", cc_idx);
+      return;
+    }
+  }
   if (srsran_enb_ul_init(&enb_ul, signal_buffer_rx[0], nof_prb)) {
     ERROR("Error initiating ENB UL");
     return;
@@ -131,6 +147,18 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     ERROR("Error initiating ENB UL");
     return;
   }
+  lane_pusch.resize(phy->nof_ue_task_lanes() - 1);
+  for (pusch_lane_t& lane : lane_pusch) {
+    if (srsran_chest_ul_init(&lane.chest, nof_prb) < SRSRAN_SUCCESS or
+        srsran_chest_ul_res_init(&lane.chest_res, nof_prb) < SRSRAN_SUCCESS or
+        srsran_pusch_init_enb(&lane.pusch, nof_prb) < SRSRAN_SUCCESS or
+        srsran_chest_ul_set_cell(&lane.chest, cell) < SRSRAN_SUCCESS or
+        srsran_pusch_set_cell(&lane.pusch, cell) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating PUSCH receiver (cc=%d)", cc_idx);
+      return;
+    }
+    srsran_chest_ul_pregen(&lane.chest, &phy->dmrs_pusch_cfg, nullptr);
+  }
 
   /* Setup SI-RNTI in PHY */
   add_rnti(SRSRAN_SIRNTI);
@@ -155,6 +183,10 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
   if (phy->params.pusch_8bit_decoder) {
     enb_ul.pusch.llr_is_8bit        = true;
     enb_ul.pusch.ul_sch.llr_is_8bit = true;
+    for (pusch_lane_t& lane : lane_pusch) {
+      lane.pusch.llr_is_8bit        = true;
+      lane.pusch.ul_sch.llr_is_8bit = true;
+    }
   }
   initiated = true;
 
@@ -215,17 +247,90 @@ uint32_t cc_worker::get_nof_rnti()
 void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  ul_sf = ul_sf_cfg;
+  auto                        t_start = std::chrono::steady_clock::now();
+  ul_sf                               = ul_sf_cfg;
   logger.set_context(ul_sf.tti);
 
-  // Process UL signal
-  srsran_enb_ul_fft(&enb_ul);
+  // Find the UEs expected to transmit PUCCH or SRS in this TTI
+  select_pucch();
+  select_srs();
+
+  // Nothing is received in TTIs without PUSCH, PUCCH nor SRS, so the signal is not even demodulated
+  tti_ul_empty = ul_grants.nof_grants == 0 and pucch_rx.empty() and srs_cfg.empty();
+  tti_ul_prb   = 0;
+  if (not tti_ul_empty) {
+    // Process UL signal
+    srsran_enb_ul_fft(&enb_ul);
+
+    // Decode pending UL grants for the tti they were scheduled
+    decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
+
+    // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
+    decode_pucch();
+
+    // Measure the SRS of all the UEs that transmit it in this TTI
+    decode_srs();
+  }
+
+  tti_proc_time = std::chrono::steady_clock::now() - t_start;
+}
+
+void cc_worker::select_srs()
+{
+  srs_rnti.clear();
+  srs_cfg.clear();
+  for (auto& iter : ue_db) {
+    uint16_t rnti = iter.first;
+    if (not SRSRAN_RNTI_ISUSER(rnti) or not phy->ue_db.is_pcell(rnti, cc_idx)) {
+      continue;
+    }
 
-  // Decode pending UL grants for the tti they were scheduled
-  decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
+    srsran_ul_cfg_t ul_cfg = {};
+    if (phy->ue_db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS) {
+      Error("Error retrieving last UL configuration for RNTI %x, CC %d", rnti, cc_idx);
+      continue;
+    }
+
+    if (ul_cfg.srs.configured and
+        srsran_refsignal_srs_send_cs(ul_cfg.srs.subframe_config, tti_rx % SRSRAN_NOF_SF_X_FRAME) == 1 and
+        srsran_refsignal_srs_send_ue(ul_cfg.srs.I_srs, tti_rx) == 1) {
+      srs_rnti.push_back(rnti);
+      srs_cfg.push_back(ul_cfg.srs);
+    }
+  }
+}
 
-  // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
-  decode_pucch();
+void cc_worker::decode_srs()
+{
+  if (srs_cfg.empty()) {
+    return;
+  }
+
+  // All the UEs are measured in a single pass, with one IFFT per group of UEs sounding the same subcarriers
+  srs_res.resize(srs_cfg.size());
+  if (srsran_enb_ul_get_srs(
+          &enb_ul, &ul_sf, &phy->dmrs_pusch_cfg, srs_cfg.data(), srs_cfg.size(), srs_res.data()) < SRSRAN_SUCCESS) {
+    Error("Error measuring SRS");
+    return;
+  }
+
+  for (uint32_t i = 0; i < srs_rnti.size(); i++) {
+    const srsran_chest_ul_srs_res_t& res = srs_res[i];
+    phy->stack->ul_sb_snr_info(tti_rx,
+                               srs_rnti[i],
+                               cc_idx,
+                               res.prb_start,
+                               SRSRAN_CHEST_UL_SRS_SB_NOF_PRB,
+                               srsran::span<const float>(res.sb_snr_db, res.nof_sb));
+    Debug("SRS: rnti=0x%x, cc=%d, prb_start=%d, nof_sb=%d, snr=%.1f dB, noise=%.1f dBfs, ta=%.2f us",
+          srs_rnti[i],
+          cc_idx,
+          res.prb_start,
+          res.nof_sb,
+          res.snr_db,
+          res.noise_estimate_dbFs,
+          res.ta_us);
+  }
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
@@ -234,7 +339,9 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         srsran_mbsfn_cfg_t*                  mbsfn_cfg)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  dl_sf = dl_sf_cfg;
+  auto                        t_start = std::chrono::steady_clock::now();
+  dl_sf                               = dl_sf_cfg;
+  tti_dl_prb                          = 0;
 
   // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
   srsran_enb_dl_put_base(&enb_dl, &dl_sf);
@@ -281,23 +388,28 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
     // clear measurement flag on cell
     phy->clear_cell_measure_trigger(cc_idx);
   }
+
+  tti_proc_time += std::chrono::steady_clock::now() - t_start;
+  metrics_tti(tti_ul_empty and dl_sf_cfg.sf_type == SRSRAN_SF_NORM and dl_grants.nof_grants == 0 and
+              ul_grants.nof_grants == 0 and ul_grants.nof_phich == 0);
 }
 
-bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                                  srsran_ul_cfg_t&                           ul_cfg,
-                                  srsran_pusch_res_t&                        pusch_res)
+bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_rx_t& rx, uint32_t lane)
 {
-  uint16_t rnti = ul_grant.dci.rnti;
+  uint16_t         rnti   = ul_grant.dci.rnti;
+  srsran_ul_cfg_t& ul_cfg = rx.ul_cfg;
 
   // Invalid RNTI
   if (rnti == SRSRAN_INVALID_RNTI) {
     return false;
   }
 
-  // RNTI does not exist
-  if (ue_db.count(rnti) == 0) {
+  // RNTI does not exist. The worker lock is held during the whole TTI, so the UE remains valid while it is decoded
+  auto ue_it = ue_db.find(rnti);
+  if (ue_it == ue_db.end()) {
     return false;
   }
+  ue& user = *ue_it->second;
 
   // Get UE configuration
   if (phy->ue_db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS) {
@@ -307,7 +419,7 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // Fill UCI configuration
-  bool uci_required =
+  rx.uci_required =
       phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, ul_grant.dci.cqi_request, true, ul_cfg.pusch.uci_cfg);
 
   // Compute UL grant
@@ -338,20 +450,43 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     Error("Error setting last UL TB for RNTI %x, CC %d, PID %d", rnti, cc_idx, ul_grant.pid);
   }
 
-  // Run PUSCH decoder
+  // Select the PUSCH receiver of the lane
+  srsran_chest_ul_t*     chest     = lane == 0 ? &enb_ul.chest : &lane_pusch[lane - 1].chest;
+  srsran_chest_ul_res_t* chest_res = lane == 0 ? &enb_ul.chest_res : &lane_pusch[lane - 1].chest_res;
+  srsran_pusch_t*        pusch     = lane == 0 ? &enb_ul.pusch : &lane_pusch[lane - 1].pusch;
+
+  // Run PUSCH decoder, the grant soft-buffer is only used by this task
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
-  pusch_res.data              = ul_grant.data;
-  if (pusch_res.data) {
-    if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
+  rx.res.data                 = ul_grant.data;
+  if (rx.res.data) {
+    srsran_chest_ul_estimate_pusch(chest, &ul_sf, &ul_cfg.pusch, enb_ul.sf_symbols, chest_res);
+    if (srsran_pusch_decode(pusch, &ul_sf, &ul_cfg.pusch, chest_res, enb_ul.sf_symbols, &rx.res)) {
       Error("Decoding PUSCH for RNTI %x", rnti);
       return false;
     }
   }
+  rx.chest_res = *chest_res;
+
   // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
-  ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
-  ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
+  user.phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
+  user.phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
 
-  float snr_db = enb_ul.chest_res.snr_db;
+  // Save statistics only if data was provided
+  if (ul_grant.data != nullptr) {
+    // Save metrics stats
+    user.metrics_ul(ul_grant.dci.tb.mcs_idx,
+                    rx.chest_res.epre_dBfs - phy->params.rx_gain_offset,
+                    rx.chest_res.snr_db,
+                    rx.res.avg_iterations_block);
+  }
+  return true;
+}
+
+void cc_worker::report_pusch(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_rx_t& rx)
+{
+  uint16_t         rnti   = ul_grant.dci.rnti;
+  srsran_ul_cfg_t& ul_cfg = rx.ul_cfg;
+  float            snr_db = rx.chest_res.snr_db;
 
   // Notify MAC of RL status
   if (snr_db >= PUSCH_RL_SNR_DB_TH) {
@@ -359,78 +494,66 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
 
     // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
-    if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and not std::isinf(enb_ul.chest_res.ta_us)) {
-      phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+    if (ul_cfg.pusch.meas_ta_en and not std::isnan(rx.chest_res.ta_us) and not std::isinf(rx.chest_res.ta_us)) {
+      phy->stack->ta_info(ul_sf.tti, rnti, rx.chest_res.ta_us);
     }
   }
 
   // Send UCI data to MAC
-  if (uci_required) {
-    phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
+  if (rx.uci_required) {
+    phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, rx.res.uci);
   }
 
-  // Save statistics only if data was provided
+  // Notify MAC new received data and HARQ Indication value
   if (ul_grant.data != nullptr) {
-    // Save metrics stats
-    ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx,
-                            enb_ul.chest_res.epre_dBfs - phy->params.rx_gain_offset,
-                            enb_ul.chest_res.snr_db,
-                            pusch_res.avg_iterations_block);
+    // Inform MAC about the CRC result
+    phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, rx.res.crc);
+    // Push PDU buffer
+    phy->stack->push_pdu(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, rx.res.crc, ul_cfg.pusch.grant.L_prb);
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pusch_rx_info(&ul_cfg.pusch, &rx.res, &rx.chest_res, str, sizeof(str));
+      logger.info("PUSCH: cc=%d, %s", cc_idx, str);
+    }
   }
-  return true;
 }
 
 void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
 {
-  // Iterate over all the grants, all the grants need to report MAC the CRC status
-  for (uint32_t i = 0; i < nof_pusch; i++) {
-    // Get grant itself and RNTI
-    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = grants[i];
-    uint16_t                                   rnti     = ul_grant.dci.rnti;
+  // The grants are decoded in parallel, one receiver per lane
+  pusch_rx.assign(nof_pusch, pusch_rx_t{});
+  phy->run_ue_tasks(nof_pusch, [this, grants](uint32_t i, uint32_t lane) {
+    pusch_rx[i].valid = decode_pusch_rnti(grants[i], pusch_rx[i], lane);
+  });
 
-    srsran_pusch_res_t pusch_res = {};
-    srsran_ul_cfg_t    ul_cfg    = {};
-
-    // Decodes PUSCH for the given grant
-    if (!decode_pusch_rnti(ul_grant, ul_cfg, pusch_res)) {
-      return;
-    }
-
-    // Notify MAC new received data and HARQ Indication value
-    if (ul_grant.data != nullptr) {
-      // Inform MAC about the CRC result
-      phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
-      // Push PDU buffer
-      phy->stack->push_pdu(
-          tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc, ul_cfg.pusch.grant.L_prb);
-      // Logging
-      if (logger.info.enabled()) {
-        char str[512];
-        srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &enb_ul.chest_res, str, sizeof(str));
-        logger.info("PUSCH: cc=%d, %s", cc_idx, str);
-      }
+  // Iterate over all the grants in order, all the grants need to report MAC the CRC status
+  for (uint32_t i = 0; i < nof_pusch; i++) {
+    if (pusch_rx[i].valid) {
+      report_pusch(grants[i], pusch_rx[i]);
+      tti_ul_prb += pusch_rx[i].ul_cfg.pusch.grant.L_prb;
     }
   }
 }
 
-int cc_worker::decode_pucch()
+void cc_worker::select_pucch()
 {
-  srsran_pucch_res_t pucch_res = {};
-
+  pucch_rx.clear();
   for (auto& iter : ue_db) {
     uint16_t rnti = iter.first;
 
     // If it's a User RNTI and doesn't have PUSCH grant in this TTI
     if (SRSRAN_RNTI_ISUSER(rnti) and phy->ue_db.is_pcell(rnti, cc_idx)) {
-      srsran_ul_cfg_t ul_cfg = {};
+      pucch_rx_t rx = {};
+      rx.rnti       = rnti;
 
-      if (phy->ue_db.get_ul_config(rnti, cc_idx, ul_cfg) < SRSRAN_SUCCESS) {
+      if (phy->ue_db.get_ul_config(rnti, cc_idx, rx.ul_cfg) < SRSRAN_SUCCESS) {
         Error("Error retrieving last UL configuration for RNTI %x, CC %d", rnti, cc_idx);
         continue;
       }
 
       // Check if user needs to receive PUCCH
-      int ret = phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, false, false, ul_cfg.pucch.uci_cfg);
+      int ret = phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, false, false, rx.ul_cfg.pucch.uci_cfg);
       if (ret < SRSRAN_SUCCESS) {
         Error("Error retrieving UCI configuration for RNTI %x, CC %d", rnti, cc_idx);
         continue;
@@ -438,37 +561,49 @@ int cc_worker::decode_pucch()
 
       // If ret is more than success, UCI is present
       if (ret > SRSRAN_SUCCESS) {
-        // Decode PUCCH
-        if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
-          Error("Error getting PUCCH");
-          continue;
-        }
+        pucch_rx.push_back(rx);
+      }
+    }
+  }
+}
 
-        // Send UCI data to MAC
-        if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
-          Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
-          continue;
-        }
+int cc_worker::decode_pucch()
+{
+  srsran_pucch_res_t pucch_res = {};
 
-        if (pucch_res.detected and pucch_res.ta_valid) {
-          phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
-          phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
-        }
+  for (pucch_rx_t& rx : pucch_rx) {
+    uint16_t         rnti   = rx.rnti;
+    srsran_ul_cfg_t& ul_cfg = rx.ul_cfg;
 
-        // Logging
-        if (logger.info.enabled()) {
-          char str[512];
-          srsran_pucch_rx_info(&ul_cfg.pucch, &pucch_res, str, sizeof(str));
-          logger.info("PUCCH: cc=%d; %s", cc_idx, str);
-        }
+    // Decode PUCCH
+    if (srsran_enb_ul_get_pucch(&enb_ul, &ul_sf, &ul_cfg.pucch, &pucch_res)) {
+      Error("Error getting PUCCH");
+      continue;
+    }
 
-        // Save metrics
-        if (pucch_res.detected) {
-          ue_db[rnti]->metrics_ul_pucch(pucch_res.rssi_dbFs - phy->params.rx_gain_offset,
-                                        pucch_res.ni_dbFs - -phy->params.rx_gain_offset,
-                                        pucch_res.snr_db);
-        }
-      }
+    // Send UCI data to MAC
+    if (phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pucch.uci_cfg, pucch_res.uci_data) < SRSRAN_SUCCESS) {
+      Error("Error sending UCI data for RNTI %x, CC %d", rnti, cc_idx);
+      continue;
+    }
+
+    if (pucch_res.detected and pucch_res.ta_valid) {
+      phy->stack->ta_info(tti_rx, rnti, pucch_res.ta_us);
+      phy->stack->snr_info(tti_rx, rnti, cc_idx, pucch_res.snr_db, mac_interface_phy_lte::PUCCH);
+    }
+
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pucch_rx_info(&ul_cfg.pucch, &pucch_res, str, sizeof(str));
+      logger.info("PUCCH: cc=%d; %s", cc_idx, str);
+    }
+
+    // Save metrics
+    if (pucch_res.detected) {
+      ue_db.at(rnti)->metrics_ul_pucch(pucch_res.rssi_dbFs - phy->params.rx_gain_offset,
+                                       pucch_res.ni_dbFs - -phy->params.rx_gain_offset,
+                                       pucch_res.snr_db);
     }
   }
   return 0;
@@ -477,14 +612,16 @@ int cc_worker::decode_pucch()
 int cc_worker::encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks)
 {
   for (uint32_t i = 0; i < nof_acks; i++) {
-    if (acks[i].rnti && ue_db.count(acks[i].rnti)) {
-      srsran_enb_dl_put_phich(&enb_dl, &ue_db[acks[i].rnti]->phich_grant, acks[i].ack);
+    auto it = ue_db.find(acks[i].rnti);
+    if (acks[i].rnti && it != ue_db.end()) {
+      srsran_phich_grant_t& phich_grant = it->second->phich_grant;
+      srsran_enb_dl_put_phich(&enb_dl, &phich_grant, acks[i].ack);
 
       Info("PHICH: rnti=0x%x, hi=%d, I_lowest=%d, n_dmrs=%d, tti_tx_dl=%d",
            acks[i].rnti,
            acks[i].ack,
-           ue_db[acks[i].rnti]->phich_grant.n_prb_lowest,
-           ue_db[acks[i].rnti]->phich_grant.n_dmrs,
+           phich_grant.n_prb_lowest,
+           phich_grant.n_dmrs,
            tti_tx_dl);
     }
   }
@@ -595,58 +732,97 @@ int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srs
 
 int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants)
 {
-  /* Scales the Resources Elements affected by the power allocation (p_b) */
-  // srsran_enb_dl_prepare_power_allocation(&enb_dl);
+  // The PDSCH grants are computed first, so that the power allocation (p_b), which scales whole OFDM symbols shared by
+  // all the grants, is applied once before any PDSCH is mapped. It uses the p_b of the first grant with power scaling
+  pdsch_tx.assign(nof_grants, pdsch_tx_t{});
+  const srsran_pdsch_cfg_t* rho_b_cfg = nullptr;
   for (uint32_t i = 0; i < nof_grants; i++) {
-    uint16_t rnti = grants[i].dci.rnti;
+    pdsch_tx_t& tx = pdsch_tx[i];
+    if (not prepare_pdsch_grant(grants[i], tx)) {
+      continue;
+    }
+    if (rho_b_cfg == nullptr and tx.dl_cfg.pdsch.power_scale) {
+      rho_b_cfg = &tx.dl_cfg.pdsch;
+    }
+    tx.dl_cfg.pdsch.rho_b_applied = true;
+  }
+  if (rho_b_cfg != nullptr) {
+    srsran_pdsch_apply_rho_b(&enb_dl.pdsch, rho_b_cfg, enb_dl.sf_symbols);
+  }
 
-    if (rnti && ue_db.count(rnti)) {
-      srsran_dl_cfg_t dl_cfg = {};
+  // The grants use disjoint resource elements, so they are encoded and mapped in parallel, one encoder per lane
+  std::atomic<bool> error{false};
+  phy->run_ue_tasks(nof_grants, [this, grants, &error](uint32_t i, uint32_t lane) {
+    srsran_pdsch_t* pdsch = lane == 0 ? &enb_dl.pdsch : &lane_pdsch[lane - 1];
+    if (pdsch_tx[i].user != nullptr and encode_pdsch_grant(grants[i], i, pdsch_tx[i], pdsch) < SRSRAN_SUCCESS) {
+      error.store(true, std::memory_order_relaxed);
+    }
+  });
 
-      if (phy->ue_db.get_dl_config(rnti, cc_idx, dl_cfg) < SRSRAN_SUCCESS) {
-        Error("Error retrieving DCI DL configuration for RNTI %x, CC %d", grants[i].dci.rnti, cc_idx);
-        continue;
-      }
+  return error ? SRSRAN_ERROR : SRSRAN_SUCCESS;
+}
 
-      // Compute DL grant
-      if (srsran_ra_dl_dci_to_grant(
-              &enb_dl.cell, &dl_sf, dl_cfg.tm, dl_cfg.pdsch.use_tbs_index_alt, &grants[i].dci, &dl_cfg.pdsch.grant)) {
-        Error("Computing DL grant");
-        continue;
-      }
+bool cc_worker::prepare_pdsch_grant(stack_interface_phy_lte::dl_sched_grant_t& grant, pdsch_tx_t& tx)
+{
+  uint16_t rnti = grant.dci.rnti;
+  auto     it   = ue_db.find(rnti);
+  if (rnti == SRSRAN_INVALID_RNTI or it == ue_db.end()) {
+    Error("User rnti=0x%x not found in cc_worker=%d", rnti, cc_idx);
+    return false;
+  }
 
-      // Set soft buffer
-      for (uint32_t j = 0; j < SRSRAN_MAX_CODEWORDS; j++) {
-        dl_cfg.pdsch.softbuffers.tx[j] = grants[i].softbuffer_tx[j];
-      }
+  srsran_dl_cfg_t& dl_cfg = tx.dl_cfg;
+  if (phy->ue_db.get_dl_config(rnti, cc_idx, dl_cfg) < SRSRAN_SUCCESS) {
+    Error("Error retrieving DCI DL configuration for RNTI %x, CC %d", grant.dci.rnti, cc_idx);
+    return false;
+  }
 
-      // Encode PDSCH
-      if (srsran_enb_dl_put_pdsch(&enb_dl, &dl_cfg.pdsch, grants[i].data)) {
-        Error("Error putting PDSCH %d", i);
-        return SRSRAN_ERROR;
-      }
+  // Compute DL grant
+  if (srsran_ra_dl_dci_to_grant(
+          &enb_dl.cell, &dl_sf, dl_cfg.tm, dl_cfg.pdsch.use_tbs_index_alt, &grant.dci, &dl_cfg.pdsch.grant)) {
+    Error("Computing DL grant");
+    return false;
+  }
 
-      // Save pending ACK
-      if (SRSRAN_RNTI_ISUSER(rnti)) {
-        // Push whole DCI
-        phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, grants[i].dci);
-      }
+  // Set soft buffer
+  for (uint32_t j = 0; j < SRSRAN_MAX_CODEWORDS; j++) {
+    dl_cfg.pdsch.softbuffers.tx[j] = grant.softbuffer_tx[j];
+  }
 
-      if (LOG_THIS(rnti) and logger.info.enabled()) {
-        // Logging
-        char str[512];
-        srsran_pdsch_tx_info(&dl_cfg.pdsch, str, 512);
-        logger.info("PDSCH: cc=%d, %s, tti_tx_dl=%d", cc_idx, str, tti_tx_dl);
-      }
+  tx.user = it->second;
+  return true;
+}
 
-      // Save metrics stats
-      ue_db[rnti]->metrics_dl(grants[i].dci.tb[0].mcs_idx);
-    } else {
-      Error("User rnti=0x%x not found in cc_worker=%d", rnti, cc_idx);
-    }
+int cc_worker::encode_pdsch_grant(stack_interface_phy_lte::dl_sched_grant_t& grant,
+                                  uint32_t                                   grant_idx,
+                                  pdsch_tx_t&                                tx,
+                                  srsran_pdsch_t*                            pdsch)
+{
+  uint16_t         rnti   = grant.dci.rnti;
+  srsran_dl_cfg_t& dl_cfg = tx.dl_cfg;
+
+  // Encode PDSCH
+  if (srsran_pdsch_encode(pdsch, &enb_dl.dl_sf, &dl_cfg.pdsch, grant.data, enb_dl.sf_symbols)) {
+    Error("Error putting PDSCH %d", grant_idx);
+    return SRSRAN_ERROR;
   }
 
-  // srsran_enb_dl_apply_power_allocation(&enb_dl);
+  // Save pending ACK
+  if (SRSRAN_RNTI_ISUSER(rnti)) {
+    // Push whole DCI
+    phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, grant.dci);
+  }
+
+  if (LOG_THIS(rnti) and logger.info.enabled()) {
+    // Logging
+    char str[512];
+    srsran_pdsch_tx_info(&dl_cfg.pdsch, str, 512);
+    logger.info("PDSCH: cc=%d, %s, tti_tx_dl=%d", cc_idx, str, tti_tx_dl);
+  }
+
+  // Save metrics stats
+  tx.user->metrics_dl(grant.dci.tb[0].mcs_idx);
+  tti_dl_prb += dl_cfg.pdsch.grant.nof_prb;
 
   return SRSRAN_SUCCESS;
 }
@@ -666,6 +842,40 @@ uint32_t cc_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
   return cnt;
 }
 
+void cc_worker::metrics_tti(bool empty)
+{
+  load_metrics.nof_tti++;
+  load_metrics.dl_prb += tti_dl_prb;
+  load_metrics.ul_prb += tti_ul_prb;
+  load_metrics.proc_time += tti_proc_time;
+  if (empty) {
+    load_metrics.nof_empty_tti++;
+    load_metrics.proc_time_empty += tti_proc_time;
+  }
+}
+
+void cc_worker::get_load_metrics(phy_load_metrics_t& metrics)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  metrics = {};
+  if (load_metrics.nof_tti > 0) {
+    using us_t = std::chrono::duration<float, std::micro>;
+
+    // A TTI lasts 1 ms
+    float nof_prb_total   = (float)load_metrics.nof_tti * enb_dl.cell.nof_prb;
+    metrics.nof_tti       = load_metrics.nof_tti;
+    metrics.nof_empty_tti = load_metrics.nof_empty_tti;
+    metrics.dl_prb_usage  = 100.0f * load_metrics.dl_prb / nof_prb_total;
+    metrics.ul_prb_usage  = 100.0f * load_metrics.ul_prb / nof_prb_total;
+    metrics.proc_time_us  = us_t(load_metrics.proc_time).count() / load_metrics.nof_tti;
+    metrics.cpu_load      = 100.0f * metrics.proc_time_us / 1000.0f;
+    if (load_metrics.nof_empty_tti > 0) {
+      metrics.proc_time_empty_us = us_t(load_metrics.proc_time_empty).count() / load_metrics.nof_empty_tti;
+    }
+  }
+  load_metrics = {};
+}
+
 void cc_worker::ue::metrics_read(phy_metrics_t* metrics_)
 {
   if (metrics_) {
@@ -297,6 +297,14 @@ uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
   return cnt;
 }
 
+void sf_worker::get_load_metrics(std::vector<phy_load_metrics_t>& metrics)
+{
+  metrics.resize(cc_workers.size());
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    cc_workers[cc]->get_load_metrics(metrics[cc]);
+  }
+}
+
 void sf_worker::start_plot()
 {
 #ifdef ENABLE_GUI
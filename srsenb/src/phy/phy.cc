@@ -182,6 +182,7 @@ int phy::init_lte(const phy_args_t&            args,
 
   // Add workers to workers pool and start threads
   if (not cfg.phy_cell_cfg.empty()) {
+    workers_common.start_ue_tasks(args.nof_ue_task_threads, WORKERS_THREAD_PRIO);
     lte_workers.init(args, &workers_common, log_sink, WORKERS_THREAD_PRIO);
   }
 
@@ -207,6 +208,7 @@ void phy::stop()
     tx_rx.stop();
     workers_common.stop();
     lte_workers.stop();
+    workers_common.stop_ue_tasks();
     if (nr_workers != nullptr) {
       nr_workers->stop();
     }
@@ -286,6 +288,37 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   }
 }
 
+void phy::get_load_metrics(std::vector<phy_load_metrics_t>& metrics)
+{
+  // Each worker processes a different set of TTIs, the averages of the workers are weighted by their number of TTIs
+  std::vector<phy_load_metrics_t> metrics_tmp;
+  metrics.assign(workers_common.get_nof_carriers_lte(), {});
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    lte_workers[i]->get_load_metrics(metrics_tmp);
+    for (uint32_t cc = 0; cc < std::min(metrics_tmp.size(), metrics.size()); cc++) {
+      phy_load_metrics_t&       m  = metrics[cc];
+      const phy_load_metrics_t& m_ = metrics_tmp[cc];
+      m.dl_prb_usage += m_.nof_tti * m_.dl_prb_usage;
+      m.ul_prb_usage += m_.nof_tti * m_.ul_prb_usage;
+      m.proc_time_us += m_.nof_tti * m_.proc_time_us;
+      m.proc_time_empty_us += m_.nof_empty_tti * m_.proc_time_empty_us;
+      m.nof_tti += m_.nof_tti;
+      m.nof_empty_tti += m_.nof_empty_tti;
+    }
+  }
+  for (phy_load_metrics_t& m : metrics) {
+    if (m.nof_tti > 0) {
+      m.dl_prb_usage /= m.nof_tti;
+      m.ul_prb_usage /= m.nof_tti;
+      m.proc_time_us /= m.nof_tti;
+      m.cpu_load = 100.0f * m.proc_time_us / 1000.0f;
+    }
+    if (m.nof_empty_tti > 0) {
+      m.proc_time_empty_us /= m.nof_empty_tti;
+    }
+  }
+}
+
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
 {
   Info("set_cell_gain: cell_id=%d, gain_db=%.2f", cell_id, gain_db);
@@ -85,6 +85,65 @@ void phy_common::stop()
   semaphore.wait_all();
 }
 
+void phy_common::start_ue_tasks(uint32_t nof_helpers, int32_t prio)
+{
+  if (nof_helpers == 0 or ue_helpers != nullptr) {
+    return;
+  }
+  ue_helpers.reset(new srsran::task_thread_pool(nof_helpers, true));
+  ue_helpers->start(prio);
+  nof_ue_helpers = nof_helpers;
+}
+
+void phy_common::stop_ue_tasks()
+{
+  if (ue_helpers != nullptr) {
+    ue_helpers->stop();
+  }
+}
+
+void phy_common::run_ue_batch_tasks(ue_batch_t& batch, uint32_t lane)
+{
+  uint32_t nof_run = 0;
+  for (uint32_t idx = batch.next_task.fetch_add(1, std::memory_order_relaxed); idx < batch.nof_tasks;
+       idx          = batch.next_task.fetch_add(1, std::memory_order_relaxed)) {
+    batch.func(batch.ctx, idx, lane);
+    nof_run++;
+  }
+  if (nof_run > 0) {
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    batch.nof_done += nof_run;
+    if (batch.nof_done == batch.nof_tasks) {
+      batch.cvar.notify_one();
+    }
+  }
+}
+
+void phy_common::run_ue_batch(uint32_t nof_tasks, ue_task_func_t func, void* ctx)
+{
+  if (nof_tasks == 0) {
+    return;
+  }
+  auto batch       = std::make_shared<ue_batch_t>();
+  batch->nof_tasks = nof_tasks;
+  batch->func      = func;
+  batch->ctx       = ctx;
+
+  // One helper task per lane, unless there is nobody to help. A helper only calls the task function after it has
+  // taken a task index, i.e. while the caller is still waiting for the batch to finish. The helper tasks are pushed
+  // with high priority and run in FIFO order, i.e. the batches are served in the order they were started, not by TTI
+  uint32_t nof_helpers = ue_helpers == nullptr ? 0 : std::min(nof_ue_helpers, nof_tasks - 1);
+  for (uint32_t lane = 1; lane <= nof_helpers; ++lane) {
+    ue_helpers->push_task([batch, lane]() { run_ue_batch_tasks(*batch, lane); },
+                          srsran::task_thread_pool::task_priority::high);
+  }
+
+  // The caller works on its own batch until no task is left, then waits for the tasks taken by the helpers
+  run_ue_batch_tasks(*batch, 0);
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->cvar.wait(lock, [&batch]() { return batch->nof_done == batch->nof_tasks; });
+}
+
 void phy_common::clear_grants(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(grant_mutex);
@@ -105,10 +105,14 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   }
 
   if (args.mac_pcap_net.enable) {
+    srsran::mac_pcap_net_batch_cfg_t batch_cfg;
+    batch_cfg.enable = args.mac_pcap_net.batch_enable;
     mac_pcap_net.open(args.mac_pcap_net.client_ip,
                       args.mac_pcap_net.bind_ip,
                       args.mac_pcap_net.client_port,
-                      args.mac_pcap_net.bind_port);
+                      args.mac_pcap_net.bind_port,
+                      0,
+                      batch_cfg);
     mac.start_pcap_net(&mac_pcap_net);
   }
 
@@ -134,8 +138,10 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     return SRSRAN_ERROR;
   }
   rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
+  // RLC may be fed by the MAC UL PDU workers. Its outputs that are not handled in the workers go to the stack thread
+  rlc.set_upper_layer_queue(mac.get_ul_worker_stack_queue());
   pdcp.init(&rlc, &rrc, gtpu_adapter.get());
-  if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
+  if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
   }
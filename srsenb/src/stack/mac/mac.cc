@@ -24,6 +24,7 @@
 
 #include "srsenb/hdr/stack/mac/mac.h"
 #include "srsran/adt/pool/obj_pool.h"
+#include "srsran/common/epoch_guard.h"
 #include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/time_prof.h"
@@ -40,14 +41,14 @@ namespace srsenb {
 mac::mac(srsran::ext_task_sched_handle task_sched_, srslog::basic_logger& logger) :
   logger(logger), rar_payload(), common_buffers(SRSRAN_MAX_CARRIERS), task_sched(task_sched_)
 {
-  pthread_rwlock_init(&rwlock, nullptr);
+  pthread_rwlock_init(&cfg_rwlock, nullptr);
   stack_task_queue = task_sched.make_task_queue();
 }
 
 mac::~mac()
 {
   stop();
-  pthread_rwlock_destroy(&rwlock);
+  pthread_rwlock_destroy(&cfg_rwlock);
 }
 
 bool mac::init(const mac_args_t&        args_,
@@ -90,45 +91,63 @@ bool mac::init(const mac_args_t&        args_,
 
   detected_rachs.resize(cells.size());
 
+  // Start UE-plane workers for UL PDU processing
+  if (args.nof_ul_pdu_workers > 0) {
+    ul_worker_stack_queue = task_sched.make_task_queue();
+  }
+  for (uint32_t i = 0; i < args.nof_ul_pdu_workers; ++i) {
+    ul_pdu_workers.emplace_back(new srsran::task_worker("MAC_UL" + std::to_string(i), ul_pdu_worker_queue_size));
+  }
+
   started = true;
   return true;
 }
 
 void mac::stop()
 {
-  srsran::rwlock_write_guard lock(rwlock);
-  if (started) {
+  {
+    // Once started is cleared under the lock, allocate_ue() cannot add UEs to the ue_db anymore
+    std::lock_guard<std::mutex> lock(ue_alloc_mutex);
+    if (not started) {
+      return;
+    }
     started = false;
+  }
 
-    ue_db.clear();
-    for (auto& cc : common_buffers) {
-      for (int i = 0; i < NOF_BCCH_DLSCH_MSG; i++) {
-        srsran_softbuffer_tx_free(&cc.bcch_softbuffer_tx[i]);
-      }
-      srsran_softbuffer_tx_free(&cc.pcch_softbuffer_tx);
-      srsran_softbuffer_tx_free(&cc.rar_softbuffer_tx);
+  // Stop the UL PDU workers. The PDUs still waiting in their queues are discarded, and so are the tasks posted to the
+  // stack thread, which would otherwise keep a worker waiting for room in the queue
+  ul_worker_stack_queue.deactivate();
+  for (auto& w : ul_pdu_workers) {
+    w->stop();
+  }
+  ul_pdu_workers.clear();
+
+  ue_db.clear();
+  // Wait for PHY workers to release the removed UEs
+  ue_db.synchronize();
+  for (auto& cc : common_buffers) {
+    for (int i = 0; i < NOF_BCCH_DLSCH_MSG; i++) {
+      srsran_softbuffer_tx_free(&cc.bcch_softbuffer_tx[i]);
     }
+    srsran_softbuffer_tx_free(&cc.pcch_softbuffer_tx);
+    srsran_softbuffer_tx_free(&cc.rar_softbuffer_tx);
   }
 }
 
 void mac::start_pcap(srsran::mac_pcap* pcap_)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
   pcap = pcap_;
   // Set pcap in all UEs for UL messages
-  for (auto& u : ue_db) {
-    u.second->start_pcap(pcap);
-  }
+  ue_db.for_each([this](uint16_t rnti, unique_rnti_ptr<ue>& u) { u->start_pcap(pcap); });
 }
 
 void mac::start_pcap_net(srsran::mac_pcap_net* pcap_net_)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
   pcap_net = pcap_net_;
   // Set pcap in all UEs for UL messages
-  for (auto& u : ue_db) {
-    u.second->start_pcap_net(pcap_net);
-  }
+  ue_db.for_each([this](uint16_t rnti, unique_rnti_ptr<ue>& u) { u->start_pcap_net(pcap_net); });
 }
 
 /********************************************************
@@ -139,12 +158,13 @@ void mac::start_pcap_net(srsran::mac_pcap_net* pcap_net_)
 
 int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
   int                       ret = -1;
-  if (check_ue_active(rnti)) {
+  if (get_active_ue(rnti) != nullptr) {
     if (rnti != SRSRAN_MRNTI) {
       ret = scheduler.dl_rlc_buffer_state(rnti, lc_id, tx_queue, retx_queue);
     } else {
+      srsran::rwlock_read_guard cfg_lock(cfg_rwlock);
       for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
         if (lc_id == mch.mtch_sched[i].lcid) {
           mch.mtch_sched[i].lcid_buffer_size = tx_queue;
@@ -158,14 +178,14 @@ int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint
 
 int mac::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  return check_ue_active(rnti) ? scheduler.bearer_ue_cfg(rnti, lc_id, *cfg) : -1;
+  srsran::epoch_read_guard lock;
+  return get_active_ue(rnti) != nullptr ? scheduler.bearer_ue_cfg(rnti, lc_id, *cfg) : -1;
 }
 
 int mac::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  return check_ue_active(rnti) ? scheduler.bearer_ue_rem(rnti, lc_id) : -1;
+  srsran::epoch_read_guard lock;
+  return get_active_ue(rnti) != nullptr ? scheduler.bearer_ue_rem(rnti, lc_id) : -1;
 }
 
 void mac::phy_config_enabled(uint16_t rnti, bool enabled)
@@ -176,11 +196,11 @@ void mac::phy_config_enabled(uint16_t rnti, bool enabled)
 // Update UE configuration
 int mac::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t* cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  if (not check_ue_active(rnti)) {
+  srsran::epoch_read_guard lock;
+  ue* ue_ptr = get_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
-  ue* ue_ptr = ue_db[rnti].get();
 
   // Start TA FSM in UE entity
   ue_ptr->start_ta();
@@ -202,9 +222,10 @@ int mac::ue_rem(uint16_t rnti)
 {
   // Remove UE from the perspective of L2/L3
   {
-    srsran::rwlock_read_guard lock(rwlock);
-    if (check_ue_active(rnti)) {
-      ue_db[rnti]->set_active(false);
+    srsran::epoch_read_guard lock;
+    ue* ue_ptr = get_active_ue(rnti);
+    if (ue_ptr != nullptr) {
+      ue_ptr->set_active(false);
     } else {
       logger.error("User rnti=0x%x not found", rnti);
       return SRSRAN_ERROR;
@@ -216,9 +237,9 @@ int mac::ue_rem(uint16_t rnti)
   // Note: Let any pending retx ACK to arrive, so that PHY recognizes rnti
   task_sched.defer_callback(FDD_HARQ_DELAY_DL_MS + FDD_HARQ_DELAY_UL_MS, [this, rnti]() {
     phy_h->rem_rnti(rnti);
-    srsran::rwlock_write_guard lock(rwlock);
     ue_db.erase(rnti);
     logger.info("User rnti=0x%x removed from MAC/PHY", rnti);
+    reclaim_removed_ues();
   });
   return SRSRAN_SUCCESS;
 }
@@ -226,7 +247,7 @@ int mac::ue_rem(uint16_t rnti)
 // Called after Msg3
 int mac::ue_set_crnti(uint16_t temp_crnti, uint16_t crnti, const sched_interface::ue_cfg_t& cfg)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
   if (temp_crnti == crnti) {
     // Schedule ConRes Msg4
     scheduler.dl_mac_buffer_state(crnti, (uint32_t)srsran::dl_sch_lcid::CON_RES_ID);
@@ -236,26 +257,27 @@ int mac::ue_set_crnti(uint16_t temp_crnti, uint16_t crnti, const sched_interface
 
 int mac::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg_)
 {
-  srsran::rwlock_write_guard lock(rwlock);
+  srsran::rwlock_write_guard cfg_lock(cfg_rwlock);
   cell_config = cell_cfg_;
   return scheduler.cell_cfg(cell_config);
 }
 
 void mac::get_metrics(mac_metrics_t& metrics)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard  lock;
+  srsran::rwlock_read_guard cfg_lock(cfg_rwlock);
   metrics.ues.reserve(ue_db.size());
-  for (auto& u : ue_db) {
-    if (not scheduler.ue_exists(u.first)) {
-      continue;
+  ue_db.for_each([this, &metrics](uint16_t rnti, unique_rnti_ptr<ue>& u) {
+    if (not scheduler.ue_exists(rnti)) {
+      return;
     }
     metrics.ues.emplace_back();
     auto& ue_metrics = metrics.ues.back();
 
-    u.second->metrics_read(&ue_metrics);
-    scheduler.metrics_read(u.first, ue_metrics);
+    u->metrics_read(&ue_metrics);
+    scheduler.metrics_read(rnti, ue_metrics);
     ue_metrics.pci = (ue_metrics.cc_idx < cell_config.size()) ? cell_config[ue_metrics.cc_idx].cell.id : 0;
-  }
+  });
   metrics.cc_info.resize(detected_rachs.size());
   for (unsigned cc = 0, e = detected_rachs.size(); cc != e; ++cc) {
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
@@ -270,13 +292,11 @@ void mac::toggle_padding()
 
 void mac::add_padding()
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  for (auto it = ue_db.begin(); it != ue_db.end(); ++it) {
-    uint16_t cur_rnti = it->first;
-    auto     ue       = it;
-    scheduler.dl_rlc_buffer_state(ue->first, args.lcid_padding, 20e6, 0);
-    ue->second->trigger_padding(args.lcid_padding);
-  }
+  srsran::epoch_read_guard lock;
+  ue_db.for_each([this](uint16_t rnti, unique_rnti_ptr<ue>& u) {
+    scheduler.dl_rlc_buffer_state(rnti, args.lcid_padding, 20e6, 0);
+    u->trigger_padding(args.lcid_padding);
+  });
 }
 
 /********************************************************
@@ -288,14 +308,15 @@ void mac::add_padding()
 int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  ue* ue_ptr = get_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
-  ue_db[rnti]->metrics_tx(ack, nof_bytes);
+  ue_ptr->metrics_tx(ack, nof_bytes);
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
 
@@ -305,14 +326,15 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t nof_bytes, bool crc)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  ue* ue_ptr = get_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  ue_db[rnti]->set_tti(tti_rx);
-  ue_db[rnti]->metrics_rx(crc, nof_bytes);
+  ue_ptr->set_tti(tti_rx);
+  ue_ptr->metrics_rx(crc, nof_bytes);
 
   rrc_h->set_radiolink_ul_state(rnti, crc);
 
@@ -327,13 +349,14 @@ int mac::push_pdu(uint32_t tti_rx,
                   bool     crc,
                   uint32_t ul_nof_prbs)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  ue* ue_ptr = get_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  srsran::unique_byte_buffer_t pdu = ue_db[rnti]->release_pdu(tti_rx, enb_cc_idx);
+  srsran::unique_byte_buffer_t pdu = ue_ptr->release_pdu(tti_rx, enb_cc_idx);
   if (pdu == nullptr) {
     logger.warning("Could not find MAC UL PDU for rnti=0x%x, cc=%d, tti=%d", rnti, enb_cc_idx, tti_rx);
     return SRSRAN_ERROR;
@@ -349,14 +372,20 @@ int mac::push_pdu(uint32_t tti_rx,
                   nof_bytes,
                   (int)pdu->size());
     auto process_pdu_task = [this, rnti, enb_cc_idx, ul_nof_prbs](srsran::unique_byte_buffer_t& pdu) {
-      srsran::rwlock_read_guard lock(rwlock);
-      if (check_ue_active(rnti)) {
-        ue_db[rnti]->process_pdu(std::move(pdu), enb_cc_idx, ul_nof_prbs);
+      srsran::epoch_read_guard lock;
+      ue*                      ue_ptr = get_active_ue(rnti);
+      if (ue_ptr != nullptr) {
+        ue_ptr->process_pdu(std::move(pdu), enb_cc_idx, ul_nof_prbs);
       } else {
         logger.debug("Discarding PDU rnti=0x%x", rnti);
       }
     };
-    stack_task_queue.try_push(std::bind(process_pdu_task, std::move(pdu)));
+    if (ul_pdu_workers.empty()) {
+      stack_task_queue.try_push(std::bind(process_pdu_task, std::move(pdu)));
+    } else {
+      // Each UE is always served by the same worker, which preserves the order of its UL PDUs
+      ul_pdu_workers[rnti % ul_pdu_workers.size()]->push_task(std::bind(process_pdu_task, std::move(pdu)));
+    }
   } else {
     logger.debug("Discarding PDU rnti=0x%x, tti_rx=%d, nof_bytes=%d", rnti, tti_rx, nof_bytes);
   }
@@ -366,14 +395,15 @@ int mac::push_pdu(uint32_t tti_rx,
 int mac::ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  ue* ue_ptr = get_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_ri_info(tti, rnti, enb_cc_idx, ri_value);
-  ue_db[rnti]->metrics_dl_ri(ri_value);
+  ue_ptr->metrics_dl_ri(ri_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -381,14 +411,15 @@ int mac::ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_v
 int mac::pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  ue* ue_ptr = get_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_pmi_info(tti, rnti, enb_cc_idx, pmi_value);
-  ue_db[rnti]->metrics_dl_pmi(pmi_value);
+  ue_ptr->metrics_dl_pmi(pmi_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -396,14 +427,15 @@ int mac::pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi
 int mac::cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  ue* ue_ptr = get_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
   scheduler.dl_cqi_info(tti, rnti, enb_cc_idx, cqi_value);
-  ue_db[rnti]->metrics_dl_cqi(cqi_value);
+  ue_ptr->metrics_dl_cqi(cqi_value);
 
   return SRSRAN_SUCCESS;
 }
@@ -411,9 +443,9 @@ int mac::cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi
 int mac::sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  if (get_active_ue(rnti) == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -424,9 +456,9 @@ int mac::sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
 int mac::snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, ul_channel_t ch)
 {
   logger.set_context(tti_rx);
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  if (get_active_ue(rnti) == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -435,15 +467,33 @@ int mac::snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr
   return scheduler.ul_snr_info(tti_rx, rnti, enb_cc_idx, snr, (uint32_t)ch);
 }
 
+int mac::ul_sb_snr_info(uint32_t                  tti_rx,
+                        uint16_t                  rnti,
+                        uint32_t                  enb_cc_idx,
+                        uint32_t                  prb_start,
+                        uint32_t                  sb_nof_prb,
+                        srsran::span<const float> sb_snr_db)
+{
+  logger.set_context(tti_rx);
+  srsran::epoch_read_guard lock;
+
+  if (get_active_ue(rnti) == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  return scheduler.ul_sb_snr_info(tti_rx, rnti, enb_cc_idx, prb_start, sb_nof_prb, sb_snr_db);
+}
+
 int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
 {
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  ue* ue_ptr = get_active_ue(rnti);
+  if (ue_ptr == nullptr) {
     return SRSRAN_ERROR;
   }
 
-  uint32_t nof_ta_count = ue_db[rnti]->set_ta_us(ta_us);
+  uint32_t nof_ta_count = ue_ptr->set_ta_us(ta_us);
   if (nof_ta_count > 0) {
     return scheduler.dl_mac_buffer_state(rnti, (uint32_t)srsran::dl_sch_lcid::TA_CMD, nof_ta_count);
   }
@@ -453,9 +503,9 @@ int mac::ta_info(uint32_t tti, uint16_t rnti, float ta_us)
 int mac::sr_detected(uint32_t tti, uint16_t rnti)
 {
   logger.set_context(tti);
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard lock;
 
-  if (not check_ue_active(rnti)) {
+  if (get_active_ue(rnti) == nullptr) {
     return SRSRAN_ERROR;
   }
 
@@ -485,29 +535,35 @@ uint16_t mac::allocate_ue(uint32_t enb_cc_idx)
     rnti = FIRST_RNTI + (ue_counter.fetch_add(1, std::memory_order_relaxed) % 60000);
 
     // Pre-check if rnti is valid
-    {
-      srsran::rwlock_read_guard read_lock(rwlock);
-      if (ue_db.full()) {
-        logger.warning("Maximum number of connected UEs %zd connected to the eNB. Ignoring PRACH", SRSENB_MAX_UES);
-        return SRSRAN_INVALID_RNTI;
-      }
-      if (not is_valid_rnti_unprotected(rnti)) {
-        continue;
-      }
+    if (ue_db.full()) {
+      logger.warning("Maximum number of connected UEs %zd connected to the eNB. Ignoring PRACH", SRSENB_MAX_UES);
+      return SRSRAN_INVALID_RNTI;
     }
-
-    // Allocate and initialize UE object
-    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-        rnti, rnti, enb_cc_idx, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
-
-    // Add UE to rnti map
-    srsran::rwlock_write_guard rw_lock(rwlock);
     if (not is_valid_rnti_unprotected(rnti)) {
       continue;
     }
-    auto ret = ue_db.insert(rnti, std::move(ue_ptr));
-    if (ret.has_value()) {
-      inserted_ue = ret.value()->second.get();
+
+    // Allocate and initialize UE object
+    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(rnti,
+                                                   rnti,
+                                                   enb_cc_idx,
+                                                   &scheduler,
+                                                   get_ue_rrc_interface(),
+                                                   rlc_h,
+                                                   phy_h,
+                                                   logger,
+                                                   cells.size(),
+                                                   softbuffer_pool.get());
+
+    // Add UE to rnti map. The check and the insertion are atomic with respect to stop()
+    std::lock_guard<std::mutex> lock(ue_alloc_mutex);
+    if (not started) {
+      logger.info("RACH ignored as eNB is being shutdown");
+      return SRSRAN_INVALID_RNTI;
+    }
+    unique_rnti_ptr<ue>* ret = ue_db.insert(rnti, std::move(ue_ptr));
+    if (ret != nullptr) {
+      inserted_ue = ret->get();
     } else {
       logger.info("Failed to allocate rnti=0x%x. Attempting a different rnti.", rnti);
     }
@@ -606,11 +662,7 @@ void mac::rach_detected(uint32_t tti, uint32_t enb_cc_idx, uint32_t preamble_idx
     // Trigger scheduler RACH
     scheduler.dl_rach_info(enb_cc_idx, rar_info);
 
-    auto get_pci = [this, enb_cc_idx]() {
-      srsran::rwlock_read_guard lock(rwlock);
-      return (enb_cc_idx < cell_config.size()) ? cell_config[enb_cc_idx].cell.id : 0;
-    };
-    uint32_t pci = get_pci();
+    uint32_t pci = (enb_cc_idx < cell_config.size()) ? cell_config[enb_cc_idx].cell.id : 0;
     logger.info("%sRACH:  tti=%d, cc=%d, pci=%d, preamble=%d, offset=%d, temp_crnti=0x%x",
                 (is_po_prach) ? "PDCCH order " : "",
                 tti,
@@ -642,7 +694,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
     add_padding();
   }
 
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard  lock;
+  srsran::rwlock_read_guard cfg_lock(cfg_rwlock);
 
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     // Run scheduler with current info
@@ -662,13 +715,14 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
       // Get UE
       uint16_t rnti = sched_result.data[i].dci.rnti;
 
-      if (ue_db.contains(rnti)) {
+      unique_rnti_ptr<ue>* ue_ptr = ue_db.find(rnti);
+      if (ue_ptr != nullptr) {
         // Copy dci info
         dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
 
         for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
           dl_sched_res->pdsch[n].softbuffer_tx[tb] =
-              ue_db[rnti]->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
+              (*ue_ptr)->get_tx_softbuffer(enb_cc_idx, sched_result.data[i].dci.pid, tb);
 
           // If the Rx soft-buffer is not given, abort transmission
           if (dl_sched_res->pdsch[n].softbuffer_tx[tb] == nullptr) {
@@ -677,12 +731,12 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
           if (sched_result.data[i].nof_pdu_elems[tb] > 0) {
             /* Get PDU if it's a new transmission */
-            dl_sched_res->pdsch[n].data[tb] = ue_db[rnti]->generate_pdu(enb_cc_idx,
-                                                                        sched_result.data[i].dci.pid,
-                                                                        tb,
-                                                                        sched_result.data[i].pdu[tb],
-                                                                        sched_result.data[i].nof_pdu_elems[tb],
-                                                                        sched_result.data[i].tbs[tb]);
+            dl_sched_res->pdsch[n].data[tb] = (*ue_ptr)->generate_pdu(enb_cc_idx,
+                                                                      sched_result.data[i].dci.pid,
+                                                                      tb,
+                                                                      sched_result.data[i].pdu[tb],
+                                                                      sched_result.data[i].nof_pdu_elems[tb],
+                                                                      sched_result.data[i].tbs[tb]);
 
             if (!dl_sched_res->pdsch[n].data[tb]) {
               logger.error("Error! PDU was not generated (rnti=0x%04x, tb=%d)", rnti, tb);
@@ -808,9 +862,7 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
   }
 
   // Count number of TTIs for all active users
-  for (auto& u : ue_db) {
-    u.second->metrics_cnt();
-  }
+  ue_db.for_each([](uint16_t rnti, unique_rnti_ptr<ue>& u) { u->metrics_cnt(); });
 
   return SRSRAN_SUCCESS;
 }
@@ -850,8 +902,14 @@ void mac::build_mch_sched(uint32_t tbs)
 
 int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res_list)
 {
-  srsran::rwlock_read_guard lock(rwlock);
-  dl_sched_t*               dl_sched_res = &dl_sched_res_list[0];
+  srsran::epoch_read_guard  lock;
+  srsran::rwlock_read_guard cfg_lock(cfg_rwlock);
+  unique_rnti_ptr<ue>*      mch_ue = ue_db.find(SRSRAN_MRNTI);
+  if (mch_ue == nullptr) {
+    logger.error("User rnti=0x%x not found", SRSRAN_MRNTI);
+    return SRSRAN_ERROR;
+  }
+  dl_sched_t* dl_sched_res = &dl_sched_res_list[0];
   logger.set_context(tti);
   srsran_ra_tb_t mcs      = {};
   srsran_ra_tb_t mcs_data = {};
@@ -878,9 +936,9 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
     dl_sched_res->pdsch[0].dci.rnti    = SRSRAN_MRNTI;
 
     // we use TTI % HARQ to make sure we use different buffers for consecutive TTIs to avoid races between PHY workers
-    ue_db[SRSRAN_MRNTI]->metrics_tx(true, mcs.tbs);
+    (*mch_ue)->metrics_tx(true, mcs.tbs);
     dl_sched_res->pdsch[0].data[0] =
-        ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, mch.num_mtch_sched + 1, mcs.tbs / 8);
+        (*mch_ue)->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, mch.num_mtch_sched + 1, mcs.tbs / 8);
   } else {
     uint32_t current_lcid = 1;
     uint32_t mtch_index   = 0;
@@ -897,15 +955,15 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
       int requested_bytes = (mcs_data.tbs / 8 > (int)mch.mtch_sched[mtch_index].lcid_buffer_size)
                                 ? (mch.mtch_sched[mtch_index].lcid_buffer_size)
                                 : ((mcs_data.tbs / 8) - 2);
-      int bytes_received = ue_db[SRSRAN_MRNTI]->read_pdu(current_lcid, mtch_payload_buffer, requested_bytes);
+      int bytes_received = (*mch_ue)->read_pdu(current_lcid, mtch_payload_buffer, requested_bytes);
       mch.pdu[0].lcid    = current_lcid;
       mch.pdu[0].nbytes  = bytes_received;
       mch.mtch_sched[0].mtch_payload  = mtch_payload_buffer;
       dl_sched_res->pdsch[0].dci.rnti = SRSRAN_MRNTI;
       if (bytes_received) {
-        ue_db[SRSRAN_MRNTI]->metrics_tx(true, mcs.tbs);
+        (*mch_ue)->metrics_tx(true, mcs.tbs);
         dl_sched_res->pdsch[0].data[0] =
-            ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, 1, mcs_data.tbs / 8);
+            (*mch_ue)->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, 1, mcs_data.tbs / 8);
       }
     } else {
       dl_sched_res->pdsch[0].dci.rnti = 0;
@@ -915,9 +973,7 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
   }
 
   // Count number of TTIs for all active users
-  for (auto& u : ue_db) {
-    u.second->metrics_cnt();
-  }
+  ue_db.for_each([](uint16_t rnti, unique_rnti_ptr<ue>& u) { u->metrics_cnt(); });
   return SRSRAN_SUCCESS;
 }
 
@@ -963,12 +1019,11 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
 
   logger.set_context(TTI_SUB(tti_tx_ul, FDD_HARQ_DELAY_UL_MS + FDD_HARQ_DELAY_DL_MS));
 
-  srsran::rwlock_read_guard lock(rwlock);
+  srsran::epoch_read_guard  lock;
+  srsran::rwlock_read_guard cfg_lock(cfg_rwlock);
 
   // Execute UE FSMs (e.g. TA)
-  for (auto& ue : ue_db) {
-    ue.second->tic();
-  }
+  ue_db.for_each([](uint16_t rnti, unique_rnti_ptr<ue>& u) { u->tic(); });
 
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     ul_sched_t* phy_ul_sched_res = &ul_sched_res_list[enb_cc_idx];
@@ -988,13 +1043,14 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
         // Get UE
         uint16_t rnti = sched_result.pusch[i].dci.rnti;
 
-        if (ue_db.contains(rnti)) {
+        unique_rnti_ptr<ue>* ue_ptr = ue_db.find(rnti);
+        if (ue_ptr != nullptr) {
           // Copy grant info
           phy_ul_sched_res->pusch[n].current_tx_nb = sched_result.pusch[i].current_tx_nb;
           phy_ul_sched_res->pusch[n].pid           = TTI_RX(tti_tx_ul) % SRSRAN_FDD_NOF_HARQ;
           phy_ul_sched_res->pusch[n].needs_pdcch   = sched_result.pusch[i].needs_pdcch;
           phy_ul_sched_res->pusch[n].dci           = sched_result.pusch[i].dci;
-          phy_ul_sched_res->pusch[n].softbuffer_rx = ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
+          phy_ul_sched_res->pusch[n].softbuffer_rx = (*ue_ptr)->get_rx_softbuffer(enb_cc_idx, tti_tx_ul);
 
           // If the Rx soft-buffer is not given, abort reception
           if (phy_ul_sched_res->pusch[n].softbuffer_rx == nullptr) {
@@ -1006,7 +1062,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
             srsran_softbuffer_rx_reset_tbs(phy_ul_sched_res->pusch[n].softbuffer_rx, sched_result.pusch[i].tbs * 8);
           }
           phy_ul_sched_res->pusch[n].data =
-              ue_db[rnti]->request_buffer(tti_tx_ul, enb_cc_idx, sched_result.pusch[i].tbs);
+              (*ue_ptr)->request_buffer(tti_tx_ul, enb_cc_idx, sched_result.pusch[i].tbs);
           if (phy_ul_sched_res->pusch[n].data) {
             phy_ul_sched_res->nof_grants++;
           } else {
@@ -1029,9 +1085,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
     phy_ul_sched_res->nof_phich = sched_result.phich.size();
   }
   // clear old buffers from all users
-  for (auto& u : ue_db) {
-    u.second->clear_old_buffers(tti_tx_ul);
-  }
+  ue_db.for_each([tti_tx_ul](uint16_t rnti, unique_rnti_ptr<ue>& u) { u->clear_old_buffers(tti_tx_ul); });
   return SRSRAN_SUCCESS;
 }
 
@@ -1041,35 +1095,96 @@ void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
                      const uint8_t*             mcch_payload,
                      const uint8_t              mcch_payload_length)
 {
-  srsran::rwlock_write_guard lock(rwlock);
-  mcch               = *mcch_;
-  mch.num_mtch_sched = this->mcch.pmch_info_list[0].nof_mbms_session_info;
-  for (uint32_t i = 0; i < mch.num_mtch_sched; ++i) {
-    mch.mtch_sched[i].lcid = this->mcch.pmch_info_list[0].mbms_session_info_list[i].lc_ch_id;
+  {
+    // The PHY workers may be already running the MCH scheduling
+    srsran::rwlock_write_guard cfg_lock(cfg_rwlock);
+    mcch               = *mcch_;
+    mch.num_mtch_sched = this->mcch.pmch_info_list[0].nof_mbms_session_info;
+    for (uint32_t i = 0; i < mch.num_mtch_sched; ++i) {
+      mch.mtch_sched[i].lcid = this->mcch.pmch_info_list[0].mbms_session_info_list[i].lc_ch_id;
+    }
+    sib2  = *sib2_;
+    sib13 = *sib13_;
+    memcpy(mcch_payload_buffer, mcch_payload, mcch_payload_length * sizeof(uint8_t));
+    current_mcch_length = mcch_payload_length;
   }
-  sib2  = *sib2_;
-  sib13 = *sib13_;
-  memcpy(mcch_payload_buffer, mcch_payload, mcch_payload_length * sizeof(uint8_t));
-  current_mcch_length = mcch_payload_length;
 
   unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
       SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
 
-  auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
-  if (!ret) {
+  if (ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr)) == nullptr) {
     logger.info("Failed to allocate rnti=0x%x.for eMBMS", SRSRAN_MRNTI);
   }
   rrc_h->add_user(SRSRAN_MRNTI, {});
 }
 
-// Internal helper function, caller must hold UE DB rwlock
-bool mac::check_ue_active(uint16_t rnti)
+// Internal helper function, caller must hold an epoch_read_guard. The UE is looked up only once, as a concurrent
+// ue_rem() may unlink it from the ue_db at any time. The returned object stays valid until the guard is released
+ue* mac::get_active_ue(uint16_t rnti)
 {
-  if (not ue_db.contains(rnti)) {
+  unique_rnti_ptr<ue>* ue_ptr = ue_db.find(rnti);
+  if (ue_ptr == nullptr) {
     logger.error("User rnti=0x%x not found", rnti);
-    return false;
+    return nullptr;
+  }
+  return (*ue_ptr)->is_active() ? ue_ptr->get() : nullptr;
+}
+
+/********************************************************
+ *
+ * RRC interface for UEs processed in the UL PDU workers
+ *
+ *******************************************************/
+
+int mac::ul_worker_rrc_adapter::add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg)
+{
+  return parent->rrc_h->add_user(rnti, init_ue_cfg);
+}
+
+void mac::ul_worker_rrc_adapter::upd_user(uint16_t new_rnti, uint16_t old_rnti)
+{
+  // C-RNTI CE handling changes the RRC UE context, which is only accessed from the stack thread. It is posted after the
+  // RLC SDUs of the same PDU, as in the stack thread
+  parent->ul_worker_stack_queue.push([this, new_rnti, old_rnti]() { parent->rrc_h->upd_user(new_rnti, old_rnti); });
+}
+
+void mac::ul_worker_rrc_adapter::set_activity_user(uint16_t rnti)
+{
+  parent->rrc_h->set_activity_user(rnti);
+}
+
+void mac::ul_worker_rrc_adapter::set_radiolink_dl_state(uint16_t rnti, bool crc_res)
+{
+  parent->rrc_h->set_radiolink_dl_state(rnti, crc_res);
+}
+
+void mac::ul_worker_rrc_adapter::set_radiolink_ul_state(uint16_t rnti, bool crc_res)
+{
+  parent->rrc_h->set_radiolink_ul_state(rnti, crc_res);
+}
+
+bool mac::ul_worker_rrc_adapter::is_paging_opportunity(uint32_t tti_tx_dl, uint32_t* payload_len)
+{
+  return parent->rrc_h->is_paging_opportunity(tti_tx_dl, payload_len);
+}
+
+void mac::ul_worker_rrc_adapter::read_pdu_pcch(uint32_t tti_tx_dl, uint8_t* payload, uint32_t payload_size)
+{
+  parent->rrc_h->read_pdu_pcch(tti_tx_dl, payload, payload_size);
+}
+
+uint8_t* mac::ul_worker_rrc_adapter::read_pdu_bcch_dlsch(const uint8_t enb_cc_idx, const uint32_t sib_index)
+{
+  return parent->rrc_h->read_pdu_bcch_dlsch(enb_cc_idx, sib_index);
+}
+
+// Destroys the UE objects removed from the ue_db, once no PHY worker can hold a reference to them anymore
+void mac::reclaim_removed_ues()
+{
+  if (ue_db.reclaim() > 0) {
+    // A PHY worker is still processing a TTI that started before the UE removal. Retry later
+    task_sched.defer_callback(1, [this]() { reclaim_removed_ues(); });
   }
-  return ue_db[rnti]->is_active();
 }
 
 } // namespace srsenb
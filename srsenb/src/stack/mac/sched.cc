@@ -237,6 +237,18 @@ int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, floa
                              [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
 }
 
+int sched::ul_sb_snr_info(uint32_t                  tti_rx,
+                          uint16_t                  rnti,
+                          uint32_t                  enb_cc_idx,
+                          uint32_t                  prb_start,
+                          uint32_t                  sb_nof_prb,
+                          srsran::span<const float> sb_snr_db)
+{
+  return ue_db_access_locked(rnti, [&](sched_ue& ue) {
+    ue.set_ul_sb_snr(tti_point{tti_rx}, enb_cc_idx, prb_start, sb_nof_prb, sb_snr_db);
+  });
+}
+
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
   return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
@@ -24,6 +24,7 @@
 #include "srsran/common/string_helpers.h"
 #include "srsran/mac/pdu.h"
 #include "srsran/srslog/bundled/fmt/format.h"
+#include <algorithm>
 #include <array>
 
 #define Debug(fmt, ...) get_mac_logger().debug(fmt, ##__VA_ARGS__)
@@ -217,6 +218,32 @@ sched_cell_params_t::dl_lb_nof_re_table get_lb_nof_re_x_prb(const sched_cell_par
   return ret;
 }
 
+static uint32_t get_mcs_table_idx(bool use_tbs_index_alt, bool is_ul)
+{
+  return is_ul ? 2 : (use_tbs_index_alt ? 1 : 0);
+}
+
+sched_cell_params_t::tbs_bytes_table generate_tbs_table(uint32_t nof_prb)
+{
+  sched_cell_params_t::tbs_bytes_table table;
+  for (uint32_t mcs_table = 0; mcs_table < sched_cell_params_t::nof_mcs_tables; ++mcs_table) {
+    bool use_tbs_index_alt = mcs_table == get_mcs_table_idx(true, false);
+    bool is_ul             = mcs_table == get_mcs_table_idx(false, true);
+    for (uint32_t mcs = 0; mcs < sched_cell_params_t::nof_mcs; ++mcs) {
+      int tbs_idx = srsran_ra_tbs_idx_from_mcs(mcs, use_tbs_index_alt, is_ul);
+      if (tbs_idx < 0) {
+        // MCS not present in the table
+        continue;
+      }
+      table[mcs_table][mcs].resize(nof_prb);
+      for (uint32_t n = 0; n < nof_prb; ++n) {
+        table[mcs_table][mcs][n] = (uint32_t)srsran_ra_tbs_from_idx((uint32_t)tbs_idx, n + 1) / 8U;
+      }
+    }
+  }
+  return table;
+}
+
 void sched_cell_params_t::regs_deleter::operator()(srsran_regs_t* p)
 {
   if (p != nullptr) {
@@ -312,6 +339,7 @@ bool sched_cell_params_t::set_cfg(uint32_t                             enb_cc_id
 
   nof_re_table    = generate_nof_re_table(cfg.cell);
   nof_re_lb_table = get_lb_nof_re_x_prb(nof_re_table);
+  tbs_table       = generate_tbs_table(cfg.cell.nof_prb);
 
   return true;
 }
@@ -330,6 +358,42 @@ uint32_t sched_cell_params_t::get_dl_lb_nof_re(tti_point tti_tx_dl, uint32_t nof
   return nof_re;
 }
 
+int sched_cell_params_t::get_tbs_bytes(uint32_t mcs, uint32_t nof_prbs_alloc, bool use_tbs_index_alt, bool is_ul) const
+{
+  if (mcs >= nof_mcs) {
+    return SRSRAN_ERROR;
+  }
+  const srsran::bounded_vector<uint32_t, SRSRAN_MAX_PRB>& tbs_row =
+      tbs_table[get_mcs_table_idx(use_tbs_index_alt, is_ul)][mcs];
+  if (nof_prbs_alloc == 0 or nof_prbs_alloc > tbs_row.size()) {
+    // MCS not present in the table, or invalid nof PRBs
+    return SRSRAN_ERROR;
+  }
+  return tbs_row[nof_prbs_alloc - 1];
+}
+
+int sched_cell_params_t::get_min_nof_prb(uint32_t mcs, uint32_t req_bytes, bool use_tbs_index_alt, bool is_ul) const
+{
+  if (mcs >= nof_mcs) {
+    return -1;
+  }
+  const srsran::bounded_vector<uint32_t, SRSRAN_MAX_PRB>& tbs_row =
+      tbs_table[get_mcs_table_idx(use_tbs_index_alt, is_ul)][mcs];
+  if (tbs_row.empty()) {
+    return -1;
+  }
+  // Note: The TBS does not decrease with the number of PRBs, except for the single PRB entry of I_TBS=6 in
+  //       TS 36.213 Table 7.1.7.2.1-1, which is checked separately
+  if (tbs_row[0] >= req_bytes) {
+    return 1;
+  }
+  auto it = std::lower_bound(tbs_row.begin() + 1, tbs_row.end(), req_bytes);
+  if (it == tbs_row.end()) {
+    return -1;
+  }
+  return static_cast<int>(it - tbs_row.begin()) + 1;
+}
+
 uint32_t
 sched_cell_params_t::get_dl_nof_res(srsran::tti_point tti_tx_dl, const srsran_dci_dl_t& dci, uint32_t cfi) const
 {
@@ -180,14 +180,23 @@ tbs_info compute_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
     return tb_max;
   }
 
-  // Iterate from min to max MCS until a solution is found
-  for (int mcs = mcs_min + 1; mcs < tb_max.mcs; ++mcs) {
-    tbs_info tb2 = compute_mcs_and_tbs(nof_prb, nof_re, cqi, mcs, is_ul, ulqam64_enabled, use_tbs_index_alt);
+  // Search for the lowest MCS in ]mcs_min, tb_max.mcs[ whose TBS fits req_bytes.
+  // Note: The TBS derived for a maximum MCS does not decrease when the maximum MCS increases, so the search can be
+  //       a bisection rather than a linear sweep.
+  int      lo       = mcs_min + 1;
+  int      hi       = tb_max.mcs;
+  tbs_info tb_found = tb_max;
+  while (lo < hi) {
+    int      mid = lo + (hi - lo) / 2;
+    tbs_info tb2 = compute_mcs_and_tbs(nof_prb, nof_re, cqi, mid, is_ul, ulqam64_enabled, use_tbs_index_alt);
     if (tb2.tbs_bytes >= (int)req_bytes) {
-      return tb2;
+      tb_found = tb2;
+      hi       = mid;
+    } else {
+      lo = mid + 1;
     }
   }
-  return tb_max;
+  return tb_found;
 }
 
 int generate_ra_bc_dci_format1a_common(srsran_dci_dl_t&           dci,
@@ -51,20 +51,22 @@ template <typename RBMask,
               typename std::conditional<std::is_same<RBMask, prbmask_t>::value, prb_interval, rbg_interval>::type>
 RBInterval find_contiguous_interval(const RBMask& in_mask, uint32_t max_size)
 {
-  RBInterval max_interv;
+  // Common case, where an interval of the requested length is available
+  int run_start = in_mask.find_lowest_run(0, in_mask.size(), max_size, false);
+  if (run_start >= 0) {
+    return RBInterval(run_start, run_start + max_size);
+  }
 
+  // Otherwise, search for the largest empty interval
+  RBInterval max_interv;
   for (size_t n = 0; n < in_mask.size();) {
     int pos = in_mask.find_lowest(n, in_mask.size(), false);
     if (pos < 0) {
       break;
     }
 
-    size_t     max_pos = std::min(in_mask.size(), (size_t)pos + max_size);
-    int        pos2    = in_mask.find_lowest(pos + 1, max_pos, true);
-    RBInterval interv(pos, pos2 < 0 ? max_pos : pos2);
-    if (interv.length() >= max_size) {
-      return interv;
-    }
+    int        pos2 = in_mask.find_lowest(pos + 1, in_mask.size(), true);
+    RBInterval interv(pos, pos2 < 0 ? in_mask.size() : pos2);
     if (interv.length() > max_interv.length()) {
       max_interv = interv;
     }
@@ -83,13 +85,12 @@ rbgmask_t find_available_rbgmask(const rbgmask_t& in_mask, uint32_t max_size)
     return localmask;
   }
 
-  uint32_t i = 0, nof_alloc = 0;
-  for (; i < localmask.size() and nof_alloc < max_size; ++i) {
-    if (localmask.test(i)) {
-      nof_alloc++;
-    }
+  // Keep the first "max_size" free RBGs
+  int pos = -1;
+  for (uint32_t nof_alloc = 0; nof_alloc < max_size; ++nof_alloc) {
+    pos = localmask.find_lowest(pos + 1, localmask.size(), true);
   }
-  localmask.fill(i, localmask.size(), false);
+  localmask.fill(pos + 1, localmask.size(), false);
   return localmask;
 }
 
@@ -304,6 +304,15 @@ void sched_ue::set_ul_snr(tti_point tti_rx, uint32_t enb_cc_idx, float snr, uint
   cells[enb_cc_idx].set_ul_snr(tti_rx, snr, ul_ch_code);
 }
 
+void sched_ue::set_ul_sb_snr(tti_point                 tti_rx,
+                             uint32_t                  enb_cc_idx,
+                             uint32_t                  prb_start,
+                             uint32_t                  sb_nof_prb,
+                             srsran::span<const float> sb_snr_db)
+{
+  cells[enb_cc_idx].set_ul_sb_snr(tti_rx, prb_start, sb_nof_prb, sb_snr_db);
+}
+
 /*******************************************************
  *
  * Functions used to generate DCI grants
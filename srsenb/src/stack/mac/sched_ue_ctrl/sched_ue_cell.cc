@@ -57,7 +57,8 @@ sched_ue_cell::sched_ue_cell(uint16_t rnti_, const sched_cell_params_t& cell_cfg
   fixed_mcs_ul(cell_cfg_.sched_cfg->pusch_mcs),
   current_tti(current_tti_),
   max_aggr_level(cell_cfg_.sched_cfg->max_aggr_level >= 0 ? cell_cfg_.sched_cfg->max_aggr_level : 3),
-  dl_cqi_ctxt(cell_cfg_.nof_prb(), 0, cell_cfg_.sched_cfg->init_dl_cqi)
+  dl_cqi_ctxt(cell_cfg_.nof_prb(), 0, cell_cfg_.sched_cfg->init_dl_cqi),
+  ul_sinr_ctxt(cell_cfg_.nof_prb())
 {
   float target_bler = cell_cfg->sched_cfg->target_bler;
   dl_delta_inc      = cell_cfg->sched_cfg->adaptive_dl_mcs_step_size; // delta_{down} of OLLA
@@ -173,6 +174,7 @@ void sched_ue_cell::clear_feedback()
   dl_pmi_tti_rx = tti_point{};
   dl_cqi_ctxt.reset_cqi(ue_cc_idx == 0 ? cell_cfg->sched_cfg->init_dl_cqi : 1);
   ul_cqi_tti_rx = tti_point{};
+  ul_sinr_ctxt.reset();
 }
 
 void sched_ue_cell::finish_tti(tti_point tti_rx)
@@ -282,6 +284,20 @@ int sched_ue_cell::set_ul_snr(tti_point tti_rx, float ul_snr, uint32_t ul_ch_cod
   return SRSRAN_SUCCESS;
 }
 
+int sched_ue_cell::set_ul_sb_snr(tti_point                 tti_rx,
+                                 uint32_t                  prb_start,
+                                 uint32_t                  sb_nof_prb,
+                                 srsran::span<const float> sb_snr_db)
+{
+  CHECK_VALID_CC("UL subband SNR estimate");
+  ul_sinr_ctxt.sb_snr_info(tti_rx, prb_start, sb_nof_prb, sb_snr_db);
+  logger.debug("SCHED: UL subband SNR cc=%d, prb_start=%d, nof_sb=%zd",
+               cell_cfg->enb_cc_idx,
+               prb_start,
+               sb_snr_db.size());
+  return SRSRAN_SUCCESS;
+}
+
 int sched_ue_cell::get_ul_cqi() const
 {
   if (not ul_cqi_tti_rx.is_valid()) {
@@ -418,12 +434,12 @@ tbs_info cqi_to_tbs_dl(const sched_ue_cell& cell,
     // handled by the scheduler, but we might be scheduling undecodable codewords at very low SNR
     if (ret.tbs_bytes < 0) {
       ret.mcs       = 0;
-      ret.tbs_bytes = get_tbs_bytes((uint32_t)ret.mcs, nof_prbs, use_tbs_index_alt, false);
+      ret.tbs_bytes = cell.cell_cfg->get_tbs_bytes((uint32_t)ret.mcs, nof_prbs, use_tbs_index_alt, false);
     }
   } else {
     // Fixed MCS configured
     ret.mcs       = cell.fixed_mcs_dl;
-    ret.tbs_bytes = get_tbs_bytes((uint32_t)cell.fixed_mcs_dl, nof_prbs, use_tbs_index_alt, false);
+    ret.tbs_bytes = cell.cell_cfg->get_tbs_bytes((uint32_t)cell.fixed_mcs_dl, nof_prbs, use_tbs_index_alt, false);
   }
   return ret;
 }
@@ -444,12 +460,12 @@ tbs_info cqi_to_tbs_ul(const sched_ue_cell& cell, uint32_t nof_prb, uint32_t nof
     // handled by the scheduler, but we might be scheduling undecodable codewords at very low SNR
     if (ret.tbs_bytes < 0) {
       ret.mcs       = 0;
-      ret.tbs_bytes = get_tbs_bytes((uint32_t)ret.mcs, nof_prb, false, true);
+      ret.tbs_bytes = cell.cell_cfg->get_tbs_bytes((uint32_t)ret.mcs, nof_prb, false, true);
     }
   } else {
     // Fixed MCS
     ret.mcs       = mcs;
-    ret.tbs_bytes = get_tbs_bytes((uint32_t)mcs, nof_prb, false, true);
+    ret.tbs_bytes = cell.cell_cfg->get_tbs_bytes((uint32_t)mcs, nof_prb, false, true);
   }
 
   return ret;
@@ -487,12 +503,20 @@ uint32_t get_required_prb_ul(const sched_ue_cell& cell, uint32_t req_bytes)
   };
 
   // find nof prbs that lead to a tbs just above req_bytes
-  int                                      target_tbs = std::max(static_cast<int>(req_bytes) + 4, MIN_ALLOC_BYTES);
-  uint32_t                                 max_prbs   = std::min(cell.tpc_fsm.max_ul_prbs(), cell.cell_cfg->nof_prb());
-  std::tuple<uint32_t, int, uint32_t, int> ret =
-      false_position_method(1U, max_prbs, target_tbs, compute_tbs_approx, [](int y) { return y == SRSRAN_ERROR; });
-  uint32_t req_prbs  = std::get<2>(ret);
-  uint32_t final_tbs = std::get<3>(ret);
+  int      target_tbs = std::max(static_cast<int>(req_bytes) + 4, MIN_ALLOC_BYTES);
+  uint32_t max_prbs   = std::min(cell.tpc_fsm.max_ul_prbs(), cell.cell_cfg->nof_prb());
+  uint32_t req_prbs, final_tbs;
+  if (cell.fixed_mcs_ul >= 0) {
+    // Fixed MCS: the TBS only depends on the nof PRBs, so the cell TBS table can be searched directly
+    int min_prbs = cell.cell_cfg->get_min_nof_prb((uint32_t)cell.fixed_mcs_ul, target_tbs, false, true);
+    req_prbs     = (min_prbs < 0 or min_prbs > (int)max_prbs) ? max_prbs : (uint32_t)min_prbs;
+    final_tbs    = compute_tbs_approx(req_prbs);
+  } else {
+    std::tuple<uint32_t, int, uint32_t, int> ret =
+        false_position_method(1U, max_prbs, target_tbs, compute_tbs_approx, [](int y) { return y == SRSRAN_ERROR; });
+    req_prbs  = std::get<2>(ret);
+    final_tbs = std::get<3>(ret);
+  }
   while (final_tbs < MIN_ALLOC_BYTES and req_prbs < cell.cell_cfg->nof_prb()) {
     // Note: If PHR<0 is limiting the max nof PRBs per UL grant, the UL grant may become too small to fit any
     //       data other than headers + BSR. In this edge-case, force an increase the nof required PRBs.
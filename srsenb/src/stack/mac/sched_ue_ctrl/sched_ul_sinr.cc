@@ -0,0 +1,131 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/sched_ue_ctrl/sched_ul_sinr.h"
+
+namespace srsenb {
+
+void sched_ul_sinr::sb_snr_info(tti_point                 tti_rx,
+                                uint32_t                  prb_start,
+                                uint32_t                  sb_nof_prb,
+                                srsran::span<const float> sb_snr_db)
+{
+  for (uint32_t sb = 0; sb < sb_snr_db.size(); ++sb) {
+    uint32_t prb_stop = std::min(prb_start + (sb + 1) * sb_nof_prb, cell_nof_prb);
+    for (uint32_t prb = prb_start + sb * sb_nof_prb; prb < prb_stop; ++prb) {
+      // Restart the average if the last measurement is too old
+      prb_sinr_context& ctxt = prbs[prb];
+      if (is_prb_valid(prb, tti_rx)) {
+        ctxt.sinr_db += alpha * (sb_snr_db[sb] - ctxt.sinr_db);
+      } else {
+        ctxt.sinr_db = sb_snr_db[sb];
+      }
+      ctxt.last_tti_rx = tti_rx;
+    }
+  }
+}
+
+void sched_ul_sinr::reset()
+{
+  for (prb_sinr_context& ctxt : prbs) {
+    ctxt = prb_sinr_context{};
+  }
+}
+
+bool sched_ul_sinr::is_sinr_info_valid(tti_point tti) const
+{
+  for (uint32_t prb = 0; prb < cell_nof_prb; ++prb) {
+    if (is_prb_valid(prb, tti)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+float sched_ul_sinr::get_wb_sinr(tti_point tti) const
+{
+  float    sinr  = 0;
+  uint32_t count = 0;
+  for (uint32_t prb = 0; prb < cell_nof_prb; ++prb) {
+    if (is_prb_valid(prb, tti)) {
+      sinr += prbs[prb].sinr_db;
+      count++;
+    }
+  }
+  return count > 0 ? sinr / count : 0;
+}
+
+float sched_ul_sinr::get_prb_sinr(uint32_t prb, tti_point tti) const
+{
+  return is_prb_valid(prb, tti) ? prbs[prb].sinr_db : get_wb_sinr(tti);
+}
+
+float sched_ul_sinr::get_avg_sinr(prb_interval interv, tti_point tti) const
+{
+  if (interv.empty()) {
+    return 0;
+  }
+  float wb_sinr = get_wb_sinr(tti);
+  float sinr    = 0;
+  for (uint32_t prb = interv.start(); prb < interv.stop(); ++prb) {
+    sinr += is_prb_valid(prb, tti) ? prbs[prb].sinr_db : wb_sinr;
+  }
+  return sinr / interv.length();
+}
+
+prb_interval sched_ul_sinr::get_optim_prb_interval(const prbmask_t& ul_mask, uint32_t L, tti_point tti) const
+{
+  uint32_t nof_prb = std::min(cell_nof_prb, static_cast<uint32_t>(ul_mask.size()));
+  if (L == 0 or L > nof_prb) {
+    return {};
+  }
+
+  float wb_sinr = get_wb_sinr(tti);
+  srsran::bounded_vector<float, MAX_NOF_PRBS> sinr(nof_prb);
+  for (uint32_t prb = 0; prb < nof_prb; ++prb) {
+    sinr[prb] = is_prb_valid(prb, tti) ? prbs[prb].sinr_db : wb_sinr;
+  }
+
+  // Slide a window of L PRBs over the runs of free PRBs
+  prb_interval best;
+  float        best_sum = 0;
+  uint32_t     run_len  = 0;
+  float        sum      = 0;
+  for (uint32_t prb = 0; prb < nof_prb; ++prb) {
+    if (ul_mask.test(prb)) {
+      run_len = 0;
+      sum     = 0;
+      continue;
+    }
+    run_len++;
+    sum += sinr[prb];
+    if (run_len > L) {
+      sum -= sinr[prb - L];
+    }
+    if (run_len >= L and (best.empty() or sum > best_sum)) {
+      best     = prb_interval{prb + 1 - L, prb + 1};
+      best_sum = sum;
+    }
+  }
+  return best;
+}
+
+} // namespace srsenb
@@ -179,4 +179,18 @@ alloc_result try_ul_retx_alloc(sf_sched& tti_sched, sched_ue& ue, const ul_harq_
   return tti_sched.alloc_ul_user(&ue, alloc);
 }
 
+prb_interval find_ul_newtx_prbs(sf_sched& tti_sched, sched_ue& ue, uint32_t L)
+{
+  prb_interval         alloc   = find_contiguous_ul_prbs(L, tti_sched.get_ul_mask());
+  const sched_ue_cell* ue_cell = ue.find_ue_carrier(tti_sched.get_enb_cc_idx());
+  if (alloc.empty() or ue_cell == nullptr or not ue_cell->ul_sinr().is_sinr_info_valid(tti_sched.get_tti_rx())) {
+    return alloc;
+  }
+
+  // Keep the number of PRBs, which is valid for SC-FDMA, and move them to the best free interval
+  prb_interval optim =
+      ue_cell->ul_sinr().get_optim_prb_interval(tti_sched.get_ul_mask(), alloc.length(), tti_sched.get_tti_rx());
+  return optim.empty() ? alloc : optim;
+}
+
 } // namespace srsenb
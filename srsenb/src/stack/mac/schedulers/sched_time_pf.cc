@@ -156,7 +156,7 @@ uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
       return 0;
     }
     uint32_t     pending_rb = ue.get_required_prb_ul(cc_cfg->enb_cc_idx, pending_data);
-    prb_interval alloc      = find_contiguous_ul_prbs(pending_rb, tti_sched->get_ul_mask());
+    prb_interval alloc      = find_ul_newtx_prbs(*tti_sched, ue, pending_rb);
     if (alloc.empty()) {
       return 0;
     }
@@ -141,7 +141,7 @@ void sched_time_rr::sched_ul_newtxs(sched_ue_list& ue_db, sf_sched* tti_sched, s
       continue;
     }
     uint32_t     pending_rb = user.get_required_prb_ul(cc_cfg->enb_cc_idx, pending_data);
-    prb_interval alloc      = find_contiguous_ul_prbs(pending_rb, tti_sched->get_ul_mask());
+    prb_interval alloc      = find_ul_newtx_prbs(*tti_sched, user, pending_rb);
     if (alloc.empty()) {
       continue;
     }
@@ -424,6 +424,8 @@ bool ue::process_ce(srsran::sch_subh* subh, uint32_t grant_nof_prbs)
       old_rnti = subh->get_c_rnti();
       if (sched->ue_exists(old_rnti)) {
         rrc->upd_user(rnti, old_rnti);
+        // The PDUs may be processed in a UL PDU worker, while the metrics are read by the stack thread
+        std::lock_guard<std::mutex> lock(metrics_mutex);
         rnti = old_rnti;
       } else {
         logger.warning("Updating user C-RNTI: rnti=0x%x already released.", old_rnti);
@@ -608,10 +610,11 @@ uint8_t* ue::generate_mch_pdu(uint32_t                             harq_pid,
 /******* METRICS interface ***************/
 void ue::metrics_read(mac_ue_metrics_t* metrics_)
 {
-  uint32_t ul_buffer = sched->get_ul_buffer(rnti);
-  uint32_t dl_buffer = sched->get_dl_buffer(rnti);
-
+  // The RNTI is updated by the C-RNTI CE under the same lock
   std::lock_guard<std::mutex> lock(metrics_mutex);
+  uint32_t                    ul_buffer = sched->get_ul_buffer(rnti);
+  uint32_t                    dl_buffer = sched->get_dl_buffer(rnti);
+
   ue_metrics.rnti      = rnti;
   ue_metrics.ul_buffer = ul_buffer;
   ue_metrics.dl_buffer = dl_buffer;
@@ -66,15 +66,17 @@ int32_t rrc::init(const rrc_cfg_t&       cfg_,
                   pdcp_interface_rrc*    pdcp_,
                   s1ap_interface_rrc*    s1ap_,
                   gtpu_interface_rrc*    gtpu_,
-                  rrc_nr_interface_rrc*  rrc_nr_)
+                  rrc_nr_interface_rrc*  rrc_nr_,
+                  pdcp_nr_interface_rrc* pdcp_nr_)
 {
-  phy    = phy_;
-  mac    = mac_;
-  rlc    = rlc_;
-  pdcp   = pdcp_;
-  gtpu   = gtpu_;
-  s1ap   = s1ap_;
-  rrc_nr = rrc_nr_;
+  phy     = phy_;
+  mac     = mac_;
+  rlc     = rlc_;
+  pdcp    = pdcp_;
+  gtpu    = gtpu_;
+  s1ap    = s1ap_;
+  rrc_nr  = rrc_nr_;
+  pdcp_nr = pdcp_nr_;
 
   cfg = cfg_;
 
@@ -165,9 +165,11 @@ bool rrc::ue::rrc_endc::fill_conn_recfg(asn1::rrc::rrc_conn_recfg_r8_ies_s* conn
     meas_cfg.meas_id_to_rem_list[0] = nr_meas_id;
 
     // FIXME: use bearer manager to remove EUTRA DRB
-    conn_recfg->rr_cfg_ded.drb_to_release_list_present = true;
-    conn_recfg->rr_cfg_ded.drb_to_release_list.resize(1);
-    conn_recfg->rr_cfg_ded.drb_to_release_list[0] = 1;
+    if (not endc_cfg.split_bearer) {
+      conn_recfg->rr_cfg_ded.drb_to_release_list_present = true;
+      conn_recfg->rr_cfg_ded.drb_to_release_list.resize(1);
+      conn_recfg->rr_cfg_ded.drb_to_release_list[0] = 1;
+    }
 
     // don't send EUTRA dedicated config again
     conn_recfg->rr_cfg_ded.phys_cfg_ded_present = false;
@@ -384,12 +386,32 @@ void rrc::ue::rrc_endc::handle_sgnb_add_req_ack(wait_sgnb_add_req_resp_st& s, co
 
   // store RNTI for later
   nr_rnti = ev.params.nr_rnti;
+
+  if (endc_cfg.split_bearer and rrc_enb->pdcp_nr != nullptr) {
+    // keep the EUTRA RLC bearer of the DRB as secondary leg of the NR PDCP.
+    // Limitation: only the eNB side of the split bearer is set up. The RRC Reconfiguration does not tell the UE that
+    // the EUTRA DRB now uses NR PDCP, and srsUE has no routing from its EUTRA RLC bearer into its NR PDCP. Hence, the
+    // option is off by default, and only works with UEs that expect this bearer configuration
+    for (const auto& drb : rrc_ue->bearer_list.get_established_drbs()) {
+      if (drb.eps_bearer_id_present and drb.eps_bearer_id == ev.params.eps_bearer_id) {
+        split_leg_lcid = drb.lc_ch_id;
+        rrc_enb->pdcp_nr->add_split_bearer_leg(
+            nr_rnti, lcid_drb_nr, rrc_ue->rnti, split_leg_lcid, endc_cfg.split_bearer_cfg);
+        Info("Split bearer for rnti=0x%x over NR lcid=%d and EUTRA lcid=%d", rrc_ue->rnti, lcid_drb_nr, split_leg_lcid);
+        break;
+      }
+    }
+  }
 }
 
 void rrc::ue::rrc_endc::handle_sgnb_rel_req(const sgnb_rel_req_ev& ev)
 {
   logger.info("Triggering SgNB release for E-UTRA rnti=0x%x", rrc_ue->rnti);
   rrc_enb->bearer_manager.rem_user(nr_rnti);
+  if (split_leg_lcid != 0) {
+    rrc_enb->pdcp_nr->del_split_bearer_leg(nr_rnti, lcid_drb_nr, rrc_ue->rnti, split_leg_lcid);
+    split_leg_lcid = 0;
+  }
   rrc_enb->rrc_nr->sgnb_release_request(nr_rnti);
 }
 
@@ -43,7 +43,14 @@ namespace srsenb {
 
 gtpu_tunnel_manager::gtpu_tunnel_manager(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger) :
   logger(logger), task_sched(task_sched_), tunnels(1)
-{}
+{
+  pthread_rwlock_init(&rwlock, nullptr);
+}
+
+gtpu_tunnel_manager::~gtpu_tunnel_manager()
+{
+  pthread_rwlock_destroy(&rwlock);
+}
 
 void gtpu_tunnel_manager::init(const gtpu_args_t& args, pdcp_interface_gtpu* pdcp_)
 {
@@ -60,7 +67,7 @@ const gtpu_tunnel_manager::tunnel* gtpu_tunnel_manager::find_tunnel(uint32_t tei
 gtpu_tunnel_manager::ue_bearer_tunnel_list* gtpu_tunnel_manager::find_rnti_tunnels(uint16_t rnti)
 {
   auto it = ue_teidin_db.find(rnti);
-  return it != ue_teidin_db.end() ? &ue_teidin_db[rnti] : nullptr;
+  return it != ue_teidin_db.end() ? &it->second : nullptr;
 }
 
 srsran::span<gtpu_tunnel_manager::bearer_teid_pair>
@@ -87,7 +94,8 @@ gtpu_tunnel_manager::add_tunnel(uint16_t rnti, uint32_t eps_bearer_id, uint32_t
     logger.warning("Adding TEID with invalid eps-BearerID=%d", eps_bearer_id);
     return nullptr;
   }
-  auto ret_pair = tunnels.insert(tunnel());
+  srsran::rwlock_write_guard rw_lock(rwlock);
+  auto                       ret_pair = tunnels.insert(tunnel());
   if (not ret_pair) {
     logger.warning("Unable to create new GTPU TEID In");
     return nullptr;
@@ -130,6 +138,7 @@ gtpu_tunnel_manager::add_tunnel(uint16_t rnti, uint32_t eps_bearer_id, uint32_t
 
 bool gtpu_tunnel_manager::update_rnti(uint16_t old_rnti, uint16_t new_rnti)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   auto* old_rnti_ptr = find_rnti_tunnels(old_rnti);
   auto* new_rnti_ptr = find_rnti_tunnels(new_rnti);
   if (old_rnti_ptr == nullptr or (new_rnti_ptr != nullptr and not new_rnti_ptr->empty())) {
@@ -162,7 +171,7 @@ bool gtpu_tunnel_manager::update_rnti(uint16_t old_rnti, uint16_t new_rnti)
     }
   }
   while (not to_remove.empty()) {
-    remove_tunnel(to_remove.back());
+    remove_tunnel_unlocked(to_remove.back());
     to_remove.pop_back();
   }
 
@@ -173,6 +182,13 @@ bool gtpu_tunnel_manager::update_rnti(uint16_t old_rnti, uint16_t new_rnti)
 }
 
 bool gtpu_tunnel_manager::remove_tunnel(uint32_t teidin)
+{
+  srsran::rwlock_write_guard rw_lock(rwlock);
+  return remove_tunnel_unlocked(teidin);
+}
+
+// Private unlocked removal of a tunnel. The removal callbacks of the tunnels are called with the lock held
+bool gtpu_tunnel_manager::remove_tunnel_unlocked(uint32_t teidin)
 {
   tunnel& tun = tunnels[teidin];
 
@@ -193,7 +209,8 @@ bool gtpu_tunnel_manager::remove_tunnel(uint32_t teidin)
 
 bool gtpu_tunnel_manager::remove_rnti(uint16_t rnti)
 {
-  auto it = ue_teidin_db.find(rnti);
+  srsran::rwlock_write_guard rw_lock(rwlock);
+  auto                       it = ue_teidin_db.find(rnti);
   if (it == ue_teidin_db.end()) {
     logger.warning("Removing rnti. rnti=0x%x not found.", rnti);
     return false;
@@ -202,7 +219,7 @@ bool gtpu_tunnel_manager::remove_rnti(uint16_t rnti)
 
   while (not ue_teidin_db[rnti].empty()) {
     uint32_t teid = ue_teidin_db[rnti].front().teid;
-    bool     ret  = remove_tunnel(teid);
+    bool     ret  = remove_tunnel_unlocked(teid);
     srsran_expect(
         ret, "Inconsistency detected between internal data structures for rnti=0x%x," TEID_IN_FMT, rnti, teid);
   }
@@ -339,7 +356,7 @@ void gtpu_tunnel_manager::setup_forwarding(uint32_t rx_teid, uint32_t tx_teid)
   // Auto-removes indirect tunnel when the main tunnel is removed
   rx_tun.on_removal = [this, tx_teid]() {
     if (tunnels.contains(tx_teid)) {
-      remove_tunnel(tx_teid);
+      remove_tunnel_unlocked(tx_teid);
     }
   };
 
@@ -435,16 +452,16 @@ void gtpu::stop()
 }
 
 // gtpu_interface_pdcp
+// Note: May be called from the MAC UL PDU workers
 void gtpu::write_pdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_buffer_t pdu)
 {
-  srsran::span<gtpu_tunnel_manager::bearer_teid_pair> teids = tunnels.find_rnti_bearer_tunnels(rnti, eps_bearer_id);
-  if (teids.empty()) {
+  bool found = tunnels.apply_to_ul_tunnel(rnti, eps_bearer_id, [this, &pdu](const gtpu_tunnel& tx_tun) {
+    log_message(tx_tun, false, srsran::make_span(pdu));
+    send_pdu_to_tunnel(tx_tun, std::move(pdu));
+  });
+  if (not found) {
     logger.warning("The rnti=0x%x, eps-BearerID=%d does not have any pdcp_active tunnel", rnti, eps_bearer_id);
-    return;
   }
-  const gtpu_tunnel& tx_tun = *tunnels.find_tunnel(teids[0].teid);
-  log_message(tx_tun, false, srsran::make_span(pdu));
-  send_pdu_to_tunnel(tx_tun, std::move(pdu));
 }
 
 void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn)
@@ -967,12 +984,12 @@ bool gtpu::m1u_handler::init(std::string m1u_multiaddr_, std::string m1u_if_addr
   initiated      = true;
   bearer_counter = 1;
 
-  // Assign a handler to rx M1U packets
+  // Assign a handler to rx M1U packets. The multicast bursts are received and dispatched to the stack in batches
   auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
     parent->handle_gtpu_m1u_rx_packet(std::move(pdu), from);
   };
-  parent->rx_socket_handler->add_socket_handler(m1u_sd,
-                                                srsran::make_sdu_handler(logger, parent->gtpu_queue, rx_callback));
+  parent->rx_socket_handler->add_socket_handler(
+      m1u_sd, srsran::make_batch_sdu_handler(logger, parent->gtpu_queue, rx_callback));
 
   return true;
 }
@@ -29,7 +29,14 @@ namespace srsenb {
 
 pdcp::pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger_) :
   task_sched(task_sched_), logger(logger_)
-{}
+{
+  pthread_rwlock_init(&rwlock, nullptr);
+}
+
+pdcp::~pdcp()
+{
+  pthread_rwlock_destroy(&rwlock);
+}
 
 void pdcp::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_)
 {
@@ -40,6 +47,7 @@ void pdcp::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interfa
 
 void pdcp::stop()
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   for (std::map<uint32_t, user_interface>::iterator iter = users.begin(); iter != users.end(); ++iter) {
     clear_user(&iter->second);
   }
@@ -48,6 +56,7 @@ void pdcp::stop()
 
 void pdcp::add_user(uint16_t rnti)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti) == 0) {
     unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
     obj->init(&users[rnti].rlc_itf, &users[rnti].rrc_itf, &users[rnti].gtpu_itf);
@@ -71,6 +80,7 @@ void pdcp::clear_user(user_interface* ue)
 
 void pdcp::rem_user(uint16_t rnti)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti)) {
     clear_user(&users[rnti]);
     users.erase(rnti);
@@ -79,6 +89,7 @@ void pdcp::rem_user(uint16_t rnti)
 
 void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cfg)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       users[rnti].pdcp->add_bearer(lcid, cfg);
@@ -90,6 +101,7 @@ void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t&
 
 void pdcp::del_bearer(uint16_t rnti, uint32_t lcid)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti)) {
     users[rnti].pdcp->del_bearer(lcid);
   }
@@ -97,6 +109,7 @@ void pdcp::del_bearer(uint16_t rnti, uint32_t lcid)
 
 void pdcp::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti)) {
     users[rnti].pdcp->set_enabled(lcid, enabled);
   }
@@ -104,6 +117,7 @@ void pdcp::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
 
 void pdcp::reset(uint16_t rnti)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti)) {
     users[rnti].pdcp->reset();
   }
@@ -111,6 +125,7 @@ void pdcp::reset(uint16_t rnti)
 
 void pdcp::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& sec_cfg)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti)) {
     users[rnti].pdcp->config_security(lcid, sec_cfg);
   }
@@ -118,16 +133,19 @@ void pdcp::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_securi
 
 void pdcp::enable_integrity(uint16_t rnti, uint32_t lcid)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   users[rnti].pdcp->enable_integrity(lcid, srsran::DIRECTION_TXRX);
 }
 
 void pdcp::enable_encryption(uint16_t rnti, uint32_t lcid)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   users[rnti].pdcp->enable_encryption(lcid, srsran::DIRECTION_TXRX);
 }
 
 bool pdcp::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti) == 0) {
     return false;
   }
@@ -136,6 +154,7 @@ bool pdcp::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state
 
 bool pdcp::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti) == 0) {
     return false;
   }
@@ -144,6 +163,7 @@ bool pdcp::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte
 
 void pdcp::reestablish(uint16_t rnti)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti) == 0) {
     return;
   }
@@ -152,6 +172,7 @@ void pdcp::reestablish(uint16_t rnti)
 
 void pdcp::send_status_report(uint16_t rnti)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti) == 0) {
     return;
   }
@@ -161,6 +182,11 @@ void pdcp::send_status_report(uint16_t rnti)
 void pdcp::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
   if (users.count(rnti)) {
+    const split_bearer_owner_t* owner = get_split_bearer_owner(rnti, lcid);
+    if (owner != nullptr) {
+      owner->pdcp->notify_delivery(owner->rnti, owner->lcid, pdcp_sns);
+      return;
+    }
     users[rnti].pdcp->notify_delivery(lcid, pdcp_sns);
   }
 }
@@ -168,6 +194,11 @@ void pdcp::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_v
 void pdcp::notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
   if (users.count(rnti)) {
+    const split_bearer_owner_t* owner = get_split_bearer_owner(rnti, lcid);
+    if (owner != nullptr) {
+      owner->pdcp->notify_failure(owner->rnti, owner->lcid, pdcp_sns);
+      return;
+    }
     users[rnti].pdcp->notify_failure(lcid, pdcp_sns);
   }
 }
@@ -186,6 +217,7 @@ void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t
 
 void pdcp::send_status_report(uint16_t rnti, uint32_t lcid)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   if (users.count(rnti)) {
     users[rnti].pdcp->send_status_report(lcid);
   }
@@ -199,13 +231,100 @@ std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_
   return {};
 }
 
+bool pdcp::add_split_bearer_leg(uint16_t                               rnti,
+                                uint32_t                               lcid,
+                                rlc_interface_pdcp*                    leg_rlc,
+                                uint16_t                               leg_rnti,
+                                uint32_t                               leg_lcid,
+                                const srsran::pdcp_split_bearer_cfg_t& split_cfg)
+{
+  srsran::rwlock_write_guard rw_lock(rwlock);
+  if (users.count(rnti) == 0) {
+    return false;
+  }
+  user_interface_rlc& leg_itf = users[rnti].split_leg_itfs[lcid];
+  leg_itf.rnti                = leg_rnti;
+  leg_itf.rlc                 = leg_rlc;
+  if (not users[rnti].pdcp->add_split_bearer_leg(lcid, &leg_itf, leg_lcid, split_cfg)) {
+    users[rnti].split_leg_itfs.erase(lcid);
+    return false;
+  }
+  logger.info("Split bearer rnti=0x%x, lcid=%d: secondary leg is rnti=0x%x, lcid=%d", rnti, lcid, leg_rnti, leg_lcid);
+  return true;
+}
+
+void pdcp::del_split_bearer_leg(uint16_t rnti, uint32_t lcid)
+{
+  srsran::rwlock_write_guard rw_lock(rwlock);
+  if (users.count(rnti)) {
+    users[rnti].pdcp->del_split_bearer_leg(lcid);
+    users[rnti].split_leg_itfs.erase(lcid);
+  }
+}
+
+void pdcp::add_split_bearer_owner(uint16_t            rnti,
+                                  uint32_t            lcid,
+                                  pdcp_interface_rlc* owner,
+                                  uint16_t            owner_rnti,
+                                  uint32_t            owner_lcid)
+{
+  srsran::rwlock_write_guard rw_lock(rwlock);
+  if (users.count(rnti) == 0) {
+    logger.warning("Can't forward lcid=%d of inexistent rnti=0x%x to a split bearer", lcid, rnti);
+    return;
+  }
+  users[rnti].split_leg_owners[lcid] = {owner, owner_rnti, owner_lcid};
+  logger.info("RLC bearer rnti=0x%x, lcid=%d: secondary leg of split bearer rnti=0x%x, lcid=%d",
+              rnti,
+              lcid,
+              owner_rnti,
+              owner_lcid);
+}
+
+void pdcp::del_split_bearer_owner(uint16_t rnti, uint32_t lcid)
+{
+  srsran::rwlock_write_guard rw_lock(rwlock);
+  if (users.count(rnti)) {
+    users[rnti].split_leg_owners.erase(lcid);
+  }
+}
+
+const pdcp::split_bearer_owner_t* pdcp::get_split_bearer_owner(uint16_t rnti, uint32_t lcid)
+{
+  auto& owners = users[rnti].split_leg_owners;
+  auto  it     = owners.find(lcid);
+  return it != owners.end() ? &it->second : nullptr;
+}
+
 void pdcp::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
   if (users.count(rnti)) {
+    const split_bearer_owner_t* owner = get_split_bearer_owner(rnti, lcid);
+    if (owner != nullptr) {
+      owner->pdcp->write_pdu(owner->rnti, owner->lcid, std::move(sdu));
+      return;
+    }
     users[rnti].pdcp->write_pdu(lcid, std::move(sdu));
   }
 }
 
+// Note: May be called from the MAC UL PDU workers. The data PDUs of a bearer are serialized by its RLC entity
+bool pdcp::try_write_pdu_user_plane(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t& pdu)
+{
+  if (pdu == nullptr or pdu->N_bytes == 0 or ((pdu->msg[0] >> 7U) & 0x01U) != srsran::PDCP_DC_FIELD_DATA_PDU) {
+    return false;
+  }
+  srsran::rwlock_read_guard rw_lock(rwlock);
+  auto                      user_it = users.find(rnti);
+  if (user_it == users.end() or user_it->second.split_leg_owners.count(lcid) > 0 or
+      not user_it->second.pdcp->is_lte_drb(lcid)) {
+    // The PDUs of SRBs, NR bearers and secondary legs of split bearers are handled by the stack thread
+    return false;
+  }
+  user_it->second.pdcp->write_pdu(lcid, std::move(pdu));
+  return true;
+}
+
 void pdcp::user_interface_gtpu::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   gtpu->write_pdu(rnti, lcid, std::move(pdu));
@@ -236,6 +355,11 @@ bool pdcp::user_interface_rlc::sdu_queue_is_full(uint32_t lcid)
   return rlc->sdu_queue_is_full(rnti, lcid);
 }
 
+uint32_t pdcp::user_interface_rlc::get_buffer_state(uint32_t lcid)
+{
+  return rlc->get_buffer_state(rnti, lcid);
+}
+
 void pdcp::user_interface_rrc::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   rrc->write_pdu(rnti, lcid, std::move(pdu));
@@ -268,6 +392,7 @@ const char* pdcp::user_interface_rrc::get_rb_name(uint32_t lcid)
 
 void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
 {
+  srsran::rwlock_write_guard rw_lock(rwlock);
   m.ues.resize(users.size());
   size_t count = 0;
   for (auto& user : users) {
@@ -27,6 +27,11 @@
 
 namespace srsenb {
 
+// Set while a UL PDU worker writes a PDU. The RLC outputs for the stack thread are then collected in
+// "pending_upper_tasks", and pushed once the RLC lock is released, as the push waits while the queue is full
+static thread_local bool                             collect_upper_tasks = false;
+static thread_local std::vector<srsran::move_task_t> pending_upper_tasks;
+
 void rlc::init(pdcp_interface_rlc*    pdcp_,
                rrc_interface_rlc*     rrc_,
                mac_interface_rlc*     mac_,
@@ -222,11 +227,19 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
 
 void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
+  collect_upper_tasks = upper_queue != nullptr;
   pthread_rwlock_rdlock(&rwlock);
   if (users.count(rnti)) {
     users[rnti].rlc->write_pdu(lcid, payload, nof_bytes);
   }
   pthread_rwlock_unlock(&rwlock);
+  collect_upper_tasks = false;
+
+  // No SDU or notification is dropped. The worker waits for room in the queue, until it is deactivated at shutdown
+  for (srsran::move_task_t& task : pending_upper_tasks) {
+    upper_queue->push(std::move(task));
+  }
+  pending_upper_tasks.clear();
 }
 
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
@@ -273,6 +286,17 @@ bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
   return ret;
 }
 
+uint32_t rlc::get_buffer_state(uint16_t rnti, uint32_t lcid)
+{
+  uint32_t ret = 0;
+  pthread_rwlock_rdlock(&rwlock);
+  if (users.count(rnti)) {
+    ret = users[rnti].rlc->get_buffer_state(lcid);
+  }
+  pthread_rwlock_unlock(&rwlock);
+  return ret;
+}
+
 void rlc::user_interface::max_retx_attempted()
 {
   rrc->max_retx_attempted(rnti);
@@ -287,6 +311,18 @@ void rlc::user_interface::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t
 {
   if (lcid == srb_to_lcid(lte_srb::srb0)) {
     rrc->write_pdu(rnti, lcid, std::move(sdu));
+  } else if (collect_upper_tasks) {
+    // The user plane PDUs of LTE DRBs go through PDCP and GTP-U in the worker. The other SDUs are handled by the stack
+    // thread, which owns their PDCP entities. The SDUs of a bearer are pushed in order, so their order is preserved
+    if (pdcp->try_write_pdu_user_plane(rnti, lcid, sdu)) {
+      return;
+    }
+    srsenb::pdcp_interface_rlc* pdcp_      = pdcp;
+    uint16_t                    rnti_      = rnti;
+    auto                        write_pdcp = [pdcp_, rnti_, lcid](srsran::unique_byte_buffer_t& sdu_) {
+      pdcp_->write_pdu(rnti_, lcid, std::move(sdu_));
+    };
+    pending_upper_tasks.push_back(std::bind(write_pdcp, std::move(sdu)));
   } else {
     pdcp->write_pdu(rnti, lcid, std::move(sdu));
   }
@@ -294,11 +330,23 @@ void rlc::user_interface::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t
 
 void rlc::user_interface::notify_delivery(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
+  if (collect_upper_tasks) {
+    srsenb::pdcp_interface_rlc* pdcp_ = pdcp;
+    uint16_t                    rnti_ = rnti;
+    pending_upper_tasks.push_back([pdcp_, rnti_, lcid, pdcp_sns]() { pdcp_->notify_delivery(rnti_, lcid, pdcp_sns); });
+    return;
+  }
   pdcp->notify_delivery(rnti, lcid, pdcp_sns);
 }
 
 void rlc::user_interface::notify_failure(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
+  if (collect_upper_tasks) {
+    srsenb::pdcp_interface_rlc* pdcp_ = pdcp;
+    uint16_t                    rnti_ = rnti;
+    pending_upper_tasks.push_back([pdcp_, rnti_, lcid, pdcp_sns]() { pdcp_->notify_failure(rnti_, lcid, pdcp_sns); });
+    return;
+  }
   pdcp->notify_failure(rnti, lcid, pdcp_sns);
 }
 
@@ -66,6 +66,14 @@ public:
     metrics[0].phy[0].ul.mcs        = 20.2;
     metrics[0].phy[0].ul.pucch_sinr = 14.2;
     metrics[0].phy[0].ul.pusch_sinr = 14.2;
+    metrics[0].phy_load.resize(1);
+    metrics[0].phy_load[0].nof_tti            = 1000;
+    metrics[0].phy_load[0].nof_empty_tti      = 900;
+    metrics[0].phy_load[0].dl_prb_usage       = 8.5;
+    metrics[0].phy_load[0].ul_prb_usage       = 2.0;
+    metrics[0].phy_load[0].proc_time_us       = 120.0;
+    metrics[0].phy_load[0].proc_time_empty_us = 60.0;
+    metrics[0].phy_load[0].cpu_load           = 12.0;
 
     metrics[0].rf.rf_o = 10;
     metrics[0].nr_stack.mac.ues.resize(1);
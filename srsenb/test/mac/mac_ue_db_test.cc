@@ -0,0 +1,237 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/common/rnti_epoch_map.h"
+#include "srsran/common/rwlock_guard.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <thread>
+
+namespace srsenb {
+
+const uint32_t ue_alive_magic = 0xcafe;
+
+/// Mock of a MAC UE, which readers check for use-after-free
+struct dummy_ue {
+  explicit dummy_ue(uint16_t rnti_) : rnti(rnti_) {}
+  ~dummy_ue() { magic = 0; }
+
+  uint16_t              rnti;
+  std::atomic<uint32_t> magic{ue_alive_magic};
+  std::atomic<uint64_t> nof_callbacks{0};
+};
+
+/// Emulates the work of a PHY->MAC callback (e.g. crc_info) on the UE object
+inline bool callback_work(dummy_ue& u, uint16_t rnti)
+{
+  if (u.magic.load(std::memory_order_relaxed) != ue_alive_magic or u.rnti != rnti) {
+    return false;
+  }
+  u.nof_callbacks.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+struct bench_result {
+  double   callbacks_per_sec = 0;
+  uint64_t nof_errors        = 0;
+};
+
+/// UE DB protected by a process-wide rwlock, as used by the MAC before
+struct rwlock_ue_db {
+  rwlock_ue_db() { pthread_rwlock_init(&rwlock, nullptr); }
+  ~rwlock_ue_db() { pthread_rwlock_destroy(&rwlock); }
+
+  bool callback(uint16_t rnti)
+  {
+    srsran::rwlock_read_guard lock(rwlock);
+    if (not ue_db.contains(rnti)) {
+      return true;
+    }
+    return callback_work(*ue_db[rnti], rnti);
+  }
+  void add(uint16_t rnti)
+  {
+    srsran::rwlock_write_guard lock(rwlock);
+    ue_db.insert(rnti, std::unique_ptr<dummy_ue>(new dummy_ue(rnti)));
+  }
+  void rem(uint16_t rnti)
+  {
+    srsran::rwlock_write_guard lock(rwlock);
+    ue_db.erase(rnti);
+  }
+
+  pthread_rwlock_t                       rwlock = {};
+  rnti_map_t<std::unique_ptr<dummy_ue> > ue_db;
+};
+
+/// UE DB with lock-free lookups and epoch-based reclamation
+struct epoch_ue_db {
+  bool callback(uint16_t rnti)
+  {
+    srsran::epoch_read_guard   lock;
+    std::unique_ptr<dummy_ue>* u = ue_db.find(rnti);
+    if (u == nullptr) {
+      return true;
+    }
+    return callback_work(**u, rnti);
+  }
+  void add(uint16_t rnti) { ue_db.insert(rnti, std::unique_ptr<dummy_ue>(new dummy_ue(rnti))); }
+  void rem(uint16_t rnti)
+  {
+    ue_db.erase(rnti);
+    ue_db.reclaim();
+  }
+
+  rnti_epoch_map<std::unique_ptr<dummy_ue> > ue_db;
+};
+
+/// Runs "nof_phy_threads" PHY workers issuing callbacks, while the stack thread keeps adding/removing UEs
+template <typename UEDb>
+bench_result run_callback_benchmark(uint32_t nof_phy_threads, uint32_t nof_ues, std::chrono::milliseconds duration)
+{
+  const uint16_t first_rnti = 0x46;
+  UEDb           db;
+  for (uint16_t i = 0; i < nof_ues; ++i) {
+    db.add(first_rnti + i);
+  }
+
+  std::atomic<bool>     running{true};
+  std::atomic<uint64_t> nof_callbacks{0}, nof_errors{0};
+
+  std::vector<std::thread> phy_workers;
+  for (uint32_t w = 0; w < nof_phy_threads; ++w) {
+    phy_workers.emplace_back([&, w]() {
+      uint64_t count = 0, errors = 0;
+      uint32_t idx   = w;
+      while (running.load(std::memory_order_relaxed)) {
+        // Emulate several callbacks per TTI (CRC, ACK, CQI, ...) for the scheduled UEs
+        for (uint32_t i = 0; i < 64; ++i) {
+          uint16_t rnti = first_rnti + (idx++ % nof_ues);
+          errors += db.callback(rnti) ? 0 : 1;
+        }
+        count += 64;
+      }
+      nof_callbacks.fetch_add(count);
+      nof_errors.fetch_add(errors);
+    });
+  }
+
+  // Stack thread: UE removal and re-addition, i.e. writer activity
+  std::thread stack_thread([&]() {
+    uint32_t idx = 0;
+    while (running.load(std::memory_order_relaxed)) {
+      uint16_t rnti = first_rnti + (idx++ % nof_ues);
+      db.rem(rnti);
+      db.add(rnti);
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  });
+
+  auto tp = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(duration);
+  running = false;
+  for (auto& t : phy_workers) {
+    t.join();
+  }
+  stack_thread.join();
+  double elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - tp).count();
+
+  bench_result ret;
+  ret.callbacks_per_sec = nof_callbacks.load() / elapsed_sec;
+  ret.nof_errors        = nof_errors.load();
+  return ret;
+}
+
+void test_rnti_epoch_map()
+{
+  rnti_epoch_map<std::unique_ptr<dummy_ue>, 4> ue_db;
+  TESTASSERT(ue_db.empty() and not ue_db.full());
+
+  TESTASSERT(ue_db.insert(0x46, std::unique_ptr<dummy_ue>(new dummy_ue(0x46))) != nullptr);
+  TESTASSERT(ue_db.contains(0x46) and ue_db.size() == 1);
+  TESTASSERT(not ue_db.has_space(0x46) and not ue_db.has_space(0x4a));
+  TESTASSERT(ue_db.insert(0x4a, std::unique_ptr<dummy_ue>(new dummy_ue(0x4a))) == nullptr);
+  TESTASSERT(not ue_db.contains(0x4a));
+
+  {
+    // While a reader is active, the removed UE cannot be reclaimed
+    srsran::epoch_read_guard lock;
+    dummy_ue*                u = ue_db[0x46].get();
+    TESTASSERT(ue_db.erase(0x46));
+    TESTASSERT(not ue_db.contains(0x46) and ue_db.empty());
+    TESTASSERT(ue_db.reclaim() == 1);
+    TESTASSERT(u->magic == ue_alive_magic);
+  }
+  TESTASSERT(ue_db.reclaim() == 0);
+  TESTASSERT(not ue_db.erase(0x46));
+
+  // Readers that entered after the removal do not hold back reclamation
+  TESTASSERT(ue_db.insert(0x47, std::unique_ptr<dummy_ue>(new dummy_ue(0x47))) != nullptr);
+  TESTASSERT(ue_db.erase(0x47));
+  {
+    srsran::epoch_read_guard lock;
+    TESTASSERT(ue_db.reclaim() == 0);
+  }
+
+  uint32_t count = 0;
+  for (uint16_t rnti = 0x46; rnti < 0x4a; ++rnti) {
+    TESTASSERT(ue_db.insert(rnti, std::unique_ptr<dummy_ue>(new dummy_ue(rnti))) != nullptr);
+  }
+  TESTASSERT(ue_db.full());
+  ue_db.for_each([&count](uint16_t rnti, std::unique_ptr<dummy_ue>& u) { count += (u->rnti == rnti) ? 1 : 0; });
+  TESTASSERT(count == 4);
+  ue_db.clear();
+  TESTASSERT(ue_db.empty() and ue_db.nof_pending_reclaims() == 4);
+  ue_db.synchronize();
+  TESTASSERT(ue_db.nof_pending_reclaims() == 0);
+}
+
+void run_benchmark(std::chrono::milliseconds duration)
+{
+  const uint32_t nof_ues = 32;
+
+  fmt::print("PHY->MAC callback throughput with UE add/rem running in the stack thread ({} UEs)\n", nof_ues);
+  fmt::print("Nthreads | rwlock [Mcallbacks/s] | epoch [Mcallbacks/s] | speedup\n");
+  for (uint32_t nof_threads : {1, 4, 8}) {
+    bench_result rw    = run_callback_benchmark<rwlock_ue_db>(nof_threads, nof_ues, duration);
+    bench_result epoch = run_callback_benchmark<epoch_ue_db>(nof_threads, nof_ues, duration);
+    TESTASSERT(rw.nof_errors == 0);
+    TESTASSERT(epoch.nof_errors == 0);
+    fmt::print("{:>8} | {:>21.2f} | {:>20.2f} | {:>6.2f}x\n",
+               nof_threads,
+               rw.callbacks_per_sec / 1e6,
+               epoch.callbacks_per_sec / 1e6,
+               epoch.callbacks_per_sec / rw.callbacks_per_sec);
+  }
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srsenb::test_rnti_epoch_map();
+
+  // Use "benchmark" argument for longer runs
+  bool long_run = argc > 1 and strcmp(argv[1], "benchmark") == 0;
+  srsenb::run_benchmark(std::chrono::milliseconds(long_run ? 2000 : 100));
+
+  return 0;
+}
@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/stack/mac/sched_ue_ctrl/sched_dl_cqi.h"
+#include "srsenb/hdr/stack/mac/sched_ue_ctrl/sched_ul_sinr.h"
 #include "srsran/common/test_common.h"
 
 namespace srsenb {
@@ -89,6 +90,43 @@ void test_sched_cqi_wideband_cqi()
   }
 }
 
+void test_sched_ul_sinr()
+{
+  uint32_t      nof_prb = 50;
+  sched_ul_sinr ue_sinr(nof_prb, 100, 0.5);
+
+  TESTASSERT(not ue_sinr.is_sinr_info_valid(tti_point(0)));
+
+  // SRS covering PRBs 8..24, in 4 subbands of 4 PRBs. The best subband is the third
+  const float sb_snr_db[] = {5, 10, 20, 10};
+  ue_sinr.sb_snr_info(tti_point(0), 8, 4, sb_snr_db);
+
+  // TEST: measured PRBs take the SINR of their subband. Non-measured PRBs take the average SINR
+  TESTASSERT(ue_sinr.is_sinr_info_valid(tti_point(10)));
+  TESTASSERT(ue_sinr.get_prb_sinr(8, tti_point(10)) == 5);
+  TESTASSERT(ue_sinr.get_prb_sinr(16, tti_point(10)) == 20);
+  TESTASSERT(ue_sinr.get_prb_sinr(0, tti_point(10)) == 11.25);
+  TESTASSERT(ue_sinr.get_avg_sinr(prb_interval(12, 20), tti_point(10)) == 15);
+
+  // TEST: Get optimal PRB interval in terms of SINR
+  prbmask_t ul_mask(nof_prb);
+  TESTASSERT(ue_sinr.get_optim_prb_interval(ul_mask, 4, tti_point(10)) == prb_interval(16, 20));
+  ul_mask.fill(14, 18);
+  TESTASSERT(ue_sinr.get_optim_prb_interval(ul_mask, 4, tti_point(10)) == prb_interval(18, 22));
+  ul_mask.fill(0, nof_prb);
+  TESTASSERT(ue_sinr.get_optim_prb_interval(ul_mask, 4, tti_point(10)).empty());
+
+  // TEST: measurements are averaged
+  const float sb_snr_db2[] = {15};
+  ue_sinr.sb_snr_info(tti_point(20), 8, 4, sb_snr_db2);
+  TESTASSERT(ue_sinr.get_prb_sinr(8, tti_point(20)) == 10);
+
+  // TEST: old measurements are forgotten, and a flat channel keeps the first-fit allocation
+  TESTASSERT(not ue_sinr.is_sinr_info_valid(tti_point(200)));
+  ul_mask.reset();
+  TESTASSERT(ue_sinr.get_optim_prb_interval(ul_mask, 4, tti_point(200)) == prb_interval(0, 4));
+}
+
 } // namespace srsenb
 
 int main(int argc, char** argv)
@@ -97,6 +135,7 @@ int main(int argc, char** argv)
 
   srsenb::test_sched_cqi_one_subband_cqi();
   srsenb::test_sched_cqi_wideband_cqi();
+  srsenb::test_sched_ul_sinr();
 
   return SRSRAN_SUCCESS;
 }
@@ -24,6 +24,8 @@
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sched_dci.h"
 #include "srsran/common/common_lte.h"
 #include "srsran/support/srsran_test.h"
+#include <chrono>
+#include <inttypes.h>
 
 namespace srsenb {
 
@@ -280,6 +282,138 @@ int test_min_mcs_tbs_specific()
   return SRSRAN_SUCCESS;
 }
 
+/// Linear search of the lowest MCS whose TBS fits the required bytes, used as reference for the min MCS search
+tbs_info ref_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
+                                                 uint32_t nof_re,
+                                                 uint32_t cqi,
+                                                 uint32_t max_mcs,
+                                                 uint32_t req_bytes,
+                                                 bool     is_ul,
+                                                 bool     ulqam64_enabled,
+                                                 bool     use_tbs_index_alt)
+{
+  tbs_info tb_max = compute_mcs_and_tbs(nof_prb, nof_re, cqi, max_mcs, is_ul, ulqam64_enabled, use_tbs_index_alt);
+  if (tb_max.tbs_bytes + 8 <= (int)req_bytes or tb_max.mcs == 0) {
+    return tb_max;
+  }
+  for (int mcs = 0; mcs < tb_max.mcs; ++mcs) {
+    tbs_info tb2 = compute_mcs_and_tbs(nof_prb, nof_re, cqi, mcs, is_ul, ulqam64_enabled, use_tbs_index_alt);
+    if (tb2.tbs_bytes >= (int)req_bytes) {
+      return tb2;
+    }
+  }
+  return tb_max;
+}
+
+/// Verify that the search for the min MCS yields the same result as a linear search over all MCSs
+int test_min_mcs_tbs_search_all()
+{
+  sched_interface::sched_args_t sched_args  = {};
+  sched_interface::cell_cfg_t   cell_cfg    = generate_default_cell_cfg(100);
+  sched_cell_params_t           cell_params = {};
+  cell_params.set_cfg(0, cell_cfg, sched_args);
+
+  const uint32_t req_bytes_list[] = {1, 10, 50, 100, 109, 500, 1000, 5000, 10000};
+  for (uint32_t i = 0; i < 4; ++i) {
+    bool is_ul             = i >= 2;
+    bool use_tbs_index_alt = i == 1;
+    bool ulqam64_enabled   = i == 3;
+    for (uint32_t prb_grant = 1; prb_grant <= cell_params.nof_prb(); ++prb_grant) {
+      uint32_t nof_re = is_ul ? 2 * (SRSRAN_CP_NSYMB(cell_params.cfg.cell.cp) - 1) * prb_grant * SRSRAN_NRE
+                              : cell_params.get_dl_lb_nof_re(tti_point{1}, prb_grant);
+      for (uint32_t cqi = 0; cqi < 16; ++cqi) {
+        for (uint32_t max_mcs = 0; max_mcs <= 28; ++max_mcs) {
+          for (uint32_t req_bytes : req_bytes_list) {
+            tbs_info tb = compute_min_mcs_and_tbs_from_required_bytes(
+                prb_grant, nof_re, cqi, max_mcs, req_bytes, is_ul, ulqam64_enabled, use_tbs_index_alt);
+            tbs_info tb_ref = ref_min_mcs_and_tbs_from_required_bytes(
+                prb_grant, nof_re, cqi, max_mcs, req_bytes, is_ul, ulqam64_enabled, use_tbs_index_alt);
+            TESTASSERT_EQ(tb_ref.mcs, tb.mcs);
+            TESTASSERT_EQ(tb_ref.tbs_bytes, tb.tbs_bytes);
+          }
+        }
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Verify the cached TBS tables of the cell against the TBS determination procedure
+int test_cell_tbs_table()
+{
+  sched_interface::sched_args_t sched_args = {};
+  for (auto& nof_prb_cell : srsran::lte_cell_nof_prbs) {
+    sched_interface::cell_cfg_t cell_cfg    = generate_default_cell_cfg(nof_prb_cell);
+    sched_cell_params_t         cell_params = {};
+    cell_params.set_cfg(0, cell_cfg, sched_args);
+    for (uint32_t i = 0; i < 3; ++i) {
+      bool is_ul             = i == 2;
+      bool use_tbs_index_alt = i == 1;
+      for (uint32_t mcs = 0; mcs < 29; ++mcs) {
+        if (srsran_ra_tbs_idx_from_mcs(mcs, use_tbs_index_alt, is_ul) < 0) {
+          continue;
+        }
+        for (uint32_t nof_prb = 1; nof_prb <= nof_prb_cell; ++nof_prb) {
+          uint32_t tbs = get_tbs_bytes(mcs, nof_prb, use_tbs_index_alt, is_ul);
+          TESTASSERT_EQ((int)tbs, cell_params.get_tbs_bytes(mcs, nof_prb, use_tbs_index_alt, is_ul));
+          // The min nof PRBs carrying a TBS is the first nof PRBs whose TBS is at least as large
+          uint32_t min_prb_ref = 1;
+          while (get_tbs_bytes(mcs, min_prb_ref, use_tbs_index_alt, is_ul) < tbs) {
+            min_prb_ref++;
+          }
+          TESTASSERT_EQ((int)min_prb_ref, cell_params.get_min_nof_prb(mcs, tbs, use_tbs_index_alt, is_ul));
+        }
+        uint32_t max_tbs = cell_params.get_tbs_bytes(mcs, nof_prb_cell, use_tbs_index_alt, is_ul);
+        TESTASSERT_EQ(-1, cell_params.get_min_nof_prb(mcs, max_tbs + 1, use_tbs_index_alt, is_ul));
+        TESTASSERT_EQ(-1, cell_params.get_tbs_bytes(mcs, 0, use_tbs_index_alt, is_ul));
+        TESTASSERT_EQ(-1, cell_params.get_tbs_bytes(mcs, nof_prb_cell + 1, use_tbs_index_alt, is_ul));
+      }
+      // MCSs outside of the MCS table
+      TESTASSERT_EQ(-1, cell_params.get_tbs_bytes(29, 1, use_tbs_index_alt, is_ul));
+      TESTASSERT_EQ(-1, cell_params.get_tbs_bytes(31, 1, use_tbs_index_alt, is_ul));
+    }
+    TESTASSERT_EQ(-1, cell_params.get_tbs_bytes(28, 1, true, false));
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/// Measure the cost of the per-UE TBS/PRB queries with and without the cell TBS tables
+void benchmark_tbs_lookup()
+{
+  sched_interface::sched_args_t sched_args  = {};
+  sched_interface::cell_cfg_t   cell_cfg    = generate_default_cell_cfg(100);
+  sched_cell_params_t           cell_params = {};
+  cell_params.set_cfg(0, cell_cfg, sched_args);
+
+  const uint32_t nof_reps = 100;
+  uint64_t       sum      = 0;
+  auto           tp0      = std::chrono::steady_clock::now();
+  for (uint32_t rep = 0; rep < nof_reps; ++rep) {
+    for (uint32_t mcs = 0; mcs < 29; ++mcs) {
+      uint32_t req_bytes = 10 + rep * 10;
+      uint32_t nof_prb   = 1;
+      while (nof_prb < cell_params.nof_prb() and get_tbs_bytes(mcs, nof_prb, false, true) < req_bytes) {
+        nof_prb++;
+      }
+      sum += nof_prb;
+    }
+  }
+  auto tp1 = std::chrono::steady_clock::now();
+  for (uint32_t rep = 0; rep < nof_reps; ++rep) {
+    for (uint32_t mcs = 0; mcs < 29; ++mcs) {
+      uint32_t req_bytes = 10 + rep * 10;
+      sum += cell_params.get_min_nof_prb(mcs, req_bytes, false, true);
+    }
+  }
+  auto tp2 = std::chrono::steady_clock::now();
+
+  uint32_t nof_calls = nof_reps * 29;
+  printf("Min nof PRBs for a TBS: linear search=%.1f ns/call, cell table=%.1f ns/call (checksum=%" PRIu64 ")\n",
+         std::chrono::duration_cast<std::chrono::nanoseconds>(tp1 - tp0).count() / (double)nof_calls,
+         std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp1).count() / (double)nof_calls,
+         sum);
+}
+
 void test_ul_mcs_tbs_derivation()
 {
   uint32_t cqi     = 15;
@@ -332,7 +466,10 @@ int main()
   TESTASSERT(srsenb::test_mcs_lookup_specific() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_mcs_tbs_consistency_all() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_min_mcs_tbs_specific() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_min_mcs_tbs_search_all() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_cell_tbs_table() == SRSRAN_SUCCESS);
   srsenb::test_ul_mcs_tbs_derivation();
+  srsenb::benchmark_tbs_lookup();
 
   printf("Success\n");
   return 0;
@@ -0,0 +1,248 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_utils.h"
+#include "srsenb/hdr/stack/mac/mac.h"
+#include "srsran/interfaces/enb_phy_interfaces.h"
+#include "srsran/interfaces/enb_rlc_interfaces.h"
+#include "srsran/common/test_common.h"
+#include "srsran/mac/pdu.h"
+#include <chrono>
+#include <thread>
+
+/**
+ * Test and benchmark of the UL MAC PDU processing in the eNB MAC. The UL grants of several UEs are obtained from
+ * mac::get_ul_sched, and the PDUs are filled and handed back through mac::crc_info and mac::push_pdu, as the PHY does.
+ * The PDUs are then demultiplexed either in the stack thread or in the UE-plane workers. The test checks that the SDU
+ * order of each UE is preserved, while the stack thread reads the MAC metrics, and reports the achieved UL rate for
+ * different numbers of workers.
+ *
+ * Usage: ul_pdu_workers_test [test|benchmark]
+ */
+
+namespace srsenb {
+
+const uint32_t nof_prb      = 25;
+const uint32_t nof_ues      = 8;
+const uint32_t max_sdu_len  = 1500;
+const uint32_t min_sdu_len  = 8;
+const uint32_t drb_lcid     = 3;
+const uint32_t max_nof_subh = 20;
+
+class phy_dummy_lte : public phy_interface_stack_lte
+{
+public:
+  void rem_rnti(uint16_t rnti) override {}
+  void set_mch_period_stop(uint32_t stop) override {}
+  void set_activation_deactivation_scell(uint16_t                                     rnti,
+                                         const std::array<bool, SRSRAN_MAX_CARRIERS>& activation) override
+  {}
+  void configure_mbsfn(srsran::sib2_mbms_t* sib2, srsran::sib13_t* sib13, const srsran::mcch_msg_t& mcch) override {}
+  void set_config(uint16_t rnti, const phy_rrc_cfg_list_t& phy_cfg_list) override {}
+  void complete_config(uint16_t rnti) override {}
+};
+
+class rrc_dummy_mac : public rrc_interface_mac
+{
+public:
+  int  add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg) override { return SRSRAN_SUCCESS; }
+  void upd_user(uint16_t new_rnti, uint16_t old_rnti) override {}
+  void set_activity_user(uint16_t rnti) override {}
+  void set_radiolink_dl_state(uint16_t rnti, bool crc_res) override {}
+  void set_radiolink_ul_state(uint16_t rnti, bool crc_res) override {}
+  bool is_paging_opportunity(uint32_t tti_tx_dl, uint32_t* payload_len) override { return false; }
+  void read_pdu_pcch(uint32_t tti_tx_dl, uint8_t* payload, uint32_t payload_size) override {}
+  uint8_t* read_pdu_bcch_dlsch(const uint8_t enb_cc_idx, const uint32_t sib_index) override { return sib.data(); }
+
+private:
+  std::array<uint8_t, 128> sib = {};
+};
+
+/// RLC that checks the order of the DRB SDUs of each UE, which carry their sequence number in the first bytes
+class rlc_dummy_ul : public rlc_interface_mac
+{
+public:
+  struct ue_rx_t {
+    uint32_t next_sdu_sn  = 0;
+    uint64_t rx_bytes     = 0;
+    uint32_t order_errors = 0;
+  };
+
+  /// Called before the traffic starts. The UEs are then only accessed by the thread that processes their PDUs
+  void add_user(uint16_t rnti) { ues[rnti]; }
+
+  int  read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) override { return 0; }
+  void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) override
+  {
+    auto it = ues.find(rnti);
+    if (lcid != drb_lcid or it == ues.end()) {
+      return;
+    }
+    ue_rx_t& ue = it->second;
+    uint32_t sn;
+    memcpy(&sn, payload, sizeof(sn));
+    ue.order_errors += (sn != ue.next_sdu_sn) ? 1 : 0;
+    ue.next_sdu_sn = sn + 1;
+    ue.rx_bytes += nof_bytes;
+    nof_rx_sdus.fetch_add(1, std::memory_order_release);
+  }
+
+  std::map<uint16_t, ue_rx_t> ues;
+  std::atomic<uint64_t>       nof_rx_sdus{0};
+};
+
+/// Fills the UL PDU of a grant with a long BSR, a PHR and DRB SDUs. Returns the number of SDUs
+uint32_t fill_ul_pdu(srsran::sch_pdu& mac_msg, uint8_t* data, uint32_t tbs, uint32_t& sdu_sn)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  TESTASSERT(pdu != nullptr);
+  std::array<uint8_t, max_sdu_len> sdu = {};
+
+  mac_msg.init_tx(pdu.get(), tbs, true);
+  // Keep the UE UL buffer full
+  uint32_t buff_size[4] = {0, 150000, 0, 0};
+  TESTASSERT(mac_msg.new_subh() and mac_msg.get()->set_bsr(buff_size, srsran::ul_sch_lcid::LONG_BSR));
+  // The PHR updates the UE metrics that are read concurrently by the stack thread
+  TESTASSERT(mac_msg.new_subh() and mac_msg.get()->set_phr(10));
+  uint32_t nof_sdus = 0;
+  while (mac_msg.rem_size() >= (int)(min_sdu_len + 3) and nof_sdus + 3 < max_nof_subh) {
+    uint32_t sdu_len = std::min(max_sdu_len, (uint32_t)mac_msg.rem_size() - 3);
+    memcpy(sdu.data(), &sdu_sn, sizeof(sdu_sn));
+    TESTASSERT(mac_msg.new_subh());
+    TESTASSERT(mac_msg.get()->set_sdu(drb_lcid, sdu_len, sdu.data()) == (int)sdu_len);
+    sdu_sn++;
+    nof_sdus++;
+  }
+  uint8_t* ptr = mac_msg.write_packet();
+  TESTASSERT(ptr != nullptr);
+  memcpy(data, ptr, tbs);
+  return nof_sdus;
+}
+
+struct run_result {
+  uint64_t nof_sdus;
+  double   ul_mbps;
+};
+
+run_result run_scenario(uint32_t nof_workers, uint32_t nof_ttis)
+{
+  auto&                  logger = srslog::fetch_basic_logger("MAC", false);
+  srsran::task_scheduler task_sched;
+  phy_dummy_lte          phy;
+  rlc_dummy_ul           rlc;
+  rrc_dummy_mac          rrc;
+
+  mac_args_t args         = {};
+  args.nof_prb            = nof_prb;
+  args.lcid_padding       = -1;
+  args.nof_prealloc_ues   = nof_ues;
+  args.max_nof_kos        = 100;
+  args.nof_ul_pdu_workers = nof_workers;
+  args.sched.pusch_mcs    = 20;
+
+  mac mac(&task_sched, logger);
+  TESTASSERT(mac.init(args, cell_list_t(1), &phy, &rlc, &rrc));
+  TESTASSERT(mac.cell_cfg({generate_default_cell_cfg(nof_prb)}) == SRSRAN_SUCCESS);
+
+  sched_interface::ue_cfg_t    ue_cfg = generate_default_ue_cfg();
+  std::map<uint16_t, uint32_t> tx_sdu_sn;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    uint16_t rnti = mac.reserve_new_crnti(ue_cfg);
+    TESTASSERT(rnti != SRSRAN_INVALID_RNTI);
+    rlc.add_user(rnti);
+    tx_sdu_sn[rnti] = 0;
+    TESTASSERT(mac.sr_detected(0, rnti) == SRSRAN_SUCCESS);
+  }
+
+  srsran::sch_pdu                        mac_msg(max_nof_subh, logger);
+  mac_interface_phy_lte::ul_sched_list_t ul_res(1);
+  uint64_t                               nof_tx_sdus = 0;
+  uint64_t                               tx_bytes    = 0;
+  auto                                   tp          = std::chrono::steady_clock::now();
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    TESTASSERT(mac.get_ul_sched(tti, ul_res) == SRSRAN_SUCCESS);
+    for (uint32_t i = 0; i < ul_res[0].nof_grants; ++i) {
+      mac_interface_phy_lte::ul_sched_grant_t& grant = ul_res[0].pusch[i];
+      uint16_t                                 rnti  = grant.dci.rnti;
+      uint32_t                                 L_prb = 0, RB_start = 0;
+      srsran_ra_type2_from_riv(grant.dci.type2_alloc.riv, &L_prb, &RB_start, nof_prb, nof_prb);
+      int tbs = srsran_ra_tbs_from_idx(srsran_ra_tbs_idx_from_mcs(grant.dci.tb.mcs_idx, false, true), L_prb) / 8;
+      TESTASSERT(tbs > 0 and grant.data != nullptr and tx_sdu_sn.count(rnti) > 0);
+
+      // Emulate the decoding of the PUSCH
+      nof_tx_sdus += fill_ul_pdu(mac_msg, grant.data, tbs, tx_sdu_sn[rnti]);
+      tx_bytes += tbs;
+      TESTASSERT(mac.crc_info(tti, rnti, 0, tbs, true) == SRSRAN_SUCCESS);
+      TESTASSERT(mac.push_pdu(tti, rnti, 0, tbs, true, L_prb) == SRSRAN_SUCCESS);
+    }
+
+    // Stack thread work, which includes the PDU processing when there are no workers
+    task_sched.run_pending_tasks();
+    if (tti % 100 == 0) {
+      mac_metrics_t metrics;
+      mac.get_metrics(metrics);
+      TESTASSERT(metrics.ues.size() == nof_ues);
+    }
+  }
+
+  // Wait for all the PDUs to be processed
+  while (rlc.nof_rx_sdus.load(std::memory_order_acquire) < nof_tx_sdus) {
+    task_sched.run_pending_tasks();
+    std::this_thread::yield();
+  }
+  double elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - tp).count();
+  mac.stop();
+
+  TESTASSERT(nof_tx_sdus > 0);
+  for (auto& ue : rlc.ues) {
+    TESTASSERT(ue.second.order_errors == 0);
+    TESTASSERT(ue.second.next_sdu_sn == tx_sdu_sn[ue.first]);
+    TESTASSERT(ue.second.next_sdu_sn > 0);
+  }
+  return {nof_tx_sdus, tx_bytes * 8 / elapsed_sec / 1e6};
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("MAC", false).set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("POOL", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  uint32_t nof_ttis = 1000;
+  if (argc > 1 and strcmp(argv[1], "benchmark") == 0) {
+    nof_ttis = 20000;
+  }
+
+  fmt::print("UL PDU processing rate through mac::push_pdu ({} UEs, {} PRBs, {} TTIs)\n",
+             srsenb::nof_ues,
+             srsenb::nof_prb,
+             nof_ttis);
+  fmt::print("Nworkers | SDUs   | UL rate [Mbps]\n");
+  for (uint32_t nof_workers : {0, 1, 2, 4}) {
+    srsenb::run_result r = srsenb::run_scenario(nof_workers, nof_ttis);
+    fmt::print("{:>8} | {:>6} | {:>14.1f}\n", nof_workers, r.nof_sdus, r.ul_mbps);
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
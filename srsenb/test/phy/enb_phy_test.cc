@@ -26,6 +26,7 @@
 #include <boost/program_options.hpp>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
+#include <deque>
 #include <iostream>
 #include <mutex>
 #include <srsenb/hdr/phy/phy.h>
@@ -72,6 +73,59 @@ private:
     received_##NAME = true;                                                                                            \
   }
 
+/**
+ * Measures the time the eNb PHY takes from requesting the DL scheduling of a TTI to transmitting it. The PHY processes
+ * the TTIs in order, so every transmission is matched with the oldest pending scheduling request.
+ */
+class dl_latency_meter
+{
+private:
+  using clock_t = std::chrono::steady_clock;
+
+  std::mutex                      mutex;
+  std::deque<clock_t::time_point> pending;
+  std::chrono::microseconds       deadline;
+  uint32_t                        nof_tti    = 0;
+  uint32_t                        nof_missed = 0;
+  std::chrono::microseconds       sum_latency{0};
+  std::chrono::microseconds       max_latency{0};
+
+public:
+  explicit dl_latency_meter(uint32_t deadline_us) : deadline(deadline_us) {}
+
+  void new_dl_sched()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(clock_t::now());
+  }
+
+  void new_tx()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pending.empty()) {
+      return;
+    }
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(clock_t::now() - pending.front());
+    pending.pop_front();
+    nof_tti++;
+    nof_missed += (latency > deadline) ? 1 : 0;
+    sum_latency += latency;
+    max_latency = std::max(max_latency, latency);
+  }
+
+  void print(uint32_t nof_ue_task_threads)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    printf("DL processing with %d UE task threads: avg=%.1f us, max=%ld us, missed %d of %d TTI deadlines of %ld us\n",
+           nof_ue_task_threads,
+           nof_tti > 0 ? (double)sum_latency.count() / nof_tti : 0.0,
+           (long)max_latency.count(),
+           nof_missed,
+           nof_tti,
+           (long)deadline.count());
+  }
+};
+
 class dummy_radio final : public srsran::radio_interface_phy
 {
 private:
@@ -83,6 +137,7 @@ private:
   srsran::rf_timestamp_t            ts_rx    = {};
   double                            rx_srate = 0.0;
   std::atomic<bool>                 running  = {true};
+  dl_latency_meter*                 latency  = nullptr;
 
   CALLBACK(tx);
   CALLBACK(tx_end);
@@ -160,6 +215,8 @@ public:
 
   void stop() { running = false; }
 
+  void set_latency_meter(dl_latency_meter* latency_) { latency = latency_; }
+
   int read_tx(std::vector<cf_t*>& buffers, uint32_t nof_samples)
   {
     int      err    = SRSRAN_SUCCESS;
@@ -205,6 +262,10 @@ public:
       err = srsran_ringbuffer_write(ringbuffers_tx[i], buffer.get(i), nbytes);
     }
 
+    if (latency != nullptr) {
+      latency->new_tx();
+    }
+
     // Notify call
     notify_tx();
 
@@ -286,6 +347,7 @@ private:
   uint8_t*                                          data                                                    = nullptr;
   uint16_t                                          ue_rnti                                                 = 0;
   srsran_random_t                                   random_gen                                              = nullptr;
+  dl_latency_meter*                                 latency                                                 = nullptr;
 
   CALLBACK(sr_detected);
   CALLBACK(rach_detected);
@@ -415,6 +477,8 @@ public:
     srsran_random_free(random_gen);
   }
 
+  void set_latency_meter(dl_latency_meter* latency_) { latency = latency_; }
+
   void set_active_cell_list(std::vector<uint32_t>& active_cell_list_)
   {
     std::lock_guard<std::mutex> lock(phy_mac_mutex);
@@ -483,6 +547,21 @@ public:
     notify_snr_info();
     return 0;
   }
+  int ul_sb_snr_info(uint32_t                  tti,
+                     uint16_t                  rnti,
+                     uint32_t                  cc_idx,
+                     uint32_t                  prb_start,
+                     uint32_t                  sb_nof_prb,
+                     srsran::span<const float> sb_snr_db) override
+  {
+    logger.info("Received UL subband SNR tti=%d; rnti=0x%x; cc_idx=%d; prb_start=%d; nof_sb=%zd;",
+                tti,
+                rnti,
+                cc_idx,
+                prb_start,
+                sb_snr_db.size());
+    return SRSRAN_SUCCESS;
+  }
   int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override
   {
     logger.info("Received TA INFO tti=%d; rnti=0x%x; ta=%.1f us", tti, rnti, ta_us);
@@ -535,6 +614,9 @@ public:
 
     // Notify test engine
     notify_get_dl_sched();
+    if (latency != nullptr) {
+      latency->new_dl_sched();
+    }
 
     // Make sure it writes the CFI in all cells
     for (dl_sched_t& dl_sched : dl_sched_res) {
@@ -1175,6 +1257,8 @@ public:
     uint32_t              period_pcell_rotate = 0;
     srsran_tm_t           tm                  = SRSRAN_TM1;
     bool                  extended_cp         = false;
+    uint32_t              nof_ue_task_threads = 0;
+    uint32_t              deadline_us         = 1000; ///< DL processing budget of a TTI
     args_t()
     {
       cell.nof_prb   = 6;
@@ -1216,6 +1300,7 @@ private:
   unique_srsenb_phy_t   enb_phy;
   unique_dummy_ue_phy_t ue_phy;
   srslog::basic_logger& logger;
+  dl_latency_meter      dl_latency;
 
   args_t                                            args = {};   ///< Test arguments
   srsenb::phy_args_t                                phy_args = {};   ///< PHY arguments
@@ -1232,7 +1317,7 @@ private:
 
 public:
   phy_test_bench(args_t& args_, srslog::sink& log_sink) :
-    logger(srslog::fetch_basic_logger("TEST BENCH", log_sink, false))
+    logger(srslog::fetch_basic_logger("TEST BENCH", log_sink, false)), dl_latency(args_.deadline_us)
   {
     // Copy test arguments
     args = args_;
@@ -1241,8 +1326,9 @@ public:
     logger.set_level(srslog::str_to_basic_level(args.log_level));
 
     // PHY arguments
-    phy_args.log.phy_level   = args.log_level;
-    phy_args.nof_phy_threads = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.log.phy_level       = args.log_level;
+    phy_args.nof_phy_threads     = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.nof_ue_task_threads = args.nof_ue_task_threads;
 
     // Create cell configuration
     phy_cfg.phy_cell_cfg.resize(args.nof_enb_cells);
@@ -1336,6 +1422,10 @@ public:
     stack = unique_dummy_stack_t(new dummy_stack(phy_cfg, phy_rrc_cfg, args.log_level, args.rnti));
     stack->set_active_cell_list(args.ue_cell_list);
 
+    /// Measure the DL processing latency between the stack and the radio
+    radio->set_latency_meter(&dl_latency);
+    stack->set_latency_meter(&dl_latency);
+
     /// Initiate eNb PHY with the given RNTI
     if (enb_phy->init(phy_args, phy_cfg, radio.get(), stack.get(), this) < 0) {
       return SRSRAN_ERROR;
@@ -1355,8 +1445,25 @@ public:
 
   void stop()
   {
+    // Report the processing load against the cell load before the workers are released
+    std::vector<srsenb::phy_load_metrics_t> load;
+    enb_phy->get_load_metrics(load);
+    for (uint32_t cc = 0; cc < load.size(); cc++) {
+      printf("PHY load cc=%d: %d TTI (%.1f%% empty); DL PRB %.1f%%; UL PRB %.1f%%; "
+             "processing %.1f us/TTI (%.1f us empty); CPU %.1f%%\n",
+             cc,
+             load[cc].nof_tti,
+             load[cc].nof_tti > 0 ? 100.0 * load[cc].nof_empty_tti / load[cc].nof_tti : 0.0,
+             load[cc].dl_prb_usage,
+             load[cc].ul_prb_usage,
+             load[cc].proc_time_us,
+             load[cc].proc_time_empty_us,
+             load[cc].cpu_load);
+    }
+
     radio->stop();
     enb_phy->stop();
+    dl_latency.print(args.nof_ue_task_threads);
   }
 
   virtual ~phy_test_bench() = default;
@@ -1462,6 +1569,8 @@ int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
       ("cell.cp",        bpo::value<bool>(&args.extended_cp)->default_value(false),                      "use extended CP")
       ("tm", bpo::value<uint32_t>(&args.tm_u32)->default_value(args.tm_u32),                             "Transmission mode")
       ("rotation", bpo::value<uint32_t>(&args.period_pcell_rotate),                      "Serving cells rotation period in ms, set to zero to disable")
+      ("ue_task_threads", bpo::value<uint32_t>(&args.nof_ue_task_threads),                               "Number of helper threads processing the PDSCH and PUSCH of different UEs")
+      ("deadline_us",    bpo::value<uint32_t>(&args.deadline_us),                                        "DL processing deadline of a TTI in microseconds")
       ;
   options.add(common).add_options()("help", "Show this message");
   // clang-format on
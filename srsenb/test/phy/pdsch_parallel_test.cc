@@ -0,0 +1,172 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/lte/cc_worker.h"
+#include "srsran/common/test_common.h"
+#include "srsran/phy/utils/random.h"
+
+/**
+ * Test of the parallel PDSCH encoding of the LTE cc_worker. The same multi-UE DL subframes are generated with the UE
+ * tasks run serially by the PHY worker and with several helper threads, and the transmitted signals must be equal.
+ * The cell uses a power allocation p_b that scales the OFDM symbols carrying CRS, which are shared by all the grants.
+ */
+
+namespace srsenb {
+
+const uint32_t nof_prb    = 50;
+const uint32_t nof_ues    = 4;
+const uint32_t nof_rbg    = 17; // RBG size 3 for 50 PRB
+const uint32_t nof_sf     = 40;
+const uint32_t p_b        = 2;
+const uint16_t first_rnti = 0x46;
+
+class pdsch_parallel_test
+{
+public:
+  explicit pdsch_parallel_test(uint32_t nof_helpers) : worker(srslog::fetch_basic_logger("PHY"))
+  {
+    phy_cell_cfg_t cell_cfg       = {};
+    cell_cfg.cell.nof_prb         = nof_prb;
+    cell_cfg.cell.nof_ports       = 1;
+    cell_cfg.cell.id              = 1;
+    cell_cfg.cell.cp              = SRSRAN_CP_NORM;
+    cell_cfg.cell.phich_length    = SRSRAN_PHICH_NORM;
+    cell_cfg.cell.phich_resources = SRSRAN_PHICH_R_1;
+    cell_list.push_back(cell_cfg);
+
+    common.init(cell_list, {}, nullptr, nullptr);
+    common.start_ue_tasks(nof_helpers, -1);
+    worker.init(&common, 0);
+
+    for (uint32_t i = 0; i < nof_ues; i++) {
+      uint16_t rnti = first_rnti + i;
+      TESTASSERT(worker.add_rnti(rnti) == SRSRAN_SUCCESS);
+
+      phy_interface_rrc_lte::phy_rrc_cfg_list_t cfg_list(1);
+      cfg_list[0].configured = true;
+      cfg_list[0].enb_cc_idx = 0;
+      cfg_list[0].phy_cfg.set_defaults();
+      cfg_list[0].phy_cfg.dl_cfg.tm                = SRSRAN_TM1;
+      cfg_list[0].phy_cfg.dl_cfg.pdsch.p_b         = p_b;
+      cfg_list[0].phy_cfg.dl_cfg.pdsch.power_scale = true;
+      common.ue_db.addmod_rnti(rnti, cfg_list);
+
+      TESTASSERT(srsran_softbuffer_tx_init(&softbuffer[i], nof_prb) == SRSRAN_SUCCESS);
+    }
+  }
+
+  ~pdsch_parallel_test()
+  {
+    common.stop_ue_tasks();
+    for (srsran_softbuffer_tx_t& sb : softbuffer) {
+      srsran_softbuffer_tx_free(&sb);
+    }
+  }
+
+  /// Generates a subframe in which every UE is given a set of RBGs, and returns the transmitted signal
+  std::vector<cf_t> run_sf(uint32_t tti, std::vector<std::vector<uint8_t> >& data)
+  {
+    srsran_dl_sf_cfg_t dl_sf = {};
+    dl_sf.tti                = tti;
+    dl_sf.cfi                = 2;
+    dl_sf.sf_type            = SRSRAN_SF_NORM;
+
+    stack_interface_phy_lte::dl_sched_t dl_grants = {};
+    dl_grants.cfi                                 = dl_sf.cfi;
+    dl_grants.nof_grants                          = nof_ues;
+    for (uint32_t i = 0; i < nof_ues; i++) {
+      stack_interface_phy_lte::dl_sched_grant_t& grant = dl_grants.pdsch[i];
+      grant.dci.rnti                                   = first_rnti + i;
+      grant.dci.format                                 = SRSRAN_DCI_FORMAT1;
+      grant.dci.location.L                             = 2;
+      grant.dci.location.ncce                          = 4 * i;
+      grant.dci.alloc_type                             = SRSRAN_RA_ALLOC_TYPE0;
+      // The RBGs are distributed in turns, which changes with the TTI
+      for (uint32_t rbg = 0; rbg < nof_rbg; rbg++) {
+        if ((rbg + tti) % nof_ues == i) {
+          grant.dci.type0_alloc.rbg_bitmask |= 1u << rbg;
+        }
+      }
+      grant.dci.tb[0].mcs_idx = (tti + 5 * i) % 28;
+      grant.dci.tb[0].rv      = 0;
+      grant.dci.tb[0].ndi     = (tti % 2) == 0;
+      SRSRAN_DCI_TB_DISABLE(grant.dci.tb[1]);
+      grant.data[0]          = data[i].data();
+      grant.softbuffer_tx[0] = &softbuffer[i];
+      srsran_softbuffer_tx_reset(&softbuffer[i]);
+    }
+
+    stack_interface_phy_lte::ul_sched_t ul_grants = {};
+    worker.set_tti(tti);
+    worker.work_dl(dl_sf, dl_grants, ul_grants, nullptr);
+
+    cf_t* buffer = worker.get_buffer_tx(0);
+    return std::vector<cf_t>(buffer, buffer + SRSRAN_SF_LEN_PRB(nof_prb));
+  }
+
+private:
+  phy_cell_cfg_list_t    cell_list;
+  phy_common             common;
+  lte::cc_worker         worker;
+  srsran_softbuffer_tx_t softbuffer[nof_ues] = {};
+};
+
+int test_pdsch_parallel(uint32_t nof_helpers)
+{
+  // Transport block data of each UE, large enough for any MCS
+  srsran_random_t                     random = srsran_random_init(1234);
+  std::vector<std::vector<uint8_t> > data(nof_ues, std::vector<uint8_t>(SRSRAN_MAX_BUFFER_SIZE_BYTES));
+  for (std::vector<uint8_t>& d : data) {
+    for (uint8_t& b : d) {
+      b = (uint8_t)srsran_random_uniform_int_dist(random, 0, 255);
+    }
+  }
+  srsran_random_free(random);
+
+  pdsch_parallel_test serial(0);
+  pdsch_parallel_test parallel(nof_helpers);
+  for (uint32_t tti = 0; tti < nof_sf; tti++) {
+    // Skip the subframes with PBCH and synchronization signals, which the allocations above do not account for
+    if (tti % SRSRAN_NOF_SF_X_FRAME == 0 or tti % SRSRAN_NOF_SF_X_FRAME == 5) {
+      continue;
+    }
+    std::vector<cf_t> expected = serial.run_sf(tti, data);
+    std::vector<cf_t> actual   = parallel.run_sf(tti, data);
+    TESTASSERT(srsran_vec_avg_power_cf(expected.data(), expected.size()) > 0.0f);
+    TESTASSERT(memcmp(expected.data(), actual.data(), expected.size() * sizeof(cf_t)) == 0);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("PHY", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  for (uint32_t nof_helpers : {1, 3}) {
+    TESTASSERT(srsenb::test_pdsch_parallel(nof_helpers) == SRSRAN_SUCCESS);
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,208 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/lte/cc_worker.h"
+#include "srsran/common/test_common.h"
+#include "srsran/phy/utils/random.h"
+#include <chrono>
+
+/**
+ * Benchmark of the parallel PUSCH decoding of the LTE cc_worker. The PRBs of every UL subframe are split evenly among
+ * a varying number of UEs, and the subframes are processed with a varying number of UE task helpers. The received
+ * signal is noise, so no transport block passes the CRC and the turbo decoder always runs its maximum number of
+ * iterations, i.e. the worst case. The test checks that every grant is reported to the MAC once per subframe, and
+ * reports the rate of UL transport blocks processed.
+ *
+ * Usage: pusch_parallel_benchmark [test|benchmark]
+ */
+
+namespace srsenb {
+
+const uint32_t nof_prb       = 50;
+const uint32_t nof_alloc_prb = 48; // Divisible into valid PUSCH allocations for up to 8 UEs
+const uint32_t pusch_mcs     = 20;
+const uint16_t first_rnti    = 0x46;
+
+/// Stack that counts the PUSCH reports of the PHY
+class stack_dummy_phy : public stack_interface_phy_lte
+{
+public:
+  int  sr_detected(uint32_t tti, uint16_t rnti) override { return SRSRAN_SUCCESS; }
+  void rach_detected(uint32_t tti, uint32_t primary_cc_idx, uint32_t preamble_idx, uint32_t time_adv) override {}
+  int  ri_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t ri_value) override { return SRSRAN_SUCCESS; }
+  int  pmi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t pmi_value) override { return SRSRAN_SUCCESS; }
+  int  cqi_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t cqi_value) override { return SRSRAN_SUCCESS; }
+  int  sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int snr_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, float snr_db, ul_channel_t ch) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int ul_sb_snr_info(uint32_t                  tti,
+                     uint16_t                  rnti,
+                     uint32_t                  enb_cc_idx,
+                     uint32_t                  prb_start,
+                     uint32_t                  nof_prb_per_sb,
+                     srsran::span<const float> sb_snr_db) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int ta_info(uint32_t tti, uint16_t rnti, float ta_us) override { return SRSRAN_SUCCESS; }
+  int ack_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t tb_idx, bool ack) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+  int crc_info(uint32_t tti, uint16_t rnti, uint32_t cc_idx, uint32_t nof_bytes, bool crc_res) override
+  {
+    nof_crc++;
+    return SRSRAN_SUCCESS;
+  }
+  int push_pdu(uint32_t tti_rx,
+               uint16_t rnti,
+               uint32_t enb_cc_idx,
+               uint32_t nof_bytes,
+               bool     crc_res,
+               uint32_t ul_nof_prbs) override
+  {
+    nof_pdus++;
+    rx_bytes += nof_bytes;
+    return SRSRAN_SUCCESS;
+  }
+  int  get_dl_sched(uint32_t tti, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int  get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res) override { return SRSRAN_SUCCESS; }
+  int  get_ul_sched(uint32_t tti, ul_sched_list_t& ul_sched_res) override { return SRSRAN_SUCCESS; }
+  void set_sched_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override {}
+
+  uint32_t nof_crc  = 0;
+  uint32_t nof_pdus = 0;
+  uint64_t rx_bytes = 0;
+};
+
+struct run_result {
+  uint32_t nof_pdus;
+  double   ul_mbps;
+};
+
+run_result run_scenario(uint32_t nof_ues, uint32_t nof_helpers, uint32_t nof_ttis)
+{
+  stack_dummy_phy     stack;
+  phy_cell_cfg_list_t cell_list(1);
+  cell_list[0].cell.nof_prb         = nof_prb;
+  cell_list[0].cell.nof_ports       = 1;
+  cell_list[0].cell.id              = 1;
+  cell_list[0].cell.cp              = SRSRAN_CP_NORM;
+  cell_list[0].cell.phich_length    = SRSRAN_PHICH_NORM;
+  cell_list[0].cell.phich_resources = SRSRAN_PHICH_R_1;
+
+  phy_common common;
+  common.init(cell_list, {}, nullptr, &stack);
+  common.start_ue_tasks(nof_helpers, -1);
+  lte::cc_worker worker(srslog::fetch_basic_logger("PHY"));
+  worker.init(&common, 0);
+
+  // Every UE is given the same share of the PRBs
+  uint32_t                            L_prb = nof_alloc_prb / nof_ues;
+  std::vector<srsran_softbuffer_rx_t> softbuffer(nof_ues);
+  std::vector<std::vector<uint8_t> >  data(nof_ues, std::vector<uint8_t>(SRSRAN_MAX_BUFFER_SIZE_BYTES));
+  stack_interface_phy_lte::ul_sched_t ul_grants = {};
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    uint16_t rnti = first_rnti + i;
+    TESTASSERT(worker.add_rnti(rnti) == SRSRAN_SUCCESS);
+
+    phy_interface_rrc_lte::phy_rrc_cfg_list_t cfg_list(1);
+    cfg_list[0].configured = true;
+    cfg_list[0].enb_cc_idx = 0;
+    cfg_list[0].phy_cfg.set_defaults();
+    common.ue_db.addmod_rnti(rnti, cfg_list);
+
+    TESTASSERT(srsran_softbuffer_rx_init(&softbuffer[i], nof_prb) == SRSRAN_SUCCESS);
+    stack_interface_phy_lte::ul_sched_grant_t& grant = ul_grants.pusch[i];
+    grant.dci.rnti                                   = rnti;
+    grant.dci.format                                 = SRSRAN_DCI_FORMAT0;
+    grant.dci.freq_hop_fl                            = srsran_dci_ul_t::SRSRAN_RA_PUSCH_HOP_DISABLED;
+    grant.dci.type2_alloc.riv                        = srsran_ra_type2_to_riv(L_prb, i * L_prb, nof_prb);
+    grant.dci.tb.mcs_idx                             = pusch_mcs;
+    grant.data                                       = data[i].data();
+    grant.softbuffer_rx                              = &softbuffer[i];
+  }
+  ul_grants.nof_grants = nof_ues;
+
+  // Received signal
+  srsran_random_t random = srsran_random_init(1234);
+  cf_t*           rx     = worker.get_buffer_rx(0);
+  for (uint32_t i = 0; i < SRSRAN_SF_LEN_PRB(nof_prb); i++) {
+    rx[i] = {srsran_random_gauss_dist(random, 0.1f), srsran_random_gauss_dist(random, 0.1f)};
+  }
+  srsran_random_free(random);
+
+  std::chrono::nanoseconds proc_time = {};
+  for (uint32_t tti = 0; tti < nof_ttis; tti++) {
+    srsran_ul_sf_cfg_t ul_sf = {};
+    ul_sf.tti                = tti;
+    for (srsran_softbuffer_rx_t& sb : softbuffer) {
+      srsran_softbuffer_rx_reset(&sb);
+    }
+
+    worker.set_tti(tti);
+    auto t_start = std::chrono::steady_clock::now();
+    worker.work_ul(ul_sf, ul_grants);
+    proc_time += std::chrono::steady_clock::now() - t_start;
+  }
+  common.stop_ue_tasks();
+  for (srsran_softbuffer_rx_t& sb : softbuffer) {
+    srsran_softbuffer_rx_free(&sb);
+  }
+
+  TESTASSERT(stack.nof_crc == nof_ues * nof_ttis);
+  TESTASSERT(stack.nof_pdus == nof_ues * nof_ttis);
+  TESTASSERT(stack.rx_bytes > 0);
+  return {stack.nof_pdus, stack.rx_bytes * 8 / std::chrono::duration<double>(proc_time).count() / 1e6};
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("PHY", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  uint32_t nof_ttis = 10;
+  if (argc > 1 and strcmp(argv[1], "benchmark") == 0) {
+    nof_ttis = 1000;
+  }
+
+  fmt::print("PUSCH decoding rate of the LTE cc_worker ({} PRBs, MCS {}, {} TTIs)\n",
+             srsenb::nof_alloc_prb,
+             srsenb::pusch_mcs,
+             nof_ttis);
+  fmt::print("Nues | Nhelpers | PDUs   | UL rate [Mbps]\n");
+  for (uint32_t nof_ues : {1, 2, 4, 8}) {
+    for (uint32_t nof_helpers : {0, 1, 3}) {
+      srsenb::run_result r = srsenb::run_scenario(nof_ues, nof_helpers, nof_ttis);
+      fmt::print("{:>4} | {:>8} | {:>6} | {:>14.1f}\n", nof_ues, nof_helpers, r.nof_pdus, r.ul_mbps);
+    }
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,183 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/pdcp.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_gtpu_interfaces.h"
+#include "srsran/interfaces/enb_rlc_interfaces.h"
+#include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include <set>
+
+/**
+ * Test of an EN-DC split bearer across two srsenb::pdcp instances, as in NSA mode. The NR PDCP owns the DRB and sends
+ * part of its DL PDUs over the RLC bearer of the EUTRA side, whose PDCP forwards the delivery notifications and UL PDUs
+ * of that RLC bearer back to the NR PDCP. The test checks that discards only reach the leg that carried each COUNT.
+ */
+
+namespace srsenb {
+
+const uint16_t nr_rnti    = 0x4601;
+const uint16_t eutra_rnti = 0x46;
+const uint32_t nr_lcid    = 4;
+const uint32_t eutra_lcid = 3;
+
+/// RLC that records the COUNTs written to and discarded from each bearer
+class rlc_leg_dummy : public rlc_interface_pdcp
+{
+public:
+  void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override
+  {
+    tx_counts.insert(sdu->md.pdcp_sn);
+  }
+  void     discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t sn) override { discarded_counts.insert(sn); }
+  bool     rb_is_um(uint16_t rnti, uint32_t lcid) override { return false; }
+  bool     sdu_queue_is_full(uint16_t rnti, uint32_t lcid) override { return false; }
+  bool     is_suspended(uint16_t rnti, uint32_t lcid) override { return false; }
+  uint32_t get_buffer_state(uint16_t rnti, uint32_t lcid) override { return 0; }
+
+  std::set<uint32_t> tx_counts;
+  std::set<uint32_t> discarded_counts;
+};
+
+class rrc_pdcp_dummy : public rrc_interface_pdcp
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override {}
+  void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override {}
+};
+
+class gtpu_pdcp_dummy : public gtpu_interface_pdcp
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    last_rnti = rnti;
+    last_lcid = lcid;
+    nof_pdus++;
+  }
+
+  uint16_t last_rnti = SRSRAN_INVALID_RNTI;
+  uint32_t last_lcid = 0;
+  uint32_t nof_pdus  = 0;
+};
+
+int test_split_bearer_owner()
+{
+  srsran::task_scheduler task_sched;
+  auto&                  logger = srslog::fetch_basic_logger("PDCP", false);
+  rlc_leg_dummy          nr_rlc, eutra_rlc;
+  rrc_pdcp_dummy         rrc;
+  gtpu_pdcp_dummy        nr_gtpu, eutra_gtpu;
+
+  pdcp nr_pdcp(&task_sched, logger);
+  pdcp eutra_pdcp(&task_sched, logger);
+  nr_pdcp.init(&nr_rlc, &rrc, &nr_gtpu);
+  eutra_pdcp.init(&eutra_rlc, &rrc, &eutra_gtpu);
+
+  srsran::pdcp_config_t drb_cfg(1,
+                                srsran::PDCP_RB_IS_DRB,
+                                srsran::SECURITY_DIRECTION_DOWNLINK,
+                                srsran::SECURITY_DIRECTION_UPLINK,
+                                srsran::PDCP_SN_LEN_18,
+                                srsran::pdcp_t_reordering_t::ms100,
+                                srsran::pdcp_discard_timer_t::ms50,
+                                false,
+                                srsran::srsran_rat_t::nr);
+  nr_pdcp.add_user(nr_rnti);
+  nr_pdcp.add_bearer(nr_rnti, nr_lcid, drb_cfg);
+  eutra_pdcp.add_user(eutra_rnti);
+
+  srsran::pdcp_split_bearer_cfg_t split_cfg = {};
+  TESTASSERT(nr_pdcp.add_split_bearer_leg(nr_rnti, nr_lcid, &eutra_rlc, eutra_rnti, eutra_lcid, split_cfg));
+  eutra_pdcp.add_split_bearer_owner(eutra_rnti, eutra_lcid, &nr_pdcp, nr_rnti, nr_lcid);
+
+  // DL PDUs are distributed over both legs
+  const uint32_t nof_sdus = 20;
+  for (uint32_t i = 0; i < nof_sdus; ++i) {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->N_bytes = 100;
+    nr_pdcp.write_sdu(nr_rnti, nr_lcid, std::move(sdu));
+  }
+  TESTASSERT(not nr_rlc.tx_counts.empty() and not eutra_rlc.tx_counts.empty());
+  TESTASSERT(nr_rlc.tx_counts.size() + eutra_rlc.tx_counts.size() == nof_sdus);
+
+  // All but the last COUNT of each leg are delivered. The EUTRA leg notifies its own PDCP
+  srsran::pdcp_sn_vector_t nr_delivered, eutra_delivered;
+  for (uint32_t count : nr_rlc.tx_counts) {
+    if (count != *nr_rlc.tx_counts.rbegin()) {
+      nr_delivered.push_back(count);
+    }
+  }
+  for (uint32_t count : eutra_rlc.tx_counts) {
+    if (count != *eutra_rlc.tx_counts.rbegin()) {
+      eutra_delivered.push_back(count);
+    }
+  }
+  nr_pdcp.notify_delivery(nr_rnti, nr_lcid, nr_delivered);
+  eutra_pdcp.notify_delivery(eutra_rnti, eutra_lcid, eutra_delivered);
+
+  // Only the undelivered COUNTs are discarded, each in the leg that carried it
+  for (uint32_t i = 0; i < 60; ++i) {
+    task_sched.tic();
+  }
+  TESTASSERT(nr_rlc.discarded_counts == std::set<uint32_t>{*nr_rlc.tx_counts.rbegin()});
+  TESTASSERT(eutra_rlc.discarded_counts == std::set<uint32_t>{*eutra_rlc.tx_counts.rbegin()});
+
+  // UL PDUs received over the EUTRA leg reach the NR PDCP. The PDU carries the NR PDCP header of COUNT 0
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  TESTASSERT(pdu != nullptr);
+  pdu->N_bytes = 50;
+  pdu->msg[0]  = 0x80;
+  pdu->msg[1]  = 0x00;
+  pdu->msg[2]  = 0x00;
+  eutra_pdcp.write_pdu(eutra_rnti, eutra_lcid, std::move(pdu));
+  TESTASSERT(nr_gtpu.nof_pdus == 1 and eutra_gtpu.nof_pdus == 0);
+  TESTASSERT(nr_gtpu.last_rnti == nr_rnti and nr_gtpu.last_lcid == nr_lcid);
+
+  // Once the leg is removed, the EUTRA PDCP keeps the notifications and UL PDUs of the RLC bearer
+  eutra_pdcp.del_split_bearer_owner(eutra_rnti, eutra_lcid);
+  nr_pdcp.del_split_bearer_leg(nr_rnti, nr_lcid);
+  pdu          = srsran::make_byte_buffer();
+  pdu->N_bytes = 50;
+  pdu->msg[0]  = 0x80;
+  pdu->msg[1]  = 0x00;
+  pdu->msg[2]  = 0x01;
+  eutra_pdcp.write_pdu(eutra_rnti, eutra_lcid, std::move(pdu));
+  TESTASSERT(nr_gtpu.nof_pdus == 1);
+
+  nr_pdcp.stop();
+  eutra_pdcp.stop();
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("PDCP", false).set_level(srslog::basic_levels::info);
+  srslog::init();
+
+  TESTASSERT(srsenb::test_split_bearer_owner() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -74,7 +74,8 @@ private:
 
   int      init_sgi_mb_if(mbms_gw_args_t* args);
   int      init_m1_u(mbms_gw_args_t* args);
-  void     handle_sgi_md_pdu(srsran::byte_buffer_t* msg);
+  bool     handle_sgi_md_pdu(srsran::byte_buffer_t* msg);
+  void     send_m1u_pdus(const srsran::unique_byte_buffer_t* pdus, uint32_t nof_pdus);
   uint16_t in_cksum(uint16_t* iphdr, int count);
 
   /* Members */
@@ -22,24 +22,35 @@
 #define SRSEPC_GTPC_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsepc/hdr/spgw/ue_ip_pool.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 
-#include <set>
+#include <atomic>
+#include <deque>
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <unordered_map>
 
 namespace srsepc {
 
-class spgw::gtpc : public gtpc_interface_gtpu
+/**
+ * GTP-C entity of the SP-GW. It runs in its own thread, so that the S11 signalling does not delay the user-plane
+ * thread, which only reads the tunnels that GTP-C publishes through gtpu_interface_gtpc.
+ * The downlink packets of idle UEs are handed over by the user-plane thread through a bounded event queue, and the
+ * paging procedure is handled in the GTP-C thread.
+ */
+class spgw::gtpc : public gtpc_interface_gtpu, public srsran::thread
 {
 public:
   gtpc();
   virtual ~gtpc();
   int init(spgw_args_t* args, spgw* spgw, gtpu_interface_gtpc* gtpu, const std::map<std::string, uint64_t>& ip_to_imsi);
   void stop();
+  void run_thread() override;
 
   int init_s11(spgw_args_t* args);
   int init_ue_ip(spgw_args_t* args, const std::map<std::string, uint64_t>& ip_to_imsi);
@@ -66,13 +77,20 @@ public:
       const srsran::gtpc_header&                                        header,
       const srsran::gtpc_downlink_data_notification_failure_indication& not_fail);
 
+  // Called from the user-plane thread. The requests are processed in the GTP-C thread
   virtual bool queue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg) override;
   virtual bool send_downlink_data_notification(uint32_t spgw_ctr_teid) override;
 
+  void handle_dl_events();
+  bool trigger_downlink_data_notification(uint32_t spgw_ctr_teid);
+  bool store_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg);
+
   spgw_tunnel_ctx_t* create_gtpc_ctx(const srsran::gtpc_create_session_request& cs_req);
   bool               delete_gtpc_ctx(uint32_t ctrl_teid);
 
+  void send_all_queued_packets(spgw_tunnel_ctx_t* tunnel_ctx);
   bool free_all_queued_packets(spgw_tunnel_ctx_t* tunnel_ctx);
+  void log_paging_buffer_metrics();
 
   spgw*                m_spgw;
   gtpu_interface_gtpc* m_gtpu;
@@ -80,18 +98,34 @@ public:
   int                m_s11;
   struct sockaddr_un m_spgw_addr, m_mme_addr;
 
+  std::atomic<bool> m_running;
+  int               m_event_fd; ///< Wakes up the GTP-C thread when there are pending downlink events
+
+  /// Downlink event posted by the user-plane thread. Events without packet trigger a Downlink Data Notification
+  struct dl_event_t {
+    uint32_t                     spgw_ctr_teid;
+    srsran::unique_byte_buffer_t pkt;
+  };
+  /// Maximum number of pending downlink events. The packets of the events beyond it are dropped, so that a burst of
+  /// traffic towards idle UEs cannot drain the buffer pool before the packets are copied to the paging buffers
+  static const uint32_t  max_dl_events = 512;
+  std::mutex             m_dl_events_mutex;
+  std::deque<dl_event_t> m_dl_events;
+  uint64_t               m_nof_dropped_dl_pkts = 0; ///< Packets dropped because the event queue was full
+
   uint32_t m_h_next_ue_ip;
   uint64_t m_next_ctrl_teid;
   uint64_t m_next_user_teid;
-  uint32_t m_max_paging_queue;
 
-  std::map<uint64_t, uint32_t> m_imsi_to_ctr_teid;           // IMSI to control TEID map. Important to check if UE
+  paging_buffer_store m_paging_buffers; // Downlink packets held while the UEs are paged
+
+  std::unordered_map<uint64_t, uint32_t> m_imsi_to_ctr_teid; // IMSI to control TEID map. Important to check if UE
                                                              // is previously connected
-  std::map<uint32_t, spgw_tunnel_ctx*> m_teid_to_tunnel_ctx; // Map control TEID to tunnel ctx. Usefull to get
-                                                             // reply ctrl TEID, UE IP, etc.
+  std::unordered_map<uint32_t, spgw_tunnel_ctx*> m_teid_to_tunnel_ctx; // Map control TEID to tunnel ctx. Usefull to
+                                                                       // get reply ctrl TEID, UE IP, etc.
 
-  std::set<uint32_t>                 m_ue_ip_addr_pool;
-  std::map<uint64_t, struct in_addr> m_imsi_to_ip;
+  ue_ip_pool                                   m_ue_ip_addr_pool;
+  std::unordered_map<uint64_t, struct in_addr> m_imsi_to_ip;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("SPGW GTPC");
 };
@@ -23,13 +23,13 @@
 #define SRSEPC_GTPU_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsepc/hdr/spgw/spgw_tunnel_table.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
-#include <queue>
 
 namespace srsepc {
 
@@ -48,15 +48,16 @@ public:
 
   void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
   void handle_s1u_pdu(srsran::byte_buffer_t* msg);
-  void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
 
   virtual in_addr_t get_s1u_addr();
 
+  // Tunnel management, called from the GTP-C thread. The tunnels are published to the user-plane thread lock-free
   virtual bool modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtp_fteid_t dw_user_fteid, uint32_t up_ctr_fteid);
   virtual bool delete_gtpu_tunnel(in_addr_t ue_ipv4);
   virtual bool delete_gtpc_tunnel(in_addr_t ue_ipv4);
-  virtual void send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
-                                       std::queue<srsran::unique_byte_buffer_t>& pkt_queue);
+
+  // Called from both the user-plane and the GTP-C threads, the latter to send the packets held during paging
+  virtual void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
 
   spgw*                m_spgw;
   gtpc_interface_gtpu* m_gtpc;
@@ -68,10 +69,9 @@ public:
   int         m_s1u;
   sockaddr_in m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  spgw_tunnel_table m_tunnels; // Map IP to User-plane TEID for downlink traffic, and to control TEID. The latter is
+                               // important to check if UE is attached without an active user-plane for downlink
+                               // notifications.
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
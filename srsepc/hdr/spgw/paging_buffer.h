@@ -0,0 +1,120 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSEPC_PAGING_BUFFER_H
+#define SRSEPC_PAGING_BUFFER_H
+
+#include "srsran/common/byte_buffer.h"
+#include <array>
+#include <cstdint>
+
+namespace srsepc {
+
+/// Packet that is dropped when the paging queue of a UE or the paging buffer memory is full
+enum class paging_drop_policy_t { drop_newest, drop_oldest };
+
+struct paging_buffer_args_t {
+  uint32_t             max_pkts_per_ue;  ///< Maximum number of packets queued per UE
+  uint32_t             max_bytes_per_ue; ///< Maximum memory used by the packets queued per UE
+  uint64_t             max_bytes;        ///< Maximum memory used by the paging buffers of all UEs
+  paging_drop_policy_t drop_policy;
+};
+
+struct paging_buffer_metrics_t {
+  uint32_t nof_queued_pkts;
+  uint64_t bytes_in_use; ///< Memory used by the queued packets
+  uint64_t bytes_cached; ///< Memory of the free buffers kept for reuse
+  uint64_t peak_bytes_in_use;
+  uint64_t nof_dropped_pkts;
+};
+
+/**
+ * Store of the downlink packets that the SP-GW holds while their UE is being paged.
+ * The packets are copied into buffers of the smallest size class that fits them, instead of holding a byte_buffer_t
+ * from the shared buffer pool each. Freed buffers are kept in per size class free lists for reuse. Cached buffers of
+ * any size class are released before a new buffer is allocated, so that the memory in use plus the cached memory
+ * never exceeds the global limit.
+ * The memory limits account for the size of the buffers, including their header. The store is not thread-safe.
+ */
+class paging_buffer_store
+{
+  struct packet_t;
+
+public:
+  /// Paging queue of a UE. It is owned by the tunnel context, while its packets are owned by the store
+  struct queue_t {
+    packet_t* head      = nullptr;
+    packet_t* tail      = nullptr;
+    uint32_t  nof_pkts  = 0;
+    uint32_t  nof_bytes = 0;
+  };
+
+  paging_buffer_store()                           = default;
+  paging_buffer_store(const paging_buffer_store&) = delete;
+  paging_buffer_store& operator=(const paging_buffer_store&) = delete;
+  ~paging_buffer_store();
+
+  void init(const paging_buffer_args_t& args_);
+
+  /// Copies a packet to the queue of a UE. Returns false if the new packet is dropped.
+  bool push(queue_t& q, const uint8_t* data, uint32_t len);
+
+  /// Copies the oldest packet of the queue to the PDU and frees it. Returns false if the queue is empty.
+  bool pop(queue_t& q, srsran::byte_buffer_t& pdu);
+
+  /// Frees all the packets of the queue. Returns the number of freed packets.
+  uint32_t clear(queue_t& q);
+
+  paging_buffer_metrics_t get_metrics() const;
+
+private:
+  struct packet_t {
+    packet_t* next;
+    uint32_t  size_class;
+    uint32_t  len;
+    uint8_t*  data() { return reinterpret_cast<uint8_t*>(this + 1); }
+  };
+
+  static const uint32_t nof_size_classes   = 15;
+  static const uint32_t invalid_size_class = nof_size_classes;
+  /// Payload sizes of the buffers, with a maximum overhead of one third of the packet size
+  static const std::array<uint32_t, nof_size_classes> size_classes;
+
+  static uint32_t get_size_class(uint32_t len);
+  static uint32_t get_buffer_size(uint32_t size_class) { return sizeof(packet_t) + size_classes[size_class]; }
+
+  packet_t* alloc_packet(uint32_t size_class);
+  void      release_cached(uint32_t buffer_size);
+  void      free_packet(packet_t* pkt);
+  packet_t* pop_packet(queue_t& q);
+
+  paging_buffer_args_t                    args              = {};
+  std::array<packet_t*, nof_size_classes> free_lists        = {};
+  uint32_t                                nof_queued_pkts   = 0;
+  uint64_t                                bytes_in_use      = 0;
+  uint64_t                                bytes_cached      = 0;
+  uint64_t                                peak_bytes_in_use = 0;
+  uint64_t                                nof_dropped_pkts  = 0;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_PAGING_BUFFER_H
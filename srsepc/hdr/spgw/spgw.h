@@ -28,12 +28,12 @@
 #ifndef SRSEPC_SPGW_H
 #define SRSEPC_SPGW_H
 
+#include "srsepc/hdr/spgw/paging_buffer.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
-#include <queue>
 
 namespace srsepc {
 
@@ -42,22 +42,25 @@ class mme_gtpc;
 const uint16_t GTPU_RX_PORT = 2152;
 
 typedef struct {
-  std::string gtpu_bind_addr;
-  std::string sgi_if_addr;
-  std::string sgi_if_name;
-  uint32_t    max_paging_queue;
+  std::string          gtpu_bind_addr;
+  std::string          sgi_if_addr;
+  std::string          sgi_if_name;
+  uint32_t             max_paging_queue;
+  uint32_t             max_paging_queue_bytes;
+  uint32_t             paging_buffer_bytes;
+  paging_drop_policy_t paging_drop_policy;
 } spgw_args_t;
 
 typedef struct spgw_tunnel_ctx {
-  uint64_t                                 imsi;
-  in_addr_t                                ue_ipv4;
-  uint8_t                                  ebi;
-  srsran::gtp_fteid_t                      up_ctrl_fteid;
-  srsran::gtp_fteid_t                      up_user_fteid;
-  srsran::gtp_fteid_t                      dw_ctrl_fteid;
-  srsran::gtp_fteid_t                      dw_user_fteid;
-  bool                                     paging_pending;
-  std::queue<srsran::unique_byte_buffer_t> paging_queue;
+  uint64_t                     imsi;
+  in_addr_t                    ue_ipv4;
+  uint8_t                      ebi;
+  srsran::gtp_fteid_t          up_ctrl_fteid;
+  srsran::gtp_fteid_t          up_user_fteid;
+  srsran::gtp_fteid_t          dw_ctrl_fteid;
+  srsran::gtp_fteid_t          dw_user_fteid;
+  bool                         paging_pending;
+  paging_buffer_store::queue_t paging_queue;
 } spgw_tunnel_ctx_t;
 
 class spgw : public srsran::thread
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSEPC_SPGW_TUNNEL_TABLE_H
+#define SRSEPC_SPGW_TUNNEL_TABLE_H
+
+#include "srsran/asn1/gtpc_ies.h"
+#include "srsran/common/epoch_guard.h"
+#include <atomic>
+#include <memory>
+#include <netinet/in.h>
+#include <vector>
+
+namespace srsepc {
+
+/**
+ * Table of the downlink tunnels of the SP-GW, indexed by UE IP.
+ * It is written by the GTP-C thread and read by the user-plane thread for every SGi packet:
+ * - lookups are lock-free. Readers must hold a srsran::epoch_read_guard while they access the table.
+ * - entries are immutable. A modification publishes a new entry and retires the previous one.
+ * - retired entries are only destroyed once no reader can still hold a reference to them.
+ * The buckets are chained lists whose links are atomic pointers. Only one thread may write to the table.
+ */
+class spgw_tunnel_table
+{
+public:
+  struct tunnel_t {
+    in_addr_t           ue_ipv4       = 0;
+    bool                user_present  = false; ///< The UE has a user-plane tunnel, i.e. it is ECM connected
+    srsran::gtp_fteid_t dw_user_fteid = {};    ///< eNB F-TEID of the user-plane tunnel
+    bool                ctrl_present  = false; ///< The UE has a control-plane tunnel, i.e. it is attached
+    uint32_t            up_ctrl_teid  = 0;     ///< SP-GW control TEID of the UE
+  };
+
+  explicit spgw_tunnel_table(uint32_t nof_buckets_log2 = 10);
+  spgw_tunnel_table(const spgw_tunnel_table&) = delete;
+  spgw_tunnel_table& operator=(const spgw_tunnel_table&) = delete;
+  ~spgw_tunnel_table();
+
+  /// Copies the tunnel of a UE. Caller must hold an epoch_read_guard. Returns false if the UE is not present.
+  bool find(in_addr_t ue_ipv4, tunnel_t& tunnel) const;
+
+  // Writer interface
+  void set_tunnel(in_addr_t ue_ipv4, const srsran::gtp_fteid_t& dw_user_fteid, uint32_t up_ctrl_teid);
+  bool remove_user_tunnel(in_addr_t ue_ipv4);
+  bool remove_ctrl_tunnel(in_addr_t ue_ipv4);
+  void clear();
+
+  /// Destroys the retired entries that no reader can reference anymore. Returns the number of entries still pending.
+  size_t reclaim();
+
+  size_t size() const { return count; }
+  size_t nof_pending_reclaims() const { return retired.size(); }
+
+private:
+  struct node_t {
+    tunnel_t             tunnel;
+    std::atomic<node_t*> next{nullptr};
+    uint64_t             retire_epoch = 0;
+  };
+
+  uint32_t              get_bucket(in_addr_t ue_ipv4) const { return (ue_ipv4 * 2654435761u) >> hash_shift; }
+  std::atomic<node_t*>* find_link(in_addr_t ue_ipv4) const;
+  void                  publish(std::atomic<node_t*>* link, const tunnel_t& tunnel);
+  void                  retire(std::atomic<node_t*>* link);
+
+  srsran::epoch_domain&                   epochs;
+  uint32_t                                hash_shift;
+  std::unique_ptr<std::atomic<node_t*>[]> buckets;
+  uint32_t                                nof_buckets;
+  size_t                                  count = 0;
+  std::vector<node_t*>                    retired;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_SPGW_TUNNEL_TABLE_H
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSEPC_UE_IP_POOL_H
+#define SRSEPC_UE_IP_POOL_H
+
+#include <cstdint>
+#include <netinet/in.h>
+#include <vector>
+
+namespace srsepc {
+
+/**
+ * Pool of UE IPv4 addresses with O(1) allocation and release.
+ * The pool covers a contiguous range of addresses, so the index of an address is given by its offset from the first
+ * one. Free addresses are kept in a FIFO list threaded through the entries, which hands out the addresses in
+ * ascending order at start and reuses the released ones as late as possible.
+ * All addresses are in network byte order.
+ */
+class ue_ip_pool
+{
+public:
+  /// Creates the pool with the nof_addrs addresses that start at first_addr.
+  void init(in_addr_t first_addr, uint32_t nof_addrs);
+
+  /// Takes an address out of the pool permanently, e.g. because it is statically assigned to a UE.
+  bool reserve(in_addr_t addr);
+
+  /// Returns a free address, or INADDR_ANY if the pool is exhausted.
+  in_addr_t allocate();
+
+  /// Returns an allocated address to the pool. Addresses that do not belong to the pool are ignored.
+  bool release(in_addr_t addr);
+
+  bool     contains(in_addr_t addr) const { return get_index(addr) < entries.size(); }
+  uint32_t size() const { return entries.size(); }
+  uint32_t nof_free() const { return free_count; }
+
+private:
+  static const uint32_t invalid_index = UINT32_MAX;
+
+  enum class addr_state : uint8_t { free, allocated, reserved };
+
+  struct entry_t {
+    addr_state state;
+    uint32_t   prev;
+    uint32_t   next;
+  };
+
+  uint32_t get_index(in_addr_t addr) const { return ntohl(addr) - first_host_addr; }
+  void     push_free(uint32_t idx);
+  void     unlink_free(uint32_t idx);
+
+  uint32_t             first_host_addr = 0; ///< first address of the pool, in host byte order
+  std::vector<entry_t> entries;
+  uint32_t             free_head  = invalid_index;
+  uint32_t             free_tail  = invalid_index;
+  uint32_t             free_count = 0;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_UE_IP_POOL_H
@@ -85,8 +85,11 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   mme_apn;
   string   encryption_algo;
   string   integrity_algo;
-  uint16_t paging_timer     = 0;
-  uint32_t max_paging_queue = 0;
+  uint16_t paging_timer           = 0;
+  uint32_t max_paging_queue       = 0;
+  uint32_t max_paging_queue_bytes = 0;
+  uint32_t paging_buffer_bytes    = 0;
+  string   paging_drop_policy;
   string   spgw_bind_addr;
   string   sgi_if_addr;
   string   sgi_if_name;
@@ -131,6 +134,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("spgw.sgi_if_addr",    bpo::value<string>(&sgi_if_addr)->default_value("176.16.0.1"),   "IP address of TUN interface for the SGi connection")
     ("spgw.sgi_if_name",    bpo::value<string>(&sgi_if_name)->default_value("srs_spgw_sgi"), "Name of TUN interface for the SGi connection")
     ("spgw.max_paging_queue", bpo::value<uint32_t>(&max_paging_queue)->default_value(100), "Max number of packets in paging queue")
+    ("spgw.max_paging_queue_bytes", bpo::value<uint32_t>(&max_paging_queue_bytes)->default_value(262144), "Max memory in bytes used by the paging queue of a UE")
+    ("spgw.paging_buffer_bytes", bpo::value<uint32_t>(&paging_buffer_bytes)->default_value(16777216), "Max memory in bytes used by the paging queues of all UEs")
+    ("spgw.paging_drop_policy", bpo::value<string>(&paging_drop_policy)->default_value("newest"), "Packet dropped when a paging queue is full (newest or oldest)")
 
     ("pcap.enable",   bpo::value<bool>(&args->mme_args.s1ap_args.pcap_enable)->default_value(false),         "Enable S1AP PCAP")
     ("pcap.filename", bpo::value<string>(&args->mme_args.s1ap_args.pcap_filename)->default_value("/tmp/epc.pcap"), "PCAP filename")
@@ -283,6 +289,17 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     cout << "Using default mme.integrity_algo: EIA1" << endl;
   }
 
+  std::transform(paging_drop_policy.begin(), paging_drop_policy.end(), paging_drop_policy.begin(), ::tolower);
+  if (paging_drop_policy == "newest") {
+    args->spgw_args.paging_drop_policy = paging_drop_policy_t::drop_newest;
+  } else if (paging_drop_policy == "oldest") {
+    args->spgw_args.paging_drop_policy = paging_drop_policy_t::drop_oldest;
+  } else {
+    args->spgw_args.paging_drop_policy = paging_drop_policy_t::drop_newest;
+    cout << "Error parsing spgw.paging_drop_policy:" << paging_drop_policy << " - must be newest or oldest." << endl;
+    cout << "Using default spgw.paging_drop_policy: newest" << endl;
+  }
+
   args->mme_args.s1ap_args.mme_bind_addr  = mme_bind_addr;
   args->mme_args.s1ap_args.mme_name       = mme_name;
   args->mme_args.s1ap_args.dns_addr       = dns_addr;
@@ -295,6 +312,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   args->spgw_args.sgi_if_addr             = sgi_if_addr;
   args->spgw_args.sgi_if_name             = sgi_if_name;
   args->spgw_args.max_paging_queue        = max_paging_queue;
+  args->spgw_args.max_paging_queue_bytes  = max_paging_queue_bytes;
+  args->spgw_args.paging_buffer_bytes     = paging_buffer_bytes;
   args->hss_args.db_file                  = hss_db_file;
 
   // Apply all_level to any unset layers
@@ -24,6 +24,7 @@
 #include "srsran/common/network_utils.h"
 #include "srsran/upper/gtpu.h"
 #include <algorithm>
+#include <array>
 #include <fcntl.h>
 #include <iostream>
 #include <linux/if.h>
@@ -31,6 +32,7 @@
 #include <linux/ip.h>
 #include <netinet/in.h>
 #include <netinet/udp.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
@@ -40,6 +42,7 @@ mbms_gw*        mbms_gw::m_instance    = NULL;
 pthread_mutex_t mbms_gw_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 const uint16_t MBMS_GW_BUFFER_SIZE = 2500;
+const uint32_t MBMS_GW_BATCH_SIZE  = 32; ///< Maximum number of SGi-mb packets forwarded per M1-U send
 
 mbms_gw::mbms_gw() : m_running(false), m_sgi_mb_up(false), thread("MBMS_GW")
 {
@@ -137,6 +140,13 @@ int mbms_gw::init_sgi_mb_if(mbms_gw_args_t* args)
     m_logger.debug("Set TUN device name: %s", args->sgi_mb_if_name.c_str());
   }
 
+  // Non-blocking reads let the MBMS-GW thread drain all the pending packets after each poll wakeup
+  if (fcntl(m_sgi_mb_if, F_SETFL, fcntl(m_sgi_mb_if, F_GETFL) | O_NONBLOCK) < 0) {
+    m_logger.error("Failed to set TUN device as non-blocking: %s", strerror(errno));
+    close(m_sgi_mb_if);
+    return SRSRAN_ERROR_CANT_START;
+  }
+
   // Bring up the interface
   int sgi_mb_sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (sgi_mb_sock < 0) {
@@ -257,32 +267,57 @@ int mbms_gw::init_m1_u(mbms_gw_args_t* args)
 void mbms_gw::run_thread()
 {
   // Mark the thread as running
-  m_running                        = true;
-  srsran::unique_byte_buffer_t msg = srsran::make_byte_buffer();
-  if (msg == nullptr) {
-    m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return;
+  m_running = true;
+
+  // Buffers of the batch, reused across batches. The GTP-U header is prepended in their headroom
+  std::array<srsran::unique_byte_buffer_t, MBMS_GW_BATCH_SIZE> batch;
+  for (srsran::unique_byte_buffer_t& msg : batch) {
+    msg = srsran::make_byte_buffer();
+    if (msg == nullptr) {
+      m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      return;
+    }
   }
 
-  uint8_t seq = 0;
+  pollfd sgi_mb_pfd = {m_sgi_mb_if, POLLIN, 0};
   while (m_running) {
-    msg->clear();
-    int n;
-    do {
-      n = read(m_sgi_mb_if, msg->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES);
-    } while (n == -1 && errno == EAGAIN);
-
+    int n = poll(&sgi_mb_pfd, 1, -1);
     if (n < 0) {
-      m_logger.error("Error reading from TUN interface. Error: %s", strerror(errno));
-    } else {
+      if (errno != EINTR) {
+        m_logger.error("Error polling TUN interface. Error: %s", strerror(errno));
+      }
+      continue;
+    }
+    if (sgi_mb_pfd.revents & POLLNVAL) {
+      // TUN interface closed
+      break;
+    }
+
+    // Drain the TUN interface, up to a full batch, and send all the packets to the M1-U with a single syscall
+    uint32_t nof_pdus = 0;
+    while (nof_pdus < batch.size()) {
+      srsran::byte_buffer_t* msg = batch[nof_pdus].get();
+      msg->clear();
+      n = read(m_sgi_mb_if, msg->msg, msg->get_tailroom());
+      if (n < 0) {
+        if (errno != EAGAIN and errno != EWOULDBLOCK) {
+          m_logger.error("Error reading from TUN interface. Error: %s", strerror(errno));
+        }
+        break;
+      }
       msg->N_bytes = n;
-      handle_sgi_md_pdu(msg.get());
+      if (handle_sgi_md_pdu(msg)) {
+        nof_pdus++;
+      }
+    }
+    if (nof_pdus > 0) {
+      send_m1u_pdus(batch.data(), nof_pdus);
     }
   }
   return;
 }
 
-void mbms_gw::handle_sgi_md_pdu(srsran::byte_buffer_t* msg)
+bool mbms_gw::handle_sgi_md_pdu(srsran::byte_buffer_t* msg)
 {
   uint8_t               version;
   srsran::gtpu_header_t header;
@@ -296,26 +331,32 @@ void mbms_gw::handle_sgi_md_pdu(srsran::byte_buffer_t* msg)
   // Sanity Check IP packet
   if (msg->N_bytes < 20) {
     m_logger.error("IPv4 min len: %d, drop msg len %d", 20, msg->N_bytes);
-    return;
+    return false;
   }
 
   // IP Headers
   struct iphdr* iph = (struct iphdr*)msg->msg;
   if (iph->version != 4) {
     m_logger.info("IPv6 not supported yet.");
-    return;
+    return false;
   }
 
   // Write GTP-U header into packet
   if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
     srsran::console("Error writing GTP-U header on PDU\n");
+    return false;
   }
+  return true;
+}
 
-  int n = sendto(m_m1u, msg->msg, msg->N_bytes, 0, (sockaddr*)&m_m1u_multi_addr, sizeof(struct sockaddr));
-  if (n < 0) {
+void mbms_gw::send_m1u_pdus(const srsran::unique_byte_buffer_t* pdus, uint32_t nof_pdus)
+{
+  int n = srsran::net_utils::send_pdus(m_m1u, m_m1u_multi_addr, pdus, nof_pdus);
+  if (n < (int)nof_pdus) {
     srsran::console("Error writing to M1-U socket.\n");
-  } else {
-    m_logger.debug("Sent %d Bytes", msg->N_bytes);
+  }
+  if (n > 0) {
+    m_logger.debug("Sent %d PDUs", n);
   }
 }
 
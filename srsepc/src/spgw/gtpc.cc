@@ -29,9 +29,12 @@
 #include <linux/if_tun.h>
 #include <linux/ip.h>
 #include <netinet/in.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
+#include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <unistd.h>
 
 namespace srsepc {
 
@@ -41,7 +44,13 @@ namespace srsepc {
  * comminication with the MME
  *
  **********************************************/
-spgw::gtpc::gtpc() : m_h_next_ue_ip(0), m_next_ctrl_teid(1), m_next_user_teid(1), m_max_paging_queue(0)
+spgw::gtpc::gtpc() :
+  thread("SPGW_GTPC"),
+  m_running(false),
+  m_event_fd(-1),
+  m_h_next_ue_ip(0),
+  m_next_ctrl_teid(1),
+  m_next_user_teid(1)
 {
   return;
 }
@@ -76,8 +85,24 @@ int spgw::gtpc::init(spgw_args_t*                           args,
     return err;
   }
 
-  // Limit paging queue
-  m_max_paging_queue = args->max_paging_queue;
+  // Limit paging queues
+  paging_buffer_args_t paging_args;
+  paging_args.max_pkts_per_ue  = args->max_paging_queue;
+  paging_args.max_bytes_per_ue = args->max_paging_queue_bytes;
+  paging_args.max_bytes        = args->paging_buffer_bytes;
+  paging_args.drop_policy      = args->paging_drop_policy;
+  m_paging_buffers.init(paging_args);
+
+  // Init event notifications from the user-plane thread
+  m_event_fd = eventfd(0, EFD_NONBLOCK);
+  if (m_event_fd < 0) {
+    m_logger.error("Error creating eventfd. Error %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+
+  // Handle S11 in a dedicated thread
+  m_running = true;
+  start();
 
   m_logger.info("SPGW S11 Initialized.");
   srsran::console("SPGW S11 Initialized.\n");
@@ -86,10 +111,25 @@ int spgw::gtpc::init(spgw_args_t*                           args,
 
 void spgw::gtpc::stop()
 {
-  std::map<uint32_t, spgw_tunnel_ctx*>::iterator it = m_teid_to_tunnel_ctx.begin();
+  if (m_running) {
+    m_running = false;
+    uint64_t value = 1;
+    if (write(m_event_fd, &value, sizeof(value)) < 0) {
+      m_logger.error("Error waking up GTP-C thread. Error %s", strerror(errno));
+    }
+    wait_thread_finish();
+  }
+  if (m_event_fd >= 0) {
+    close(m_event_fd);
+    m_event_fd = -1;
+  }
+  m_dl_events.clear();
+
+  auto it = m_teid_to_tunnel_ctx.begin();
   while (it != m_teid_to_tunnel_ctx.end()) {
     m_logger.info("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "", it->second->imsi);
     srsran::console("Deleting SP-GW GTP-C Tunnel. IMSI: %015" PRIu64 "\n", it->second->imsi);
+    m_paging_buffers.clear(it->second->paging_queue);
     delete it->second;
     m_teid_to_tunnel_ctx.erase(it++);
   }
@@ -132,6 +172,43 @@ int spgw::gtpc::init_s11(spgw_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+void spgw::gtpc::run_thread()
+{
+  srsran::unique_byte_buffer_t s11_msg = srsran::make_byte_buffer("spgw::gtpc::run_thread::s11");
+  struct sockaddr_un           src_addr_un;
+
+  size_t buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+
+  fd_set set;
+  int    max_fd = std::max(m_s11, m_event_fd);
+  while (m_running) {
+    FD_ZERO(&set);
+    FD_SET(m_s11, &set);
+    FD_SET(m_event_fd, &set);
+
+    int n = select(max_fd + 1, &set, NULL, NULL, NULL);
+    if (n == -1) {
+      if (errno != EINTR) {
+        m_logger.error("Error from select");
+      }
+      continue;
+    }
+    if (FD_ISSET(m_event_fd, &set)) {
+      uint64_t value;
+      if (read(m_event_fd, &value, sizeof(value)) > 0) {
+        handle_dl_events();
+      }
+    }
+    if (FD_ISSET(m_s11, &set)) {
+      m_logger.debug("Message received at SPGW: S11 Message");
+      s11_msg->clear();
+      socklen_t addrlen = sizeof(src_addr_un);
+      s11_msg->N_bytes  = recvfrom(m_s11, s11_msg->msg, buf_len, 0, (struct sockaddr*)&src_addr_un, &addrlen);
+      handle_s11_pdu(s11_msg.get());
+    }
+  }
+}
+
 bool spgw::gtpc::send_s11_pdu(const srsran::gtpc_pdu& pdu)
 {
   m_logger.debug("SPGW Sending S11 PDU! N_Bytes: %zd", sizeof(pdu));
@@ -240,8 +317,8 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
   m_logger.info("Received Modified Bearer Request");
 
   // Get control tunnel info from mb_req PDU
-  uint32_t                                         ctrl_teid = mb_req_hdr.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = mb_req_hdr.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID %d to modify", ctrl_teid);
     return;
@@ -271,12 +348,13 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
   // Setup IP to F-TEID map
   m_gtpu->modify_gtpu_tunnel(tunnel_ctx->ue_ipv4, tunnel_ctx->dw_user_fteid, tunnel_ctx->up_ctrl_fteid.teid);
 
-  // Mark paging as done & send queued packets
+  // Mark paging as done & send queued packets, including the ones still waiting in the event queue
+  handle_dl_events();
   if (tunnel_ctx->paging_pending == true) {
     tunnel_ctx->paging_pending = false;
     m_logger.debug("Modify Bearer Request received after Downling Data Notification was sent");
     srsran::console("Modify Bearer Request received after Downling Data Notification was sent\n");
-    m_gtpu->send_all_queued_packets(tunnel_ctx->dw_user_fteid, tunnel_ctx->paging_queue);
+    send_all_queued_packets(tunnel_ctx);
   }
 
   // Setting up Modify bearer response PDU
@@ -303,8 +381,8 @@ void spgw::gtpc::handle_modify_bearer_request(const struct srsran::gtpc_header&
 void spgw::gtpc::handle_delete_session_request(const srsran::gtpc_header&                 header,
                                                const srsran::gtpc_delete_session_request& del_req_pdu)
 {
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to delete session", ctrl_teid);
     return;
@@ -320,8 +398,8 @@ void spgw::gtpc::handle_release_access_bearers_request(const srsran::gtpc_header
                                                        const srsran::gtpc_release_access_bearers_request& rel_req)
 {
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to release bearers", ctrl_teid);
     return;
@@ -334,7 +412,7 @@ void spgw::gtpc::handle_release_access_bearers_request(const srsran::gtpc_header
   return;
 }
 
-bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
+bool spgw::gtpc::trigger_downlink_data_notification(uint32_t spgw_ctr_teid)
 {
   m_logger.debug("Sending Downlink Notification Request");
 
@@ -344,7 +422,7 @@ bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
   struct srsran::gtpc_downlink_data_notification* dl_not = &dl_not_pdu.choice.downlink_data_notification;
 
   // Find MME Ctrl TEID
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
+  auto tunnel_it = m_teid_to_tunnel_ctx.find(spgw_ctr_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to send downlink notification.", spgw_ctr_teid);
     return false;
@@ -382,8 +460,8 @@ void spgw::gtpc::handle_downlink_data_notification_acknowledge(
   m_logger.debug("Handling downlink data notification acknowledge");
 
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to handle notification acknowldge", ctrl_teid);
     return;
@@ -410,8 +488,8 @@ void spgw::gtpc::handle_downlink_data_notification_failure_indication(
 {
   m_logger.debug("Handling downlink data notification failure indication");
   // Find tunel ctxt
-  uint32_t                                         ctrl_teid = header.teid;
-  std::map<uint32_t, spgw_tunnel_ctx_t*>::iterator tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
+  uint32_t ctrl_teid = header.teid;
+  auto     tunnel_it = m_teid_to_tunnel_ctx.find(ctrl_teid);
   if (tunnel_it == m_teid_to_tunnel_ctx.end()) {
     m_logger.warning("Could not find TEID 0x%x to handle notification failure indication", ctrl_teid);
     return;
@@ -481,19 +559,81 @@ bool spgw::gtpc::delete_gtpc_ctx(uint32_t ctrl_teid)
   // Remove Ctrl TEID from GTP-U Mapping
   m_gtpu->delete_gtpc_tunnel(tunnel_ctx->ue_ipv4);
 
+  // Return the UE IP to the pool. Static addresses are not part of it
+  m_ue_ip_addr_pool.release(tunnel_ctx->ue_ipv4);
+
   // Remove Ctrl TEID from IMSI to control TEID map
   m_imsi_to_ctr_teid.erase(tunnel_ctx->imsi);
 
+  // Free the packets held for paging
+  m_paging_buffers.clear(tunnel_ctx->paging_queue);
+
   // Remove GTP context from control TEID mapping
   m_teid_to_tunnel_ctx.erase(ctrl_teid);
   delete tunnel_ctx;
   return true;
 }
 
+/*
+ * Downlink events from the user-plane thread
+ */
+bool spgw::gtpc::queue_downlink_packet(uint32_t spgw_ctr_teid, srsran::unique_byte_buffer_t msg)
+{
+  bool notify;
+  {
+    std::lock_guard<std::mutex> lock(m_dl_events_mutex);
+    if (m_dl_events.size() >= max_dl_events) {
+      // Dropped notifications are triggered again by the next packet of the UE
+      if (msg != nullptr) {
+        m_nof_dropped_dl_pkts++;
+      }
+      return false;
+    }
+    notify = m_dl_events.empty();
+    m_dl_events.push_back(dl_event_t{spgw_ctr_teid, std::move(msg)});
+  }
+  // The GTP-C thread only needs to be woken up once for all the events queued until it runs
+  if (notify) {
+    uint64_t value = 1;
+    if (write(m_event_fd, &value, sizeof(value)) < 0) {
+      m_logger.error("Error notifying downlink event. Error %s", strerror(errno));
+      return false;
+    }
+  }
+  return true;
+}
+
+bool spgw::gtpc::send_downlink_data_notification(uint32_t spgw_ctr_teid)
+{
+  return queue_downlink_packet(spgw_ctr_teid, nullptr);
+}
+
+void spgw::gtpc::handle_dl_events()
+{
+  std::deque<dl_event_t> events;
+  uint64_t               nof_dropped_pkts;
+  {
+    std::lock_guard<std::mutex> lock(m_dl_events_mutex);
+    events.swap(m_dl_events);
+    nof_dropped_pkts      = m_nof_dropped_dl_pkts;
+    m_nof_dropped_dl_pkts = 0;
+  }
+  if (nof_dropped_pkts > 0) {
+    m_logger.warning("Dropped %" PRIu64 " downlink packets of idle UEs, the event queue is full", nof_dropped_pkts);
+  }
+  for (dl_event_t& event : events) {
+    if (event.pkt == nullptr) {
+      trigger_downlink_data_notification(event.spgw_ctr_teid);
+    } else {
+      store_downlink_packet(event.spgw_ctr_teid, std::move(event.pkt));
+    }
+  }
+}
+
 /*
  * Queueing functions
  */
-bool spgw::gtpc::queue_downlink_packet(uint32_t ctrl_teid, srsran::unique_byte_buffer_t msg)
+bool spgw::gtpc::store_downlink_packet(uint32_t ctrl_teid, srsran::unique_byte_buffer_t msg)
 {
   spgw_tunnel_ctx_t* tunnel_ctx;
   if (!m_teid_to_tunnel_ctx.count(ctrl_teid)) {
@@ -506,13 +646,17 @@ bool spgw::gtpc::queue_downlink_packet(uint32_t ctrl_teid, srsran::unique_byte_b
     goto pkt_discard;
   }
 
-  if (tunnel_ctx->paging_queue.size() < m_max_paging_queue) {
-    tunnel_ctx->paging_queue.push(std::move(msg));
-    m_logger.debug(
-        "Queued packet. IMSI %" PRIu64 ", Packets in Queue %zd", tunnel_ctx->imsi, tunnel_ctx->paging_queue.size());
+  // The packet is copied to a right-sized paging buffer, and its byte_buffer returned to the pool right away
+  if (m_paging_buffers.push(tunnel_ctx->paging_queue, msg->msg, msg->N_bytes)) {
+    m_logger.debug("Queued packet. IMSI %" PRIu64 ", Packets in Queue %d, Bytes in Queue %d",
+                   tunnel_ctx->imsi,
+                   tunnel_ctx->paging_queue.nof_pkts,
+                   tunnel_ctx->paging_queue.nof_bytes);
   } else {
-    m_logger.debug(
-        "Paging queue full. IMSI %" PRIu64 ", Packets in Queue %zd", tunnel_ctx->imsi, tunnel_ctx->paging_queue.size());
+    m_logger.debug("Paging queue full. IMSI %" PRIu64 ", Packets in Queue %d, Bytes in Queue %d",
+                   tunnel_ctx->imsi,
+                   tunnel_ctx->paging_queue.nof_pkts,
+                   tunnel_ctx->paging_queue.nof_bytes);
     goto pkt_discard;
   }
   return true;
@@ -521,20 +665,45 @@ pkt_discard:
   return false;
 }
 
+void spgw::gtpc::send_all_queued_packets(spgw_tunnel_ctx_t* tunnel_ctx)
+{
+  m_logger.debug("Sending all queued packets");
+  srsran::unique_byte_buffer_t msg = srsran::make_byte_buffer("spgw::gtpc::send_all_queued_packets");
+  if (msg == nullptr) {
+    m_logger.error("Couldn't allocate buffer to send queued packets");
+    free_all_queued_packets(tunnel_ctx);
+    return;
+  }
+  while (m_paging_buffers.pop(tunnel_ctx->paging_queue, *msg)) {
+    m_gtpu->send_s1u_pdu(tunnel_ctx->dw_user_fteid, msg.get());
+  }
+  log_paging_buffer_metrics();
+}
+
 bool spgw::gtpc::free_all_queued_packets(spgw_tunnel_ctx_t* tunnel_ctx)
 {
   if (!tunnel_ctx->paging_pending) {
     m_logger.info("Trying to free queued packets, but paging is not pending.");
   }
 
-  while (!tunnel_ctx->paging_queue.empty()) {
-    srsran::unique_byte_buffer_t pkt = std::move(tunnel_ctx->paging_queue.front());
-    m_logger.debug("Dropping packet. Bytes %d", pkt->N_bytes);
-    tunnel_ctx->paging_queue.pop();
-  }
+  uint32_t nof_pkts = m_paging_buffers.clear(tunnel_ctx->paging_queue);
+  m_logger.debug("Dropping %d queued packets", nof_pkts);
+  log_paging_buffer_metrics();
   return true;
 }
 
+void spgw::gtpc::log_paging_buffer_metrics()
+{
+  paging_buffer_metrics_t metrics = m_paging_buffers.get_metrics();
+  m_logger.info("Paging buffers: %d queued packets, %" PRIu64 " bytes in use, %" PRIu64 " bytes cached, peak %" PRIu64
+                " bytes, %" PRIu64 " dropped packets",
+                metrics.nof_queued_pkts,
+                metrics.bytes_in_use,
+                metrics.bytes_cached,
+                metrics.peak_bytes_in_use,
+                metrics.nof_dropped_pkts);
+}
+
 int spgw::gtpc::init_ue_ip(spgw_args_t* args, const std::map<std::string, uint64_t>& ip_to_imsi)
 {
   std::map<std::string, uint64_t>::const_iterator iter = ip_to_imsi.find(args->sgi_if_addr);
@@ -563,26 +732,25 @@ int spgw::gtpc::init_ue_ip(spgw_args_t* args, const std::map<std::string, uint64
 
   // XXX TODO add an upper bound to ip addr range via config, use 254 for now
   // first address is allocated to the epc tun interface, start w/next addr
-  for (uint32_t n = 1; n < 254; ++n) {
-    struct in_addr ue_addr;
-    if (inet_pton(AF_INET, args->sgi_if_addr.c_str(), &ue_addr.s_addr) != 1) {
-      m_logger.error("Invalid sgi_if_addr: %s", args->sgi_if_addr.c_str());
-      srsran::console("Invalid sgi_if_addr: %s\n", args->sgi_if_addr.c_str());
-      perror("inet_pton");
-      return SRSRAN_ERROR;
-    }
-    ue_addr.s_addr = ue_addr.s_addr + htonl(n);
+  struct in_addr ue_addr;
+  if (inet_pton(AF_INET, args->sgi_if_addr.c_str(), &ue_addr.s_addr) != 1) {
+    m_logger.error("Invalid sgi_if_addr: %s", args->sgi_if_addr.c_str());
+    srsran::console("Invalid sgi_if_addr: %s\n", args->sgi_if_addr.c_str());
+    perror("inet_pton");
+    return SRSRAN_ERROR;
+  }
+  ue_addr.s_addr = htonl(ntohl(ue_addr.s_addr) + 1);
+  m_ue_ip_addr_pool.init(ue_addr.s_addr, 253);
 
-    std::map<std::string, uint64_t>::const_iterator iter = ip_to_imsi.find(inet_ntoa(ue_addr));
-    if (iter != ip_to_imsi.end()) {
+  // static addresses are not handed out by the pool
+  for (const auto& imsi_ip : m_imsi_to_ip) {
+    if (m_ue_ip_addr_pool.reserve(imsi_ip.second.s_addr)) {
       m_logger.debug("SPGW: init_ue_ip ue ip addr %s is reserved for imsi %015" PRIu64 ", not adding to pool",
-                     iter->first.c_str(),
-                     iter->second);
-    } else {
-      m_ue_ip_addr_pool.insert(ue_addr.s_addr);
-      m_logger.debug("SPGW: init_ue_ip ue ip addr %s is added to pool", inet_ntoa(ue_addr));
+                     inet_ntoa(imsi_ip.second),
+                     imsi_ip.first);
     }
   }
+  m_logger.debug("SPGW: init_ue_ip %d ue ip addrs are added to pool", m_ue_ip_addr_pool.nof_free());
   return SRSRAN_SUCCESS;
 }
 
@@ -590,17 +758,15 @@ in_addr_t spgw::gtpc::get_new_ue_ipv4(uint64_t imsi)
 {
   struct in_addr ue_addr;
 
-  std::map<uint64_t, struct in_addr>::const_iterator iter = m_imsi_to_ip.find(imsi);
+  auto iter = m_imsi_to_ip.find(imsi);
   if (iter != m_imsi_to_ip.end()) {
     ue_addr = iter->second;
     m_logger.info("SPGW: get_new_ue_ipv4 static ip addr %s", inet_ntoa(ue_addr));
   } else {
-    if (m_ue_ip_addr_pool.empty()) {
+    ue_addr.s_addr = m_ue_ip_addr_pool.allocate();
+    if (ue_addr.s_addr == INADDR_ANY) {
       m_logger.error("SPGW: ue address pool is empty");
-      ue_addr.s_addr = 0;
     } else {
-      ue_addr.s_addr = *m_ue_ip_addr_pool.begin();
-      m_ue_ip_addr_pool.erase(ue_addr.s_addr);
       m_logger.info("SPGW: get_new_ue_ipv4 pool ip addr %s", inet_ntoa(ue_addr));
     }
   }
@@ -208,11 +208,8 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   bool usr_found = false;
   bool ctr_found = false;
 
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  spgw_tunnel_table::tunnel_t tunnel;
+  struct iphdr*               iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -234,15 +231,12 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
 
   // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
-    usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
-  }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
-    ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
+  {
+    srsran::epoch_read_guard guard;
+    if (m_tunnels.find(iph->daddr, tunnel)) {
+      usr_found = tunnel.user_present;
+      ctr_found = tunnel.ctrl_present;
+    }
   }
 
   // Handle SGi packet
@@ -251,13 +245,13 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   } else if (usr_found == false && ctr_found == true) {
     m_logger.debug("Packet for attached UE that is not ECM connected.");
     m_logger.debug("Triggering Donwlink Notification Requset.");
-    m_gtpc->send_downlink_data_notification(spgw_teid);
-    m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
+    m_gtpc->send_downlink_data_notification(tunnel.up_ctrl_teid);
+    m_gtpc->queue_downlink_packet(tunnel.up_ctrl_teid, std::move(msg));
     return;
   } else if (usr_found == true && ctr_found == false) {
     m_logger.error("User plane tunnel found without a control plane tunnel present.");
   } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+    send_s1u_pdu(tunnel.dw_user_fteid, msg.get());
   }
 }
 
@@ -315,18 +309,6 @@ out:
   return;
 }
 
-void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
-                                         std::queue<srsran::unique_byte_buffer_t>& pkt_queue)
-{
-  m_logger.debug("Sending all queued packets");
-  while (!pkt_queue.empty()) {
-    srsran::unique_byte_buffer_t msg = std::move(pkt_queue.front());
-    send_s1u_pdu(dw_user_fteid, msg.get());
-    pkt_queue.pop();
-  }
-  return;
-}
-
 /*
  * Tunnel managment
  */
@@ -340,17 +322,14 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
-  m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
-  m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+  m_tunnels.set_tunnel(ue_ipv4, dw_user_fteid, up_ctrl_teid);
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
-  } else {
+  if (!m_tunnels.remove_user_tunnel(ue_ipv4)) {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
   }
@@ -360,9 +339,7 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
-  } else {
+  if (!m_tunnels.remove_ctrl_tunnel(ue_ipv4)) {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
   }
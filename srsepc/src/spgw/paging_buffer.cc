@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/paging_buffer.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace srsepc {
+
+const std::array<uint32_t, paging_buffer_store::nof_size_classes> paging_buffer_store::size_classes = {
+    {128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 6144, 8192, 12288, 16384}};
+
+paging_buffer_store::~paging_buffer_store()
+{
+  // Queued packets are freed by the owners of the queues
+  for (packet_t*& head : free_lists) {
+    while (head != nullptr) {
+      packet_t* next = head->next;
+      ::operator delete(head);
+      head = next;
+    }
+  }
+}
+
+void paging_buffer_store::init(const paging_buffer_args_t& args_)
+{
+  args = args_;
+}
+
+uint32_t paging_buffer_store::get_size_class(uint32_t len)
+{
+  auto it = std::lower_bound(size_classes.begin(), size_classes.end(), len);
+  return it - size_classes.begin();
+}
+
+bool paging_buffer_store::push(queue_t& q, const uint8_t* data, uint32_t len)
+{
+  uint32_t size_class = get_size_class(len);
+  if (size_class == invalid_size_class) {
+    nof_dropped_pkts++;
+    return false;
+  }
+  uint32_t buffer_size = get_buffer_size(size_class);
+
+  // Make room for the packet according to the drop policy
+  while (q.nof_pkts >= args.max_pkts_per_ue or q.nof_bytes + buffer_size > args.max_bytes_per_ue or
+         bytes_in_use + buffer_size > args.max_bytes) {
+    if (args.drop_policy == paging_drop_policy_t::drop_newest or q.head == nullptr) {
+      nof_dropped_pkts++;
+      return false;
+    }
+    free_packet(pop_packet(q));
+    nof_dropped_pkts++;
+  }
+
+  packet_t* pkt = alloc_packet(size_class);
+  pkt->next     = nullptr;
+  pkt->len      = len;
+  memcpy(pkt->data(), data, len);
+  if (q.tail != nullptr) {
+    q.tail->next = pkt;
+  } else {
+    q.head = pkt;
+  }
+  q.tail = pkt;
+  q.nof_pkts++;
+  q.nof_bytes += buffer_size;
+  nof_queued_pkts++;
+  bytes_in_use += buffer_size;
+  peak_bytes_in_use = std::max(peak_bytes_in_use, bytes_in_use);
+  return true;
+}
+
+bool paging_buffer_store::pop(queue_t& q, srsran::byte_buffer_t& pdu)
+{
+  packet_t* pkt = pop_packet(q);
+  if (pkt == nullptr) {
+    return false;
+  }
+  pdu.clear();
+  pdu.append_bytes(pkt->data(), pkt->len);
+  free_packet(pkt);
+  return true;
+}
+
+uint32_t paging_buffer_store::clear(queue_t& q)
+{
+  uint32_t nof_pkts = q.nof_pkts;
+  while (q.head != nullptr) {
+    free_packet(pop_packet(q));
+  }
+  return nof_pkts;
+}
+
+paging_buffer_metrics_t paging_buffer_store::get_metrics() const
+{
+  paging_buffer_metrics_t metrics;
+  metrics.nof_queued_pkts   = nof_queued_pkts;
+  metrics.bytes_in_use      = bytes_in_use;
+  metrics.bytes_cached      = bytes_cached;
+  metrics.peak_bytes_in_use = peak_bytes_in_use;
+  metrics.nof_dropped_pkts  = nof_dropped_pkts;
+  return metrics;
+}
+
+paging_buffer_store::packet_t* paging_buffer_store::alloc_packet(uint32_t size_class)
+{
+  packet_t* pkt = free_lists[size_class];
+  if (pkt != nullptr) {
+    free_lists[size_class] = pkt->next;
+    bytes_cached -= get_buffer_size(size_class);
+  } else {
+    // Free cached buffers of other size classes, so that the memory held by the store stays within the global limit
+    release_cached(get_buffer_size(size_class));
+    pkt = static_cast<packet_t*>(::operator new(get_buffer_size(size_class)));
+  }
+  pkt->size_class = size_class;
+  return pkt;
+}
+
+void paging_buffer_store::release_cached(uint32_t buffer_size)
+{
+  // Start with the largest buffers, which are the least likely to be reused
+  for (uint32_t i = nof_size_classes; i > 0 and bytes_in_use + bytes_cached + buffer_size > args.max_bytes; --i) {
+    packet_t*& head = free_lists[i - 1];
+    while (head != nullptr and bytes_in_use + bytes_cached + buffer_size > args.max_bytes) {
+      packet_t* pkt = head;
+      head          = pkt->next;
+      bytes_cached -= get_buffer_size(i - 1);
+      ::operator delete(pkt);
+    }
+  }
+}
+
+void paging_buffer_store::free_packet(packet_t* pkt)
+{
+  uint32_t buffer_size = get_buffer_size(pkt->size_class);
+  nof_queued_pkts--;
+  bytes_in_use -= buffer_size;
+  // Keep the buffer for reuse, as long as the memory held by the store stays within the global limit
+  if (bytes_in_use + bytes_cached + buffer_size <= args.max_bytes) {
+    pkt->next                   = free_lists[pkt->size_class];
+    free_lists[pkt->size_class] = pkt;
+    bytes_cached += buffer_size;
+  } else {
+    ::operator delete(pkt);
+  }
+}
+
+paging_buffer_store::packet_t* paging_buffer_store::pop_packet(queue_t& q)
+{
+  packet_t* pkt = q.head;
+  if (pkt == nullptr) {
+    return nullptr;
+  }
+  q.head = pkt->next;
+  if (q.head == nullptr) {
+    q.tail = nullptr;
+  }
+  q.nof_pkts--;
+  q.nof_bytes -= get_buffer_size(pkt->size_class);
+  return pkt;
+}
+
+} // namespace srsepc
@@ -0,0 +1,183 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/spgw_tunnel_table.h"
+#include <algorithm>
+
+namespace srsepc {
+
+spgw_tunnel_table::spgw_tunnel_table(uint32_t nof_buckets_log2) :
+  epochs(srsran::epoch_domain::get_instance()),
+  hash_shift(32 - nof_buckets_log2),
+  buckets(new std::atomic<node_t*>[1u << nof_buckets_log2]),
+  nof_buckets(1u << nof_buckets_log2)
+{
+  srsran_assert(nof_buckets_log2 > 0 and nof_buckets_log2 < 32, "Invalid number of buckets");
+  for (uint32_t i = 0; i < nof_buckets; ++i) {
+    buckets[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+spgw_tunnel_table::~spgw_tunnel_table()
+{
+  // The readers are expected to be stopped at this point
+  for (uint32_t i = 0; i < nof_buckets; ++i) {
+    node_t* n = buckets[i].load(std::memory_order_relaxed);
+    while (n != nullptr) {
+      node_t* next = n->next.load(std::memory_order_relaxed);
+      delete n;
+      n = next;
+    }
+  }
+  for (node_t* n : retired) {
+    delete n;
+  }
+}
+
+bool spgw_tunnel_table::find(in_addr_t ue_ipv4, tunnel_t& tunnel) const
+{
+  node_t* n = buckets[get_bucket(ue_ipv4)].load(std::memory_order_acquire);
+  while (n != nullptr) {
+    if (n->tunnel.ue_ipv4 == ue_ipv4) {
+      tunnel = n->tunnel;
+      return true;
+    }
+    n = n->next.load(std::memory_order_acquire);
+  }
+  return false;
+}
+
+void spgw_tunnel_table::set_tunnel(in_addr_t ue_ipv4, const srsran::gtp_fteid_t& dw_user_fteid, uint32_t up_ctrl_teid)
+{
+  tunnel_t tunnel;
+  tunnel.ue_ipv4       = ue_ipv4;
+  tunnel.user_present  = true;
+  tunnel.dw_user_fteid = dw_user_fteid;
+  tunnel.ctrl_present  = true;
+  tunnel.up_ctrl_teid  = up_ctrl_teid;
+  publish(find_link(ue_ipv4), tunnel);
+  reclaim();
+}
+
+bool spgw_tunnel_table::remove_user_tunnel(in_addr_t ue_ipv4)
+{
+  std::atomic<node_t*>* link = find_link(ue_ipv4);
+  node_t*               n    = link->load(std::memory_order_relaxed);
+  if (n == nullptr or not n->tunnel.user_present) {
+    return false;
+  }
+  if (n->tunnel.ctrl_present) {
+    tunnel_t tunnel      = n->tunnel;
+    tunnel.user_present  = false;
+    tunnel.dw_user_fteid = {};
+    publish(link, tunnel);
+  } else {
+    retire(link);
+  }
+  reclaim();
+  return true;
+}
+
+bool spgw_tunnel_table::remove_ctrl_tunnel(in_addr_t ue_ipv4)
+{
+  std::atomic<node_t*>* link = find_link(ue_ipv4);
+  node_t*               n    = link->load(std::memory_order_relaxed);
+  if (n == nullptr or not n->tunnel.ctrl_present) {
+    return false;
+  }
+  if (n->tunnel.user_present) {
+    tunnel_t tunnel     = n->tunnel;
+    tunnel.ctrl_present = false;
+    tunnel.up_ctrl_teid = 0;
+    publish(link, tunnel);
+  } else {
+    retire(link);
+  }
+  reclaim();
+  return true;
+}
+
+void spgw_tunnel_table::clear()
+{
+  for (uint32_t i = 0; i < nof_buckets; ++i) {
+    while (buckets[i].load(std::memory_order_relaxed) != nullptr) {
+      retire(&buckets[i]);
+    }
+  }
+  reclaim();
+}
+
+size_t spgw_tunnel_table::reclaim()
+{
+  if (retired.empty()) {
+    return 0;
+  }
+  uint64_t min_epoch = epochs.min_active_epoch();
+  auto     it        = std::partition(
+      retired.begin(), retired.end(), [min_epoch](const node_t* n) { return n->retire_epoch >= min_epoch; });
+  for (auto safe_it = it; safe_it != retired.end(); ++safe_it) {
+    delete *safe_it;
+  }
+  retired.erase(it, retired.end());
+  return retired.size();
+}
+
+/// Returns the link that points to the entry of the UE, or the null link at the end of its bucket.
+std::atomic<spgw_tunnel_table::node_t*>* spgw_tunnel_table::find_link(in_addr_t ue_ipv4) const
+{
+  std::atomic<node_t*>* link = &buckets[get_bucket(ue_ipv4)];
+  node_t*               n    = link->load(std::memory_order_relaxed);
+  while (n != nullptr and n->tunnel.ue_ipv4 != ue_ipv4) {
+    link = &n->next;
+    n    = link->load(std::memory_order_relaxed);
+  }
+  return link;
+}
+
+/// Replaces the entry pointed by the link, or appends a new entry if the link is null.
+void spgw_tunnel_table::publish(std::atomic<node_t*>* link, const tunnel_t& tunnel)
+{
+  node_t* old_node = link->load(std::memory_order_relaxed);
+  node_t* new_node = new node_t;
+  new_node->tunnel = tunnel;
+  new_node->next.store(old_node != nullptr ? old_node->next.load(std::memory_order_relaxed) : nullptr,
+                       std::memory_order_relaxed);
+  // The release store makes the entry contents visible to the readers that reach it
+  link->store(new_node, std::memory_order_release);
+  if (old_node != nullptr) {
+    old_node->retire_epoch = epochs.advance();
+    retired.push_back(old_node);
+  } else {
+    count++;
+  }
+}
+
+/// Unlinks the entry pointed by the link. Readers that already reached it can still follow its next pointer.
+void spgw_tunnel_table::retire(std::atomic<node_t*>* link)
+{
+  node_t* n = link->load(std::memory_order_relaxed);
+  link->store(n->next.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+  n->retire_epoch = epochs.advance();
+  retired.push_back(n);
+  count--;
+}
+
+} // namespace srsepc
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/ue_ip_pool.h"
+
+namespace srsepc {
+
+void ue_ip_pool::init(in_addr_t first_addr, uint32_t nof_addrs)
+{
+  first_host_addr = ntohl(first_addr);
+  entries.assign(nof_addrs, entry_t{addr_state::free, invalid_index, invalid_index});
+  free_head  = invalid_index;
+  free_tail  = invalid_index;
+  free_count = 0;
+  for (uint32_t idx = 0; idx < nof_addrs; ++idx) {
+    push_free(idx);
+  }
+}
+
+bool ue_ip_pool::reserve(in_addr_t addr)
+{
+  uint32_t idx = get_index(addr);
+  if (idx >= entries.size() or entries[idx].state == addr_state::reserved) {
+    return false;
+  }
+  if (entries[idx].state == addr_state::free) {
+    unlink_free(idx);
+  }
+  entries[idx].state = addr_state::reserved;
+  return true;
+}
+
+in_addr_t ue_ip_pool::allocate()
+{
+  if (free_head == invalid_index) {
+    return INADDR_ANY;
+  }
+  uint32_t idx = free_head;
+  unlink_free(idx);
+  entries[idx].state = addr_state::allocated;
+  return htonl(first_host_addr + idx);
+}
+
+bool ue_ip_pool::release(in_addr_t addr)
+{
+  uint32_t idx = get_index(addr);
+  if (idx >= entries.size() or entries[idx].state != addr_state::allocated) {
+    return false;
+  }
+  push_free(idx);
+  return true;
+}
+
+void ue_ip_pool::push_free(uint32_t idx)
+{
+  entry_t& e = entries[idx];
+  e.state    = addr_state::free;
+  e.prev     = free_tail;
+  e.next     = invalid_index;
+  if (free_tail != invalid_index) {
+    entries[free_tail].next = idx;
+  } else {
+    free_head = idx;
+  }
+  free_tail = idx;
+  free_count++;
+}
+
+void ue_ip_pool::unlink_free(uint32_t idx)
+{
+  entry_t& e = entries[idx];
+  if (e.prev != invalid_index) {
+    entries[e.prev].next = e.next;
+  } else {
+    free_head = e.next;
+  }
+  if (e.next != invalid_index) {
+    entries[e.next].prev = e.prev;
+  } else {
+    free_tail = e.prev;
+  }
+  e.prev = invalid_index;
+  e.next = invalid_index;
+  free_count--;
+}
+
+} // namespace srsepc
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/paging_buffer.h"
+#include "srsran/common/test_common.h"
+#include <vector>
+
+using namespace srsepc;
+
+/// Size of the buffer that holds a packet of 1000 bytes, including its header
+uint32_t buffer_size = 0;
+
+srsran::unique_byte_buffer_t make_packet(uint8_t seq, uint32_t len)
+{
+  srsran::unique_byte_buffer_t pkt = srsran::make_byte_buffer();
+  for (uint32_t i = 0; i < len; ++i) {
+    pkt->msg[i] = seq;
+  }
+  pkt->N_bytes = len;
+  return pkt;
+}
+
+bool push_packet(paging_buffer_store& store, paging_buffer_store::queue_t& q, uint8_t seq, uint32_t len = 1000)
+{
+  srsran::unique_byte_buffer_t pkt = make_packet(seq, len);
+  return store.push(q, pkt->msg, pkt->N_bytes);
+}
+
+/// Pops a packet and checks its contents. Returns the sequence number of the packet.
+int pop_packet(paging_buffer_store& store, paging_buffer_store::queue_t& q, uint32_t len = 1000)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (not store.pop(q, *pdu)) {
+    return -1;
+  }
+  TESTASSERT(pdu->N_bytes == len);
+  for (uint32_t i = 0; i < len; ++i) {
+    TESTASSERT(pdu->msg[i] == pdu->msg[0]);
+  }
+  return pdu->msg[0];
+}
+
+int test_per_ue_limits()
+{
+  paging_buffer_store store;
+  store.init({4, 3 * buffer_size + 400, 100 * buffer_size, paging_drop_policy_t::drop_newest});
+  paging_buffer_store::queue_t q;
+
+  // Byte limit
+  TESTASSERT(push_packet(store, q, 1));
+  TESTASSERT(push_packet(store, q, 2));
+  TESTASSERT(push_packet(store, q, 3));
+  TESTASSERT(not push_packet(store, q, 4));
+  TESTASSERT(q.nof_pkts == 3 and q.nof_bytes == 3 * buffer_size);
+
+  // Packet limit, with smaller packets
+  TESTASSERT(push_packet(store, q, 5, 100));
+  TESTASSERT(not push_packet(store, q, 6, 100));
+
+  TESTASSERT(pop_packet(store, q) == 1);
+  TESTASSERT(pop_packet(store, q) == 2);
+  TESTASSERT(pop_packet(store, q) == 3);
+  TESTASSERT(pop_packet(store, q, 100) == 5);
+  TESTASSERT(pop_packet(store, q) == -1);
+  TESTASSERT(q.nof_pkts == 0 and q.nof_bytes == 0);
+
+  paging_buffer_metrics_t metrics = store.get_metrics();
+  TESTASSERT(metrics.nof_queued_pkts == 0);
+  TESTASSERT(metrics.bytes_in_use == 0);
+  TESTASSERT(metrics.nof_dropped_pkts == 2);
+  return SRSRAN_SUCCESS;
+}
+
+int test_global_limit()
+{
+  paging_buffer_store store;
+  store.init({100, 100 * buffer_size, 3 * buffer_size, paging_drop_policy_t::drop_newest});
+  paging_buffer_store::queue_t q1, q2;
+
+  TESTASSERT(push_packet(store, q1, 1));
+  TESTASSERT(push_packet(store, q2, 2));
+  TESTASSERT(push_packet(store, q2, 3));
+  TESTASSERT(not push_packet(store, q1, 4));
+  TESTASSERT(store.get_metrics().bytes_in_use == 3 * buffer_size);
+
+  // Freed buffers are reused without exceeding the global limit
+  TESTASSERT(store.clear(q2) == 2);
+  TESTASSERT(store.get_metrics().bytes_cached == 2 * buffer_size);
+  TESTASSERT(push_packet(store, q1, 5));
+  TESTASSERT(store.get_metrics().bytes_cached == buffer_size);
+  TESTASSERT(store.get_metrics().peak_bytes_in_use == 3 * buffer_size);
+
+  TESTASSERT(pop_packet(store, q1) == 1);
+  TESTASSERT(pop_packet(store, q1) == 5);
+  return SRSRAN_SUCCESS;
+}
+
+int test_global_limit_across_size_classes()
+{
+  paging_buffer_store store;
+  store.init({100, 100 * buffer_size, 3 * buffer_size, paging_drop_policy_t::drop_newest});
+  paging_buffer_store::queue_t q;
+
+  for (uint8_t seq = 1; seq <= 3; ++seq) {
+    TESTASSERT(push_packet(store, q, seq));
+  }
+  TESTASSERT(store.clear(q) == 3);
+  TESTASSERT(store.get_metrics().bytes_cached == 3 * buffer_size);
+
+  // Packets of another size class cannot reuse the cached buffers, which are released to stay within the limit
+  uint32_t nof_pushed = 0;
+  for (uint8_t seq = 1; push_packet(store, q, seq, 100); ++seq) {
+    paging_buffer_metrics_t metrics = store.get_metrics();
+    TESTASSERT(metrics.bytes_in_use + metrics.bytes_cached <= 3 * buffer_size);
+    nof_pushed++;
+  }
+  TESTASSERT(nof_pushed > 3);
+  TESTASSERT(store.get_metrics().bytes_cached < buffer_size);
+
+  for (uint8_t seq = 1; seq <= nof_pushed; ++seq) {
+    TESTASSERT(pop_packet(store, q, 100) == seq);
+  }
+  paging_buffer_metrics_t metrics = store.get_metrics();
+  TESTASSERT(metrics.bytes_in_use == 0 and metrics.bytes_cached <= 3 * buffer_size);
+  return SRSRAN_SUCCESS;
+}
+
+int test_drop_oldest()
+{
+  paging_buffer_store store;
+  store.init({3, 100 * buffer_size, 100 * buffer_size, paging_drop_policy_t::drop_oldest});
+  paging_buffer_store::queue_t q;
+
+  for (uint8_t seq = 1; seq <= 5; ++seq) {
+    TESTASSERT(push_packet(store, q, seq));
+  }
+  TESTASSERT(q.nof_pkts == 3);
+  TESTASSERT(pop_packet(store, q) == 3);
+  TESTASSERT(pop_packet(store, q) == 4);
+  TESTASSERT(pop_packet(store, q) == 5);
+  TESTASSERT(store.get_metrics().nof_dropped_pkts == 2);
+
+  // Packets bigger than any buffer are dropped
+  std::vector<uint8_t> big_pkt(16385);
+  TESTASSERT(not store.push(q, big_pkt.data(), big_pkt.size()));
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  {
+    paging_buffer_store store;
+    store.init({1, UINT32_MAX, UINT64_MAX, paging_drop_policy_t::drop_newest});
+    paging_buffer_store::queue_t q;
+    TESTASSERT(push_packet(store, q, 0));
+    buffer_size = store.get_metrics().bytes_in_use;
+    TESTASSERT(buffer_size >= 1000 and buffer_size < 1400);
+    store.clear(q);
+  }
+
+  TESTASSERT(test_per_ue_limits() == SRSRAN_SUCCESS);
+  TESTASSERT(test_global_limit() == SRSRAN_SUCCESS);
+  TESTASSERT(test_global_limit_across_size_classes() == SRSRAN_SUCCESS);
+  TESTASSERT(test_drop_oldest() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,312 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/spgw.h"
+#include "srsepc/hdr/spgw/spgw_tunnel_table.h"
+#include "srsepc/hdr/spgw/ue_ip_pool.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * SP-GW session benchmark. It runs attach/detach storms over the session state of the SP-GW GTP-C and measures the
+ * sessions per second, while a user-plane thread looks up the downlink tunnels concurrently. It compares:
+ * - the hashed session tables, the free-list UE IP pool and the epoch-published tunnel table
+ * - a reference with ordered maps, an ordered set as IP pool and a tunnel map shared with the user plane via a mutex
+ * Each session goes through Create Session, Modify Bearer, Release Access Bearers, Modify Bearer and Delete Session.
+ *
+ * Usage: spgw_session_benchmark [test|benchmark]
+ */
+
+namespace srsepc {
+
+using bench_clock = std::chrono::steady_clock;
+
+const uint32_t  nof_pool_addrs = 65000;
+const in_addr_t first_ue_addr  = htonl(0x0a000001); // 10.0.0.1
+
+struct session_store {
+  virtual ~session_store()                                           = default;
+  virtual bool create(uint64_t imsi, uint32_t ctrl_teid)             = 0;
+  virtual void modify(uint32_t ctrl_teid, srsran::gtp_fteid_t fteid) = 0;
+  virtual void release(uint32_t ctrl_teid)                           = 0;
+  virtual void remove(uint32_t ctrl_teid)                            = 0;
+  /// Lookup of the user plane. Returns whether the packet has a tunnel
+  virtual bool lookup(in_addr_t ue_ipv4) = 0;
+};
+
+/// Session state as kept by the SP-GW GTP-C and GTP-U
+class hashed_session_store : public session_store
+{
+public:
+  hashed_session_store() { pool.init(first_ue_addr, nof_pool_addrs); }
+  ~hashed_session_store()
+  {
+    for (auto& it : teid_to_ctx) {
+      delete it.second;
+    }
+  }
+
+  bool create(uint64_t imsi, uint32_t ctrl_teid) override
+  {
+    in_addr_t ue_ipv4 = pool.allocate();
+    if (ue_ipv4 == INADDR_ANY) {
+      return false;
+    }
+    spgw_tunnel_ctx_t* ctx = new spgw_tunnel_ctx_t{};
+    ctx->imsi               = imsi;
+    ctx->ue_ipv4            = ue_ipv4;
+    ctx->up_ctrl_fteid.teid = ctrl_teid;
+    teid_to_ctx.emplace(ctrl_teid, ctx);
+    imsi_to_teid.emplace(imsi, ctrl_teid);
+    return true;
+  }
+  void modify(uint32_t ctrl_teid, srsran::gtp_fteid_t fteid) override
+  {
+    spgw_tunnel_ctx_t* ctx = teid_to_ctx.at(ctrl_teid);
+    ctx->dw_user_fteid     = fteid;
+    tunnels.set_tunnel(ctx->ue_ipv4, fteid, ctrl_teid);
+  }
+  void release(uint32_t ctrl_teid) override { tunnels.remove_user_tunnel(teid_to_ctx.at(ctrl_teid)->ue_ipv4); }
+  void remove(uint32_t ctrl_teid) override
+  {
+    auto               it  = teid_to_ctx.find(ctrl_teid);
+    spgw_tunnel_ctx_t* ctx = it->second;
+    tunnels.remove_user_tunnel(ctx->ue_ipv4);
+    tunnels.remove_ctrl_tunnel(ctx->ue_ipv4);
+    pool.release(ctx->ue_ipv4);
+    imsi_to_teid.erase(ctx->imsi);
+    teid_to_ctx.erase(it);
+    delete ctx;
+  }
+  bool lookup(in_addr_t ue_ipv4) override
+  {
+    srsran::epoch_read_guard    guard;
+    spgw_tunnel_table::tunnel_t tunnel;
+    return tunnels.find(ue_ipv4, tunnel) and tunnel.user_present;
+  }
+
+private:
+  std::unordered_map<uint64_t, uint32_t>           imsi_to_teid;
+  std::unordered_map<uint32_t, spgw_tunnel_ctx_t*> teid_to_ctx;
+  ue_ip_pool                                       pool;
+  spgw_tunnel_table                                tunnels{16};
+};
+
+/// Reference with the ordered containers of the previous SP-GW, where the tunnel maps are shared under a mutex
+class reference_session_store : public session_store
+{
+public:
+  reference_session_store()
+  {
+    for (uint32_t i = 0; i < nof_pool_addrs; ++i) {
+      pool.insert(htonl(ntohl(first_ue_addr) + i));
+    }
+  }
+  ~reference_session_store()
+  {
+    for (auto& it : teid_to_ctx) {
+      delete it.second;
+    }
+  }
+
+  bool create(uint64_t imsi, uint32_t ctrl_teid) override
+  {
+    if (pool.empty()) {
+      return false;
+    }
+    spgw_tunnel_ctx_t* ctx = new spgw_tunnel_ctx_t{};
+    ctx->imsi               = imsi;
+    ctx->ue_ipv4            = *pool.begin();
+    ctx->up_ctrl_fteid.teid = ctrl_teid;
+    pool.erase(pool.begin());
+    teid_to_ctx.emplace(ctrl_teid, ctx);
+    imsi_to_teid.emplace(imsi, ctrl_teid);
+    return true;
+  }
+  void modify(uint32_t ctrl_teid, srsran::gtp_fteid_t fteid) override
+  {
+    spgw_tunnel_ctx_t* ctx = teid_to_ctx.at(ctrl_teid);
+    ctx->dw_user_fteid     = fteid;
+    std::lock_guard<std::mutex> lock(mutex);
+    ip_to_usr_teid[ctx->ue_ipv4] = fteid;
+    ip_to_ctr_teid[ctx->ue_ipv4] = ctrl_teid;
+  }
+  void release(uint32_t ctrl_teid) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ip_to_usr_teid.erase(teid_to_ctx.at(ctrl_teid)->ue_ipv4);
+  }
+  void remove(uint32_t ctrl_teid) override
+  {
+    auto               it  = teid_to_ctx.find(ctrl_teid);
+    spgw_tunnel_ctx_t* ctx = it->second;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ip_to_usr_teid.erase(ctx->ue_ipv4);
+      ip_to_ctr_teid.erase(ctx->ue_ipv4);
+    }
+    pool.insert(ctx->ue_ipv4);
+    imsi_to_teid.erase(ctx->imsi);
+    teid_to_ctx.erase(it);
+    delete ctx;
+  }
+  bool lookup(in_addr_t ue_ipv4) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return ip_to_usr_teid.count(ue_ipv4) > 0 and ip_to_ctr_teid.count(ue_ipv4) > 0;
+  }
+
+private:
+  std::map<uint64_t, uint32_t>             imsi_to_teid;
+  std::map<uint32_t, spgw_tunnel_ctx_t*>   teid_to_ctx;
+  std::set<uint32_t>                       pool;
+  std::mutex                               mutex;
+  std::map<in_addr_t, srsran::gtp_fteid_t> ip_to_usr_teid;
+  std::map<in_addr_t, uint32_t>            ip_to_ctr_teid;
+};
+
+struct run_params {
+  uint32_t nof_active_ues; ///< number of attached UEs kept during the storm
+  uint32_t nof_sessions;   ///< number of sessions created and deleted
+  bool     user_plane;     ///< whether the user-plane thread looks up tunnels concurrently
+};
+
+struct run_data {
+  run_params params;
+  bool       hashed;
+  double     sessions_per_sec;
+  double     lookups_per_sec;
+};
+
+/// Keeps nof_active_ues attached, while the oldest UEs detach to make room for new ones
+run_data run_storm(session_store& store, const run_params& params)
+{
+  run_data r = {};
+  r.params   = params;
+
+  std::atomic<bool>     running{true};
+  std::atomic<uint64_t> nof_lookups{0};
+  std::thread           up_thread;
+  if (params.user_plane) {
+    up_thread = std::thread([&store, &running, &nof_lookups, &params]() {
+      uint64_t count = 0;
+      uint32_t idx   = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        idx = (idx * 1103515245 + 12345) % params.nof_active_ues;
+        store.lookup(htonl(ntohl(first_ue_addr) + idx));
+        count++;
+      }
+      nof_lookups = count;
+    });
+  }
+
+  std::deque<uint32_t>    active;
+  srsran::gtp_fteid_t     enb_fteid = {};
+  uint32_t                next_teid = 1;
+  bench_clock::time_point tic       = bench_clock::now();
+  for (uint32_t i = 0; i < params.nof_sessions; ++i) {
+    if (active.size() == params.nof_active_ues) {
+      store.remove(active.front());
+      active.pop_front();
+    }
+    uint32_t ctrl_teid = next_teid++;
+    bool     created   = store.create(1010123456789ULL + i, ctrl_teid);
+    TESTASSERT(created);
+    enb_fteid.teid = ctrl_teid;
+    store.modify(ctrl_teid, enb_fteid);
+    store.release(ctrl_teid);
+    store.modify(ctrl_teid, enb_fteid);
+    active.push_back(ctrl_teid);
+  }
+  while (not active.empty()) {
+    store.remove(active.front());
+    active.pop_front();
+  }
+  std::chrono::duration<double> elapsed = bench_clock::now() - tic;
+
+  running = false;
+  if (up_thread.joinable()) {
+    up_thread.join();
+  }
+  r.sessions_per_sec = params.nof_sessions / elapsed.count();
+  r.lookups_per_sec  = nof_lookups / elapsed.count();
+  return r;
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  fmt::print("run | tables    | active UEs | sessions | user plane | sessions/s | lookups/s\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data& r = run_results[i];
+    fmt::print("{:>3d} | {:<9} | {:>10d} | {:>8d} | {:>10} | {:>10.0f} | {:>9.0f}\n",
+               i,
+               r.hashed ? "hashed" : "reference",
+               r.params.nof_active_ues,
+               r.params.nof_sessions,
+               r.params.user_plane ? "yes" : "no",
+               r.sessions_per_sec,
+               r.lookups_per_sec);
+  }
+}
+
+int run_all(uint32_t nof_sessions)
+{
+  std::vector<run_data> run_results;
+  for (uint32_t nof_active_ues : {250, 10000, 60000}) {
+    for (bool user_plane : {false, true}) {
+      run_params params = {nof_active_ues, nof_sessions, user_plane};
+      {
+        reference_session_store store;
+        run_results.push_back(run_storm(store, params));
+        run_results.back().hashed = false;
+      }
+      {
+        hashed_session_store store;
+        run_results.push_back(run_storm(store, params));
+        run_results.back().hashed = true;
+      }
+    }
+  }
+  print_benchmark_results(run_results);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsepc
+
+int main(int argc, char* argv[])
+{
+  srslog::init();
+
+  if (argc == 1 or strcmp(argv[1], "test") == 0) {
+    TESTASSERT(srsepc::run_all(20000) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark") == 0) {
+    TESTASSERT(srsepc::run_all(1000000) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
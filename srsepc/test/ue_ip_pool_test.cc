@@ -0,0 +1,101 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/ue_ip_pool.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+
+using namespace srsepc;
+
+in_addr_t make_addr(uint32_t host_addr)
+{
+  return htonl(host_addr);
+}
+
+int test_allocate_release()
+{
+  const uint32_t first = 0xac100002; // 172.16.0.2
+  ue_ip_pool     pool;
+  pool.init(make_addr(first), 4);
+  TESTASSERT(pool.size() == 4);
+  TESTASSERT(pool.nof_free() == 4);
+
+  // Addresses are handed out in ascending order
+  for (uint32_t i = 0; i < 4; ++i) {
+    in_addr_t addr = pool.allocate();
+    TESTASSERT(addr == make_addr(first + i));
+  }
+  TESTASSERT(pool.nof_free() == 0);
+  TESTASSERT(pool.allocate() == INADDR_ANY);
+
+  // Released addresses are reused in release order
+  TESTASSERT(pool.release(make_addr(first + 2)));
+  TESTASSERT(pool.release(make_addr(first)));
+  TESTASSERT(not pool.release(make_addr(first))); // double release
+  TESTASSERT(not pool.release(make_addr(first + 4))); // outside of the pool
+  TESTASSERT(not pool.release(make_addr(first - 1)));
+  TESTASSERT(pool.nof_free() == 2);
+  in_addr_t addr = pool.allocate();
+  TESTASSERT(addr == make_addr(first + 2));
+  addr = pool.allocate();
+  TESTASSERT(addr == make_addr(first));
+  TESTASSERT(pool.nof_free() == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int test_reserve()
+{
+  const uint32_t first = 0xac100002;
+  ue_ip_pool     pool;
+  pool.init(make_addr(first), 4);
+
+  // Reserved addresses are never allocated nor released into the pool
+  TESTASSERT(pool.reserve(make_addr(first + 1)));
+  TESTASSERT(not pool.reserve(make_addr(first + 1)));
+  TESTASSERT(not pool.reserve(make_addr(first + 4)));
+  TESTASSERT(pool.nof_free() == 3);
+  in_addr_t addr = pool.allocate();
+  TESTASSERT(addr == make_addr(first));
+  addr = pool.allocate();
+  TESTASSERT(addr == make_addr(first + 2));
+  TESTASSERT(not pool.release(make_addr(first + 1)));
+
+  // An allocated address can also be reserved
+  TESTASSERT(pool.reserve(make_addr(first)));
+  TESTASSERT(not pool.release(make_addr(first)));
+  TESTASSERT(pool.nof_free() == 1);
+  addr = pool.allocate();
+  TESTASSERT(addr == make_addr(first + 3));
+  TESTASSERT(pool.allocate() == INADDR_ANY);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_allocate_release() == SRSRAN_SUCCESS);
+  TESTASSERT(test_reserve() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -58,6 +58,7 @@ class gnb_stack_nr final : public srsenb::enb_stack_base,
                            public srsue::stack_interface_gw,
                            public rrc_nr_interface_rrc,
                            public pdcp_interface_gtpu, // for user-plane over X2
+                           public pdcp_interface_rlc,  // for the EUTRA RLC legs of split bearers
                            public srsran::thread
 {
 public:
@@ -125,6 +126,36 @@ public:
     // TODO: make it thread-safe. For now, this function is unused
     return pdcp.get_buffered_pdus(rnti, lcid);
   }
+  // X2 split bearer interface
+  void add_split_bearer_leg(uint16_t                               rnti,
+                            uint32_t                               lcid,
+                            rlc_interface_pdcp*                    leg_rlc,
+                            uint16_t                               leg_rnti,
+                            uint32_t                               leg_lcid,
+                            const srsran::pdcp_split_bearer_cfg_t& split_cfg)
+  {
+    x2_task_queue.push([this, rnti, lcid, leg_rlc, leg_rnti, leg_lcid, split_cfg]() {
+      pdcp.add_split_bearer_leg(rnti, lcid, leg_rlc, leg_rnti, leg_lcid, split_cfg);
+    });
+  }
+  void del_split_bearer_leg(uint16_t rnti, uint32_t lcid)
+  {
+    x2_task_queue.push([this, rnti, lcid]() { pdcp.del_split_bearer_leg(rnti, lcid); });
+  }
+  // pdcp_interface_rlc, called by the EUTRA PDCP for the EUTRA RLC legs of split bearers
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) final
+  {
+    auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) { pdcp.write_pdu(rnti, lcid, std::move(pdu)); };
+    x2_task_queue.push(std::bind(task, std::move(pdu)));
+  }
+  void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) final
+  {
+    x2_task_queue.push([this, rnti, lcid, pdcp_sns]() { pdcp.notify_delivery(rnti, lcid, pdcp_sns); });
+  }
+  void notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) final
+  {
+    x2_task_queue.push([this, rnti, lcid, pdcp_sns]() { pdcp.notify_failure(rnti, lcid, pdcp_sns); });
+  }
 
 private:
   void run_thread() final;
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_FEEDBACK_H
+#define SRSRAN_SCHED_NR_FEEDBACK_H
+
+#include "srsran/adt/spsc_ring.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Feedback reported by the PHY for one UE, i.e. the HARQ feedback of one carrier or an SR
+struct ue_feedback_t {
+  enum class type_t : uint8_t { dl_ack, ul_crc, ul_sr };
+  uint16_t rnti;
+  type_t   type;
+  uint8_t  pid;
+  uint8_t  tb_idx;
+  bool     ok;
+};
+
+/**
+ * Queue of UE feedback with one SPSC ring per PHY worker thread
+ * - A producer thread claims a ring the first time it pushes, and keeps it for the lifetime of the queue
+ * - The scheduler drains all the rings in bulk at the start of the slot processing
+ * - When the ring of a producer is full, the feedback is stored in a locked overflow list attached to that ring. The
+ *   producer keeps using the overflow list until the scheduler drains it, right after the ring. Thus, the feedback of
+ *   each producer is always popped in push order
+ * - When all rings are claimed by other threads, push() fails and the caller must fall back to a locked path. Such a
+ *   producer never gets a ring, so all its feedback goes through the locked path, also in push order
+ */
+class ue_feedback_queue
+{
+public:
+  static constexpr size_t MAX_PRODUCERS = 8;
+  static constexpr size_t RING_SIZE     = 1024;
+
+  /// Called by the PHY workers. Returns false if the calling thread has no ring
+  bool push(const ue_feedback_t& fb);
+
+  /// Called by the scheduler. Passes all the enqueued feedback to "f", in order for each producer
+  /// @return number of popped elements
+  template <typename F>
+  size_t pop_all(F&& f)
+  {
+    size_t   count         = 0;
+    uint32_t nof_producers = std::min(nof_claimed.load(std::memory_order_acquire), (uint32_t)MAX_PRODUCERS);
+    for (uint32_t i = 0; i < nof_producers; ++i) {
+      producer_ring& r = rings[i];
+      count += r.ring.pop_all(f);
+      if (r.overflow_pending.load(std::memory_order_acquire)) {
+        {
+          std::lock_guard<std::mutex> lock(r.overflow_mutex);
+          r.overflow.swap(r.overflow_drain);
+          r.overflow_pending.store(false, std::memory_order_release);
+        }
+        for (const ue_feedback_t& fb : r.overflow_drain) {
+          f(fb);
+        }
+        count += r.overflow_drain.size();
+        r.overflow_drain.clear();
+      }
+    }
+    return count;
+  }
+
+private:
+  struct producer_ring {
+    std::atomic<uint32_t>                       owner{0};
+    srsran::spsc_ring<ue_feedback_t, RING_SIZE> ring;
+    std::atomic<bool>                           overflow_pending{false};
+    std::mutex                                  overflow_mutex;
+    std::vector<ue_feedback_t>                  overflow, overflow_drain;
+  };
+
+  producer_ring* get_producer_ring();
+
+  std::atomic<uint32_t>                    nof_claimed{0};
+  std::array<producer_ring, MAX_PRODUCERS> rings;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_FEEDBACK_H
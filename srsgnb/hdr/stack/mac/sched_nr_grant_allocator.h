@@ -82,6 +82,9 @@ struct bwp_res_grid {
 
   const bwp_params_t* cfg = nullptr;
 
+  /// PDSCH TBS tables used to select the MCS of the BWP grants
+  std::unique_ptr<pdsch_tbs_table_cache> pdsch_tbs_tables;
+
 private:
   // TTIMOD_SZ is the longest allocation in the future
   srsran::bounded_vector<bwp_slot_grid, TTIMOD_SZ> slots;
@@ -128,6 +131,14 @@ public:
 private:
   alloc_result verify_uci_space(const bwp_slot_grid& uci_grid) const;
 
+  /// Sets the UCI slot of a PDSCH grant to the UL slot, among the ones reachable with the UE k1 candidates, with the
+  /// fewest pending HARQ-ACKs. Ties are resolved in favour of the smallest k1
+  void select_uci_slot(slot_ue& ue) const;
+  /// Sets the PUSCH slot of a grant to the UL slot, among the ones reachable with the PUSCH time-domain allocations of
+  /// the BWP, where the grant fits and fewest PRBs are occupied. Returns the index of the time-domain allocation, or
+  /// -1 if the grant does not fit in any of the slots
+  int select_pusch_slot(slot_ue& ue, srsran_search_space_type_t ss_type, const prb_grant& grant) const;
+
   bwp_res_grid& bwp_grid;
 
   slot_point     pdcch_slot;
@@ -57,6 +57,25 @@ inline bool is_rnti_type_valid_in_search_space(srsran_rnti_type_t rnti_type, srs
   return false;
 }
 
+/// Cache of PDSCH TBS tables, one per combination of MCS table, RE per PRB and nof layers in use in a BWP
+class pdsch_tbs_table_cache
+{
+public:
+  explicit pdsch_tbs_table_cache(uint32_t nof_prb);
+  ~pdsch_tbs_table_cache();
+  pdsch_tbs_table_cache(const pdsch_tbs_table_cache&) = delete;
+  pdsch_tbs_table_cache& operator=(const pdsch_tbs_table_cache&) = delete;
+
+  /// Gets the TBS table matching the PDSCH config, computing it if it is not cached. Returns nullptr on failure
+  const srsran_ra_nr_tbs_table_t* get(const srsran_sch_cfg_nr_t& sch_cfg);
+
+private:
+  static const uint32_t max_nof_tables = 4;
+
+  std::array<srsran_ra_nr_tbs_table_t, max_nof_tables> tables     = {};
+  uint32_t                                             next_table = 0;
+};
+
 /// Log UE state for slot being scheduled
 void log_sched_slot_ues(srslog::basic_logger& logger,
                         slot_point            pdcch_slot,
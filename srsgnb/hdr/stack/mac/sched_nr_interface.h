@@ -122,6 +122,9 @@ public:
     bool        auto_refill_buffer = false;
     int         fixed_dl_mcs       = 28;
     int         fixed_ul_mcs       = 28;
+    /// Select the k1/k2 of each grant looking at the UCI/PUSCH load of the upcoming UL slots of the TDD pattern,
+    /// instead of using the fixed dl-DataToUL-ACK entry of the slot and the first PUSCH time-domain allocation
+    bool        lookahead_k1_k2    = false;
     std::string logger_name        = "MAC-NR";
   };
 
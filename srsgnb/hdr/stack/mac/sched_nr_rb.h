@@ -255,16 +255,22 @@ find_next_empty_interval(const prb_bitmap& mask, size_t start_prb_idx = 0, size_
 
 inline prb_interval find_empty_interval_of_length(const prb_bitmap& mask, size_t nof_prbs, uint32_t start_prb_idx = 0)
 {
+  if (start_prb_idx >= mask.size()) {
+    return {};
+  }
+  // Common case, where an interval of the requested length is available
+  int rb_start = mask.find_lowest_run(start_prb_idx, mask.size(), nof_prbs, false);
+  if (rb_start >= 0) {
+    return {(uint32_t)rb_start, (uint32_t)(rb_start + nof_prbs)};
+  }
+
+  // Otherwise, search for the largest empty interval
   prb_interval max_interv;
   do {
     prb_interval interv = find_next_empty_interval(mask, start_prb_idx, mask.size());
     if (interv.empty()) {
       break;
     }
-    if (interv.length() >= nof_prbs) {
-      max_interv.set(interv.start(), interv.start() + nof_prbs);
-      break;
-    }
     if (interv.length() > max_interv.length()) {
       max_interv = interv;
     }
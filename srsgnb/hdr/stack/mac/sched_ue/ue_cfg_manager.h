@@ -84,6 +84,9 @@ public:
     }
     return phy().harq_ack.dl_data_to_ul_ack[pdsch_slot.to_uint() % phy().harq_ack.nof_dl_data_to_ul_ack];
   }
+  /// Distinct values of dl-DataToUL-ACK that can be signalled in a DCI format 1_0, in increasing order
+  srsran::const_span<uint32_t> k1_candidates() const { return k1_list; }
+
   int fixed_pdsch_mcs() const { return bwp_cfg->sched_cfg.fixed_dl_mcs; }
   int fixed_pusch_mcs() const { return bwp_cfg->sched_cfg.fixed_ul_mcs; }
 
@@ -96,9 +99,10 @@ private:
   const bwp_params_t*   bwp_cfg = nullptr;
 
   // derived
-  std::vector<bwp_cce_pos_list>                              cce_positions_list;
-  std::array<uint32_t, SRSRAN_UE_DL_NR_MAX_NOF_SEARCH_SPACE> ss_id_to_cce_idx;
-  srsran_dci_cfg_nr_t                                        cached_dci_cfg;
+  std::vector<bwp_cce_pos_list>                                  cce_positions_list;
+  std::array<uint32_t, SRSRAN_UE_DL_NR_MAX_NOF_SEARCH_SPACE>     ss_id_to_cce_idx;
+  srsran_dci_cfg_nr_t                                            cached_dci_cfg;
+  srsran::bounded_vector<uint32_t, SRSRAN_MAX_NOF_DL_DATA_TO_UL> k1_list;
 };
 
 } // namespace sched_nr_impl
@@ -23,6 +23,7 @@
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsgnb/hdr/stack/mac/harq_softbuffer.h"
 #include "srsgnb/hdr/stack/mac/sched_nr_bwp.h"
+#include "srsgnb/hdr/stack/mac/sched_nr_feedback.h"
 #include "srsgnb/hdr/stack/mac/sched_nr_worker.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/string_helpers.h"
@@ -110,6 +111,30 @@ public:
     carriers[cc].next_slot_ue_events.emplace_back(rnti, cc, event_name, std::move(callback));
   }
 
+  /// Enqueue HARQ feedback directed at a given UE in a given cell, without locking
+  void enqueue_harq_feedback(uint32_t cc, const ue_feedback_t& fb)
+  {
+    srsran_assert(fb.rnti != SRSRAN_INVALID_RNTI, "Invalid rnti=0x%x passed to event manager", fb.rnti);
+    srsran_assert(cc < carriers.size(), "Invalid cc=%d passed to event manager", cc);
+    if (not carriers[cc].harq_feedback.push(fb)) {
+      // No ring available for the calling thread. Use the locked path
+      enqueue_ue_cc_feedback(get_event_name(fb), fb.rnti, cc, [fb](ue_carrier& ue_cc, logger& ev_logger) {
+        process_harq_feedback(ue_cc, fb, ev_logger);
+      });
+    }
+  }
+
+  /// Enqueue an SR of a given UE, without locking
+  void enqueue_sr(uint16_t rnti)
+  {
+    srsran_assert(rnti != SRSRAN_INVALID_RNTI, "Invalid rnti=0x%x passed to common event manager", rnti);
+    ue_feedback_t fb = {rnti, ue_feedback_t::type_t::ul_sr, 0, 0, true};
+    if (not sr_feedback.push(fb)) {
+      // No ring available for the calling thread. Use the locked path
+      enqueue_ue_event(get_event_name(fb), rnti, [](ue& u, logger& ev_logger) { process_sr(u, ev_logger); });
+    }
+  }
+
   /// Process all events that are not specific to a carrier or that are directed at CA-enabled UEs
   /// Note: non-CA UEs are updated later in get_dl_sched, to leverage parallelism
   void process_common(ue_map_t& ues)
@@ -141,6 +166,16 @@ public:
         ev.rnti = SRSRAN_INVALID_RNTI;
       }
     }
+
+    // SRs are drained in bulk from the PHY worker rings. As the carrier workers do not run during slot_indication(),
+    // the SRs of non-CA UEs are also processed here
+    sr_feedback.pop_all([this, &ues, &evlogger](const ue_feedback_t& fb) {
+      if (ues.contains(fb.rnti)) {
+        process_sr(*ues[fb.rnti], evlogger);
+      } else {
+        sched_logger.warning("SCHED: \"%s\" called for unknown rnti=0x%x.", get_event_name(fb), fb.rnti);
+      }
+    });
   }
 
   /// Process events synchronized during slot_indication() that are directed at non CA-enabled UEs
@@ -177,9 +212,56 @@ public:
         sched_logger.warning("SCHED: \"%s\" called for unknown rnti=0x%x,cc=%d.", ev.event_name, ev.rnti, ev.cc);
       }
     }
+
+    // HARQ feedback is drained in bulk from the PHY worker rings. The feedback of a UE usually comes in consecutive
+    // entries, so the UE carrier is only looked up in the RNTI map when the RNTI changes
+    uint16_t    last_rnti = SRSRAN_INVALID_RNTI;
+    ue_carrier* ue_cc     = nullptr;
+    carriers[cc].harq_feedback.pop_all([&](const ue_feedback_t& fb) {
+      if (fb.rnti != last_rnti) {
+        last_rnti = fb.rnti;
+        ue_cc     = ues.contains(fb.rnti) ? ues[fb.rnti]->carriers[cc].get() : nullptr;
+      }
+      if (ue_cc != nullptr) {
+        process_harq_feedback(*ue_cc, fb, evlogger);
+      } else {
+        sched_logger.warning("SCHED: \"%s\" called for unknown rnti=0x%x,cc=%d.", get_event_name(fb), fb.rnti, cc);
+      }
+    });
   }
 
 private:
+  static const char* get_event_name(const ue_feedback_t& fb)
+  {
+    switch (fb.type) {
+      case ue_feedback_t::type_t::dl_ack:
+        return "dl_ack_info";
+      case ue_feedback_t::type_t::ul_crc:
+        return "ul_crc_info";
+      default:
+        return "ul_sr_info";
+    }
+  }
+
+  static void process_sr(ue& u, logger& ev_logger)
+  {
+    u.ul_sr_info();
+    ev_logger.push("0x{:x}: ul_sr_info()", u.rnti);
+  }
+
+  static void process_harq_feedback(ue_carrier& ue_cc, const ue_feedback_t& fb, logger& ev_logger)
+  {
+    if (fb.type == ue_feedback_t::type_t::dl_ack) {
+      if (ue_cc.dl_ack_info(fb.pid, fb.tb_idx, fb.ok) >= 0) {
+        ev_logger.push("0x{:x}: dl_ack_info(pid={}, ack={})", ue_cc.rnti, fb.pid, fb.ok ? "OK" : "KO");
+      }
+    } else {
+      if (ue_cc.ul_crc_info(fb.pid, fb.ok) >= 0) {
+        ev_logger.push("0x{:x}: ul_crc_info(pid={}, crc={})", ue_cc.rnti, fb.pid, fb.ok ? "OK" : "KO");
+      }
+    }
+  }
+
   struct event_t {
     const char*                          event_name;
     srsran::move_callback<void(logger&)> callback;
@@ -213,9 +295,11 @@ private:
   std::mutex                event_mutex;
   srsran::deque<event_t>    next_slot_events, current_slot_events;
   srsran::deque<ue_event_t> next_slot_ue_events, current_slot_ue_events;
+  ue_feedback_queue         sr_feedback;
   struct cc_events {
     std::mutex                   event_cc_mutex;
     srsran::deque<ue_cc_event_t> next_slot_ue_events, current_slot_ue_events;
+    ue_feedback_queue            harq_feedback;
   };
   std::vector<cc_events> carriers;
 };
@@ -451,30 +535,19 @@ int sched_nr::dl_rach_info(const rar_info_t& rar_info)
 
 void sched_nr::dl_ack_info(uint16_t rnti, uint32_t cc, uint32_t pid, uint32_t tb_idx, bool ack)
 {
-  auto callback = [pid, tb_idx, ack](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
-    if (ue_cc.dl_ack_info(pid, tb_idx, ack) >= 0) {
-      ev_logger.push("0x{:x}: dl_ack_info(pid={}, ack={})", ue_cc.rnti, pid, ack ? "OK" : "KO");
-    }
-  };
-  pending_events->enqueue_ue_cc_feedback("dl_ack_info", rnti, cc, callback);
+  ue_feedback_t fb = {rnti, ue_feedback_t::type_t::dl_ack, (uint8_t)pid, (uint8_t)tb_idx, ack};
+  pending_events->enqueue_harq_feedback(cc, fb);
 }
 
 void sched_nr::ul_crc_info(uint16_t rnti, uint32_t cc, uint32_t pid, bool crc)
 {
-  auto callback = [pid, crc](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
-    if (ue_cc.ul_crc_info(pid, crc) >= 0) {
-      ev_logger.push("0x{:x}: ul_crc_info(pid={}, crc={})", ue_cc.rnti, pid, crc ? "OK" : "KO");
-    }
-  };
-  pending_events->enqueue_ue_cc_feedback("ul_crc_info", rnti, cc, callback);
+  ue_feedback_t fb = {rnti, ue_feedback_t::type_t::ul_crc, (uint8_t)pid, 0, crc};
+  pending_events->enqueue_harq_feedback(cc, fb);
 }
 
 void sched_nr::ul_sr_info(uint16_t rnti)
 {
-  pending_events->enqueue_ue_event("ul_sr_info", rnti, [](ue& u, event_manager::logger& evlogger) {
-    u.ul_sr_info();
-    evlogger.push("0x{:x}: ul_sr_info()", u.rnti);
-  });
+  pending_events->enqueue_sr(rnti);
 }
 
 void sched_nr::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
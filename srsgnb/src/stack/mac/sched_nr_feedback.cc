@@ -0,0 +1,88 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_feedback.h"
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Identifier of the calling thread, unique for the lifetime of the process. 0 marks a free ring
+static uint32_t get_thread_token()
+{
+  static std::atomic<uint32_t> next_token{1};
+  thread_local uint32_t        token = next_token.fetch_add(1, std::memory_order_relaxed);
+  return token;
+}
+
+ue_feedback_queue::producer_ring* ue_feedback_queue::get_producer_ring()
+{
+  uint32_t token = get_thread_token();
+
+  // Fast path. Ring of the last queue this thread pushed to
+  thread_local const ue_feedback_queue* last_queue = nullptr;
+  thread_local uint32_t                 last_idx   = 0;
+  if (last_queue == this and rings[last_idx].owner.load(std::memory_order_relaxed) == token) {
+    return &rings[last_idx];
+  }
+
+  // Search for a ring already claimed by this thread
+  uint32_t nof_producers = std::min(nof_claimed.load(std::memory_order_acquire), (uint32_t)MAX_PRODUCERS);
+  for (uint32_t i = 0; i < nof_producers; ++i) {
+    if (rings[i].owner.load(std::memory_order_relaxed) == token) {
+      last_queue = this;
+      last_idx   = i;
+      return &rings[i];
+    }
+  }
+
+  // Claim a new ring
+  if (nof_producers == MAX_PRODUCERS) {
+    return nullptr;
+  }
+  uint32_t idx = nof_claimed.fetch_add(1, std::memory_order_acq_rel);
+  if (idx >= MAX_PRODUCERS) {
+    return nullptr;
+  }
+  rings[idx].owner.store(token, std::memory_order_relaxed);
+  last_queue = this;
+  last_idx   = idx;
+  return &rings[idx];
+}
+
+bool ue_feedback_queue::push(const ue_feedback_t& fb)
+{
+  producer_ring* r = get_producer_ring();
+  if (r == nullptr) {
+    return false;
+  }
+
+  // The ring is only used again once the consumer has drained the overflow list, which keeps the push order
+  if (not r->overflow_pending.load(std::memory_order_acquire) and r->ring.try_push(fb)) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(r->overflow_mutex);
+  r->overflow.push_back(fb);
+  r->overflow_pending.store(true, std::memory_order_release);
+  return true;
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
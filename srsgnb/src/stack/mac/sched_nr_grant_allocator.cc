@@ -23,6 +23,7 @@
 #include "srsgnb/hdr/stack/mac/sched_nr_bwp.h"
 #include "srsgnb/hdr/stack/mac/sched_nr_helpers.h"
 #include "srsran/mac/mac_sch_pdu_nr.h"
+#include <limits>
 
 namespace srsenb {
 namespace sched_nr_impl {
@@ -108,7 +109,8 @@ void bwp_slot_grid::reset()
   pending_acks.clear();
 }
 
-bwp_res_grid::bwp_res_grid(const bwp_params_t& bwp_cfg_) : cfg(&bwp_cfg_)
+bwp_res_grid::bwp_res_grid(const bwp_params_t& bwp_cfg_) :
+  cfg(&bwp_cfg_), pdsch_tbs_tables(new pdsch_tbs_table_cache(bwp_cfg_.cfg.rb_width))
 {
   for (uint32_t sl = 0; sl < slots.capacity(); ++sl) {
     slots.emplace_back(*cfg, sl % static_cast<uint32_t>(SRSRAN_NSLOTS_PER_FRAME_NR(bwp_cfg_.cell_cfg.carrier.scs)));
@@ -292,6 +294,10 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   static const srsran_dci_format_nr_t dci_fmt   = srsran_dci_format_nr_1_0;
   static const srsran_rnti_type_t     rnti_type = srsran_rnti_type_c;
 
+  if (cfg.sched_cfg.lookahead_k1_k2) {
+    select_uci_slot(ue);
+  }
+
   bwp_slot_grid& bwp_pdcch_slot = bwp_grid[ue.pdcch_slot];
   bwp_slot_grid& bwp_pdsch_slot = bwp_grid[ue.pdsch_slot];
   bwp_slot_grid& bwp_uci_slot   = bwp_grid[ue.uci_slot]; // UCI : UL control info
@@ -370,8 +376,9 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   srsran_slot_cfg_t slot_cfg;
   slot_cfg.idx = ue.pdsch_slot.to_uint();
   // Value 0.95 is from TS 38.214 v15.14.00, Section 5.1.3, page 17
-  const static float max_R = 0.95;
-  double             R_prime;
+  const static float max_R        = 0.95;
+  double             R_prime      = 0;
+  bool               ccch_pending = ue.get_pending_bytes(srsran::mac_sch_subpdu_nr::nr_lcid_sch_t::CCCH) > 0;
   // The purpose of the internal loop is to decrease the MCS if the effective coderate is too high. This loop
   // only affects the high MCS values
   while (true) {
@@ -382,12 +389,17 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
       srsran_assert(pdsch.sch.grant.tb[0].tbs == (int)ue.h_dl->tbs(), "The TBS did not remain constant in retx");
     }
     R_prime = pdsch.sch.grant.tb[0].R_prime;
-    if (ue.h_dl->nof_retx() > 0 or R_prime < max_R or mcs <= 0 or
-        (ue.get_pending_bytes(srsran::mac_sch_subpdu_nr::nr_lcid_sch_t::CCCH) and mcs <= min_MCS_ccch)) {
+    if (ue.h_dl->nof_retx() > 0 or R_prime < max_R or mcs <= 0 or (ccch_pending and mcs <= min_MCS_ccch)) {
       break;
     }
-    // Decrease MCS if first tx and rate is too high
-    mcs--;
+    // Decrease MCS if first tx and rate is too high. The number of REs of the grant does not depend on the MCS, so the
+    // TBS table gives the rate of the lower MCSs without regenerating the PDSCH for each of them
+    const srsran_ra_nr_tbs_table_t* tbs_table = bwp_grid.pdsch_tbs_tables->get(pdsch.sch);
+    do {
+      mcs--;
+    } while (tbs_table != nullptr and mcs > 0 and not(ccch_pending and mcs <= min_MCS_ccch) and
+             srsran_ra_nr_tbs_table_get_R_prime(
+                 tbs_table, mcs, pdsch.sch.grant.nof_prb, pdsch.sch.grant.tb[0].nof_re) >= max_R);
     pdcch.dci.mcs = mcs;
   }
   if (R_prime >= max_R and mcs == 0) {
@@ -423,7 +435,6 @@ alloc_result bwp_slot_allocator::alloc_pusch(slot_ue& ue, const prb_grant& ul_gr
   static const srsran_rnti_type_t                    rnti_type = srsran_rnti_type_c;
 
   auto& bwp_pdcch_slot = bwp_grid[ue.pdcch_slot];
-  auto& bwp_pusch_slot = bwp_grid[ue.pusch_slot];
 
   if (ue.h_ul == nullptr) {
     logger.warning("SCHED: Trying to allocate rnti=0x%x with no available UL HARQs", ue->rnti);
@@ -440,7 +451,15 @@ alloc_result bwp_slot_allocator::alloc_pusch(slot_ue& ue, const prb_grant& ul_gr
   const srsran_search_space_t& ss = *ss_candidates[0];
 
   // Verify if PUSCH allocation is valid
-  alloc_result ret = bwp_pusch_slot.puschs.is_grant_valid(ss.type, ul_grant);
+  int time_ra_idx = 0;
+  if (cfg.sched_cfg.lookahead_k1_k2) {
+    time_ra_idx = select_pusch_slot(ue, ss.type, ul_grant);
+    if (time_ra_idx < 0) {
+      return alloc_result::sch_collision;
+    }
+  }
+  auto&        bwp_pusch_slot = bwp_grid[ue.pusch_slot];
+  alloc_result ret            = bwp_pusch_slot.puschs.is_grant_valid(ss.type, ul_grant);
   if (ret != alloc_result::success) {
     return ret;
   }
@@ -457,6 +476,8 @@ alloc_result bwp_slot_allocator::alloc_pusch(slot_ue& ue, const prb_grant& ul_gr
 
   // Allocate PUSCH
   pusch_t& pusch = bwp_pusch_slot.puschs.alloc_pusch_unchecked(ul_grant, pdcch.dci);
+  // Signal the k2 of the selected PUSCH slot
+  pdcch.dci.time_domain_assigment = time_ra_idx;
 
   if (ue.h_ul->empty()) {
     int  mcs     = ue->fixed_pusch_mcs();
@@ -492,6 +513,51 @@ alloc_result bwp_slot_allocator::verify_uci_space(const bwp_slot_grid& uci_grid)
   return alloc_result::success;
 }
 
+void bwp_slot_allocator::select_uci_slot(slot_ue& ue) const
+{
+  uint32_t min_nof_acks = std::numeric_limits<uint32_t>::max();
+  for (uint32_t k1 : ue->k1_candidates()) {
+    slot_point uci_slot = ue.pdsch_slot + k1;
+    if (not cfg.slots[uci_slot.slot_idx()].is_ul) {
+      continue;
+    }
+    const bwp_slot_grid& uci_grid = bwp_grid[uci_slot];
+    if (uci_grid.pending_acks.size() < min_nof_acks and not uci_grid.pending_acks.full()) {
+      min_nof_acks = uci_grid.pending_acks.size();
+      ue.uci_slot  = uci_slot;
+    }
+  }
+}
+
+int bwp_slot_allocator::select_pusch_slot(slot_ue&                   ue,
+                                          srsran_search_space_type_t ss_type,
+                                          const prb_grant&           grant) const
+{
+  int      time_ra_idx       = -1;
+  uint32_t min_nof_used_prbs = std::numeric_limits<uint32_t>::max();
+  for (uint32_t m = 0; m < cfg.pusch_ra_list.size(); ++m) {
+    slot_point pusch_slot = ue.pdcch_slot + cfg.pusch_ra_list[m].K;
+    if (not cfg.slots[pusch_slot.slot_idx()].is_ul) {
+      continue;
+    }
+    const bwp_slot_grid& pusch_grid = bwp_grid[pusch_slot];
+    // A UE cannot transmit two PUSCHs in the same slot
+    bool ue_has_pusch = std::any_of(pusch_grid.ul.pusch.begin(), pusch_grid.ul.pusch.end(), [&ue](const pusch_t& p) {
+      return p.sch.grant.rnti == ue->rnti;
+    });
+    if (ue_has_pusch or pusch_grid.puschs.is_grant_valid(ss_type, grant, false) != alloc_result::success) {
+      continue;
+    }
+    uint32_t nof_used_prbs = pusch_grid.puschs.occupied_prbs().count();
+    if (nof_used_prbs < min_nof_used_prbs) {
+      min_nof_used_prbs = nof_used_prbs;
+      time_ra_idx       = m;
+      ue.pusch_slot     = pusch_slot;
+    }
+  }
+  return time_ra_idx;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 prb_grant find_optimal_dl_grant(bwp_slot_allocator& slot_alloc, const slot_ue& ue, uint32_t ss_id)
@@ -30,6 +30,41 @@ namespace sched_nr_impl {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+pdsch_tbs_table_cache::pdsch_tbs_table_cache(uint32_t nof_prb)
+{
+  for (srsran_ra_nr_tbs_table_t& table : tables) {
+    if (srsran_ra_nr_tbs_table_init(&table, nof_prb) < SRSRAN_SUCCESS) {
+      srsran_terminate("Error initiating PDSCH TBS table");
+    }
+  }
+}
+
+pdsch_tbs_table_cache::~pdsch_tbs_table_cache()
+{
+  for (srsran_ra_nr_tbs_table_t& table : tables) {
+    srsran_ra_nr_tbs_table_free(&table);
+  }
+}
+
+const srsran_ra_nr_tbs_table_t* pdsch_tbs_table_cache::get(const srsran_sch_cfg_nr_t& sch_cfg)
+{
+  for (const srsran_ra_nr_tbs_table_t& table : tables) {
+    if (srsran_ra_nr_tbs_table_match(&table, &sch_cfg, &sch_cfg.grant)) {
+      return &table;
+    }
+  }
+
+  // Replace the tables in round-robin
+  srsran_ra_nr_tbs_table_t& table = tables[next_table];
+  next_table                      = (next_table + 1) % max_nof_tables;
+  if (srsran_ra_nr_tbs_table_set(&table, &sch_cfg, &sch_cfg.grant) < SRSRAN_SUCCESS) {
+    return nullptr;
+  }
+  return &table;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void log_sched_slot_ues(srslog::basic_logger& logger, slot_point pdcch_slot, uint32_t cc, const slot_ue_map_t& slot_ues)
 {
   if (not logger.debug.enabled() or slot_ues.empty()) {
@@ -76,16 +76,17 @@ uint32_t bwp_rb_bitmap::prb_to_rbg_idx(uint32_t prb_idx) const
 
 void bwp_rb_bitmap::add_prbs_to_rbgs(const prb_bitmap& grant)
 {
-  int idx = 0;
-  do {
-    idx = grant.find_lowest(idx, grant.size(), true);
-    if (idx < 0) {
-      return;
-    }
+  int idx = grant.find_lowest(0, grant.size(), true);
+  while (idx >= 0) {
     uint32_t rbg_idx = prb_to_rbg_idx(idx);
     rbgs_.set(rbg_idx, true);
-    idx++;
-  } while (idx != (int)prbs_.size());
+    // Skip the remaining PRBs of the RBG
+    uint32_t next_rbg_prb = rbg_idx * P_ + first_rbg_size;
+    if (next_rbg_prb >= grant.size()) {
+      return;
+    }
+    idx = grant.find_lowest(next_rbg_prb, grant.size(), true);
+  }
 }
 
 void bwp_rb_bitmap::add_prbs_to_rbgs(const prb_interval& grant)
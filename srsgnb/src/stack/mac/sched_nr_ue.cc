@@ -99,6 +99,16 @@ slot_ue::slot_ue(ue_carrier& ue_, slot_point slot_tx_) : ue(&ue_), pdcch_slot(sl
     }
   }
   ul_active = ue->cell_params.bwps[0].slots[pusch_slot.slot_idx()].is_ul;
+  if (not ul_active and ue->cell_params.sched_args.lookahead_k1_k2) {
+    // Other PUSCH time-domain allocations may reach an UL slot. The final k2 is chosen at PUSCH allocation
+    for (const bwp_params_t::pusch_ra_time_cfg& ra : ue->bwp_cfg.active_bwp().pusch_ra_list) {
+      if (ue->cell_params.bwps[0].slots[(pdcch_slot + ra.K).slot_idx()].is_ul) {
+        pusch_slot = pdcch_slot + ra.K;
+        ul_active  = true;
+        break;
+      }
+    }
+  }
   if (ul_active) {
     ul_bytes = ue->common_ctxt.pending_ul_bytes;
     h_ul     = ue->harq_ent.find_pending_ul_retx();
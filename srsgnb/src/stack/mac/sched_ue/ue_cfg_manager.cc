@@ -22,6 +22,7 @@
 #include "srsgnb/hdr/stack/mac/sched_ue/ue_cfg_manager.h"
 #include "srsgnb/hdr/stack/mac/sched_nr_helpers.h"
 #include "srsran/asn1/rrc_nr_utils.h"
+#include <algorithm>
 
 namespace srsenb {
 namespace sched_nr_impl {
@@ -78,6 +79,16 @@ ue_carrier_params_t::ue_carrier_params_t(uint16_t rnti_, const bwp_params_t& bwp
     get_dci_locs(coreset_view[ss.coreset_id], ss, rnti, cce_positions_list.back());
     ss_id_to_cce_idx[ss.id] = cce_positions_list.size() - 1;
   }
+
+  // The PDSCH-to-HARQ timing indicator of DCI format 1_0 maps to k1 = 1..8
+  const srsran_harq_ack_cfg_hl_t& harq_ack = phy().harq_ack;
+  for (uint32_t i = 0; i < harq_ack.nof_dl_data_to_ul_ack; ++i) {
+    uint32_t k1 = harq_ack.dl_data_to_ul_ack[i];
+    if (k1 >= 1 and k1 <= 8 and std::find(k1_list.begin(), k1_list.end(), k1) == k1_list.end()) {
+      k1_list.push_back(k1);
+    }
+  }
+  std::sort(k1_list.begin(), k1_list.end());
 }
 
 int ue_carrier_params_t::find_ss_id(srsran_dci_format_nr_t dci_fmt) const
@@ -0,0 +1,302 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_feedback.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/adt/pool/cached_alloc.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace srsenb;
+using namespace srsenb::sched_nr_impl;
+
+ue_feedback_t make_feedback(uint32_t producer, uint32_t count)
+{
+  ue_feedback_t fb = {};
+  fb.rnti            = 0x4601 + producer;
+  fb.type            = count % 2 == 0 ? ue_feedback_t::type_t::dl_ack : ue_feedback_t::type_t::ul_crc;
+  fb.pid             = count % 16;
+  fb.tb_idx          = (count / 16) % 256;
+  fb.ok              = (count / 4096) % 2 == 0;
+  return fb;
+}
+
+uint32_t feedback_count(const ue_feedback_t& fb)
+{
+  return fb.pid + 16 * fb.tb_idx + 4096 * (fb.ok ? 0 : 1);
+}
+
+void test_ue_feedback_queue_single_producer()
+{
+  ue_feedback_queue q;
+  auto                discard = [](const ue_feedback_t& fb) {};
+
+  // TEST: empty queue
+  size_t n = q.pop_all(discard);
+  TESTASSERT(n == 0);
+
+  // TEST: feedback is popped in push order
+  for (uint32_t i = 0; i < 10; ++i) {
+    bool success = q.push(make_feedback(0, i));
+    TESTASSERT(success);
+  }
+  uint32_t count = 0;
+  n              = q.pop_all([&count](const ue_feedback_t& fb) {
+    TESTASSERT(fb.rnti == 0x4601 and feedback_count(fb) == count);
+    count++;
+  });
+  TESTASSERT(n == 10 and count == 10);
+  n = q.pop_all(discard);
+  TESTASSERT(n == 0);
+
+  // TEST: when the ring is full, the feedback goes to the overflow list and is still popped in push order
+  const uint32_t nof_events = ue_feedback_queue::RING_SIZE + 100;
+  for (uint32_t i = 0; i < nof_events; ++i) {
+    bool success = q.push(make_feedback(0, i));
+    TESTASSERT(success);
+  }
+  count = 0;
+  n     = q.pop_all([&count](const ue_feedback_t& fb) {
+    TESTASSERT(feedback_count(fb) == count);
+    count++;
+  });
+  TESTASSERT(n == nof_events and count == nof_events);
+
+  // TEST: the ring is used again once the overflow list is drained
+  bool success = q.push(make_feedback(0, 0));
+  TESTASSERT(success);
+  n = q.pop_all(discard);
+  TESTASSERT(n == 1);
+}
+
+void test_ue_feedback_queue_overflow_order()
+{
+  ue_feedback_queue q;
+
+  // The producer keeps pushing while the consumer drains the queue at a lower rate, so that its feedback alternates
+  // between the ring and the overflow list
+  const uint32_t    nof_events = 50 * ue_feedback_queue::RING_SIZE;
+  std::atomic<bool> done{false};
+  std::thread       producer([&q, &done, nof_events]() {
+    for (uint32_t i = 0; i < nof_events; ++i) {
+      bool success = q.push(make_feedback(0, i));
+      TESTASSERT(success);
+      if (i % 64 == 0) {
+        std::this_thread::yield();
+      }
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  uint32_t next_count = 0;
+  auto     consume    = [&next_count](const ue_feedback_t& fb) {
+    TESTASSERT(feedback_count(fb) == next_count % 8192);
+    next_count++;
+  };
+  while (not done.load(std::memory_order_acquire)) {
+    q.pop_all(consume);
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  producer.join();
+  q.pop_all(consume);
+
+  // TEST: all the feedback was received in push order
+  TESTASSERT(next_count == nof_events);
+}
+
+void test_ue_feedback_queue_multi_producer()
+{
+  const uint32_t nof_producers = ue_feedback_queue::MAX_PRODUCERS + 2;
+  const uint32_t nof_events    = 20000;
+
+  ue_feedback_queue      q;
+  std::atomic<bool>        start{false};
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&q, &start, p, nof_events]() {
+      while (not start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      for (uint32_t i = 0; i < nof_events;) {
+        if (q.push(make_feedback(p, i))) {
+          i++;
+          continue;
+        }
+        if (i == 0) {
+          // No ring left for this thread
+          break;
+        }
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  // Consumer checks that the feedback of each producer arrives in order
+  std::vector<uint32_t> next_count(nof_producers, 0);
+  uint32_t              total = 0;
+  start.store(true, std::memory_order_release);
+  auto consume = [&](const ue_feedback_t& fb) {
+    uint32_t p = fb.rnti - 0x4601;
+    TESTASSERT(p < nof_producers);
+    TESTASSERT(feedback_count(fb) == next_count[p] % 8192);
+    next_count[p]++;
+  };
+  while (total < nof_events * ue_feedback_queue::MAX_PRODUCERS) {
+    total += q.pop_all(consume);
+    std::this_thread::yield();
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  total += q.pop_all(consume);
+
+  // TEST: only MAX_PRODUCERS threads got a ring, and all of their feedback was received
+  TESTASSERT(total == nof_events * ue_feedback_queue::MAX_PRODUCERS);
+  uint32_t nof_complete = 0;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    TESTASSERT(next_count[p] == 0 or next_count[p] == nof_events);
+    nof_complete += next_count[p] == nof_events ? 1 : 0;
+  }
+  TESTASSERT(nof_complete == ue_feedback_queue::MAX_PRODUCERS);
+}
+
+/// Locked path used for the HARQ feedback before the rings, used as reference in the benchmark
+class locked_feedback_queue
+{
+public:
+  using callback_t = srsran::move_callback<void(uint32_t&)>;
+
+  void push(const ue_feedback_t& fb)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    next_events.emplace_back(fb.rnti, [fb](uint32_t& sum) { sum += fb.pid; });
+  }
+
+  size_t pop_all(uint32_t& sum)
+  {
+    current_events.clear();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      current_events.swap(next_events);
+    }
+    for (auto& ev : current_events) {
+      ev.second(sum);
+    }
+    return current_events.size();
+  }
+
+private:
+  std::mutex                                      mutex;
+  srsran::deque<std::pair<uint16_t, callback_t> > next_events, current_events;
+};
+
+struct benchmark_result {
+  double push_ns;
+  double pop_ns;
+};
+
+/// Each slot, "nof_producers" threads push "nof_events" feedback each, after which the consumer drains the queue
+template <typename Queue, typename PopFunc>
+benchmark_result
+run_benchmark(Queue& q, PopFunc&& pop_all, uint32_t nof_producers, uint32_t nof_events, uint32_t nof_slots)
+{
+  using clock = std::chrono::steady_clock;
+
+  std::atomic<uint32_t>    slot_start{0}, nof_done{0};
+  std::vector<double>      push_ns(nof_producers, 0);
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&, p]() {
+      for (uint32_t slot = 1; slot <= nof_slots; ++slot) {
+        while (slot_start.load(std::memory_order_acquire) < slot) {
+          std::this_thread::yield();
+        }
+        auto t0 = clock::now();
+        for (uint32_t i = 0; i < nof_events; ++i) {
+          q.push(make_feedback(p, i));
+        }
+        push_ns[p] += std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        nof_done.fetch_add(1, std::memory_order_acq_rel);
+      }
+    });
+  }
+
+  double pop_ns = 0;
+  for (uint32_t slot = 1; slot <= nof_slots; ++slot) {
+    slot_start.store(slot, std::memory_order_release);
+    while (nof_done.load(std::memory_order_acquire) < slot * nof_producers) {
+      std::this_thread::yield();
+    }
+    auto   t0    = clock::now();
+    size_t count = pop_all();
+    pop_ns += std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+    TESTASSERT(count == nof_producers * nof_events);
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+
+  double total_events = (double)nof_slots * nof_producers * nof_events;
+  double total_push   = 0;
+  for (double ns : push_ns) {
+    total_push += ns;
+  }
+  return {total_push / total_events, pop_ns / total_events};
+}
+
+void benchmark_ue_feedback_queue()
+{
+  const uint32_t nof_producers = 4;
+  const uint32_t nof_events    = 256;
+  const uint32_t nof_slots     = 500;
+
+  uint32_t              sum = 0;
+  locked_feedback_queue locked_q;
+  benchmark_result      locked_res = run_benchmark(
+      locked_q, [&]() { return locked_q.pop_all(sum); }, nof_producers, nof_events, nof_slots);
+
+  ue_feedback_queue ring_q;
+  benchmark_result    ring_res = run_benchmark(
+      ring_q,
+      [&]() { return ring_q.pop_all([&sum](const ue_feedback_t& fb) { sum += fb.pid; }); },
+      nof_producers,
+      nof_events,
+      nof_slots);
+
+  srsran::console("HARQ feedback, %d producers x %d events per slot:\n", nof_producers, nof_events);
+  srsran::console("  locked queue: push=%.1f ns/event, pop=%.1f ns/event\n", locked_res.push_ns, locked_res.pop_ns);
+  srsran::console("  SPSC rings:   push=%.1f ns/event, pop=%.1f ns/event\n", ring_res.push_ns, ring_res.pop_ns);
+}
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  test_ue_feedback_queue_single_producer();
+  test_ue_feedback_queue_overflow_order();
+  test_ue_feedback_queue_multi_producer();
+  benchmark_ue_feedback_queue();
+
+  return SRSRAN_SUCCESS;
+}
@@ -27,6 +27,25 @@
 
 namespace srsenb {
 
+/// PDSCH-to-HARQ feedback timing of a DL grant, as derived by the UE
+static uint32_t get_ue_k1(const srsran::phy_cfg_nr_t& phy_cfg, const srsran_dci_dl_nr_t& dci, slot_point pdcch_slot)
+{
+  if (dci.ctx.format == srsran_dci_format_nr_1_0) {
+    return dci.harq_feedback + 1;
+  }
+  return phy_cfg.harq_ack.dl_data_to_ul_ack[pdcch_slot.slot_idx() % phy_cfg.harq_ack.nof_dl_data_to_ul_ack];
+}
+
+/// PDCCH-to-PUSCH timing of an UL grant, as derived by the UE
+static uint32_t get_ue_k2(const srsran::phy_cfg_nr_t& phy_cfg, const srsran_dci_ul_nr_t& dci)
+{
+  srsran_sch_grant_nr_t grant = {};
+  int                   ret   = srsran_ra_ul_nr_time(
+      &phy_cfg.pusch, dci.ctx.rnti_type, dci.ctx.ss_type, dci.ctx.coreset_id, dci.time_domain_assigment, &grant);
+  TESTASSERT_EQ(SRSRAN_SUCCESS, ret);
+  return grant.k;
+}
+
 sched_nr_ue_sim::sched_nr_ue_sim(uint16_t rnti_, const sched_nr_ue_cfg_t& ue_cfg_) :
   logger(srslog::fetch_basic_logger("MAC"))
 {
@@ -63,9 +82,8 @@ int sched_nr_ue_sim::update(const sched_nr_cc_result_view& cc_out)
       continue;
     }
     slot_point pdcch_slot = cc_out.slot;
-    uint32_t   k1         = ctxt.ue_cfg.phy_cfg.harq_ack
-                      .dl_data_to_ul_ack[pdcch_slot.slot_idx() % ctxt.ue_cfg.phy_cfg.harq_ack.nof_dl_data_to_ul_ack];
-    slot_point uci_slot = pdcch_slot + k1;
+    uint32_t   k1         = get_ue_k1(ctxt.ue_cfg.phy_cfg, data.dci, pdcch_slot);
+    slot_point uci_slot   = pdcch_slot + k1;
 
     ctxt.cc_list[cc_out.cc].pending_acks[uci_slot.to_uint()]++;
   }
@@ -102,12 +120,9 @@ void sched_nr_ue_sim::update_dl_harqs(const sched_nr_cc_result_view& cc_out)
       // it is retx
       h.nof_retxs++;
     }
-    h.active       = true;
-    h.last_slot_tx = cc_out.slot;
-    h.last_slot_ack =
-        h.last_slot_tx +
-        ctxt.ue_cfg.phy_cfg.harq_ack
-            .dl_data_to_ul_ack[h.last_slot_tx.slot_idx() % ctxt.ue_cfg.phy_cfg.harq_ack.nof_dl_data_to_ul_ack];
+    h.active        = true;
+    h.last_slot_tx  = cc_out.slot;
+    h.last_slot_ack = h.last_slot_tx + get_ue_k1(ctxt.ue_cfg.phy_cfg, data.dci, h.last_slot_tx);
     h.nof_txs++;
   }
 
@@ -117,13 +132,14 @@ void sched_nr_ue_sim::update_dl_harqs(const sched_nr_cc_result_view& cc_out)
     if (data.dci.ctx.rnti != ctxt.rnti) {
       continue;
     }
-    auto& h = ctxt.cc_list[cc].ul_harqs[data.dci.pid];
+    auto&    h  = ctxt.cc_list[cc].ul_harqs[data.dci.pid];
+    uint32_t k2 = get_ue_k2(ctxt.ue_cfg.phy_cfg, data.dci);
     if (h.nof_txs == 0 or h.ndi != data.dci.ndi) {
       // It is newtx
       h.is_msg3       = false;
       h.nof_retxs     = 0;
       h.ndi           = data.dci.ndi;
-      h.first_slot_tx = cc_out.slot + 4; // TODO
+      h.first_slot_tx = cc_out.slot + k2;
       h.dci_loc       = data.dci.ctx.location;
       h.tbs           = 100; // TODO
     } else {
@@ -131,7 +147,7 @@ void sched_nr_ue_sim::update_dl_harqs(const sched_nr_cc_result_view& cc_out)
       h.nof_retxs++;
     }
     h.active        = true;
-    h.last_slot_tx  = cc_out.slot + 4; // TODO
+    h.last_slot_tx  = cc_out.slot + k2;
     h.last_slot_ack = h.last_slot_tx;
     h.nof_txs++;
   }
@@ -235,6 +235,82 @@ void test_sched_nr_data(sim_args_t args)
   TESTASSERT_EQ(1, tester.ue_metrics[rnti].nof_ul_txs);
 }
 
+/// Runs a UE with full DL and UL buffers in a TDD cell and returns its metrics
+sched_tester::sched_ue_metrics run_sched_nr_tdd_full_buffer(sim_args_t                  args,
+                                                            const srsran::phy_cfg_nr_t& phy_cfg,
+                                                            bool                        lookahead_k1_k2,
+                                                            uint32_t                    nof_slots)
+{
+  uint16_t rnti = 0x4601;
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer                     = true;
+  cfg.lookahead_k1_k2                        = lookahead_k1_k2;
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(1, phy_cfg);
+
+  std::string  test_name = fmt::format("Test TDD with full buffer and lookahead_k1_k2={}", lookahead_k1_k2);
+  sched_tester tester(args, cfg, cells_cfg, test_name);
+
+  /* Set events */
+  std::deque<sched_event_t> events;
+  events.push_back(add_user(9, rnti, 0));
+  events.push_back(ue_cfg(20, rnti, get_default_ue_cfg(1, phy_cfg)));
+
+  /* Run Test */
+  for (uint32_t nof_slots_run = 0; nof_slots_run < nof_slots; ++nof_slots_run) {
+    slot_point slot_rx(0, nof_slots_run % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+
+    // run events
+    while (not events.empty() and events.front().slot_count <= nof_slots_run) {
+      events.front().run(tester);
+      events.pop_front();
+    }
+
+    // call sched
+    tester.run_slot(slot_tx);
+  }
+
+  tester.print_results();
+  return tester.ue_metrics[rnti];
+}
+
+/// Compares the cell throughput with fixed and with lookahead k1/k2 selection, when the dl-DataToUL-ACK table maps the
+/// HARQ-ACKs of all the DL slots of the TDD period to the first UL slot and a second PUSCH time-domain allocation is
+/// available
+void test_sched_nr_tdd_lookahead(sim_args_t args)
+{
+  uint32_t nof_slots = 2000;
+
+  srsran::phy_cfg_nr_t phy_cfg = srsran::phy_cfg_nr_default_t{srsran::phy_cfg_nr_default_t::reference_cfg_t{}};
+  TESTASSERT_EQ(SRSRAN_DUPLEX_MODE_TDD, phy_cfg.duplex.mode);
+  uint32_t nof_dl_slots = phy_cfg.duplex.tdd.pattern1.nof_dl_slots;
+  for (uint32_t n = 0; n < nof_dl_slots; ++n) {
+    phy_cfg.harq_ack.dl_data_to_ul_ack[n] = nof_dl_slots - n;
+  }
+  phy_cfg.harq_ack.nof_dl_data_to_ul_ack = nof_dl_slots;
+  phy_cfg.pusch.common_time_ra[1]        = phy_cfg.pusch.common_time_ra[0];
+  phy_cfg.pusch.common_time_ra[1].k      = phy_cfg.pusch.common_time_ra[0].k + 2;
+  phy_cfg.pusch.nof_common_time_ra       = 2;
+
+  sched_tester::sched_ue_metrics fixed     = run_sched_nr_tdd_full_buffer(args, phy_cfg, false, nof_slots);
+  sched_tester::sched_ue_metrics lookahead = run_sched_nr_tdd_full_buffer(args, phy_cfg, true, nof_slots);
+
+  srslog::flush();
+  auto to_mbps = [nof_slots](uint64_t nof_bytes) { return nof_bytes * 8 / (nof_slots * 1000.0); };
+  fmt::print("== Results ==\n");
+  fmt::print("Cell throughput with fixed k1/k2: DL={:.2f} Mbps, UL={:.2f} Mbps\n",
+             to_mbps(fixed.nof_dl_bytes),
+             to_mbps(fixed.nof_ul_bytes));
+  fmt::print("Cell throughput with lookahead k1/k2: DL={:.2f} Mbps, UL={:.2f} Mbps\n",
+             to_mbps(lookahead.nof_dl_bytes),
+             to_mbps(lookahead.nof_ul_bytes));
+
+  // With fixed k1, the DL slots whose HARQ-ACK does not fit in the first UL slot are left empty
+  TESTASSERT(lookahead.nof_dl_bytes > fixed.nof_dl_bytes);
+  TESTASSERT(lookahead.nof_ul_bytes >= fixed.nof_ul_bytes);
+}
+
 sim_args_t handle_args(int argc, char** argv)
 {
   sim_args_t args;
@@ -329,6 +405,7 @@ int main(int argc, char** argv)
 
   srsenb::test_sched_nr_no_data(args);
   srsenb::test_sched_nr_data(args);
+  srsenb::test_sched_nr_tdd_lookahead(args);
 
   fmt::print("TEST: Random Seed was {}", args.rand_seed);
 }
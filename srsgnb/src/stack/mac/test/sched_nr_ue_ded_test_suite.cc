@@ -22,6 +22,7 @@
 #include "sched_nr_ue_ded_test_suite.h"
 #include "srsgnb/hdr/stack/mac/sched_nr_grant_allocator.h"
 #include "srsran/common/test_common.h"
+#include <algorithm>
 
 namespace srsenb {
 
@@ -51,7 +52,16 @@ void test_dl_sched_result(const sim_nr_enb_ctxt_t& enb_ctxt, const sched_nr_cc_r
 
     // CHECK: UCI
     if (pdcch.dci.ctx.format == srsran_dci_format_nr_1_0) {
-      TESTASSERT_EQ(k1 - 1, pdcch.dci.harq_feedback);
+      if (enb_ctxt.cell_params[cc_out.cc].sched_args.lookahead_k1_k2) {
+        // k1 is one of the configured values and points to an UL slot
+        const srsran_harq_ack_cfg_hl_t& ack_cfg = ue.ue_cfg.phy_cfg.harq_ack;
+        k1                                      = pdcch.dci.harq_feedback + 1;
+        TESTASSERT(std::count(ack_cfg.dl_data_to_ul_ack, ack_cfg.dl_data_to_ul_ack + ack_cfg.nof_dl_data_to_ul_ack, k1) >
+                   0);
+        TESTASSERT(enb_ctxt.cell_params[cc_out.cc].bwps[0].slots[(pdcch_slot + k1).slot_idx()].is_ul);
+      } else {
+        TESTASSERT_EQ(k1 - 1, pdcch.dci.harq_feedback);
+      }
     } else {
       TESTASSERT(pdcch.dci.harq_feedback == pdcch_slot.slot_idx());
     }
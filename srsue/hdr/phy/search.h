@@ -33,6 +33,7 @@ class search_callback
 public:
   virtual int                          radio_recv_fnc(srsran::rf_buffer_t&, srsran_timestamp_t* rx_time) = 0;
   virtual void                         set_ue_sync_opts(srsran_ue_sync_t* q, float cfo)                  = 0;
+  virtual void                         set_ue_sync_agc_opts(srsran_ue_sync_t* q)                         = 0;
   virtual srsran::radio_interface_phy* get_radio()                                                       = 0;
   virtual void                         set_rx_gain(float gain)                                           = 0;
 };
@@ -139,6 +139,7 @@ private:
   void reset();
   void radio_error();
   void set_ue_sync_opts(srsran_ue_sync_t* q, float cfo) override;
+  void set_ue_sync_agc_opts(srsran_ue_sync_t* q) override;
 
   /**
    * Search for a cell in the current frequency and go to IDLE.
@@ -68,6 +68,10 @@ public:
   {
     parent_sdap->write_pdu(lcid, std::move(pdu));
   }
+  void write_pdu_batch(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus) final
+  {
+    parent_sdap->write_pdu_batch(lcid, pdus);
+  }
   void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu) final
   {
     // not implemented
@@ -62,6 +62,7 @@ public:
   // PDCP interface
   void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu);
   void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu);
+  void write_pdu_batch(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus);
 
   // NAS interface
   int  setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr, uint8_t* ipv6_if_addr, char* err_str);
@@ -102,6 +103,7 @@ private:
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
   void run_thread();
+  void write_tun_pdu(const srsran::unique_byte_buffer_t& pdu);
   int  init_if(char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
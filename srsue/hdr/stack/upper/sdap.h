@@ -40,6 +40,7 @@ public:
 
   // Interface for GW
   void write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) final;
+  void write_pdu_batch(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus);
 
   // Interface for PDCP
   void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu) final;
@@ -100,6 +100,11 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.rx_gain[4]",   bpo::value<float>(&args->rf.rx_gain_ch[4])->default_value(-1),       "Front-end receiver gain CH4")
     ("rf.nof_antennas", bpo::value<uint32_t>(&args->rf.nof_antennas)->default_value(1),      "Number of antennas per carrier")
 
+    ("rf.agc_fast_attack", bpo::value<bool>(&args->phy.agc_fast_attack)->default_value(false),  "Enables the fast-attack/slow-decay AGC, used when rx_gain is not set")
+    ("rf.agc_attack_tc",   bpo::value<float>(&args->phy.agc_attack_tc)->default_value(1.0),     "Fast-attack AGC time constant in frames when the signal level rises")
+    ("rf.agc_decay_tc",    bpo::value<float>(&args->phy.agc_decay_tc)->default_value(20.0),     "Fast-attack AGC time constant in frames when the signal level falls")
+    ("rf.agc_hold_frames", bpo::value<uint32_t>(&args->phy.agc_hold_frames)->default_value(3),  "Frames ignored by the fast-attack AGC after a gain change")
+
     ("rf.device_name", bpo::value<string>(&args->rf.device_name)->default_value("auto"), "Front-end device name")
     ("rf.device_args", bpo::value<string>(&args->rf.device_args)->default_value("auto"), "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
@@ -101,6 +101,7 @@ void search::set_agc_enable(bool enable)
                              rf_info->min_rx_gain,
                              rf_info->max_rx_gain,
                              p->get_radio()->get_rx_gain());
+    p->set_ue_sync_agc_opts(&ue_mib_sync.ue_sync);
   } else {
     ERROR("Error stop AGC not implemented");
   }
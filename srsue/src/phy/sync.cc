@@ -789,9 +789,24 @@ void sync::set_agc_enable(bool enable)
   // Enable AGC (unprotected call to ue_sync must not happen outside of thread calling recv)
   srsran_ue_sync_start_agc(
       &ue_sync, callback_set_rx_gain, rf_info->min_rx_gain, rf_info->max_rx_gain, radio_h->get_rx_gain());
+  set_ue_sync_agc_opts(&ue_sync);
   search_p.set_agc_enable(true);
 }
 
+void sync::set_ue_sync_agc_opts(srsran_ue_sync_t* q)
+{
+  if (not q->do_agc or not worker_com->args->agc_fast_attack) {
+    return;
+  }
+
+  if (srsran_agc_set_fast_attack(&q->agc,
+                                 worker_com->args->agc_attack_tc,
+                                 worker_com->args->agc_decay_tc,
+                                 worker_com->args->agc_hold_frames) < SRSRAN_SUCCESS) {
+    Warning("SYNC:  Invalid fast-attack AGC time constants. Using the default AGC");
+  }
+}
+
 float sync::get_tx_cfo()
 {
   // Use CFO estimate from last successful sync
@@ -140,6 +140,27 @@ void gw::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
     std::unique_lock<std::mutex> lock(gw_mutex);
     dl_tput_bytes += pdu->N_bytes;
   }
+  write_tun_pdu(pdu);
+}
+
+void gw::write_pdu_batch(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+{
+  uint32_t nof_bytes = 0;
+  for (const srsran::unique_byte_buffer_t& pdu : pdus) {
+    logger.info(pdu->msg, pdu->N_bytes, "RX PDU. Stack latency: %ld us", pdu->get_latency_us().count());
+    nof_bytes += pdu->N_bytes;
+  }
+  {
+    std::unique_lock<std::mutex> lock(gw_mutex);
+    dl_tput_bytes += nof_bytes;
+  }
+  for (const srsran::unique_byte_buffer_t& pdu : pdus) {
+    write_tun_pdu(pdu);
+  }
+}
+
+void gw::write_tun_pdu(const srsran::unique_byte_buffer_t& pdu)
+{
   if (!if_up) {
     if (run_enable) {
       logger.warning("TUN/TAP not up - dropping gw RX message");
@@ -49,6 +49,14 @@ void sdap::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
   m_gw->write_pdu(lcid, std::move(pdu));
 }
 
+void sdap::write_pdu_batch(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> pdus)
+{
+  if (!running) {
+    return;
+  }
+  m_gw->write_pdu_batch(lcid, pdus);
+}
+
 void sdap::write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   if (!running) {
@@ -1200,6 +1200,11 @@ bool ttcn3_syssim::sdu_queue_is_full(uint32_t lcid)
   return false;
 }
 
+uint32_t ttcn3_syssim::get_buffer_state(uint32_t lcid)
+{
+  return 0;
+}
+
 bool ttcn3_syssim::is_suspended(uint32_t lcid)
 {
   return false;